@@ -0,0 +1,78 @@
+#include <catch.hpp>
+#include <uipc/uipc.h>
+#include <numeric>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+namespace
+{
+// a vertex collection with attributes of the usual types
+AttributeCollection make_collection(SizeT N)
+{
+    AttributeCollection c;
+    c.resize(N);
+    for(int i = 0; i < 4; ++i)
+    {
+        c.create<Vector3>(fmt::format("v3_{}", i), Vector3::Zero());
+        c.create<Float>(fmt::format("f_{}", i), 0.0);
+        c.create<IndexT>(fmt::format("i_{}", i), 0);
+        c.create<Matrix3x3>(fmt::format("m3_{}", i), Matrix3x3::Identity());
+    }
+    c.create<std::string>("name", "vertex");
+    return c;
+}
+
+// a permutation that scatters the neighbours, like a spatial sort does
+vector<SizeT> make_permutation(SizeT N)
+{
+    vector<SizeT> O(N);
+    std::iota(O.begin(), O.end(), 0);
+    for(SizeT i = 0; i < N; ++i)
+        std::swap(O[i], O[(i * 7919) % N]);
+    return O;
+}
+}  // namespace
+
+TEST_CASE("attribute_collection", "[geometry]")
+{
+    for(SizeT N : {SizeT{1} << 12, SizeT{1} << 18})
+    {
+        auto foo = make_collection(N);
+        auto O   = make_permutation(N);
+
+        BENCHMARK(fmt::format("resize {} -> {} -> {}", N, 2 * N, N))
+        {
+            foo.resize(2 * N);
+            foo.resize(N);
+            return foo.size();
+        };
+
+        BENCHMARK(fmt::format("reorder permutation {}", N))
+        {
+            foo.reorder(O);
+            return foo.size();
+        };
+
+        // the first half, every value twice
+        vector<SizeT> prefix(N);
+        for(SizeT i = 0; i < N; ++i)
+            prefix[i] = i / 2;
+
+        BENCHMARK(fmt::format("reorder prefix {}", N))
+        {
+            foo.reorder(prefix);
+            return foo.size();
+        };
+
+        AttributeCollection bar;
+        bar.resize(N);
+        bar.copy_from(foo, AttributeCopy::pull(O));
+
+        BENCHMARK(fmt::format("copy_from pull {}", N))
+        {
+            bar.copy_from(foo, AttributeCopy::pull(O));
+            return bar.size();
+        };
+    }
+}
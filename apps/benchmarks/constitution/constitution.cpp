@@ -0,0 +1,423 @@
+#include <catch.hpp>
+#include "kernel_harness.h"
+#include <Eigen/LU>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace uipc::bench
+{
+namespace sym::hookean_spring_1d
+{
+#include <finite_element/constitutions/sym/hookean_spring_1d.inl>
+}
+namespace sym::stable_neo_hookean_3d
+{
+#include <finite_element/constitutions/sym/stable_neo_hookean_3d.inl>
+}
+namespace sym::shell_neo_hookean_2d
+{
+#include <finite_element/constitutions/sym/shell_neo_hookean_2d.inl>
+}
+namespace sym::kirchhoff_rod_bending
+{
+#include <finite_element/constitutions/sym/kirchhoff_rod_bending.inl>
+}
+namespace sym::discrete_shell_bending
+{
+#include <finite_element/constitutions/sym/discrete_shell_bending.inl>
+}
+namespace sym::abd_ortho_potential
+{
+#include <affine_body/constitutions/sym/ortho_potential.inl>
+}
+namespace sym::codim_ipc_contact
+{
+#include <contact_system/contact_models/sym/codim_ipc_contact.inl>
+}
+namespace sym::vertex_half_plane_distance
+{
+#include <contact_system/contact_models/sym/vertex_half_plane_distance.inl>
+}
+}  // namespace uipc::bench
+
+using namespace uipc;
+using namespace uipc::bench;
+
+namespace
+{
+constexpr SizeT CheckCount     = 1024;
+constexpr SizeT BenchmarkCount = SizeT{1} << 18;
+constexpr Float Tolerance      = 1e-4;
+
+// the random numbers of element I, independent of the evaluation order
+template <int N>
+Eigen::Vector<Float, N> random_vector(SizeT I, SizeT salt = 0)
+{
+    std::mt19937                          gen(static_cast<unsigned>(I * 7919 + salt));
+    std::uniform_real_distribution<Float> dist(-1.0, 1.0);
+    return Eigen::Vector<Float, N>::NullaryExpr([&] { return dist(gen); });
+}
+
+/**
+ * @brief Check a kernel against finite differences, then measure the throughput of the energy
+ * and of the energy, gradient and Hessian together.
+ */
+template <int N, typename XF, typename EF, typename GF, typename HF>
+void check_and_measure(std::string_view name, XF&& x, EF&& E, GF&& G, HF&& H, Float h = 1e-6)
+{
+    using VectorT = Eigen::Vector<Float, N>;
+    using MatrixT = Eigen::Matrix<Float, N, N>;
+
+    auto error = finite_difference_check<N>(CheckCount, x, E, G, H, h);
+    INFO(name << ": gradient error " << error.gradient << ", hessian error " << error.hessian);
+    CHECK(error.gradient < Tolerance);
+    CHECK(error.hessian < Tolerance);
+
+    std::vector<VectorT> xs(BenchmarkCount);
+    parallel_for(0, BenchmarkCount, [&](SizeT I) { xs[I] = x(I); });
+
+    std::vector<Float>   energies(BenchmarkCount);
+    std::vector<VectorT> gradients(BenchmarkCount);
+    std::vector<MatrixT> hessians(BenchmarkCount);
+
+    throughput(fmt::format("{} E", name),
+               BenchmarkCount,
+               [&](SizeT I) { energies[I] = E(I, xs[I]); });
+    throughput(fmt::format("{} E+G+H", name),
+               BenchmarkCount,
+               [&](SizeT I)
+               {
+                   energies[I]  = E(I, xs[I]);
+                   gradients[I] = G(I, xs[I]);
+                   hessians[I]  = H(I, xs[I]);
+               });
+}
+}  // namespace
+
+TEST_CASE("hookean_spring_1d", "[constitution]")
+{
+    namespace HS = sym::hookean_spring_1d;
+
+    constexpr Float k  = 1e4;
+    constexpr Float L0 = 1.0;
+
+    // a spring stretched or compressed by up to 50%
+    auto x = [&](SizeT I)
+    {
+        Vector3 p0  = random_vector<3>(I);
+        Vector3 dir = random_vector<3>(I, 1).normalized();
+        Vector6 X;
+        X << p0, p0 + dir * (1.0 + 0.5 * random_vector<1>(I, 2)(0));
+        return X;
+    };
+
+    check_and_measure<6>(
+        "hookean_spring_1d",
+        x,
+        [&](SizeT, const Vector6& X)
+        {
+            Float E;
+            HS::E(E, k, X, L0);
+            return E;
+        },
+        [&](SizeT, const Vector6& X)
+        {
+            Vector6 G;
+            HS::dEdX(G, k, X, L0);
+            return G;
+        },
+        [&](SizeT, const Vector6& X)
+        {
+            Matrix6x6 H;
+            HS::ddEddX(H, k, X, L0);
+            return H;
+        });
+}
+
+TEST_CASE("stable_neo_hookean_3d", "[constitution]")
+{
+    namespace SNH = sym::stable_neo_hookean_3d;
+
+    constexpr Float mu     = 1.0;
+    constexpr Float lambda = 10.0;
+
+    // F = I + 0.3 * R, not inverted
+    auto x = [&](SizeT I) -> Vector9
+    {
+        Vector9 VecF = 0.3 * random_vector<9>(I);
+        VecF(0) += 1;
+        VecF(4) += 1;
+        VecF(8) += 1;
+        return VecF;
+    };
+
+    check_and_measure<9>(
+        "stable_neo_hookean_3d",
+        x,
+        [&](SizeT, const Vector9& VecF)
+        {
+            Float E;
+            SNH::E(E, mu, lambda, VecF);
+            return E;
+        },
+        [&](SizeT, const Vector9& VecF)
+        {
+            Vector9 G;
+            SNH::dEdVecF(G, mu, lambda, VecF);
+            return G;
+        },
+        [&](SizeT, const Vector9& VecF)
+        {
+            Matrix9x9 H;
+            SNH::ddEddVecF(H, mu, lambda, VecF);
+            return H;
+        });
+}
+
+TEST_CASE("shell_neo_hookean_2d", "[constitution]")
+{
+    namespace NH = sym::shell_neo_hookean_2d;
+
+    constexpr Float mu     = 1.0;
+    constexpr Float lambda = 10.0;
+
+    // a perturbed right triangle, deformed by up to 20%
+    auto x_bar = [&](SizeT I) -> Vector9
+    {
+        Vector9 X_bar;
+        X_bar << 0, 0, 0, 1, 0, 0, 0, 1, 0;
+        return X_bar + 0.1 * random_vector<9>(I, 1);
+    };
+
+    std::vector<Matrix2x2> IBs(std::max(CheckCount, BenchmarkCount));
+    parallel_for(0,
+                 IBs.size(),
+                 [&](SizeT I)
+                 {
+                     Matrix2x2 B;
+                     NH::A(B, x_bar(I));
+                     IBs[I] = B.inverse();
+                 });
+
+    check_and_measure<9>(
+        "shell_neo_hookean_2d",
+        [&](SizeT I) -> Vector9 { return x_bar(I) + 0.2 * random_vector<9>(I); },
+        [&](SizeT I, const Vector9& X)
+        {
+            Float E;
+            NH::E(E, mu, lambda, X, IBs[I]);
+            return E;
+        },
+        [&](SizeT I, const Vector9& X)
+        {
+            Vector9 G;
+            NH::dEdX(G, mu, lambda, X, IBs[I]);
+            return G;
+        },
+        [&](SizeT I, const Vector9& X)
+        {
+            Matrix9x9 H;
+            NH::ddEddX(H, mu, lambda, X, IBs[I]);
+            return H;
+        });
+}
+
+TEST_CASE("kirchhoff_rod_bending", "[constitution]")
+{
+    namespace KRB = sym::kirchhoff_rod_bending;
+
+    constexpr Float k  = 1e2;
+    constexpr Float L0 = 2.0;
+    constexpr Float r  = 0.01;
+    constexpr Float Pi = std::numbers::pi;
+
+    // a bent rod of two unit edges
+    auto x = [&](SizeT I) -> Vector9
+    {
+        Vector9 X;
+        X << -1, 0, 0, 0, 0, 0, 1, 0, 0;
+        return X + 0.3 * random_vector<9>(I);
+    };
+
+    check_and_measure<9>(
+        "kirchhoff_rod_bending",
+        x,
+        [&](SizeT, const Vector9& X)
+        {
+            Float E;
+            KRB::E(E, k, X, L0, r, Pi);
+            return E;
+        },
+        [&](SizeT, const Vector9& X)
+        {
+            Vector9 G;
+            KRB::dEdX(G, k, X, L0, r, Pi);
+            return G;
+        },
+        [&](SizeT, const Vector9& X)
+        {
+            Matrix9x9 H;
+            KRB::ddEddX(H, k, X, L0, r, Pi);
+            return H;
+        });
+}
+
+TEST_CASE("discrete_shell_bending", "[constitution]")
+{
+    namespace DSB = sym::discrete_shell_bending;
+    using Vector1 = Eigen::Vector<Float, 1>;
+    using Matrix1 = Eigen::Matrix<Float, 1, 1>;
+
+    constexpr Float kappa = 1.0;
+    constexpr Float L0    = 1.0;
+    constexpr Float h_bar = 0.5;
+
+    std::vector<Float> theta_bars(std::max(CheckCount, BenchmarkCount));
+    parallel_for(0, theta_bars.size(), [&](SizeT I) { theta_bars[I] = random_vector<1>(I, 1)(0); });
+
+    check_and_measure<1>(
+        "discrete_shell_bending",
+        [&](SizeT I) -> Vector1 { return std::numbers::pi / 2 * random_vector<1>(I); },
+        [&](SizeT I, const Vector1& theta)
+        {
+            Float E;
+            DSB::E(E, kappa, theta(0), theta_bars[I], L0, h_bar);
+            return E;
+        },
+        [&](SizeT I, const Vector1& theta)
+        {
+            Vector1 G;
+            DSB::dEdtheta(G(0), kappa, theta(0), theta_bars[I], L0, h_bar);
+            return G;
+        },
+        [&](SizeT I, const Vector1& theta)
+        {
+            Matrix1 H;
+            DSB::ddEddtheta(H(0), kappa, theta(0), theta_bars[I], L0, h_bar);
+            return H;
+        });
+}
+
+TEST_CASE("abd_ortho_potential", "[constitution]")
+{
+    namespace OP = sym::abd_ortho_potential;
+
+    constexpr Float kappa = 1e4;
+
+    // q = (p, A), the gradient and Hessian are of the 9 dofs of A
+    auto q = [](const Vector9& A)
+    {
+        Vector12 q;
+        q << Vector3::Zero(), A;
+        return q;
+    };
+
+    check_and_measure<9>(
+        "abd_ortho_potential",
+        [&](SizeT I) -> Vector9
+        {
+            Vector9 A = 0.3 * random_vector<9>(I);
+            A(0) += 1;
+            A(4) += 1;
+            A(8) += 1;
+            return A;
+        },
+        [&](SizeT, const Vector9& A)
+        {
+            Float E;
+            OP::E(E, kappa, q(A));
+            return E;
+        },
+        [&](SizeT, const Vector9& A)
+        {
+            Vector9 G;
+            OP::dEdq(G, kappa, q(A));
+            return G;
+        },
+        [&](SizeT, const Vector9& A)
+        {
+            Matrix9x9 H;
+            OP::ddEddq(H, kappa, q(A));
+            return H;
+        });
+}
+
+TEST_CASE("codim_ipc_contact", "[constitution]")
+{
+    namespace CIC = sym::codim_ipc_contact;
+    using Vector1 = Eigen::Vector<Float, 1>;
+    using Matrix1 = Eigen::Matrix<Float, 1, 1>;
+
+    constexpr Float kappa = 1e3;
+    constexpr Float d_hat = 0.01;
+    constexpr Float xi    = 0.001;
+
+    // the squared distance D is in (xi^2, (d_hat + xi)^2), where the barrier is active
+    auto x = [&](SizeT I) -> Vector1
+    {
+        Float t = 0.55 + 0.4 * random_vector<1>(I)(0);  // (0.15, 0.95)
+        Float d = xi + t * d_hat;
+        return Vector1{d * d};
+    };
+
+    check_and_measure<1>(
+        "codim_ipc_contact",
+        x,
+        [&](SizeT, const Vector1& D)
+        {
+            Float E;
+            CIC::KappaBarrier(E, kappa, D(0), d_hat, xi);
+            return E;
+        },
+        [&](SizeT, const Vector1& D)
+        {
+            Vector1 G;
+            CIC::dKappaBarrierdD(G(0), kappa, D(0), d_hat, xi);
+            return G;
+        },
+        [&](SizeT, const Vector1& D)
+        {
+            Matrix1 H;
+            CIC::ddKappaBarrierddD(H(0), kappa, D(0), d_hat, xi);
+            return H;
+        },
+        1e-11);  // D is about 1e-5, so is the step
+}
+
+TEST_CASE("vertex_half_plane_distance", "[constitution]")
+{
+    namespace VHP = sym::vertex_half_plane_distance;
+
+    std::vector<Vector3> Ps(std::max(CheckCount, BenchmarkCount));
+    std::vector<Vector3> Ns(Ps.size());
+    parallel_for(0,
+                 Ps.size(),
+                 [&](SizeT I)
+                 {
+                     Ps[I] = random_vector<3>(I, 1);
+                     Ns[I] = random_vector<3>(I, 2).normalized();
+                 });
+
+    check_and_measure<3>(
+        "vertex_half_plane_distance",
+        [&](SizeT I) -> Vector3 { return random_vector<3>(I); },
+        [&](SizeT I, const Vector3& x)
+        {
+            Float D;
+            VHP::HalfPlaneD(D, x, Ps[I], Ns[I]);
+            return D;
+        },
+        [&](SizeT I, const Vector3& x)
+        {
+            Vector3 G;
+            VHP::dHalfPlaneDdx(G, x, Ps[I], Ns[I]);
+            return G;
+        },
+        [&](SizeT I, const Vector3& x)
+        {
+            Matrix3x3 H;
+            VHP::ddHalfPlaneDddx(H, x, Ps[I], Ns[I]);
+            return H;
+        });
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/format.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string_view>
+
+// The generated kernels (sym/*.inl) are `__host__ __device__` functions, which are plain functions on a host compiler.
+#ifndef __CUDACC__
+#ifndef __host__
+#define __host__
+#endif
+#ifndef __device__
+#define __device__
+#endif
+#endif
+
+namespace uipc::bench
+{
+struct FiniteDifferenceError
+{
+    Float gradient = 0;
+    Float hessian  = 0;
+};
+
+/**
+ * @brief Check the gradient and the Hessian of a kernel against central finite differences on a batch of elements.
+ *
+ * @param x `x(I)` the dofs of the element I
+ * @param E `E(I, x)` the energy of the element I at `x`
+ * @param G `G(I, x)` the gradient
+ * @param H `H(I, x)` the Hessian
+ * @return the max relative errors of the batch, relative to the norm of the gradient (Hessian), at least 1
+ */
+template <int N, typename XF, typename EF, typename GF, typename HF>
+FiniteDifferenceError finite_difference_check(SizeT count, XF&& x, EF&& E, GF&& G, HF&& H, Float h = 1e-6)
+{
+    using VectorT = Eigen::Vector<Float, N>;
+    using MatrixT = Eigen::Matrix<Float, N, N>;
+
+    std::vector<FiniteDifferenceError> errors(count);
+    parallel_for(0,
+                 count,
+                 [&](SizeT I)
+                 {
+                     VectorT X  = x(I);
+                     VectorT g  = G(I, X);
+                     MatrixT H_ = H(I, X);
+
+                     VectorT g_fd;
+                     MatrixT H_fd;
+                     for(int i = 0; i < N; ++i)
+                     {
+                         VectorT Xp = X, Xm = X;
+                         Xp(i) += h;
+                         Xm(i) -= h;
+                         g_fd(i)     = (E(I, Xp) - E(I, Xm)) / (2 * h);
+                         H_fd.col(i) = (G(I, Xp) - G(I, Xm)) / (2 * h);
+                     }
+
+                     errors[I].gradient = (g - g_fd).norm() / std::max<Float>(g.norm(), 1);
+                     errors[I].hessian  = (H_ - H_fd).norm() / std::max<Float>(H_.norm(), 1);
+                 },
+                 64);
+
+    FiniteDifferenceError max_error;
+    for(auto& e : errors)
+    {
+        max_error.gradient = std::max(max_error.gradient, e.gradient);
+        max_error.hessian  = std::max(max_error.hessian, e.hessian);
+    }
+    return max_error;
+}
+
+/**
+ * @brief Evaluate `f(I)` for the batch of elements on all threads, print and return the elements per second.
+ *
+ * The batch is evaluated once to warm up, then `repeat` times to measure.
+ */
+template <typename F>
+double throughput(std::string_view name, SizeT count, F&& f, SizeT repeat = 5)
+{
+    constexpr SizeT Grain = 1024;
+
+    parallel_for(0, count, f, Grain);
+
+    auto begin = std::chrono::steady_clock::now();
+    for(SizeT r = 0; r < repeat; ++r)
+        parallel_for(0, count, f, Grain);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    double eps     = seconds > 0 ? count * repeat / seconds : 0;
+    fmt::print("{:<40} {:>12.4g} elements/s\n", name, eps);
+    return eps;
+}
+}  // namespace uipc::bench
@@ -0,0 +1,179 @@
+#include <catch.hpp>
+#include <uipc/uipc.h>
+#include <uipc/common/exec.h>
+#include <uipc/common/linear_system/matrix_converter.h>
+#include <atomic>
+#include <numeric>
+#include <random>
+
+using namespace uipc;
+
+// The cost of the deterministic mode: the atomic scatter/sum (fast, the result depends on the thread
+// scheduling) against the fixed order reductions (bitwise the same for any thread count).
+TEST_CASE("determinism", "[exec]")
+{
+    constexpr SizeT V = 1 << 16;  // vertices
+    constexpr SizeT E = 1 << 18;  // tetrahedra
+
+    std::mt19937                          gen{42};
+    std::uniform_real_distribution<Float> dis{-1.0, 1.0};
+    std::uniform_int_distribution<IndexT> vertex{0, V - 1};
+
+    vector<Vector4i> tets(E);
+    vector<Vector3>  element_gradients(E * 4);  // 4 vertices per tetrahedron
+    vector<Float>    element_energies(E);
+    for(SizeT i = 0; i < E; ++i)
+    {
+        tets[i]             = Vector4i{vertex(gen), vertex(gen), vertex(gen), vertex(gen)};
+        element_energies[i] = dis(gen) * std::pow(10.0, dis(gen) * 8);
+        for(SizeT k = 0; k < 4; ++k)
+            element_gradients[i * 4 + k] = Vector3{dis(gen), dis(gen), dis(gen)};
+    }
+
+    // vertex -> the element gradients on it, in the order of the elements
+    vector<IndexT> vertex_offsets(V + 1, 0);
+    vector<IndexT> vertex_gradient_ids(E * 4);
+    for(auto& tet : tets)
+        for(auto v : tet)
+            vertex_offsets[v + 1]++;
+    std::partial_sum(vertex_offsets.begin(), vertex_offsets.end(), vertex_offsets.begin());
+    {
+        vector<IndexT> cursor(vertex_offsets.begin(), vertex_offsets.end() - 1);
+        for(SizeT i = 0; i < E; ++i)
+            for(SizeT k = 0; k < 4; ++k)
+                vertex_gradient_ids[cursor[tets[i][k]]++] = static_cast<IndexT>(i * 4 + k);
+    }
+
+    auto atomic_sum = [&]
+    {
+        Float sum = 0.0;
+        exec::parallel_for(0,
+                           E,
+                           [&](SizeT i)
+                           {
+                               std::atomic_ref<Float>{sum}.fetch_add(element_energies[i]);
+                           });
+        return sum;
+    };
+
+    auto reduce_sum = [&]
+    {
+        return exec::parallel_reduce(
+            0, E, Float{0}, [&](SizeT i) { return element_energies[i]; }, std::plus<Float>{});
+    };
+
+    vector<Vector3> gradient(V);
+
+    auto atomic_scatter = [&]
+    {
+        std::ranges::fill(gradient, Vector3::Zero());
+        exec::parallel_for(0,
+                           E,
+                           [&](SizeT i)
+                           {
+                               for(SizeT k = 0; k < 4; ++k)
+                               {
+                                   const Vector3& G = element_gradients[i * 4 + k];
+                                   Vector3&       g = gradient[tets[i][k]];
+                                   for(int d = 0; d < 3; ++d)
+                                       std::atomic_ref<Float>{g[d]}.fetch_add(G[d]);
+                               }
+                           });
+    };
+
+    // every vertex sums up its own gradients in a fixed order, no write conflicts
+    auto ordered_gather = [&]
+    {
+        exec::parallel_for(0,
+                           V,
+                           [&](SizeT v)
+                           {
+                               Vector3 g = Vector3::Zero();
+                               for(IndexT k = vertex_offsets[v]; k < vertex_offsets[v + 1]; ++k)
+                                   g += element_gradients[vertex_gradient_ids[k]];
+                               gradient[v] = g;
+                           });
+    };
+
+    TripletMatrix<Float, 3>   triplets(V, V);
+    BCOOMatrix<Float, 3>      bcoo;
+    MatrixConverter<Float, 3> converter;
+
+    auto assemble_hessian = [&]
+    {
+        triplets.clear();
+        triplets.parallel_push_back(E,
+                                    [&](SizeT i, auto&& emit)
+                                    {
+                                        for(SizeT a = 0; a < 4; ++a)
+                                            for(SizeT b = 0; b < 4; ++b)
+                                            {
+                                                const Vector3& Ga = element_gradients[i * 4 + a];
+                                                const Vector3& Gb = element_gradients[i * 4 + b];
+                                                emit(tets[i][a], tets[i][b], Ga * Gb.transpose());
+                                            }
+                                    });
+        converter.convert(triplets, bcoo);
+    };
+
+    vector<S<exec::IExecutor>> executors = {uipc::make_shared<exec::ThreadPool>(1),
+                                            uipc::make_shared<exec::ThreadPool>(2),
+                                            uipc::make_shared<exec::ThreadPool>(3),
+                                            uipc::make_shared<exec::ThreadPool>(4)};
+
+    // the deterministic paths are bitwise the same on all the thread counts
+    {
+        exec::set_executor(executors.front());
+        Float expected_reduce = reduce_sum();
+        ordered_gather();
+        vector<Vector3> expected_gradient = gradient;
+        assemble_hessian();
+        vector<Matrix3x3> expected_hessian(bcoo.values().begin(), bcoo.values().end());
+
+        for(auto& e : executors)
+        {
+            exec::set_executor(e);
+            REQUIRE(reduce_sum() == expected_reduce);
+            ordered_gather();
+            REQUIRE(gradient == expected_gradient);
+            assemble_hessian();
+            REQUIRE(std::ranges::equal(bcoo.values(), expected_hessian));
+        }
+    }
+
+    for(auto& e : executors)
+    {
+        exec::set_executor(e);
+        auto threads = e->concurrency();
+
+        BENCHMARK(fmt::format("energy atomic sum, threads={}", threads))
+        {
+            return atomic_sum();
+        };
+
+        BENCHMARK(fmt::format("energy pairwise reduce, threads={}", threads))
+        {
+            return reduce_sum();
+        };
+
+        BENCHMARK(fmt::format("gradient atomic scatter, threads={}", threads))
+        {
+            atomic_scatter();
+            return gradient.size();
+        };
+
+        BENCHMARK(fmt::format("gradient ordered gather, threads={}", threads))
+        {
+            ordered_gather();
+            return gradient.size();
+        };
+
+        BENCHMARK(fmt::format("hessian triplet -> bcoo, threads={}", threads))
+        {
+            assemble_hessian();
+            return bcoo.non_zeros();
+        };
+    }
+
+    exec::set_executor(nullptr);
+}
@@ -0,0 +1,72 @@
+#include <catch.hpp>
+#include <uipc/uipc.h>
+#include <uipc/geometry/utils/distance.h>
+#include <uipc/geometry/utils/intersection.h>
+#include <random>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("batch_queries", "[geometry]")
+{
+    constexpr SizeT N = 1 << 18;
+
+    std::mt19937                          gen{42};
+    std::uniform_real_distribution<Float> dis{-1.0, 1.0};
+    std::uniform_int_distribution<IndexT> vertex{0, N - 1};
+
+    vector<Vector3>  Vs(N);
+    vector<Vector3i> Fs(N);
+    vector<Vector2i> Es(N);
+    vector<Vector2i> Pairs(N);
+    for(SizeT i = 0; i < N; ++i)
+    {
+        Vs[i]    = Vector3{dis(gen), dis(gen), dis(gen)};
+        Fs[i]    = Vector3i{vertex(gen), vertex(gen), vertex(gen)};
+        Es[i]    = Vector2i{vertex(gen), vertex(gen)};
+        Pairs[i] = Vector2i{vertex(gen), vertex(gen)};
+    }
+
+    vector<IndexT> intersected(N);
+    vector<Float>  Ds(N);
+
+    BENCHMARK(fmt::format("tri_edge_intersect per pair {}", N))
+    {
+        for(auto&& [i, FE] : enumerate(Pairs))
+        {
+            auto F = Fs[FE[0]];
+            auto E = Es[FE[1]];
+            intersected[i] = tri_edge_intersect(
+                Vs[F[0]], Vs[F[1]], Vs[F[2]], Vs[E[0]], Vs[E[1]]);
+        }
+        return intersected.size();
+    };
+
+    BENCHMARK(fmt::format("point_triangle_squared_distance per pair {}", N))
+    {
+        for(auto&& [i, PT] : enumerate(Pairs))
+        {
+            auto F = Fs[PT[1]];
+            Ds[i]  = point_triangle_squared_distance(
+                Vs[PT[0]], Vs[F[0]], Vs[F[1]], Vs[F[2]]);
+        }
+        return Ds.size();
+    };
+
+    for(auto [name, policy] : {std::pair{"serial", ExecutionPolicy::Serial},
+                               std::pair{"parallel", ExecutionPolicy::Parallel},
+                               std::pair{"simd", ExecutionPolicy::Simd}})
+    {
+        BENCHMARK(fmt::format("tri_edge_intersect {} {}", name, N))
+        {
+            tri_edge_intersect(Pairs, Vs, Fs, Es, intersected, policy);
+            return intersected.size();
+        };
+
+        BENCHMARK(fmt::format("point_triangle_squared_distance {} {}", name, N))
+        {
+            point_triangle_squared_distance(Pairs, Vs, Fs, Ds, policy);
+            return Ds.size();
+        };
+    }
+}
@@ -0,0 +1,134 @@
+#include <app/test_common.h>
+#include <uipc/common/exec.h>
+#include <uipc/common/exception.h>
+#include <atomic>
+#include <numeric>
+#include <random>
+
+using namespace uipc;
+
+TEST_CASE("exec", "[exec]")
+{
+    std::mt19937                          gen(42);
+    std::uniform_real_distribution<Float> dis(-1.0, 1.0);
+
+    constexpr SizeT N = 100000;
+    vector<Float>   values(N);
+    for(auto& v : values)
+        v = dis(gen);
+
+    vector<S<exec::IExecutor>> executors = {uipc::make_shared<exec::SerialExecutor>(),
+                                            uipc::make_shared<exec::ThreadPool>(1),
+                                            uipc::make_shared<exec::ThreadPool>(2),
+                                            uipc::make_shared<exec::ThreadPool>(4)};
+
+    SECTION("parallel_for")
+    {
+        for(auto& e : executors)
+        {
+            exec::set_executor(e);
+
+            vector<IndexT> hits(N, 0);
+            exec::parallel_for(0, N, [&](SizeT i) { hits[i]++; }, 100);
+            REQUIRE(std::ranges::all_of(hits, [](IndexT h) { return h == 1; }));
+
+            // nested calls run on the same executor
+            constexpr SizeT    M     = 64;
+            std::atomic<SizeT> count = 0;
+            exec::parallel_for(0,
+                               M,
+                               [&](SizeT)
+                               {
+                                   exec::parallel_for(
+                                       0, M, [&](SizeT) { count++; }, 1);
+                               },
+                               1);
+            REQUIRE(count == M * M);
+
+            REQUIRE_THROWS_AS(exec::parallel_for(0,
+                                                 N,
+                                                 [&](SizeT i)
+                                                 {
+                                                     if(i == N / 2)
+                                                         throw Exception{"failed"};
+                                                 },
+                                                 100),
+                              Exception);
+        }
+    }
+
+    SECTION("parallel_reduce")
+    {
+        // the floating point sum is bitwise the same on all the executors
+        exec::set_executor(executors.front());
+        auto sum = [&]
+        {
+            return exec::parallel_reduce(
+                0, N, Float{0}, [&](SizeT i) { return values[i]; }, std::plus<Float>{}, 256);
+        };
+        Float expected = sum();
+        REQUIRE(expected == Approx(std::accumulate(values.begin(), values.end(), Float{0})));
+
+        for(auto& e : executors)
+        {
+            exec::set_executor(e);
+            for(int k = 0; k < 8; ++k)
+                REQUIRE(sum() == expected);
+        }
+
+        REQUIRE(exec::parallel_reduce(
+                    0, 0, Float{1}, [&](SizeT i) { return values[i]; }, std::plus<Float>{})
+                == 1);
+    }
+
+    SECTION("parallel_scan")
+    {
+        vector<IndexT> counts(N);
+        std::uniform_int_distribution<IndexT> pick(0, 8);
+        for(auto& c : counts)
+            c = pick(gen);
+
+        vector<IndexT> expected(N);
+        std::exclusive_scan(counts.begin(), counts.end(), expected.begin(), 0);
+        IndexT total = std::accumulate(counts.begin(), counts.end(), 0);
+
+        for(auto& e : executors)
+        {
+            exec::set_executor(e);
+
+            vector<IndexT> offsets(N);
+            REQUIRE(exec::parallel_scan<IndexT>(counts, offsets, 0, std::plus<IndexT>{}, 1000)
+                    == total);
+            REQUIRE(offsets == expected);
+
+            // in place
+            offsets = counts;
+            exec::parallel_scan<IndexT>(offsets, offsets, 0, std::plus<IndexT>{}, 1000);
+            REQUIRE(offsets == expected);
+        }
+    }
+
+    SECTION("replace_executor")
+    {
+        // the running call keeps its executor alive
+        exec::set_executor(uipc::make_shared<exec::ThreadPool>(4));
+
+        std::atomic<SizeT> count = 0;
+        exec::parallel_for(
+            0,
+            N,
+            [&](SizeT i)
+            {
+                if(i == 0)
+                    exec::set_executor(uipc::make_shared<exec::SerialExecutor>());
+                count++;
+            },
+            100);
+        REQUIRE(count == N);
+        REQUIRE(exec::executor()->concurrency() == 1);
+    }
+
+    // back to the default executor from uipc::config()
+    exec::set_executor(nullptr);
+    REQUIRE(exec::executor()->concurrency() >= 1);
+}
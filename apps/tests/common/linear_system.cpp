@@ -0,0 +1,127 @@
+#include <app/test_common.h>
+#include <uipc/common/linear_system/matrix_converter.h>
+#include <uipc/common/linear_system/spmv.h>
+#include <uipc/common/linear_system/pcg.h>
+#include <random>
+
+using namespace uipc;
+
+TEST_CASE("linear_system", "[linear_system]")
+{
+    constexpr SizeT block_count = 500;
+    using Block                 = Matrix3x3;
+
+    // springs between random pairs of blocks (each pair assembled twice) plus a mass on each block,
+    // the matrix is symmetric positive definite
+    std::mt19937                          gen(42);
+    std::uniform_int_distribution<IndexT> pick(0, block_count - 1);
+    std::uniform_real_distribution<Float> coef(-1.0, 1.0);
+
+    vector<Vector2i> pairs;
+    vector<Block>    stiffness;
+    for(SizeT e = 0; e < 4 * block_count; ++e)
+    {
+        Vector2i pair{pick(gen), pick(gen)};
+        if(pair[0] == pair[1])
+            continue;
+        Block R;
+        for(auto& v : R.reshaped())
+            v = coef(gen);
+        pairs.push_back(pair);
+        stiffness.push_back(R * R.transpose());
+    }
+
+    TripletMatrix<Float, 3> triplets{block_count, block_count};
+    triplets.parallel_push_back(block_count,
+                                [&](SizeT i, auto&& emit)
+                                { emit(i, i, Block::Identity()); });
+    for(int repeat = 0; repeat < 2; ++repeat)
+    {
+        triplets.parallel_push_back(pairs.size(),
+                                    [&](SizeT e, auto&& emit)
+                                    {
+                                        auto [i, j] = std::pair{pairs[e][0], pairs[e][1]};
+                                        emit(i, i, stiffness[e]);
+                                        emit(i, j, -stiffness[e]);
+                                        emit(j, i, -stiffness[e]);
+                                        emit(j, j, stiffness[e]);
+                                    });
+    }
+    REQUIRE(triplets.triplet_count() == block_count + 8 * pairs.size());
+
+    // the dense reference
+    Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(block_count * 3, block_count * 3);
+    for(SizeT k = 0; k < triplets.triplet_count(); ++k)
+        dense.block<3, 3>(triplets.row_indices()[k] * 3, triplets.col_indices()[k] * 3) +=
+            triplets.values()[k];
+
+    Eigen::VectorXd x = Eigen::VectorXd::NullaryExpr(block_count * 3, [&] { return coef(gen); });
+    Eigen::VectorXd y_ref = dense * x;
+
+    auto as_span = [](Eigen::VectorXd& v) { return span<Float>{v.data(), static_cast<SizeT>(v.size())}; };
+
+    MatrixConverter<Float, 3> converter;
+    BCOOMatrix<Float, 3>      bcoo;
+    converter.convert(triplets, bcoo);
+
+    SECTION("bcoo")
+    {
+        auto rows = bcoo.row_indices();
+        auto cols = bcoo.col_indices();
+        for(SizeT k = 1; k < bcoo.non_zeros(); ++k)
+            REQUIRE(std::pair{rows[k - 1], cols[k - 1]} < std::pair{rows[k], cols[k]});
+
+        Eigen::MatrixXd from_bcoo = Eigen::MatrixXd::Zero(dense.rows(), dense.cols());
+        for(SizeT k = 0; k < bcoo.non_zeros(); ++k)
+            from_bcoo.block<3, 3>(rows[k] * 3, cols[k] * 3) = bcoo.values()[k];
+        REQUIRE((from_bcoo - dense).norm() <= 1e-12 * dense.norm());
+    }
+
+    SECTION("spmv")
+    {
+        BSRMatrix<Float, 3> bsr;
+        converter.convert(bcoo, bsr);
+
+        Eigen::VectorXd y = Eigen::VectorXd::Ones(x.size());
+        spmv<Float, 3>(2.0, bsr, as_span(x), 1.0, as_span(y));
+        REQUIRE((y - (2.0 * y_ref + Eigen::VectorXd::Ones(x.size()))).norm() <= 1e-10 * y_ref.norm());
+
+        // symmetric storage
+        BCOOMatrix<Float, 3> upper = bcoo;
+        converter.ge2sym(upper);
+        REQUIRE(upper.non_zeros() == (bcoo.non_zeros() + block_count) / 2);
+
+        BSRMatrix<Float, 3> sym;
+        converter.convert(upper, sym);
+
+        y.setConstant(std::numeric_limits<Float>::quiet_NaN());
+        sym_spmv<Float, 3>(1.0, sym, as_span(x), 0.0, as_span(y));
+        REQUIRE((y - y_ref).norm() <= 1e-10 * y_ref.norm());
+
+        BCOOMatrix<Float, 3> full;
+        converter.sym2ge(upper, full);
+        REQUIRE(std::ranges::equal(full.row_indices(), bcoo.row_indices()));
+        REQUIRE(std::ranges::equal(full.col_indices(), bcoo.col_indices()));
+        for(SizeT k = 0; k < full.non_zeros(); ++k)
+            REQUIRE(full.values()[k].isApprox(bcoo.values()[k]));
+    }
+
+    SECTION("pcg")
+    {
+        converter.ge2sym(bcoo);
+        BSRMatrix<Float, 3> sym;
+        converter.convert(bcoo, sym);
+
+        BlockJacobiPreconditioner<Float, 3> P;
+        P.build(sym);
+
+        Eigen::VectorXd solution = Eigen::VectorXd::Zero(x.size());
+        auto            A        = [&](span<const Float> p, span<Float> Ap)
+        { sym_spmv<Float, 3>(1.0, sym, p, 0.0, Ap); };
+
+        auto iter = pcg<Float>(A, P, as_span(solution), as_span(y_ref), 1e-20, 10000);
+        REQUIRE(iter > 0);
+        REQUIRE(iter < 10000);
+        REQUIRE((solution - x).norm() <= 1e-6 * x.norm());
+    }
+}
@@ -94,4 +94,124 @@ TEST_CASE("attribute_collection", "[geometry]")
         // pos has a later modification time than vel
         REQUIRE(pos->last_modified() > vel->last_modified());
     }
+
+    SECTION("attribute_key")
+    {
+        AttributeCollection foo;
+        foo.resize(10);
+        auto pos = foo.create<Vector3>(builtin::position);
+
+        // builtin names are compile-time keys
+        static_assert(builtin::position.hash() == AttributeKey::hash("position"));
+
+        REQUIRE(foo.find<Vector3>(builtin::position) == pos);
+        REQUIRE(foo.find<Vector3>("position") == pos);
+        REQUIRE(foo.find<Vector3>(std::string{"position"}) == pos);
+        REQUIRE(foo.find<Vector3>(builtin::velocity) == nullptr);
+
+        // the name of the key may be a temporary
+        {
+            std::string name = "my_attr";
+            foo.create<Float>(name);
+        }
+        REQUIRE(foo.find<Float>("my_attr") != nullptr);
+
+        // interned strings are unique
+        auto a = intern(std::string{"my_attr"});
+        auto b = intern("my_attr");
+        REQUIRE(a.data() == b.data());
+
+        foo.destroy(builtin::position);
+        REQUIRE(foo.find(builtin::position) == nullptr);
+        REQUIRE(foo.attribute_count() == 1);
+    }
+
+    SECTION("adopt")
+    {
+        AttributeCollection foo;
+        foo.resize(4);
+
+        vector<Vector3> Ps(4, Vector3::Ones());
+        const Vector3*  buffer = Ps.data();
+        auto            pos    = foo.adopt<Vector3>(builtin::position, std::move(Ps));
+        // the buffer is taken over, not copied
+        REQUIRE(pos->view().data() == buffer);
+
+        vector<IndexT> Is = {0, 1, 2, 3};
+        auto ids = foo.create_from<IndexT>("id", Is, -1);
+        REQUIRE(std::ranges::equal(ids->view(), Is));
+
+        // default value is used by the later resize
+        foo.resize(5);
+        REQUIRE(ids->view()[4] == -1);
+
+        // size mismatch and duplicated name are not allowed
+        vector<Float> Ms(3, 1.0);
+        REQUIRE_THROWS_AS(foo.create_from<Float>("mass", Ms), AttributeCollectionError);
+        REQUIRE_THROWS_AS(foo.create_from<IndexT>("id", vector<IndexT>(5)), AttributeCollectionError);
+    }
+
+    SECTION("reorder")
+    {
+        auto make = [](SizeT N)
+        {
+            AttributeCollection foo;
+            foo.resize(N);
+            auto ids   = foo.create<IndexT>("id", -1);
+            auto names = foo.create<std::string>("name", "");
+            auto id_view   = view(*ids);
+            auto name_view = view(*names);
+            for(SizeT i = 0; i < N; ++i)
+            {
+                id_view[i]   = static_cast<IndexT>(i);
+                name_view[i] = std::to_string(i);
+            }
+            return foo;
+        };
+
+        auto check = [](const AttributeCollection& foo, span<const SizeT> O)
+        {
+            auto ids   = foo.find<IndexT>("id")->view();
+            auto names = foo.find<std::string>("name")->view();
+            for(SizeT i = 0; i < O.size(); ++i)
+            {
+                if(ids[i] != static_cast<IndexT>(O[i]) || names[i] != std::to_string(O[i]))
+                    return false;
+            }
+            return true;
+        };
+
+        // small and large (chunk-parallel) permutations
+        for(SizeT N : {SizeT{7}, SizeT{1} << 17})
+        {
+            auto          foo = make(N);
+            vector<SizeT> O(N);
+            for(SizeT i = 0; i < N; ++i)
+                O[i] = (i * 5 + 3) % N;
+            foo.reorder(O);
+            REQUIRE(check(foo, O));
+        }
+
+        // a prefix with repeated indices, the tail is untouched
+        {
+            auto          foo = make(6);
+            vector<SizeT> O   = {5, 5, 0, 1};
+            foo.reorder(O);
+            REQUIRE(check(foo, O));
+            REQUIRE(foo.find<IndexT>("id")->view()[5] == 5);
+        }
+
+        // copy only the included attributes
+        {
+            auto                foo = make(4);
+            AttributeCollection bar;
+            bar.resize(4);
+            vector<SizeT>  O     = {3, 2, 1, 0};
+            vector<string> names = {"id"};
+            bar.copy_from(foo, AttributeCopy::pull(O), names);
+            REQUIRE(bar.find<IndexT>("id"));
+            REQUIRE(!bar.find<std::string>("name"));
+            REQUIRE(std::ranges::equal(bar.find<IndexT>("id")->view(), vector<IndexT>{3, 2, 1, 0}));
+        }
+    }
 }
@@ -0,0 +1,281 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/diff_sim/adjoint_solver.h>
+
+using namespace uipc;
+using namespace uipc::diff_sim;
+
+namespace
+{
+// x_i = x_{i-1} + 0.5 (x_{i-1} - x_{i-2}) + H_i^{-1} (c - P_i p), a chain of small SPD systems with a fixed pattern,
+// the residual G_i = H_i (x_i - 1.5 x_{i-1} + 0.5 x_{i-2}) - c + P_i p couples each frame to the two before it
+class ChainSystem final : public FrameSystemProvider
+{
+  public:
+    static constexpr SizeT DofCount  = 3;
+    static constexpr SizeT ParmCount = 2;
+
+    explicit ChainSystem(const Vector2& p = Vector2{0.5, -0.25})
+        : m_p(p)
+    {
+        m_checkpoints[0] = {m_x, m_x_prev};
+    }
+
+    void do_advance() override
+    {
+        ++m_frame;
+        build(m_frame);
+        VectorX b = Vector3{1, 2, 3} - m_pGpP.to_dense() * m_p;
+        VectorX x = m_x + 0.5 * (m_x - m_x_prev) + m_H.to_dense().ldlt().solve(b);
+        m_x_prev  = m_x;
+        m_x       = x;
+    }
+
+    SizeT get_frame() const override { return m_frame; }
+
+    SizeT get_parm_count() const override { return ParmCount; }
+
+    bool do_checkpoint() override
+    {
+        m_checkpoints[m_frame] = {m_x, m_x_prev};
+        return true;
+    }
+
+    bool do_recover(SizeT frame) override
+    {
+        auto it = m_checkpoints.find(frame);
+        if(it == m_checkpoints.end())
+            return false;
+        m_frame                 = frame;
+        std::tie(m_x, m_x_prev) = it->second;
+        if(frame > 0)
+            build(frame);
+        return true;
+    }
+
+    span<const Float> get_dofs() const override
+    {
+        return {m_x.data(), static_cast<SizeT>(m_x.size())};
+    }
+
+    SparseCOOView get_H() const override { return m_H; }
+    SparseCOOView get_pGpP() const override { return m_pGpP; }
+    SizeT         get_coupling_depth() const override { return 2; }
+    SparseCOOView get_pGpX(SizeT k) const override
+    {
+        return k == 1 ? m_pGpX1 : m_pGpX2;
+    }
+
+    // the reference: L = sum_i g_i . x_i is linear in p, so the central difference is exact
+    static VectorX reference(SizeT n, const std::function<VectorX(SizeT)>& g)
+    {
+        auto loss = [&](const Vector2& p)
+        {
+            ChainSystem s{p};
+            Float       L = 0;
+            for(SizeT i = 1; i <= n; ++i)
+            {
+                s.do_advance();
+                L += g(i).dot(s.m_x);
+            }
+            return L;
+        };
+
+        VectorX dLdP = VectorX::Zero(ParmCount);
+        for(SizeT j = 0; j < ParmCount; ++j)
+        {
+            Vector2 e = Vector2::Unit(j);
+            dLdP[j]   = (loss(e) - loss(-e)) / 2;
+        }
+        return dLdP;
+    }
+
+  private:
+    void build(SizeT frame)
+    {
+        Float f = static_cast<Float>(frame);
+        m_H_rows = {0, 1, 2, 0, 1};
+        m_H_cols = {0, 1, 2, 1, 0};
+        m_H_vals = {4 + f, 5, 6 + 0.5 * f, 1, 1};
+        m_H = SparseCOOView{m_H_rows, m_H_cols, m_H_vals, Vector2i{DofCount, DofCount}};
+
+        m_X1_vals.resize(m_H_vals.size());
+        m_X2_vals.resize(m_H_vals.size());
+        std::ranges::transform(m_H_vals, m_X1_vals.begin(), [](Float v) { return -1.5 * v; });
+        std::ranges::transform(m_H_vals, m_X2_vals.begin(), [](Float v) { return 0.5 * v; });
+        m_pGpX1 = SparseCOOView{m_H_rows, m_H_cols, m_X1_vals, Vector2i{DofCount, DofCount}};
+        m_pGpX2 = SparseCOOView{m_H_rows, m_H_cols, m_X2_vals, Vector2i{DofCount, DofCount}};
+
+        m_P_rows = {0, 1, 2};
+        m_P_cols = {0, 1, 1};
+        m_P_vals = {1, f, 2};
+        m_pGpP = SparseCOOView{m_P_rows, m_P_cols, m_P_vals, Vector2i{DofCount, ParmCount}};
+    }
+
+    Vector2 m_p;
+    SizeT   m_frame  = 0;
+    VectorX m_x      = VectorX::Zero(DofCount);
+    VectorX m_x_prev = VectorX::Zero(DofCount);
+
+    vector<IndexT> m_H_rows, m_H_cols, m_P_rows, m_P_cols;
+    vector<Float>  m_H_vals, m_X1_vals, m_X2_vals, m_P_vals;
+    SparseCOOView  m_H;
+    SparseCOOView  m_pGpX1;
+    SparseCOOView  m_pGpX2;
+    SparseCOOView  m_pGpP;
+
+    unordered_map<SizeT, std::pair<VectorX, VectorX>> m_checkpoints;
+};
+
+VectorX loss_gradient(SizeT frame)
+{
+    Float f = static_cast<Float>(frame);
+    return Vector3{f, 1, -f};
+}
+}  // namespace
+
+TEST_CASE("diff_sim_adjoint", "[diff_sim]")
+{
+    SECTION("revolve")
+    {
+        using Type = CheckpointSchedule::ActionType;
+
+        for(SizeT steps : {1, 2, 7, 20})
+        {
+            for(SizeT c : {0, 1, 2, 4})
+            {
+                auto schedule = CheckpointSchedule::revolve(steps, c);
+
+                // every frame is reversed once, from the last to the first
+                SizeT next    = steps;
+                SizeT current = 0;
+                vector<SizeT> checkpoints;
+                for(auto& a : schedule)
+                {
+                    switch(a.type)
+                    {
+                        case Type::Advance:
+                            REQUIRE(a.frame == current + 1);
+                            current = a.frame;
+                            break;
+                        case Type::Checkpoint: {
+                            REQUIRE(a.frame == current);
+                            // the checkpoints below the next frame to reverse are still in use
+                            auto in_use = std::ranges::count_if(
+                                checkpoints, [&](SizeT k) { return k < next; });
+                            REQUIRE(static_cast<SizeT>(in_use) + 1 <= c);
+                            checkpoints.push_back(a.frame);
+                        }
+                        break;
+                        case Type::Recover:
+                            current = a.frame;
+                            break;
+                        case Type::Backward:
+                            REQUIRE(a.frame == next);
+                            REQUIRE(current == next);
+                            --next;
+                            break;
+                    }
+                }
+                REQUIRE(next == 0);
+            }
+        }
+    }
+
+    SECTION("solve")
+    {
+        constexpr SizeT N = 12;
+
+        VectorX expected = ChainSystem::reference(N, loss_gradient);
+
+        for(SizeT c : {0, 2, 4, 16})
+        {
+            ChainSystem   system;
+            AdjointSolver solver{system, c};
+            VectorX       dLdP = solver.solve(0,
+                                        N,
+                                        [](SizeT frame, Eigen::Ref<VectorX> dLdx)
+                                        { dLdx = loss_gradient(frame); });
+
+            REQUIRE(dLdP.isApprox(expected));
+
+            // the pattern of H never changes, the symbolic analysis is done once
+            auto& stats = solver.statistics();
+            REQUIRE(stats.analyses == 1);
+            REQUIRE(stats.factorizations == N);
+            REQUIRE(stats.checkpoints <= N);
+            // enough checkpoints: each frame is recomputed once before its adjoint step
+            if(c >= N - 1)
+                REQUIRE(stats.advances == 2 * N - 1);
+        }
+
+        // an empty range
+        ChainSystem   system;
+        AdjointSolver solver{system, 2};
+        VectorX       dLdP = solver.solve(0,
+                                    0,
+                                    [](SizeT frame, Eigen::Ref<VectorX> dLdx)
+                                    { dLdx = loss_gradient(frame); });
+        REQUIRE(dLdP == VectorX::Zero(ChainSystem::ParmCount));
+    }
+
+    SECTION("host_adjoint_method")
+    {
+        constexpr SizeT N = 5;
+
+        auto system = std::make_shared<ChainSystem>();
+        auto method = std::make_shared<HostAdjointMethod>(*system, 2);
+
+        auto host_view = [](auto& v)
+        {
+            using T = std::decay_t<decltype(v[0])>;
+            return backend::BufferView{reinterpret_cast<backend::HandleT>(v.data()),
+                                       0,
+                                       v.size(),
+                                       sizeof(T),
+                                       sizeof(T),
+                                       "host"};
+        };
+
+        // nothing selected yet
+        {
+            vector<Float> dLdP(ChainSystem::ParmCount, 1.0);
+            vector<Float> dLdx;
+            method->do_compute_dLdP(host_view(dLdP), host_view(dLdx));
+            REQUIRE(std::ranges::all_of(dLdP, [](Float v) { return v == 0; }));
+        }
+
+        // select the dof 0 and 2 of every frame
+        vector<IndexT> SDI = {0, 2};
+        for(SizeT i = 1; i <= N; ++i)
+        {
+            system->do_advance();
+            method->do_select_dofs(system->get_frame(), host_view(SDI));
+        }
+
+        vector<Float> dofs(SDI.size() * N);
+        method->do_receive_dofs(host_view(dofs));
+        REQUIRE(dofs[2 * (N - 1)] == system->get_dofs()[0]);
+
+        vector<Float> dLdx(dofs.size());
+        for(SizeT i = 0; i < N; ++i)
+        {
+            auto g          = loss_gradient(i + 1);
+            dLdx[2 * i]     = g[0];
+            dLdx[2 * i + 1] = g[2];
+        }
+
+        vector<Float> dLdP(ChainSystem::ParmCount);
+        method->do_compute_dLdP(host_view(dLdP), host_view(dLdx));
+
+        VectorX expected = ChainSystem::reference(N,
+                                                  [](SizeT frame)
+                                                  {
+                                                      VectorX g = loss_gradient(frame);
+                                                      g[1]      = 0;
+                                                      return g;
+                                                  });
+        REQUIRE(Eigen::Map<VectorX>(dLdP.data(), dLdP.size()).isApprox(expected));
+    }
+}
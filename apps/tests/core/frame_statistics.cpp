@@ -0,0 +1,64 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+
+using namespace uipc;
+using namespace uipc::core;
+
+TEST_CASE("frame_statistics", "[world]")
+{
+    SECTION("ring")
+    {
+        FrameStatisticsFeature stats{4};
+        REQUIRE(stats.size() == 0);
+        REQUIRE(stats.capacity() == 4);
+
+        for(SizeT f = 1; f <= 6; ++f)
+        {
+            FrameStatisticsRecord record;
+            record.frame             = f;
+            record.newton_iterations = static_cast<IndexT>(f);
+            stats.push(record);
+        }
+
+        // only the 4 latest frames are kept, from the oldest to the latest
+        REQUIRE(stats.size() == 4);
+        REQUIRE(stats[0].frame == 3);
+        REQUIRE(stats.latest().frame == 6);
+
+        auto records = stats.records();
+        REQUIRE(records.size() == 4);
+        REQUIRE(records[1].newton_iterations == 4);
+
+        auto j = stats.to_json();
+        REQUIRE(j.size() == 4);
+        REQUIRE(j[3]["phase_times"].contains("linear_solve"));
+
+        stats.clear();
+        REQUIRE(stats.size() == 0);
+    }
+
+    SECTION("none_engine")
+    {
+        Engine engine{"none", AssetDir::output_path(__FILE__)};
+        World  world{engine};
+
+        auto config                      = Scene::default_config();
+        config["sanity_check"]["enable"] = false;
+        Scene scene{config};
+
+        world.init(scene);
+
+        for(SizeT i = 0; i < 3; ++i)
+        {
+            world.advance();
+            world.retrieve();
+        }
+
+        auto stats = engine.features().find<FrameStatisticsFeature>();
+        REQUIRE(stats);
+        REQUIRE(stats->size() == 3);
+        REQUIRE(stats->latest().frame == world.frame());
+        REQUIRE(stats->latest().newton_iterations > 0);
+    }
+}
@@ -0,0 +1,111 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/io/frame_streamer.h>
+
+TEST_CASE("frame_streamer", "[io]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+    auto  object = scene.objects().create("cubes");
+
+    SimplicialComplexIO io;
+    auto cube = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    label_surface(cube);
+
+    cube.instances().resize(2);
+    {
+        Transform t = Transform::Identity();
+        t.translate(Vector3::UnitY() * 1.5);
+        view(cube.transforms())[1] = t.matrix();
+    }
+    auto [geo_slot, rest_geo_slot] = object->geometries().create(cube);
+
+    auto json             = FrameStreamer::default_config();
+    json["slot_count"]    = 3;
+    constexpr auto stream = "uipc_test_frame_streamer";
+
+    FrameStreamer     streamer{scene, stream, json};
+    FrameStreamReader reader{stream};
+    REQUIRE(!reader.latest());
+
+    SceneIO scene_io{scene};
+
+    auto require_same_surface = [&](const FrameStreamReader::Frame& frame)
+    {
+        auto surface = scene_io.simplicial_surface();
+        REQUIRE(frame.positions().size() == surface.vertices().size());
+        REQUIRE(std::ranges::equal(frame.positions(), surface.positions().view()));
+        REQUIRE(std::ranges::equal(frame.edges(), surface.edges().topo().view()));
+        REQUIRE(std::ranges::equal(frame.triangles(), surface.triangles().topo().view()));
+    };
+
+    streamer.publish(0);
+    auto first = reader.latest();
+    REQUIRE(first);
+    REQUIRE(first->frame() == 0);
+    REQUIRE(first->generation() == 1);
+    require_same_surface(*first);
+
+    SECTION("ring")
+    {
+        // move the cubes, only the positions are published
+        for(SizeT frame = 1; frame <= 2; ++frame)
+        {
+            auto Ps = view(geo_slot->geometry().positions());
+            for(auto& P : Ps)
+                P += Vector3::UnitX();
+            streamer.publish(frame);
+        }
+
+        auto latest = reader.latest();
+        REQUIRE(latest->frame() == 2);
+        REQUIRE(latest->generation() == 1);
+        require_same_surface(*latest);
+
+        // the first frame is still in the ring, until one more frame is published
+        REQUIRE(first->is_valid());
+        streamer.publish(3);
+        REQUIRE(!first->is_valid());
+        REQUIRE(latest->is_valid());
+    }
+
+    SECTION("rewired topology")
+    {
+        // the same counts, only a triangle is flipped
+        auto tris = view(geo_slot->geometry().as<SimplicialComplex>()->triangles().topo());
+        std::swap(tris[0][1], tris[0][2]);
+
+        streamer.publish(1);
+        REQUIRE(streamer.generation() == 2);
+        require_same_surface(*reader.latest());
+    }
+
+    SECTION("name in use")
+    {
+        REQUIRE_THROWS_AS((FrameStreamer{scene, stream, json}), FrameStreamError);
+        // the stream is left intact
+        REQUIRE(reader.latest()->frame() == 0);
+    }
+
+    SECTION("topology change")
+    {
+        auto tet = io.read(fmt::format("{}tet.msh", AssetDir::tetmesh_path()));
+        label_surface(tet);
+        object->geometries().create(tet);
+
+        streamer.publish(1);
+        REQUIRE(streamer.generation() == 2);
+
+        auto latest = reader.latest();
+        REQUIRE(latest->frame() == 1);
+        REQUIRE(latest->generation() == 2);
+        require_same_surface(*latest);
+
+        // the old frame stays mapped
+        REQUIRE(first->positions().size() < latest->positions().size());
+    }
+}
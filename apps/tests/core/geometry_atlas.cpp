@@ -3,9 +3,12 @@
 #include <uipc/io/simplicial_complex_io.h>
 #include <uipc/geometry.h>
 #include <uipc/geometry/geometry_atlas.h>
+#include <uipc/geometry/attribute_deduplicator.h>
+#include <uipc/common/hash.h>
 #include <uipc/common/format.h>
 #include <fstream>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/factory_keyword.h>
 
 using namespace uipc;
 using namespace uipc::geometry;
@@ -116,3 +119,73 @@ TEST_CASE("geometry_atlas_commit", "[serialization]")
         REQUIRE(instances2_it->second->attribute_collection().size() == 2);
     }
 }
+
+TEST_CASE("geometry_atlas_deduplicate", "[serialization]")
+{
+    // the reference values of XXH64
+    REQUIRE(xxhash64("", 0) == 0xEF46DB3751D8E999ull);
+    REQUIRE(xxhash64("abc", 3) == 0x44BC2CF5AD770999ull);
+
+    SimplicialComplexIO io;
+    auto path = fmt::format("{}cube.obj", AssetDir::trimesh_path());
+
+    // the same mesh loaded twice, nothing is shared in memory
+    auto mesh_a = io.read_obj(path);
+    auto mesh_b = io.read_obj(path);
+    REQUIRE(mesh_a.positions().view().data() != mesh_b.positions().view().data());
+    REQUIRE(mesh_a.positions().is_shared() == false);
+
+    auto attribute_count = [](const Json& j)
+    { return j[builtin::__data__]["attributes"].size(); };
+
+    GeometryAtlas plain;
+    plain.create(mesh_a);
+    plain.create(mesh_b);
+    auto plain_json = plain.to_json();
+
+    GeometryAtlas dedup;
+    dedup.deduplicate(true);
+    dedup.create(mesh_a);
+    dedup.create(mesh_b);
+    auto dedup_json = dedup.to_json();
+
+    GeometryAtlas single;
+    single.deduplicate(true);
+    single.create(mesh_a);
+
+    // mesh_b adds no attribute
+    REQUIRE(attribute_count(dedup_json) == attribute_count(single.to_json()));
+    REQUIRE(attribute_count(dedup_json) < attribute_count(plain_json));
+
+    GeometryAtlas loaded;
+    loaded.from_json(dedup_json);
+    auto a = loaded.find(0)->geometry().as<SimplicialComplex>();
+    auto b = loaded.find(1)->geometry().as<SimplicialComplex>();
+    REQUIRE(a->to_json() == mesh_a.to_json());
+    REQUIRE(b->to_json() == mesh_b.to_json());
+    REQUIRE(a->positions().view().data() == b->positions().view().data());
+
+    SECTION("in_memory")
+    {
+        auto mesh_c = io.read_obj(path);
+        auto mesh_d = io.read_obj(path);
+        mesh_d.positions().is_evolving(true);
+        mesh_d.vertices().create<IndexT>("label", 0);
+
+        AttributeDeduplicator deduplicator;
+        REQUIRE(deduplicator.deduplicate(mesh_c) == 0);
+        REQUIRE(deduplicator.deduplicate(mesh_d) > 0);
+        REQUIRE(deduplicator.released_bytes() > 0);
+
+        // shared, the slots keep their names and flags
+        REQUIRE(mesh_c.positions().view().data() == mesh_d.positions().view().data());
+        REQUIRE(mesh_d.positions().is_evolving());
+        REQUIRE(mesh_d.vertices().find<IndexT>("label")->name() == "label");
+
+        // copy on write
+        auto pos = view(mesh_d.positions());
+        pos[0]   = Vector3::Ones();
+        REQUIRE(mesh_c.positions().view()[0] != Vector3::Ones());
+        REQUIRE(mesh_c.positions().is_shared() == false);
+    }
+}
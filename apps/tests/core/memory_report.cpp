@@ -0,0 +1,64 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+
+struct MemoryReportTest;
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<MemoryReportTest>
+{
+  public:
+    static const IAttribute& attribute(const IAttributeSlot& slot)
+    {
+        return slot.attribute();
+    }
+};
+}  // namespace uipc::geometry
+
+TEST_CASE("memory_report", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+    using AF = AttributeFriend<MemoryReportTest>;
+
+    auto arena = create_memory_resource({{"type", "pool"}});
+
+    Scene scene;
+    {
+        MemoryResourceGuard guard{arena.get()};
+
+        auto object = scene.objects().create("cube");
+
+        SimplicialComplexIO io;
+        auto mesh = io.read_msh(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+        auto velocity = mesh.vertices().create<Vector3>("velocity");
+        REQUIRE(velocity->view().size() == mesh.vertices().size());
+
+        // the attributes created in the scope are allocated from the arena
+        auto pos = mesh.vertices().find<Vector3>(builtin::position);
+        REQUIRE(view(*pos).size() == mesh.vertices().size());
+        REQUIRE(AF::attribute(*pos).memory_resource() == arena.get());
+        REQUIRE(AF::attribute(*velocity).memory_resource() == arena.get());
+
+        object->geometries().create(mesh);
+        object->geometries().create(mesh);
+    }
+
+    Json report = scene.memory_report();
+
+    REQUIRE(report["geometries"]["count"].get<SizeT>() == 2);
+    REQUIRE(report["geometries"]["geometries"].size() == 2);
+
+    auto geo_bytes = report["geometries"]["bytes"].get<SizeT>();
+    REQUIRE(geo_bytes > 0);
+
+    auto& vertices = report["geometries"]["geometries"][0]["collections"]["vertices"];
+    REQUIRE(vertices["attributes"]["velocity"].get<SizeT>() > 0);
+
+    // the two geometries share the same attributes (copy on write),
+    // so the unique bytes should be less than the total bytes
+    REQUIRE(report["unique_bytes"].get<SizeT>() < report["total_bytes"].get<SizeT>());
+}
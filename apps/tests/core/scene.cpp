@@ -269,6 +269,74 @@ TEST_CASE("pending_destroy", "[scene]")
     }
 }
 
+TEST_CASE("geometry_collection_order", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    SimplicialComplex mesh;
+    mesh.vertices().resize(4);
+
+    GeometryCollection gc;
+
+    auto ids_of = [](span<S<GeometrySlot>> slots)
+    {
+        vector<IndexT> ids;
+        for(auto& slot : slots)
+            ids.push_back(slot->id());
+        return ids;
+    };
+
+    constexpr IndexT N = 10;
+    for(IndexT i = 0; i < N; ++i)
+        gc.emplace(mesh);
+
+    // 10, 11, 12 are pending, 13 is created immediately
+    gc.pending_emplace(mesh);
+    gc.pending_emplace(mesh);
+    gc.pending_emplace(mesh);
+    gc.emplace(mesh);
+
+    gc.destroy(3);
+    gc.pending_destroy(5);
+    gc.pending_destroy(1);
+    REQUIRE_ALL_INFO(gc.pending_destroy(11));  // cancel the creation
+
+    REQUIRE(gc.size() == N);
+    REQUIRE(!gc.find(3));
+    REQUIRE(!gc.find(5));
+    REQUIRE(!gc.find(11));
+    REQUIRE(gc.find(10));
+    REQUIRE(gc.find(13));
+    REQUIRE(ids_of(gc.pending_create_slots()) == vector<IndexT>{10, 12});
+    REQUIRE(std::ranges::equal(gc.pending_destroy_ids(), vector<IndexT>{1, 5}));
+    REQUIRE(ids_of(gc.geometry_slots()) == vector<IndexT>{0, 1, 2, 4, 5, 6, 7, 8, 9, 13});
+
+    gc.solve_pending();
+
+    REQUIRE(gc.size() == N);
+    REQUIRE(gc.pending_create_slots().empty());
+    REQUIRE(gc.pending_destroy_ids().empty());
+    REQUIRE(ids_of(gc.geometry_slots()) == vector<IndexT>{0, 2, 4, 6, 7, 8, 9, 10, 12, 13});
+
+    for(auto& slot : gc.geometry_slots())
+    {
+        REQUIRE(gc.find(slot->id()) == slot);
+        REQUIRE(slot->state() == GeometrySlotState::Normal);
+    }
+
+    // nothing pending, nothing changes
+    auto slots = gc.geometry_slots();
+    gc.solve_pending();
+    REQUIRE(gc.geometry_slots().data() == slots.data());
+
+    GeometryCollection copy{gc};
+    REQUIRE(ids_of(copy.geometry_slots()) == ids_of(gc.geometry_slots()));
+    REQUIRE(copy.find(12));
+    REQUIRE(!copy.find(11));
+}
+
 TEST_CASE("scene_commit", "[scene]")
 {
     using namespace uipc;
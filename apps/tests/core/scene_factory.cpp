@@ -7,6 +7,7 @@
 #include <uipc/geometry/geometry_atlas.h>
 #include <uipc/common/format.h>
 #include <fstream>
+#include <sstream>
 
 using namespace uipc;
 using namespace uipc::core;
@@ -44,4 +45,45 @@ TEST_CASE("scene_factory", "[serialization]")
     REQUIRE(positions.size() == loaded_positions.size());
     REQUIRE(vector<Vector3>{positions.begin(), positions.end()}
             == vector<Vector3>{loaded_positions.begin(), loaded_positions.end()});
-}
\ No newline at end of file
+}
+
+TEST_CASE("scene_factory_stream", "[serialization]")
+{
+    SimplicialComplexIO io;
+    auto mesh = io.read_obj(fmt::format("{}cube.obj", AssetDir::trimesh_path()));
+
+    Scene scene;
+    auto  cube = scene.objects().create("cube");
+    cube->geometries().create(mesh);
+
+    SceneFactory sf;
+    auto         snapshot = SceneSnapshot{scene};
+    auto         j        = sf.to_json(snapshot);
+
+    for(auto format : {JsonFormat::Json, JsonFormat::Bson})
+    {
+        std::stringstream ss;
+        sf.to_stream(snapshot, ss, format, 4);
+
+        // the same document as to_json()
+        auto str = ss.str();
+        auto streamed = format == JsonFormat::Json ? Json::parse(str) : Json::from_bson(str);
+        REQUIRE(streamed == j);
+
+        auto new_scene = sf.from_snapshot(sf.from_stream(ss, format));
+        auto [geo_slot, rest_geo_slot] = new_scene.geometries().find(0);
+        auto sc = geo_slot->geometry().as<SimplicialComplex>();
+
+        auto positions        = mesh.positions().view();
+        auto loaded_positions = sc->positions().view();
+        REQUIRE(vector<Vector3>{positions.begin(), positions.end()}
+                == vector<Vector3>{loaded_positions.begin(), loaded_positions.end()});
+    }
+
+    // documents built by to_json() can be streamed in as well
+    {
+        std::stringstream ss{j.dump()};
+        auto              new_scene = sf.from_snapshot(sf.from_stream(ss, JsonFormat::Json));
+        REQUIRE(new_scene.geometries().find(0).geometry);
+    }
+}
@@ -0,0 +1,98 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+
+TEST_CASE("scene_history", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene               scene;
+    SimplicialComplexIO io;
+    auto mesh   = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    auto object = scene.objects().create("cube");
+    auto [geo_slot, rest_geo_slot] = object->geometries().create(mesh);
+    auto id                        = geo_slot->id();
+
+    auto json            = SceneHistory::default_config();
+    json["max_versions"] = 4;
+    SceneHistory history{scene, json};
+
+    auto v0 = history.commit();
+
+    // move the cube
+    auto geo = geo_slot->geometry().as<SimplicialComplex>();
+    for(auto& P : view(geo->positions()))
+        P += Vector3::UnitX();
+    auto v1 = history.commit();
+
+    REQUIRE(history.geometry_version(v1, id) == v1);
+    REQUIRE(history.attribute_version(v1, id, "vertices", "position") == v1);
+    REQUIRE(history.attribute_version(v1, id, "instances", "transform") == v0);
+    REQUIRE(history.attribute_version(v0, id, "vertices", "position") == v0);
+    REQUIRE(!history.attribute_version(v1, id, "vertices", "no_such_attribute"));
+
+    // add another cube, the first one is untouched
+    auto [new_geo_slot, new_rest_geo_slot] = object->geometries().create(mesh);
+    auto v2                                = history.commit();
+    REQUIRE(history.geometry_version(v2, id) == v1);
+    REQUIRE(!history.geometry_version(v1, new_geo_slot->id()));
+
+    SECTION("diff")
+    {
+        auto commit = history.diff(v2, v1);
+        REQUIRE(commit.geometries().size() == 1);
+        REQUIRE(commit.geometries().at(new_geo_slot->id())->is_new());
+
+        // nothing changed
+        auto v3 = history.commit();
+        REQUIRE(history.diff(v3, v2).geometries().empty());
+
+        // only the position is changed
+        auto forward = history.diff(v1, v0);
+        auto& vertices = forward.geometries().at(id)->attribute_collections().at("vertices");
+        REQUIRE(vertices->attribute_collection().attribute_count() == 1);
+        REQUIRE(vertices->attribute_collection().find("position"));
+    }
+
+    SECTION("undo")
+    {
+        auto undo = history.diff(v0, v2);
+        // the second cube is created after v0
+        REQUIRE(undo.removed_geometries() == vector<IndexT>{new_geo_slot->id()});
+        REQUIRE(undo.removed_rest_geometries() == vector<IndexT>{new_rest_geo_slot->id()});
+
+        scene.update_from(undo);
+        REQUIRE(std::ranges::equal(geo->positions().view(), mesh.positions().view()));
+        REQUIRE(!scene.geometries().find(new_geo_slot->id()).geometry);
+        REQUIRE(scene.geometries().find(id).geometry);
+
+        // and redo
+        scene.update_from(history.diff(v1, v0));
+        REQUIRE(!std::ranges::equal(geo->positions().view(), mesh.positions().view()));
+    }
+
+    SECTION("snapshot")
+    {
+        SceneFactory sf;
+        Scene        old_scene = sf.from_snapshot(history.snapshot(v0));
+
+        auto [old_geo_slot, old_rest_geo_slot] = old_scene.geometries().find(id);
+        auto old_geo = old_geo_slot->geometry().as<SimplicialComplex>();
+        REQUIRE(std::ranges::equal(old_geo->positions().view(), mesh.positions().view()));
+        REQUIRE(!old_scene.geometries().find(new_geo_slot->id()).geometry);
+    }
+
+    SECTION("retention")
+    {
+        for(int i = 0; i < 3; ++i)
+            history.commit();
+
+        REQUIRE(history.size() == 4);
+        REQUIRE(history.oldest() == v2);
+        REQUIRE(!history.contains(v1));
+        REQUIRE_THROWS_AS(history.snapshot(v1), SceneHistoryError);
+        REQUIRE(history.geometry_version(history.latest(), id) == v1);
+    }
+}
@@ -1,6 +1,8 @@
 #include <app/test_common.h>
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
+#include <filesystem>
+#include <fstream>
 
 TEST_CASE("scene_io", "[scene]")
 {
@@ -58,3 +60,79 @@ TEST_CASE("scene_io", "[scene]")
     auto objects_found = scene_loaded.objects().find("objects");
     REQUIRE(objects_found.size() == 1);
 }
+
+TEST_CASE("scene_io_lazy_load", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+    auto  object = scene.objects().create("objects");
+
+    SimplicialComplexIO io;
+    auto cube_mesh = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    auto tet_mesh  = io.read(fmt::format("{}tet.msh", AssetDir::tetmesh_path()));
+    object->geometries().create(cube_mesh);
+    object->geometries().create(tet_mesh);
+
+    auto output = AssetDir::output_path(__FILE__);
+
+    for(std::string ext : {".json", ".bson"})
+    {
+        auto file     = fmt::format("{}lazy_scene{}", output, ext);
+        auto file_out = fmt::format("{}lazy_scene_out{}", output, ext);
+        SceneIO{scene}.save(file);
+
+        auto lazy_scene = SceneIO::load(file, true);
+        REQUIRE(lazy_scene.objects().find(0)->name() == object->name());
+
+        auto [geo_0, rest_geo_0] = lazy_scene.geometries().find(0);
+        auto [geo_1, rest_geo_1] = lazy_scene.geometries().find(1);
+        REQUIRE(!geo_0->is_loaded());
+        REQUIRE(!geo_1->is_loaded());
+        REQUIRE(!rest_geo_0->is_loaded());
+
+        // untouched geometries are copied from the file
+        SceneIO{lazy_scene}.save(file_out);
+        REQUIRE(!geo_0->is_loaded());
+
+        auto read = [](const std::string& f)
+        {
+            std::ifstream is{f, std::ios::binary};
+            return std::string{std::istreambuf_iterator<char>{is}, {}};
+        };
+        REQUIRE(read(file_out) == read(file));
+
+        // decoded on first access
+        auto [src_geo_1, src_rest_geo_1] = scene.geometries().find(1);
+        REQUIRE(geo_1->geometry().to_json() == src_geo_1->geometry().to_json());
+        REQUIRE(geo_1->is_loaded());
+        REQUIRE(!geo_0->is_loaded());
+
+        // edit one geometry and save over the file being read
+        auto mesh = geo_1->geometry().as<SimplicialComplex>();
+        view(mesh->positions())[0] = Vector3::Constant(42);
+        SceneIO{lazy_scene}.save(file);
+
+        auto loaded = SceneIO::load(file);
+        auto [loaded_geo_0, loaded_rest_geo_0] = loaded.geometries().find(0);
+        auto [loaded_geo_1, loaded_rest_geo_1] = loaded.geometries().find(1);
+        auto [src_geo_0, src_rest_geo_0]       = scene.geometries().find(0);
+        REQUIRE(loaded_geo_0->geometry().to_json() == src_geo_0->geometry().to_json());
+        REQUIRE(loaded_geo_1->geometry().as<SimplicialComplex>()->positions().view()[0]
+                == Vector3::Constant(42));
+
+        // the file was released before being replaced, the lazy scene decodes from the bytes in memory
+        REQUIRE(!geo_0->is_loaded());
+        REQUIRE(geo_0->geometry().to_json() == src_geo_0->geometry().to_json());
+
+        // a truncated file throws on access, instead of leaving an empty geometry
+        auto broken_scene = SceneIO::load(file, true);
+        std::filesystem::resize_file(file, 0);
+        auto [broken_geo_0, broken_rest_geo_0] = broken_scene.geometries().find(0);
+        REQUIRE_THROWS_AS(broken_geo_0->geometry(), SceneIOError);
+        REQUIRE(!broken_geo_0->is_loaded());
+        REQUIRE_THROWS_AS(broken_geo_0->geometry(), SceneIOError);
+    }
+}
@@ -0,0 +1,110 @@
+#include <app/test_common.h>
+#include <uipc/uipc.h>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("topology_change", "[simplicial_complex]")
+{
+    //  3 --- 2
+    //  |   / |
+    //  |  /  |
+    //  | /   |
+    //  0 --- 1
+    vector<Vector3>  Vs = {Vector3{0, 0, 0}, Vector3{1, 0, 0}, Vector3{1, 1, 0}, Vector3{0, 1, 0}};
+    vector<Vector3i> Fs = {Vector3i{0, 1, 2}, Vector3i{0, 2, 3}};
+
+    auto mesh = trimesh(Vs, Fs);
+
+    auto mass = mesh.vertices().create<Float>("mass", 0.0);
+    std::ranges::copy(vector<Float>{1, 2, 3, 4}, view(*mass).begin());
+    auto tag = mesh.triangles().create<IndexT>("tag", -1);
+    std::ranges::copy(vector<IndexT>{10, 20}, view(*tag).begin());
+
+    SECTION("tear")
+    {
+        // tear along the diagonal: the second triangle gets its own copies of vertex 0 and 2
+        TopologyChange change;
+        change.vertices().insert(0);  // -> 4
+        change.vertices().insert(2);  // -> 5
+        change.triangles().remove(1);
+        change.triangles().insert(1, Vector3i{4, 5, 3});
+
+        REQUIRE(change.vertex_remap(4) == vector<IndexT>{0, 1, 2, 3});
+
+        apply_topology_change(mesh, change);
+
+        REQUIRE(mesh.vertices().size() == 6);
+        REQUIRE(mesh.triangles().size() == 2);
+
+        auto Ps = mesh.positions().view();
+        REQUIRE(Ps[4] == Vs[0]);
+        REQUIRE(Ps[5] == Vs[2]);
+        REQUIRE(std::ranges::equal(mesh.vertices().find<Float>("mass")->view(),
+                                   vector<Float>{1, 2, 3, 4, 1, 3}));
+
+        auto Ts = mesh.triangles().topo().view();
+        REQUIRE(Ts[0] == Fs[0]);
+        REQUIRE(Ts[1] == Vector3i{4, 5, 3});
+        REQUIRE(std::ranges::equal(mesh.triangles().find<IndexT>("tag")->view(),
+                                   vector<IndexT>{10, 20}));
+    }
+
+    SECTION("remove")
+    {
+        // remove the first triangle and the vertex 1 with its edges
+        TopologyChange change;
+        change.triangles().remove(0);
+        change.vertices().remove(1);
+
+        auto Es = mesh.edges().topo().view();
+        for(auto&& [I, E] : enumerate(Es))
+        {
+            if(E[0] == 1 || E[1] == 1)
+                change.edges().remove(static_cast<IndexT>(I));
+        }
+
+        // a new vertex with the default values
+        change.vertices().insert(-1);
+
+        REQUIRE(change.vertex_remap(4) == vector<IndexT>{0, -1, 1, 2});
+
+        auto edge_count = mesh.edges().size();
+        apply_topology_change(mesh, change);
+
+        REQUIRE(mesh.vertices().size() == 4);
+        REQUIRE(mesh.edges().size() == edge_count - 2);
+        REQUIRE(mesh.triangles().size() == 1);
+        REQUIRE(mesh.triangles().topo().view()[0] == Vector3i{0, 1, 2});
+        REQUIRE(mesh.triangles().find<IndexT>("tag")->view()[0] == 20);
+        REQUIRE(std::ranges::equal(mesh.vertices().find<Float>("mass")->view(),
+                                   vector<Float>{1, 3, 4, 0}));
+
+        for(auto& E : mesh.edges().topo().view())
+            REQUIRE((E.array() >= 0 && E.array() < 3).all());
+    }
+
+    SECTION("invalid")
+    {
+        auto topo_before = mesh.triangles().topo().view();
+        vector<Vector3i> Ts{topo_before.begin(), topo_before.end()};
+
+        // the triangles still refer to vertex 1
+        TopologyChange change;
+        change.vertices().remove(1);
+        REQUIRE_THROWS_AS(apply_topology_change(mesh, change), TopologyChangeError);
+
+        change.clear();
+        change.triangles().remove(0);
+        change.triangles().remove(0);
+        REQUIRE_THROWS_AS(apply_topology_change(mesh, change), TopologyChangeError);
+
+        change.clear();
+        change.triangles().insert(0, Vector3i{0, 1, 4});
+        REQUIRE_THROWS_AS(apply_topology_change(mesh, change), TopologyChangeError);
+
+        // nothing is modified
+        REQUIRE(mesh.vertices().size() == 4);
+        REQUIRE(std::ranges::equal(mesh.triangles().topo().view(), Ts));
+    }
+}
@@ -0,0 +1,58 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+
+using namespace uipc;
+using namespace uipc::core;
+using namespace uipc::geometry;
+
+TEST_CASE("world_batch", "[world]")
+{
+    constexpr SizeT N = 4;
+
+    auto config                      = Scene::default_config();
+    config["sanity_check"]["enable"] = true;
+    config["sanity_check"]["mode"]   = "quiet";
+
+    SimplicialComplexIO io;
+    auto mesh = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    label_surface(mesh);
+    label_triangle_orient(mesh);
+
+    // identical scenes share one sanity check
+    vector<U<Scene>> scenes;
+    vector<Scene*>   scene_ptrs;
+    for(SizeT i = 0; i < N; ++i)
+    {
+        auto& scene = scenes.emplace_back(uipc::make_unique<Scene>(config));
+        scene->objects().create("cube")->geometries().create(mesh);
+        scene_ptrs.push_back(scene.get());
+    }
+
+    WorldBatch batch{"none", AssetDir::output_path(__FILE__)};
+    batch.init(scene_ptrs);
+
+    REQUIRE(batch.size() == N);
+    REQUIRE(std::ranges::all_of(batch.valid(), [](bool v) { return v; }));
+
+    for(SizeT f = 0; f < 3; ++f)
+    {
+        batch.advance();
+        batch.retrieve();
+    }
+
+    REQUIRE(batch.frame() == 3);
+    REQUIRE(std::ranges::all_of(batch.frames(), [](SizeT f) { return f == 3; }));
+
+    vector<Vector3> Xs;
+    auto            offsets = batch.gather<Vector3>(builtin::position, Xs);
+
+    auto v_count = mesh.vertices().size();
+    REQUIRE(offsets.size() == N + 1);
+    REQUIRE(Xs.size() == N * v_count);
+    for(SizeT i = 0; i < N; ++i)
+        REQUIRE(offsets[i] == i * v_count);
+
+    auto src = mesh.positions().view();
+    REQUIRE(std::equal(src.begin(), src.end(), Xs.begin() + offsets[N - 1]));
+}
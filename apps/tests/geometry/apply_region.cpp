@@ -1,6 +1,8 @@
 #include <app/test_common.h>
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
+#include <numeric>
+#include <random>
 
 using namespace uipc;
 using namespace uipc::geometry;
@@ -81,6 +83,7 @@ TEST_CASE("apply_region", "[connected_components]")
         {
             auto region_count = apart_mesh.meta().find<IndexT>("region_count");
             REQUIRE(!region_count);  // the region_count attribute should be removed
+            REQUIRE(!apart_mesh.meta().find<VectorXi>("region_vertex_count"));
 
             auto vert_region = apart_mesh.vertices().find<IndexT>("region");
 
@@ -108,3 +111,70 @@ TEST_CASE("apply_region", "[connected_components]")
         io.write(fmt::format("{}apart_mesh_1.obj", output_path), apart_meshes[1]);
     }
 }
+
+TEST_CASE("label_connected_vertices", "[connected_components]")
+{
+    // many random chains of vertices, the edges are shuffled
+    constexpr SizeT N = 200000;
+
+    std::mt19937                          gen(7);
+    std::uniform_int_distribution<IndexT> cut(0, 15);
+
+    vector<Vector3>  Vs(N, Vector3::Zero());
+    vector<Vector2i> Es;
+    vector<IndexT>   perm(N);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::shuffle(perm, gen);
+    for(SizeT i = 1; i < N; ++i)
+        if(cut(gen) != 0)  // break the chain now and then
+            Es.push_back({perm[i - 1], perm[i]});
+    std::ranges::shuffle(Es, gen);
+
+    auto mesh = linemesh(Vs, Es);
+    label_connected_vertices(mesh);
+    label_region(mesh);
+
+    // serial reference, regions are numbered in the order of their smallest vertex
+    vector<IndexT> parent(N);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](IndexT x)
+    {
+        while(parent[x] != x)
+            x = parent[x] = parent[parent[x]];
+        return x;
+    };
+    for(auto& e : Es)
+    {
+        auto a = find(e[0]), b = find(e[1]);
+        parent[std::max(a, b)] = std::min(a, b);
+    }
+    vector<IndexT> expected(N, -1);
+    IndexT         region_count = 0;
+    for(SizeT i = 0; i < N; ++i)
+    {
+        auto r = find(static_cast<IndexT>(i));
+        if(expected[r] == -1)
+            expected[r] = region_count++;
+        expected[i] = expected[r];
+    }
+
+    REQUIRE(mesh.meta().find<IndexT>("region_count")->view()[0] == region_count);
+    REQUIRE(std::ranges::equal(mesh.vertices().find<IndexT>("region")->view(), expected));
+
+    auto edge_region = mesh.edges().find<IndexT>("region")->view();
+    auto edges       = mesh.edges().topo().view();
+    REQUIRE(std::ranges::equal(edge_region,
+                               edges,
+                               [&](IndexT r, const Vector2i& e) { return r == expected[e[0]]; }));
+
+    // the primitive counts of the regions
+    VectorXi expected_vertex_count = VectorXi::Zero(region_count);
+    for(auto r : expected)
+        expected_vertex_count[r]++;
+    VectorXi expected_edge_count = VectorXi::Zero(region_count);
+    for(auto r : edge_region)
+        expected_edge_count[r]++;
+
+    REQUIRE(mesh.meta().find<VectorXi>("region_vertex_count")->view()[0] == expected_vertex_count);
+    REQUIRE(mesh.meta().find<VectorXi>("region_edge_count")->view()[0] == expected_edge_count);
+}
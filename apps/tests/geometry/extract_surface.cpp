@@ -52,3 +52,48 @@ TEST_CASE("extract_surface", "[surface]")
         io.write_obj(fmt::format("{}cube_flipped_surf.obj", this_output_path), surface_flipped);
     }
 }
+
+TEST_CASE("extract_surface_multiple", "[surface]")
+{
+    SimplicialComplexIO io;
+    auto cube = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    label_surface(cube);
+
+    auto tri = io.read(fmt::format("{}cube.obj", AssetDir::trimesh_path()));
+    auto other_cube = cube;
+
+    // some instances with transforms
+    Transform T = Transform::Identity();
+    T.translate(Vector3{1.0, 2.0, 3.0});
+    cube.instances().resize(3);
+    view(cube.transforms())[2] = T.matrix();
+    tri.instances().resize(2);
+    view(tri.transforms())[0] = T.matrix();
+
+    vector<const SimplicialComplex*> inputs = {&cube, &tri, &other_cube};
+    auto surface = extract_surface(inputs);
+
+    // the reference: extract, apply the transforms and merge one by one
+    vector<SimplicialComplex> parts;
+    for(auto input : inputs)
+    {
+        auto part = input->dim() == 3 ? extract_surface(*input) : *input;
+        for(auto& instance : apply_transform(part))
+            parts.push_back(instance);
+    }
+    vector<const SimplicialComplex*> part_ptrs;
+    for(auto& part : parts)
+        part_ptrs.push_back(&part);
+    auto expected = merge(part_ptrs);
+
+    REQUIRE(surface.vertices().size() == expected.vertices().size());
+    REQUIRE(surface.edges().size() == expected.edges().size());
+    REQUIRE(surface.triangles().size() == expected.triangles().size());
+    REQUIRE(surface.tetrahedra().size() == 0);
+
+    // the same attributes with the same values
+    REQUIRE(surface.vertices().to_json() == expected.vertices().to_json());
+    REQUIRE(surface.edges().to_json() == expected.edges().to_json());
+    REQUIRE(surface.triangles().to_json() == expected.triangles().to_json());
+    REQUIRE(!surface.triangles().find<IndexT>(builtin::parent_id));
+}
@@ -0,0 +1,66 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("merge", "[merge]")
+{
+    SimplicialComplexIO io;
+    auto tet = io.read(fmt::format("{}tet.msh", AssetDir::tetmesh_path()));
+
+    constexpr SizeT N = 1000;
+
+    vector<SimplicialComplex> meshes(N, tet);
+    for(auto&& [I, mesh] : enumerate(meshes))
+    {
+        auto Ps = view(mesh.positions());
+        for(auto& P : Ps)
+            P += Vector3::UnitX() * I;
+    }
+    // only the last mesh has the `mass` attribute
+    auto mass = meshes.back().vertices().create<Float>("mass", 2.0);
+
+    vector<const SimplicialComplex*> mesh_ptrs;
+    for(auto& mesh : meshes)
+        mesh_ptrs.push_back(&mesh);
+
+    auto R = merge(mesh_ptrs);
+
+    auto v_count = tet.vertices().size();
+    auto t_count = tet.tetrahedra().size();
+
+    REQUIRE(R.vertices().size() == N * v_count);
+    REQUIRE(R.edges().size() == N * tet.edges().size());
+    REQUIRE(R.triangles().size() == N * tet.triangles().size());
+    REQUIRE(R.tetrahedra().size() == N * t_count);
+
+    auto Ps = R.positions().view();
+    auto Ts = R.tetrahedra().topo().view();
+
+    bool topo_ok     = true;
+    bool position_ok = true;
+    for(SizeT I = 0; I < N; ++I)
+    {
+        auto src_Ts = tet.tetrahedra().topo().view();
+        for(SizeT t = 0; t < t_count; ++t)
+            topo_ok &= Ts[I * t_count + t] == (src_Ts[t].array() + static_cast<IndexT>(I * v_count)).matrix();
+
+        auto src_Ps = tet.positions().view();
+        for(SizeT v = 0; v < v_count; ++v)
+            position_ok &= Ps[I * v_count + v].isApprox(src_Ps[v] + Vector3::UnitX() * I);
+    }
+    REQUIRE(topo_ok);
+    REQUIRE(position_ok);
+
+    // rows of the meshes without the attribute keep the default value
+    auto merged_mass = R.vertices().find<Float>("mass");
+    REQUIRE(merged_mass);
+    auto Ms = merged_mass->view();
+    REQUIRE(std::ranges::all_of(Ms, [](Float m) { return m == 2.0; }));
+
+    // type mismatch is not allowed
+    meshes.front().vertices().create<IndexT>("mass", 0);
+    REQUIRE_THROWS_AS(merge(mesh_ptrs), AttributeCollectionError);
+}
@@ -0,0 +1,123 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/geometry/utils/distance.h>
+#include <random>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("mesh_distance_query", "[distance]")
+{
+    SimplicialComplexIO io;
+    auto cube = io.read(fmt::format("{}cube.obj", AssetDir::trimesh_path()));
+
+    // the signed distance of the cube [-0.5, 0.5]^3
+    auto box_sdf = [](const Vector3& P)
+    {
+        Vector3 Q = P.cwiseAbs().array() - 0.5;
+        return Q.cwiseMax(0.0).norm() + std::min(Q.maxCoeff(), 0.0);
+    };
+
+    std::mt19937                          gen{42};
+    std::uniform_real_distribution<Float> dis{-1.5, 1.5};
+
+    vector<Vector3> Ps(1000);
+    for(auto& P : Ps)
+        P = Vector3{dis(gen), dis(gen), dis(gen)};
+
+    MeshDistanceQuery mdq{cube};
+    REQUIRE(mdq.primitive_count() == cube.triangles().size());
+    REQUIRE(mdq.is_closed());
+
+    SECTION("closest_point")
+    {
+        auto Vs = cube.positions().view();
+        auto Fs = cube.triangles().topo().view();
+
+        vector<MeshDistanceQuery::Result> results(Ps.size());
+        mdq.query(Ps, results);
+
+        for(auto&& [i, P] : enumerate(Ps))
+        {
+            auto& R = results[i];
+
+            // brute force
+            Float min_d2 = std::numeric_limits<Float>::infinity();
+            for(auto& F : Fs)
+                min_d2 = std::min(min_d2,
+                                  point_triangle_squared_distance(P, Vs[F[0]], Vs[F[1]], Vs[F[2]]));
+
+            REQUIRE(R.primitive >= 0);
+            REQUIRE(R.distance == Approx(std::sqrt(min_d2)).margin(1e-9));
+            REQUIRE((R.closest_point - P).norm() == Approx(R.distance).margin(1e-9));
+
+            auto&   F = Fs[R.primitive];
+            Vector3 X = R.barycentric[0] * Vs[F[0]] + R.barycentric[1] * Vs[F[1]]
+                        + R.barycentric[2] * Vs[F[2]];
+            REQUIRE(X.isApprox(R.closest_point, 1e-9));
+
+            // the single query gives the same result
+            REQUIRE(mdq.query(P).distance == R.distance);
+        }
+
+        // no primitive within max_distance
+        auto far = mdq.query(Vector3{3, 0, 0}, 1.0);
+        REQUIRE(far.primitive == -1);
+        REQUIRE(std::isinf(far.distance));
+    }
+
+    SECTION("signed_distance")
+    {
+        vector<MeshDistanceQuery::Result> results(Ps.size());
+        mdq.signed_query(Ps, results);
+
+        for(auto&& [i, P] : enumerate(Ps))
+            REQUIRE(results[i].distance == Approx(box_sdf(P)).margin(1e-9));
+    }
+
+    SECTION("sparse_sdf")
+    {
+        constexpr Float cell_size = 0.05;
+        constexpr Float band      = 0.2;
+
+        mdq.build_sdf(cell_size, band);
+        REQUIRE(mdq.has_sdf());
+
+        vector<Float> Ds(Ps.size());
+        mdq.distance(Ps, Ds);
+
+        for(auto&& [i, P] : enumerate(Ps))
+        {
+            // in the band the distance is interpolated, outside it is exact
+            REQUIRE(Ds[i] == Approx(box_sdf(P)).margin(cell_size));
+            if(std::abs(box_sdf(P)) > band + cell_size)
+                REQUIRE(Ds[i] == Approx(box_sdf(P)).margin(1e-9));
+        }
+
+        // rebuilding drops the grid
+        mdq.build(cube);
+        REQUIRE(!mdq.has_sdf());
+    }
+
+    SECTION("tetmesh")
+    {
+        std::vector           Vs = {Vector3{0.0, 0.0, 0.0},
+                                    Vector3{1.0, 0.0, 0.0},
+                                    Vector3{0.0, 1.0, 0.0},
+                                    Vector3{0.0, 0.0, 1.0}};
+        std::vector<Vector4i> Ts = {Vector4i{0, 1, 2, 3}};
+
+        auto mesh = tetmesh(Vs, Ts);
+        label_surface(mesh);
+        label_triangle_orient(mesh);
+
+        MeshDistanceQuery tet_mdq{mesh};
+        REQUIRE(tet_mdq.primitive_count() == 4);
+        REQUIRE(tet_mdq.is_closed());
+
+        REQUIRE(tet_mdq.signed_query(Vector3::Constant(0.1)).distance == Approx(-0.1));
+        REQUIRE(tet_mdq.signed_query(Vector3::Constant(-0.1)).distance
+                == Approx(std::sqrt(0.03)));
+    }
+}
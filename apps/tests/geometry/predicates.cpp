@@ -0,0 +1,167 @@
+#include <app/test_common.h>
+#include <uipc/uipc.h>
+#include <uipc/geometry/utils/predicates.h>
+#include <uipc/geometry/utils/intersection.h>
+#include <uipc/geometry/utils/distance.h>
+#include <random>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("orient3d", "[predicates]")
+{
+    Vector3 A = Vector3::Zero();
+    Vector3 B = Vector3::UnitX();
+    Vector3 C = Vector3::UnitY();
+
+    REQUIRE(orient3d(A, B, C, Vector3::UnitZ()) == 1);
+    REQUIRE(orient3d(A, B, C, -Vector3::UnitZ()) == -1);
+    REQUIRE(orient3d(A, B, C, Vector3{0.3, 0.3, 0.0}) == 0);
+    REQUIRE(orient3d(A, C, B, Vector3{0.3, 0.3, 0x1p-60}) == -1);
+
+    // the nearly collinear points of Shewchuk, the floating point determinant has a wrong sign on many of them.
+    // with u = 2^-53, P = (2^52 + x, 2^52 + y) u, Q = (12, 12), R = (24, 24), the exact determinant is
+    // (Q - Px)(R - Py) - (Q - Py)(R - Px) = (23 * 2^52 - x)(47 * 2^52 - y) - (23 * 2^52 - y)(47 * 2^52 - x)
+    //                                     = 24 * 2^52 (y - x) (in the unit of u^2), so its sign is the sign of y - x
+    Vector3 Top = Vector3::UnitZ();
+    for(int x = 0; x < 64; ++x)
+    {
+        for(int y = 0; y < 64; ++y)
+        {
+            Vector3 P{0.5 + x * 0x1p-53, 0.5 + y * 0x1p-53, 0.0};
+
+            int exact = (y > x) - (y < x);
+
+            REQUIRE(orient3d(P, Vector3{12, 12, 0}, Vector3{24, 24, 0}, Top) == exact);
+        }
+    }
+}
+
+TEST_CASE("batch_predicates", "[predicates]")
+{
+    std::mt19937                          gen{42};
+    std::uniform_real_distribution<Float> dis{-1.0, 1.0};
+    std::uniform_int_distribution<IndexT> vertex{0, 63};
+
+    // few distinct vertices, so that many candidates share vertices or are degenerate
+    vector<Vector3> Vs(64);
+    for(auto& V : Vs)
+        V = Vector3{dis(gen), dis(gen), dis(gen)};
+    // exactly coplanar vertices
+    for(IndexT i = 0; i < 16; ++i)
+        Vs[i].z() = 0.0;
+
+    constexpr SizeT N = 2000;
+
+    vector<Vector3i> Fs(N);
+    vector<Vector2i> Es(N);
+    vector<Vector4i> Ts(N);
+    // the distinct vertices of a primitive
+    auto pick = [&]<int M>(Eigen::Vector<IndexT, M>& P)
+    {
+        for(int k = 0; k < M; ++k)
+        {
+            do
+                P[k] = vertex(gen);
+            while(std::find(P.data(), P.data() + k, P[k]) != P.data() + k);
+        }
+    };
+    for(SizeT i = 0; i < N; ++i)
+    {
+        pick(Fs[i]);
+        pick(Es[i]);
+        pick(Ts[i]);
+    }
+
+    vector<Vector2i> Pairs(N);
+    for(SizeT i = 0; i < N; ++i)
+        Pairs[i] = Vector2i{static_cast<IndexT>(i), static_cast<IndexT>((i * 7) % N)};
+
+    vector<Vector2i> PVs(N);
+    for(SizeT i = 0; i < N; ++i)
+        PVs[i] = Vector2i{vertex(gen), static_cast<IndexT>(i)};
+
+    const auto policies = {ExecutionPolicy::Serial, ExecutionPolicy::Parallel, ExecutionPolicy::Simd};
+
+    SECTION("tri_edge_intersect")
+    {
+        vector<IndexT> expected(N);
+        tri_edge_intersect(Pairs, Vs, Fs, Es, expected, ExecutionPolicy::Serial);
+
+        // the exact result agrees with the scalar check away from the degenerate cases
+        for(SizeT k = 0; k < N; ++k)
+        {
+            auto F = Fs[Pairs[k][0]];
+            auto E = Es[Pairs[k][1]];
+
+            auto on_F = [&](IndexT v)
+            { return v == F[0] || v == F[1] || v == F[2]; };
+            if(on_F(E[0]) || on_F(E[1]))
+                continue;
+            // the edge touches the plane or the boundary of the triangle
+            auto on_plane = [&](IndexT v)
+            { return orient3d(Vs[F[0]], Vs[F[1]], Vs[F[2]], Vs[v]) == 0; };
+            auto on_side = [&](IndexT a, IndexT b)
+            { return orient3d(Vs[E[0]], Vs[E[1]], Vs[F[a]], Vs[F[b]]) == 0; };
+            if(on_plane(E[0]) || on_plane(E[1]) || on_side(0, 1) || on_side(1, 2)
+               || on_side(2, 0))
+                continue;
+            bool scalar = tri_edge_intersect(
+                Vs[F[0]], Vs[F[1]], Vs[F[2]], Vs[E[0]], Vs[E[1]]);
+            CHECK(bool(expected[k]) == scalar);
+        }
+
+        for(auto policy : policies)
+        {
+            vector<IndexT> intersected(N);
+            tri_edge_intersect(Pairs, Vs, Fs, Es, intersected, policy);
+            REQUIRE(intersected == expected);
+        }
+    }
+
+    SECTION("is_point_in_tet")
+    {
+        vector<IndexT> expected(N);
+        is_point_in_tet(PVs, Vs, Ts, expected, ExecutionPolicy::Serial);
+
+        for(SizeT k = 0; k < N; ++k)
+        {
+            auto T = Ts[PVs[k][1]];
+            if(orient3d(Vs[T[0]], Vs[T[1]], Vs[T[2]], Vs[T[3]]) == 0)
+                REQUIRE(!expected[k]);
+        }
+
+        for(auto policy : policies)
+        {
+            vector<IndexT> inside(N);
+            is_point_in_tet(PVs, Vs, Ts, inside, policy);
+            REQUIRE(inside == expected);
+        }
+    }
+
+    SECTION("distance")
+    {
+        for(auto policy : policies)
+        {
+            vector<Float> Ds(N);
+            edge_edge_squared_distance(Pairs, Vs, Es, Ds, policy);
+            for(SizeT k = 0; k < N; ++k)
+            {
+                auto E0 = Es[Pairs[k][0]];
+                auto E1 = Es[Pairs[k][1]];
+                REQUIRE(Ds[k]
+                        == edge_edge_squared_distance(
+                            Vs[E0[0]], Vs[E0[1]], Vs[E1[0]], Vs[E1[1]]));
+            }
+
+            point_triangle_squared_distance(PVs, Vs, Fs, Ds, policy);
+            for(SizeT k = 0; k < N; ++k)
+            {
+                auto F = Fs[PVs[k][1]];
+                REQUIRE(Ds[k]
+                        == point_triangle_squared_distance(
+                            Vs[PVs[k][0]], Vs[F[0]], Vs[F[1]], Vs[F[2]]));
+            }
+        }
+    }
+}
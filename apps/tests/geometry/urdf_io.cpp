@@ -2,8 +2,163 @@
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
 #include <uipc/io/urdf_io.h>
+#include <filesystem>
+#include <fstream>
 
 using namespace uipc;
 using namespace uipc::geometry;
 
-TEST_CASE("read_urdf", "[io]") {}
+TEST_CASE("read_urdf", "[io]")
+{
+    using namespace uipc::core;
+    namespace fs = std::filesystem;
+
+    auto output_path = AssetDir::output_path(__FILE__);
+    auto cube        = fmt::format("{}cube.obj", AssetDir::trimesh_path());
+
+    // base -(revolute)- arm -(fixed)- hand, base -(floating)- tool
+    auto urdf = fmt::format("{}arm.urdf", output_path);
+    {
+        std::ofstream ofs(urdf);
+        ofs << fmt::format(R"(
+<robot name="arm">
+  <link name="base">
+    <collision><geometry><box size="1 0.2 1"/></geometry></collision>
+  </link>
+  <link name="arm">
+    <collision><geometry><mesh filename="{0}" scale="0.2 1 0.2"/></geometry></collision>
+  </link>
+  <link name="hand">
+    <collision><geometry><mesh filename="{0}" scale="0.2 1 0.2"/></geometry></collision>
+  </link>
+  <link name="tool">
+    <collision><geometry><mesh filename="{0}" scale="0.2 1 0.2"/></geometry></collision>
+  </link>
+  <joint name="shoulder" type="revolute">
+    <parent link="base"/>
+    <child link="arm"/>
+    <origin xyz="0 0.6 0"/>
+    <axis xyz="0 0 1"/>
+    <limit lower="-1" upper="1" effort="1" velocity="1"/>
+  </joint>
+  <joint name="wrist" type="fixed">
+    <parent link="arm"/>
+    <child link="hand"/>
+    <origin xyz="0 1 0"/>
+  </joint>
+  <joint name="grip" type="floating">
+    <parent link="base"/>
+    <child link="tool"/>
+    <origin xyz="2 0 0"/>
+  </joint>
+</robot>
+)",
+                           cube);
+    }
+
+    constexpr SizeT robot_count = 100;
+
+    vector<Transform> placements(robot_count);
+    for(SizeT i = 0; i < robot_count; ++i)
+    {
+        placements[i] = Transform::Identity();
+        placements[i].translate(Vector3::UnitX() * 4.0 * i);
+    }
+
+    Scene  scene;
+    UrdfIO io{scene};
+
+    auto robot = io.read(urdf, placements);
+
+    // the box and the scaled cube
+    REQUIRE(io.cached_mesh_count() == 2);
+    REQUIRE(robot.name == "arm");
+    // base, arm (+hand), tool
+    REQUIRE(robot.links.size() == 3);
+    REQUIRE(robot.joints);
+
+    auto geometry_of = [&](IndexT id)
+    { return scene.geometries().find(id).geometry->geometry().as<SimplicialComplex>(); };
+
+    auto link_ids = [&](std::string_view name)
+    {
+        auto it = std::ranges::find_if(robot.links, [&](auto& o) { return o->name() == name; });
+        REQUIRE(it != robot.links.end());
+        return (*it)->geometries().ids();
+    };
+
+    SECTION("instancing")
+    {
+        // jointed bodies: one single-instance geometry per robot, sharing the mesh
+        auto arm_ids = link_ids("arm/arm");
+        REQUIRE(arm_ids.size() == robot_count);
+        auto first = geometry_of(arm_ids[0]);
+        auto last  = geometry_of(arm_ids[robot_count - 1]);
+        REQUIRE(first->instances().size() == 1);
+        REQUIRE(first->positions().view().data() == last->positions().view().data());
+
+        Vector3 last_origin = last->transforms().view()[0].col(3).head<3>();
+        REQUIRE(last_origin.isApprox(Vector3{4.0 * (robot_count - 1), 0.6, 0}));
+
+        // free bodies: one geometry, one instance per robot
+        auto tool_ids = link_ids("arm/tool");
+        REQUIRE(tool_ids.size() == 1);
+        auto tool = geometry_of(tool_ids[0]);
+        REQUIRE(tool->instances().size() == robot_count);
+    }
+
+    SECTION("joints")
+    {
+        auto joints = geometry_of(robot.joints->geometries().ids()[0]);
+        REQUIRE(joints->edges().size() == robot_count);
+
+        auto links    = joints->edges().find<Vector2i>("links")->view();
+        auto base_ids = link_ids("arm/base");
+        auto arm_ids  = link_ids("arm/arm");
+        for(auto&& [i, l] : enumerate(links))
+        {
+            REQUIRE(l[0] == base_ids[i]);
+            REQUIRE(l[1] == arm_ids[i]);
+        }
+    }
+
+    SECTION("fixed_base")
+    {
+        // the shapeless root link is only a frame, the first link with a shape is fixed
+        auto world_urdf = fmt::format("{}world.urdf", output_path);
+        {
+            std::ofstream ofs(world_urdf);
+            ofs << R"(
+<robot name="block">
+  <link name="world"/>
+  <link name="block">
+    <collision><geometry><box size="1 1 1"/></geometry></collision>
+  </link>
+  <joint name="place" type="floating">
+    <parent link="world"/>
+    <child link="block"/>
+  </joint>
+</robot>
+)";
+        }
+
+        // the other keys take the default values
+        Json config          = Json::object();
+        config["fixed_base"] = true;
+        UrdfIO fixed_io{scene, config};
+
+        auto block = fixed_io.read(world_urdf);
+        REQUIRE(block.links.size() == 1);
+        auto geo = geometry_of(block.links[0]->geometries().ids()[0]);
+        REQUIRE(geo->instances().find<IndexT>(builtin::is_fixed)->view()[0] == 1);
+    }
+
+    SECTION("cache")
+    {
+        auto object_count = scene.objects().size();
+        auto again        = io.read(urdf);
+        REQUIRE(io.cached_mesh_count() == 2);
+        REQUIRE(scene.objects().size() == object_count + 4);
+        REQUIRE(again.links.size() == 3);
+    }
+}
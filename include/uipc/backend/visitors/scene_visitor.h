@@ -4,6 +4,7 @@
 #include <uipc/common/set.h>
 #include <uipc/common/unordered_map.h>
 #include <uipc/geometry/geometry_collection.h>
+#include <uipc/geometry/topology_change.h>
 #include <uipc/core/constitution_tabular.h>
 #include <uipc/core/contact_tabular.h>
 #include <uipc/backend/visitors/diff_sim_visitor.h>
@@ -46,6 +47,17 @@ class UIPC_CORE_API SceneVisitor
     span<IndexT> pending_destroy_ids() const noexcept;
     const Json&  info() const noexcept;
 
+    /**
+     * @brief Write a topology change of the simulation back to the geometry and the rest geometry with `id`.
+     *
+     * The change is applied in place (see `geometry::apply_topology_change()`), the scene is not rebuilt,
+     * and no sanity check or world initialization is triggered. Write the vertex values (e.g. positions)
+     * back after applying the change, the inserted vertices hold the values of their parents until then.
+     *
+     * @throw geometry::TopologyChangeError if the geometry is not a SimplicialComplex or the change is invalid.
+     */
+    void apply_topology_change(IndexT id, const geometry::TopologyChange& change);
+
     const core::ConstitutionTabular& constitution_tabular() const noexcept;
     core::ConstitutionTabular&       constitution_tabular() noexcept;
 
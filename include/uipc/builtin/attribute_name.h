@@ -1,7 +1,8 @@
 #pragma once
-#include <string_view>
+#include <uipc/geometry/attribute_key.h>
 
-#define UIPC_BUILTIN_ATTRIBUTE(name) constexpr std::string_view name = #name
+#define UIPC_BUILTIN_ATTRIBUTE(name)                                           \
+    constexpr ::uipc::geometry::AttributeKey name { #name }
 
 namespace uipc::builtin
 {
@@ -0,0 +1,130 @@
+#include <uipc/common/log.h>
+#include <algorithm>
+
+namespace uipc::exec
+{
+namespace detail
+{
+    inline SizeT chunk_count(SizeT count, SizeT grain_size) noexcept
+    {
+        return (count + grain_size - 1) / grain_size;
+    }
+
+    // combine the partial results by a fixed pairwise tree
+    template <typename T, typename Reduce>
+    T pairwise_reduce(vector<T>& partials, Reduce& reduce)
+    {
+        for(SizeT stride = 1; stride < partials.size(); stride *= 2)
+            for(SizeT i = 0; i + stride < partials.size(); i += 2 * stride)
+                partials[i] = reduce(partials[i], partials[i + stride]);
+        return partials.front();
+    }
+}  // namespace detail
+
+template <typename F>
+void parallel_for(SizeT begin, SizeT end, F&& f, SizeT grain_size)
+{
+    if(end <= begin)
+        return;
+
+    grain_size   = std::max<SizeT>(grain_size, 1);
+    SizeT chunks = detail::chunk_count(end - begin, grain_size);
+
+    auto e = executor();
+    if(chunks <= 1 || e->concurrency() <= 1)
+    {
+        for(SizeT i = begin; i < end; ++i)
+            f(i);
+        return;
+    }
+
+    e->bulk(chunks,
+            [&](SizeT c)
+            {
+                SizeT chunk_begin = begin + c * grain_size;
+                SizeT chunk_end   = std::min(chunk_begin + grain_size, end);
+                for(SizeT i = chunk_begin; i < chunk_end; ++i)
+                    f(i);
+            });
+}
+
+template <typename T, typename Map, typename Reduce>
+T parallel_reduce(SizeT begin, SizeT end, T identity, Map&& map, Reduce&& reduce, SizeT grain_size)
+{
+    if(end <= begin)
+        return identity;
+
+    grain_size   = std::max<SizeT>(grain_size, 1);
+    SizeT chunks = detail::chunk_count(end - begin, grain_size);
+
+    vector<T> partials(chunks, identity);
+    parallel_for(
+        0,
+        chunks,
+        [&](SizeT c)
+        {
+            SizeT chunk_begin = begin + c * grain_size;
+            SizeT chunk_end   = std::min(chunk_begin + grain_size, end);
+            T     acc         = identity;
+            for(SizeT i = chunk_begin; i < chunk_end; ++i)
+                acc = reduce(acc, map(i));
+            partials[c] = acc;
+        },
+        1);
+
+    return detail::pairwise_reduce(partials, reduce);
+}
+
+template <typename T, typename Op>
+T parallel_scan(span<const T> in, span<T> out, T init, Op&& op, SizeT grain_size)
+{
+    UIPC_ASSERT(in.size() == out.size(), "Size mismatch, in is {}, out is {}.", in.size(), out.size());
+
+    if(in.empty())
+        return init;
+
+    grain_size   = std::max<SizeT>(grain_size, 1);
+    SizeT N      = in.size();
+    SizeT chunks = detail::chunk_count(N, grain_size);
+
+    // 1) the total of each chunk
+    vector<T> offsets(chunks + 1, init);
+    parallel_for(
+        0,
+        chunks,
+        [&](SizeT c)
+        {
+            SizeT chunk_begin = c * grain_size;
+            SizeT chunk_end   = std::min(chunk_begin + grain_size, N);
+            T     acc         = in[chunk_begin];
+            for(SizeT i = chunk_begin + 1; i < chunk_end; ++i)
+                acc = op(acc, in[i]);
+            offsets[c + 1] = acc;
+        },
+        1);
+
+    // 2) the exclusive scan of the chunk totals
+    for(SizeT c = 0; c < chunks; ++c)
+        offsets[c + 1] = op(offsets[c], offsets[c + 1]);
+
+    // 3) scan each chunk from its offset
+    parallel_for(
+        0,
+        chunks,
+        [&](SizeT c)
+        {
+            SizeT chunk_begin = c * grain_size;
+            SizeT chunk_end   = std::min(chunk_begin + grain_size, N);
+            T     acc         = offsets[c];
+            for(SizeT i = chunk_begin; i < chunk_end; ++i)
+            {
+                T value = in[i];  // `out` may be `in`
+                out[i]  = acc;
+                acc     = op(acc, value);
+            }
+        },
+        1);
+
+    return offsets.back();
+}
+}  // namespace uipc::exec
@@ -1,27 +1,41 @@
 #include <uipc/common/log.h>
 namespace uipc
 {
+namespace detail
+{
+    template <typename T>
+    void* dynamic_cast_to_most_derived(T* ptr) noexcept
+    {
+        if constexpr(std::is_polymorphic_v<T>)
+            return const_cast<void*>(dynamic_cast<const volatile void*>(ptr));
+        else
+            return const_cast<void*>(static_cast<const volatile void*>(ptr));
+    }
+}  // namespace detail
+
 template <typename T>
 void PmrDeleter<T>::operator()(T* ptr) const
 {
-    auto      resource = std::pmr::get_default_resource();
-    Allocator alloc{resource};
-    std::allocator_traits<Allocator>::destroy(alloc, ptr);
-    std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
+    // ptr may point to a base subobject, get the allocated address before destroying it
+    void* p = detail::dynamic_cast_to_most_derived(ptr);
+    std::destroy_at(ptr);
+    resource->deallocate(p, bytes, alignment);
 }
 
 template <typename T, typename... Args>
 U<T> make_unique(Args&&... args)
 {
-    std::pmr::polymorphic_allocator<T> alloc;
+    auto resource = std::pmr::get_default_resource();
+    std::pmr::polymorphic_allocator<T> alloc{resource};
     return U<T>(alloc.template new_object<T, Args...>(std::forward<Args>(args)...),
-                PmrDeleter<T>{});
+                PmrDeleter<T>{resource});
 }
 
 template <typename DstT, typename SrcT>
 U<DstT> static_pointer_cast(U<SrcT>&& src)
 {
-    return U<DstT>(src.release());
+    PmrDeleter<DstT> deleter{src.get_deleter()};
+    return U<DstT>(static_cast<DstT*>(src.release()), deleter);
 }
 
 template <typename T, typename... Args>
@@ -30,6 +44,6 @@ S<T> make_shared(Args&&... args)
     auto resource = std::pmr::get_default_resource();
     std::pmr::polymorphic_allocator<T> alloc{resource};
     return std::shared_ptr<T>(alloc.template new_object<T, Args...>(std::forward<Args>(args)...),
-                              PmrDeleter<T>{});
+                              PmrDeleter<T>{resource});
 }
 }  // namespace uipc
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/span.h>
+#include <uipc/common/vector.h>
+#include <functional>
+
+/**
+ * @brief The execution facility shared by the CPU side modules.
+ *
+ * All the parallel algorithms run on one executor, by default a work-stealing thread pool sized by `uipc::config()`:
+ *
+ * ```json
+ * {
+ *     "exec": {
+ *         "threads": 0 // the total thread count including the calling thread, 0 means the hardware concurrency
+ *     }
+ * }
+ * ```
+ *
+ * An embedding application can replace it with its own scheduler, see `set_executor()`.
+ */
+namespace uipc::exec
+{
+/**
+ * @brief The interface of an executor.
+ *
+ * An executor runs a batch of tasks and waits for all of them, implement `do_bulk()` to bridge an external scheduler.
+ */
+class UIPC_CORE_API IExecutor
+{
+  public:
+    virtual ~IExecutor() = default;
+
+    /**
+     * @brief The number of threads that may run the tasks, including the calling thread.
+     */
+    [[nodiscard]] SizeT concurrency() const noexcept;
+
+    /**
+     * @brief Call `task(i)` for all `i` in `[0, count)`, and return after all of them are done.
+     *
+     * The tasks may run concurrently and in any order. `bulk()` may be called from inside a task.
+     * The first exception thrown by the tasks is rethrown after all the tasks are done.
+     */
+    void bulk(SizeT count, const std::function<void(SizeT)>& task);
+
+  protected:
+    virtual SizeT get_concurrency() const noexcept                              = 0;
+    virtual void do_bulk(SizeT count, const std::function<void(SizeT)>& task) = 0;
+};
+
+/**
+ * @brief Run all the tasks on the calling thread, in order.
+ */
+class UIPC_CORE_API SerialExecutor final : public IExecutor
+{
+  protected:
+    SizeT get_concurrency() const noexcept override;
+    void do_bulk(SizeT count, const std::function<void(SizeT)>& task) override;
+};
+
+/**
+ * @brief A work-stealing thread pool.
+ *
+ * Every worker owns a queue of task ranges, it splits the range it takes and leaves the other half for the thieves.
+ * A thread waiting for its tasks keeps running the queued ones, so the nested `bulk()` calls never deadlock.
+ */
+class UIPC_CORE_API ThreadPool final : public IExecutor
+{
+  public:
+    /**
+     * @param threads The total thread count including the calling thread, 0 means the hardware concurrency.
+     */
+    explicit ThreadPool(SizeT threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+  protected:
+    SizeT get_concurrency() const noexcept override;
+    void do_bulk(SizeT count, const std::function<void(SizeT)>& task) override;
+
+  private:
+    class Impl;
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief Get the current executor.
+ *
+ * If no executor is set, a `ThreadPool` (or a `SerialExecutor` for a single thread) is created
+ * from `uipc::config()` on the first call. Hold the returned pointer until the call on it returns,
+ * the executor may be replaced by `set_executor()` or `uipc::init()` meanwhile.
+ */
+UIPC_CORE_API S<IExecutor> executor();
+
+/**
+ * @brief Replace the current executor, e.g. to share the scheduler of the embedding application.
+ *
+ * The running parallel algorithms keep the executor they started with.
+ *
+ * @param executor The new executor, nullptr to go back to the default one created from `uipc::config()`.
+ */
+UIPC_CORE_API void set_executor(S<IExecutor> executor);
+
+namespace detail
+{
+    /**
+     * @brief Drop the default executor, so the next `executor()` call creates it from the new `uipc::config()`.
+     * The executor set by `set_executor()` is kept. Called by `uipc::init()`.
+     */
+    UIPC_CORE_API void reset_default_executor();
+}  // namespace detail
+
+/**
+ * @brief Call `f(i)` for all `i` in `[begin, end)` on the current executor.
+ *
+ * The range is split into chunks of `grain_size` indices, a range of a single chunk runs on the calling thread.
+ * `f` must be safe to call concurrently for different `i`. The first exception thrown by `f` is rethrown
+ * after all the chunks are done.
+ */
+template <typename F>
+void parallel_for(SizeT begin, SizeT end, F&& f, SizeT grain_size = 1024);
+
+/**
+ * @brief Reduce `map(i)` for all `i` in `[begin, end)` with `reduce`.
+ *
+ * The result is bitwise reproducible: the chunks only depend on `grain_size`, each chunk is reduced in order
+ * and the chunk results are combined by a fixed pairwise tree, whatever the executor and the thread count.
+ *
+ * @param identity The identity of `reduce`, the result of an empty range
+ * @param map `T(SizeT i)`
+ * @param reduce `T(const T& a, const T& b)`, associative
+ */
+template <typename T, typename Map, typename Reduce>
+[[nodiscard]] T parallel_reduce(SizeT begin, SizeT end, T identity, Map&& map, Reduce&& reduce, SizeT grain_size = 1024);
+
+/**
+ * @brief The exclusive scan of `in` with `op`, `out[i] = init op in[0] op ... op in[i-1]`.
+ *
+ * `out` may be `in`. The same as `parallel_reduce()`, the result only depends on `grain_size`.
+ *
+ * @return The total, `init op in[0] op ... op in[N-1]`
+ */
+template <typename T, typename Op>
+T parallel_scan(span<const T> in, span<T> out, T init, Op&& op, SizeT grain_size = 4096);
+}  // namespace uipc::exec
+
+#include "details/exec.inl"
@@ -0,0 +1,41 @@
+#pragma once
+#include <uipc/common/parallel_for.h>
+
+namespace uipc
+{
+/**
+ * @brief How a batch operation evaluates its elements.
+ */
+enum class ExecutionPolicy
+{
+    /**
+     * @brief One by one, on the calling thread.
+     */
+    Serial,
+    /**
+     * @brief Split over multiple threads, see `parallel_for()`.
+     */
+    Parallel,
+    /**
+     * @brief Split over multiple threads, each thread evaluates fixed size blocks of elements with branch-free
+     * kernels the compiler vectorizes. Operations without such a kernel fall back to `Parallel`.
+     */
+    Simd
+};
+
+/**
+ * @brief Call `f(i)` for all `i` in `[begin, end)`, on the calling thread if `policy` is `ExecutionPolicy::Serial`,
+ * otherwise the same as `parallel_for(begin, end, f, grain_size)`.
+ */
+template <typename F>
+void parallel_for(ExecutionPolicy policy, SizeT begin, SizeT end, F&& f, SizeT grain_size = 1024)
+{
+    if(policy == ExecutionPolicy::Serial)
+    {
+        for(SizeT i = begin; i < end; ++i)
+            f(i);
+        return;
+    }
+    parallel_for(begin, end, std::forward<F>(f), grain_size);
+}
+}  // namespace uipc
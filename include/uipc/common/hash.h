@@ -0,0 +1,13 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+
+namespace uipc
+{
+/**
+ * @brief The 64 bit xxHash (XXH64) of a byte range.
+ *
+ * Hashes of consecutive ranges can be chained by passing the previous hash as the seed.
+ */
+UIPC_CORE_API [[nodiscard]] U64 xxhash64(const void* data, SizeT size, U64 seed = 0) noexcept;
+}  // namespace uipc
@@ -0,0 +1,240 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/json.h>
+#include <uipc/common/type_define.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/span.h>
+#include <uipc/common/vector.h>
+#include <uipc/common/exception.h>
+#include <functional>
+#include <iosfwd>
+
+namespace uipc
+{
+enum class JsonFormat
+{
+    Json,  // JSON text
+    Bson   // BSON binary
+};
+
+/**
+ * @brief Encode values in JSON text or BSON, event by event, appending to a byte buffer.
+ *
+ * The layout of the output is the same as `Json::dump()` or `Json::to_bson()` of the equivalent Json.
+ * In BSON, a top-level value is prefixed by its element type byte, see `raw()`.
+ */
+class UIPC_CORE_API JsonStreamEncoder
+{
+    friend class JsonStreamWriter;
+
+  public:
+    /**
+     * @param indent The indentation of JSON text, -1 for the compact form.
+     */
+    JsonStreamEncoder(JsonFormat format, std::string& out, int indent = -1);
+
+    void null();
+    void boolean(bool v);
+    void number_integer(I64 v);
+    void number_unsigned(U64 v);
+    void number_float(double v);
+    void string(std::string_view v);
+
+    void start_object();
+    void key(std::string_view k);
+    void end_object();
+    void start_array();
+    void end_array();
+
+    /**
+     * @brief Encode a whole Json value.
+     */
+    void value(const Json& j);
+
+    /**
+     * @brief Append a top-level value encoded by another encoder of the same format.
+     */
+    void raw(std::string_view encoded);
+
+    JsonFormat format() const noexcept;
+
+  private:
+    struct Frame
+    {
+        SizeT begin = 0;  // BSON: the offset of the document size
+        bool  array = false;
+        SizeT count = 0;
+    };
+
+    void element_header(char bson_type);
+    void newline(SizeT depth);
+    void close_document();
+    void write_json_string(std::string_view v);
+
+    JsonFormat    m_format;
+    std::string&  m_out;
+    int           m_indent;
+    vector<Frame> m_frames;
+    std::string   m_key;
+    bool          m_has_key = false;
+
+    // used by JsonStreamWriter to flush `m_out` before the document ends
+    bool                     m_root_document = false;
+    SizeT                    m_flushed       = 0;
+    vector<std::pair<SizeT, I32>> m_patches;  // BSON sizes of already flushed documents
+};
+
+/**
+ * @brief Write a Json document to a stream, the large arrays in it are encoded on the fly.
+ *
+ * Mark a node of the document with `defer()`, it's written as an array whose elements are encoded by the given
+ * encoder when the writer reaches it. The elements are encoded in parallel, a batch at a time, so the
+ * encoded data never has to be held as a whole.
+ *
+ * @note Writing BSON into a non-seekable stream keeps the whole output in memory until the end.
+ */
+class UIPC_CORE_API JsonStreamWriter
+{
+    class Impl;
+
+  public:
+    /**
+     * @brief Encode the i-th element of a deferred array as a top-level value.
+     */
+    using ElementEncoder = std::function<void(SizeT i, JsonStreamEncoder& encoder)>;
+
+    JsonStreamWriter(std::ostream& os, JsonFormat format, int indent = -1);
+    ~JsonStreamWriter();
+
+    /**
+     * @brief Write `node` as an array of `count` elements encoded by `encoder`.
+     *
+     * `node` must be a node of the document passed to `write()`.
+     */
+    void defer(const Json& node, SizeT count, ElementEncoder encoder);
+
+    void write(const Json& document);
+
+  private:
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief Receive the SAX events of a Json subtree, the events are the same as `nlohmann::json_sax`.
+ */
+class UIPC_CORE_API JsonSaxConsumer
+{
+  public:
+    virtual ~JsonSaxConsumer() = default;
+
+    virtual bool null()                     = 0;
+    virtual bool boolean(bool v)            = 0;
+    virtual bool number_integer(I64 v)      = 0;
+    virtual bool number_unsigned(U64 v)     = 0;
+    virtual bool number_float(double v)     = 0;
+    virtual bool string(std::string& v)     = 0;
+    virtual bool start_object()             = 0;
+    virtual bool key(std::string& k)        = 0;
+    virtual bool end_object()               = 0;
+    virtual bool start_array()              = 0;
+    virtual bool end_array()                = 0;
+};
+
+/**
+ * @brief A JsonSaxConsumer building the Json of the subtree.
+ */
+class UIPC_CORE_API JsonSaxDomBuilder final : public JsonSaxConsumer
+{
+  public:
+    JsonSaxDomBuilder() = default;
+
+    bool null() override;
+    bool boolean(bool v) override;
+    bool number_integer(I64 v) override;
+    bool number_unsigned(U64 v) override;
+    bool number_float(double v) override;
+    bool string(std::string& v) override;
+    bool start_object() override;
+    bool key(std::string& k) override;
+    bool end_object() override;
+    bool start_array() override;
+    bool end_array() override;
+
+    /**
+     * @brief Whether the subtree is complete.
+     */
+    bool done() const noexcept;
+    Json& result() noexcept;
+
+  private:
+    template <typename V>
+    Json* emplace(V&& v);
+
+    Json          m_root;
+    vector<Json*> m_stack;
+    Json*         m_slot    = nullptr;
+    bool          m_started = false;
+};
+
+/**
+ * @brief Parse a Json document from a stream with a SAX parser.
+ *
+ * Subtrees can be captured by a JsonSaxConsumer instead of being kept in the Json, so that large arrays
+ * are decoded into their final buffers directly. A captured subtree is `null` in the resulting Json.
+ */
+class UIPC_CORE_API JsonStreamReader
+{
+    class Impl;
+
+  public:
+    /**
+     * @brief Return a consumer to capture the object or array at `path`, or nullptr to keep it in the Json.
+     *
+     * `path` holds the keys from the root, the index of an array element is its key.
+     */
+    using Capture = std::function<S<JsonSaxConsumer>(span<const std::string> path)>;
+
+    JsonStreamReader();
+    ~JsonStreamReader();
+
+    void capture(Capture capture);
+
+    [[nodiscard]] Json read(std::istream& is, JsonFormat format);
+
+  private:
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief The bytes of an encoded value in a stream, `[begin, end)` are the stream positions.
+ *
+ * In BSON, the range holds the value without its element header, `type` is the element type.
+ */
+struct JsonByteRange
+{
+    SizeT begin = 0;
+    SizeT end   = 0;
+    char  type  = 0;
+};
+
+/**
+ * @brief Read a Json document from a stream without decoding the elements of the array at `path`.
+ *
+ * The array is empty in the resulting Json, the byte ranges of its elements are returned in `elements`,
+ * so that an element can be read later by `read_json_range()`. Only the bytes of the elements are scanned,
+ * in BSON they are skipped by seeking.
+ *
+ * `path` holds the keys from the root, the index of an array element is its key.
+ */
+UIPC_CORE_API [[nodiscard]] Json read_json_index(std::istream&           is,
+                                                 JsonFormat              format,
+                                                 span<const std::string> path,
+                                                 vector<JsonByteRange>&  elements);
+
+/**
+ * @brief Read the encoded value at `range`, in the layout accepted by `JsonStreamEncoder::raw()`.
+ */
+UIPC_CORE_API [[nodiscard]] std::string read_json_range(std::istream&        is,
+                                                        JsonFormat           format,
+                                                        const JsonByteRange& range);
+}  // namespace uipc
@@ -0,0 +1,156 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/span.h>
+#include <uipc/common/vector.h>
+
+namespace uipc
+{
+template <typename T, int N>
+class MatrixConverter;
+
+/**
+ * @brief A block sparse matrix of N x N blocks in triplet form `(i, j, block)`.
+ *
+ * The triplets are unordered and the repeated `(i, j)` are summed up when converted to BCOO,
+ * see `MatrixConverter`. The indices are block indices.
+ */
+template <typename T, int N>
+class TripletMatrix
+{
+  public:
+    using BlockT = Eigen::Matrix<T, N, N>;
+
+    TripletMatrix() = default;
+    TripletMatrix(SizeT block_rows, SizeT block_cols);
+
+    void reshape(SizeT block_rows, SizeT block_cols) noexcept;
+
+    [[nodiscard]] SizeT block_rows() const noexcept { return m_block_rows; }
+    [[nodiscard]] SizeT block_cols() const noexcept { return m_block_cols; }
+    [[nodiscard]] SizeT rows() const noexcept { return m_block_rows * N; }
+    [[nodiscard]] SizeT cols() const noexcept { return m_block_cols * N; }
+    [[nodiscard]] SizeT triplet_count() const noexcept { return m_values.size(); }
+
+    void reserve(SizeT triplet_count);
+
+    /**
+     * @brief Remove all the triplets, the shape is kept.
+     */
+    void clear() noexcept;
+
+    void push_back(IndexT i, IndexT j, const BlockT& block);
+
+    /**
+     * @brief Append the triplets emitted by `f(I, emit)` for all `I` in `[0, count)` in parallel.
+     *
+     * `emit(i, j, block)` appends a triplet, `f` may emit any number of triplets. Each thread collects its
+     * triplets in its own buffer, the buffers are appended in the order of `I`, so the result is the same
+     * as calling `f` in a serial loop.
+     */
+    template <typename F>
+    void parallel_push_back(SizeT count, F&& f);
+
+    [[nodiscard]] span<const IndexT> row_indices() const noexcept { return m_row_indices; }
+    [[nodiscard]] span<const IndexT> col_indices() const noexcept { return m_col_indices; }
+    [[nodiscard]] span<const BlockT> values() const noexcept { return m_values; }
+
+  private:
+    SizeT          m_block_rows = 0;
+    SizeT          m_block_cols = 0;
+    vector<IndexT> m_row_indices;
+    vector<IndexT> m_col_indices;
+    vector<BlockT> m_values;
+};
+
+/**
+ * @brief A block sparse matrix of N x N blocks in block coordinate form.
+ *
+ * The blocks are sorted by `(i, j)` and each `(i, j)` appears once, built by `MatrixConverter`.
+ */
+template <typename T, int N>
+class BCOOMatrix
+{
+  public:
+    using BlockT = Eigen::Matrix<T, N, N>;
+
+    [[nodiscard]] SizeT block_rows() const noexcept { return m_block_rows; }
+    [[nodiscard]] SizeT block_cols() const noexcept { return m_block_cols; }
+    [[nodiscard]] SizeT rows() const noexcept { return m_block_rows * N; }
+    [[nodiscard]] SizeT cols() const noexcept { return m_block_cols * N; }
+    [[nodiscard]] SizeT non_zeros() const noexcept { return m_values.size(); }
+
+    [[nodiscard]] span<const IndexT> row_indices() const noexcept { return m_row_indices; }
+    [[nodiscard]] span<const IndexT> col_indices() const noexcept { return m_col_indices; }
+    [[nodiscard]] span<const BlockT> values() const noexcept { return m_values; }
+    /**
+     * @brief The blocks can be updated in place, the sparsity pattern is fixed.
+     */
+    [[nodiscard]] span<BlockT> values() noexcept { return m_values; }
+
+  private:
+    friend class MatrixConverter<T, N>;
+
+    SizeT          m_block_rows = 0;
+    SizeT          m_block_cols = 0;
+    vector<IndexT> m_row_indices;
+    vector<IndexT> m_col_indices;
+    vector<BlockT> m_values;
+};
+
+/**
+ * @brief A block sparse matrix of N x N blocks in block compressed sparse row form.
+ *
+ * The blocks of row `i` are `[row_offsets()[i], row_offsets()[i+1])`, sorted by column, built by `MatrixConverter`.
+ *
+ * The column-major traversal of the blocks (`col_offsets()`, `col_blocks()`) is kept as well,
+ * so that a symmetric matrix stored as its upper triangle can be multiplied without scattering, see `sym_spmv()`.
+ */
+template <typename T, int N>
+class BSRMatrix
+{
+  public:
+    using BlockT = Eigen::Matrix<T, N, N>;
+
+    [[nodiscard]] SizeT block_rows() const noexcept { return m_block_rows; }
+    [[nodiscard]] SizeT block_cols() const noexcept { return m_block_cols; }
+    [[nodiscard]] SizeT rows() const noexcept { return m_block_rows * N; }
+    [[nodiscard]] SizeT cols() const noexcept { return m_block_cols * N; }
+    [[nodiscard]] SizeT non_zeros() const noexcept { return m_values.size(); }
+
+    [[nodiscard]] span<const IndexT> row_offsets() const noexcept { return m_row_offsets; }
+    [[nodiscard]] span<const IndexT> col_indices() const noexcept { return m_col_indices; }
+    [[nodiscard]] span<const BlockT> values() const noexcept { return m_values; }
+    /**
+     * @brief The blocks can be updated in place, the sparsity pattern is fixed.
+     */
+    [[nodiscard]] span<BlockT> values() noexcept { return m_values; }
+
+    /**
+     * @brief The blocks of column `j` are `col_blocks()[col_offsets()[j] .. col_offsets()[j+1]]`.
+     */
+    [[nodiscard]] span<const IndexT> col_offsets() const noexcept { return m_col_offsets; }
+    /**
+     * @brief The block indices (into `values()`) in column-major order, sorted by row within a column.
+     */
+    [[nodiscard]] span<const IndexT> col_blocks() const noexcept { return m_col_blocks; }
+    /**
+     * @brief The row index of each entry of `col_blocks()`.
+     */
+    [[nodiscard]] span<const IndexT> col_block_rows() const noexcept { return m_col_block_rows; }
+
+  private:
+    friend class MatrixConverter<T, N>;
+
+    SizeT          m_block_rows = 0;
+    SizeT          m_block_cols = 0;
+    vector<IndexT> m_row_offsets;
+    vector<IndexT> m_col_indices;
+    vector<BlockT> m_values;
+
+    vector<IndexT> m_col_offsets;
+    vector<IndexT> m_col_blocks;
+    vector<IndexT> m_col_block_rows;
+};
+}  // namespace uipc
+
+#include "details/block_matrix.inl"
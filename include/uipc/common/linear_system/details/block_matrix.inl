@@ -0,0 +1,108 @@
+#include <uipc/common/parallel_for.h>
+#include <algorithm>
+#include <vector>
+
+namespace uipc
+{
+template <typename T, int N>
+TripletMatrix<T, N>::TripletMatrix(SizeT block_rows, SizeT block_cols)
+    : m_block_rows(block_rows)
+    , m_block_cols(block_cols)
+{
+}
+
+template <typename T, int N>
+void TripletMatrix<T, N>::reshape(SizeT block_rows, SizeT block_cols) noexcept
+{
+    m_block_rows = block_rows;
+    m_block_cols = block_cols;
+}
+
+template <typename T, int N>
+void TripletMatrix<T, N>::reserve(SizeT triplet_count)
+{
+    m_row_indices.reserve(triplet_count);
+    m_col_indices.reserve(triplet_count);
+    m_values.reserve(triplet_count);
+}
+
+template <typename T, int N>
+void TripletMatrix<T, N>::clear() noexcept
+{
+    m_row_indices.clear();
+    m_col_indices.clear();
+    m_values.clear();
+}
+
+template <typename T, int N>
+void TripletMatrix<T, N>::push_back(IndexT i, IndexT j, const BlockT& block)
+{
+    m_row_indices.push_back(i);
+    m_col_indices.push_back(j);
+    m_values.push_back(block);
+}
+
+template <typename T, int N>
+template <typename F>
+void TripletMatrix<T, N>::parallel_push_back(SizeT count, F&& f)
+{
+    if(count == 0)
+        return;
+
+    // the buffers live on the threads that fill them, the memory resource of the matrix is only
+    // touched by the calling thread
+    struct Buffer
+    {
+        std::vector<IndexT> row_indices;
+        std::vector<IndexT> col_indices;
+        std::vector<BlockT> values;
+    };
+
+    constexpr SizeT MinTaskSize = 256;
+
+    const SizeT max_threads = exec::executor()->concurrency();
+    const SizeT task_count = std::clamp<SizeT>((count + MinTaskSize - 1) / MinTaskSize, 1, max_threads);
+    const SizeT task_size = (count + task_count - 1) / task_count;
+
+    // 1) every task fills its own buffer with a contiguous range of `I`
+    std::vector<Buffer> buffers(task_count);
+    parallel_for(0,
+                 task_count,
+                 [&](SizeT t)
+                 {
+                     auto& buffer = buffers[t];
+                     auto  emit   = [&buffer](IndexT i, IndexT j, const BlockT& block)
+                     {
+                         buffer.row_indices.push_back(i);
+                         buffer.col_indices.push_back(j);
+                         buffer.values.push_back(block);
+                     };
+
+                     SizeT end = std::min(count, (t + 1) * task_size);
+                     for(SizeT I = t * task_size; I < end; ++I)
+                         f(I, emit);
+                 },
+                 1);
+
+    // 2) allocate on this thread
+    std::vector<SizeT> offsets(task_count + 1, m_values.size());
+    for(SizeT t = 0; t < task_count; ++t)
+        offsets[t + 1] = offsets[t] + buffers[t].values.size();
+
+    m_row_indices.resize(offsets.back());
+    m_col_indices.resize(offsets.back());
+    m_values.resize(offsets.back());
+
+    // 3) append in the order of the tasks
+    parallel_for(0,
+                 task_count,
+                 [&](SizeT t)
+                 {
+                     auto& buffer = buffers[t];
+                     std::ranges::copy(buffer.row_indices, m_row_indices.begin() + offsets[t]);
+                     std::ranges::copy(buffer.col_indices, m_col_indices.begin() + offsets[t]);
+                     std::ranges::copy(buffer.values, m_values.begin() + offsets[t]);
+                 },
+                 1);
+}
+}  // namespace uipc
@@ -0,0 +1,317 @@
+#include <uipc/common/log.h>
+#include <uipc/common/parallel_for.h>
+#include <algorithm>
+#include <bit>
+
+namespace uipc
+{
+namespace detail
+{
+    inline SizeT linear_system_task_count(SizeT n, SizeT min_task_size)
+    {
+        const SizeT max_threads = exec::executor()->concurrency();
+        return std::clamp<SizeT>((n + min_task_size - 1) / min_task_size, 1, max_threads);
+    }
+
+    /**
+     * @brief Stable LSD radix sort of `keys` with `values`, 8 bits per pass, each pass counts and scatters
+     * contiguous ranges of the input in parallel.
+     *
+     * `keys_temp` and `values_temp` are scratch buffers of the same size, `histogram` is resized as needed.
+     */
+    template <typename K, typename V>
+    void radix_sort_pairs(span<K>             keys,
+                          span<V>             values,
+                          span<K>             keys_temp,
+                          span<V>             values_temp,
+                          int                 key_bits,
+                          std::vector<SizeT>& histogram)
+    {
+        constexpr int   RadixBits   = 8;
+        constexpr SizeT Radix       = SizeT{1} << RadixBits;
+        constexpr SizeT MinTaskSize = 4096;
+
+        const SizeT n          = keys.size();
+        const SizeT task_count = linear_system_task_count(n, MinTaskSize);
+        const SizeT task_size  = (n + task_count - 1) / task_count;
+
+        histogram.resize(task_count * Radix);
+
+        span<K> src_keys   = keys;
+        span<V> src_values = values;
+        span<K> dst_keys   = keys_temp;
+        span<V> dst_values = values_temp;
+
+        for(int shift = 0; shift < key_bits; shift += RadixBits)
+        {
+            auto digit = [shift](K key) { return (key >> shift) & (Radix - 1); };
+
+            // 1) count the digits of each task
+            parallel_for(0,
+                         task_count,
+                         [&](SizeT t)
+                         {
+                             auto h = span{histogram}.subspan(t * Radix, Radix);
+                             std::ranges::fill(h, 0);
+                             SizeT end = std::min(n, (t + 1) * task_size);
+                             for(SizeT i = t * task_size; i < end; ++i)
+                                 ++h[digit(src_keys[i])];
+                         },
+                         1);
+
+            // 2) digit-major, task-minor exclusive scan keeps the sort stable
+            SizeT sum = 0;
+            for(SizeT d = 0; d < Radix; ++d)
+            {
+                for(SizeT t = 0; t < task_count; ++t)
+                {
+                    auto count               = histogram[t * Radix + d];
+                    histogram[t * Radix + d] = sum;
+                    sum += count;
+                }
+            }
+
+            // 3) scatter
+            parallel_for(0,
+                         task_count,
+                         [&](SizeT t)
+                         {
+                             auto  h   = span{histogram}.subspan(t * Radix, Radix);
+                             SizeT end = std::min(n, (t + 1) * task_size);
+                             for(SizeT i = t * task_size; i < end; ++i)
+                             {
+                                 auto pos        = h[digit(src_keys[i])]++;
+                                 dst_keys[pos]   = src_keys[i];
+                                 dst_values[pos] = src_values[i];
+                             }
+                         },
+                         1);
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+        }
+
+        // odd number of passes, the result is in the scratch buffers
+        if(src_keys.data() != keys.data())
+        {
+            parallel_for(0,
+                         n,
+                         [&](SizeT i)
+                         {
+                             keys[i]   = src_keys[i];
+                             values[i] = src_values[i];
+                         },
+                         MinTaskSize);
+        }
+    }
+
+    inline int key_bits(U64 max_key)
+    {
+        return std::max(1, static_cast<int>(std::bit_width(max_key)));
+    }
+}  // namespace detail
+
+template <typename T, int N>
+void MatrixConverter<T, N>::sort(int key_bits)
+{
+    auto n = m_keys.size();
+    m_keys_temp.resize(n);
+    m_order_temp.resize(n);
+    detail::radix_sort_pairs<U64, IndexT>(m_keys, m_order, m_keys_temp, m_order_temp, key_bits, m_histogram);
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::convert(const TripletMatrix<T, N>& from, BCOOMatrix<T, N>& to)
+{
+    const SizeT n          = from.triplet_count();
+    const SizeT block_cols = from.block_cols();
+
+    to.m_block_rows = from.block_rows();
+    to.m_block_cols = block_cols;
+
+    auto rows   = from.row_indices();
+    auto cols   = from.col_indices();
+    auto values = from.values();
+
+    // 1) sort the triplets by (i, j)
+    m_keys.resize(n);
+    m_order.resize(n);
+    parallel_for(0,
+                 n,
+                 [&](SizeT I)
+                 {
+                     UIPC_ASSERT(rows[I] >= 0 && rows[I] < static_cast<IndexT>(from.block_rows())
+                                     && cols[I] >= 0 && cols[I] < static_cast<IndexT>(block_cols),
+                                 "Triplet {} ({}, {}) is out of the block shape ({}, {}).",
+                                 I,
+                                 rows[I],
+                                 cols[I],
+                                 from.block_rows(),
+                                 block_cols);
+                     m_keys[I]  = static_cast<U64>(rows[I]) * block_cols + cols[I];
+                     m_order[I] = static_cast<IndexT>(I);
+                 });
+    sort(detail::key_bits(static_cast<U64>(from.block_rows()) * block_cols));
+
+    // 2) find the unique keys
+    m_unique_offsets.clear();
+    for(SizeT I = 0; I < n; ++I)
+    {
+        if(I == 0 || m_keys[I] != m_keys[I - 1])
+            m_unique_offsets.push_back(I);
+    }
+    m_unique_offsets.push_back(n);
+
+    // 3) sum up the blocks of each unique key
+    const SizeT unique_count = m_unique_offsets.size() - 1;
+    to.m_row_indices.resize(unique_count);
+    to.m_col_indices.resize(unique_count);
+    to.m_values.resize(unique_count);
+
+    parallel_for(0,
+                 unique_count,
+                 [&](SizeT u)
+                 {
+                     auto begin = m_unique_offsets[u];
+                     auto end   = m_unique_offsets[u + 1];
+                     auto key   = m_keys[begin];
+
+                     BlockT sum = values[m_order[begin]];
+                     for(SizeT I = begin + 1; I < end; ++I)
+                         sum += values[m_order[I]];
+
+                     to.m_row_indices[u] = static_cast<IndexT>(key / block_cols);
+                     to.m_col_indices[u] = static_cast<IndexT>(key % block_cols);
+                     to.m_values[u]      = sum;
+                 });
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::convert(const BCOOMatrix<T, N>& from, BSRMatrix<T, N>& to)
+{
+    const SizeT nnz = from.non_zeros();
+
+    to.m_block_rows = from.block_rows();
+    to.m_block_cols = from.block_cols();
+    to.m_col_indices.assign(from.m_col_indices.begin(), from.m_col_indices.end());
+    to.m_values.assign(from.m_values.begin(), from.m_values.end());
+
+    auto rows = from.row_indices();
+
+    // 1) the row offsets, the rows are sorted
+    to.m_row_offsets.resize(from.block_rows() + 1);
+    parallel_for(0,
+                 from.block_rows() + 1,
+                 [&](SizeT i)
+                 {
+                     to.m_row_offsets[i] = static_cast<IndexT>(
+                         std::ranges::lower_bound(rows, static_cast<IndexT>(i)) - rows.begin());
+                 });
+
+    // 2) the column-major traversal, the blocks are already sorted by row,
+    // so a stable sort by column sorts them by row within a column
+    m_keys.resize(nnz);
+    m_order.resize(nnz);
+    parallel_for(0,
+                 nnz,
+                 [&](SizeT k)
+                 {
+                     m_keys[k]  = from.m_col_indices[k];
+                     m_order[k] = static_cast<IndexT>(k);
+                 });
+    sort(detail::key_bits(from.block_cols()));
+
+    to.m_col_blocks.assign(m_order.begin(), m_order.end());
+    to.m_col_block_rows.resize(nnz);
+    parallel_for(0, nnz, [&](SizeT k) { to.m_col_block_rows[k] = rows[m_order[k]]; });
+
+    to.m_col_offsets.resize(from.block_cols() + 1);
+    parallel_for(0,
+                 from.block_cols() + 1,
+                 [&](SizeT j)
+                 {
+                     to.m_col_offsets[j] = static_cast<IndexT>(
+                         std::ranges::lower_bound(m_keys, static_cast<U64>(j)) - m_keys.begin());
+                 });
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::ge2sym(BCOOMatrix<T, N>& to)
+{
+    m_order.clear();
+    for(SizeT k = 0; k < to.non_zeros(); ++k)
+    {
+        if(to.m_row_indices[k] <= to.m_col_indices[k])
+            m_order.push_back(static_cast<IndexT>(k));
+    }
+
+    // the kept blocks only move forward, so they can be compacted in place
+    for(SizeT k = 0; k < m_order.size(); ++k)
+    {
+        auto src            = m_order[k];
+        to.m_row_indices[k] = to.m_row_indices[src];
+        to.m_col_indices[k] = to.m_col_indices[src];
+        to.m_values[k]      = to.m_values[src];
+    }
+
+    to.m_row_indices.resize(m_order.size());
+    to.m_col_indices.resize(m_order.size());
+    to.m_values.resize(m_order.size());
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::sym2ge(const BCOOMatrix<T, N>& from, BCOOMatrix<T, N>& to)
+{
+    UIPC_ASSERT(&from != &to, "sym2ge can't be done in place.");
+
+    const SizeT nnz        = from.non_zeros();
+    const SizeT block_cols = from.block_cols();
+    // the mirror of a diagonal block is sorted to the end and dropped
+    const U64 dropped = static_cast<U64>(from.block_rows()) * block_cols;
+
+    to.m_block_rows = from.block_rows();
+    to.m_block_cols = block_cols;
+
+    // entry 2k is the block k, entry 2k+1 is its mirror
+    m_keys.resize(2 * nnz);
+    m_order.resize(2 * nnz);
+    SizeT diag_count = 0;
+    for(SizeT k = 0; k < nnz; ++k)
+        diag_count += from.m_row_indices[k] == from.m_col_indices[k] ? 1 : 0;
+
+    parallel_for(0,
+                 nnz,
+                 [&](SizeT k)
+                 {
+                     U64 i = from.m_row_indices[k];
+                     U64 j = from.m_col_indices[k];
+
+                     m_keys[2 * k]      = i * block_cols + j;
+                     m_keys[2 * k + 1]  = i == j ? dropped : j * block_cols + i;
+                     m_order[2 * k]     = static_cast<IndexT>(2 * k);
+                     m_order[2 * k + 1] = static_cast<IndexT>(2 * k + 1);
+                 });
+    sort(detail::key_bits(dropped));
+
+    const SizeT ge_count = 2 * nnz - diag_count;
+    to.m_row_indices.resize(ge_count);
+    to.m_col_indices.resize(ge_count);
+    to.m_values.resize(ge_count);
+
+    parallel_for(0,
+                 ge_count,
+                 [&](SizeT m)
+                 {
+                     auto  key   = m_keys[m];
+                     auto  entry = m_order[m];
+                     auto& block = from.m_values[entry / 2];
+
+                     to.m_row_indices[m] = static_cast<IndexT>(key / block_cols);
+                     to.m_col_indices[m] = static_cast<IndexT>(key % block_cols);
+                     if(entry % 2 == 0)
+                         to.m_values[m] = block;
+                     else
+                         to.m_values[m] = block.transpose();
+                 });
+}
+}  // namespace uipc
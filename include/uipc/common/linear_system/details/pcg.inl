@@ -0,0 +1,150 @@
+#include <Eigen/LU>
+#include <uipc/common/log.h>
+#include <uipc/common/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace uipc
+{
+namespace detail
+{
+    inline constexpr SizeT PCGChunkSize = 4096;
+
+    // the partial sums of fixed-size chunks are added up in order, so the result doesn't depend on the thread count
+    template <typename T>
+    T pcg_dot(span<const T> a, span<const T> b)
+    {
+        const SizeT    chunk_count = (a.size() + PCGChunkSize - 1) / PCGChunkSize;
+        std::vector<T> partial(chunk_count, T{0});
+        parallel_for(0,
+                     chunk_count,
+                     [&](SizeT c)
+                     {
+                         SizeT begin = c * PCGChunkSize;
+                         SizeT end   = std::min(a.size(), begin + PCGChunkSize);
+                         T     sum   = T{0};
+                         for(SizeT i = begin; i < end; ++i)
+                             sum += a[i] * b[i];
+                         partial[c] = sum;
+                     },
+                     1);
+
+        T sum = T{0};
+        for(auto p : partial)
+            sum += p;
+        return sum;
+    }
+
+    // y = a * x + b * y
+    template <typename T>
+    void pcg_axpby(T a, span<const T> x, T b, span<T> y)
+    {
+        parallel_for(0, y.size(), [&](SizeT i) { y[i] = a * x[i] + b * y[i]; }, PCGChunkSize);
+    }
+}  // namespace detail
+
+template <typename T, int N>
+void BlockJacobiPreconditioner<T, N>::build(const BSRMatrix<T, N>& A)
+{
+    UIPC_ASSERT(A.block_rows() == A.block_cols(),
+                "The block Jacobi preconditioner needs a square matrix, yours is ({}, {}).",
+                A.block_rows(),
+                A.block_cols());
+
+    auto offsets = A.row_offsets();
+    auto cols    = A.col_indices();
+    auto blocks  = A.values();
+
+    m_inv_diag.resize(A.block_rows());
+    parallel_for(0,
+                 A.block_rows(),
+                 [&](SizeT i)
+                 {
+                     auto row_cols = cols.subspan(offsets[i], offsets[i + 1] - offsets[i]);
+                     auto it = std::ranges::lower_bound(row_cols, static_cast<IndexT>(i));
+
+                     BlockT inv = BlockT::Identity();
+                     if(it != row_cols.end() && *it == static_cast<IndexT>(i))
+                     {
+                         BlockT diag = blocks[offsets[i] + (it - row_cols.begin())];
+                         inv         = diag.inverse();
+                         if(!inv.allFinite())
+                             inv = BlockT::Identity();
+                     }
+                     m_inv_diag[i] = inv;
+                 },
+                 256);
+}
+
+template <typename T, int N>
+void BlockJacobiPreconditioner<T, N>::apply(span<const T> r, span<T> z) const
+{
+    using SegmentT = Eigen::Vector<T, N>;
+
+    UIPC_ASSERT(r.size() == m_inv_diag.size() * N && z.size() == r.size(),
+                "Size mismatch, preconditioner size is {}, r size is {}, z size is {}.",
+                m_inv_diag.size() * N,
+                r.size(),
+                z.size());
+
+    parallel_for(0,
+                 m_inv_diag.size(),
+                 [&](SizeT i)
+                 {
+                     Eigen::Map<SegmentT>(z.data() + i * N).noalias() =
+                         m_inv_diag[i] * Eigen::Map<const SegmentT>(r.data() + i * N);
+                 },
+                 256);
+}
+
+template <typename T, typename MatVec, typename Precond>
+SizeT pcg(MatVec&& A, Precond&& P, span<T> x, span<const T> b, T tol_rate, SizeT max_iter)
+{
+    UIPC_ASSERT(x.size() == b.size(), "Size mismatch, x size is {}, b size is {}.", x.size(), b.size());
+
+    const SizeT    n = b.size();
+    std::vector<T> r(n), z(n), p(n), Ap(n);
+
+    // r = b - A * x
+    A(span<const T>{x}, span<T>{Ap});
+    parallel_for(0, n, [&](SizeT i) { r[i] = b[i] - Ap[i]; }, detail::PCGChunkSize);
+
+    // z = P * r, p = z
+    P(span<const T>{r}, span<T>{z});
+    p = z;
+
+    T rz  = detail::pcg_dot<T>(r, z);
+    T rz0 = std::abs(rz);
+
+    UIPC_ASSERT(std::isfinite(rz0), "Init Residual is {}.", rz0);
+
+    if(rz0 == T{0})
+        return 0;
+
+    SizeT k = 0;
+    for(k = 1; k < max_iter; ++k)
+    {
+        A(span<const T>{p}, span<T>{Ap});
+
+        T alpha = rz / detail::pcg_dot<T>(p, Ap);
+        // x = x + alpha * p
+        detail::pcg_axpby<T>(alpha, p, T{1}, x);
+        // r = r - alpha * Ap
+        detail::pcg_axpby<T>(-alpha, Ap, T{1}, r);
+
+        P(span<const T>{r}, span<T>{z});
+        T rz_new = detail::pcg_dot<T>(r, z);
+
+        UIPC_ASSERT(std::isfinite(rz_new), "Residual is {}.", rz_new);
+
+        if(std::abs(rz_new) <= tol_rate * rz0)
+            break;
+
+        // p = z + beta * p
+        detail::pcg_axpby<T>(T{1}, z, rz_new / rz, p);
+        rz = rz_new;
+    }
+    return k;
+}
+}  // namespace uipc
@@ -0,0 +1,108 @@
+#include <uipc/common/log.h>
+#include <uipc/common/parallel_for.h>
+
+namespace uipc
+{
+namespace detail
+{
+    // y_i = a * acc + b * y_i for every block row i, acc is computed by `row(i)`
+    template <typename T, int N, typename F>
+    void block_row_apply(SizeT block_rows, T a, T b, span<T> y, F&& row)
+    {
+        using SegmentT = Eigen::Vector<T, N>;
+
+        UIPC_ASSERT(y.size() == block_rows * N,
+                    "The size of y ({}) doesn't match the matrix rows ({}).",
+                    y.size(),
+                    block_rows * N);
+
+        parallel_for(0,
+                     block_rows,
+                     [&](SizeT i)
+                     {
+                         SegmentT             acc = row(i);
+                         Eigen::Map<SegmentT> Y(y.data() + i * N);
+                         // b == 0 overwrites y, even if y holds NaN
+                         if(b == T{0})
+                             Y = a * acc;
+                         else
+                             Y = a * acc + b * Y;
+                     },
+                     256);
+    }
+}  // namespace detail
+
+template <typename T, int N>
+void spmv(T a, const BSRMatrix<T, N>& A, span<const T> x, T b, span<T> y)
+{
+    using SegmentT = Eigen::Vector<T, N>;
+
+    UIPC_ASSERT(x.size() == A.cols(),
+                "The size of x ({}) doesn't match the matrix cols ({}).",
+                x.size(),
+                A.cols());
+
+    auto offsets = A.row_offsets();
+    auto cols    = A.col_indices();
+    auto blocks  = A.values();
+
+    detail::block_row_apply<T, N>(A.block_rows(),
+                                  a,
+                                  b,
+                                  y,
+                                  [&](SizeT i)
+                                  {
+                                      SegmentT acc = SegmentT::Zero();
+                                      for(IndexT k = offsets[i]; k < offsets[i + 1]; ++k)
+                                          acc.noalias() +=
+                                              blocks[k]
+                                              * Eigen::Map<const SegmentT>(x.data() + cols[k] * N);
+                                      return acc;
+                                  });
+}
+
+template <typename T, int N>
+void sym_spmv(T a, const BSRMatrix<T, N>& A, span<const T> x, T b, span<T> y)
+{
+    using SegmentT = Eigen::Vector<T, N>;
+
+    UIPC_ASSERT(A.block_rows() == A.block_cols(),
+                "A symmetric matrix must be square, yours is ({}, {}).",
+                A.block_rows(),
+                A.block_cols());
+    UIPC_ASSERT(x.size() == A.cols(),
+                "The size of x ({}) doesn't match the matrix cols ({}).",
+                x.size(),
+                A.cols());
+
+    auto offsets     = A.row_offsets();
+    auto cols        = A.col_indices();
+    auto blocks      = A.values();
+    auto col_offsets = A.col_offsets();
+    auto col_blocks  = A.col_blocks();
+    auto col_rows    = A.col_block_rows();
+
+    detail::block_row_apply<T, N>(
+        A.block_rows(),
+        a,
+        b,
+        y,
+        [&](SizeT i)
+        {
+            SegmentT acc = SegmentT::Zero();
+            // the upper blocks A_ij, j >= i
+            for(IndexT k = offsets[i]; k < offsets[i + 1]; ++k)
+                acc.noalias() += blocks[k] * Eigen::Map<const SegmentT>(x.data() + cols[k] * N);
+            // the lower blocks A_ij = A_ji^T, j < i
+            for(IndexT m = col_offsets[i]; m < col_offsets[i + 1]; ++m)
+            {
+                IndexT j = col_rows[m];
+                if(j == static_cast<IndexT>(i))
+                    continue;
+                acc.noalias() += blocks[col_blocks[m]].transpose()
+                                 * Eigen::Map<const SegmentT>(x.data() + j * N);
+            }
+            return acc;
+        });
+}
+}  // namespace uipc
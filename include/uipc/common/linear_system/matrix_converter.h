@@ -0,0 +1,55 @@
+#pragma once
+#include <uipc/common/linear_system/block_matrix.h>
+#include <vector>
+
+namespace uipc
+{
+/**
+ * @brief Convert the block sparse matrices between the triplet, BCOO and BSR forms on the host.
+ *
+ * The host counterpart of the CUDA backend's `MatrixConverter`: the triplets are sorted by a parallel
+ * LSD radix sort on their `(i, j)` keys, and the blocks of the repeated keys are summed up. The sort is stable,
+ * so the blocks are summed in the order of the triplets and the result doesn't depend on the thread count.
+ *
+ * The scratch buffers are kept between the calls, reuse the converter to avoid reallocating them.
+ */
+template <typename T, int N>
+class MatrixConverter
+{
+  public:
+    using BlockT = Eigen::Matrix<T, N, N>;
+
+    /**
+     * @brief Triplet -> BCOO, the blocks of the repeated `(i, j)` are summed up.
+     */
+    void convert(const TripletMatrix<T, N>& from, BCOOMatrix<T, N>& to);
+
+    /**
+     * @brief BCOO -> BSR
+     */
+    void convert(const BCOOMatrix<T, N>& from, BSRMatrix<T, N>& to);
+
+    /**
+     * @brief Keep the upper triangular blocks (i <= j) of a symmetric matrix.
+     */
+    void ge2sym(BCOOMatrix<T, N>& to);
+
+    /**
+     * @brief Restore the full matrix from the upper triangular blocks of a symmetric matrix.
+     */
+    void sym2ge(const BCOOMatrix<T, N>& from, BCOOMatrix<T, N>& to);
+
+  private:
+    // sort m_order by m_keys, the keys are less than 2^key_bits
+    void sort(int key_bits);
+
+    std::vector<U64>    m_keys;
+    std::vector<U64>    m_keys_temp;
+    std::vector<IndexT> m_order;
+    std::vector<IndexT> m_order_temp;
+    std::vector<SizeT>  m_histogram;
+    std::vector<SizeT>  m_unique_offsets;
+};
+}  // namespace uipc
+
+#include "details/matrix_converter.inl"
@@ -0,0 +1,45 @@
+#pragma once
+#include <uipc/common/linear_system/block_matrix.h>
+
+namespace uipc
+{
+/**
+ * @brief The block Jacobi preconditioner, the inverses of the N x N diagonal blocks.
+ */
+template <typename T, int N>
+class BlockJacobiPreconditioner
+{
+  public:
+    using BlockT = Eigen::Matrix<T, N, N>;
+
+    /**
+     * @brief Invert the diagonal blocks of `A`, a missing or singular diagonal block is replaced by the identity.
+     */
+    void build(const BSRMatrix<T, N>& A);
+
+    /**
+     * @brief z = P * r
+     */
+    void apply(span<const T> r, span<T> z) const;
+
+    void operator()(span<const T> r, span<T> z) const { apply(r, z); }
+
+  private:
+    vector<BlockT> m_inv_diag;
+};
+
+/**
+ * @brief Solve `A * x = b` by the preconditioned conjugate gradient method, starting from the given `x`.
+ *
+ * The host counterpart of the CUDA backend's `LinearPCG`, converged when `|r^T z| <= tol_rate * |r0^T z0|`.
+ * The dot products sum fixed-size chunks in a fixed order, so the iterations don't depend on the thread count.
+ *
+ * @param A `A(p, Ap)` computes `Ap = A * p`, e.g. a lambda calling `sym_spmv()`
+ * @param P `P(r, z)` computes `z = P * r`, e.g. a `BlockJacobiPreconditioner`
+ * @return the iteration count
+ */
+template <typename T, typename MatVec, typename Precond>
+SizeT pcg(MatVec&& A, Precond&& P, span<T> x, span<const T> b, T tol_rate, SizeT max_iter);
+}  // namespace uipc
+
+#include "details/pcg.inl"
@@ -0,0 +1,25 @@
+#pragma once
+#include <uipc/common/linear_system/block_matrix.h>
+
+namespace uipc
+{
+/**
+ * @brief y = a * A * x + b * y
+ *
+ * The block rows are computed in parallel, each block is a fixed size N x N product.
+ */
+template <typename T, int N>
+void spmv(T a, const BSRMatrix<T, N>& A, span<const T> x, T b, span<T> y);
+
+/**
+ * @brief y = a * A * x + b * y, `A` is symmetric and only its upper triangular blocks (i <= j) are stored,
+ * see `MatrixConverter::ge2sym()`.
+ *
+ * A block row gathers the blocks of its row and the transposed blocks of its column, so the rows are computed
+ * in parallel without atomics, and the result doesn't depend on the thread count.
+ */
+template <typename T, int N>
+void sym_spmv(T a, const BSRMatrix<T, N>& A, span<const T> x, T b, span<T> y);
+}  // namespace uipc
+
+#include "details/spmv.inl"
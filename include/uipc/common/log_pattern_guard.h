@@ -3,10 +3,16 @@
 #include <uipc/common/dllexport.h>
 namespace uipc
 {
+/**
+ * @brief Prefix the messages of the default logger logged on this thread with `[pattern]` in the scope of the guard.
+ */
 class UIPC_CORE_API LogPatternGuard
 {
   public:
     LogPatternGuard(std::string_view pattern) noexcept;
     ~LogPatternGuard() noexcept;
+
+  private:
+    std::string m_previous;
 };
 }  // namespace uipc
@@ -0,0 +1,95 @@
+#pragma once
+#include <memory_resource>
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+#include <uipc/common/json.h>
+#include <uipc/common/smart_pointer.h>
+
+namespace uipc
+{
+/**
+ * @brief A memory resource that maps its blocks with (transparent) huge pages.
+ *
+ * Large blocks are mapped directly and advised to use huge pages, small blocks are forwarded to the upstream resource.
+ * On platforms without huge page support, all requests are forwarded to the upstream resource.
+ */
+class UIPC_CORE_API HugePageMemoryResource final : public std::pmr::memory_resource
+{
+  public:
+    explicit HugePageMemoryResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                                    SizeT min_huge_block = 2ull << 20) noexcept;
+
+    std::pmr::memory_resource* upstream() const noexcept;
+
+  private:
+    void* do_allocate(SizeT bytes, SizeT alignment) override;
+    void  do_deallocate(void* p, SizeT bytes, SizeT alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* m_upstream;
+    SizeT                      m_min_huge_block;
+};
+
+/**
+ * @brief Get the global huge page memory resource (upstream = new_delete_resource).
+ */
+UIPC_CORE_API std::pmr::memory_resource* huge_page_resource() noexcept;
+
+/**
+ * @brief The default config of `create_memory_resource()`.
+ *
+ * ```json
+ * {
+ *     "type": "default", // "default" | "pool" | "synchronized_pool" | "monotonic"
+ *     "synchronized": true, // lock the "pool" and "monotonic" resources, false only if the resource is never shared across threads
+ *     "huge_page": false, // use huge page resource as the upstream
+ *     "initial_size": 0, // initial buffer size of the monotonic resource (bytes)
+ *     "max_blocks_per_chunk": 0, // pool option, 0 means implementation defined
+ *     "largest_required_pool_block": 0 // pool option, 0 means implementation defined
+ * }
+ * ```
+ */
+UIPC_CORE_API Json default_memory_resource_config();
+
+/**
+ * @brief Create a memory resource from the config.
+ *
+ * The returned resource must outlive all the objects allocated from it.
+ *
+ * @sa default_memory_resource_config()
+ */
+UIPC_CORE_API S<std::pmr::memory_resource> create_memory_resource(
+    const Json& config = default_memory_resource_config());
+
+/**
+ * @brief Set the process-wide default memory resource, and restore the previous one on destruction.
+ *
+ * `std::pmr::set_default_resource()` is global: while the guard is alive, every thread allocates from
+ * the given resource, including the worker threads of `uipc::exec`. The attributes allocated from it are
+ * also resized, reordered and copied on those worker threads after the scope ends. So the resource must be
+ * thread-safe, the resources of `create_memory_resource()` are, unless `"synchronized": false` is given.
+ *
+ * Attributes, attribute collections and geometry slots created in the scope allocate from the given resource,
+ * and keep using it after the scope ends. So the resource must outlive them.
+ *
+ * ```cpp
+ * auto arena = create_memory_resource({{"type", "monotonic"}});
+ * {
+ *     MemoryResourceGuard guard{arena.get()};
+ *     // build the scene ...
+ * }
+ * ```
+ */
+class UIPC_CORE_API MemoryResourceGuard
+{
+  public:
+    explicit MemoryResourceGuard(std::pmr::memory_resource* resource) noexcept;
+    ~MemoryResourceGuard();
+
+    MemoryResourceGuard(const MemoryResourceGuard&)            = delete;
+    MemoryResourceGuard& operator=(const MemoryResourceGuard&) = delete;
+
+  private:
+    std::pmr::memory_resource* m_previous = nullptr;
+};
+}  // namespace uipc
@@ -0,0 +1,18 @@
+#pragma once
+#include <uipc/common/exec.h>
+
+namespace uipc
+{
+/**
+ * @brief Call `f(i)` for all `i` in `[begin, end)` on multiple threads.
+ *
+ * The same as `exec::parallel_for()`: the range is split into chunks of `grain_size` indices that run on the
+ * current executor, small ranges run on the calling thread. `f` must be safe to call concurrently for different `i`.
+ * The first exception thrown by `f` is rethrown after all the chunks are done.
+ */
+template <typename F>
+void parallel_for(SizeT begin, SizeT end, F&& f, SizeT grain_size = 1024)
+{
+    exec::parallel_for(begin, end, std::forward<F>(f), grain_size);
+}
+}  // namespace uipc
@@ -9,7 +9,27 @@ template <typename T>
 struct PmrDeleter
 {
     using Allocator = uipc::Allocator<T>;
+
+    PmrDeleter(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : resource(resource)
+    {
+    }
+
+    template <typename U>
+    PmrDeleter(const PmrDeleter<U>& other) noexcept
+        : resource(other.resource)
+        , bytes(other.bytes)
+        , alignment(other.alignment)
+    {
+    }
+
     void operator()(T* ptr) const;
+
+    // the resource which allocated the object, the object is always deallocated from it,
+    // with the size and alignment of the allocated (most derived) type
+    std::pmr::memory_resource* resource;
+    std::size_t                bytes     = sizeof(T);
+    std::size_t                alignment = alignof(T);
 };
 
 template <typename T>
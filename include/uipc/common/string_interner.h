@@ -0,0 +1,35 @@
+#pragma once
+#include <string_view>
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+
+namespace uipc
+{
+/**
+ * @brief A global, thread-safe string pool.
+ *
+ * Interned strings live until the end of the program, so the returned view never dangles.
+ * Interning the same content twice returns the same view (same data pointer).
+ */
+class UIPC_CORE_API StringInterner
+{
+  public:
+    /**
+     * @brief Intern the string, return a view of the pooled copy.
+     */
+    static std::string_view intern(std::string_view str);
+
+    /**
+     * @brief Get the number of interned strings.
+     */
+    static SizeT size() noexcept;
+};
+
+/**
+ * @brief Shortcut of `StringInterner::intern()`.
+ */
+inline std::string_view intern(std::string_view str)
+{
+    return StringInterner::intern(str);
+}
+}  // namespace uipc
@@ -7,12 +7,17 @@
 #include <uipc/common/range.h>
 #include <uipc/common/enumerate.h>
 #include <uipc/common/uipc.h>
+#include <uipc/common/memory_resource.h>
+#include <uipc/common/string_interner.h>
 
 #include <uipc/core/engine.h>
 #include <uipc/core/world.h>
+#include <uipc/core/world_batch.h>
 #include <uipc/core/scene.h>
 #include <uipc/core/scene_snapshot.h>
+#include <uipc/core/scene_history.h>
 #include <uipc/core/scene_factory.h>
+#include <uipc/core/frame_statistics_feature.h>
 
 #include <uipc/geometry/simplicial_complex.h>
 #include <uipc/geometry/simplicial_complex_slot.h>
@@ -36,12 +36,12 @@ class ContactModelCollectionT
     }
 
     template <typename T>
-    auto find(std::string_view name)
+    auto find(const geometry::AttributeKey& key)
     {
-        return m_attributes.template find<T>(name);
+        return m_attributes.template find<T>(key);
     }
 
-    auto find(std::string_view name) { return m_attributes.find(name); }
+    auto find(const geometry::AttributeKey& key) { return m_attributes.find(key); }
 
     auto to_json() const { return m_attributes.to_json(); }
 
@@ -21,8 +21,10 @@ class UIPC_CORE_API ContactTabular final
 {
     friend class uipc::backend::ContactTabularVisitor;
     friend class SceneSnapshot;
+    friend class SceneHistory;
     friend class Scene;
     friend class internal::Scene;
+    friend class WorldBatch;
 
   public:
     ContactTabular() noexcept;
@@ -0,0 +1,105 @@
+#pragma once
+#include <uipc/core/feature.h>
+#include <uipc/common/json.h>
+#include <uipc/common/vector.h>
+#include <array>
+
+namespace uipc::core
+{
+/**
+ * @brief The solver statistics of a single frame.
+ *
+ * A fixed-size record, so that backends can fill it without any allocation or formatting.
+ */
+struct FrameStatisticsRecord
+{
+    enum Phase : int
+    {
+        CollisionDetection = 0,
+        Assembly,
+        LinearSolve,
+        LineSearch,
+        PhaseCount
+    };
+
+    SizeT  frame                    = 0;
+    IndexT newton_iterations        = 0;
+    IndexT line_search_iterations   = 0;
+    IndexT linear_solver_iterations = 0;  // e.g. PCG iterations, summed over the Newton iterations
+    Float  ccd_alpha                = 1.0;  // the step clamp from CCD filtering, the minimum over the frame
+    Float  cfl_alpha                = 1.0;  // the step clamp from CFL condition, the minimum over the frame
+    Float  line_search_alpha        = 1.0;  // the accepted step of the last line search
+    SizeT  contact_candidates       = 0;  // the candidate primitive pairs of the broad phase, the maximum over the frame
+    SizeT  active_contacts          = 0;  // the contacts with non-zero energy, the maximum over the frame
+    std::array<Float, PhaseCount> phase_times = {};  // wall time of each phase in seconds, including the device work
+
+    static std::string_view phase_name(Phase phase) noexcept;
+
+    Json to_json() const;
+};
+
+/**
+ * @brief Per-frame solver statistics, kept in a ring of the most recent frames.
+ *
+ * Backends push one record per frame, users read the records by index, from the oldest (0) to the latest (size() - 1).
+ *
+ * ```cpp
+ * auto stats = engine.features().find<FrameStatisticsFeature>();
+ * if(stats && stats->size())
+ *     fmt::println("newton iterations: {}", stats->latest().newton_iterations);
+ * ```
+ */
+class UIPC_CORE_API FrameStatisticsFeature final : public Feature
+{
+  public:
+    constexpr static std::string_view FeatureName = "core/frame_statistics";
+
+    FrameStatisticsFeature(SizeT capacity = 128);
+
+    /**
+     * @brief Push the record of a new frame, the oldest record is dropped if the ring is full.
+     *
+     * No allocation happens here.
+     */
+    void push(const FrameStatisticsRecord& record) noexcept;
+
+    /**
+     * @brief Remove all the records.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief The number of records in the ring.
+     */
+    SizeT size() const noexcept;
+
+    /**
+     * @brief The maximum number of records kept in the ring.
+     */
+    SizeT capacity() const noexcept;
+
+    /**
+     * @brief Get the i-th record, 0 is the oldest one.
+     */
+    const FrameStatisticsRecord& operator[](SizeT i) const noexcept;
+
+    /**
+     * @brief Get the record of the latest frame.
+     */
+    const FrameStatisticsRecord& latest() const noexcept;
+
+    /**
+     * @brief Copy the records out, from the oldest to the latest.
+     */
+    vector<FrameStatisticsRecord> records() const;
+
+    Json to_json() const;
+
+  private:
+    virtual std::string_view get_name() const final override;
+
+    vector<FrameStatisticsRecord> m_ring;
+    SizeT                         m_head = 0;  // the slot of the oldest record
+    SizeT                         m_size = 0;
+};
+}  // namespace uipc::core
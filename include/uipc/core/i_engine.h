@@ -18,6 +18,7 @@ class UIPC_CORE_API IEngine
     void sync();
     void retrieve();
     Json to_json() const;
+    Json memory_report() const;
 
     bool                     dump();
     bool                     recover(SizeT dst_frame);
@@ -32,6 +33,7 @@ class UIPC_CORE_API IEngine
     virtual void                     do_sync()                 = 0;
     virtual void                     do_retrieve()             = 0;
     virtual Json                     do_to_json() const;
+    virtual Json                     do_memory_report() const;
     virtual bool                     do_dump();
     virtual bool                     do_recover(SizeT dst_frame);
     virtual SizeT                    get_frame() const    = 0;
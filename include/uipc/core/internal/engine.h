@@ -27,6 +27,8 @@ class UIPC_CORE_API Engine final
 
     Json to_json() const;
 
+    Json memory_report() const;
+
     static Json default_config();
 
   private:
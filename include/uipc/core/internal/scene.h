@@ -34,6 +34,8 @@ class UIPC_CORE_API Scene : public std::enable_shared_from_this<Scene>
 
     void update_from(const SceneSnapshotCommit& commit);
 
+    Json memory_report() const;
+
     auto& config() const noexcept { return m_config; }
     auto& config() noexcept { return m_config; }
     Float dt() const noexcept { return m_config["dt"].get<Float>(); }
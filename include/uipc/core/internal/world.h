@@ -13,6 +13,10 @@ class UIPC_CORE_API World final : public std::enable_shared_from_this<World>
   public:
     World(internal::Engine& e) noexcept;
     void init(internal::Scene& s);
+    /**
+     * @brief Initialize the world with a known sanity check result (e.g. of an identical scene), skipping the check.
+     */
+    void init(internal::Scene& s, SanityCheckResult known_result);
 
     void advance();
     void sync();
@@ -26,10 +30,13 @@ class UIPC_CORE_API World final : public std::enable_shared_from_this<World>
 
     const FeatureCollection& features() const;
 
+    Json memory_report() const;
+
   private:
     internal::Scene*  m_scene  = nullptr;
     internal::Engine* m_engine = nullptr;
     bool              m_valid  = true;
     void              sanity_check(Scene& s);
+    void              do_init(internal::Scene& s);
 };
 }  // namespace uipc::core::internal
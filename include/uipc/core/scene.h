@@ -32,11 +32,13 @@ class UIPC_CORE_API Scene final
 {
     friend class backend::SceneVisitor;
     friend class World;
+    friend class WorldBatch;
     friend class Object;
     friend class sanity_check::SanityChecker;
     friend class Animation;
     friend class SceneFactory;
     friend class SceneSnapshot;
+    friend class SceneHistory;
     friend struct fmt::formatter<Scene>;
 
   public:
@@ -88,6 +90,15 @@ class UIPC_CORE_API Scene final
       public:
         ObjectGeometrySlots<geometry::Geometry> find(IndexT id) && noexcept;
 
+        /**
+         * @brief Share the attributes with the same content among all the geometries and rest geometries.
+         *
+         * Useful when the same mesh is loaded many times. See `geometry::AttributeDeduplicator`.
+         *
+         * @return The number of attribute slots sharing another attribute now.
+         */
+        SizeT deduplicate_attributes() &&;
+
       private:
         Geometries(internal::Scene& scene) noexcept;
         internal::Scene& m_scene;
@@ -132,6 +143,14 @@ class UIPC_CORE_API Scene final
 
     void update_from(const SceneSnapshotCommit& snapshot);
 
+    /**
+     * @brief Report the memory held by the geometries and rest geometries of the scene.
+     *
+     * The report is broken down by geometry, attribute collection and attribute (in bytes).
+     * `unique_bytes` counts the attributes shared by more than one geometry only once.
+     */
+    Json memory_report() const;
+
   private:
     // Allow create a core::Scene from a core::internal::Scene
     Scene(S<internal::Scene> scene) noexcept;
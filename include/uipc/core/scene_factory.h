@@ -2,6 +2,7 @@
 #include <uipc/core/scene.h>
 #include <uipc/core/scene_snapshot.h>
 #include <uipc/geometry/attribute_collection_factory.h>
+#include <uipc/common/json_stream.h>
 
 namespace uipc::core
 {
@@ -11,16 +12,71 @@ class UIPC_CORE_API SceneFactory
 
 
   public:
-    SceneFactory();
+    /**
+     * @param config See `default_config()`.
+     */
+    SceneFactory(const Json& config = default_config());
     ~SceneFactory();
 
+    /**
+     * @brief The default config of the SceneFactory.
+     *
+     * - `deduplicate_attributes`: store the attributes with the same content once, see `GeometryAtlas::deduplicate()`.
+     */
+    static Json default_config();
+
     [[nodiscard]] Scene         from_snapshot(const SceneSnapshot& snapshot);
     [[nodiscard]] SceneSnapshot from_json(const Json& j);
     [[nodiscard]] Json          to_json(const SceneSnapshot& scene);
     [[nodiscard]] SceneSnapshotCommit commit_from_json(const Json& json);
     [[nodiscard]] Json commit_to_json(const SceneSnapshotCommit& scene);
 
+    /**
+     * @brief Write the json of the snapshot to a stream, the same document as `to_json()`.
+     *
+     * The whole Json is never built, the attribute values are encoded in parallel straight from the attributes.
+     *
+     * @param indent The indentation of JSON text, -1 for the compact form.
+     */
+    void to_stream(const SceneSnapshot& scene, std::ostream& os, JsonFormat format, int indent = -1);
+
+    /**
+     * @brief Read a snapshot from a stream, the document is the same as `from_json()` accepts.
+     *
+     * The attribute values are decoded into the attributes directly.
+     */
+    [[nodiscard]] SceneSnapshot from_stream(std::istream& is, JsonFormat format);
+
+    /**
+     * @brief Read a snapshot from a file lazily, the geometries are decoded on first access.
+     *
+     * Only the document without the attribute values is read up front (config, objects, contact models
+     * and the layout of the geometries). The attribute values stay in the file, which is kept open until
+     * the snapshot and the scenes built from it release their undecoded geometries.
+     *
+     * Writing the snapshot, or a scene built from it, copies the bytes of the undecoded geometries
+     * from the file without decoding them.
+     */
+    [[nodiscard]] SceneSnapshot lazy_from_file(std::string_view filename, JsonFormat format);
+
+    /**
+     * @brief Read the undecoded attributes of the lazy snapshots on the file into memory and close the file.
+     *
+     * Replacing an open file fails on Windows, call this before overwriting a file that may be lazily loaded.
+     * The snapshots and the scenes built from them keep working on the bytes in memory.
+     */
+    static void release_lazy_file(std::string_view filename);
+
   private:
     U<Impl> m_impl;
 };
+
+/**
+ * @brief Thrown when a scene can't be read or written, e.g. a lazily loaded geometry fails to decode.
+ */
+class UIPC_CORE_API SceneIOError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
 }  // namespace uipc::core
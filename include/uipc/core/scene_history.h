@@ -0,0 +1,113 @@
+#pragma once
+#include <uipc/core/scene_snapshot.h>
+#include <uipc/common/exception.h>
+#include <optional>
+
+namespace uipc::core
+{
+/**
+ * @brief A versioned history of a scene, for undo and time-travel.
+ *
+ * Each `commit()` records the current scene as a new version. The versions share the unchanged geometries
+ * in a persistent geometry map, so a commit only copies the geometries modified since the last version
+ * (the attribute values themselves are shared copy-on-write, see `AttributeCollection`).
+ *
+ * Every attribute remembers the version it was last modified in, which makes the diff between any two
+ * retained versions only touch the changed attributes, in both directions of time.
+ *
+ * ```cpp
+ * SceneHistory history{scene};
+ * auto v0 = history.commit();
+ * // ... edit the scene
+ * auto v1 = history.commit();
+ * // undo
+ * scene.update_from(history.diff(v0, v1));
+ * ```
+ */
+class UIPC_CORE_API SceneHistory
+{
+    class Impl;
+
+  public:
+    /**
+     * @brief The default config.
+     *
+     * - `max_versions`: the number of retained versions, the oldest ones are dropped once exceeded, 0 for unbounded
+     */
+    static Json default_config();
+
+    SceneHistory(const Scene& scene, const Json& config = default_config());
+    ~SceneHistory();
+
+    SceneHistory(const SceneHistory&)            = delete;
+    SceneHistory& operator=(const SceneHistory&) = delete;
+
+    /**
+     * @brief Record the current scene as a new version.
+     *
+     * Like `SceneSnapshot`, it should be called when the scene has no pending geometries.
+     *
+     * @return The new version
+     */
+    U64 commit();
+
+    /**
+     * @brief The latest version, throw if there is no version yet.
+     */
+    U64 latest() const;
+
+    /**
+     * @brief The oldest retained version, throw if there is no version yet.
+     */
+    U64 oldest() const;
+
+    /**
+     * @brief The number of retained versions.
+     */
+    SizeT size() const noexcept;
+
+    bool contains(U64 version) const noexcept;
+
+    /**
+     * @brief The scene snapshot of the given version.
+     */
+    SceneSnapshot snapshot(U64 version) const;
+
+    /**
+     * @brief The commit from version `src` to version `dst`, `dst` may be older than `src`.
+     *
+     * Only the geometries and the attributes changed between the two versions are in the commit.
+     * The geometries in `src` but absent in `dst`, e.g. when undoing to a version before their creation,
+     * are reported by `SceneSnapshotCommit::removed_geometries()` and destroyed by `Scene::update_from()`.
+     */
+    SceneSnapshotCommit diff(U64 dst, U64 src) const;
+
+    /**
+     * @brief The version the geometry was last modified in, as seen from `version`.
+     *
+     * @return `std::nullopt` if the geometry doesn't exist in `version`
+     */
+    std::optional<U64> geometry_version(U64 version, IndexT geometry_id) const;
+
+    /**
+     * @brief The version the attribute was last modified in, as seen from `version`.
+     *
+     * @param collection The name of the attribute collection, e.g. "vertices"
+     * @param attribute The name of the attribute, e.g. "position"
+     * @return `std::nullopt` if the attribute doesn't exist in `version`
+     */
+    std::optional<U64> attribute_version(U64              version,
+                                         IndexT           geometry_id,
+                                         std::string_view collection,
+                                         std::string_view attribute) const;
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_CORE_API SceneHistoryError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::core
@@ -1,6 +1,7 @@
 #pragma once
 #include <uipc/core/scene.h>
 #include <uipc/geometry/geometry_commit.h>
+#include <uipc/geometry/geometry_source.h>
 #include <uipc/core/object_collection.h>
 
 namespace uipc::core
@@ -14,6 +15,7 @@ class UIPC_CORE_API SceneSnapshot
     friend class Scene;
     friend class SceneSnapshotCommit;
     friend class SceneFactory;
+    friend class SceneHistory;
 
   public:
     SceneSnapshot(const Scene& scene);
@@ -32,6 +34,10 @@ class UIPC_CORE_API SceneSnapshot
     unordered_map<IndexT, S<geometry::Geometry>> m_geometries;
     unordered_map<IndexT, S<geometry::Geometry>> m_rest_geometries;
 
+    // the geometries of the lazily loaded slots, decoded only if needed
+    unordered_map<IndexT, S<const geometry::IGeometrySource>> m_geometry_sources;
+    unordered_map<IndexT, S<const geometry::IGeometrySource>> m_rest_geometry_sources;
+
     S<geometry::AttributeCollection> m_contact_models;
 };
 
@@ -44,6 +50,7 @@ class UIPC_CORE_API SceneSnapshotCommit
     friend SceneSnapshotCommit UIPC_CORE_API operator-(const SceneSnapshot& dst,
                                                        const SceneSnapshot& src);
     friend class internal::Scene;
+    friend class SceneHistory;
 
   public:
     SceneSnapshotCommit() = default;
@@ -76,6 +83,19 @@ class UIPC_CORE_API SceneSnapshotCommit
         return *m_contact_models;
     }
 
+    /**
+     * @brief The ids of the geometries to be destroyed, only reported by `SceneHistory::diff()`.
+     */
+    const vector<IndexT>& removed_geometries() const noexcept
+    {
+        return m_removed_geometries;
+    }
+
+    const vector<IndexT>& removed_rest_geometries() const noexcept
+    {
+        return m_removed_rest_geometries;
+    }
+
   private:
     bool m_is_valid = true;
     // Fully Copy:
@@ -86,6 +106,8 @@ class UIPC_CORE_API SceneSnapshotCommit
     // Full Copy Geometries/ Diff Copy AttributeCollection
     unordered_map<IndexT, S<geometry::GeometryCommit>> m_geometries;
     unordered_map<IndexT, S<geometry::GeometryCommit>> m_rest_geometries;
+    vector<IndexT>                                     m_removed_geometries;
+    vector<IndexT>                                     m_removed_rest_geometries;
 
     // Diff Copy AttributeCollection
     S<geometry::AttributeCollectionCommit> m_contact_models;
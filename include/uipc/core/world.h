@@ -20,6 +20,7 @@ class UIPC_CORE_API World final
 {
     friend class backend::WorldVisitor;
     friend class SanityChecker;
+    friend class WorldBatch;
 
   public:
     World(Engine& e) noexcept;
@@ -44,6 +45,13 @@ class UIPC_CORE_API World final
 
     const FeatureCollection& features() const;
 
+    /**
+     * @brief Report the memory held by the scene and the backend systems.
+     *
+     * @sa Scene::memory_report()
+     */
+    Json memory_report() const;
+
   private:
     // Allow create a core::World from a core::internal::World
     World(S<internal::World> w) noexcept;
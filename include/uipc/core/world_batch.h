@@ -0,0 +1,88 @@
+#pragma once
+#include <uipc/core/engine.h>
+#include <uipc/core/world.h>
+#include <uipc/geometry/attribute_key.h>
+
+namespace uipc::core
+{
+/**
+ * @brief A batch of independent worlds stepped together, for parameter sweeps and rollouts.
+ *
+ * Each scene gets its own engine (working in `{workspace}/{i}`) and world, the backend module is loaded only once.
+ * Scenes with identical content in one `init()` share one sanity check. `advance()`, `sync()` and `retrieve()` run the worlds
+ * in parallel, and `gather()` copies a vertex attribute of all the scenes into one contiguous array.
+ *
+ * ```cpp
+ * WorldBatch batch{"cuda", "./sweep"};
+ * batch.init(scene_ptrs);
+ * vector<Vector3> Xs;
+ * while(batch.frame() < 100)
+ * {
+ *     batch.advance();
+ *     batch.retrieve();
+ *     auto offsets = batch.gather<Vector3>(builtin::position, Xs);
+ * }
+ * ```
+ */
+class UIPC_CORE_API WorldBatch final
+{
+    class Impl;
+
+  public:
+    WorldBatch(std::string_view backend_name,
+               std::string_view workspace = "./",
+               const Json&      config    = Engine::default_config());
+    ~WorldBatch();
+
+    WorldBatch(const WorldBatch&)            = delete;
+    WorldBatch& operator=(const WorldBatch&) = delete;
+
+    /**
+     * @brief Create one engine and one world for each scene, then initialize the worlds in parallel.
+     *
+     * The scenes must outlive the batch. Calling `init()` again appends more worlds to the batch.
+     */
+    void init(span<Scene* const> scenes);
+
+    void advance();
+    void sync();
+    void retrieve();
+
+    /**
+     * @brief The number of worlds in the batch.
+     */
+    SizeT size() const noexcept;
+
+    World&  world(SizeT i);
+    Engine& engine(SizeT i);
+
+    /**
+     * @brief The minimum frame of the valid worlds, 0 if there is no valid world.
+     */
+    SizeT frame() const;
+
+    /**
+     * @brief The frame of each world.
+     */
+    vector<SizeT> frames() const;
+
+    /**
+     * @brief Whether each world is valid.
+     */
+    vector<bool> valid() const;
+
+    /**
+     * @brief Copy a vertex attribute of all the simplicial complexes of all the scenes into `out`.
+     *
+     * In each scene, the geometries are visited in the order of their ids. The simplicial complexes
+     * without the attribute are skipped.
+     *
+     * @return The offsets of the scenes in `out`, the values of the i-th scene are in `[offsets[i], offsets[i+1])`.
+     */
+    template <typename T>
+    vector<SizeT> gather(const geometry::AttributeKey& name, vector<T>& out) const;
+
+  private:
+    U<Impl> m_impl;
+};
+}  // namespace uipc::core
@@ -0,0 +1,169 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/exception.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/vector.h>
+#include <uipc/diff_sim/sparse_coo_view.h>
+#include <uipc/diff_sim/adjoint_method_feature.h>
+#include <functional>
+
+namespace uipc::diff_sim
+{
+/**
+ * @brief The source of the per-frame linear systems of a simulation.
+ *
+ * After `do_advance()`, `get_H()`, `get_pGpX()` and `get_pGpP()` are the systems of the new frame `i`:
+ * `H` is the (dof, dof) Hessian of the frame residual `G_i` with respect to `x_i`, `pGpX(k)` is its
+ * derivative with respect to the dofs `x_{i-k}` of a previous frame (e.g. through the inertia term), and
+ * `pGpP` is its (dof, parm) derivative with respect to the parameters.
+ *
+ * The cuda backend implements it over its engine and installs a `HostAdjointMethod` on it as the
+ * `AdjointMethodFeature`, users may implement it over their own simulation as well.
+ */
+class UIPC_CORE_API FrameSystemProvider
+{
+  public:
+    virtual ~FrameSystemProvider() = default;
+
+    virtual void  do_advance()                   = 0;
+    virtual SizeT get_frame() const              = 0;
+    /**
+     * @brief Store the current frame so that it can be recovered later, e.g. `World::dump()`.
+     */
+    virtual bool do_checkpoint() = 0;
+    /**
+     * @brief Go back to a checkpointed frame, e.g. `World::recover()`.
+     */
+    virtual bool              do_recover(SizeT frame) = 0;
+    virtual span<const Float> get_dofs() const        = 0;
+    virtual SizeT             get_parm_count() const  = 0;
+    virtual SparseCOOView     get_H() const           = 0;
+    virtual SparseCOOView     get_pGpP() const        = 0;
+    /**
+     * @brief The number of previous frames the frame residual depends on, 0 if the frames are independent.
+     */
+    virtual SizeT get_coupling_depth() const { return 0; }
+    /**
+     * @brief The (dof, dof of frame `i-k`) derivative of the frame residual with respect to `x_{i-k}`, `1 <= k <= depth`.
+     */
+    virtual SparseCOOView get_pGpX(SizeT k) const { return {}; }
+};
+
+/**
+ * @brief A revolve-style checkpointing schedule for reversing a sequence of frames with bounded memory.
+ *
+ * Frames are relative to the initial frame 0, which is always checkpointed. Every `Backward` action
+ * directly follows the `Advance` to the same frame, so only the system of the latest frame has to be kept.
+ */
+class UIPC_CORE_API CheckpointSchedule
+{
+  public:
+    enum class ActionType
+    {
+        Advance,     // advance from `frame - 1` to `frame`
+        Checkpoint,  // store `frame`
+        Recover,     // go back to `frame`
+        Backward     // the adjoint step of `frame`
+    };
+
+    struct Action
+    {
+        ActionType type;
+        SizeT      frame;
+    };
+
+    /**
+     * @brief Build the schedule to reverse frames `[1, steps]` with at most `checkpoint_count` checkpoints besides frame 0.
+     */
+    static vector<Action> revolve(SizeT steps, SizeT checkpoint_count);
+};
+
+/**
+ * @brief A host-side adjoint solver over a horizon of frames.
+ *
+ * Each frame is an implicit solve `G_i(x_i, x_{i-1}, ..., p) = 0`, so the gradient of a loss `L(x_1, ..., x_n)` is
+ * `dL/dp = -sum_i pGpP_i^T lambda_i`, with the adjoints solved from the last frame to the first:
+ * `H_i lambda_i = dL/dx_i - sum_k pGpX_{i+k}(k)^T lambda_{i+k}`. The adjoint is carried to the previous frames as
+ * soon as it is solved, so only `depth` vectors are kept besides the checkpoints chosen by
+ * `CheckpointSchedule::revolve`, the frames between them are recomputed.
+ * The sparse factorization is reused: the symbolic analysis is redone only if the sparsity pattern of H changes.
+ */
+class UIPC_CORE_API AdjointSolver
+{
+    class Impl;
+
+  public:
+    struct Statistics
+    {
+        SizeT advances       = 0;
+        SizeT recovers       = 0;
+        SizeT checkpoints    = 0;
+        SizeT analyses       = 0;  // symbolic analyses of H
+        SizeT factorizations = 0;  // numeric factorizations of H
+    };
+
+    /**
+     * @brief Fill `dLdx` (sized by the dof count) with the loss gradient of `frame`, the provider is at `frame`.
+     *
+     * Leave `dLdx` zero if the loss doesn't depend on the frame, the linear solve is skipped then.
+     */
+    using LossGradient = std::function<void(SizeT frame, Eigen::Ref<VectorX> dLdx)>;
+
+    AdjointSolver(FrameSystemProvider& provider, SizeT checkpoint_count);
+    ~AdjointSolver();
+
+    /**
+     * @brief Compute dL/dp for the frames `(begin, end]`, zero if the range is empty.
+     *
+     * The dofs of `begin` and the frames before it are constants of the parameters.
+     * The provider must be able to recover `begin`. After the call, the provider is at some frame in `(begin, end]`.
+     */
+    VectorX solve(SizeT begin, SizeT end, const LossGradient& dLdx);
+
+    const Statistics& statistics() const noexcept;
+
+  private:
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief An AdjointMethodFeatureOverrider backed by AdjointSolver.
+ *
+ * The selected dofs are recorded while the user advances the world. `compute_dLdP()` then runs the
+ * checkpointed adjoint from the frame of the provider at construction (or the frame before the first selected one,
+ * if it is earlier), which must be recoverable. Without any selected dofs, dL/dp is zero.
+ *
+ * @note All the BufferViews are host memory.
+ */
+class UIPC_CORE_API HostAdjointMethod final : public AdjointMethodFeatureOverrider
+{
+  public:
+    HostAdjointMethod(FrameSystemProvider& provider, SizeT checkpoint_count);
+
+    virtual void do_select_dofs(SizeT frame, backend::BufferView in_SDI) override;
+    virtual void do_receive_dofs(backend::BufferView out_dofs) override;
+    virtual void do_compute_dLdP(backend::BufferView out_dLdP,
+                                 backend::BufferView in_dLdx) override;
+
+    const AdjointSolver& solver() const noexcept;
+
+  private:
+    struct Selection
+    {
+        SizeT          frame;
+        vector<IndexT> indices;
+        vector<Float>  values;
+    };
+
+    FrameSystemProvider& m_provider;
+    AdjointSolver        m_solver;
+    SizeT                m_begin = 0;  // the frame the forward pass starts from
+    vector<Selection>    m_selections;
+};
+
+class UIPC_CORE_API AdjointSolverError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::diff_sim
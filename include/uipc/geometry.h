@@ -5,3 +5,4 @@
 #include <uipc/geometry/geometry_atlas.h>
 #include <uipc/geometry/utils.h>
 #include <uipc/geometry/geometry_commit.h>
+#include <uipc/geometry/topology_change.h>
@@ -39,6 +39,26 @@ class UIPC_CORE_API IAttribute
      */
     [[nodiscard]] std::string_view type_name() const noexcept;
 
+    /**
+     * @brief Get the bytes of memory held by the attribute values, including the reserved capacity.
+     */
+    [[nodiscard]] SizeT memory_usage() const noexcept;
+
+    /**
+     * @brief Get the memory resource the attribute values are allocated from.
+     */
+    [[nodiscard]] std::pmr::memory_resource* memory_resource() const noexcept;
+
+    /**
+     * @brief Get the hash of the type, the default value and the values of the attribute.
+     */
+    [[nodiscard]] U64 content_hash() const noexcept;
+
+    /**
+     * @brief Check if the other attribute has the same type, default value and values, byte by byte.
+     */
+    [[nodiscard]] bool content_equal(const IAttribute& other) const noexcept;
+
   private:
     friend class AttributeCollection;
     friend class IAttributeSlot;
@@ -52,8 +72,12 @@ class UIPC_CORE_API IAttribute
     void copy_from(const IAttribute& other, const AttributeCopy& copy) noexcept;
 
   protected:
-    virtual SizeT            get_size() const               = 0;
-    virtual std::string_view get_type_name() const noexcept = 0;
+    virtual SizeT                      get_size() const                     = 0;
+    virtual std::string_view           get_type_name() const noexcept       = 0;
+    virtual SizeT                      get_memory_usage() const noexcept    = 0;
+    virtual std::pmr::memory_resource* get_memory_resource() const noexcept = 0;
+    virtual U64                        get_content_hash() const noexcept    = 0;
+    virtual bool get_content_equal(const IAttribute& other) const noexcept  = 0;
 
     virtual void          do_resize(SizeT N)                       = 0;
     virtual void          do_clear()                               = 0;
@@ -86,6 +110,11 @@ class Attribute : public IAttribute
 
     Attribute(const T& default_value = {}) noexcept;
 
+    /**
+     * @brief Construct an attribute taking the ownership of the given values, no copy is made.
+     */
+    Attribute(vector<T>&& values, const T& default_value = {}) noexcept;
+
     Attribute(const Attribute<T>&)               = default;
     Attribute(Attribute<T>&&)                    = default;
     Attribute<T>& operator=(const Attribute<T>&) = default;
@@ -95,11 +124,17 @@ class Attribute : public IAttribute
 
     [[nodiscard]] span<const T> view() const noexcept;
 
+    [[nodiscard]] const T& default_value() const noexcept;
+
     [[nodiscard]] static std::string type() noexcept;
 
   protected:
-    virtual SizeT            get_size() const override;
-    virtual std::string_view get_type_name() const noexcept override;
+    virtual SizeT                      get_size() const override;
+    virtual std::string_view           get_type_name() const noexcept override;
+    virtual SizeT                      get_memory_usage() const noexcept override;
+    virtual std::pmr::memory_resource* get_memory_resource() const noexcept override;
+    virtual U64                        get_content_hash() const noexcept override;
+    virtual bool get_content_equal(const IAttribute& other) const noexcept override;
 
     virtual void          do_resize(SizeT N) override;
     virtual void          do_clear() override;
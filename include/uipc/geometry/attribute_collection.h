@@ -1,12 +1,14 @@
 #pragma once
 #include <uipc/common/string.h>
 #include <uipc/common/unordered_map.h>
+#include <uipc/common/vector.h>
 #include <uipc/common/exception.h>
 #include <uipc/common/smart_pointer.h>
 #include <uipc/geometry/attribute.h>
 #include <uipc/geometry/attribute_slot.h>
 #include <uipc/geometry/attribute_copy.h>
 #include <uipc/geometry/attribute_friend.h>
+#include <uipc/geometry/attribute_key.h>
 
 namespace uipc::geometry
 {
@@ -26,7 +28,7 @@ class UIPC_CORE_API AttributeCollection
     friend class AttributeCollectionCommit;
 
   public:
-    AttributeCollection() = default;
+    AttributeCollection();
 
     AttributeCollection(const AttributeCollection&);
     AttributeCollection& operator=(const AttributeCollection&);
@@ -46,6 +48,40 @@ class UIPC_CORE_API AttributeCollection
                                const T&         default_value = {},
                                bool             allow_destroy = true);
 
+    /**
+     * @brief Create a new attribute slot of type T, taking the ownership of the given values.
+     * 
+     * No value is copied, the buffer of `values` becomes the storage of the attribute.
+     * 
+     * @param name The name of the attribute slot.
+     * @param values The values of the attribute, `values.size()` must be equal to `size()`.
+     * @return The created attribute slot.
+     *
+     * @throw AttributeCollectionError if the attribute already exists or the size mismatches.
+     */
+    template <typename T>
+    S<AttributeSlot<T>> adopt(std::string_view name,
+                              vector<T>&&      values,
+                              const T&         default_value = {},
+                              bool             allow_destroy = true);
+
+    /**
+     * @brief Create a new attribute slot of type T, initialized with the given values in a single copy.
+     * 
+     * Unlike `create()` followed by a copy, the values are not default filled before being overwritten.
+     * 
+     * @param name The name of the attribute slot.
+     * @param values The values of the attribute, `values.size()` must be equal to `size()`.
+     * @return The created attribute slot.
+     *
+     * @throw AttributeCollectionError if the attribute already exists or the size mismatches.
+     */
+    template <typename T>
+    S<AttributeSlot<T>> create_from(std::string_view name,
+                                    span<const T>    values,
+                                    const T&         default_value = {},
+                                    bool             allow_destroy = true);
+
     /**
      * @brief Share the underlying attribute of the given slot with a new name.
      * 
@@ -75,34 +111,36 @@ class UIPC_CORE_API AttributeCollection
      * 
      * @danger Accessing the removed attribute slot will cause undefined behavior. 
      * It's user's responsibility to ensure that the removed attribute slot is not accessed.
-     * @param name 
+     * @param key 
      */
-    void destroy(std::string_view name);
+    void destroy(const AttributeKey& key);
 
     /**
      * @brief Find the attribute slot with the given name.
      * 
-     * @param name The name of the attribute slot.
+     * Passing a prebuilt AttributeKey (e.g. `builtin::position`) skips hashing the name.
+     * 
+     * @param key The name of the attribute slot.
      * @return The attribute slot with the given name.
      * @return nullptr if the attribute slot with the given name does not exist.
      */
-    [[nodiscard]] S<IAttributeSlot> find(std::string_view name);
+    [[nodiscard]] S<IAttributeSlot> find(const AttributeKey& key);
     /**
      * @brief const version of find.
      */
-    [[nodiscard]] S<const IAttributeSlot> find(std::string_view name) const;
+    [[nodiscard]] S<const IAttributeSlot> find(const AttributeKey& key) const;
 
     /**
      * @brief Template version of find.
      */
     template <typename T>
-    [[nodiscard]] S<AttributeSlot<T>> find(std::string_view name);
+    [[nodiscard]] S<AttributeSlot<T>> find(const AttributeKey& key);
 
     /**
      * @brief  Template const version of find.
      */
     template <typename T>
-    [[nodiscard]] S<const AttributeSlot<T>> find(std::string_view name) const;
+    [[nodiscard]] S<const AttributeSlot<T>> find(const AttributeKey& key) const;
 
     /**
      * @brief Resize all attribute slots to the given size.
@@ -132,6 +170,38 @@ class UIPC_CORE_API AttributeCollection
                    span<const string>         include_names = {},
                    span<const string>         exclude_names = {});
 
+    /**
+     * @brief Concatenate the attribute slots of the given collections into this one.
+     * 
+     * The collection is resized to the total size of the sources, the values of `sources[i]` are copied to
+     * `[offset_i, offset_i + sources[i]->size())` where `offset_i` is the total size of the sources before it.
+     * The source slots are grouped by name only once, and the copies are done in parallel.
+     * If a source doesn't have an attribute, its rows keep the default value of the attribute.
+     * 
+     * @param sources The attribute collections to be concatenated.
+     * @param exclude_names The names of the attribute slots not to be copied.
+     * 
+     * @throw AttributeCollectionError if the slots with the same name have different types.
+     */
+    void concat_from(span<const AttributeCollection* const> sources,
+                     span<const string>                     exclude_names = {});
+
+    /**
+     * @brief Concatenate the selected rows of the given collections into this one.
+     * 
+     * The same as `concat_from(sources, exclude_names)`, but `sources[i]` only contributes
+     * `mappings[i].size()` rows, the `j`-th of which is the row `mappings[i][j]` of `sources[i]`.
+     * 
+     * @param sources The attribute collections to be concatenated.
+     * @param mappings The selected rows of each source, the same size as `sources`.
+     * @param exclude_names The names of the attribute slots not to be copied.
+     * 
+     * @throw AttributeCollectionError if the slots with the same name have different types.
+     */
+    void concat_from(span<const AttributeCollection* const> sources,
+                     span<const span<const SizeT>>          mappings,
+                     span<const string>                     exclude_names = {});
+
     /**
      * @brief Get the size of the attribute slots.
      */
@@ -159,6 +229,15 @@ class UIPC_CORE_API AttributeCollection
     */
     [[nodiscard]] SizeT attribute_count() const;
 
+    /**
+     * @brief Get the modification stamp of the attribute collection.
+     *
+     * The stamp is process-wide unique and changes whenever the collection is resized, or an attribute is created,
+     * destroyed, shared or written (through `view()`), so an unchanged stamp means an unchanged collection.
+     * A write only flags the collection, the new stamp is taken here.
+     */
+    [[nodiscard]] U64 modification_stamp() const noexcept;
+
     /**
     * @brief Get the json representation of the attribute collection.
     */
@@ -173,8 +252,58 @@ class UIPC_CORE_API AttributeCollection
     void update_from(const AttributeCollectionCommit& commit);
 
   private:
-    SizeT                                    m_size = 0;
-    unordered_map<string, S<IAttributeSlot>> m_attributes;
+    // throw if the attribute already exists or `value_count` mismatches the collection size
+    void check_new_attribute(std::string_view name, SizeT value_count) const;
+
+    // let the slot report its modifications to this collection
+    void attach(IAttributeSlot& slot);
+    // mark the collection modified, the stamp is updated on the next `modification_stamp()`
+    void touch();
+
+    /**
+     * @brief A flat map from interned attribute names to attribute slots, in insertion order.
+     *
+     * An attribute collection only holds a handful of attributes, so a linear scan over
+     * the packed hashes beats hashing a temporary string into a node-based map.
+     */
+    class SlotMap
+    {
+      public:
+        using value_type     = std::pair<AttributeKey, S<IAttributeSlot>>;
+        using iterator       = typename vector<value_type>::iterator;
+        using const_iterator = typename vector<value_type>::const_iterator;
+
+        iterator       begin() noexcept { return m_entries.begin(); }
+        iterator       end() noexcept { return m_entries.end(); }
+        const_iterator begin() const noexcept { return m_entries.begin(); }
+        const_iterator end() const noexcept { return m_entries.end(); }
+
+        iterator find(const AttributeKey& key) noexcept;
+        const_iterator find(const AttributeKey& key) const noexcept;
+
+        /**
+         * @brief Get the slot with the given name, insert an empty one if it doesn't exist.
+         */
+        S<IAttributeSlot>& operator[](const AttributeKey& key);
+
+        void erase(const_iterator it);
+        void erase(const AttributeKey& key);
+
+        SizeT size() const noexcept { return m_entries.size(); }
+        bool  empty() const noexcept { return m_entries.empty(); }
+        void  clear() noexcept;
+
+      private:
+        SizeT index_of(const AttributeKey& key) const noexcept;
+
+        vector<U64>        m_hashes;
+        vector<value_type> m_entries;
+    };
+
+    SizeT               m_size = 0;
+    SlotMap             m_attributes;
+    S<std::atomic<bool>> m_dirty;  // shared with the slots, null after being moved from
+    mutable U64          m_stamp = 0;
 };
 
 class UIPC_CORE_API AttributeCollectionError : public Exception
@@ -1,6 +1,11 @@
 #pragma once
 #include <uipc/geometry/attribute_collection.h>
 
+namespace uipc::core
+{
+class SceneHistory;
+}
+
 namespace uipc::geometry
 {
 class UIPC_CORE_API AttributeCollectionCommit
@@ -10,6 +15,7 @@ class UIPC_CORE_API AttributeCollectionCommit
     friend class AttributeCollection;
     friend class AttributeCollectionFactory;
     friend class GeometryFactory;
+    friend class core::SceneHistory;
     friend UIPC_CORE_API AttributeCollectionCommit operator-(const AttributeCollection& dst,
                                                              const AttributeCollection& src);
     friend UIPC_CORE_API AttributeCollection& operator+=(AttributeCollection& dst,
@@ -36,6 +36,10 @@ class UIPC_CORE_API AttributeCopy
      * @brief Dst[i] = Src[Mapping[i]] 
      */
     static AttributeCopy pull(span<const SizeT> mapping) noexcept;
+    /**
+     * @brief Dst[dst_offset + i] = Src[Mapping[i]]
+     */
+    static AttributeCopy pull(span<const SizeT> mapping, SizeT dst_offset) noexcept;
     /**
      * @brief Dst[Mapping[i]] = Src[i]
      */
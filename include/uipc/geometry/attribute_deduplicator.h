@@ -0,0 +1,50 @@
+#pragma once
+#include <uipc/geometry/geometry.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief Merge the attributes with the same content into shared attributes.
+ *
+ * Attributes are compared by type, default value and values (see `IAttribute::content_equal()`).
+ * The first attribute seen with some content is kept, the later attribute slots with the same content
+ * share it (copy-on-write), so writing to any of them later makes a private copy again.
+ * The names, evolving flags and modification times of the slots are kept.
+ *
+ * ```cpp
+ * AttributeDeduplicator dedup;
+ * for(auto& mesh : meshes)
+ *     dedup.deduplicate(mesh);
+ * ```
+ */
+class UIPC_CORE_API AttributeDeduplicator
+{
+    class Impl;
+
+  public:
+    AttributeDeduplicator();
+    ~AttributeDeduplicator();
+
+    /**
+     * @brief Share the attributes of `ac` with the attributes seen before.
+     *
+     * @return The number of attribute slots sharing a seen attribute now.
+     */
+    SizeT deduplicate(AttributeCollection& ac);
+
+    /**
+     * @brief Share the attributes of all the attribute collections of `geometry` with the attributes seen before.
+     *
+     * @return The number of attribute slots sharing a seen attribute now.
+     */
+    SizeT deduplicate(Geometry& geometry);
+
+    /**
+     * @brief Get the bytes of attribute values released by the merges so far.
+     */
+    [[nodiscard]] SizeT released_bytes() const noexcept;
+
+  private:
+    U<Impl> m_impl;
+};
+}  // namespace uipc::geometry
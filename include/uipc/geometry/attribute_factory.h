@@ -1,5 +1,7 @@
 #pragma once
 #include <uipc/geometry/attribute_slot.h>
+#include <uipc/common/json_stream.h>
+#include <functional>
 
 namespace uipc::geometry
 {
@@ -14,6 +16,18 @@ class UIPC_CORE_API AttributeFactory
     [[nodiscard]] vector<S<IAttributeSlot>> from_json(const Json& j);
     [[nodiscard]] Json to_json(span<IAttribute*> attributes);
 
+    /**
+     * @brief Encode an attribute in the layout of an element of `to_json()`, straight from its values.
+     */
+    void encode(const IAttribute& attribute, JsonStreamEncoder& encoder);
+
+    /**
+     * @brief Create a consumer decoding an element of `to_json()`, the values are filled into the attribute directly.
+     *
+     * `on_decoded` receives the attribute slot, or nullptr if the element can't be decoded.
+     */
+    [[nodiscard]] S<JsonSaxConsumer> decoder(std::function<void(S<IAttributeSlot>)> on_decoded);
+
   private:
     U<Impl> m_impl;
 };
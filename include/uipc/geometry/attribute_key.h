@@ -0,0 +1,84 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <uipc/common/type_define.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief A pre-hashed attribute name.
+ *
+ * AttributeKey is a `std::string_view` carrying the hash of its content, so lookups by key
+ * don't need to rehash or allocate. The builtin attribute names (e.g. `builtin::position`) are
+ * compile-time AttributeKey constants.
+ *
+ * ```cpp
+ * constexpr AttributeKey velocity{"velocity"};
+ * auto vel = sc.vertices().find<Vector3>(velocity);
+ * ```
+ *
+ * @note AttributeKey doesn't own the name, the name must outlive the key.
+ */
+class AttributeKey : public std::string_view
+{
+  public:
+    constexpr AttributeKey() noexcept = default;
+
+    constexpr AttributeKey(std::string_view name) noexcept
+        : std::string_view(name)
+        , m_hash(hash(name))
+    {
+    }
+
+    constexpr AttributeKey(const char* name) noexcept
+        : AttributeKey(std::string_view{name})
+    {
+    }
+
+    AttributeKey(const std::string& name) noexcept
+        : AttributeKey(std::string_view{name})
+    {
+    }
+
+    /**
+     * @brief Get the name of the key.
+     */
+    constexpr std::string_view name() const noexcept { return *this; }
+
+    /**
+     * @brief Get the hash of the key.
+     */
+    constexpr U64 hash() const noexcept { return m_hash; }
+
+    /**
+     * @brief The hash function of the AttributeKey (64 bit FNV-1a).
+     */
+    static constexpr U64 hash(std::string_view name) noexcept
+    {
+        U64 h = 14695981039346656037ull;
+        for(char c : name)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    friend constexpr bool operator==(const AttributeKey& lhs, const AttributeKey& rhs) noexcept
+    {
+        return lhs.m_hash == rhs.m_hash && lhs.name() == rhs.name();
+    }
+
+  private:
+    U64 m_hash = hash({});
+};
+}  // namespace uipc::geometry
+
+template <>
+struct std::hash<uipc::geometry::AttributeKey>
+{
+    std::size_t operator()(const uipc::geometry::AttributeKey& key) const noexcept
+    {
+        return static_cast<std::size_t>(key.hash());
+    }
+};
@@ -5,6 +5,7 @@
 #include <uipc/common/exception.h>
 #include <uipc/backend/buffer_view.h>
 #include <uipc/common/buffer_info.h>
+#include <atomic>
 #include <chrono>
 namespace uipc::geometry
 {
@@ -98,6 +99,13 @@ class UIPC_CORE_API IAttributeSlot
     void         rw_access();
     void         last_modified(const TimePoint& tp);
     virtual void set_last_modified(const TimePoint& tp) noexcept = 0;
+
+    // a process-wide increasing stamp, see `AttributeCollection::modification_stamp()`
+    static U64 next_modification_stamp() noexcept;
+
+  private:
+    // the dirty flag of the collection holding this slot, set on every modification of the slot
+    S<std::atomic<bool>> m_collection_dirty;
 };
 
 /**
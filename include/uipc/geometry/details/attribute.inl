@@ -3,9 +3,98 @@
 #include <uipc/common/range.h>
 #include <uipc/common/readable_type_name.h>
 #include <uipc/common/demangle.h>
+#include <uipc/common/hash.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 namespace uipc::geometry
 {
+namespace detail
+{
+    // values whose bytes are exactly their content: arithmetic values and fixed size Eigen matrices
+    template <typename T>
+    concept PlainBytesValue =
+        std::is_arithmetic_v<T> || requires {
+            typename T::Scalar;
+            requires T::SizeAtCompileTime != Eigen::Dynamic;
+            requires sizeof(T) == T::SizeAtCompileTime * sizeof(typename T::Scalar);
+        };
+
+    template <typename T>
+    U64 content_hash(span<const T> values, U64 seed) noexcept
+    {
+        if constexpr(PlainBytesValue<T>)
+        {
+            return xxhash64(values.data(), values.size_bytes(), seed);
+        }
+        else
+        {
+            U64 h = seed;
+            for(auto&& v : values)
+            {
+                if constexpr(requires { v.rows(); v.cols(); v.data(); })  // dynamic Eigen
+                {
+                    Eigen::Index shape[] = {v.rows(), v.cols()};
+                    h = xxhash64(shape, sizeof(shape), h);
+                    h = xxhash64(v.data(), v.size() * sizeof(*v.data()), h);
+                }
+                else if constexpr(requires { v.size(); v.data(); })  // string-like
+                {
+                    SizeT size = v.size();
+                    h          = xxhash64(&size, sizeof(size), h);
+                    h = xxhash64(v.data(), size * sizeof(*v.data()), h);
+                }
+                else
+                {
+                    auto str = Json(v).dump();
+                    h        = xxhash64(str.data(), str.size(), h);
+                }
+            }
+            return h;
+        }
+    }
+
+    template <typename T>
+    bool content_equal(span<const T> a, span<const T> b) noexcept
+    {
+        if(a.size() != b.size())
+            return false;
+
+        if constexpr(PlainBytesValue<T>)
+        {
+            return a.empty() || std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+        }
+        else
+        {
+            for(SizeT i = 0; i < a.size(); ++i)
+            {
+                auto&& x = a[i];
+                auto&& y = b[i];
+                if constexpr(requires { x.rows(); x.cols(); x.data(); })  // dynamic Eigen
+                {
+                    if(x.rows() != y.rows() || x.cols() != y.cols())
+                        return false;
+                    if(x.size() > 0
+                       && std::memcmp(x.data(), y.data(), x.size() * sizeof(*x.data())) != 0)
+                        return false;
+                }
+                else if constexpr(std::equality_comparable<T>)
+                {
+                    if(x != y)
+                        return false;
+                }
+                else
+                {
+                    if(Json(x) != Json(y))
+                        return false;
+                }
+            }
+            return true;
+        }
+    }
+}  // namespace detail
+
 template <typename T>
 Attribute<T>::Attribute(const T& default_value) noexcept
     : m_values{}
@@ -13,12 +102,25 @@ Attribute<T>::Attribute(const T& default_value) noexcept
 {
 }
 
+template <typename T>
+Attribute<T>::Attribute(vector<T>&& values, const T& default_value) noexcept
+    : m_values{std::move(values)}
+    , m_default_value{default_value}
+{
+}
+
 template <typename T>
 span<const T> Attribute<T>::view() const noexcept
 {
     return m_values;
 }
 
+template <typename T>
+const T& Attribute<T>::default_value() const noexcept
+{
+    return m_default_value;
+}
+
 template <typename T>
 std::string Attribute<T>::type() noexcept
 {
@@ -38,6 +140,57 @@ std::string_view Attribute<T>::get_type_name() const noexcept
     return type_name;
 }
 
+template <typename T>
+SizeT Attribute<T>::get_memory_usage() const noexcept
+{
+    SizeT bytes = m_values.capacity() * sizeof(T);
+
+    // count the heap memory of dynamic sized values
+    if constexpr(requires(const T& t) { t.capacity(); })  // string-like
+    {
+        for(auto&& v : m_values)
+            bytes += v.capacity();
+    }
+    else if constexpr(requires(const T& t) {
+                          t.size();
+                          t.data();
+                          T::SizeAtCompileTime;
+                      })
+    {
+        if constexpr(T::SizeAtCompileTime == Eigen::Dynamic)
+        {
+            for(auto&& v : m_values)
+                bytes += v.size() * sizeof(typename T::Scalar);
+        }
+    }
+    return bytes;
+}
+
+template <typename T>
+std::pmr::memory_resource* Attribute<T>::get_memory_resource() const noexcept
+{
+    return m_values.get_allocator().resource();
+}
+
+template <typename T>
+U64 Attribute<T>::get_content_hash() const noexcept
+{
+    auto type = get_type_name();
+    U64  h    = xxhash64(type.data(), type.size());
+    h         = detail::content_hash(span<const T>{&m_default_value, 1}, h);
+    return detail::content_hash(span<const T>{m_values}, h);
+}
+
+template <typename T>
+bool Attribute<T>::get_content_equal(const IAttribute& other) const noexcept
+{
+    // the type is checked by IAttribute
+    auto& o = static_cast<const Attribute<T>&>(other);
+    return detail::content_equal(span<const T>{&m_default_value, 1},
+                                 span<const T>{&o.m_default_value, 1})
+           && detail::content_equal(span<const T>{m_values}, span<const T>{o.m_values});
+}
+
 template <typename T>
 void Attribute<T>::do_resize(SizeT N)
 {
@@ -69,9 +222,43 @@ inline S<IAttribute> Attribute<T>::do_clone_empty() const
 template <typename T>
 void Attribute<T>::do_reorder(span<const SizeT> O) noexcept
 {
-    auto old_values = m_values;
-    for(SizeT i = 0; i < O.size(); ++i)
-        m_values[i] = old_values[O[i]];
+    const SizeT N = O.size();
+
+    // a permutation of all the values is applied in place by following its cycles, no copy is needed
+    if(N == m_values.size() && N < detail::ParallelAttributeSize)
+    {
+        // 0: unseen, 1: seen in O, 2: moved to its new place
+        std::vector<char> state(N, 0);
+        bool is_permutation = std::ranges::all_of(
+            O, [&](SizeT o) { return o < N && std::exchange(state[o], 1) == 0; });
+
+        if(is_permutation)
+        {
+            for(SizeT i = 0; i < N; ++i)
+            {
+                if(state[i] == 2)
+                    continue;
+
+                T     first = std::move(m_values[i]);
+                SizeT j     = i;
+                for(; O[j] != i; j = O[j])
+                {
+                    m_values[j] = std::move(m_values[O[j]]);
+                    state[j]    = 2;
+                }
+                m_values[j] = std::move(first);
+                state[j]    = 2;
+            }
+            return;
+        }
+    }
+
+    // a large permutation, a prefix or repeated indices: gather into a scratch buffer (in parallel chunks
+    // if large), then move back, only the first N values are touched
+    std::vector<T> scratch(N, m_default_value);
+    span<T>        values = m_values;
+    detail::parallel_assign(span<T>{scratch}, N, [&](SizeT i) -> const T& { return values[O[i]]; });
+    detail::parallel_assign(values, N, [&](SizeT i) -> T&& { return std::move(scratch[i]); });
 }
 
 template <typename T>
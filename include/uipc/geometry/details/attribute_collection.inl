@@ -12,16 +12,16 @@ S<AttributeSlot<T>> AttributeCollection::share(std::string_view        name,
 }
 
 template <typename T>
-S<AttributeSlot<T>> AttributeCollection::find(std::string_view name)
+S<AttributeSlot<T>> AttributeCollection::find(const AttributeKey& key)
 {
-    auto slot = this->find(name);
+    auto slot = this->find(key);
     return std::dynamic_pointer_cast<AttributeSlot<T>>(slot);
 }
 
 template <typename T>
-S<const AttributeSlot<T>> AttributeCollection::find(std::string_view name) const
+S<const AttributeSlot<T>> AttributeCollection::find(const AttributeKey& key) const
 {
-    auto slot = this->find(name);
+    auto slot = this->find(key);
     return std::dynamic_pointer_cast<const AttributeSlot<T>>(slot);
 }
 }  // namespace uipc::geometry
@@ -1,7 +1,27 @@
 #include <uipc/common/log.h>
 #include <uipc/common/enumerate.h>
+#include <uipc/common/parallel_for.h>
 namespace uipc::geometry
 {
+namespace detail
+{
+    // the values of an attribute are copied and reordered in parallel chunks from this size on,
+    // smaller attributes are not worth the threads
+    inline constexpr SizeT ParallelAttributeSize  = SizeT{1} << 16;
+    inline constexpr SizeT ParallelAttributeGrain = SizeT{1} << 14;
+
+    // dst[i] = f(i) for i in [0, count)
+    template <typename T, typename F>
+    void parallel_assign(span<T> dst, SizeT count, F&& f)
+    {
+        if(count >= ParallelAttributeSize)
+            parallel_for(0, count, [&](SizeT i) { dst[i] = f(i); }, ParallelAttributeGrain);
+        else
+            for(SizeT i = 0; i < count; ++i)
+                dst[i] = f(i);
+    }
+}  // namespace detail
+
 template <typename T>
 void AttributeCopy::copy(span<T> dst, span<const T> src) const noexcept
 {
@@ -16,27 +36,34 @@ void AttributeCopy::copy(span<T> dst, span<const T> src) const noexcept
                         "Attribute size mismatch, dst is {}, src is {}.",
                         dst.size(),
                         src.size());
-            std::ranges::copy(src, dst.begin());
+            detail::parallel_assign(dst, dst.size(), [&](SizeT i) -> const T& { return src[i]; });
         }
         break;
         case uipc::geometry::AttributeCopy::Range: {
             auto src_subspan = src.subspan(m_src_offset, m_count);
             auto dst_subspan = dst.subspan(m_dst_offset, m_count);
-            std::ranges::copy(src_subspan, dst_subspan.begin());
+            detail::parallel_assign(dst_subspan, src_subspan.size(), [&](SizeT i) -> const T& { return src_subspan[i]; });
         }
         break;
         case uipc::geometry::AttributeCopy::Pull: {
             auto pull_mapping = m_mapping;
+            if(m_dst_offset != ~0ull)
+            {
+                UIPC_ASSERT(m_dst_offset + pull_mapping.size() <= dst.size(),
+                            "Pull mapping out of range, dst size is {}, dst offset is {}, mapper size is {}",
+                            dst.size(),
+                            m_dst_offset,
+                            pull_mapping.size());
+                dst = dst.subspan(m_dst_offset, pull_mapping.size());
+            }
             UIPC_ASSERT(pull_mapping.size() == dst.size(),
                         "Pull mapping size mismatch, dst size is {}, mapper size is {}",
                         dst.size(),
                         pull_mapping.size());
-            for(auto [i, j] : enumerate(pull_mapping))
-            {
-                dst[i] = src[j];
-            }
+            detail::parallel_assign(dst, dst.size(), [&](SizeT i) -> const T& { return src[pull_mapping[i]]; });
         }
         break;
+        // a push or pair mapping may write the same dst twice, so it is applied in order
         case uipc::geometry::AttributeCopy::Push: {
             auto push_mapping = m_mapping;
             UIPC_ASSERT(push_mapping.size() == src.size(),
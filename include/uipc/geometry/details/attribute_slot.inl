@@ -86,8 +86,8 @@ template <typename T>
 void AttributeSlot<T>::do_share_from(const IAttributeSlot& other) noexcept
 {
     auto& other_slot = static_cast<const AttributeSlot<T>&>(other);
-    m_name           = other_slot.m_name;
-    m_attribute      = other_slot.m_attribute;
+    // keep the name, the slot may be shared under another name
+    m_attribute = other_slot.m_attribute;
     // m_last_modified is updated in base class
     m_is_evolving = other_slot.m_is_evolving;
 }
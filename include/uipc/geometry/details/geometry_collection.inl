@@ -4,13 +4,11 @@ template <std::derived_from<geometry::Geometry> GeometryT>
     requires(!std::is_abstract_v<GeometryT>)
 S<geometry::GeometrySlotT<GeometryT>> GeometryCollection::emplace(const GeometryT& geometry)
 {
-    m_dirty = true;
-
     auto id = m_next_id++;
 
     auto slot = uipc::make_shared<geometry::GeometrySlotT<GeometryT>>(id, geometry);
     slot->state(geometry::GeometrySlotState::Normal);
-    m_geometries.emplace(id, slot);
+    insert(slot);
 
     return slot;
 }
@@ -19,13 +17,11 @@ template <std::derived_from<geometry::Geometry> GeometryT>
     requires(!std::is_abstract_v<GeometryT>)
 S<geometry::GeometrySlotT<GeometryT>> GeometryCollection::pending_emplace(const GeometryT& geometry)
 {
-    m_dirty = true;
-
     auto id = m_next_id++;
 
     auto slot = uipc::make_shared<geometry::GeometrySlotT<GeometryT>>(id, geometry);
     slot->state(geometry::GeometrySlotState::PendingCreate);
-    m_pending_create.emplace(id, slot);
+    pending_insert(slot);
 
     return slot;
 }
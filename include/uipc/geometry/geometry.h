@@ -132,9 +132,9 @@ class UIPC_CORE_API Geometry : public IGeometry
          * @brief Find an attribute by type and name, if the attribute does not exist, return nullptr.
          */
         template <typename T>
-        [[nodiscard]] auto find(std::string_view name) &&
+        [[nodiscard]] auto find(const AttributeKey& key) &&
         {
-            return m_attributes.template find<T>(name);
+            return m_attributes.template find<T>(key);
         }
 
         /**
@@ -245,9 +245,9 @@ class UIPC_CORE_API Geometry : public IGeometry
          * @brief Find an attribute by type and name, if the attribute does not exist, return nullptr.
          */
         template <typename T>
-        [[nodiscard]] auto find(std::string_view name) &&
+        [[nodiscard]] auto find(const AttributeKey& key) &&
         {
-            return m_attributes.template find<T>(name);
+            return m_attributes.template find<T>(key);
         }
 
         /**
@@ -2,6 +2,8 @@
 #include <uipc/geometry/geometry.h>
 #include <uipc/geometry/geometry_slot.h>
 #include <uipc/geometry/geometry_collection.h>
+#include <uipc/geometry/geometry_source.h>
+#include <uipc/common/json_stream.h>
 
 namespace uipc::geometry
 {
@@ -13,11 +15,32 @@ class UIPC_CORE_API GeometryAtlas
     GeometryAtlas();
     ~GeometryAtlas();
 
+    /**
+     * @brief Enable or disable the content-addressed deduplication of attributes, disabled by default.
+     *
+     * When enabled, the attributes with the same type, default value and values are stored once,
+     * even if they are not shared in memory (e.g. the same mesh loaded many times).
+     * The deserialized geometries share these attributes (copy-on-write).
+     *
+     * @note Only affects the geometries and attribute collections created afterwards.
+     */
+    void deduplicate(bool enable) noexcept;
+
+    [[nodiscard]] bool deduplicate() const noexcept;
+
     /**
      * @brief Create a geometry in the atlas
      */
     IndexT create(const Geometry& geo, bool evolving_only = false);
 
+    /**
+     * @brief Create a geometry in the atlas from a geometry source, without decoding it.
+     *
+     * The attributes are copied from the archive of the source when the atlas is written,
+     * see `IGeometrySource::encode_attribute()`. `find()` returns nullptr for such a geometry.
+     */
+    IndexT create(S<const IGeometrySource> source);
+
     /**
      * @brief Find the geometry slot by id
      * 
@@ -56,6 +79,22 @@ class UIPC_CORE_API GeometryAtlas
      */
     void from_json(const Json& j);
 
+    /**
+     * @brief Create json representation of the geometry atlas in `j`, the attribute values are deferred to `writer`.
+     *
+     * The attribute values are encoded straight from the attributes when `writer` reaches them,
+     * so the geometry atlas must outlive `writer.write()`.
+     */
+    void to_json(Json& j, JsonStreamWriter& writer) const;
+
+    /**
+     * @brief Decode the attributes of the geometry atlas at `path` of the document read by `reader`.
+     *
+     * The attribute values are filled into the attributes directly. After `reader.read()`,
+     * call `from_json()` with the json of the geometry atlas to finish.
+     */
+    void capture(JsonStreamReader& reader, span<const std::string> path);
+
   private:
     U<Impl> m_impl;
 };
@@ -2,7 +2,8 @@
 #include <concepts>
 #include <uipc/geometry/geometry.h>
 #include <uipc/geometry/geometry_slot.h>
-#include <uipc/common/set.h>
+#include <uipc/common/vector.h>
+#include <uipc/common/unordered_map.h>
 
 namespace uipc::core::internal
 {
@@ -82,22 +83,44 @@ class UIPC_CORE_API GeometryCollection : public IGeometryCollection
     virtual IndexT get_next_id() const noexcept override;
 
   private:
-    unordered_map<IndexT, S<geometry::GeometrySlot>> m_geometries;
-    unordered_map<IndexT, S<geometry::GeometrySlot>> m_pending_create;
-    set<IndexT>                                      m_pending_destroy;
+    enum class SlotLocation : IndexT
+    {
+        None,
+        Normal,
+        PendingCreate
+    };
+
+    // the location of the slot with the id, indexed by id
+    struct SlotEntry
+    {
+        SlotLocation location = SlotLocation::None;
+        IndexT       index    = -1;  // the index in m_geometry_slots or m_pending_create_slots
+    };
+
+    // ids are never reused, so the id itself tells the slots apart, no generation counter is needed
+    mutable vector<SlotEntry> m_entries;
+
+    // sorted by id, the destroyed slots (entry location is None) stay until the next flush()
+    mutable vector<S<geometry::GeometrySlot>> m_geometry_slots;
+    mutable SizeT                             m_destroyed_count = 0;
+    mutable SizeT                             m_first_destroyed = 0;
+    mutable vector<S<geometry::GeometrySlot>> m_pending_create_slots;  // sorted by id
+    mutable vector<IndexT>                    m_pending_destroy_ids;
+    mutable bool                              m_pending_destroy_sorted = true;
 
     IndexT m_next_id = 0;
 
-    mutable bool m_dirty = true;
-
-    mutable vector<S<geometry::GeometrySlot>> m_geometry_slots;
-    mutable vector<S<geometry::GeometrySlot>> m_pending_create_slots;
-    mutable vector<IndexT>                    m_pending_destroy_ids;
+    const SlotEntry* entry(IndexT id) const noexcept;
+    void             insert(S<geometry::GeometrySlot> slot);
+    void             pending_insert(S<geometry::GeometrySlot> slot);
+    void             mark_destroyed(IndexT id);
+    void reindex(span<S<geometry::GeometrySlot>> slots, SlotLocation location, SizeT begin) const;
 
     void flush() const;
 
     void build_from(span<S<geometry::GeometrySlot>> slots) noexcept;
-    void update_from(const unordered_map<IndexT, S<GeometryCommit>>& commits) noexcept;
+    void update_from(const unordered_map<IndexT, S<GeometryCommit>>& commits,
+                     span<const IndexT> removed_ids = {});
 };
 }  // namespace uipc::geometry
 
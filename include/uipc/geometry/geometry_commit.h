@@ -2,6 +2,11 @@
 #include <uipc/geometry/geometry.h>
 #include <uipc/geometry/attribute_collection_commit.h>
 
+namespace uipc::core
+{
+class SceneHistory;
+}
+
 namespace uipc::geometry
 {
 class UIPC_CORE_API GeometryCommit
@@ -10,6 +15,7 @@ class UIPC_CORE_API GeometryCommit
     friend class GeometryCollection;
     friend class GeometryFactory;
     friend class GeometryAtlasCommit;
+    friend class core::SceneHistory;
 
     friend UIPC_CORE_API GeometryCommit operator-(const Geometry& dst, const Geometry& src);
     friend UIPC_CORE_API Geometry& operator+=(Geometry& base, const GeometryCommit& inc);
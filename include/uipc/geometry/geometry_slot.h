@@ -2,10 +2,14 @@
 #include <uipc/common/type_define.h>
 #include <uipc/common/smart_pointer.h>
 #include <uipc/geometry/geometry.h>
+#include <atomic>
+#include <mutex>
 
 namespace uipc::core
 {
 class SceneFactory;
+class SceneSnapshot;
+class SceneHistory;
 }
 
 namespace uipc::geometry
@@ -17,22 +21,36 @@ enum class GeometrySlotState
     PendingDestroy
 };
 
+class IGeometrySource;
+
 class UIPC_CORE_API GeometrySlot
 {
     friend class GeometryCollection;
     friend class core::SceneFactory;
+    friend class core::SceneSnapshot;
+    friend class core::SceneHistory;
     friend class GeometryAtlas;
 
   public:
     GeometrySlot(IndexT id) noexcept;
     virtual ~GeometrySlot() = default;
     IndexT          id() const noexcept;
-    Geometry&       geometry() noexcept;
-    const Geometry& geometry() const noexcept;
+    /**
+     * @brief The geometry, a lazily loaded slot decodes it on first access.
+     *
+     * @throw core::SceneIOError if the geometry can't be decoded, e.g. the file is truncated or changed.
+     */
+    Geometry&       geometry();
+    const Geometry& geometry() const;
 
     GeometrySlotState state() const noexcept;
     S<GeometrySlot>   clone() const;
 
+    /**
+     * @brief Whether the geometry is decoded, a lazily loaded slot decodes its geometry on first access.
+     */
+    bool is_loaded() const noexcept;
+
     GeometrySlot(const GeometrySlot&)            = delete;
     GeometrySlot(GeometrySlot&&)                 = delete;
     GeometrySlot& operator=(const GeometrySlot&) = delete;
@@ -43,11 +61,25 @@ class UIPC_CORE_API GeometrySlot
     virtual const Geometry& get_geometry() const noexcept = 0;
     virtual S<GeometrySlot> do_clone() const              = 0;
 
+    /**
+     * @brief Decode the geometry of a lazily loaded slot, the typed accessors of the subclasses must call it.
+     *
+     * @throw core::SceneIOError if the geometry can't be decoded, the slot stays unloaded.
+     */
+    void load() const;
+
   private:
     IndexT            m_id;
     void              id(IndexT id) noexcept;
     GeometrySlotState m_state = GeometrySlotState::Normal;
     void              state(GeometrySlotState state) noexcept;
+
+    // lazy loading
+    mutable std::mutex               m_load_mutex;
+    mutable std::atomic<bool>        m_loaded{true};
+    mutable S<const IGeometrySource> m_source;
+    void                     source(S<const IGeometrySource> source) noexcept;
+    S<const IGeometrySource> source() const noexcept;
 };
 
 template <std::derived_from<Geometry> GeometryT>
@@ -0,0 +1,58 @@
+#pragma once
+#include <uipc/geometry/geometry.h>
+#include <uipc/common/json_stream.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief The serialized form of a geometry, decoded on demand.
+ *
+ * A lazily loaded GeometrySlot holds a geometry source instead of the attribute values,
+ * the geometry is decoded by `load()` when the slot is first accessed.
+ *
+ * The attributes of the geometry are stored in an archive (e.g. a scene file) shared by many sources.
+ * The json of the geometry refers to them by their index in the archive, so an untouched geometry can
+ * be written back by copying the encoded attributes, without decoding them (see `GeometryAtlas::create()`).
+ */
+class UIPC_CORE_API IGeometrySource
+{
+  public:
+    virtual ~IGeometrySource() = default;
+
+    /**
+     * @brief Decode the geometry.
+     */
+    [[nodiscard]] S<Geometry> load() const;
+
+    /**
+     * @brief The json of the geometry, in the layout of `GeometryFactory::to_json()`.
+     *
+     * The `index` of an attribute is the index of the attribute in the archive.
+     */
+    [[nodiscard]] const Json& json() const;
+
+    /**
+     * @brief The identity of the archive, the sources of the same archive share the attribute indices.
+     */
+    [[nodiscard]] const void* archive() const noexcept;
+
+    /**
+     * @brief Encode the attribute at `index` of the archive, in the layout of `AttributeFactory::encode()`.
+     *
+     * The encoded bytes are copied if the archive has the format of `encoder`.
+     */
+    void encode_attribute(IndexT index, JsonStreamEncoder& encoder) const;
+
+    /**
+     * @brief The json of the attribute at `index` of the archive, in the layout of `AttributeFactory::to_json()`.
+     */
+    [[nodiscard]] Json attribute_to_json(IndexT index) const;
+
+  protected:
+    virtual S<Geometry> do_load() const                                     = 0;
+    virtual const Json& get_json() const                                    = 0;
+    virtual const void* get_archive() const noexcept                        = 0;
+    virtual void do_encode_attribute(IndexT index, JsonStreamEncoder& encoder) const = 0;
+    virtual Json do_attribute_to_json(IndexT index) const                   = 0;
+};
+}  // namespace uipc::geometry
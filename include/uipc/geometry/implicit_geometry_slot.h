@@ -10,8 +10,8 @@ class UIPC_CORE_API GeometrySlotT<ImplicitGeometry> : public GeometrySlot
   public:
     GeometrySlotT(IndexT id, const ImplicitGeometry& geometry);
 
-    ImplicitGeometry&       geometry() noexcept;
-    const ImplicitGeometry& geometry() const noexcept;
+    ImplicitGeometry&       geometry();
+    const ImplicitGeometry& geometry() const;
 
   protected:
     Geometry&       get_geometry() noexcept override;
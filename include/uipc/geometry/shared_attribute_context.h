@@ -3,6 +3,11 @@
 #include <uipc/geometry/attribute_slot.h>
 #include <uipc/common/unordered_map.h>
 
+namespace uipc::core
+{
+class SceneFactory;
+}
+
 namespace uipc::geometry
 {
 class UIPC_CORE_API SerialSharedAttributeContext
@@ -20,6 +25,10 @@ class UIPC_CORE_API SerialSharedAttributeContext
 
     unordered_map<IAttribute*, IndexT> m_attr_to_index;
     vector<IAttribute*>                m_index_to_attr;
+    // attributes with the same content share one index, see GeometryAtlas::deduplicate()
+    bool                               m_deduplicate = false;
+    unordered_map<U64, vector<IndexT>> m_content_to_indices;
+    void                               insert(IAttribute* attr);
     void                               clear();
 };
 
@@ -33,6 +42,7 @@ class UIPC_CORE_API DeserialSharedAttributeContext
   private:
     friend class GeometryAtlas;
     friend class GeometryAtlasCommit;
+    friend class core::SceneFactory;
 
     vector<S<IAttributeSlot>> m_attribute_slots;
     void                      clear();
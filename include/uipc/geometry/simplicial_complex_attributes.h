@@ -3,6 +3,7 @@
 #include <uipc/geometry/attribute_collection.h>
 #include <uipc/common/json.h>
 #include <uipc/geometry/attribute_friend.h>
+#include <uipc/builtin/attribute_name.h>
 namespace uipc::geometry
 {
 template <bool IsConst, IndexT N>
@@ -44,13 +45,13 @@ class SimplicialComplexAttributes
     [[nodiscard]] AttributeSlot<TopoValueT>& topo()
         requires(!IsConst && N > 0)
     {
-        return *m_attributes.template find<TopoValueT>("topo");
+        return *m_attributes.template find<TopoValueT>(builtin::topo);
     }
 
     [[nodiscard]] const AttributeSlot<TopoValueT>& topo() const
         requires(N > 0)
     {
-        return *m_attributes.template find<TopoValueT>("topo");
+        return *m_attributes.template find<TopoValueT>(builtin::topo);
     }
 
     /**
@@ -70,6 +71,15 @@ class SimplicialComplexAttributes
     {
         m_attributes.reserve(size);
     }
+    /**
+     * @sa AttributeCollection::reorder
+     */
+    void reorder(span<const SizeT> O)
+        requires(!IsConst)
+    {
+        m_attributes.reorder(O);
+    }
+
     /**
      * @sa AttributeCollection::clear
      */
@@ -95,19 +105,19 @@ class SimplicialComplexAttributes
      * @brief Find an attribute by type and name, if the attribute does not exist, return nullptr.
      */
     template <typename T>
-    [[nodiscard]] decltype(auto) find(std::string_view name)
+    [[nodiscard]] decltype(auto) find(const AttributeKey& key)
         requires(!IsConst)
     {
-        return m_attributes.template find<T>(name);
+        return m_attributes.template find<T>(key);
     }
 
     /**
     * @brief Find an attribute by type and name, if the attribute does not exist, return nullptr.
     */
     template <typename T>
-    [[nodiscard]] decltype(auto) find(std::string_view name) const
+    [[nodiscard]] decltype(auto) find(const AttributeKey& key) const
     {
-        return std::as_const(m_attributes).template find<T>(name);
+        return std::as_const(m_attributes).template find<T>(key);
     }
 
     template <typename T>
@@ -117,6 +127,26 @@ class SimplicialComplexAttributes
         return m_attributes.template create<T>(name, default_value, allow_destroy);
     }
 
+    /**
+     * @sa AttributeCollection::adopt
+     */
+    template <typename T>
+    decltype(auto) adopt(std::string_view name, vector<T>&& values, const T& default_value = {}, bool allow_destroy = true)
+        requires(!IsConst)
+    {
+        return m_attributes.template adopt<T>(name, std::move(values), default_value, allow_destroy);
+    }
+
+    /**
+     * @sa AttributeCollection::create_from
+     */
+    template <typename T>
+    decltype(auto) create_from(std::string_view name, span<const T> values, const T& default_value = {}, bool allow_destroy = true)
+        requires(!IsConst)
+    {
+        return m_attributes.template create_from<T>(name, values, default_value, allow_destroy);
+    }
+
     template <typename T>
     decltype(auto) share(std::string_view name, const AttributeSlot<T>& slot, bool allow_destroy = true)
         requires(!IsConst)
@@ -133,6 +163,35 @@ class SimplicialComplexAttributes
         m_attributes.copy_from(other.m_attributes, copy, include_names, exclude_names);
     }
 
+    /**
+     * @sa AttributeCollection::concat_from
+     */
+    void concat_from(span<const SimplicialComplexAttributes<true, N>> others,
+                     span<const string> exclude_names = {})
+        requires(!IsConst)
+    {
+        vector<const AttributeCollection*> sources;
+        sources.reserve(others.size());
+        for(auto& other : others)
+            sources.push_back(&other.m_attributes);
+        m_attributes.concat_from(sources, exclude_names);
+    }
+
+    /**
+     * @sa AttributeCollection::concat_from
+     */
+    void concat_from(span<const SimplicialComplexAttributes<true, N>> others,
+                     span<const span<const SizeT>>                    mappings,
+                     span<const string> exclude_names = {})
+        requires(!IsConst)
+    {
+        vector<const AttributeCollection*> sources;
+        sources.reserve(others.size());
+        for(auto& other : others)
+            sources.push_back(&other.m_attributes);
+        m_attributes.concat_from(sources, mappings, exclude_names);
+    }
+
     Json to_json() const { return m_attributes.to_json(); }
 
   private:
@@ -14,8 +14,8 @@ class GeometrySlotT<SimplicialComplex> : public GeometrySlot
     GeometrySlotT& operator=(const GeometrySlotT&) = delete;
     GeometrySlotT& operator=(GeometrySlotT&&)      = delete;
 
-    SimplicialComplex&       geometry() noexcept;
-    const SimplicialComplex& geometry() const noexcept;
+    SimplicialComplex&       geometry();
+    const SimplicialComplex& geometry() const;
 
   protected:
     virtual Geometry&       get_geometry() noexcept override;
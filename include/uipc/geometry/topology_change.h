@@ -0,0 +1,129 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief The removed and inserted simplices of one dimension, see `TopologyChange`.
+ *
+ * The indices of `remove()` and the parents of `insert()` are the indices before the change.
+ * The topology of an inserted simplex is in the vertex indices after the change, see `TopologyChange::vertex_remap()`.
+ */
+template <IndexT N>
+class SimplexChange
+{
+  public:
+    using TopoValueT = typename SimplicialComplexAttributes<true, N>::TopoValueT;
+
+    /**
+     * @brief Remove the simplex at `index`.
+     */
+    void remove(IndexT index) { m_removed.push_back(index); }
+
+    /**
+     * @brief Insert a vertex, the attribute values are copied from the vertex `parent`,
+     * or are the default values if `parent` is -1.
+     */
+    void insert(IndexT parent)
+        requires(N == 0)
+    {
+        m_parents.push_back(parent);
+    }
+
+    /**
+     * @brief Insert a simplex, the attribute values (except the topology) are copied from the simplex `parent`,
+     * or are the default values if `parent` is -1.
+     */
+    void insert(IndexT parent, const TopoValueT& topo)
+        requires(N > 0)
+    {
+        m_parents.push_back(parent);
+        m_topo.push_back(topo);
+    }
+
+    [[nodiscard]] span<const IndexT> removed() const noexcept { return m_removed; }
+    [[nodiscard]] span<const IndexT> parents() const noexcept { return m_parents; }
+    [[nodiscard]] span<const TopoValueT> topo() const noexcept
+        requires(N > 0)
+    {
+        return m_topo;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_removed.empty() && m_parents.empty();
+    }
+
+    void clear() noexcept
+    {
+        m_removed.clear();
+        m_parents.clear();
+        m_topo.clear();
+    }
+
+  private:
+    vector<IndexT>     m_removed;
+    vector<IndexT>     m_parents;
+    vector<TopoValueT> m_topo;
+};
+
+/**
+ * @brief The topology change of a SimplicialComplex, e.g. reported by a backend after tearing or remeshing.
+ *
+ * After the change, the kept simplices of each dimension keep their relative order, and the inserted simplices
+ * are appended in the order of insertion. So the new index of a kept vertex is its old index minus the number
+ * of removed vertices before it, and the k-th inserted vertex gets the index `kept vertex count + k`.
+ */
+class UIPC_CORE_API TopologyChange
+{
+  public:
+    [[nodiscard]] SimplexChange<0>&       vertices() noexcept;
+    [[nodiscard]] const SimplexChange<0>& vertices() const noexcept;
+
+    [[nodiscard]] SimplexChange<1>&       edges() noexcept;
+    [[nodiscard]] const SimplexChange<1>& edges() const noexcept;
+
+    [[nodiscard]] SimplexChange<2>&       triangles() noexcept;
+    [[nodiscard]] const SimplexChange<2>& triangles() const noexcept;
+
+    [[nodiscard]] SimplexChange<3>&       tetrahedra() noexcept;
+    [[nodiscard]] const SimplexChange<3>& tetrahedra() const noexcept;
+
+    [[nodiscard]] bool empty() const noexcept;
+    void               clear() noexcept;
+
+    /**
+     * @brief The new vertex indices of the old vertices, -1 for the removed ones.
+     *
+     * @param vertex_count the vertex count before the change
+     */
+    [[nodiscard]] vector<IndexT> vertex_remap(SizeT vertex_count) const;
+
+  private:
+    SimplexChange<0> m_vertices;
+    SimplexChange<1> m_edges;
+    SimplexChange<2> m_triangles;
+    SimplexChange<3> m_tetrahedra;
+};
+
+/**
+ * @brief Apply a topology change to a SimplicialComplex.
+ *
+ * Each attribute collection is changed in one batch: resized, reordered by a single New2Old mapping
+ * (kept simplices then parents), and resized again, so the cost is one pass over the values of each
+ * attribute, and the untouched collections cost nothing unless the vertex indices change.
+ * The topology of the kept simplices is remapped to the new vertex indices.
+ *
+ * The change is validated before anything is modified.
+ *
+ * @throw TopologyChangeError if an index is out of range, a simplex is removed twice,
+ * or a kept simplex refers to a removed vertex.
+ */
+UIPC_CORE_API void apply_topology_change(SimplicialComplex& sc, const TopologyChange& change);
+
+class UIPC_CORE_API TopologyChangeError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::geometry
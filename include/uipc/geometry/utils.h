@@ -15,3 +15,4 @@
 #include <uipc/geometry/utils/compute_instance_volume.h>
 #include <uipc/geometry/utils/optimal_transform.h>
 #include <uipc/geometry/utils/is_trimesh_closed.h>
+#include <uipc/geometry/utils/mesh_distance_query.h>
@@ -1,6 +1,8 @@
 #pragma once
 #include <uipc/common/type_define.h>
 #include <uipc/common/dllexport.h>
+#include <uipc/common/span.h>
+#include <uipc/common/execution_policy.h>
 
 namespace uipc::geometry
 {
@@ -32,4 +34,58 @@ Float UIPC_GEOMETRY_API edge_edge_squared_distance(const Vector3& Ea0,
                                                    const Vector3& Ea1,
                                                    const Vector3& Eb0,
                                                    const Vector3& Eb1);
+
+/**
+ * @brief Compute the squared distances of a batch of point-point pairs.
+ *
+ * @param PPs The candidate pairs, (vertex index, vertex index)
+ * @param Vs The vertex positions
+ * @param[out] Ds The squared distance of each pair, the same size as `PPs`
+ */
+void UIPC_GEOMETRY_API point_point_squared_distance(span<const Vector2i> PPs,
+                                                    span<const Vector3>  Vs,
+                                                    span<Float>          Ds,
+                                                    ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Compute the squared distances of a batch of point-edge pairs.
+ *
+ * @param PEs The candidate pairs, (vertex index, edge index)
+ * @param Vs The vertex positions
+ * @param Es The edges
+ * @param[out] Ds The squared distance of each pair, the same size as `PEs`
+ */
+void UIPC_GEOMETRY_API point_edge_squared_distance(span<const Vector2i> PEs,
+                                                   span<const Vector3>  Vs,
+                                                   span<const Vector2i> Es,
+                                                   span<Float>          Ds,
+                                                   ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Compute the squared distances of a batch of point-triangle pairs.
+ *
+ * @param PTs The candidate pairs, (vertex index, triangle index)
+ * @param Vs The vertex positions
+ * @param Fs The triangles
+ * @param[out] Ds The squared distance of each pair, the same size as `PTs`
+ */
+void UIPC_GEOMETRY_API point_triangle_squared_distance(span<const Vector2i> PTs,
+                                                       span<const Vector3>  Vs,
+                                                       span<const Vector3i> Fs,
+                                                       span<Float>          Ds,
+                                                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Compute the squared distances of a batch of edge-edge pairs.
+ *
+ * @param EEs The candidate pairs, (edge index, edge index)
+ * @param Vs The vertex positions
+ * @param Es The edges
+ * @param[out] Ds The squared distance of each pair, the same size as `EEs`
+ */
+void UIPC_GEOMETRY_API edge_edge_squared_distance(span<const Vector2i> EEs,
+                                                  span<const Vector3>  Vs,
+                                                  span<const Vector2i> Es,
+                                                  span<Float>          Ds,
+                                                  ExecutionPolicy policy = ExecutionPolicy::Parallel);
 }  // namespace uipc::geometry
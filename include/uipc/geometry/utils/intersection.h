@@ -1,6 +1,8 @@
 #pragma once
 #include <uipc/common/dllexport.h>
 #include <uipc/common/type_define.h>
+#include <uipc/common/span.h>
+#include <uipc/common/execution_policy.h>
 
 namespace uipc::geometry
 {
@@ -31,4 +33,41 @@ UIPC_GEOMETRY_API bool is_point_in_tet(const Vector3& T0,
                                        const Vector3& T2,
                                        const Vector3& T3,
                                        const Vector3& P);
+
+/**
+ * @brief Check a batch of triangle-edge pairs for intersection.
+ *
+ * The intersections are decided by the exact orientation predicates (see `orient3d()`), the floating point filters
+ * decide almost all the pairs and only the nearly degenerate ones fall back to the exact arithmetic.
+ * An edge lying exactly in the plane of the triangle is checked by `tri_edge_intersect()`.
+ *
+ * @param FEs The candidate pairs, (triangle index, edge index)
+ * @param Vs The vertex positions
+ * @param Fs The triangles
+ * @param Es The edges
+ * @param[out] intersected 1 if the pair intersects, otherwise 0, the same size as `FEs`
+ */
+UIPC_GEOMETRY_API void tri_edge_intersect(span<const Vector2i> FEs,
+                                          span<const Vector3>  Vs,
+                                          span<const Vector3i> Fs,
+                                          span<const Vector2i> Es,
+                                          span<IndexT>         intersected,
+                                          ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Check a batch of point-tetrahedron pairs for containment, the points on the boundary are inside.
+ *
+ * Decided by the exact orientation predicates, see `tri_edge_intersect()` for the batch version.
+ * A degenerate tetrahedron contains no point.
+ *
+ * @param PTs The candidate pairs, (vertex index, tetrahedron index)
+ * @param Vs The vertex positions
+ * @param Ts The tetrahedra
+ * @param[out] inside 1 if the point is in the tetrahedron, otherwise 0, the same size as `PTs`
+ */
+UIPC_GEOMETRY_API void is_point_in_tet(span<const Vector2i> PTs,
+                                       span<const Vector3>  Vs,
+                                       span<const Vector4i> Ts,
+                                       span<IndexT>         inside,
+                                       ExecutionPolicy policy = ExecutionPolicy::Parallel);
 }  // namespace uipc::geometry
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace uipc::geometry
  * 
  * - Create a `region` <IndexT> attribute on `vertices` to tell which region a vertex is belong to.
  * - Create a `region_count` <IndexT> attribute on `meta` to tell how many regions are there.
+ * - Create a `region_vertex_count` <VectorXi> attribute on `meta` to tell how many vertices are in each region.
  * 
  * @return S<AttributeSlot<IndexT>> The `region` attribute slot.
  */
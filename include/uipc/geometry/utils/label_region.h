@@ -10,6 +10,8 @@ namespace uipc::geometry
  * - Create a `region` <IndexT> attribute on `triangles` to tell which region a triangle is belong to. (if exists)
  * - Create a `region` <IndexT> attribute on `tetrahedra` to tell which region a tetrahedron is belong to. (if exists)
  * - Create a `region_count` <IndexT> attribute on `meta` to tell how many regions are there.
+ * - Create the `region_edge_count`, `region_triangle_count` and `region_tetrahedron_count` <VectorXi> attributes
+ *   on `meta` to tell how many simplices are in each region. (if exists)
  * 
  * @return S<AttributeSlot<IndexT>> The `region` attribute slot.
  */
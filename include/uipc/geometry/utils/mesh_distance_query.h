@@ -0,0 +1,158 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/common/span.h>
+#include <uipc/common/smart_pointer.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief Closest-point and signed-distance queries against a SimplicialComplex.
+ *
+ * The primitives of the mesh are kept in a BVH, a query walks the nodes nearest-first and skips the nodes
+ * farther than the best primitive found so far. The query structure is immutable after `build()`,
+ * so a single structure can be queried from many threads.
+ *
+ * The primitives depend on the dimension of the mesh:
+ * - dim = 0: the vertices
+ * - dim = 1: the edges
+ * - dim = 2: the triangles
+ * - dim = 3: the surface triangles (`is_surf` = 1)
+ *
+ * The positions are used as they are, the instance transforms are not applied.
+ */
+class UIPC_GEOMETRY_API MeshDistanceQuery
+{
+  public:
+    struct Result
+    {
+        /**
+         * @brief The distance from the query point to the mesh.
+         *
+         * Unsigned for `query()`, negative inside the mesh for `signed_query()`.
+         */
+        Float distance = std::numeric_limits<Float>::infinity();
+        /**
+         * @brief The index of the closest primitive, -1 if no primitive is within `max_distance`.
+         */
+        IndexT primitive = -1;
+        /**
+         * @brief The barycentric coordinates of the closest point on the closest primitive,
+         * the unused coordinates are zero (e.g. (1-t, t, 0) for an edge).
+         */
+        Vector3 barycentric = Vector3::Zero();
+        /**
+         * @brief The closest point on the mesh.
+         */
+        Vector3 closest_point = Vector3::Zero();
+    };
+
+    MeshDistanceQuery();
+    ~MeshDistanceQuery();
+
+    MeshDistanceQuery(const MeshDistanceQuery&)            = delete;
+    MeshDistanceQuery& operator=(const MeshDistanceQuery&) = delete;
+
+    /**
+     * @brief Build the query structure from a SimplicialComplex.
+     */
+    explicit MeshDistanceQuery(const SimplicialComplex& mesh);
+
+    /**
+     * @brief Build the query structure from a SimplicialComplex, the sparse SDF grid is dropped.
+     */
+    void build(const SimplicialComplex& mesh);
+
+    /**
+     * @brief Build the query structure from a triangle soup, the sparse SDF grid is dropped.
+     */
+    void build(span<const Vector3> positions, span<const Vector3i> triangles);
+
+    /**
+     * @brief Clear the query structure.
+     */
+    void clear();
+
+    /**
+     * @brief The number of primitives in the query structure.
+     */
+    [[nodiscard]] SizeT primitive_count() const noexcept;
+
+    /**
+     * @brief The primitives are triangles that form a closed surface, so the signed distance is defined.
+     */
+    [[nodiscard]] bool is_closed() const noexcept;
+
+    /**
+     * @brief Find the closest point on the mesh.
+     *
+     * @param max_distance the primitives farther than `max_distance` are ignored,
+     * a small `max_distance` makes the query cheaper.
+     */
+    [[nodiscard]] Result query(const Vector3& point,
+                               Float max_distance = std::numeric_limits<Float>::infinity()) const;
+
+    /**
+     * @brief Find the closest points of a batch of points in parallel.
+     *
+     * @param results results[i] is the result of points[i], `results` must have the size of `points`.
+     */
+    void query(span<const Vector3> points,
+               span<Result>        results,
+               Float max_distance = std::numeric_limits<Float>::infinity()) const;
+
+    /**
+     * @brief Find the closest point on the mesh, the distance is negative inside the mesh.
+     *
+     * The sign is taken from the angle-weighted pseudo normal of the closest feature (face, edge or vertex),
+     * which is exact for a closed, consistently oriented (outward) triangle mesh.
+     * A point farther than `max_distance` gets `Result::primitive` = -1 and an infinite distance, which
+     * carries no sign.
+     *
+     * Only available if `is_closed()` is true.
+     */
+    [[nodiscard]] Result signed_query(const Vector3& point,
+                                      Float max_distance = std::numeric_limits<Float>::infinity()) const;
+
+    /**
+     * @brief Signed queries of a batch of points in parallel, see `signed_query()`.
+     */
+    void signed_query(span<const Vector3> points,
+                      span<Result>        results,
+                      Float max_distance = std::numeric_limits<Float>::infinity()) const;
+
+    /**
+     * @brief Sample the signed distance (or the distance if the mesh is not closed) on a sparse grid
+     * around the surface, the samples are used by `distance()` afterwards.
+     *
+     * Only the grid nodes within `band` of the surface are kept, so the memory grows with the surface area
+     * instead of the volume.
+     *
+     * @param cell_size the edge length of the grid cells
+     * @param band the half width of the narrow band, should be at least `cell_size`
+     */
+    void build_sdf(Float cell_size, Float band);
+
+    /**
+     * @brief The sparse SDF grid is built.
+     */
+    [[nodiscard]] bool has_sdf() const noexcept;
+
+    /**
+     * @brief The (signed) distance at a point.
+     *
+     * If the sparse SDF grid is built and covers the point, the distance is trilinearly interpolated from
+     * the grid, which is exact up to O(cell_size^2) on a smooth surface. Otherwise the distance is queried
+     * exactly from the BVH.
+     */
+    [[nodiscard]] Float distance(const Vector3& point) const;
+
+    /**
+     * @brief The (signed) distances of a batch of points in parallel, see `distance()`.
+     */
+    void distance(span<const Vector3> points, span<Float> distances) const;
+
+  private:
+    class Impl;
+    U<Impl> m_impl;
+};
+}  // namespace uipc::geometry
@@ -0,0 +1,57 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/dllexport.h>
+#include <cmath>
+
+namespace uipc::geometry
+{
+/**
+ * @brief The exact sign of the orientation of the tetrahedron (A, B, C, D), i.e. the sign of `(B - A).cross(C - A).dot(D - A)`.
+ *
+ * The sign is decided by a floating point filter, and only the nearly degenerate cases fall back to the exact
+ * arithmetic, so the result is never affected by the rounding errors.
+ *
+ * @return 1, -1 or 0 if the four points are coplanar
+ */
+UIPC_GEOMETRY_API int orient3d(const Vector3& A, const Vector3& B, const Vector3& C, const Vector3& D);
+
+namespace detail
+{
+    /**
+     * @brief The relative error bound of the floating point orientation, see `orient3d_filter()`.
+     */
+    inline constexpr Float Orient3dErrorBound = (7.0 + 56.0 * 0x1p-53) * 0x1p-53;
+
+    /**
+     * @brief The floating point filter of `orient3d()`.
+     *
+     * Branch-free, so it can be evaluated for a block of tetrahedra in a vectorized loop.
+     *
+     * @return 1 or -1 if the sign is certain, 0 if the sign is uncertain, then `orient3d()` should be called
+     */
+    inline int orient3d_filter(const Vector3& A,
+                               const Vector3& B,
+                               const Vector3& C,
+                               const Vector3& D) noexcept
+    {
+        // the same expression as Shewchuk's orient3d, relative to D
+        Float adx = A[0] - D[0], ady = A[1] - D[1], adz = A[2] - D[2];
+        Float bdx = B[0] - D[0], bdy = B[1] - D[1], bdz = B[2] - D[2];
+        Float cdx = C[0] - D[0], cdy = C[1] - D[1], cdz = C[2] - D[2];
+
+        Float bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        Float cdxady = cdx * ady, adxcdy = adx * cdy;
+        Float adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        Float det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+
+        Float permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+                          + (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+                          + (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+
+        Float bound = Orient3dErrorBound * permanent;
+        // Shewchuk's orient3d(A, B, C, D) is positive if D is below ABC, which is the opposite of ours
+        return (det < -bound) - (det > bound);
+    }
+}  // namespace detail
+}  // namespace uipc::geometry
@@ -0,0 +1,130 @@
+#pragma once
+#include <uipc/core/scene.h>
+#include <uipc/common/exception.h>
+#include <optional>
+
+namespace uipc::core
+{
+/**
+ * @brief Publish the surface of a scene to a shared memory ring buffer, for the external viewers to monitor a running simulation.
+ *
+ * The surface is the one of `SceneIO::simplicial_surface()`. Its topology is written once,
+ * then each `publish()` writes the surface positions to the next slot of the ring.
+ * Publishing never waits for the readers, a slow reader skips the frames it missed.
+ *
+ * When the surface topology changes (e.g. geometries are created or destroyed), the streamer moves to a new segment
+ * with a new generation, the readers follow it automatically. See `FrameStreamReader`.
+ *
+ * ```cpp
+ * FrameStreamer streamer{scene, "uipc_frames"};
+ * while(world.frame() < 1000)
+ * {
+ *     world.advance();
+ *     world.retrieve();
+ *     streamer.publish(world.frame());
+ * }
+ * ```
+ */
+class UIPC_IO_API FrameStreamer
+{
+    class Impl;
+
+  public:
+    /**
+     * @brief The default config.
+     *
+     * - `slot_count`: the number of frames in the ring, a frame read by a reader stays valid until `slot_count - 1` newer frames are published
+     * - `dim`: the dimension of the surface, see `SceneIO::simplicial_surface()`
+     */
+    static Json default_config();
+
+    /**
+     * @param scene The scene to publish
+     * @param name The name of the stream, shared with the readers
+     * @throw FrameStreamError if the name is already in use, e.g. by another streamer
+     */
+    FrameStreamer(Scene& scene, std::string_view name, const Json& config = default_config());
+    ~FrameStreamer();
+
+    FrameStreamer(const FrameStreamer&)            = delete;
+    FrameStreamer& operator=(const FrameStreamer&) = delete;
+
+    /**
+     * @brief Publish the current surface positions of the scene as the frame `frame`.
+     */
+    void publish(SizeT frame);
+
+    /**
+     * @brief The generation of the surface topology, increased each time the topology changes.
+     */
+    U64 generation() const noexcept;
+
+    std::string_view name() const noexcept;
+
+  private:
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief Map the frames published by a `FrameStreamer`, without copying them.
+ */
+class UIPC_IO_API FrameStreamReader
+{
+    class Impl;
+
+  public:
+    class Segment;
+
+    /**
+     * @brief A frame in the shared memory.
+     *
+     * The views stay mapped as long as the frame is alive, but the writer may overwrite the positions
+     * once it wraps around the ring. Check `is_valid()` after using the positions.
+     */
+    class UIPC_IO_API Frame
+    {
+      public:
+        SizeT frame() const noexcept;
+        U64   generation() const noexcept;
+
+        span<const Vector3>  positions() const noexcept;
+        span<const Vector2i> edges() const noexcept;
+        span<const Vector3i> triangles() const noexcept;
+
+        /**
+         * @brief The positions are not overwritten by the writer (yet).
+         */
+        bool is_valid() const noexcept;
+
+      private:
+        friend class FrameStreamReader;
+        S<const Segment> m_segment;
+        SizeT            m_slot     = 0;
+        U64              m_sequence = 0;
+        SizeT            m_frame    = 0;
+    };
+
+    /**
+     * @param name The name of the stream, see `FrameStreamer`
+     */
+    explicit FrameStreamReader(std::string_view name);
+    ~FrameStreamReader();
+
+    FrameStreamReader(const FrameStreamReader&)            = delete;
+    FrameStreamReader& operator=(const FrameStreamReader&) = delete;
+
+    /**
+     * @brief The latest published frame, `std::nullopt` if no frame is published yet.
+     */
+    std::optional<Frame> latest();
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_IO_API FrameStreamError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::core
@@ -1,5 +1,6 @@
 #pragma once
 #include <uipc/core/scene.h>
+#include <uipc/core/scene_factory.h>
 #include <uipc/common/exception.h>
 #include <uipc/geometry/simplicial_complex.h>
 
@@ -37,9 +38,11 @@ class UIPC_IO_API SceneIO
      * - .bson
      * 
      * @param filename
+     * @param lazy Decode the geometries on first access, see `SceneFactory::lazy_from_file()`.
+     * Saving the scene copies the untouched geometries from the file.
      * @return 
      */
-    static Scene load(std::string_view filename);
+    static Scene load(std::string_view filename, bool lazy = false);
 
     /**
      * @brief Save the scene to a file.
@@ -50,8 +53,11 @@ class UIPC_IO_API SceneIO
      * 
      * @param scene
      * @param filename
+     * @param config The config of the SceneFactory, see `SceneFactory::default_config()`.
      */
-    static void save(const Scene& scene, std::string_view filename);
+    static void save(const Scene&     scene,
+                     std::string_view filename,
+                     const Json&      config = SceneFactory::default_config());
 
     /**
      * @brief Save the scene to a file.
@@ -61,8 +67,10 @@ class UIPC_IO_API SceneIO
      * - .bson
      * 
      * @param filename
+     * @param config The config of the SceneFactory, see `SceneFactory::default_config()`.
      */
-    void save(std::string_view filename) const;
+    void save(std::string_view filename,
+              const Json&      config = SceneFactory::default_config()) const;
 
     /**
      * @brief Commit the scene's update to a file.
@@ -126,13 +134,11 @@ class UIPC_IO_API SceneIO
     void update_from_json(const Json& json);
 
   private:
+    friend class FrameStreamer;
+
     Scene& m_scene;
     void   write_surface_obj(std::string_view filename);
-};
-
-class UIPC_IO_API SceneIOError : public Exception
-{
-  public:
-    using Exception::Exception;
+    // the geometries merged by `simplicial_surface()`
+    vector<const geometry::SimplicialComplex*> surface_inputs(IndexT dim) const;
 };
 }  // namespace uipc::core
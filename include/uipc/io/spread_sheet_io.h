@@ -1,5 +1,6 @@
 #pragma once
 #include <uipc/geometry/geometry.h>
+#include <uipc/common/exception.h>
 namespace uipc::geometry
 {
 /**
@@ -13,6 +14,8 @@ namespace uipc::geometry
  *  sio.write_csv("spreadsheet", mesh);
  *  // dump to json
  *  sio.write_json("spreadsheet", mesh);
+ *  // dump to arrow
+ *  sio.write_arrow("spreadsheet", mesh);
  * @endcode
  */
 class UIPC_IO_API SpreadSheetIO
@@ -23,8 +26,75 @@ class UIPC_IO_API SpreadSheetIO
     void write_json(const Geometry& geo) const;
     void write_csv(std::string_view geo_name, const Geometry& geo) const;
     void write_csv(const Geometry& geo) const;
+    /**
+     * @brief Write the geometry in columnar binary form (Arrow IPC streaming format).
+     * 
+     * One file `{output_folder}/{geo_name}/{collection}.arrows` is written for each attribute collection.
+     * @sa SpreadSheetStream
+     */
+    void write_arrow(std::string_view geo_name, const Geometry& geo) const;
+    void write_arrow(const Geometry& geo) const;
 
   private:
     string m_output_folder;
 };
+
+/**
+ * @brief Append geometry spreadsheets frame by frame, in columnar binary form (Arrow IPC streaming format).
+ * 
+ * Each attribute collection of the geometry goes to `{output_folder}/{geo_name}/{collection}.arrows`,
+ * and every `append()` adds one record batch to each file, with a leading `frame` column.
+ * Attribute values are written as they are stored, without any text formatting:
+ * - scalars map to int/uint/float columns
+ * - fixed-size vectors and matrices map to fixed-size-list columns (column-major for matrices)
+ * - dynamic vectors map to list columns, strings to utf8 columns
+ * 
+ * A whole run can then be loaded in one read, e.g. `pyarrow.ipc.open_stream(file).read_all()`
+ * or `polars.read_ipc_stream(file)`.
+ * 
+ * @code
+ *  SpreadSheetStream stream{"output/", "cloth"};
+ *  for(SizeT frame = 0; frame < 100; ++frame)
+ *  {
+ *      world.advance();
+ *      world.retrieve();
+ *      stream.append(cloth_mesh, frame);
+ *  }
+ *  stream.close();
+ * @endcode
+ * 
+ * @note The attributes (names and types) of a collection must not change between frames.
+ */
+class UIPC_IO_API SpreadSheetStream
+{
+  public:
+    SpreadSheetStream(std::string_view output_folder = "./",
+                      std::string_view geo_name      = "spreadsheet");
+    ~SpreadSheetStream();
+
+    SpreadSheetStream(const SpreadSheetStream&)            = delete;
+    SpreadSheetStream& operator=(const SpreadSheetStream&) = delete;
+
+    /**
+     * @brief Append one frame of the geometry.
+     * 
+     * @throw SpreadSheetIOError if the attributes of a collection differ from the previous frames.
+     */
+    void append(const Geometry& geo, SizeT frame);
+
+    /**
+     * @brief Finish all the streams, called automatically on destruction.
+     */
+    void close();
+
+  private:
+    class Impl;
+    U<Impl> m_impl;
+};
+
+class UIPC_IO_API SpreadSheetIOError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
 }  // namespace uipc::geometry
@@ -0,0 +1,99 @@
+#pragma once
+#include <uipc/core/scene.h>
+#include <uipc/core/object.h>
+#include <uipc/common/exception.h>
+
+namespace uipc::core
+{
+/**
+ * @brief A class for importing robots from URDF files into a scene.
+ *
+ * Each link, together with the links attached to it by fixed joints, becomes an affine body.
+ * Revolute and continuous joints become `AffineBodyRevoluteJoint`s, other joint types leave the links unconstrained.
+ *
+ * The link meshes and the parsed robots are cached in the UrdfIO: a mesh file is read once,
+ * and the geometries created from it share its attributes (copy-on-write).
+ * Importing many robots at once only costs one robot plus the transforms:
+ * the bodies without joints become one geometry with one instance per robot,
+ * the jointed bodies become one single-instance geometry per robot (required by the joints),
+ * all of them sharing the same mesh.
+ */
+class UIPC_IO_API UrdfIO
+{
+    class Impl;
+
+  public:
+    /**
+     * @brief The objects created for a robot.
+     */
+    class Robot
+    {
+      public:
+        string name;
+        /**
+         * @brief One object per body, named `<robot>/<root link of the body>`.
+         */
+        vector<S<Object>> links;
+        /**
+         * @brief The object holding the joints, named `<robot>/joints`, nullptr if the robot has no revolute joint.
+         */
+        S<Object> joints;
+    };
+
+    /**
+     * @param config The config, the missing keys take the values of `default_config()`
+     */
+    UrdfIO(Scene& scene, const Json& config = default_config());
+    ~UrdfIO();
+
+    UrdfIO(const UrdfIO&)            = delete;
+    UrdfIO& operator=(const UrdfIO&) = delete;
+
+    /**
+     * @brief The default config.
+     *
+     * - `kappa`, `mass_density`: the material of the affine bodies
+     * - `strength_ratio`: the strength ratio of the revolute joints
+     * - `joint_axis_length`: the length of the edges representing the joint axes
+     * - `use_collision`: build the bodies from the `<collision>` elements, otherwise from the `<visual>` elements
+     * - `fixed_base`: fix the root body of the robot, or the first body with a shape if the root link has none
+     * - `package_dirs`: the directories to search for `package://<package>/...` mesh files,
+     *   the parent directory of the URDF file is always searched
+     */
+    static Json default_config();
+
+    /**
+     * @brief Import a robot at its URDF frame.
+     *
+     * @param file_name The URDF file to read
+     */
+    Robot read(std::string_view file_name);
+
+    /**
+     * @brief Import one copy of a robot for each placement.
+     *
+     * @param file_name The URDF file to read
+     * @param placements The transforms of the robot frames
+     */
+    Robot read(std::string_view file_name, span<const Transform> placements);
+
+    /**
+     * @brief The number of mesh files read so far, each is read only once.
+     */
+    SizeT cached_mesh_count() const noexcept;
+
+    /**
+     * @brief Drop the cached meshes and robots, the next read reads the files again.
+     */
+    void clear_cache() noexcept;
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_IO_API UrdfIOError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::core
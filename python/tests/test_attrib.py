@@ -24,4 +24,29 @@ def test_attrib():
     print("name_attr:\n", name_attr.view())
 
     sc.instances().resize(10)
-    print("name_attr:\n", name_attr.view())
\ No newline at end of file
+    print("name_attr:\n", name_attr.view())
+
+@pytest.mark.basic
+def test_attrib_create_many():
+    Vs = np.random.rand(1000, 3)
+    Ts = np.array([[0,1,2,3]], dtype=np.int32)
+
+    sc = tetmesh(Vs, Ts)
+    assert np.allclose(sc.positions().view().reshape(-1, 3), Vs)
+
+    N = sc.vertices().size()
+    velocity, mass, ids = sc.vertices().create_many({
+        "velocity": np.ones((N, 3)),
+        "mass": np.full(N, 2.0),
+        "id": np.arange(N, dtype=np.int32)})
+
+    assert np.allclose(velocity.view().reshape(-1, 3), 1.0)
+    assert np.allclose(mass.view(), 2.0)
+    assert np.array_equal(ids.view(), np.arange(N))
+
+    # nothing is created if any of the values is invalid
+    with pytest.raises(Exception):
+        sc.vertices().create_many({
+            "a": np.zeros(N),
+            "b": np.zeros(N + 1)})
+    assert sc.vertices().find("a") is None
@@ -57,6 +57,11 @@ Json ISimSystem::to_json() const
     return do_to_json();
 }
 
+SizeT ISimSystem::memory_usage() const noexcept
+{
+    return get_memory_usage();
+}
+
 bool ISimSystem::dump(DumpInfo& info)
 {
     return do_dump(info);
@@ -91,6 +96,11 @@ void ISimSystem::do_apply_recover(RecoverInfo&) {}
 
 void ISimSystem::do_clear_recover(RecoverInfo&) {}
 
+SizeT ISimSystem::get_memory_usage() const noexcept
+{
+    return 0;
+}
+
 ISimSystem::BaseInfo::BaseInfo(SizeT frame, std::string_view workspace, const Json& config) noexcept
     : m_frame(frame)
     , m_config(config)
@@ -19,6 +19,11 @@ class ISimSystem
     span<ISimSystem* const> weak_dependencies() const noexcept;
     Json                    to_json() const;
 
+    /**
+     * @brief Get the bytes of memory held by this system, used in the memory report of the engine.
+     */
+    SizeT memory_usage() const noexcept;
+
     class BaseInfo
     {
       public:
@@ -84,6 +89,7 @@ class ISimSystem
     virtual bool             do_try_recover(RecoverInfo&);
     virtual void             do_apply_recover(RecoverInfo&);
     virtual void             do_clear_recover(RecoverInfo&);
+    virtual SizeT            get_memory_usage() const noexcept;
 
   private:
     friend class SimEngine;
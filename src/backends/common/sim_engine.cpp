@@ -21,6 +21,23 @@ Json SimEngine::do_to_json() const
     return j;
 }
 
+Json SimEngine::do_memory_report() const
+{
+    Json  j           = Json::object();
+    auto& systems     = j["systems"] = Json::object();
+    SizeT total_bytes = 0;
+    for(auto system : m_system_collection.systems())
+    {
+        if(!system->is_valid())
+            continue;
+        SizeT bytes = system->memory_usage();
+        systems[std::string{system->name()}] = bytes;
+        total_bytes += bytes;
+    }
+    j["total_bytes"] = total_bytes;
+    return j;
+}
+
 WorldVisitor& SimEngine::world() noexcept
 {
     UIPC_ASSERT(m_world_visitor, "WorldVisitor is not initialized.");
@@ -24,6 +24,13 @@ class SimEngine : public core::IEngine
   protected:
     virtual Json do_to_json() const override;
 
+    /**
+     * @brief Report the memory held by each SimSystem.
+     * 
+     * @sa ISimSystem::memory_usage()
+     */
+    virtual Json do_memory_report() const override;
+
     /**
      * @brief Build the SimSystems in the engine.
      * 
@@ -0,0 +1,88 @@
+#include <diff_sim/diff_dof_reporter.h>
+#include <affine_body/affine_body_dynamics.h>
+#include <affine_body/abd_jacobi_matrix.h>
+#include <utils/matrix_unpacker.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Report the coupling of the current frame to the previous frames through the inertia
+ *
+ * The same as the FEM, with the 12x12 mass matrix of each affine body:
+ * $-2M$, $M$ for the dynamic bodies, $-M$, $0$ for the static bodies, and $0$ for the fixed bodies.
+ */
+class ABDKineticDiffDofReporter final : public DiffDofReporter
+{
+  public:
+    using DiffDofReporter::DiffDofReporter;
+
+    AffineBodyDynamics* affine_body_dynamics = nullptr;
+
+    // the window holds the frames i-1, i-2 the inertia reaches
+    static SizeT coupled_frame_count(SizeT frame, SizeT first_frame)
+    {
+        return frame - first_frame;
+    }
+
+    virtual void do_build(BuildInfo& info) override
+    {
+        affine_body_dynamics = &require<AffineBodyDynamics>();
+    }
+
+    virtual void do_report_extent(GlobalDiffSimManager::DiffDofExtentInfo& info) override
+    {
+        auto body_count = affine_body_dynamics->body_masses().size();
+        // a 12x12 block per body per coupled frame
+        info.triplet_count(body_count * 12 * 12
+                           * coupled_frame_count(info.frame(), info.first_frame()));
+    }
+
+    virtual void do_assemble(GlobalDiffSimManager::DiffDofInfo& info) override
+    {
+        using namespace muda;
+
+        auto frame      = info.frame();
+        auto body_count = affine_body_dynamics->body_masses().size();
+        auto H          = info.H();
+
+        for(SizeT k = 1; k <= coupled_frame_count(frame, info.first_frame()); ++k)
+        {
+            // Frame Dof Offset + ABD Dof Offset => Frame ABD Dof Offset
+            IndexT row_offset =
+                info.dof_offset(frame) + affine_body_dynamics->dof_offset(frame);
+            IndexT col_offset =
+                info.dof_offset(frame - k) + affine_body_dynamics->dof_offset(frame - k);
+            auto pGpX = H.subview((k - 1) * body_count * 12 * 12, body_count * 12 * 12);
+
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(body_count,
+                       [is_fixed   = affine_body_dynamics->body_is_fixed().cviewer().name("is_fixed"),
+                        is_dynamic = affine_body_dynamics->body_is_dynamic().cviewer().name("is_dynamic"),
+                        masses = affine_body_dynamics->body_masses().cviewer().name("masses"),
+                        pGpX       = pGpX.viewer().name("pGpX"),
+                        row_offset = row_offset,
+                        col_offset = col_offset,
+                        k          = k] __device__(int i) mutable
+                       {
+                           Float c = 0.0;
+                           if(!is_fixed(i))
+                           {
+                               if(is_dynamic(i))
+                                   c = k == 1 ? -2.0 : 1.0;
+                               else  // static: q_tilde doesn't depend on the velocity
+                                   c = k == 1 ? -1.0 : 0.0;
+                           }
+
+                           Matrix12x12 M = c * masses(i).to_mat();
+
+                           TripletMatrixUnpacker unpacker{pGpX};
+                           unpacker.block<12, 12>(i * 12 * 12).write(
+                               row_offset + i * 12, col_offset + i * 12, M);
+                       });
+        }
+    }
+};
+
+REGISTER_SIM_SYSTEM(ABDKineticDiffDofReporter);
+}  // namespace uipc::backend::cuda
@@ -12,6 +12,7 @@ REGISTER_SIM_SYSTEM(ABDLineSearchReporter);
 void ABDLineSearchReporter::do_build(LineSearchReporter::BuildInfo& info)
 {
     m_impl.affine_body_dynamics = require<AffineBodyDynamics>();
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 }
 
 void ABDLineSearchReporter::Impl::init(LineSearchReporter::InitInfo& info)
@@ -84,9 +85,8 @@ void ABDLineSearchReporter::Impl::compute_energy(LineSearcher::EnergyInfo& info)
                });
 
     // Sum up the kinetic energy
-    DeviceReduce().Sum(abd().body_id_to_kinetic_energy.data(),
-                       abd().abd_kinetic_energy.data(),
-                       abd().body_id_to_kinetic_energy.size());
+    energy_sum.sum(std::as_const(abd().body_id_to_kinetic_energy).view(),
+                   abd().abd_kinetic_energy.view());
 
     // Distribute the computation of shape energy to each constitution
     for(auto&& [i, cst] : enumerate(abd().constitutions.view()))
@@ -96,9 +96,8 @@ void ABDLineSearchReporter::Impl::compute_energy(LineSearcher::EnergyInfo& info)
     }
 
     // Sum up the shape energy
-    DeviceReduce().Sum(abd().body_id_to_shape_energy.data(),
-                       abd().abd_shape_energy.data(),
-                       abd().body_id_to_shape_energy.size());
+    energy_sum.sum(std::as_const(abd().body_id_to_shape_energy).view(),
+                   abd().abd_shape_energy.view());
 
     // Collect the energy from all reporters
     auto         reporter_view = reporters.view();
@@ -121,9 +120,7 @@ void ABDLineSearchReporter::Impl::compute_energy(LineSearcher::EnergyInfo& info)
     }
 
     // Compute the total energy from all reporters
-    DeviceReduce().Sum(reporter_energies.data(),
-                       total_reporter_energy.data(),
-                       reporter_energies.size());
+    energy_sum.sum(std::as_const(reporter_energies).view(), total_reporter_energy.view());
 
     // Copy from device to host
     Float K       = abd().abd_kinetic_energy;
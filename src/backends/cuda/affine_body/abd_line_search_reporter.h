@@ -3,6 +3,7 @@
 #include <line_search/line_search_reporter.h>
 #include <affine_body/affine_body_dynamics.h>
 #include <utils/offset_count_collection.h>
+#include <algorithm/device_sum.h>
 
 namespace uipc::backend::cuda
 {
@@ -46,6 +47,7 @@ class ABDLineSearchReporter final : public LineSearchReporter
         OffsetCountCollection<IndexT> reporter_energy_offsets_counts;
         muda::DeviceBuffer<Float>     reporter_energies;
         muda::DeviceVar<Float>        total_reporter_energy;
+        DeviceSum                     energy_sum;
 
         AffineBodyDynamics::Impl& abd() const
         {
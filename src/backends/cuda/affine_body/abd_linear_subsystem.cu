@@ -7,6 +7,7 @@
 #include <uipc/builtin/attribute_name.h>
 #include <affine_body/inter_affine_body_constitution_manager.h>
 #include <affine_body/abd_linear_subsystem_reporter.h>
+#include <utils/memory_usage.h>
 
 namespace uipc::backend::cuda
 {
@@ -16,6 +17,8 @@ void ABDLinearSubsystem::do_build(DiagLinearSubsystem::BuildInfo& info)
 {
     m_impl.affine_body_dynamics        = require<AffineBodyDynamics>();
     m_impl.affine_body_vertex_reporter = require<AffineBodyVertexReporter>();
+    m_impl.sim_engine                  = &engine();
+    m_impl.deterministic = world().scene().info()["deterministic"]["enable"].get<bool>();
 
     auto contact = find<ABDContactReceiver>();
     if(contact)
@@ -128,6 +131,10 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
 {
     using namespace muda;
 
+    // 0) record dof info
+    auto frame = sim_engine->frame();
+    abd().set_dof_info(frame, info.gradient().offset(), info.gradient().size());
+
     // 1) Kinetic & Shape
     IndexT offset = 0;
     {
@@ -180,7 +187,47 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
             contact_gradient_count = contact().contact_gradient.doublet_count();
         }
 
-        if(contact_gradient_count)
+        if(contact_gradient_count && deterministic)
+        {
+            // every body sums up the gradients of its vertices in a fixed order
+            body_keys.resize(contact_gradient_count);
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(contact_gradient_count,
+                       [contact_gradient = contact().contact_gradient.cviewer().name("contact_gradient"),
+                        body_keys = body_keys.viewer().name("body_keys"),
+                        v2b       = abd().vertex_id_to_body_id.cviewer().name("v2b"),
+                        is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
+                        vertex_offset = vertex_offset,
+                        body_count = static_cast<IndexT>(abd().body_count())] __device__(int I) mutable
+                       {
+                           const auto& [g_i, G3] = contact_gradient(I);
+                           auto body_i           = v2b(g_i - vertex_offset);
+                           body_keys(I) = is_fixed(body_i) ? body_count : body_i;
+                       });
+
+            body_grouper.group(body_keys.view(), abd().body_count());
+
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(abd().body_count(),
+                       [contact_gradient = contact().contact_gradient.cviewer().name("contact_gradient"),
+                        gradient = info.gradient().viewer().name("gradient"),
+                        Js       = abd().vertex_id_to_J.cviewer().name("Js"),
+                        offsets  = body_grouper.offsets().cviewer().name("offsets"),
+                        items    = body_grouper.items().cviewer().name("items"),
+                        vertex_offset = vertex_offset] __device__(int body_i) mutable
+                       {
+                           Vector12 G12 = Vector12::Zero();
+                           for(IndexT k = offsets(body_i); k < offsets(body_i + 1); ++k)
+                           {
+                               const auto& [g_i, G3] = contact_gradient(items(k));
+                               G12 += Js(g_i - vertex_offset).T() * G3;
+                           }
+                           gradient.segment<12>(body_i * 12).as_eigen() += G12;
+                       });
+        }
+        else if(contact_gradient_count)
         {
             ParallelFor()
                 .file_line(__FILE__, __LINE__)
@@ -230,7 +277,8 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
                         Js  = abd().vertex_id_to_J.cviewer().name("Js"),
                         is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
                         diag_hessian = abd().diag_hessian.viewer().name("diag_hessian"),
-                        vertex_offset = vertex_offset] __device__(int I) mutable
+                        vertex_offset = vertex_offset,
+                        deterministic = deterministic] __device__(int I) mutable
                        {
                            const auto& [g_i, g_j, H3x3] = contact_hessian(I);
 
@@ -254,7 +302,7 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
 
                                // Fill diagonal hessian for diag-inv preconditioner
                                // TODO: Maybe later we can move it to a separate kernel for readability
-                               if(body_i == body_j)
+                               if(body_i == body_j && !deterministic)
                                {
                                    eigen::atomic_add(diag_hessian(body_i), H12x12);
                                }
@@ -266,6 +314,54 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
                                       body_j * 4,  // begin col
                                       H12x12);
                        });
+
+            if(deterministic)
+            {
+                // every body sums up its diagonal hessians in a fixed order
+                body_keys.resize(contact_hessian_count);
+                ParallelFor()
+                    .file_line(__FILE__, __LINE__)
+                    .apply(contact_hessian_count,
+                           [contact_hessian = contact().contact_hessian.cviewer().name("contact_hessian"),
+                            body_keys = body_keys.viewer().name("body_keys"),
+                            v2b       = abd().vertex_id_to_body_id.cviewer().name("v2b"),
+                            is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
+                            vertex_offset = vertex_offset,
+                            body_count = static_cast<IndexT>(abd().body_count())] __device__(int I) mutable
+                           {
+                               const auto& [g_i, g_j, H3x3] = contact_hessian(I);
+
+                               auto body_i = v2b(g_i - vertex_offset);
+                               auto body_j = v2b(g_j - vertex_offset);
+
+                               bool is_diag = body_i == body_j && !is_fixed(body_i);
+                               body_keys(I) = is_diag ? body_i : body_count;
+                           });
+
+                body_grouper.group(body_keys.view(), abd().body_count());
+
+                ParallelFor()
+                    .file_line(__FILE__, __LINE__)
+                    .apply(abd().body_count(),
+                           [contact_hessian = contact().contact_hessian.cviewer().name("contact_hessian"),
+                            diag_hessian = abd().diag_hessian.viewer().name("diag_hessian"),
+                            Js      = abd().vertex_id_to_J.cviewer().name("Js"),
+                            offsets = body_grouper.offsets().cviewer().name("offsets"),
+                            items   = body_grouper.items().cviewer().name("items"),
+                            vertex_offset = vertex_offset] __device__(int body_i) mutable
+                           {
+                               Matrix12x12 H = Matrix12x12::Zero();
+                               for(IndexT k = offsets(body_i); k < offsets(body_i + 1); ++k)
+                               {
+                                   const auto& [g_i, g_j, H3x3] = contact_hessian(items(k));
+
+                                   auto& J_i = Js(g_i - vertex_offset);
+                                   auto& J_j = Js(g_j - vertex_offset);
+                                   H += ABDJacobi::JT_H_J(J_i.T(), H3x3, J_j);
+                               }
+                               diag_hessian(body_i) += H;
+                           });
+            }
         }
 
         offset += H3x3_count;
@@ -281,7 +377,42 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
             R->assemble(info);
         }
 
-        if(reporter_gradients.doublet_count())
+        if(reporter_gradients.doublet_count() && deterministic)
+        {
+            // every body sums up its gradients in a fixed order
+            body_keys.resize(reporter_gradients.doublet_count());
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(reporter_gradients.doublet_count(),
+                       [src       = reporter_gradients.cviewer().name("src_gradient"),
+                        body_keys = body_keys.viewer().name("body_keys"),
+                        is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
+                        body_count = static_cast<IndexT>(abd().body_count())] __device__(int I) mutable
+                       {
+                           auto&& [body_i, G12] = src(I);
+                           body_keys(I) = is_fixed(body_i) ? body_count : body_i;
+                       });
+
+            body_grouper.group(body_keys.view(), abd().body_count());
+
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(abd().body_count(),
+                       [dst     = info.gradient().viewer().name("dst_gradient"),
+                        src     = reporter_gradients.cviewer().name("src_gradient"),
+                        offsets = body_grouper.offsets().cviewer().name("offsets"),
+                        items = body_grouper.items().cviewer().name("items")] __device__(int body_i) mutable
+                       {
+                           Vector12 G = Vector12::Zero();
+                           for(IndexT k = offsets(body_i); k < offsets(body_i + 1); ++k)
+                           {
+                               auto&& [body, G12] = src(items(k));
+                               G += G12;
+                           }
+                           dst.segment<12>(body_i * 12).as_eigen() += G;
+                       });
+        }
+        else if(reporter_gradients.doublet_count())
         {
             ParallelFor()
                 .file_line(__FILE__, __LINE__)
@@ -315,8 +446,8 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
                        [dst = H3x3s.viewer().name("dst_hessian"),
                         src = reporter_hessians.cviewer().name("src_hessian"),
                         diag_hessian = abd().diag_hessian.viewer().name("diag_hessian"),
-                        is_fixed = abd().body_id_to_is_fixed.cviewer().name(
-                            "is_fixed")] __device__(int I) mutable
+                        is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
+                        deterministic = deterministic] __device__(int I) mutable
                        {
                            TripletMatrixUnpacker MU{dst};
                            Matrix12x12           Value;
@@ -336,11 +467,49 @@ void ABDLinearSubsystem::Impl::assemble(GlobalLinearSystem::DiagInfo& info)
                                       Value);
 
                            // Fill diagonal hessian for diag-inv preconditioner
-                           if(body_i == body_j && !has_fixed)
+                           if(body_i == body_j && !has_fixed && !deterministic)
                            {
                                eigen::atomic_add(diag_hessian(body_i), H12x12);
                            }
                        });
+
+            if(deterministic)
+            {
+                // every body sums up its diagonal hessians in a fixed order
+                body_keys.resize(reporter_hessians.triplet_count());
+                ParallelFor()
+                    .file_line(__FILE__, __LINE__)
+                    .apply(reporter_hessians.triplet_count(),
+                           [src       = reporter_hessians.cviewer().name("src_hessian"),
+                            body_keys = body_keys.viewer().name("body_keys"),
+                            is_fixed = abd().body_id_to_is_fixed.cviewer().name("is_fixed"),
+                            body_count = static_cast<IndexT>(abd().body_count())] __device__(int I) mutable
+                           {
+                               auto&& [body_i, body_j, H12x12] = src(I);
+
+                               bool is_diag = body_i == body_j && !is_fixed(body_i);
+                               body_keys(I) = is_diag ? body_i : body_count;
+                           });
+
+                body_grouper.group(body_keys.view(), abd().body_count());
+
+                ParallelFor()
+                    .file_line(__FILE__, __LINE__)
+                    .apply(abd().body_count(),
+                           [src = reporter_hessians.cviewer().name("src_hessian"),
+                            diag_hessian = abd().diag_hessian.viewer().name("diag_hessian"),
+                            offsets = body_grouper.offsets().cviewer().name("offsets"),
+                            items = body_grouper.items().cviewer().name("items")] __device__(int body_i) mutable
+                           {
+                               Matrix12x12 H = Matrix12x12::Zero();
+                               for(IndexT k = offsets(body_i); k < offsets(body_i + 1); ++k)
+                               {
+                                   auto&& [row, col, H12x12] = src(items(k));
+                                   H += H12x12;
+                               }
+                               diag_hessian(body_i) += H;
+                           });
+            }
         }
     }
 }
@@ -395,6 +564,12 @@ void ABDLinearSubsystem::do_retrieve_solution(GlobalLinearSystem::SolutionInfo&
     m_impl.retrieve_solution(info);
 }
 
+SizeT ABDLinearSubsystem::get_memory_usage() const noexcept
+{
+    return memory_usage(m_impl.reporter_hessians) + memory_usage(m_impl.reporter_gradients)
+           + memory_usage(m_impl.body_keys);
+}
+
 void ABDLinearSubsystem::add_reporter(ABDLinearSubsystemReporter* reporter)
 {
     UIPC_ASSERT(reporter, "reporter cannot be null");
@@ -5,6 +5,7 @@
 #include <affine_body/affine_body_vertex_reporter.h>
 #include <affine_body/matrix_converter.h>
 #include <utils/offset_count_collection.h>
+#include <algorithm/key_grouper.h>
 
 namespace uipc::backend::cuda
 {
@@ -57,6 +58,8 @@ class ABDLinearSubsystem final : public DiagLinearSubsystem
         void accuracy_check(GlobalLinearSystem::AccuracyInfo& info);
         void retrieve_solution(GlobalLinearSystem::SolutionInfo& info);
 
+        SimEngine* sim_engine = nullptr;
+
         SimSystemSlot<AffineBodyDynamics>       affine_body_dynamics;
         AffineBodyDynamics::Impl&               abd() const noexcept;
         SimSystemSlot<ABDContactReceiver>       abd_contact_receiver;
@@ -64,6 +67,7 @@ class ABDLinearSubsystem final : public DiagLinearSubsystem
         SimSystemSlot<AffineBodyVertexReporter> affine_body_vertex_reporter;
 
         Float reserve_ratio = 1.5;
+        bool  deterministic = false;
 
         SimSystemSlotCollection<ABDLinearSubsystemReporter> reporters;
         OffsetCountCollection<IndexT> reporter_gradient_offsets_counts;
@@ -71,6 +75,10 @@ class ABDLinearSubsystem final : public DiagLinearSubsystem
 
         muda::DeviceTripletMatrix<Float, 12, 12> reporter_hessians;
         muda::DeviceDoubletVector<Float, 12>     reporter_gradients;
+
+        // the gradients and the diagonal hessians grouped by bodies, only used in the deterministic mode
+        muda::DeviceBuffer<IndexT> body_keys;
+        KeyGrouper                 body_grouper;
     };
 
   private:
@@ -85,6 +93,8 @@ class ABDLinearSubsystem final : public DiagLinearSubsystem
     virtual void do_accuracy_check(GlobalLinearSystem::AccuracyInfo& info) override;
     virtual void do_retrieve_solution(GlobalLinearSystem::SolutionInfo& info) override;
 
+    virtual SizeT get_memory_usage() const noexcept override;
+
     friend class ABDLinearSubsystemReporter;
     void add_reporter(ABDLinearSubsystemReporter* reporter);  // only be called by ABDLinearSubsystemReporter
 
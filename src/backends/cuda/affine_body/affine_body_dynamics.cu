@@ -23,6 +23,7 @@
 #include <uipc/builtin/attribute_name.h>
 
 #include <utils/offset_count_collection.h>
+#include <utils/memory_usage.h>
 
 namespace uipc::backend
 {
@@ -86,6 +87,23 @@ void AffineBodyDynamics::do_clear_recover(RecoverInfo& info)
     m_impl.clear_recover(info);
 }
 
+SizeT AffineBodyDynamics::get_memory_usage() const noexcept
+{
+    const auto& i = m_impl;
+    return memory_usage(i.vertex_id_to_J) + memory_usage(i.vertex_id_to_body_id)
+           + memory_usage(i.body_id_to_dim) + memory_usage(i.body_id_to_abd_mass)
+           + memory_usage(i.body_id_to_abd_mass_inv) + memory_usage(i.body_id_to_volume)
+           + memory_usage(i.body_id_to_q) + memory_usage(i.body_id_to_q_temp)
+           + memory_usage(i.body_id_to_q_tilde) + memory_usage(i.body_id_to_q_prev)
+           + memory_usage(i.body_id_to_q_v) + memory_usage(i.body_id_to_dq)
+           + memory_usage(i.body_id_to_abd_force) + memory_usage(i.body_id_to_abd_gravity)
+           + memory_usage(i.body_id_to_is_fixed) + memory_usage(i.body_id_to_is_dynamic)
+           + memory_usage(i.body_id_to_kinetic_energy)
+           + memory_usage(i.body_id_to_shape_energy)
+           + memory_usage(i.body_id_to_body_hessian)
+           + memory_usage(i.body_id_to_body_gradient) + memory_usage(i.diag_hessian);
+}
+
 IndexT AffineBodyDynamics::dof_offset(SizeT frame) const
 {
     return m_impl.dof_offset(frame);
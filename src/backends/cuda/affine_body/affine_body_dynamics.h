@@ -177,6 +177,8 @@ class AffineBodyDynamics : public SimSystem
     virtual void do_apply_recover(RecoverInfo& info) override;
     virtual void do_clear_recover(RecoverInfo& info) override;
 
+    virtual SizeT get_memory_usage() const noexcept override;
+
   public:
     class Impl
     {
@@ -1,5 +1,7 @@
 #include <cub/warp/warp_reduce.cuh>
 #include <muda/ext/eigen/atomic.h>
+#include <muda/buffer/device_buffer.h>
+#include <utility>
 namespace muda
 {
 //constexpr int BlockSize = 128;
@@ -37,6 +39,9 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
 
     BufferLaunch(this->stream()).fill<Matrix>(out, Matrix::Zero().eval());
 
+    // the partial results of the cross-warp segments, only used in the deterministic mode
+    DeviceBuffer<Matrix> partials(m_deterministic ? size : 0);
+
     int block_count = (size + block_dim - 1) / block_dim;
     Launch(block_count, block_dim)
         .kernel_name("segmental_reduce")
@@ -44,7 +49,9 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
             [in     = in.cviewer().name("in"),
              out    = out.viewer().name("out"),
              offset = offset.cviewer().name("offset"),
-             op] __device__() mutable
+             op,
+             deterministic = m_deterministic,
+             partials      = partials.viewer().name("partials")] __device__() mutable
             {
                 using WarpReduceInt = cub::WarpReduce<int, warp_size>;
                 using WarpReduceT   = cub::WarpReduce<T, warp_size>;
@@ -124,8 +131,15 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
                 {
                     if(flags.is_cross_warp)
                     {
-                        auto& out_value = out(i);
-                        eigen::atomic_add(out_value, value);
+                        if(deterministic)
+                        {
+                            partials(global_thread_id) = value;
+                        }
+                        else
+                        {
+                            auto& out_value = out(i);
+                            eigen::atomic_add(out_value, value);
+                        }
                     }
                     else
                     {
@@ -133,6 +147,9 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
                     }
                 }
             });
+
+    if(m_deterministic)
+        combine_cross_warp<Matrix>(offset, std::as_const(partials).view(), out);
 }
 template <int BlockSize, int WarpSize>
 template <typename T, typename ReduceOp>
@@ -155,6 +172,9 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
 
     BufferLaunch(this->stream()).fill<ValueT>(out, ValueT{0});
 
+    // the partial results of the cross-warp segments, only used in the deterministic mode
+    DeviceBuffer<ValueT> partials(m_deterministic ? size : 0);
+
     int block_count = (size + block_dim - 1) / block_dim;
     Launch(block_count, block_dim)
         .kernel_name("segmental_reduce")
@@ -162,7 +182,9 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
             [in     = in.cviewer().name("in"),
              out    = out.viewer().name("out"),
              offset = offset.cviewer().name("offset"),
-             op     = op] __device__() mutable
+             op     = op,
+             deterministic = m_deterministic,
+             partials      = partials.viewer().name("partials")] __device__() mutable
             {
                 using WarpReduceInt = cub::WarpReduce<int, warp_size>;
                 using WarpReduceT   = cub::WarpReduce<T, warp_size>;
@@ -198,6 +220,7 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
 
                 if(global_thread_id < in.total_size())
                 {
+                    i              = offset(global_thread_id);
                     value          = in(global_thread_id);
                     flags.is_valid = 1;
                 }
@@ -235,8 +258,15 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
                 {
                     if(flags.is_cross_warp)
                     {
-                        auto& out_value = out(i);
-                        atomic_add(&out_value, value);
+                        if(deterministic)
+                        {
+                            partials(global_thread_id) = value;
+                        }
+                        else
+                        {
+                            auto& out_value = out(i);
+                            atomic_add(&out_value, value);
+                        }
                     }
                     else
                     {
@@ -244,5 +274,45 @@ void FastSegmentalReduce<BlockSize, WarpSize>::reduce(CBufferView<int> offset,
                     }
                 }
             });
+
+    if(m_deterministic)
+        combine_cross_warp<ValueT>(offset, std::as_const(partials).view(), out);
+}
+
+template <int BlockSize, int WarpSize>
+template <typename T>
+void FastSegmentalReduce<BlockSize, WarpSize>::combine_cross_warp(CBufferView<int> offset,
+                                                                  CBufferView<T> partials,
+                                                                  BufferView<T> out)
+{
+    constexpr int warp_size = WarpSize;
+
+    ParallelFor(0, this->stream())
+        .kernel_name("segmental_reduce_combine")
+        .apply(partials.size(),
+               [offset   = offset.cviewer().name("offset"),
+                partials = partials.cviewer().name("partials"),
+                out      = out.viewer().name("out")] __device__(int g) mutable
+               {
+                   int N = partials.total_size();
+                   int i = offset(g);
+
+                   // only the head of a segment
+                   if(g > 0 && offset(g - 1) == i)
+                       return;
+
+                   // the first element of the next warp
+                   int w = (g / warp_size + 1) * warp_size;
+
+                   // the segment lies in one warp, it's written by the reduction
+                   if(w >= N || offset(w) != i)
+                       return;
+
+                   // the head's partial, then the partial of each following warp (left by its lane 0)
+                   T sum = partials(g);
+                   for(; w < N && offset(w) == i; w += warp_size)
+                       sum += partials(w);
+                   out(i) = sum;
+               });
 }
 }  // namespace muda
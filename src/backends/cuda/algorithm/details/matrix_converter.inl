@@ -254,6 +254,7 @@ void MatrixConverter<T, N>::_make_unique_block_warp_reduction(
     auto blocks = to.values();
 
     FastSegmentalReduce<>()
+        .deterministic(m_deterministic)
         .file_line(__FILE__, __LINE__)
         .reduce(std::as_const(sorted_partition_output).view(),
                 std::as_const(blocks_sorted).view(),
@@ -430,6 +431,7 @@ void MatrixConverter<T, N>::_make_unique_segment_warp_reduction(
     auto segments = to.values();
 
     FastSegmentalReduce<64, 32>()
+        .deterministic(m_deterministic)
         .file_line(__FILE__, __LINE__)
         .reduce(std::as_const(sorted_partition_output).view(),
                 std::as_const(segments_sorted).view(),
@@ -0,0 +1,72 @@
+#include <algorithm/device_sum.h>
+#include <muda/launch.h>
+#include <muda/cub/device/device_reduce.h>
+#include <cub/block/block_reduce.cuh>
+#include <algorithm>
+#include <utility>
+
+namespace uipc::backend::cuda
+{
+constexpr int DeviceSumBlockDim       = 256;
+constexpr int DeviceSumItemsPerThread = 4;
+constexpr int DeviceSumTileSize = DeviceSumBlockDim * DeviceSumItemsPerThread;
+
+void DeviceSum::sum(muda::CBufferView<Float> in, muda::VarView<Float> out, cudaStream_t s)
+{
+    using namespace muda;
+
+    if(!m_deterministic)
+    {
+        DeviceReduce(s).Sum(in.data(), out.data(), in.size());
+        return;
+    }
+
+    // every block sums up a tile to a partial, the partials are summed up again until one is left,
+    // the tile size and the block reduction are fixed, so is the order of the additions
+    CBufferView<Float> src  = in;
+    int                pass = 0;
+    int                tiles;
+    do
+    {
+        int N = src.size();
+        tiles = std::max((N + DeviceSumTileSize - 1) / DeviceSumTileSize, 1);
+
+        Float* dst = out.data();
+        if(tiles > 1)
+        {
+            auto& partials = m_partials[pass % 2];
+            if(partials.size() < static_cast<SizeT>(tiles))
+                partials.resize(tiles);
+            dst = partials.data();
+        }
+
+        Launch(tiles, DeviceSumBlockDim, 0, s)
+            .file_line(__FILE__, __LINE__)
+            .apply(
+                [in = src.cviewer().name("in"), dst] __device__() mutable
+                {
+                    using BlockReduce =
+                        cub::BlockReduce<Float, DeviceSumBlockDim, cub::BLOCK_REDUCE_WARP_REDUCTIONS>;
+                    __shared__ typename BlockReduce::TempStorage storage;
+
+                    int   N     = in.total_size();
+                    int   begin = blockIdx.x * DeviceSumTileSize + threadIdx.x;
+                    Float value = 0.0;
+                    for(int k = 0; k < DeviceSumItemsPerThread; ++k)
+                    {
+                        int I = begin + k * DeviceSumBlockDim;
+                        if(I < N)
+                            value += in(I);
+                    }
+
+                    Float sum = BlockReduce(storage).Sum(value);
+                    if(threadIdx.x == 0)
+                        dst[blockIdx.x] = sum;
+                });
+
+        if(tiles > 1)
+            src = std::as_const(m_partials[pass % 2]).view(0, tiles);
+        ++pass;
+    } while(tiles > 1);
+}
+}  // namespace uipc::backend::cuda
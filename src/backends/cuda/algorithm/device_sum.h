@@ -0,0 +1,28 @@
+#pragma once
+#include <type_define.h>
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/var_view.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Sum up a device buffer of Float.
+ *
+ * By default it calls `cub::DeviceReduce::Sum`, whose tiling is tuned for the device, so the rounding
+ * may differ between GPUs. In the deterministic mode the buffer is summed in fixed tiles and a fixed
+ * order, so the result only depends on the input.
+ */
+class DeviceSum
+{
+  public:
+    void deterministic(bool enable) noexcept { m_deterministic = enable; }
+    bool deterministic() const noexcept { return m_deterministic; }
+
+    // out = sum(in), out = 0 if in is empty
+    void sum(muda::CBufferView<Float> in, muda::VarView<Float> out, cudaStream_t s = nullptr);
+
+  private:
+    bool                      m_deterministic = false;
+    muda::DeviceBuffer<Float> m_partials[2];
+};
+}  // namespace uipc::backend::cuda
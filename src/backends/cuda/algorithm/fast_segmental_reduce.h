@@ -36,6 +36,14 @@ class FastSegmentalReduce : public LaunchBase<FastSegmentalReduce<BlockSize, War
     {
     }
 
+    // if enabled, the partial results of a segment spanning several warps are added up in the warp order
+    // instead of by atomics, so the result is bitwise reproducible, at the cost of a temporary buffer and a kernel
+    FastSegmentalReduce& deterministic(bool enable) noexcept
+    {
+        m_deterministic = enable;
+        return *this;
+    }
+
     // e.g.
     // when ReduceOp = cub::Sum
     // dst = [0, 1, 1, 2, 2, 2]
@@ -49,6 +57,13 @@ class FastSegmentalReduce : public LaunchBase<FastSegmentalReduce<BlockSize, War
 
     template <typename T, typename ReduceOp = cub::Sum>
     void reduce(CBufferView<int> dst, CBufferView<T> in, BufferView<T> out, ReduceOp op = ReduceOp{});
+
+  private:
+    bool m_deterministic = false;
+
+    // add up the partial results left by the cross-warp segments, in the warp order
+    template <typename T>
+    void combine_cross_warp(CBufferView<int> dst, CBufferView<T> partials, BufferView<T> out);
 };
 }  // namespace muda
 
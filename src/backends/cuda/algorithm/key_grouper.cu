@@ -0,0 +1,53 @@
+#include <algorithm/key_grouper.h>
+#include <muda/launch.h>
+#include <muda/cub/device/device_radix_sort.h>
+
+namespace uipc::backend::cuda
+{
+void KeyGrouper::group(muda::CBufferView<IndexT> keys, SizeT key_count, cudaStream_t s)
+{
+    using namespace muda;
+
+    auto N = keys.size();
+
+    m_sorted_keys.resize(N);
+    m_indices.resize(N);
+    m_items.resize(N);
+    m_offsets.resize(key_count + 1);
+
+    if(N > 0)
+    {
+        ParallelFor(0, s)
+            .file_line(__FILE__, __LINE__)
+            .apply(N,
+                   [indices = m_indices.viewer().name("indices")] __device__(int I) mutable
+                   { indices(I) = I; });
+
+        // the radix sort is stable, so the items of a key stay in the index order
+        DeviceRadixSort(s).SortPairs(
+            keys.data(), m_sorted_keys.data(), m_indices.data(), m_items.data(), N);
+    }
+
+    // the first item of each key
+    ParallelFor(0, s)
+        .file_line(__FILE__, __LINE__)
+        .apply(key_count + 1,
+               [sorted_keys = m_sorted_keys.cviewer().name("sorted_keys"),
+                offsets     = m_offsets.viewer().name("offsets"),
+                N           = static_cast<IndexT>(N)] __device__(int k) mutable
+               {
+                   // lower bound of k
+                   IndexT lo = 0;
+                   IndexT hi = N;
+                   while(lo < hi)
+                   {
+                       IndexT mid = (lo + hi) / 2;
+                       if(sorted_keys(mid) < k)
+                           lo = mid + 1;
+                       else
+                           hi = mid;
+                   }
+                   offsets(k) = lo;
+               });
+}
+}  // namespace uipc::backend::cuda
@@ -0,0 +1,37 @@
+#pragma once
+#include <type_define.h>
+#include <muda/buffer/device_buffer.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Group the items by their keys, the items of a key keep their index order.
+ *
+ * A scatter by atomics adds the items of a key in the order the threads arrive. Looping over
+ * the group of the key instead adds them in the same order run by run, used by the deterministic mode.
+ *
+ * ```cpp
+ * grouper.group(keys, key_count);
+ * // the items of key k are grouper.items()[offsets[k], offsets[k + 1])
+ * ```
+ */
+class KeyGrouper
+{
+  public:
+    /**
+     * @param keys The key of each item, in `[0, key_count)`, the items with key `key_count` are left out
+     */
+    void group(muda::CBufferView<IndexT> keys, SizeT key_count, cudaStream_t s = nullptr);
+
+    // the item offsets of the keys, `key_count + 1` of them
+    muda::CBufferView<IndexT> offsets() const noexcept { return m_offsets.view(); }
+    // the items sorted by their keys
+    muda::CBufferView<IndexT> items() const noexcept { return m_items.view(); }
+
+  private:
+    muda::DeviceBuffer<IndexT> m_sorted_keys;
+    muda::DeviceBuffer<IndexT> m_indices;
+    muda::DeviceBuffer<IndexT> m_items;
+    muda::DeviceBuffer<IndexT> m_offsets;
+};
+}  // namespace uipc::backend::cuda
@@ -12,6 +12,7 @@ class MatrixConverter
     using SegmentVector = muda::DeviceDoubletVector<T, N>::ValueT;
 
     Float m_reserve_ratio = 1.5;
+    bool  m_deterministic = false;
 
     muda::DeviceBuffer<int> col_counts_per_row;
     muda::DeviceBuffer<int> unique_indices;
@@ -44,6 +45,10 @@ class MatrixConverter
     void  reserve_ratio(Float ratio) { m_reserve_ratio = ratio; }
     Float reserve_ratio() const { return m_reserve_ratio; }
 
+    // sum up the repeated blocks in a fixed order, see `FastSegmentalReduce::deterministic()`
+    void deterministic(bool enable) { m_deterministic = enable; }
+    bool deterministic() const { return m_deterministic; }
+
 
     // Triplet -> BCOO
     void convert(const muda::DeviceTripletMatrix<T, N>& from,
@@ -0,0 +1,43 @@
+#include <algorithm/pair_sorter.h>
+#include <muda/launch.h>
+#include <muda/cub/device/device_radix_sort.h>
+
+namespace uipc::backend::cuda
+{
+void PairSorter::sort(muda::BufferView<Vector2i> pairs, cudaStream_t s)
+{
+    using namespace muda;
+
+    auto N = pairs.size();
+    if(N == 0)
+        return;
+
+    m_keys.resize(N);
+    m_sorted_keys.resize(N);
+
+    // hash (i, j), the same as the triplet sort of the `MatrixConverter`
+    ParallelFor(0, s)
+        .file_line(__FILE__, __LINE__)
+        .apply(N,
+               [pairs = pairs.cviewer().name("pairs"),
+                keys  = m_keys.viewer().name("keys")] __device__(int I) mutable
+               {
+                   const Vector2i& P = pairs(I);
+                   keys(I) = (uint64_t{static_cast<uint32_t>(P[0])} << 32)
+                             + uint64_t{static_cast<uint32_t>(P[1])};
+               });
+
+    DeviceRadixSort(s).SortKeys(m_keys.data(), m_sorted_keys.data(), N);
+
+    ParallelFor(0, s)
+        .file_line(__FILE__, __LINE__)
+        .apply(N,
+               [pairs = pairs.viewer().name("pairs"),
+                keys  = m_sorted_keys.cviewer().name("keys")] __device__(int I) mutable
+               {
+                   uint64_t key = keys(I);
+                   pairs(I) = Vector2i{static_cast<IndexT>(key >> 32),
+                                       static_cast<IndexT>(key & 0xFFFFFFFF)};
+               });
+}
+}  // namespace uipc::backend::cuda
@@ -0,0 +1,22 @@
+#pragma once
+#include <type_define.h>
+#include <muda/buffer/device_buffer.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Sort the index pairs lexicographically.
+ *
+ * The candidate pairs are appended by an atomic counter, so their order changes run by run.
+ * Sorting them makes the downstream assembly visit the contacts in a fixed order.
+ */
+class PairSorter
+{
+  public:
+    void sort(muda::BufferView<Vector2i> pairs, cudaStream_t s = nullptr);
+
+  private:
+    muda::DeviceBuffer<uint64_t> m_keys;
+    muda::DeviceBuffer<uint64_t> m_sorted_keys;
+};
+}  // namespace uipc::backend::cuda
@@ -1,6 +1,7 @@
 #pragma once
 #include <uipc/common/span.h>
 #include <collision_detection/linear_bvh.h>
+#include <algorithm/pair_sorter.h>
 #include <muda/buffer/device_buffer.h>
 #include <muda/launch.h>
 
@@ -33,12 +34,19 @@ class AtomicCountingLBVH
     template <typename Pred>
     void query(muda::CBufferView<LinearBVHAABB> query_aabbs, Pred p, QueryBuffer& out_pairs);
 
+    // sort the output pairs, so the candidate order doesn't depend on the thread scheduling
+    void deterministic(bool enable) noexcept { m_deterministic = enable; }
+    bool deterministic() const noexcept { return m_deterministic; }
+
   private:
     muda::CBufferView<LinearBVHAABB> m_aabbs;
     muda::DeviceVar<IndexT>          m_cp_num;
     LinearBVH                        m_lbvh;
     Float                            m_reserve_ratio = 1.1;
     muda::Stream&                    m_stream;
+
+    bool       m_deterministic = false;
+    PairSorter m_pair_sorter;
 };
 }  // namespace uipc::backend::cuda
 
@@ -53,6 +53,9 @@ void AtomicCountingLBVH::detect(Pred p, QueryBuffer& qbuffer)
     }
 
     qbuffer.m_size = h_cp_num;
+
+    if(m_deterministic)
+        m_pair_sorter.sort(qbuffer.m_pairs.view(0, h_cp_num), m_stream);
 }
 
 template <typename Pred>
@@ -109,5 +112,8 @@ void AtomicCountingLBVH::query(muda::CBufferView<LinearBVHAABB> query_aabbs, Pre
     }
 
     qbuffer.m_size = h_cp_num;
+
+    if(m_deterministic)
+        m_pair_sorter.sort(qbuffer.m_pairs.view(0, h_cp_num), m_stream);
 }
 }  // namespace uipc::backend::cuda
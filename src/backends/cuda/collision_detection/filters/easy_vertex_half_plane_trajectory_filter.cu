@@ -9,6 +9,11 @@ REGISTER_SIM_SYSTEM(EasyVertexHalfPlaneTrajectoryFilter);
 
 constexpr bool PrintDebugInfo = false;
 
+void EasyVertexHalfPlaneTrajectoryFilter::do_build(BuildInfo& info)
+{
+    m_impl.deterministic = world().scene().info()["deterministic"]["enable"].get<bool>();
+}
+
 void EasyVertexHalfPlaneTrajectoryFilter::do_detect(DetectInfo& info)
 {
     // do nothing
@@ -24,10 +29,17 @@ void EasyVertexHalfPlaneTrajectoryFilter::do_filter_toi(FilterTOIInfo& info)
     m_impl.filter_toi(info);
 }
 
+SizeT EasyVertexHalfPlaneTrajectoryFilter::do_candidate_count() const noexcept
+{
+    return m_impl.candidate_count;
+}
+
 void EasyVertexHalfPlaneTrajectoryFilter::Impl::filter_active(FilterActiveInfo& info)
 {
     using namespace muda;
 
+    candidate_count = info.surf_vertices().size() * info.plane_positions().size();
+
     auto query = [&]
     {
         num_collisions = 0;
@@ -96,6 +108,9 @@ void EasyVertexHalfPlaneTrajectoryFilter::Impl::filter_active(FilterActiveInfo&
         query();
     }
 
+    if(deterministic)
+        ph_sorter.sort(PHs.view(0, h_num_collisions));
+
     info.PHs(PHs.view(0, h_num_collisions));
 
     if constexpr(PrintDebugInfo)
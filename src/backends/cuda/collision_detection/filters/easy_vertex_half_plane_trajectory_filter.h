@@ -1,5 +1,6 @@
 #pragma once
 #include <collision_detection/vertex_half_plane_trajectory_filter.h>
+#include <algorithm/pair_sorter.h>
 
 namespace uipc::backend::cuda
 {
@@ -17,11 +18,18 @@ class EasyVertexHalfPlaneTrajectoryFilter final : public VertexHalfPlaneTrajecto
         muda::DeviceVar<IndexT> num_collisions;
         IndexT                  h_num_collisions;
 
+        // no broad phase, all the surface vertex-half plane pairs are candidates
+        SizeT candidate_count = 0;
+
         /**
          * @brief [Vertex-HalfPlane] pairs
          */
         muda::DeviceBuffer<Vector2i> PHs;
 
+        // sort the PHs, see `PairSorter`
+        bool       deterministic = false;
+        PairSorter ph_sorter;
+
         Float reserve_ratio = 1.1f;
 
         muda::DeviceBuffer<Float> tois;
@@ -32,8 +40,10 @@ class EasyVertexHalfPlaneTrajectoryFilter final : public VertexHalfPlaneTrajecto
 
     // Inherited via VertexHalfPlaneTrajectoryFilter
 
+    virtual void do_build(BuildInfo& info) override;
     virtual void do_detect(DetectInfo& info) override;
     virtual void do_filter_active(FilterActiveInfo& info) override;
     virtual void do_filter_toi(FilterTOIInfo& info) override;
+    virtual SizeT do_candidate_count() const noexcept override;
 };
 }  // namespace uipc::backend::cuda
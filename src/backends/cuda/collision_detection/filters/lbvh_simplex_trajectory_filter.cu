@@ -23,6 +23,11 @@ void LBVHSimplexTrajectoryFilter::do_build(BuildInfo& info)
     {
         throw SimSystemException("Linear BVH unused");
     }
+
+    bool deterministic = config["deterministic"]["enable"].get<bool>();
+    m_impl.lbvh_CodimP.deterministic(deterministic);
+    m_impl.lbvh_E.deterministic(deterministic);
+    m_impl.lbvh_T.deterministic(deterministic);
 }
 
 void LBVHSimplexTrajectoryFilter::do_detect(DetectInfo& info)
@@ -40,6 +45,13 @@ void LBVHSimplexTrajectoryFilter::do_filter_toi(FilterTOIInfo& info)
     m_impl.filter_toi(info);
 }
 
+SizeT LBVHSimplexTrajectoryFilter::do_candidate_count() const noexcept
+{
+    return m_impl.candidate_AllP_CodimP_pairs.size() + m_impl.candidate_CodimP_AllE_pairs.size()
+           + m_impl.candidate_AllE_AllE_pairs.size()
+           + m_impl.candidate_AllP_AllT_pairs.size();
+}
+
 void LBVHSimplexTrajectoryFilter::Impl::detect(DetectInfo& info)
 {
     using namespace muda;
@@ -100,5 +100,6 @@ class LBVHSimplexTrajectoryFilter final : public SimplexTrajectoryFilter
     virtual void do_detect(DetectInfo& info) override final;
     virtual void do_filter_active(FilterActiveInfo& info) override final;
     virtual void do_filter_toi(FilterTOIInfo& info) override final;
+    virtual SizeT do_candidate_count() const noexcept override final;
 };
 }  // namespace uipc::backend::cuda
\ No newline at end of file
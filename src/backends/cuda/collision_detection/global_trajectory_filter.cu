@@ -99,6 +99,22 @@ void GlobalTrajectoryFilter::record_friction_candidates()
     }
 }
 
+SizeT GlobalTrajectoryFilter::candidate_count() const
+{
+    SizeT count = 0;
+    for(auto filter : m_impl.filters.view())
+        count += filter->candidate_count();
+    return count;
+}
+
+SizeT GlobalTrajectoryFilter::active_count() const
+{
+    SizeT count = 0;
+    for(auto filter : m_impl.filters.view())
+        count += filter->active_count();
+    return count;
+}
+
 void GlobalTrajectoryFilter::label_active_vertices()
 {
     for(auto filter : m_impl.filters.view())
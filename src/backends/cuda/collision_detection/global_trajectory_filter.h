@@ -99,6 +99,8 @@ class GlobalTrajectoryFilter : public SimSystem
     void  filter_active();               // only called by SimEngine
     Float filter_toi(Float alpha);       // only called by SimEngine
     void  record_friction_candidates();  // only called by SimEngine
+    SizeT candidate_count() const;       // only called by SimEngine
+    SizeT active_count() const;          // only called by SimEngine
     friend class GlobalContactManager;
     void label_active_vertices();  // only called by GlobalContactManager
 
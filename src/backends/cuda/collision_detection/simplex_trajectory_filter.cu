@@ -252,6 +252,11 @@ muda::CBufferView<Vector2i> SimplexTrajectoryFilter::friction_PPs() const noexce
     return m_impl.friction_PP;
 }
 
+SizeT SimplexTrajectoryFilter::do_active_count() const noexcept
+{
+    return m_impl.PTs.size() + m_impl.EEs.size() + m_impl.PEs.size() + m_impl.PPs.size();
+}
+
 muda::CBufferView<Vector3> SimplexTrajectoryFilter::DetectInfo::displacements() const noexcept
 {
     return m_impl->global_vertex_manager->displacements();
@@ -162,5 +162,6 @@ class SimplexTrajectoryFilter : public TrajectoryFilter
     virtual void do_record_friction_candidates(
         GlobalTrajectoryFilter::RecordFrictionCandidatesInfo& info) override final;
     virtual void do_label_active_vertices(GlobalTrajectoryFilter::LabelActiveVerticesInfo& info) final override;
+    virtual SizeT do_active_count() const noexcept override final;
 };
 }  // namespace uipc::backend::cuda
@@ -26,4 +26,14 @@ void TrajectoryFilter::label_active_vertices(GlobalTrajectoryFilter::LabelActive
 {
     do_label_active_vertices(info);
 }
+
+SizeT TrajectoryFilter::candidate_count() const noexcept
+{
+    return do_candidate_count();
+}
+
+SizeT TrajectoryFilter::active_count() const noexcept
+{
+    return do_active_count();
+}
 }  // namespace uipc::backend::cuda
@@ -15,6 +15,10 @@ class TrajectoryFilter : public SimSystem
     virtual void do_filter_toi(GlobalTrajectoryFilter::FilterTOIInfo& info) = 0;
     virtual void do_record_friction_candidates(GlobalTrajectoryFilter::RecordFrictionCandidatesInfo&) = 0;
     virtual void do_label_active_vertices(GlobalTrajectoryFilter::LabelActiveVerticesInfo& info) = 0;
+    // the primitive pairs found by the last broad phase
+    virtual SizeT do_candidate_count() const noexcept = 0;
+    // the primitive pairs kept by the last active filtering
+    virtual SizeT do_active_count() const noexcept = 0;
 
   private:
     friend class GlobalTrajectoryFilter;
@@ -24,5 +28,7 @@ class TrajectoryFilter : public SimSystem
     void filter_toi(GlobalTrajectoryFilter::FilterTOIInfo& info);
     void record_friction_candidates(GlobalTrajectoryFilter::RecordFrictionCandidatesInfo& info);
     void label_active_vertices(GlobalTrajectoryFilter::LabelActiveVerticesInfo& info);
+    SizeT candidate_count() const noexcept;
+    SizeT active_count() const noexcept;
 };
 }  // namespace uipc::backend::cuda
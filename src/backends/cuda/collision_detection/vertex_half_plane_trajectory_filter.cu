@@ -88,6 +88,11 @@ muda::CBufferView<Vector2i> VertexHalfPlaneTrajectoryFilter::friction_PHs() noex
     return m_impl.friction_PHs;
 }
 
+SizeT VertexHalfPlaneTrajectoryFilter::do_active_count() const noexcept
+{
+    return m_impl.PHs.size();
+}
+
 Float VertexHalfPlaneTrajectoryFilter::BaseInfo::d_hat() const noexcept
 {
     return m_impl->global_contact_manager->d_hat();
@@ -126,5 +126,6 @@ class VertexHalfPlaneTrajectoryFilter : public TrajectoryFilter
     virtual void do_record_friction_candidates(
         GlobalTrajectoryFilter::RecordFrictionCandidatesInfo& info) override final;
     virtual void do_label_active_vertices(GlobalTrajectoryFilter::LabelActiveVerticesInfo& info) override final;
+    virtual SizeT do_active_count() const noexcept override final;
 };
 }  // namespace uipc::backend::cuda
@@ -35,7 +35,7 @@ void ContactLineSearchReporter::Impl::do_compute_energy(LineSearcher::EnergyInfo
     contact_energies.view().copy_to(h_contact_energies.data());
 
     Float total_contact_energy =
-        std::accumulate(h_contact_energies.begin(), h_contact_energies.end(), 0.0f);
+        std::accumulate(h_contact_energies.begin(), h_contact_energies.end(), 0.0);
 
     info.energy(total_contact_energy);
 }
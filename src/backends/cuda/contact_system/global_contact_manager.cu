@@ -7,6 +7,7 @@
 #include <kernel_cout.h>
 #include <uipc/common/unit.h>
 #include <uipc/common/zip.h>
+#include <utils/memory_usage.h>
 
 namespace uipc::backend
 {
@@ -40,6 +41,27 @@ void GlobalContactManager::do_build()
     m_impl.eps_velocity = info["contact"]["eps_velocity"].get<Float>();
     m_impl.cfl_enabled  = info["cfl"]["enable"].get<bool>();
     m_impl.kappa = world().scene().contact_tabular().default_model().resistance();
+
+    m_impl.matrix_converter.deterministic(info["deterministic"]["enable"].get<bool>());
+}
+
+SizeT GlobalContactManager::get_memory_usage() const noexcept
+{
+    SizeT bytes = memory_usage(m_impl.vert_is_active_contact)
+                  + memory_usage(m_impl.vert_disp_norms)
+                  + memory_usage(m_impl.collected_contact_hessian)
+                  + memory_usage(m_impl.collected_contact_gradient)
+                  + memory_usage(m_impl.sorted_contact_hessian)
+                  + memory_usage(m_impl.sorted_contact_gradient)
+                  + memory_usage(m_impl.selected_hessian)
+                  + memory_usage(m_impl.selected_hessian_offsets);
+
+    for(auto& hessian : m_impl.classified_contact_hessians)
+        bytes += memory_usage(hessian);
+    for(auto& gradient : m_impl.classified_contact_gradients)
+        bytes += memory_usage(gradient);
+
+    return bytes;
 }
 
 muda::CBuffer2DView<IndexT> GlobalContactManager::contact_mask_tabular() const noexcept
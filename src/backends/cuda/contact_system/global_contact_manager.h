@@ -217,7 +217,8 @@ class GlobalContactManager final : public SimSystem
     muda::CBuffer2DView<IndexT>       contact_mask_tabular() const noexcept;
 
   protected:
-    virtual void do_build() override;
+    virtual void  do_build() override;
+    virtual SizeT get_memory_usage() const noexcept override;
 
   private:
     friend class SimEngine;
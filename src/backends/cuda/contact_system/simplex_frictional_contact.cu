@@ -21,6 +21,7 @@ void SimplexFrictionalContact::do_build()
 
     m_impl.global_contact_manager->add_reporter(this);
     m_impl.dt = world().scene().info()["dt"].get<Float>();
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 
     on_init_scene(
         [this]
@@ -62,7 +63,7 @@ void SimplexFrictionalContact::Impl::compute_energy(SimplexFrictionalContact* co
     contact->do_compute_energy(this_info);
     using namespace muda;
 
-    DeviceReduce().Sum(energies.data(), info.energy().data(), energies.size());
+    energy_sum.sum(std::as_const(energies).view(), info.energy());
 }
 
 void SimplexFrictionalContact::do_compute_energy(GlobalContactManager::EnergyInfo& info)
@@ -17,6 +17,7 @@ void SimplexNormalContact::do_build()
 
     m_impl.global_contact_manager->add_reporter(this);
     m_impl.dt = world().scene().info()["dt"].get<Float>();
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 
     on_init_scene(
         [this]
@@ -65,7 +66,7 @@ void SimplexNormalContact::Impl::compute_energy(SimplexNormalContact* contact,
     //                               { return a < b; });
     //}
 
-    DeviceReduce().Sum(energies.data(), info.energy().data(), energies.size());
+    energy_sum.sum(std::as_const(energies).view(), info.energy());
 }
 
 void SimplexNormalContact::do_compute_energy(GlobalContactManager::EnergyInfo& info)
@@ -3,6 +3,7 @@
 #include <line_search/line_searcher.h>
 #include <contact_system/contact_coeff.h>
 #include <collision_detection/simplex_trajectory_filter.h>
+#include <algorithm/device_sum.h>
 
 namespace uipc::backend::cuda
 {
@@ -182,6 +183,7 @@ class SimplexNormalContact : public ContactReporter
         muda::DeviceBuffer<Vector6>   PP_gradients;
 
         muda::DeviceBuffer<Float> energies;
+        DeviceSum                 energy_sum;
 
         Float reserve_ratio = 1.1;
 
@@ -19,6 +19,7 @@ void VertexHalfPlaneFrictionalContact::do_build()
     m_impl.global_vertex_manager    = require<GlobalVertexManager>();
 
     m_impl.dt = world().scene().info()["dt"].get<Float>();
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 
     BuildInfo info;
     do_build(info);
@@ -62,8 +63,7 @@ void VertexHalfPlaneFrictionalContact::do_compute_energy(GlobalContactManager::E
     // let subclass to fill in the data
     do_compute_energy(this_info);
 
-    DeviceReduce().Sum(
-        m_impl.energies.data(), info.energy().data(), m_impl.energies.size());
+    m_impl.energy_sum.sum(std::as_const(m_impl.energies).view(), info.energy());
 
     Float E;
     info.energy().copy_to(&E);
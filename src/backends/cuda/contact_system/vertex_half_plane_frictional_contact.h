@@ -2,6 +2,7 @@
 #include <contact_system/contact_reporter.h>
 #include <line_search/line_searcher.h>
 #include <contact_system/contact_coeff.h>
+#include <algorithm/device_sum.h>
 
 namespace uipc::backend::cuda
 {
@@ -92,6 +93,7 @@ class VertexHalfPlaneFrictionalContact : public ContactReporter
         Float dt;
 
         muda::DeviceBuffer<Float>     energies;
+        DeviceSum                     energy_sum;
         muda::DeviceBuffer<Vector3>   gradients;
         muda::DeviceBuffer<Matrix3x3> hessians;
 
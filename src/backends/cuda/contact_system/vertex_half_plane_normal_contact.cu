@@ -16,6 +16,7 @@ void VertexHalfPlaneNormalContact::do_build()
 
     m_impl.global_contact_manager->add_reporter(this);
     m_impl.dt = world().scene().info()["dt"].get<Float>();
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 
     on_init_scene(
         [this]
@@ -54,8 +55,7 @@ void VertexHalfPlaneNormalContact::do_compute_energy(GlobalContactManager::Energ
     // let subclass to fill in the data
     do_compute_energy(this_info);
 
-    DeviceReduce().Sum(
-        m_impl.energies.data(), info.energy().data(), m_impl.energies.size());
+    m_impl.energy_sum.sum(std::as_const(m_impl.energies).view(), info.energy());
 
     Float E;
     info.energy().copy_to(&E);
@@ -2,6 +2,7 @@
 #include <contact_system/contact_reporter.h>
 #include <line_search/line_searcher.h>
 #include <contact_system/contact_coeff.h>
+#include <algorithm/device_sum.h>
 
 namespace uipc::backend::cuda
 {
@@ -93,6 +94,7 @@ class VertexHalfPlaneNormalContact : public ContactReporter
         Float dt;
 
         muda::DeviceBuffer<Float>     energies;
+        DeviceSum                     energy_sum;
         muda::DeviceBuffer<Vector3>   gradients;
         muda::DeviceBuffer<Matrix3x3> m_hessians;
 
@@ -2,10 +2,12 @@
 #include <diff_sim/diff_dof_reporter.h>
 #include <diff_sim/diff_parm_reporter.h>
 #include <linear_system/global_linear_system.h>
+#include <finite_element/finite_element_method.h>
+#include <affine_body/affine_body_dynamics.h>
 #include <sim_engine.h>
 #include <utils/offset_count_collection.h>
-#include <sim_engine.h>
 #include <kernel_cout.h>
+#include <uipc/common/zip.h>
 
 namespace uipc::backend
 {
@@ -29,75 +31,38 @@ namespace uipc::backend::cuda
 {
 namespace detail
 {
-    void build_coo_matrix(muda::LinearSystemContext&           ctx,
-                          muda::DeviceCOOMatrix<Float>&        total_coo,
-                          muda::DeviceTripletMatrix<Float, 1>& total_triplet,
-                          muda::DeviceTripletMatrix<Float, 1>& local_triplet)
-    {
-        using namespace muda;
-
-        // 1) reshape the total_coo and total_triplet
-        auto M = local_triplet.rows();
-        auto N = local_triplet.cols();
-        total_coo.reshape(M, N);
-        total_triplet.reshape(M, N);
-
-        // 2) append the local_triplet to the total_triplet
-        //  2.1) resize copy the total_coo to total_triplet
-        auto new_triplet_count = total_coo.non_zeros() + local_triplet.triplet_count();
-        total_triplet.resize_triplets(new_triplet_count);
-        auto total_triplet_view = total_triplet.view();
-        ParallelFor()
-            .file_line(__FILE__, __LINE__)
-            .apply(total_coo.non_zeros(),
-                   [total_coo     = total_coo.cviewer().name("total_coo"),
-                    total_triplet = total_triplet_view
-                                        .subview(0, total_coo.non_zeros())  // front
-                                        .viewer()
-                                        .name("total_triplet")] __device__(int I) mutable
-                   {
-                       auto&& [i, j, V] = total_coo(I);
-                       total_triplet(I).write(i, j, V);
-                   });
-        //  2.2) append the local_triplet to the total_triplet
-        ParallelFor()
-            .file_line(__FILE__, __LINE__)
-            .apply(local_triplet.triplet_count(),
-                   [local_triplet = local_triplet.cviewer().name("local_triplet"),
-                    total_triplet = total_triplet_view
-                                        .subview(total_coo.non_zeros(),
-                                                 local_triplet.triplet_count())  // back
-                                        .viewer()
-                                        .name("total_triplet")] __device__(int I) mutable
-                   {
-                       auto&& [i, j, V] = local_triplet(I);
-                       total_triplet(I).write(i, j, V);
-                       // cout << "i: " << i << ", j: " << j << ", V: " << V << "\n";
-                   })
-            .wait();
-
-        // 3) convert the total_triplet to total_coo
-        ctx.convert(total_triplet, total_coo);
-    }
-
-    void copy_to_host(const muda::DeviceCOOMatrix<Float>& total_coo,
+    void copy_to_host(const muda::DeviceCOOMatrix<Float>& coo,
                       GlobalDiffSimManager::SparseCOO&    host_coo)
     {
         // copy row_inides, col_indices, values to host_coo
 
-        host_coo.row_indices.resize(total_coo.row_indices().size());
-        total_coo.row_indices().copy_to(host_coo.row_indices.data());
+        host_coo.row_indices.resize(coo.row_indices().size());
+        coo.row_indices().copy_to(host_coo.row_indices.data());
+
+        host_coo.col_indices.resize(coo.col_indices().size());
+        coo.col_indices().copy_to(host_coo.col_indices.data());
 
-        host_coo.col_indices.resize(total_coo.col_indices().size());
-        total_coo.col_indices().copy_to(host_coo.col_indices.data());
+        host_coo.values.resize(coo.values().size());
+        coo.values().copy_to(host_coo.values.data());
 
-        host_coo.values.resize(total_coo.values().size());
-        total_coo.values().copy_to(host_coo.values.data());
+        host_coo.shape = {coo.rows(), coo.cols()};
+    }
 
-        host_coo.shape = {total_coo.rows(), total_coo.cols()};
+    void clear(GlobalDiffSimManager::SparseCOO& host_coo, const Vector2i& shape)
+    {
+        host_coo.row_indices.clear();
+        host_coo.col_indices.clear();
+        host_coo.values.clear();
+        host_coo.shape = shape;
+    }
+
+    void push_back(GlobalDiffSimManager::SparseCOO& host_coo, IndexT i, IndexT j, Float V)
+    {
+        host_coo.row_indices.push_back(i);
+        host_coo.col_indices.push_back(j);
+        host_coo.values.push_back(V);
     }
 }  // namespace detail
-// namespace detail
 }  // namespace uipc::backend::cuda
 
 namespace uipc::backend::cuda
@@ -106,8 +71,10 @@ REGISTER_SIM_SYSTEM(GlobalDiffSimManager);
 
 void GlobalDiffSimManager::do_build()
 {
-    m_impl.global_linear_system = &require<GlobalLinearSystem>();
-    m_impl.sim_engine           = &engine();
+    m_impl.global_linear_system  = &require<GlobalLinearSystem>();
+    m_impl.sim_engine            = &engine();
+    m_impl.finite_element_method = find<FiniteElementMethod>();
+    m_impl.affine_body_dynamics  = find<AffineBodyDynamics>();
 
     on_write_scene([&] { m_impl.write_scene(world()); });
 }
@@ -122,10 +89,6 @@ void GlobalDiffSimManager::Impl::init(WorldVisitor& world)
     auto& diff_sim   = world.scene().diff_sim();
     auto  parm_view  = diff_sim.parameters().view();
     total_parm_count = parm_view.size();
-    dof_offsets.reserve(1024);
-    dof_counts.reserve(1024);
-    total_coo_pGpP.reshape(0, 0);
-    total_coo_H.reshape(0, 0);
 
     // 1) Copy the parameters to the device
     parameters.resize(total_parm_count);
@@ -162,7 +125,132 @@ void GlobalDiffSimManager::Impl::update()
 
 void GlobalDiffSimManager::Impl::assemble()
 {
-    // Waiting for later version merging
+    using namespace muda;
+
+    auto frame = sim_engine->frame();
+    UIPC_ASSERT(frame > 0, "frame 0 is not solved");
+
+    // the dof count is assumed to be the same for all the frames in the window
+    window_begin            = frame > CouplingDepth ? frame - CouplingDepth : 1;
+    frame_dof_count         = global_linear_system->dof_count();
+    IndexT window_dof_count = (frame - window_begin + 1) * frame_dof_count;
+
+    // 1) H and pGpX: the rows of the current frame, the columns of all the frames in the window
+    {
+        auto reporter_view = diff_dof_reporters.view();
+        auto counts        = diff_dof_triplet_offset_count.counts();
+        for(auto&& [i, R] : enumerate(reporter_view))
+        {
+            DiffDofExtentInfo info{this, i};
+            R->report_extent(info);
+            counts[i] = info.m_triplet_count;
+        }
+        diff_dof_triplet_offset_count.scan();
+
+        local_triplet_H.reshape(window_dof_count, window_dof_count);
+        local_triplet_H.resize_triplets(diff_dof_triplet_offset_count.total_count());
+
+        for(auto&& [i, R] : enumerate(reporter_view))
+        {
+            DiffDofInfo info{this, i};
+            R->assemble_diff_dof(info);
+        }
+    }
+
+    // 2) pGpP: the rows of the current frame
+    {
+        auto reporter_view = diff_parm_reporters.view();
+        auto counts        = diff_parm_triplet_offset_count.counts();
+        for(auto&& [i, R] : enumerate(reporter_view))
+        {
+            DiffParmExtentInfo info{this, i};
+            R->report_extent(info);
+            counts[i] = info.m_triplet_count;
+        }
+        diff_parm_triplet_offset_count.scan();
+
+        local_triplet_pGpP.reshape(window_dof_count, total_parm_count);
+        local_triplet_pGpP.resize_triplets(diff_parm_triplet_offset_count.total_count());
+
+        for(auto&& [i, R] : enumerate(reporter_view))
+        {
+            DiffParmInfo info{this, i};
+            R->assemble_diff_parm(info);
+        }
+    }
+
+    // 3) merge the duplicated triplets, download and split the rows of the current frame by the frames of the columns
+    IndexT row_begin = (frame - window_begin) * frame_dof_count;
+    IndexT n         = frame_dof_count;
+
+    SparseCOO coo;
+    {
+        detail::clear(host_coo_H, Vector2i{n, n});
+        for(auto& pGpX : host_coo_pGpX)
+            detail::clear(pGpX, Vector2i{n, n});
+
+        if(local_triplet_H.triplet_count() > 0)
+        {
+            ctx().convert(local_triplet_H, coo_H);
+            detail::copy_to_host(coo_H, coo);
+        }
+
+        for(auto&& [i, j, V] : zip(coo.row_indices, coo.col_indices, coo.values))
+        {
+            UIPC_ASSERT(i >= row_begin && i < row_begin + n,
+                        "Only the rows of the current frame can be reported, row={}, expected=[{}, {})",
+                        i,
+                        row_begin,
+                        row_begin + n);
+
+            SizeT k   = frame - (window_begin + j / n);  // the column frame is i-k
+            auto& dst = k == 0 ? host_coo_H : host_coo_pGpX[k - 1];
+            detail::push_back(dst, i - row_begin, j % n, V);
+        }
+    }
+
+    {
+        detail::clear(host_coo_pGpP, Vector2i{n, static_cast<IndexT>(total_parm_count)});
+
+        coo = {};
+        if(local_triplet_pGpP.triplet_count() > 0)
+        {
+            ctx().convert(local_triplet_pGpP, coo_pGpP);
+            detail::copy_to_host(coo_pGpP, coo);
+        }
+
+        for(auto&& [i, j, V] : zip(coo.row_indices, coo.col_indices, coo.values))
+        {
+            UIPC_ASSERT(i >= row_begin && i < row_begin + n,
+                        "Only the rows of the current frame can be reported, row={}, expected=[{}, {})",
+                        i,
+                        row_begin,
+                        row_begin + n);
+            detail::push_back(host_coo_pGpP, i - row_begin, j, V);
+        }
+    }
+}
+
+void GlobalDiffSimManager::Impl::gather_dofs()
+{
+    auto frame = sim_engine->frame();
+    UIPC_ASSERT(frame > 0, "The dof layout is recorded from frame 1");
+    host_dofs.resize(global_linear_system->dof_count());
+
+    // the dofs are laid out as the global linear system of the frame
+    if(finite_element_method && finite_element_method->dof_count(frame) > 0)
+    {
+        auto xs     = finite_element_method->xs();
+        auto offset = finite_element_method->dof_offset(frame);
+        xs.copy_to(reinterpret_cast<Vector3*>(host_dofs.data() + offset));
+    }
+
+    if(affine_body_dynamics && affine_body_dynamics->dof_count(frame) > 0)
+    {
+        auto qs     = affine_body_dynamics->qs();
+        auto offset = affine_body_dynamics->dof_offset(frame);
+        qs.copy_to(reinterpret_cast<Vector12*>(host_dofs.data() + offset));
+    }
 }
 
 void GlobalDiffSimManager::Impl::write_scene(WorldVisitor& world)
@@ -185,6 +273,34 @@ void GlobalDiffSimManager::update()
     m_impl.update();
 }
 
+diff_sim::SparseCOOView GlobalDiffSimManager::H() const
+{
+    return m_impl.host_coo_H.view();
+}
+
+diff_sim::SparseCOOView GlobalDiffSimManager::pGpX(SizeT k) const
+{
+    if(k < 1 || k > Impl::CouplingDepth)
+        return {};
+    return m_impl.host_coo_pGpX[k - 1].view();
+}
+
+diff_sim::SparseCOOView GlobalDiffSimManager::pGpP() const
+{
+    return m_impl.host_coo_pGpP.view();
+}
+
+SizeT GlobalDiffSimManager::parm_count() const
+{
+    return m_impl.total_parm_count;
+}
+
+span<const Float> GlobalDiffSimManager::dofs()
+{
+    m_impl.gather_dofs();
+    return m_impl.host_dofs;
+}
+
 void GlobalDiffSimManager::add_reporter(DiffDofReporter* subsystem)
 {
     UIPC_ASSERT(subsystem != nullptr, "subsystem is nullptr");
@@ -216,14 +332,24 @@ SizeT GlobalDiffSimManager::BaseInfo::frame() const
     return m_impl->sim_engine->frame();
 }
 
+SizeT GlobalDiffSimManager::BaseInfo::first_frame() const
+{
+    return m_impl->window_begin;
+}
+
 IndexT GlobalDiffSimManager::BaseInfo::dof_offset(SizeT frame) const
 {
-    return m_impl->dof_offsets[frame - 1];  // we record from the frame 1
+    UIPC_ASSERT(frame >= m_impl->window_begin && frame <= this->frame(),
+                "Frame {} is out of the window [{}, {}]",
+                frame,
+                m_impl->window_begin,
+                this->frame());
+    return (frame - m_impl->window_begin) * m_impl->frame_dof_count;
 }
 
 IndexT GlobalDiffSimManager::BaseInfo::dof_count(SizeT frame) const
 {
-    return m_impl->dof_counts[frame - 1];  // we record from the frame 1
+    return m_impl->frame_dof_count;
 }
 
 diff_sim::SparseCOOView GlobalDiffSimManager::SparseCOO::view() const
@@ -4,12 +4,16 @@
 #include <utils/offset_count_collection.h>
 #include <algorithm/matrix_converter.h>
 #include <uipc/diff_sim/sparse_coo_view.h>
+#include <array>
 
 namespace uipc::backend::cuda
 {
 class DiffDofReporter;
 class DiffParmReporter;
 class GlobalLinearSystem;
+class FiniteElementMethod;
+class AffineBodyDynamics;
+class SimEngineFrameSystem;
 
 class GlobalDiffSimManager final : public SimSystem
 {
@@ -35,10 +39,16 @@ class GlobalDiffSimManager final : public SimSystem
         void init(WorldVisitor& world);
         void update();
         void assemble();
+        void gather_dofs();
         void write_scene(WorldVisitor& world);
 
-        GlobalLinearSystem* global_linear_system = nullptr;
-        SimEngine*          sim_engine           = nullptr;
+        // the inertia couples a frame to the two frames before it
+        static constexpr SizeT CouplingDepth = 2;
+
+        GlobalLinearSystem*  global_linear_system  = nullptr;
+        SimEngine*           sim_engine            = nullptr;
+        FiniteElementMethod* finite_element_method = nullptr;
+        AffineBodyDynamics*  affine_body_dynamics  = nullptr;
 
         SimSystemSlotCollection<DiffDofReporter>  diff_dof_reporters;
         SimSystemSlotCollection<DiffParmReporter> diff_parm_reporters;
@@ -46,68 +56,50 @@ class GlobalDiffSimManager final : public SimSystem
         OffsetCountCollection<IndexT> diff_dof_triplet_offset_count;
         OffsetCountCollection<IndexT> diff_parm_triplet_offset_count;
 
-        vector<IndexT> dof_offsets;
-        vector<IndexT> dof_counts;
-
         SizeT total_parm_count = 0;
 
         muda::DeviceBuffer<Float> parameters;
 
+        // NOTE:
+        // Only the window of frames [window_begin, i] is kept, the dofs of the frame f
+        // are at (f - window_begin) * frame_dof_count, so the memory doesn't grow with the horizon.
+        SizeT window_begin    = 1;
+        SizeT frame_dof_count = 0;
+
         // NOTE:
         // local_triplet_pGpP only consider the triplet at current frame.
-        // So the triplet count = current_frame_triplet_count
-        // The shape of the matrix = (total_frame_dof_count, total_parm_count)
+        // The shape of the matrix = (window_dof_count, total_parm_count)
         //tex:
         //$$
         //T = \begin{bmatrix}
         // 0   \\
-        // ... \\
         // 0   \\
         // T^{[i]} \\
         //\end{bmatrix}
         //$$
         muda::DeviceTripletMatrix<Float, 1> local_triplet_pGpP;
-        //tex:
-        //$$
-        //T = \begin{bmatrix}
-        // T^{[1]}   \\
-        // ... \\
-        // T^{[i]} \\
-        //\end{bmatrix}
-        //$$
-        muda::DeviceTripletMatrix<Float, 1> total_triplet_pGpP;
-        muda::DeviceCOOMatrix<Float>        total_coo_pGpP;
+        muda::DeviceCOOMatrix<Float>        coo_pGpP;
 
         // NOTE:
-        // local_triplet_H only consider the triplet at current frame.
-        // So the triplet count = current_frame_triplet_count
-        // The shape of the matrix = (total_frame_dof_count, total_frame_dof_count)
+        // local_triplet_H only consider the rows of the current frame.
+        // The shape of the matrix = (window_dof_count, window_dof_count)
         //tex:
         //$$
         //T = \begin{bmatrix}
-        // 0   \\
-        // ... \\
-        // 0   \\
-        // H^{[i]} \\
+        // 0 & 0 & 0 \\
+        // 0 & 0 & 0 \\
+        // \frac{\partial G^{[i]}}{\partial X^{[i-2]}} & \frac{\partial G^{[i]}}{\partial X^{[i-1]}} & H^{[i]} \\
         //\end{bmatrix}
         //$$
         muda::DeviceTripletMatrix<Float, 1> local_triplet_H;
-        //tex:
-        //$$
-        //T = \begin{bmatrix}
-        // H^{[1]}   \\
-        // ... \\
-        // H^{[i]} \\
-        //\end{bmatrix}
-        //$$
-        muda::DeviceTripletMatrix<Float, 1> total_triplet_H;
-        muda::DeviceCOOMatrix<Float>        total_coo_H;
+        muda::DeviceCOOMatrix<Float>        coo_H;
 
-        SizeT current_frame_dof_count = 0;
-        SizeT total_frame_dof_count   = 0;
+        // the row block of the current frame, split by the frames of the columns
+        SparseCOO                            host_coo_pGpP;
+        SparseCOO                            host_coo_H;
+        std::array<SparseCOO, CouplingDepth> host_coo_pGpX;  // [k-1] -> frame i-k
 
-        SparseCOO host_coo_pGpP;
-        SparseCOO host_coo_H;
+        vector<Float> host_dofs;
     };
 
     class BaseInfo
@@ -119,7 +111,11 @@ class GlobalDiffSimManager final : public SimSystem
         {
         }
 
-        SizeT  frame() const;
+        SizeT frame() const;
+        /**
+         * @brief The first frame of the window, the dofs of the frames `[first_frame(), frame()]` are the columns of H.
+         */
+        SizeT  first_frame() const;
         IndexT dof_offset(SizeT frame) const;
         IndexT dof_count(SizeT frame) const;
 
@@ -190,6 +186,14 @@ class GlobalDiffSimManager final : public SimSystem
     void assemble();  // only be called by SimEngine
     void update();    // only be called by SimEngine
 
+    friend class SimEngineFrameSystem;
+    // the systems of the current frame, only be called by SimEngineFrameSystem
+    diff_sim::SparseCOOView H() const;
+    diff_sim::SparseCOOView pGpX(SizeT k) const;
+    diff_sim::SparseCOOView pGpP() const;
+    SizeT                   parm_count() const;
+    span<const Float>       dofs();
+
     virtual void do_build() override;
 
 
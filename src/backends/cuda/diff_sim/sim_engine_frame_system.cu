@@ -0,0 +1,71 @@
+#include <diff_sim/sim_engine_frame_system.h>
+#include <diff_sim/global_diff_sim_manager.h>
+#include <uipc/common/log.h>
+
+namespace uipc::backend::cuda
+{
+SimEngineFrameSystem::SimEngineFrameSystem(core::IEngine& engine, GlobalDiffSimManager& manager)
+    : m_engine(engine)
+    , m_manager(manager)
+{
+}
+
+void SimEngineFrameSystem::do_advance()
+{
+    m_engine.advance();
+    // assemble the systems of the new frame
+    m_engine.backward();
+
+    if(m_engine.status().has_error())
+        throw diff_sim::AdjointSolverError{
+            fmt::format("The engine failed to replay frame {}", m_engine.frame())};
+}
+
+SizeT SimEngineFrameSystem::get_frame() const
+{
+    return m_engine.frame();
+}
+
+bool SimEngineFrameSystem::do_checkpoint()
+{
+    return m_engine.dump() && !m_engine.status().has_error();
+}
+
+bool SimEngineFrameSystem::do_recover(SizeT frame)
+{
+    // the engine is already there, nothing to load
+    if(m_engine.frame() == frame)
+        return true;
+    return m_engine.recover(frame) && !m_engine.status().has_error();
+}
+
+span<const Float> SimEngineFrameSystem::get_dofs() const
+{
+    return m_manager.dofs();
+}
+
+SizeT SimEngineFrameSystem::get_parm_count() const
+{
+    return m_manager.parm_count();
+}
+
+diff_sim::SparseCOOView SimEngineFrameSystem::get_H() const
+{
+    return m_manager.H();
+}
+
+diff_sim::SparseCOOView SimEngineFrameSystem::get_pGpP() const
+{
+    return m_manager.pGpP();
+}
+
+SizeT SimEngineFrameSystem::get_coupling_depth() const
+{
+    return GlobalDiffSimManager::Impl::CouplingDepth;
+}
+
+diff_sim::SparseCOOView SimEngineFrameSystem::get_pGpX(SizeT k) const
+{
+    return m_manager.pGpX(k);
+}
+}  // namespace uipc::backend::cuda
@@ -0,0 +1,37 @@
+#pragma once
+#include <uipc/diff_sim/adjoint_solver.h>
+#include <uipc/core/i_engine.h>
+
+namespace uipc::backend::cuda
+{
+class GlobalDiffSimManager;
+
+/**
+ * @brief The FrameSystemProvider over the cuda engine.
+ *
+ * A frame is advanced by `advance()` and `backward()`, so that the GlobalDiffSimManager assembles the systems
+ * of the new frame. The checkpoints are the dumps of the engine, so the frame the forward pass starts from
+ * (e.g. the frame right after `World::init()`) must be dumped by the user before the adjoint is computed.
+ */
+class SimEngineFrameSystem final : public diff_sim::FrameSystemProvider
+{
+  public:
+    SimEngineFrameSystem(core::IEngine& engine, GlobalDiffSimManager& manager);
+
+    virtual void  do_advance() override;
+    virtual SizeT get_frame() const override;
+    virtual bool  do_checkpoint() override;
+    virtual bool  do_recover(SizeT frame) override;
+
+    virtual span<const Float>       get_dofs() const override;
+    virtual SizeT                   get_parm_count() const override;
+    virtual diff_sim::SparseCOOView get_H() const override;
+    virtual diff_sim::SparseCOOView get_pGpP() const override;
+    virtual SizeT                   get_coupling_depth() const override;
+    virtual diff_sim::SparseCOOView get_pGpX(SizeT k) const override;
+
+  private:
+    core::IEngine&        m_engine;
+    GlobalDiffSimManager& m_manager;
+};
+}  // namespace uipc::backend::cuda
@@ -6,6 +6,7 @@
 #include <backends/common/module.h>
 #include <global_geometry/global_vertex_manager.h>
 #include <global_geometry/global_simplicial_surface_manager.h>
+#include <diff_sim/sim_engine_frame_system.h>
 #include <fstream>
 #include <uipc/common/timer.h>
 #include <backends/common/backend_path_tool.h>
@@ -11,6 +11,8 @@
 #include <animator/global_animator.h>
 #include <diff_sim/global_diff_sim_manager.h>
 #include <newton_tolerance/newton_tolerance_manager.h>
+#include <muda/muda.h>
+#include <chrono>
 
 namespace uipc::backend::cuda
 {
@@ -20,6 +22,9 @@ void SimEngine::do_advance()
     Float ccd_alpha = 1.0;
     Float cfl_alpha = 1.0;
 
+    using Phase = core::FrameStatisticsRecord::Phase;
+    core::FrameStatisticsRecord stats;
+
     bool dump_surface =
         world().scene().info()["extras"]["debug"]["dump_surface"].get<bool>();
 
@@ -27,31 +32,57 @@ void SimEngine::do_advance()
     *                                  Function Shortcuts
     ***************************************************************************************/
 
-    auto detect_dcd_candidates = [this]
+    // accumulate the wall time of `f` to the phase, exclusive of the phases nested in `f`,
+    // the device is synchronized around `f`, so the kernels launched by `f` are charged to its phase
+    Float nested_time = 0.0;
+    auto  timed       = [&stats, &nested_time](Phase phase, auto&& f)
+    {
+        Float outer_nested_time = std::exchange(nested_time, 0.0);
+        muda::wait_device();
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        muda::wait_device();
+        std::chrono::duration<Float> d = std::chrono::steady_clock::now() - begin;
+        stats.phase_times[phase] += d.count() - nested_time;
+        nested_time = outer_nested_time + d.count();
+    };
+
+    // the contact counts are recorded in the frame statistics, the maximum over the Newton iterations
+    auto detect_dcd_candidates = [this, &timed, &stats]
     {
         if(m_global_trajectory_filter)
         {
             Timer timer{"Detect DCD Candidates"};
-            m_global_trajectory_filter->detect(0.0);
-            m_global_trajectory_filter->filter_active();
+            timed(Phase::CollisionDetection,
+                  [this]
+                  {
+                      m_global_trajectory_filter->detect(0.0);
+                      m_global_trajectory_filter->filter_active();
+                  });
+            stats.contact_candidates = std::max(
+                stats.contact_candidates, m_global_trajectory_filter->candidate_count());
+            stats.active_contacts = std::max(stats.active_contacts,
+                                             m_global_trajectory_filter->active_count());
         }
     };
 
-    auto detect_trajectory_candidates = [this](Float alpha)
+    auto detect_trajectory_candidates = [this, &timed](Float alpha)
     {
         if(m_global_trajectory_filter)
         {
             Timer timer{"Detect Trajectory Candidates"};
-            m_global_trajectory_filter->detect(alpha);
+            timed(Phase::CollisionDetection,
+                  [&] { m_global_trajectory_filter->detect(alpha); });
         }
     };
 
-    auto filter_dcd_candidates = [this]
+    auto filter_dcd_candidates = [this, &timed]
     {
         if(m_global_trajectory_filter)
         {
             Timer timer{"Filter Contact Candidates"};
-            m_global_trajectory_filter->filter_active();
+            timed(Phase::CollisionDetection,
+                  [this] { m_global_trajectory_filter->filter_active(); });
         }
     };
 
@@ -70,41 +101,39 @@ void SimEngine::do_advance()
             m_global_contact_manager->compute_adaptive_kappa();
     };
 
-    auto compute_contact = [this]
+    auto compute_contact = [this, &timed]
     {
         if(m_global_contact_manager)
         {
             Timer timer{"Compute Contact"};
-            m_global_contact_manager->compute_contact();
+            timed(Phase::Assembly, [this] { m_global_contact_manager->compute_contact(); });
         }
     };
 
-    auto cfl_condition = [&cfl_alpha, this](Float alpha)
+    // the step clamps are recorded in the frame statistics, not logged per iteration
+    auto cfl_condition = [&cfl_alpha, &stats, this](Float alpha)
     {
         if(m_global_contact_manager)
         {
-            cfl_alpha = m_global_contact_manager->compute_cfl_condition();
+            cfl_alpha       = m_global_contact_manager->compute_cfl_condition();
+            stats.cfl_alpha = std::min(stats.cfl_alpha, cfl_alpha);
             if(cfl_alpha < alpha)
-            {
-                spdlog::info("CFL Filter: {} < {}", cfl_alpha, alpha);
                 return cfl_alpha;
-            }
         }
 
         return alpha;
     };
 
-    auto filter_toi = [&ccd_alpha, this](Float alpha)
+    auto filter_toi = [&ccd_alpha, &stats, &timed, this](Float alpha)
     {
         if(m_global_trajectory_filter)
         {
             Timer timer{"Filter CCD TOI"};
-            ccd_alpha = m_global_trajectory_filter->filter_toi(alpha);
+            timed(Phase::CollisionDetection,
+                  [&] { ccd_alpha = m_global_trajectory_filter->filter_toi(alpha); });
+            stats.ccd_alpha = std::min(stats.ccd_alpha, ccd_alpha);
             if(ccd_alpha < alpha)
-            {
-                spdlog::info("CCD Filter: {} < {}", ccd_alpha, alpha);
                 return ccd_alpha;
-            }
         }
 
         return alpha;
@@ -173,6 +202,7 @@ void SimEngine::do_advance()
         Timer timer{"Pipeline"};
 
         ++m_current_frame;
+        stats.frame = m_current_frame;
 
         spdlog::info(R"(>>> Begin Frame: {})", m_current_frame);
 
@@ -223,6 +253,7 @@ void SimEngine::do_advance()
             for(; newton_iter < m_newton_max_iter; ++newton_iter)
             {
                 Timer timer{"Newton Iteration"};
+                ++stats.newton_iterations;
 
                 // 1) Compute animation substep ratio
                 compute_animation_substep_ratio(newton_iter);
@@ -239,14 +270,17 @@ void SimEngine::do_advance()
                 m_state = SimEngineState::ComputeGradientHessian;
                 {
                     Timer timer{"Compute Gradient Hessian"};
-                    m_gradient_hessian_computer->compute_gradient_hessian();
+                    timed(Phase::Assembly,
+                          [this] { m_gradient_hessian_computer->compute_gradient_hessian(); });
                 }
 
                 // 5) Solve Global Linear System => dx = A^-1 * b
                 m_state = SimEngineState::SolveGlobalLinearSystem;
                 {
                     Timer timer{"Solve Global Linear System"};
-                    m_global_linear_system->solve();
+                    timed(Phase::LinearSolve, [this] { m_global_linear_system->solve(); });
+                    stats.linear_solver_iterations +=
+                        static_cast<IndexT>(m_global_linear_system->last_iter_count());
                 }
 
 
@@ -282,6 +316,7 @@ void SimEngine::do_advance()
 
                 // 8) Begin Line Search
                 m_state = SimEngineState::LineSearch;
+                timed(Phase::LineSearch, [&]
                 {
                     Timer timer{"Line Search"};
 
@@ -331,6 +366,8 @@ void SimEngine::do_advance()
                             line_search_iter++;
                         }
 
+                        stats.line_search_iterations += static_cast<IndexT>(line_search_iter);
+
                         if(line_search_iter > m_line_searcher->max_iter())
                         {
                             //m_global_linear_system->dump_linear_system(
@@ -352,7 +389,9 @@ void SimEngine::do_advance()
                             }
                         }
                     }
-                }
+
+                    stats.line_search_alpha = alpha;
+                });
             }
 
             // 5. Update Velocity => v = (x - x_0) / dt
@@ -386,6 +425,7 @@ void SimEngine::do_advance()
     {
         pipeline();
         m_last_solved_frame = m_current_frame;
+        m_frame_statistics->push(stats);
     }
     catch(const SimEngineException& e)
     {
@@ -33,11 +33,12 @@ void SimEngine::do_backward()
             // \frac{\partial G^{[i]}}{\partial P} := \frac{\partial^2 E}{\partial X^{[i]} \partial P}
             //$$
             //
+            // only the window of the frames the current frame depends on is kept (the inertia reaches back two frames)
             //
             //$$
             //H^{[i]} :=
             //\begin{bmatrix}
-            // \frac{\partial^2 E}{\partial X^{[i]} \partial X^{[1]}} & \cdots & \frac{\partial^2 E}{\partial X^{[i]} \partial X^{[i]}} \\
+            // \frac{\partial G^{[i]}}{\partial X^{[i-2]}} & \frac{\partial G^{[i]}}{\partial X^{[i-1]}} & \frac{\partial^2 E}{\partial X^{[i]} \partial X^{[i]}} \\
             //\end{bmatrix}
             //$$
             m_global_diff_sim_manager->assemble();
@@ -2,6 +2,7 @@
 #include <collision_detection/global_trajectory_filter.h>
 #include <contact_system/global_contact_manager.h>
 #include <diff_sim/global_diff_sim_manager.h>
+#include <diff_sim/sim_engine_frame_system.h>
 #include <dof_predictor.h>
 #include <fstream>
 #include <global_geometry/global_simplicial_surface_manager.h>
@@ -109,6 +110,19 @@ void SimEngine::do_init(InitInfo& info)
         m_state = SimEngineState::BuildSystems;
         build();
 
+        m_frame_statistics = uipc::make_shared<core::FrameStatisticsFeature>();
+        features().insert(m_frame_statistics);
+
+        if(m_global_diff_sim_manager)
+        {
+            SizeT checkpoint_count =
+                world().scene().info()["diff_sim"]["checkpoint_count"].get<SizeT>();
+            m_frame_system = uipc::make_unique<SimEngineFrameSystem>(
+                *this, *m_global_diff_sim_manager);
+            features().insert(uipc::make_shared<diff_sim::AdjointMethodFeature>(
+                uipc::make_shared<diff_sim::HostAdjointMethod>(*m_frame_system, checkpoint_count)));
+        }
+
         // 2. Trigger the init_scene event, systems register their actions will be called here
         m_state = SimEngineState::InitScene;
         init_scene();
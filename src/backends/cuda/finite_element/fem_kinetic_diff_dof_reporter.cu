@@ -0,0 +1,84 @@
+#include <finite_element/finite_element_diff_dof_reporter.h>
+#include <utils/matrix_unpacker.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Report the coupling of the current frame to the previous frames through the inertia
+ *
+ * The kinetic gradient is $M (x^{[i]} - \tilde{x}^{[i]})$, where
+ * $\tilde{x}^{[i]} = x^{[i-1]} + \Delta t v^{[i-1]} + \Delta t^2 g$ and $v^{[i-1]} = (x^{[i-1]} - x^{[i-2]}) / \Delta t$, so
+ *
+ * $$
+ * \frac{\partial G^{[i]}}{\partial X^{[i-1]}} = -2M, \quad \frac{\partial G^{[i]}}{\partial X^{[i-2]}} = M
+ * $$
+ *
+ * for the dynamic vertices, $-M$ and $0$ for the static vertices, and $0$ for the fixed vertices.
+ */
+class FEMKineticDiffDofReporter final : public FiniteElementDiffDofReporter
+{
+  public:
+    using FiniteElementDiffDofReporter::FiniteElementDiffDofReporter;
+
+    // the window holds the frames i-1, i-2 the inertia reaches
+    static SizeT coupled_frame_count(SizeT frame, SizeT first_frame)
+    {
+        return frame - first_frame;
+    }
+
+    virtual void do_build(BuildInfo& info) override {}
+
+    virtual void do_report_extent(DiffDofExtentInfo& info) override
+    {
+        auto vertex_count = fem().xs.size();
+        // a 3x3 block per vertex per coupled frame
+        info.triplet_count(vertex_count * 3 * 3
+                           * coupled_frame_count(info.frame(), info.first_frame()));
+    }
+
+    virtual void do_assemble(DiffDofInfo& info) override
+    {
+        using namespace muda;
+
+        auto frame        = info.frame();
+        auto vertex_count = fem().xs.size();
+        auto H            = info.H();
+
+        for(SizeT k = 1; k <= coupled_frame_count(frame, info.first_frame()); ++k)
+        {
+            IndexT row_offset = info.dof_offset(frame);
+            IndexT col_offset = info.dof_offset(frame - k);
+            auto   pGpX = H.subview((k - 1) * vertex_count * 3 * 3, vertex_count * 3 * 3);
+
+            ParallelFor()
+                .file_line(__FILE__, __LINE__)
+                .apply(vertex_count,
+                       [is_fixed   = fem().is_fixed.cviewer().name("is_fixed"),
+                        is_dynamic = fem().is_dynamic.cviewer().name("is_dynamic"),
+                        masses     = fem().masses.cviewer().name("masses"),
+                        pGpX       = pGpX.viewer().name("pGpX"),
+                        row_offset = row_offset,
+                        col_offset = col_offset,
+                        k          = k] __device__(int i) mutable
+                       {
+                           Float c = 0.0;
+                           if(!is_fixed(i))
+                           {
+                               if(is_dynamic(i))
+                                   c = k == 1 ? -2.0 : 1.0;
+                               else  // static: x_tilde doesn't depend on the velocity
+                                   c = k == 1 ? -1.0 : 0.0;
+                           }
+
+                           Matrix3x3 M = c * masses(i) * Matrix3x3::Identity();
+
+                           TripletMatrixUnpacker unpacker{pGpX};
+                           unpacker.block<3, 3>(i * 3 * 3).write(
+                               row_offset + i * 3, col_offset + i * 3, M);
+                       });
+        }
+    }
+};
+
+REGISTER_SIM_SYSTEM(FEMKineticDiffDofReporter);
+}  // namespace uipc::backend::cuda
@@ -18,6 +18,8 @@ void FEMLineSearchReporter::do_build(LineSearchReporter::BuildInfo& info)
     auto fea = find<FiniteElementAnimator>();
     if(fea)
         m_impl.finite_element_animator = *fea;
+
+    m_impl.energy_sum.deterministic(world().scene().info()["deterministic"]["enable"].get<bool>());
 }
 
 void FEMLineSearchReporter::do_record_start_point(LineSearcher::RecordInfo& info)
@@ -64,9 +66,8 @@ void FEMLineSearchReporter::Impl::compute_energy(LineSearcher::EnergyInfo& info)
     for(auto* producer : fem().energy_producers)
         producer->compute_energy(info);
 
-    DeviceReduce().Sum(fem().energy_producer_energies.data(),
-                       fem().energy_producer_energy.data(),
-                       fem().energy_producer_energies.size());
+    energy_sum.sum(std::as_const(fem().energy_producer_energies).view(),
+                   fem().energy_producer_energy.view());
 
     // copy back to host
     Float E = fem().energy_producer_energy;
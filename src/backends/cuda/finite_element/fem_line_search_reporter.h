@@ -3,6 +3,7 @@
 #include <line_search/line_search_reporter.h>
 #include <finite_element/finite_element_method.h>
 #include <finite_element/finite_element_animator.h>
+#include <algorithm/device_sum.h>
 
 namespace uipc::backend::cuda
 {
@@ -20,6 +21,7 @@ class FEMLineSearchReporter final : public LineSearchReporter
 
         SimSystemSlot<FiniteElementMethod>   finite_element_method;
         SimSystemSlot<FiniteElementAnimator> finite_element_animator;
+        DeviceSum                            energy_sum;
         FiniteElementMethod::Impl&           fem()
         {
             return finite_element_method->m_impl;
@@ -17,8 +17,9 @@ void FEMLinearSubsystem::do_build(DiagLinearSubsystem::BuildInfo&)
 {
     m_impl.finite_element_method = require<FiniteElementMethod>();
     m_impl.finite_element_vertex_reporter = require<FiniteElementVertexReporter>();
-    m_impl.sim_engine = &engine();
-    m_impl.dt         = world().scene().info()["dt"];
+    m_impl.sim_engine    = &engine();
+    m_impl.dt            = world().scene().info()["dt"];
+    m_impl.deterministic = world().scene().info()["deterministic"]["enable"];
 
     auto contact = find<FEMContactReceiver>();
     if(contact)
@@ -28,6 +29,7 @@ void FEMLinearSubsystem::do_build(DiagLinearSubsystem::BuildInfo&)
         m_impl.finite_element_animator = *animator;
 
     m_impl.converter.reserve_ratio(1.1);
+    m_impl.converter.deterministic(m_impl.deterministic);
 }
 
 void FEMLinearSubsystem::do_init(DiagLinearSubsystem::InitInfo& info) {}
@@ -160,6 +162,24 @@ void FEMLinearSubsystem::Impl::_assemble_producers(GlobalLinearSystem::DiagInfo&
 
     // need to assemble doublet gradient to dense gradient
     const auto& producer_gradients = fem().energy_producer_gradients;
+
+    if(deterministic)
+    {
+        // sum up the repeated vertices in a fixed order, then every vertex is written once
+        converter.convert(producer_gradients, bcoo_producer_gradients);
+
+        ParallelFor()
+            .file_line(__FILE__, __LINE__)
+            .apply(bcoo_producer_gradients.doublet_count(),
+                   [dst_gradient = info.gradient().viewer().name("dst_gradient"),
+                    src_gradient = std::as_const(bcoo_producer_gradients).viewer().name("src_gradient")] __device__(int I) mutable
+                   {
+                       auto&& [i, G3] = src_gradient(I);
+                       dst_gradient.segment<3>(i * 3).as_eigen() += G3;
+                   });
+        return;
+    }
+
     ParallelFor()
         .file_line(__FILE__, __LINE__)
         .apply(producer_gradients.doublet_count(),
@@ -55,13 +55,16 @@ class FEMLinearSubsystem final : public DiagLinearSubsystem
         SizeT animator_hessian_offset = 0;
         SizeT animator_hessian_count  = 0;
 
-        Float dt = 0.0;
+        Float dt            = 0.0;
+        bool  deterministic = false;
 
         Float reserve_ratio = 1.5;
 
         MatrixConverter<Float, 3>           converter;
         muda::DeviceTripletMatrix<Float, 3> triplet_A;
         muda::DeviceBCOOMatrix<Float, 3>    bcoo_A;
+        // the producer gradients summed up in a fixed order, only used in the deterministic mode
+        muda::DeviceBCOOVector<Float, 3> bcoo_producer_gradients;
     };
 
   private:
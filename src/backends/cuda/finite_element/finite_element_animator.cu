@@ -12,6 +12,8 @@ void FiniteElementAnimator::do_build(BuildInfo& info)
 {
     m_impl.finite_element_method = &require<FiniteElementMethod>();
     m_impl.global_animator       = &require<GlobalAnimator>();
+    m_impl.deterministic = world().scene().info()["deterministic"]["enable"].get<bool>();
+    m_impl.constraint_energy_sum.deterministic(m_impl.deterministic);
 }
 
 void FiniteElementAnimator::add_constraint(FiniteElementConstraint* constraint)
@@ -238,6 +240,47 @@ void FiniteElementAnimator::Impl::assemble(AssembleInfo& info)
     using namespace muda;
 
     // only need to setup gradient (from doublet vector to dense vector)
+    if(deterministic)
+    {
+        // every vertex sums up its gradients in a fixed order
+        SizeT vertex_count = fem().xs.size();
+        vertex_keys.resize(constraint_gradient.doublet_count());
+        ParallelFor()
+            .file_line(__FILE__, __LINE__)
+            .apply(constraint_gradient.doublet_count(),
+                   [anim_gradients = std::as_const(constraint_gradient).viewer().name("aim_gradients"),
+                    vertex_keys = vertex_keys.viewer().name("vertex_keys"),
+                    is_fixed    = fem().is_fixed.cviewer().name("is_fixed"),
+                    vertex_count = static_cast<IndexT>(vertex_count)] __device__(int I) mutable
+                   {
+                       const auto& [i, G3] = anim_gradients(I);
+                       vertex_keys(I)      = is_fixed(i) ? vertex_count : i;
+                   });
+
+        vertex_grouper.group(vertex_keys.view(), vertex_count);
+
+        ParallelFor()
+            .file_line(__FILE__, __LINE__)
+            .apply(vertex_count,
+                   [anim_gradients = std::as_const(constraint_gradient).viewer().name("aim_gradients"),
+                    gradient = info.gradients().viewer().name("gradient"),
+                    offsets  = vertex_grouper.offsets().cviewer().name("offsets"),
+                    items = vertex_grouper.items().cviewer().name("items")] __device__(int i) mutable
+                   {
+                       if(offsets(i) == offsets(i + 1))
+                           return;
+
+                       Vector3 G = Vector3::Zero();
+                       for(IndexT k = offsets(i); k < offsets(i + 1); ++k)
+                       {
+                           const auto& [vertex, G3] = anim_gradients(items(k));
+                           G += G3;
+                       }
+                       gradient.segment<3>(i * 3).as_eigen() += G;
+                   });
+        return;
+    }
+
     ParallelFor()
         .file_line(__FILE__, __LINE__)
         .apply(constraint_gradient.doublet_count(),
@@ -266,9 +309,8 @@ Float FiniteElementAnimator::compute_energy(LineSearcher::EnergyInfo& info)
         constraint->compute_energy(this_info);
     }
 
-    DeviceReduce().Sum(m_impl.constraint_energies.data(),
-                       m_impl.constraint_energy.data(),
-                       m_impl.constraint_energies.size());
+    m_impl.constraint_energy_sum.sum(std::as_const(m_impl.constraint_energies).view(),
+                                     m_impl.constraint_energy.view());
 
     // copy back to host
     Float E = m_impl.constraint_energy;
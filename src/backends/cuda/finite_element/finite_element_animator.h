@@ -3,6 +3,8 @@
 #include <finite_element/finite_element_method.h>
 #include <gradient_hessian_computer.h>
 #include <line_search/line_searcher.h>
+#include <algorithm/device_sum.h>
+#include <algorithm/key_grouper.h>
 #include <muda/ext/linear_system/device_dense_vector.h>
 #include <muda/ext/linear_system/device_doublet_vector.h>
 #include <muda/ext/linear_system/device_triplet_matrix.h>
@@ -157,6 +159,7 @@ class FiniteElementAnimator final : public Animator
         // Constraints
         muda::DeviceVar<Float> constraint_energy;  // Constraint Energy
         muda::DeviceBuffer<Float> constraint_energies;  // Constraint Energy Per Element
+        DeviceSum constraint_energy_sum;
         vector<SizeT> constraint_energy_offsets;
         vector<SizeT> constraint_energy_counts;
 
@@ -164,6 +167,11 @@ class FiniteElementAnimator final : public Animator
         vector<SizeT> constraint_gradient_offsets;
         vector<SizeT> constraint_gradient_counts;
 
+        // the constraint gradients grouped by vertices, only used in the deterministic mode
+        bool                       deterministic = false;
+        muda::DeviceBuffer<IndexT> vertex_keys;
+        KeyGrouper                 vertex_grouper;
+
         muda::DeviceTripletMatrix<Float, 3> constraint_hessian;  // Constraint Hessian Per Vertex
         vector<SizeT> constraint_hessian_offsets;
         vector<SizeT> constraint_hessian_counts;
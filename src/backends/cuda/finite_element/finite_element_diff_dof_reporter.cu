@@ -21,6 +21,11 @@ SizeT FiniteElementDiffDofReporter::DiffDofInfo::frame() const
     return m_global_info.frame();
 }
 
+SizeT FiniteElementDiffDofReporter::DiffDofInfo::first_frame() const
+{
+    return m_global_info.first_frame();
+}
+
 IndexT FiniteElementDiffDofReporter::DiffDofInfo::dof_offset(SizeT frame) const
 {
     // Frame Dof Offset + FEM Dof Offset => Frame FEM Dof Offset
@@ -31,6 +31,7 @@ class FiniteElementDiffDofReporter : public DiffDofReporter
         }
 
         SizeT  frame() const;
+        SizeT  first_frame() const;
         IndexT dof_offset(SizeT frame) const;
         IndexT dof_count(SizeT frame) const;
 
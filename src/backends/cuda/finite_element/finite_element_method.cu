@@ -14,6 +14,7 @@
 #include <ranges>
 #include <sim_engine.h>
 #include <utils/offset_count_collection.h>
+#include <utils/memory_usage.h>
 
 // kinetic
 #include <finite_element/finite_element_kinetic.h>
@@ -142,6 +143,22 @@ void FiniteElementMethod::do_clear_recover(RecoverInfo& info)
     m_impl.clear_recover(info);
 }
 
+SizeT FiniteElementMethod::get_memory_usage() const noexcept
+{
+    const auto& i = m_impl;
+    return memory_usage(i.codim_0ds) + memory_usage(i.codim_1ds)
+           + memory_usage(i.rest_lengths) + memory_usage(i.codim_2ds)
+           + memory_usage(i.rest_areas) + memory_usage(i.tets)
+           + memory_usage(i.rest_volumes) + memory_usage(i.is_fixed)
+           + memory_usage(i.is_dynamic) + memory_usage(i.gravities)
+           + memory_usage(i.x_bars) + memory_usage(i.xs) + memory_usage(i.dxs)
+           + memory_usage(i.x_temps) + memory_usage(i.vs) + memory_usage(i.x_tildes)
+           + memory_usage(i.x_prevs) + memory_usage(i.masses)
+           + memory_usage(i.thicknesses) + memory_usage(i.Dm3x3_invs)
+           + memory_usage(i.energy_producer_energies)
+           + memory_usage(i.energy_producer_gradients);
+}
+
 void FiniteElementMethod::Impl::init(WorldVisitor& world)
 {
     _init_dof_info();
@@ -1067,9 +1084,11 @@ void FiniteElementMethod::Impl::write_scene(WorldVisitor& world)
         std::copy(src_pos_span.begin(), src_pos_span.end(), pos_view.begin());
 
         // 2) write primitives back
-        // TODO:
-        // Now there is no topology modification, so no need to write back
-        // In the future, we may need to write back the topology if the topology is modified
+        // Now there is no topology modification, so no need to write back.
+        // A topology modifying feature (tearing, remeshing, ...) should collect the removed and inserted
+        // primitives of the geometry into a geometry::TopologyChange, and apply it before 1):
+        //   world.scene().apply_topology_change(geo_slot->id(), change);
+        // so that the positions are written to the geometry with the new vertex count.
     }
 }
 }  // namespace uipc::backend::cuda
@@ -498,6 +498,8 @@ class FiniteElementMethod final : public SimSystem
     virtual void do_apply_recover(RecoverInfo& info) override;
     virtual void do_clear_recover(RecoverInfo& info) override;
 
+    virtual SizeT get_memory_usage() const noexcept override;
+
     Impl m_impl;
 };
 }  // namespace uipc::backend::cuda
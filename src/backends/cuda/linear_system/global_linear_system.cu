@@ -5,6 +5,7 @@
 #include <linear_system/iterative_solver.h>
 #include <linear_system/global_preconditioner.h>
 #include <linear_system/local_preconditioner.h>
+#include <utils/memory_usage.h>
 #include <fstream>
 
 namespace uipc::backend::cuda
@@ -67,10 +68,21 @@ SizeT GlobalLinearSystem::dof_count() const
     return m_impl.b.size();
 }
 
-void GlobalLinearSystem::do_build() {}
+void GlobalLinearSystem::do_build()
+{
+    m_impl.deterministic = world().scene().info()["deterministic"]["enable"].get<bool>();
+    m_impl.converter.deterministic(m_impl.deterministic);
+}
+
+SizeT GlobalLinearSystem::get_memory_usage() const noexcept
+{
+    return memory_usage(m_impl.x) + memory_usage(m_impl.b)
+           + memory_usage(m_impl.triplet_A) + memory_usage(m_impl.bcoo_A);
+}
 
 void GlobalLinearSystem::solve()
 {
+    m_impl.last_iter_count = 0;
     m_impl.build_linear_system();
     // if the system is empty, skip the following steps
     if(m_impl.empty_system) [[unlikely]]
@@ -79,6 +91,11 @@ void GlobalLinearSystem::solve()
     m_impl.distribute_solution();
 }
 
+SizeT GlobalLinearSystem::last_iter_count() const noexcept
+{
+    return m_impl.last_iter_count;
+}
+
 void GlobalLinearSystem::prepare_hessian()
 {
     Timer timer{"Build Linear System"};
@@ -196,6 +213,8 @@ void GlobalLinearSystem::Impl::build_linear_system()
 
     converter.convert(triplet_A, bcoo_A);
     converter.ge2sym(bcoo_A);
+    if(deterministic)
+        spmver.prepare_fixed_order_sym_spmv(bcoo_A);
 
     _assemble_preconditioner();
 }
@@ -394,7 +413,7 @@ void GlobalLinearSystem::Impl::solve_linear_system()
         info.m_b = b.cview();
         info.m_x = x.view();
         iterative_solver->solve(info);
-        spdlog::info("Iterative linear solver iteration count: {}", info.m_iter_count);
+        last_iter_count = info.m_iter_count;
     }
 }
 
@@ -456,7 +475,10 @@ void GlobalLinearSystem::Impl::spmv(Float                         a,
                                     Float                         b,
                                     muda::DenseVectorView<Float>  y)
 {
-    spmver.rbk_sym_spmv(a, bcoo_A.cview(), x, b, y);
+    if(deterministic)
+        spmver.fixed_order_sym_spmv(a, bcoo_A.cview(), x, b, y);
+    else
+        spmver.rbk_sym_spmv(a, bcoo_A.cview(), x, b, y);
 }
 
 bool GlobalLinearSystem::Impl::accuracy_statisfied(muda::DenseVectorView<Float> r)
@@ -290,7 +290,9 @@ class GlobalLinearSystem : public SimSystem
         Spmv                      spmver;
         MatrixConverter<Float, 3> converter;
 
-        bool empty_system = true;
+        bool  empty_system    = true;
+        bool  deterministic   = false;
+        SizeT last_iter_count = 0;  // the iterations of the last solve
 
         void apply_preconditioner(muda::DenseVectorView<Float>  z,
                                   muda::CDenseVectorView<Float> r);
@@ -305,7 +307,8 @@ class GlobalLinearSystem : public SimSystem
     SizeT dof_count() const;
 
   protected:
-    void do_build() override;
+    void  do_build() override;
+    SizeT get_memory_usage() const noexcept override;
 
   private:
     friend class SimEngine;
@@ -329,6 +332,9 @@ class GlobalLinearSystem : public SimSystem
     // only be called by SimEngine::do_advance()
     void solve();
 
+    // the iteration count of the iterative solver in the last `solve()`, only be called by SimEngine::do_advance()
+    SizeT last_iter_count() const noexcept;
+
     // only be called by SimEngine::do_backward()
     // we just build a full hessian matrix for diff simulation
     void prepare_hessian();
@@ -416,4 +416,77 @@ void Spmv::rbk_sym_spmv(Float                           a,
                 }
             });
 }
+
+void Spmv::prepare_fixed_order_sym_spmv(const muda::DeviceBCOOMatrix<Float, 3>& A)
+{
+    using namespace muda;
+
+    SizeT block_rows = A.block_rows();
+
+    m_row_keys.resize(A.triplet_count());
+    m_col_keys.resize(A.triplet_count());
+
+    ParallelFor()
+        .file_line(__FILE__, __LINE__)
+        .apply(A.triplet_count(),
+               [A          = A.cviewer().name("A"),
+                row_keys   = m_row_keys.viewer().name("row_keys"),
+                col_keys   = m_col_keys.viewer().name("col_keys"),
+                block_rows = static_cast<IndexT>(block_rows)] __device__(int I) mutable
+               {
+                   auto&& [i, j, block] = A(I);
+                   row_keys(I)          = i;
+                   // the diagonal blocks are only added once, by their rows
+                   col_keys(I) = i != j ? j : block_rows;
+               });
+
+    m_rows.group(m_row_keys.view(), block_rows);
+    m_cols.group(m_col_keys.view(), block_rows);
+}
+
+void Spmv::fixed_order_sym_spmv(Float                           a,
+                                muda::CBCOOMatrixView<Float, 3> A,
+                                muda::CDenseVectorView<Float>   x,
+                                Float                           b,
+                                muda::DenseVectorView<Float>    y)
+{
+    using namespace muda;
+    constexpr int N = 3;
+
+    ParallelFor()
+        .file_line(__FILE__, __LINE__)
+        .apply(y.size() / N,
+               [a = a,
+                A = A.viewer().name("A"),
+                x = x.viewer().name("x"),
+                b = b,
+                y = y.viewer().name("y"),
+                row_offsets = m_rows.offsets().cviewer().name("row_offsets"),
+                row_items   = m_rows.items().cviewer().name("row_items"),
+                col_offsets = m_cols.offsets().cviewer().name("col_offsets"),
+                col_items = m_cols.items().cviewer().name("col_items")] __device__(int r) mutable
+               {
+                   Vector3 acc = Vector3::Zero();
+
+                   // the upper blocks of row r
+                   for(IndexT k = row_offsets(r); k < row_offsets(r + 1); ++k)
+                   {
+                       auto&& [i, j, block] = A(row_items(k));
+                       acc += block * x.segment<N>(j * N).as_eigen();
+                   }
+
+                   // the lower blocks of row r, the transposed upper blocks of column r
+                   for(IndexT k = col_offsets(r); k < col_offsets(r + 1); ++k)
+                   {
+                       auto&& [i, j, block] = A(col_items(k));
+                       acc += block.transpose() * x.segment<N>(i * N).as_eigen();
+                   }
+
+                   auto seg_y = y.segment<N>(r * N);
+                   if(b != 0)
+                       seg_y.as_eigen() = a * acc + b * seg_y.as_eigen();
+                   else
+                       seg_y.as_eigen() = a * acc;
+               });
+}
 }  // namespace uipc::backend::cuda
@@ -2,9 +2,11 @@
 #include <type_define.h>
 #include <muda/buffer/device_buffer.h>
 #include <muda/ext/linear_system/bcoo_matrix_view.h>
+#include <muda/ext/linear_system/device_bcoo_matrix.h>
 #include <muda/ext/linear_system/bsr_matrix_view.h>
 #include <muda/ext/linear_system/dense_vector_view.h>
 #include <muda/ext/linear_system/device_dense_vector.h>
+#include <algorithm/key_grouper.h>
 namespace uipc::backend::cuda
 {
 // calculate y = a * A * x + b * y
@@ -31,5 +33,23 @@ class Spmv
                       muda::CDenseVectorView<Float>   x,
                       Float                           b,
                       muda::DenseVectorView<Float>    y);
+
+    // group the blocks of A by rows and by columns for `fixed_order_sym_spmv()`, call it when A is rebuilt
+    void prepare_fixed_order_sym_spmv(const muda::DeviceBCOOMatrix<Float, 3>& A);
+
+    // symmetric bcoo spmv without atomics, every row of y is summed up by one thread in a fixed order,
+    // so the result is bitwise reproducible
+    void fixed_order_sym_spmv(Float                           a,
+                              muda::CBCOOMatrixView<Float, 3> A,
+                              muda::CDenseVectorView<Float>   x,
+                              Float                           b,
+                              muda::DenseVectorView<Float>    y);
+
+  private:
+    muda::DeviceBuffer<IndexT> m_row_keys;
+    muda::DeviceBuffer<IndexT> m_col_keys;
+    KeyGrouper                 m_rows;
+    // the off-diagonal blocks of each column, they are added to y transposed
+    KeyGrouper m_cols;
 };
 }  // namespace uipc::backend::cuda
@@ -4,6 +4,7 @@
 #include <sim_engine_state.h>
 #include <backends/common/sim_engine.h>
 #include <sim_action_collection.h>
+#include <uipc/core/frame_statistics_feature.h>
 
 namespace uipc::backend::cuda
 {
@@ -19,6 +20,7 @@ class GradientHessianComputer;
 class GlobalLinearSystem;
 class GlobalAnimator;
 class GlobalDiffSimManager;
+class SimEngineFrameSystem;
 class AffineBodyDynamics;
 class FiniteElementMethod;
 class InterAffineBodyConstitutionManager;
@@ -99,5 +101,9 @@ class SimEngine final : public backend::SimEngine
     SizeT m_last_solved_frame   = 0;
     bool  m_strict_mode         = false;
     Float m_ccd_tol             = 1;
+
+    S<core::FrameStatisticsFeature> m_frame_statistics;
+    // the provider of the adjoint method feature, only if diff_sim is enabled
+    U<SimEngineFrameSystem> m_frame_system;
 };
 }  // namespace uipc::backend::cuda
\ No newline at end of file
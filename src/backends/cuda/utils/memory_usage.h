@@ -0,0 +1,39 @@
+#pragma once
+#include <type_define.h>
+#include <muda/buffer/device_buffer.h>
+#include <muda/ext/linear_system/device_dense_vector.h>
+#include <muda/ext/linear_system/device_doublet_vector.h>
+#include <muda/ext/linear_system/device_triplet_matrix.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief The bytes of device memory held by the muda containers, including the reserved capacity,
+ * used by `ISimSystem::get_memory_usage()`.
+ */
+template <typename T>
+SizeT memory_usage(const muda::DeviceBuffer<T>& buffer) noexcept
+{
+    return buffer.capacity() * sizeof(T);
+}
+
+template <typename T, int N>
+SizeT memory_usage(const muda::DeviceTripletMatrix<T, N>& m) noexcept
+{
+    // block value + row index + col index
+    return m.triplet_capacity() * (sizeof(Eigen::Matrix<T, N, N>) + 2 * sizeof(int));
+}
+
+template <typename T, int N>
+SizeT memory_usage(const muda::DeviceDoubletVector<T, N>& v) noexcept
+{
+    // segment value + index
+    return v.doublet_capacity() * (sizeof(Eigen::Matrix<T, N, 1>) + sizeof(int));
+}
+
+template <typename T>
+SizeT memory_usage(const muda::DeviceDenseVector<T>& v) noexcept
+{
+    return v.size() * sizeof(T);
+}
+}  // namespace uipc::backend::cuda
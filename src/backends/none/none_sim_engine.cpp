@@ -23,6 +23,9 @@ void NoneSimEngine::do_init(InitInfo& info)
 
     m_system = &require<NoneSimSystem>();
 
+    m_frame_statistics = uipc::make_shared<core::FrameStatisticsFeature>();
+    features().insert(m_frame_statistics);
+
     dump_system_info();
 }
 
@@ -30,6 +33,16 @@ void NoneSimEngine::do_advance()
 {
     m_frame++;
     spdlog::info("[NoneEngine] do_advance() called.");
+
+    // fill the statistics with dummy values, so that the tools can be tested without a real solver
+    core::FrameStatisticsRecord record;
+    record.frame                    = m_frame;
+    record.newton_iterations        = static_cast<IndexT>(1 + m_frame % 4);
+    record.line_search_iterations   = record.newton_iterations;
+    record.linear_solver_iterations = 10 * record.newton_iterations;
+    record.contact_candidates       = 100 * m_frame;
+    record.active_contacts          = record.contact_candidates / 10;
+    m_frame_statistics->push(record);
 }
 
 void NoneSimEngine::do_sync()
@@ -1,6 +1,7 @@
 #pragma once
 #include <uipc/backend/macro.h>
 #include <backends/common/sim_engine.h>
+#include <uipc/core/frame_statistics_feature.h>
 
 namespace uipc::backend::none
 {
@@ -24,7 +25,8 @@ class NoneSimEngine final : public SimEngine
     void  do_retrieve() override;
     SizeT get_frame() const override;
 
-    NoneSimSystem* m_system = nullptr;
-    SizeT          m_frame  = 0;
+    NoneSimSystem*                  m_system = nullptr;
+    SizeT                           m_frame  = 0;
+    S<core::FrameStatisticsFeature> m_frame_statistics;
 };
 }  // namespace uipc::backend::none
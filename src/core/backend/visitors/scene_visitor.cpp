@@ -66,6 +66,41 @@ span<IndexT> SceneVisitor::pending_destroy_ids() const noexcept
     return m_scene.geometries().pending_destroy_ids();
 }
 
+void SceneVisitor::apply_topology_change(IndexT id, const geometry::TopologyChange& change)
+{
+    if(change.empty())
+        return;
+
+    auto as_simplicial_complex = [&](S<geometry::GeometrySlot> slot) -> geometry::SimplicialComplex&
+    {
+        if(!slot)
+            throw geometry::TopologyChangeError{
+                fmt::format("Geometry ({}) does not exist.", id)};
+
+        auto sc = slot->geometry().as<geometry::SimplicialComplex>();
+        if(!sc)
+            throw geometry::TopologyChangeError{
+                fmt::format("Geometry ({}) is not a SimplicialComplex (it's {}).",
+                            id,
+                            slot->geometry().type())};
+        return *sc;
+    };
+
+    auto& geo      = as_simplicial_complex(m_scene.geometries().find(id));
+    auto& rest_geo = as_simplicial_complex(m_scene.rest_geometries().find(id));
+
+    // the change is validated against `geo`, so the rest geometry must have the same simplex counts
+    if(geo.vertices().size() != rest_geo.vertices().size()
+       || geo.edges().size() != rest_geo.edges().size()
+       || geo.triangles().size() != rest_geo.triangles().size()
+       || geo.tetrahedra().size() != rest_geo.tetrahedra().size())
+        throw geometry::TopologyChangeError{fmt::format(
+            "Geometry ({}) and its rest geometry have different simplex counts.", id)};
+
+    geometry::apply_topology_change(geo, change);
+    geometry::apply_topology_change(rest_geo, change);
+}
+
 const Json& SceneVisitor::info() const noexcept
 {
     return m_scene.config();
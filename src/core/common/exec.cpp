@@ -0,0 +1,309 @@
+#include <uipc/common/exec.h>
+#include <uipc/common/uipc.h>
+#include <uipc/common/log.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace uipc::exec
+{
+SizeT IExecutor::concurrency() const noexcept
+{
+    return get_concurrency();
+}
+
+void IExecutor::bulk(SizeT count, const std::function<void(SizeT)>& task)
+{
+    if(count == 0)
+        return;
+    do_bulk(count, task);
+}
+
+SizeT SerialExecutor::get_concurrency() const noexcept
+{
+    return 1;
+}
+
+void SerialExecutor::do_bulk(SizeT count, const std::function<void(SizeT)>& task)
+{
+    for(SizeT i = 0; i < count; ++i)
+        task(i);
+}
+
+class ThreadPool::Impl
+{
+    // one bulk() call
+    struct Job
+    {
+        const std::function<void(SizeT)>* task = nullptr;
+        std::atomic<SizeT>                remaining;
+        std::mutex                        error_mutex;
+        std::exception_ptr                error;
+    };
+
+    // the tasks [begin, end) of a job
+    struct Range
+    {
+        Job*  job   = nullptr;
+        SizeT begin = 0;
+        SizeT end   = 0;
+    };
+
+    struct Queue
+    {
+        std::mutex        mutex;
+        std::deque<Range> ranges;
+    };
+
+    // the queue of the current thread, if it's a worker of this pool
+    static thread_local const Impl* tl_pool;
+    static thread_local SizeT       tl_queue;
+
+  public:
+    explicit Impl(SizeT threads)
+    {
+        if(threads == 0)
+            threads = std::max<SizeT>(std::thread::hardware_concurrency(), 1);
+
+        // the workers and the calling thread, the last queue is shared by the threads out of the pool
+        SizeT workers = threads - 1;
+        m_queues.resize(workers + 1);
+        for(auto& q : m_queues)
+            q = uipc::make_unique<Queue>();
+
+        m_threads.reserve(workers);
+        for(SizeT i = 0; i < workers; ++i)
+            m_threads.emplace_back([this, i] { work(i); });
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard lock{m_sleep_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for(auto& t : m_threads)
+            t.join();
+    }
+
+    SizeT concurrency() const noexcept { return m_threads.size() + 1; }
+
+    void bulk(SizeT count, const std::function<void(SizeT)>& task)
+    {
+        Job job;
+        job.task = &task;
+        job.remaining.store(count, std::memory_order_relaxed);
+
+        SizeT q = tl_pool == this ? tl_queue : m_queues.size() - 1;
+        push(q, {&job, 0, count});
+
+        // help until all the tasks of the job are done, sleep while the rest of them are running on the other threads
+        while(job.remaining.load(std::memory_order_acquire) > 0)
+        {
+            if(try_run(q))
+                continue;
+
+            std::unique_lock lock{m_sleep_mutex};
+            m_wake.wait(lock,
+                        [&]
+                        {
+                            return job.remaining.load(std::memory_order_acquire) == 0
+                                   || m_queued.load(std::memory_order_acquire) > 0;
+                        });
+        }
+
+        if(job.error)
+            std::rethrow_exception(job.error);
+    }
+
+  private:
+    vector<U<Queue>>        m_queues;
+    vector<std::thread>     m_threads;
+    std::atomic<SizeT>      m_queued = 0;
+    std::mutex              m_sleep_mutex;
+    std::condition_variable m_wake;
+    bool                    m_stop = false;
+
+    void push(SizeT q, const Range& range)
+    {
+        // count it first, so `m_queued` is never less than the queued ranges
+        m_queued.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard lock{m_queues[q]->mutex};
+            m_queues[q]->ranges.push_back(range);
+        }
+        {
+            // a worker checks `m_queued` under the lock before sleeping, so it can't miss the notification
+            std::lock_guard lock{m_sleep_mutex};
+        }
+        m_wake.notify_one();
+    }
+
+    // the owner takes the latest range from the back
+    bool pop(SizeT q, Range& range)
+    {
+        auto&           queue = *m_queues[q];
+        std::lock_guard lock{queue.mutex};
+        if(queue.ranges.empty())
+            return false;
+        range = queue.ranges.back();
+        queue.ranges.pop_back();
+        return true;
+    }
+
+    // a thief takes the oldest (largest) range from the front
+    bool steal(SizeT thief, Range& range)
+    {
+        for(SizeT k = 1; k < m_queues.size(); ++k)
+        {
+            auto&           queue = *m_queues[(thief + k) % m_queues.size()];
+            std::lock_guard lock{queue.mutex};
+            if(queue.ranges.empty())
+                continue;
+            range = queue.ranges.front();
+            queue.ranges.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool try_run(SizeT q)
+    {
+        Range range;
+        if(!pop(q, range) && !steal(q, range))
+            return false;
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        run(q, range);
+        return true;
+    }
+
+    void run(SizeT q, Range range)
+    {
+        // keep the first half, leave the other half to the thieves
+        while(range.end - range.begin > 1)
+        {
+            SizeT mid = range.begin + (range.end - range.begin) / 2;
+            push(q, {range.job, mid, range.end});
+            range.end = mid;
+        }
+
+        auto job = range.job;
+        try
+        {
+            (*job->task)(range.begin);
+        }
+        catch(...)
+        {
+            std::lock_guard lock{job->error_mutex};
+            if(!job->error)
+                job->error = std::current_exception();
+        }
+        if(job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // the job lives on the stack of the waiting thread, don't touch it after the last task is done
+            {
+                std::lock_guard lock{m_sleep_mutex};
+            }
+            m_wake.notify_all();
+        }
+    }
+
+    void work(SizeT q)
+    {
+        tl_pool  = this;
+        tl_queue = q;
+
+        while(true)
+        {
+            if(try_run(q))
+                continue;
+
+            std::unique_lock lock{m_sleep_mutex};
+            m_wake.wait(lock,
+                        [&]
+                        {
+                            return m_stop || m_queued.load(std::memory_order_acquire) > 0;
+                        });
+            if(m_stop)
+                return;
+        }
+    }
+};
+
+thread_local const ThreadPool::Impl* ThreadPool::Impl::tl_pool  = nullptr;
+thread_local SizeT                   ThreadPool::Impl::tl_queue = 0;
+
+ThreadPool::ThreadPool(SizeT threads)
+    : m_impl{uipc::make_unique<Impl>(threads)}
+{
+}
+
+ThreadPool::~ThreadPool() = default;
+
+SizeT ThreadPool::get_concurrency() const noexcept
+{
+    return m_impl->concurrency();
+}
+
+void ThreadPool::do_bulk(SizeT count, const std::function<void(SizeT)>& task)
+{
+    if(count == 1)
+    {
+        task(0);
+        return;
+    }
+    m_impl->bulk(count, task);
+}
+
+static std::mutex   executor_mutex;
+static S<IExecutor> current_executor;
+static bool         is_default_executor = false;
+
+static S<IExecutor> create_default_executor()
+{
+    SizeT threads = 0;
+    auto& config  = uipc::config();
+    if(auto exec = config.find("exec"); exec != config.end())
+        threads = exec->value("threads", SizeT{0});
+
+    if(threads == 0)
+        threads = std::max<SizeT>(std::thread::hardware_concurrency(), 1);
+
+    if(threads == 1)
+        return uipc::make_shared<SerialExecutor>();
+    return uipc::make_shared<ThreadPool>(threads);
+}
+
+S<IExecutor> executor()
+{
+    std::lock_guard lock{executor_mutex};
+    if(!current_executor)
+    {
+        current_executor    = create_default_executor();
+        is_default_executor = true;
+    }
+    return current_executor;
+}
+
+void set_executor(S<IExecutor> executor)
+{
+    std::lock_guard lock{executor_mutex};
+    is_default_executor = executor == nullptr;
+    current_executor    = std::move(executor);
+}
+
+namespace detail
+{
+    void reset_default_executor()
+    {
+        std::lock_guard lock{executor_mutex};
+        // keep the executor set by the application
+        if(is_default_executor)
+            current_executor = nullptr;
+    }
+}  // namespace detail
+}  // namespace uipc::exec
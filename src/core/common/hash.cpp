@@ -0,0 +1,113 @@
+#include <uipc/common/hash.h>
+
+namespace uipc
+{
+namespace
+{
+    constexpr U64 P1 = 11400714785074694791ull;
+    constexpr U64 P2 = 14029467366897019727ull;
+    constexpr U64 P3 = 1609587929392839161ull;
+    constexpr U64 P4 = 9650029242287828579ull;
+    constexpr U64 P5 = 2870177450012600261ull;
+
+    constexpr U64 rotl(U64 x, int r) noexcept
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // little endian loads, as the reference implementation
+    U64 read64(const unsigned char* p) noexcept
+    {
+        U64 v = 0;
+        for(int i = 0; i < 8; ++i)
+            v |= static_cast<U64>(p[i]) << (8 * i);
+        return v;
+    }
+
+    U64 read32(const unsigned char* p) noexcept
+    {
+        U64 v = 0;
+        for(int i = 0; i < 4; ++i)
+            v |= static_cast<U64>(p[i]) << (8 * i);
+        return v;
+    }
+
+    constexpr U64 round(U64 acc, U64 input) noexcept
+    {
+        acc += input * P2;
+        acc = rotl(acc, 31);
+        return acc * P1;
+    }
+
+    constexpr U64 merge_round(U64 acc, U64 val) noexcept
+    {
+        acc ^= round(0, val);
+        return acc * P1 + P4;
+    }
+}  // namespace
+
+U64 xxhash64(const void* data, SizeT size, U64 seed) noexcept
+{
+    auto        p   = static_cast<const unsigned char*>(data);
+    const auto* end = p + size;
+    U64         h;
+
+    if(size >= 32)
+    {
+        U64 v1 = seed + P1 + P2;
+        U64 v2 = seed + P2;
+        U64 v3 = seed;
+        U64 v4 = seed - P1;
+
+        const auto* limit = end - 32;
+        do
+        {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+            p += 32;
+        } while(p <= limit);
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge_round(h, v1);
+        h = merge_round(h, v2);
+        h = merge_round(h, v3);
+        h = merge_round(h, v4);
+    }
+    else
+    {
+        h = seed + P5;
+    }
+
+    h += static_cast<U64>(size);
+
+    while(p + 8 <= end)
+    {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * P1 + P4;
+        p += 8;
+    }
+
+    if(p + 4 <= end)
+    {
+        h ^= read32(p) * P1;
+        h = rotl(h, 23) * P2 + P3;
+        p += 4;
+    }
+
+    while(p < end)
+    {
+        h ^= static_cast<U64>(*p) * P5;
+        h = rotl(h, 11) * P1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+}  // namespace uipc
@@ -0,0 +1,1296 @@
+#include <uipc/common/json_stream.h>
+#include <uipc/common/json_eigen.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/unordered_map.h>
+#include <uipc/common/log.h>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+namespace uipc
+{
+static_assert(std::endian::native == std::endian::little,
+              "BSON encoding assumes a little-endian host");
+
+namespace
+{
+    template <typename T>
+    void append_bytes(std::string& out, T v)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    template <typename T>
+    void append_chars(std::string& out, T v)
+    {
+        char buf[32];
+        auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, end);
+    }
+
+    constexpr char BsonDouble   = 0x01;
+    constexpr char BsonString   = 0x02;
+    constexpr char BsonDocument = 0x03;
+    constexpr char BsonArray    = 0x04;
+    constexpr char BsonBoolean  = 0x08;
+    constexpr char BsonNull     = 0x0A;
+    constexpr char BsonInt32    = 0x10;
+    constexpr char BsonInt64    = 0x12;
+}  // namespace
+
+/**************************************************************
+*                       JsonStreamEncoder
+***************************************************************/
+
+JsonStreamEncoder::JsonStreamEncoder(JsonFormat format, std::string& out, int indent)
+    : m_format(format)
+    , m_out(out)
+    , m_indent(indent)
+{
+}
+
+JsonFormat JsonStreamEncoder::format() const noexcept
+{
+    return m_format;
+}
+
+void JsonStreamEncoder::newline(SizeT depth)
+{
+    if(m_indent < 0)
+        return;
+    m_out += '\n';
+    m_out.append(depth * m_indent, ' ');
+}
+
+void JsonStreamEncoder::element_header(char bson_type)
+{
+    if(m_format == JsonFormat::Json)
+    {
+        if(m_frames.empty())
+            return;
+
+        auto& frame = m_frames.back();
+        if(frame.array)
+        {
+            if(frame.count > 0)
+                m_out += ',';
+            newline(m_frames.size());
+            ++frame.count;
+        }
+        else
+        {
+            UIPC_ASSERT(m_has_key, "A value in an object must follow a key.");
+            m_has_key = false;
+        }
+        return;
+    }
+
+    if(m_frames.empty())
+    {
+        // the root document of a BSON file has no element header
+        if(!m_root_document)
+            m_out += bson_type;
+        return;
+    }
+
+    auto& frame = m_frames.back();
+    m_out += bson_type;
+    if(frame.array)
+    {
+        append_chars(m_out, frame.count);
+    }
+    else
+    {
+        UIPC_ASSERT(m_has_key, "A value in an object must follow a key.");
+        m_out += m_key;
+        m_has_key = false;
+    }
+    m_out += '\0';
+    ++frame.count;
+}
+
+void JsonStreamEncoder::write_json_string(std::string_view v)
+{
+    m_out += '"';
+    for(char c : v)
+    {
+        switch(c)
+        {
+            case '"':
+                m_out += "\\\"";
+                break;
+            case '\\':
+                m_out += "\\\\";
+                break;
+            case '\b':
+                m_out += "\\b";
+                break;
+            case '\f':
+                m_out += "\\f";
+                break;
+            case '\n':
+                m_out += "\\n";
+                break;
+            case '\r':
+                m_out += "\\r";
+                break;
+            case '\t':
+                m_out += "\\t";
+                break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                    m_out += fmt::format("\\u{:04x}", static_cast<int>(c));
+                else
+                    m_out += c;
+                break;
+        }
+    }
+    m_out += '"';
+}
+
+void JsonStreamEncoder::null()
+{
+    element_header(BsonNull);
+    if(m_format == JsonFormat::Json)
+        m_out += "null";
+}
+
+void JsonStreamEncoder::boolean(bool v)
+{
+    element_header(BsonBoolean);
+    if(m_format == JsonFormat::Json)
+        m_out += v ? "true" : "false";
+    else
+        m_out += static_cast<char>(v ? 1 : 0);
+}
+
+void JsonStreamEncoder::number_integer(I64 v)
+{
+    if(m_format == JsonFormat::Json)
+    {
+        element_header(0);
+        append_chars(m_out, v);
+        return;
+    }
+
+    if(v >= std::numeric_limits<I32>::min() && v <= std::numeric_limits<I32>::max())
+    {
+        element_header(BsonInt32);
+        append_bytes(m_out, static_cast<I32>(v));
+    }
+    else
+    {
+        element_header(BsonInt64);
+        append_bytes(m_out, v);
+    }
+}
+
+void JsonStreamEncoder::number_unsigned(U64 v)
+{
+    if(m_format == JsonFormat::Json)
+    {
+        element_header(0);
+        append_chars(m_out, v);
+        return;
+    }
+
+    if(v > static_cast<U64>(std::numeric_limits<I64>::max()))
+        throw JsonIOError{fmt::format("Integer {} can not be represented by BSON as it does not fit int64", v)};
+    number_integer(static_cast<I64>(v));
+}
+
+void JsonStreamEncoder::number_float(double v)
+{
+    element_header(BsonDouble);
+    if(m_format == JsonFormat::Bson)
+    {
+        append_bytes(m_out, v);
+        return;
+    }
+
+    if(!std::isfinite(v))
+    {
+        // the same as Json::dump()
+        m_out += "null";
+        return;
+    }
+
+    SizeT begin = m_out.size();
+    append_chars(m_out, v);
+    // keep it a float when read back
+    if(m_out.find_first_of(".e", begin) == std::string::npos)
+        m_out += ".0";
+}
+
+void JsonStreamEncoder::string(std::string_view v)
+{
+    element_header(BsonString);
+    if(m_format == JsonFormat::Json)
+    {
+        write_json_string(v);
+        return;
+    }
+    append_bytes(m_out, static_cast<I32>(v.size() + 1));
+    m_out += v;
+    m_out += '\0';
+}
+
+void JsonStreamEncoder::start_object()
+{
+    element_header(BsonDocument);
+    Frame frame;
+    frame.begin = m_flushed + m_out.size();
+    frame.array = false;
+    if(m_format == JsonFormat::Json)
+        m_out += '{';
+    else
+        append_bytes(m_out, I32{0});
+    m_frames.push_back(frame);
+}
+
+void JsonStreamEncoder::key(std::string_view k)
+{
+    UIPC_ASSERT(!m_frames.empty() && !m_frames.back().array, "A key must be in an object.");
+
+    m_has_key = true;
+    if(m_format == JsonFormat::Bson)
+    {
+        m_key = k;
+        return;
+    }
+
+    auto& frame = m_frames.back();
+    if(frame.count > 0)
+        m_out += ',';
+    newline(m_frames.size());
+    write_json_string(k);
+    m_out += m_indent >= 0 ? ": " : ":";
+    ++frame.count;
+}
+
+void JsonStreamEncoder::end_object()
+{
+    UIPC_ASSERT(!m_frames.empty() && !m_frames.back().array, "No object to end.");
+    if(m_format == JsonFormat::Bson)
+    {
+        close_document();
+        return;
+    }
+    auto count = m_frames.back().count;
+    m_frames.pop_back();
+    if(count > 0)
+        newline(m_frames.size());
+    m_out += '}';
+}
+
+void JsonStreamEncoder::start_array()
+{
+    element_header(BsonArray);
+    Frame frame;
+    frame.begin = m_flushed + m_out.size();
+    frame.array = true;
+    if(m_format == JsonFormat::Json)
+        m_out += '[';
+    else
+        append_bytes(m_out, I32{0});
+    m_frames.push_back(frame);
+}
+
+void JsonStreamEncoder::end_array()
+{
+    UIPC_ASSERT(!m_frames.empty() && m_frames.back().array, "No array to end.");
+    if(m_format == JsonFormat::Bson)
+    {
+        close_document();
+        return;
+    }
+    auto count = m_frames.back().count;
+    m_frames.pop_back();
+    if(count > 0)
+        newline(m_frames.size());
+    m_out += ']';
+}
+
+void JsonStreamEncoder::close_document()
+{
+    m_out += '\0';
+    auto  begin = m_frames.back().begin;
+    SizeT end   = m_flushed + m_out.size();
+    auto  size  = static_cast<I32>(end - begin);
+    if(begin >= m_flushed)
+        std::memcpy(m_out.data() + (begin - m_flushed), &size, sizeof(size));
+    else  // the beginning has been written out, patch it later
+        m_patches.push_back({begin, size});
+    m_frames.pop_back();
+}
+
+void JsonStreamEncoder::value(const Json& j)
+{
+    switch(j.type())
+    {
+        case Json::value_t::null:
+            null();
+            break;
+        case Json::value_t::boolean:
+            boolean(j.get<bool>());
+            break;
+        case Json::value_t::number_integer:
+            number_integer(j.get<I64>());
+            break;
+        case Json::value_t::number_unsigned:
+            number_unsigned(j.get<U64>());
+            break;
+        case Json::value_t::number_float:
+            number_float(j.get<double>());
+            break;
+        case Json::value_t::string:
+            string(j.get_ref<const std::string&>());
+            break;
+        case Json::value_t::object:
+            start_object();
+            for(auto&& [k, v] : j.items())
+            {
+                key(k);
+                value(v);
+            }
+            end_object();
+            break;
+        case Json::value_t::array:
+            start_array();
+            for(auto& v : j)
+                value(v);
+            end_array();
+            break;
+        default:
+            throw JsonIOError{fmt::format("Json type `{}` is not supported by JsonStreamEncoder",
+                                          j.type_name())};
+    }
+}
+
+void JsonStreamEncoder::raw(std::string_view encoded)
+{
+    if(encoded.empty())
+        return;
+
+    if(m_format == JsonFormat::Json)
+    {
+        element_header(0);
+        m_out += encoded;
+    }
+    else
+    {
+        // the first byte is the element type
+        element_header(encoded.front());
+        m_out += encoded.substr(1);
+    }
+}
+
+/**************************************************************
+*                       JsonStreamWriter
+***************************************************************/
+
+class JsonStreamWriter::Impl
+{
+  public:
+    // flush the buffer to the stream every so often
+    static constexpr SizeT FlushSize = 1 << 22;
+
+    struct Deferred
+    {
+        SizeT          count = 0;
+        ElementEncoder encoder;
+    };
+
+    Impl(std::ostream& os, JsonFormat format, int indent)
+        : m_os(os)
+        , m_format(format)
+        , m_encoder(format, m_buffer, indent)
+    {
+        m_encoder.m_root_document = true;
+    }
+
+    void defer(const Json& node, SizeT count, ElementEncoder encoder)
+    {
+        m_deferred[&node] = Deferred{count, std::move(encoder)};
+    }
+
+    void write(const Json& document)
+    {
+        if(m_format == JsonFormat::Bson && !document.is_object())
+            throw JsonIOError{"The root of a BSON document must be an object"};
+
+        m_base     = m_os.tellp();
+        m_seekable = m_base != std::streampos(-1);
+
+        walk(document);
+        flush(true);
+
+        if(!m_encoder.m_patches.empty())
+        {
+            auto end = m_os.tellp();
+            for(auto&& [offset, size] : m_encoder.m_patches)
+            {
+                m_os.seekp(m_base + static_cast<std::streamoff>(offset));
+                m_os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            }
+            m_os.seekp(end);
+            m_encoder.m_patches.clear();
+        }
+
+        if(!m_os)
+            throw JsonIOError{"Failed to write the json stream"};
+    }
+
+  private:
+    void walk(const Json& j)
+    {
+        auto it = m_deferred.find(&j);
+        if(it != m_deferred.end())
+        {
+            write_deferred(it->second);
+            return;
+        }
+
+        switch(j.type())
+        {
+            case Json::value_t::object:
+                m_encoder.start_object();
+                for(auto&& [k, v] : j.items())
+                {
+                    m_encoder.key(k);
+                    walk(v);
+                }
+                m_encoder.end_object();
+                break;
+            case Json::value_t::array:
+                m_encoder.start_array();
+                for(auto& v : j)
+                    walk(v);
+                m_encoder.end_array();
+                break;
+            default:
+                m_encoder.value(j);
+                break;
+        }
+        try_flush();
+    }
+
+    void write_deferred(const Deferred& d)
+    {
+        const SizeT batch = exec::executor()->concurrency();
+
+        vector<std::string> encoded(std::min(batch, d.count));
+
+        m_encoder.start_array();
+        for(SizeT b = 0; b < d.count; b += batch)
+        {
+            SizeT n = std::min(batch, d.count - b);
+            parallel_for(
+                0,
+                n,
+                [&](SizeT i)
+                {
+                    encoded[i].clear();
+                    JsonStreamEncoder e{m_format, encoded[i]};
+                    d.encoder(b + i, e);
+                },
+                1);
+
+            for(SizeT i = 0; i < n; ++i)
+            {
+                m_encoder.raw(encoded[i]);
+                try_flush();
+            }
+        }
+        m_encoder.end_array();
+    }
+
+    void try_flush()
+    {
+        if(m_buffer.size() >= FlushSize)
+            flush(false);
+    }
+
+    void flush(bool last)
+    {
+        // without seeking, the BSON sizes can't be patched, keep everything until the end
+        if(!last && m_format == JsonFormat::Bson && !m_seekable)
+            return;
+
+        m_os.write(m_buffer.data(), m_buffer.size());
+        m_encoder.m_flushed += m_buffer.size();
+        m_buffer.clear();
+    }
+
+    std::ostream&     m_os;
+    JsonFormat        m_format;
+    std::string       m_buffer;
+    JsonStreamEncoder m_encoder;
+    std::streampos    m_base;
+    bool              m_seekable = false;
+
+    unordered_map<const Json*, Deferred> m_deferred;
+};
+
+JsonStreamWriter::JsonStreamWriter(std::ostream& os, JsonFormat format, int indent)
+    : m_impl{uipc::make_unique<Impl>(os, format, indent)}
+{
+}
+
+JsonStreamWriter::~JsonStreamWriter() {}
+
+void JsonStreamWriter::defer(const Json& node, SizeT count, ElementEncoder encoder)
+{
+    m_impl->defer(node, count, std::move(encoder));
+}
+
+void JsonStreamWriter::write(const Json& document)
+{
+    m_impl->write(document);
+}
+
+/**************************************************************
+*                       JsonSaxDomBuilder
+***************************************************************/
+
+template <typename V>
+Json* JsonSaxDomBuilder::emplace(V&& v)
+{
+    if(!m_started)
+    {
+        m_started = true;
+        m_root    = Json(std::forward<V>(v));
+        return &m_root;
+    }
+
+    UIPC_ASSERT(!m_stack.empty(), "The json subtree is already complete.");
+
+    auto top = m_stack.back();
+    if(top->is_array())
+    {
+        top->emplace_back(std::forward<V>(v));
+        return &top->back();
+    }
+
+    UIPC_ASSERT(m_slot, "A value in an object must follow a key.");
+    *m_slot   = Json(std::forward<V>(v));
+    auto slot = m_slot;
+    m_slot    = nullptr;
+    return slot;
+}
+
+bool JsonSaxDomBuilder::null()
+{
+    emplace(nullptr);
+    return true;
+}
+
+bool JsonSaxDomBuilder::boolean(bool v)
+{
+    emplace(v);
+    return true;
+}
+
+bool JsonSaxDomBuilder::number_integer(I64 v)
+{
+    emplace(v);
+    return true;
+}
+
+bool JsonSaxDomBuilder::number_unsigned(U64 v)
+{
+    emplace(v);
+    return true;
+}
+
+bool JsonSaxDomBuilder::number_float(double v)
+{
+    emplace(v);
+    return true;
+}
+
+bool JsonSaxDomBuilder::string(std::string& v)
+{
+    emplace(std::move(v));
+    return true;
+}
+
+bool JsonSaxDomBuilder::start_object()
+{
+    m_stack.push_back(emplace(Json::value_t::object));
+    return true;
+}
+
+bool JsonSaxDomBuilder::key(std::string& k)
+{
+    m_slot = &(*m_stack.back())[k];
+    return true;
+}
+
+bool JsonSaxDomBuilder::end_object()
+{
+    m_stack.pop_back();
+    return true;
+}
+
+bool JsonSaxDomBuilder::start_array()
+{
+    m_stack.push_back(emplace(Json::value_t::array));
+    return true;
+}
+
+bool JsonSaxDomBuilder::end_array()
+{
+    m_stack.pop_back();
+    return true;
+}
+
+bool JsonSaxDomBuilder::done() const noexcept
+{
+    return m_started && m_stack.empty();
+}
+
+Json& JsonSaxDomBuilder::result() noexcept
+{
+    return m_root;
+}
+
+/**************************************************************
+*                       JsonStreamReader
+***************************************************************/
+
+class JsonStreamReader::Impl
+{
+  public:
+    vector<Capture> m_captures;
+
+    // the nlohmann sax handler
+    class Sax
+    {
+      public:
+        Sax(const vector<Capture>& captures)
+            : m_captures(captures)
+        {
+        }
+
+        bool null() { return value([](JsonSaxConsumer& c) { return c.null(); }); }
+
+        bool boolean(bool v)
+        {
+            return value([v](JsonSaxConsumer& c) { return c.boolean(v); });
+        }
+
+        bool number_integer(Json::number_integer_t v)
+        {
+            return value([v](JsonSaxConsumer& c) { return c.number_integer(v); });
+        }
+
+        bool number_unsigned(Json::number_unsigned_t v)
+        {
+            return value([v](JsonSaxConsumer& c) { return c.number_unsigned(v); });
+        }
+
+        bool number_float(Json::number_float_t v, const Json::string_t&)
+        {
+            return value([v](JsonSaxConsumer& c) { return c.number_float(v); });
+        }
+
+        bool string(Json::string_t& v)
+        {
+            return value([&v](JsonSaxConsumer& c) { return c.string(v); });
+        }
+
+        bool binary(Json::binary_t&)
+        {
+            throw JsonIOError{"Binary values are not supported by JsonStreamReader"};
+        }
+
+        bool start_object(std::size_t) { return start(false); }
+
+        bool key(Json::string_t& k)
+        {
+            if(m_captured)
+                return m_captured->key(k);
+            m_path.back() = k;
+            return m_dom.key(k);
+        }
+
+        bool end_object() { return end(false); }
+
+        bool start_array(std::size_t) { return start(true); }
+
+        bool end_array() { return end(true); }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e)
+        {
+            throw JsonIOError{fmt::format("Failed to parse json at {}: {}", position, e.what())};
+        }
+
+        Json& result() { return m_dom.result(); }
+
+      private:
+        template <typename F>
+        bool value(F&& f)
+        {
+            if(m_captured)
+                return f(*m_captured);
+            if(!m_levels.empty() && m_levels.back().array)
+                ++m_levels.back().count;
+            return f(m_dom);
+        }
+
+        bool start(bool array)
+        {
+            if(m_captured)
+            {
+                ++m_captured_depth;
+                return array ? m_captured->start_array() : m_captured->start_object();
+            }
+
+            if(!m_levels.empty() && m_levels.back().array)
+                m_path.back() = std::to_string(m_levels.back().count++);
+
+            for(auto& capture : m_captures)
+            {
+                auto consumer = capture(m_path);
+                if(consumer)
+                {
+                    m_captured       = std::move(consumer);
+                    m_captured_depth = 1;
+                    m_dom.null();
+                    return array ? m_captured->start_array() : m_captured->start_object();
+                }
+            }
+
+            m_levels.push_back({array, 0});
+            m_path.emplace_back();
+            return array ? m_dom.start_array() : m_dom.start_object();
+        }
+
+        bool end(bool array)
+        {
+            if(m_captured)
+            {
+                bool ok = array ? m_captured->end_array() : m_captured->end_object();
+                if(--m_captured_depth == 0)
+                    m_captured.reset();
+                return ok;
+            }
+
+            m_levels.pop_back();
+            m_path.pop_back();
+            return array ? m_dom.end_array() : m_dom.end_object();
+        }
+
+        struct Level
+        {
+            bool  array;
+            SizeT count;
+        };
+
+        const vector<Capture>& m_captures;
+        JsonSaxDomBuilder      m_dom;
+        vector<Level>          m_levels;
+        vector<std::string>    m_path;
+        S<JsonSaxConsumer>     m_captured;
+        SizeT                  m_captured_depth = 0;
+    };
+
+    Json read(std::istream& is, JsonFormat format)
+    {
+        Sax  sax{m_captures};
+        auto input_format = format == JsonFormat::Json ? nlohmann::detail::input_format_t::json :
+                                                         nlohmann::detail::input_format_t::bson;
+        if(!Json::sax_parse(is, &sax, input_format))
+            throw JsonIOError{"Failed to parse the json stream"};
+        return std::move(sax.result());
+    }
+};
+
+JsonStreamReader::JsonStreamReader()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+JsonStreamReader::~JsonStreamReader() {}
+
+void JsonStreamReader::capture(Capture capture)
+{
+    m_impl->m_captures.push_back(std::move(capture));
+}
+
+Json JsonStreamReader::read(std::istream& is, JsonFormat format)
+{
+    return m_impl->read(is, format);
+}
+
+/**************************************************************
+*                         Json Index
+***************************************************************/
+
+namespace
+{
+    // buffered reading from a stream, keeping track of the position
+    class ByteSource
+    {
+      public:
+        static constexpr SizeT BufferSize = 1 << 16;
+
+        ByteSource(std::istream& is)
+            : m_is(is)
+        {
+            auto pos = is.tellg();
+            if(pos == std::streampos(-1))
+                throw JsonIOError{"The json stream is not seekable"};
+            m_pos = static_cast<SizeT>(pos);
+        }
+
+        SizeT pos() const noexcept { return m_pos; }
+
+        bool eof()
+        {
+            return m_head == m_buffer.size() && !fill();
+        }
+
+        char get()
+        {
+            if(eof())
+                throw JsonIOError{"Unexpected end of the json stream"};
+            ++m_pos;
+            return m_buffer[m_head++];
+        }
+
+        char peek()
+        {
+            if(eof())
+                throw JsonIOError{"Unexpected end of the json stream"};
+            return m_buffer[m_head];
+        }
+
+        void read(SizeT n, std::string& out)
+        {
+            while(n > 0)
+            {
+                if(eof())
+                    throw JsonIOError{"Unexpected end of the json stream"};
+                SizeT m = std::min(n, m_buffer.size() - m_head);
+                out.append(m_buffer.data() + m_head, m);
+                m_head += m;
+                m_pos += m;
+                n -= m;
+            }
+        }
+
+        template <typename T>
+        T read()
+        {
+            std::string bytes;
+            read(sizeof(T), bytes);
+            T v;
+            std::memcpy(&v, bytes.data(), sizeof(T));
+            return v;
+        }
+
+        void skip(SizeT n)
+        {
+            if(n <= m_buffer.size() - m_head)
+            {
+                m_head += n;
+                m_pos += n;
+                return;
+            }
+
+            m_pos += n;
+            m_buffer.clear();
+            m_head = 0;
+            m_is.clear();
+            m_is.seekg(static_cast<std::streamoff>(m_pos));
+        }
+
+      private:
+        bool fill()
+        {
+            m_buffer.resize(BufferSize);
+            m_is.read(m_buffer.data(), BufferSize);
+            m_buffer.resize(static_cast<SizeT>(m_is.gcount()));
+            m_head = 0;
+            return !m_buffer.empty();
+        }
+
+        std::istream& m_is;
+        std::string   m_buffer;
+        SizeT         m_head = 0;
+        SizeT         m_pos  = 0;
+    };
+
+    class JsonIndexer
+    {
+      public:
+        JsonIndexer(ByteSource& src, span<const std::string> path, vector<JsonByteRange>& elements)
+            : m_src(src)
+            , m_path(path)
+            , m_elements(elements)
+        {
+        }
+
+        Json read()
+        {
+            // the skeleton text without the elements of the array at `path`
+            std::string out;
+            skip_ws(&out);
+            value(out);
+            return Json::parse(out);
+        }
+
+      private:
+        struct Level
+        {
+            bool        array = false;
+            SizeT       count = 0;
+            std::string key;
+        };
+
+        void skip_ws(std::string* out)
+        {
+            while(!m_src.eof())
+            {
+                char c = m_src.peek();
+                if(c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                    break;
+                m_src.get();
+                if(out)
+                    *out += c;
+            }
+        }
+
+        void string(std::string* out)
+        {
+            if(out)
+                *out += m_src.get();
+            else
+                m_src.get();
+
+            while(true)
+            {
+                char c = m_src.get();
+                if(out)
+                    *out += c;
+                if(c == '"')
+                    break;
+                if(c == '\\')
+                {
+                    char e = m_src.get();
+                    if(out)
+                        *out += e;
+                }
+            }
+        }
+
+        void scalar(std::string* out)
+        {
+            while(!m_src.eof())
+            {
+                char c = m_src.peek();
+                if(c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n'
+                   || c == '\r' || c == '\t')
+                    break;
+                m_src.get();
+                if(out)
+                    *out += c;
+            }
+        }
+
+        // skip a value, nothing is kept
+        void skip_value()
+        {
+            char c = m_src.peek();
+            if(c == '"')
+            {
+                string(nullptr);
+                return;
+            }
+            if(c != '{' && c != '[')
+            {
+                scalar(nullptr);
+                return;
+            }
+
+            SizeT depth = 0;
+            do
+            {
+                c = m_src.peek();
+                if(c == '"')
+                {
+                    string(nullptr);
+                    continue;
+                }
+                m_src.get();
+                if(c == '{' || c == '[')
+                    ++depth;
+                else if(c == '}' || c == ']')
+                    --depth;
+            } while(depth > 0);
+        }
+
+        bool at_path() const
+        {
+            if(m_levels.size() != m_path.size())
+                return false;
+            for(SizeT i = 0; i < m_levels.size(); ++i)
+            {
+                auto& l   = m_levels[i];
+                auto  key = l.array ? std::to_string(l.count) : l.key;
+                if(key != m_path[i])
+                    return false;
+            }
+            return true;
+        }
+
+        void indexed_array(std::string& out)
+        {
+            out += m_src.get();  // [
+            skip_ws(nullptr);
+            if(m_src.peek() != ']')
+            {
+                while(true)
+                {
+                    skip_ws(nullptr);
+                    JsonByteRange range;
+                    range.begin = m_src.pos();
+                    skip_value();
+                    range.end = m_src.pos();
+                    m_elements.push_back(range);
+
+                    skip_ws(nullptr);
+                    if(m_src.peek() != ',')
+                        break;
+                    m_src.get();
+                }
+            }
+            out += m_src.get();  // ]
+        }
+
+        void value(std::string& out)
+        {
+            char c = m_src.peek();
+            if(c == '"')
+            {
+                string(&out);
+                return;
+            }
+            if(c != '{' && c != '[')
+            {
+                scalar(&out);
+                return;
+            }
+
+            if(c == '[' && at_path())
+            {
+                indexed_array(out);
+                return;
+            }
+
+            bool array = c == '[';
+            out += m_src.get();
+            m_levels.push_back(Level{array, 0, {}});
+
+            skip_ws(&out);
+            if(m_src.peek() != (array ? ']' : '}'))
+            {
+                while(true)
+                {
+                    if(!array)
+                    {
+                        SizeT begin = out.size();
+                        string(&out);
+                        m_levels.back().key =
+                            Json::parse(std::string_view{out}.substr(begin)).get<std::string>();
+                        skip_ws(&out);
+                        out += m_src.get();  // :
+                        skip_ws(&out);
+                    }
+
+                    value(out);
+                    skip_ws(&out);
+
+                    if(m_src.peek() != ',')
+                        break;
+                    out += m_src.get();
+                    ++m_levels.back().count;
+                    skip_ws(&out);
+                }
+            }
+
+            out += m_src.get();
+            m_levels.pop_back();
+        }
+
+        ByteSource&             m_src;
+        span<const std::string> m_path;
+        vector<JsonByteRange>&  m_elements;
+        vector<Level>           m_levels;
+    };
+
+    class BsonIndexer
+    {
+      public:
+        BsonIndexer(ByteSource& src, span<const std::string> path, vector<JsonByteRange>& elements)
+            : m_src(src)
+            , m_path(path)
+            , m_elements(elements)
+        {
+        }
+
+        Json read()
+        {
+            std::string out;
+            document(out, 0);
+            return Json::from_bson(out);
+        }
+
+      private:
+        std::string cstring()
+        {
+            std::string s;
+            for(char c = m_src.get(); c != '\0'; c = m_src.get())
+                s += c;
+            return s;
+        }
+
+        // read the size prefix of a value into `prefix`, return the size of the rest of the value
+        SizeT value_size(char type, std::string& prefix)
+        {
+            switch(type)
+            {
+                case 0x01:  // double
+                case 0x09:  // datetime
+                case 0x11:  // timestamp / uint64
+                case 0x12:  // int64
+                    return 8;
+                case 0x08:  // boolean
+                    return 1;
+                case 0x0A:  // null
+                    return 0;
+                case 0x10:  // int32
+                    return 4;
+                case 0x07:  // object id
+                    return 12;
+                case 0x13:  // decimal128
+                    return 16;
+                case 0x02:  // string
+                case 0x03:  // document
+                case 0x04:  // array
+                case 0x05:  // binary
+                {
+                    SizeT head = prefix.size();
+                    m_src.read(4, prefix);
+                    I32 n;
+                    std::memcpy(&n, prefix.data() + head, sizeof(n));
+                    if(type == 0x02)
+                        return static_cast<SizeT>(n);
+                    if(type == 0x05)
+                        return 1 + static_cast<SizeT>(n);
+                    return static_cast<SizeT>(n) - 4;
+                }
+                default:
+                    throw JsonIOError{fmt::format("Unsupported BSON element type 0x{:02x}",
+                                                  static_cast<int>(static_cast<unsigned char>(type)))};
+            }
+        }
+
+        void indexed_array()
+        {
+            SizeT begin = m_src.pos();
+            SizeT size  = static_cast<SizeT>(m_src.read<I32>());
+            for(char type = m_src.get(); type != '\0'; type = m_src.get())
+            {
+                cstring();
+                JsonByteRange range;
+                range.type  = type;
+                range.begin = m_src.pos();
+                std::string prefix;
+                m_src.skip(value_size(type, prefix));
+                range.end = m_src.pos();
+                m_elements.push_back(range);
+            }
+            UIPC_ASSERT(m_src.pos() == begin + size, "Corrupted BSON array");
+        }
+
+        void document(std::string& out, SizeT depth)
+        {
+            SizeT out_begin = out.size();
+            m_src.read<I32>();
+            append_bytes<I32>(out, 0);
+
+            for(char type = m_src.get(); type != '\0'; type = m_src.get())
+            {
+                auto key = cstring();
+                out += type;
+                out += key;
+                out += '\0';
+
+                bool on_path = depth < m_path.size() && key == m_path[depth];
+                if(on_path && depth + 1 == m_path.size() && type == BsonArray)
+                {
+                    indexed_array();
+                    append_bytes<I32>(out, 5);  // an empty array
+                    out += '\0';
+                }
+                else if(on_path && (type == BsonDocument || type == BsonArray))
+                {
+                    document(out, depth + 1);
+                }
+                else
+                {
+                    m_src.read(value_size(type, out), out);
+                }
+            }
+
+            out += '\0';
+            I32 size = static_cast<I32>(out.size() - out_begin);
+            std::memcpy(out.data() + out_begin, &size, sizeof(size));
+        }
+
+        ByteSource&             m_src;
+        span<const std::string> m_path;
+        vector<JsonByteRange>&  m_elements;
+    };
+}  // namespace
+
+Json read_json_index(std::istream&           is,
+                     JsonFormat              format,
+                     span<const std::string> path,
+                     vector<JsonByteRange>&  elements)
+{
+    elements.clear();
+    ByteSource src{is};
+    if(format == JsonFormat::Json)
+        return JsonIndexer{src, path, elements}.read();
+    else
+        return BsonIndexer{src, path, elements}.read();
+}
+
+std::string read_json_range(std::istream& is, JsonFormat format, const JsonByteRange& range)
+{
+    std::string encoded;
+    if(format == JsonFormat::Bson)
+        encoded += range.type;
+
+    SizeT head = encoded.size();
+    encoded.resize(head + range.end - range.begin);
+
+    is.clear();
+    is.seekg(static_cast<std::streamoff>(range.begin));
+    is.read(encoded.data() + head, static_cast<std::streamsize>(range.end - range.begin));
+    if(!is)
+        throw JsonIOError{"Failed to read the json stream"};
+    return encoded;
+}
+}  // namespace uipc
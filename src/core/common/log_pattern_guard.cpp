@@ -1,14 +1,56 @@
 #include <uipc/common/log_pattern_guard.h>
+#include <spdlog/pattern_formatter.h>
+#include <mutex>
 
 namespace uipc
 {
+namespace
+{
+    // the pattern of the guard alive on this thread, engines stepped in parallel don't race on it
+    thread_local std::string tl_pattern;
+
+    class PatternFlag final : public spdlog::custom_flag_formatter
+    {
+      public:
+        void format(const spdlog::details::log_msg&, const std::tm&, spdlog::memory_buf_t& dest) override
+        {
+            if(tl_pattern.empty())
+                return;
+            dest.push_back('[');
+            dest.append(tl_pattern.data(), tl_pattern.data() + tl_pattern.size());
+            dest.append(std::string_view{"] "});
+        }
+
+        std::unique_ptr<custom_flag_formatter> clone() const override
+        {
+            return spdlog::details::make_unique<PatternFlag>();
+        }
+    };
+
+    void install_formatter()
+    {
+        static std::once_flag once;
+        std::call_once(once,
+                       []
+                       {
+                           auto formatter = std::make_unique<spdlog::pattern_formatter>();
+                           formatter->add_flag<PatternFlag>('*').set_pattern(
+                               "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %*%v");
+                           // only the default logger, the other loggers keep their own pattern
+                           spdlog::default_logger()->set_formatter(std::move(formatter));
+                       });
+    }
+}  // namespace
+
 LogPatternGuard::LogPatternGuard(std::string_view pattern) noexcept
+    : m_previous{std::move(tl_pattern)}
 {
-    spdlog::set_pattern(fmt::format("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [{}] %v", pattern));
+    install_formatter();
+    tl_pattern = pattern;
 }
 
 LogPatternGuard::~LogPatternGuard() noexcept
 {
-    spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+    tl_pattern = std::move(m_previous);
 }
 }  // namespace uipc
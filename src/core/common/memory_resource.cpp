@@ -0,0 +1,201 @@
+#include <uipc/common/memory_resource.h>
+#include <uipc/common/exception.h>
+#include <uipc/common/log.h>
+#include <mutex>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace uipc
+{
+constexpr SizeT HugePageSize = 2ull << 20;
+
+HugePageMemoryResource::HugePageMemoryResource(std::pmr::memory_resource* upstream,
+                                               SizeT min_huge_block) noexcept
+    : m_upstream(upstream)
+    , m_min_huge_block(min_huge_block)
+{
+}
+
+std::pmr::memory_resource* HugePageMemoryResource::upstream() const noexcept
+{
+    return m_upstream;
+}
+
+static bool use_huge_page(SizeT bytes, SizeT alignment, SizeT min_huge_block) noexcept
+{
+#if defined(__linux__)
+    return bytes >= min_huge_block && alignment <= HugePageSize;
+#else
+    return false;
+#endif
+}
+
+static SizeT round_up_huge_page(SizeT bytes) noexcept
+{
+    return (bytes + HugePageSize - 1) / HugePageSize * HugePageSize;
+}
+
+void* HugePageMemoryResource::do_allocate(SizeT bytes, SizeT alignment)
+{
+#if defined(__linux__)
+    if(use_huge_page(bytes, alignment, m_min_huge_block))
+    {
+        SizeT size = round_up_huge_page(bytes);
+        void* p    = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(p == MAP_FAILED)
+            throw std::bad_alloc{};
+        // it's only an advice, the kernel may ignore it
+        ::madvise(p, size, MADV_HUGEPAGE);
+        return p;
+    }
+#endif
+    return m_upstream->allocate(bytes, alignment);
+}
+
+void HugePageMemoryResource::do_deallocate(void* p, SizeT bytes, SizeT alignment)
+{
+#if defined(__linux__)
+    if(use_huge_page(bytes, alignment, m_min_huge_block))
+    {
+        ::munmap(p, round_up_huge_page(bytes));
+        return;
+    }
+#endif
+    m_upstream->deallocate(p, bytes, alignment);
+}
+
+bool HugePageMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+std::pmr::memory_resource* huge_page_resource() noexcept
+{
+    static HugePageMemoryResource resource;
+    return &resource;
+}
+
+Json default_memory_resource_config()
+{
+    Json j                           = Json::object();
+    j["type"]                        = "default";
+    j["synchronized"]                = true;
+    j["huge_page"]                   = false;
+    j["initial_size"]                = 0;
+    j["max_blocks_per_chunk"]        = 0;
+    j["largest_required_pool_block"] = 0;
+    return j;
+}
+
+namespace detail
+{
+    // A memory resource which keeps its upstream alive.
+    template <typename ResourceT>
+    class OwningResource final : public ResourceT
+    {
+      public:
+        template <typename... Args>
+        OwningResource(S<std::pmr::memory_resource> upstream, Args&&... args)
+            : ResourceT(std::forward<Args>(args)..., upstream.get())
+            , m_upstream(std::move(upstream))
+        {
+        }
+
+      private:
+        S<std::pmr::memory_resource> m_upstream;
+    };
+
+    // Serialize the calls to a resource which is not thread-safe.
+    class LockedResource final : public std::pmr::memory_resource
+    {
+      public:
+        explicit LockedResource(S<std::pmr::memory_resource> resource) noexcept
+            : m_resource(std::move(resource))
+        {
+        }
+
+      private:
+        void* do_allocate(SizeT bytes, SizeT alignment) override
+        {
+            std::lock_guard lock{m_mutex};
+            return m_resource->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, SizeT bytes, SizeT alignment) override
+        {
+            std::lock_guard lock{m_mutex};
+            m_resource->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        S<std::pmr::memory_resource> m_resource;
+        std::mutex                   m_mutex;
+    };
+}  // namespace detail
+
+S<std::pmr::memory_resource> create_memory_resource(const Json& config)
+{
+    Json c = default_memory_resource_config();
+    c.merge_patch(config);
+
+    auto type         = c["type"].get<std::string>();
+    auto synchronized = c["synchronized"].get<bool>();
+    auto huge_page    = c["huge_page"].get<bool>();
+
+    // non-owning upstream, the global resources are never destroyed
+    S<std::pmr::memory_resource> upstream{huge_page ? huge_page_resource() :
+                                                      std::pmr::get_default_resource(),
+                                          [](std::pmr::memory_resource*) {}};
+
+    std::pmr::pool_options options;
+    options.max_blocks_per_chunk        = c["max_blocks_per_chunk"].get<SizeT>();
+    options.largest_required_pool_block = c["largest_required_pool_block"].get<SizeT>();
+
+    if(type == "default")
+    {
+        return upstream;
+    }
+    else if(type == "pool" && !synchronized)
+    {
+        return std::make_shared<detail::OwningResource<std::pmr::unsynchronized_pool_resource>>(
+            upstream, options);
+    }
+    else if(type == "pool" || type == "synchronized_pool")
+    {
+        return std::make_shared<detail::OwningResource<std::pmr::synchronized_pool_resource>>(
+            upstream, options);
+    }
+    else if(type == "monotonic")
+    {
+        using Monotonic = detail::OwningResource<std::pmr::monotonic_buffer_resource>;
+
+        auto initial_size = c["initial_size"].get<SizeT>();
+
+        S<std::pmr::memory_resource> monotonic =
+            initial_size == 0 ? std::make_shared<Monotonic>(upstream) :
+                                std::make_shared<Monotonic>(upstream, initial_size);
+        if(!synchronized)
+            return monotonic;
+        return std::make_shared<detail::LockedResource>(std::move(monotonic));
+    }
+
+    throw Exception{fmt::format("Unknown memory resource type [{}], "
+                                "supported types are: default, pool, synchronized_pool, monotonic.",
+                                type)};
+}
+
+MemoryResourceGuard::MemoryResourceGuard(std::pmr::memory_resource* resource) noexcept
+    : m_previous(std::pmr::set_default_resource(resource))
+{
+}
+
+MemoryResourceGuard::~MemoryResourceGuard()
+{
+    std::pmr::set_default_resource(m_previous);
+}
+}  // namespace uipc
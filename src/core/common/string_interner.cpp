@@ -0,0 +1,65 @@
+#include <uipc/common/string_interner.h>
+#include <string>
+#include <unordered_set>
+#include <shared_mutex>
+#include <mutex>
+
+namespace uipc
+{
+namespace detail
+{
+    struct StringHash
+    {
+        using is_transparent = void;
+        SizeT operator()(std::string_view str) const noexcept
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // NOTE: node based container, so the interned strings never move.
+    // Always use the global heap, the pmr default resource may be a short-lived arena.
+    class StringPool
+    {
+      public:
+        std::string_view intern(std::string_view str)
+        {
+            {
+                std::shared_lock lock{m_mutex};
+                auto             it = m_pool.find(str);
+                if(it != m_pool.end())
+                    return *it;
+            }
+
+            std::unique_lock lock{m_mutex};
+            return *m_pool.emplace(str).first;
+        }
+
+        SizeT size() const noexcept
+        {
+            std::shared_lock lock{m_mutex};
+            return m_pool.size();
+        }
+
+      private:
+        mutable std::shared_mutex                                          m_mutex;
+        std::unordered_set<std::string, StringHash, std::equal_to<>> m_pool;
+    };
+
+    static StringPool& string_pool()
+    {
+        static StringPool pool;
+        return pool;
+    }
+}  // namespace detail
+
+std::string_view StringInterner::intern(std::string_view str)
+{
+    return detail::string_pool().intern(str);
+}
+
+SizeT StringInterner::size() noexcept
+{
+    return detail::string_pool().size();
+}
+}  // namespace uipc
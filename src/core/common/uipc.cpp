@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <cpptrace/cpptrace.hpp>
 #include <uipc/common/exception.h>
+#include <uipc/common/exec.h>
 
 namespace uipc
 {
@@ -14,6 +15,8 @@ Json default_config()
     Json j = Json::object();
     // j["version"]    = "1.0.0";
     j["module_dir"] = "";
+    // the total thread count of the CPU side parallel algorithms, 0 means the hardware concurrency
+    j["exec"]["threads"] = 0;
     return j;
 }
 
@@ -38,5 +41,8 @@ void init(const Json& config)
             throw uipc::Exception("module_dir does not exist.");
         }
     }
+
+    // the thread count may be changed
+    exec::detail::reset_default_executor();
 }
 }  // namespace uipc
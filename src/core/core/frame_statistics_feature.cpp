@@ -0,0 +1,102 @@
+#include <uipc/core/frame_statistics_feature.h>
+#include <uipc/common/log.h>
+#include <array>
+
+namespace uipc::core
+{
+std::string_view FrameStatisticsRecord::phase_name(Phase phase) noexcept
+{
+    constexpr std::array<std::string_view, PhaseCount> names = {
+        "collision_detection", "assembly", "linear_solve", "line_search"};
+    return phase >= 0 && phase < PhaseCount ? names[phase] : std::string_view{};
+}
+
+Json FrameStatisticsRecord::to_json() const
+{
+    Json j;
+    j["frame"]                    = frame;
+    j["newton_iterations"]        = newton_iterations;
+    j["line_search_iterations"]   = line_search_iterations;
+    j["linear_solver_iterations"] = linear_solver_iterations;
+    j["ccd_alpha"]                = ccd_alpha;
+    j["cfl_alpha"]                = cfl_alpha;
+    j["line_search_alpha"]        = line_search_alpha;
+    j["contact_candidates"]       = contact_candidates;
+    j["active_contacts"]          = active_contacts;
+
+    auto& times = j["phase_times"];
+    for(int p = 0; p < PhaseCount; ++p)
+        times[std::string{phase_name(static_cast<Phase>(p))}] = phase_times[p];
+    return j;
+}
+
+FrameStatisticsFeature::FrameStatisticsFeature(SizeT capacity)
+    : m_ring(capacity)
+{
+    UIPC_ASSERT(capacity > 0, "The capacity of FrameStatisticsFeature must be positive.");
+}
+
+void FrameStatisticsFeature::push(const FrameStatisticsRecord& record) noexcept
+{
+    if(m_size < m_ring.size())
+    {
+        m_ring[(m_head + m_size) % m_ring.size()] = record;
+        ++m_size;
+    }
+    else  // overwrite the oldest one
+    {
+        m_ring[m_head] = record;
+        m_head         = (m_head + 1) % m_ring.size();
+    }
+}
+
+void FrameStatisticsFeature::clear() noexcept
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+SizeT FrameStatisticsFeature::size() const noexcept
+{
+    return m_size;
+}
+
+SizeT FrameStatisticsFeature::capacity() const noexcept
+{
+    return m_ring.size();
+}
+
+const FrameStatisticsRecord& FrameStatisticsFeature::operator[](SizeT i) const noexcept
+{
+    UIPC_ASSERT(i < m_size, "Index out of range, size={}, yours={}.", m_size, i);
+    return m_ring[(m_head + i) % m_ring.size()];
+}
+
+const FrameStatisticsRecord& FrameStatisticsFeature::latest() const noexcept
+{
+    UIPC_ASSERT(m_size > 0, "No frame statistics recorded yet.");
+    return (*this)[m_size - 1];
+}
+
+vector<FrameStatisticsRecord> FrameStatisticsFeature::records() const
+{
+    vector<FrameStatisticsRecord> R;
+    R.reserve(m_size);
+    for(SizeT i = 0; i < m_size; ++i)
+        R.push_back((*this)[i]);
+    return R;
+}
+
+Json FrameStatisticsFeature::to_json() const
+{
+    Json j = Json::array();
+    for(SizeT i = 0; i < m_size; ++i)
+        j.push_back((*this)[i].to_json());
+    return j;
+}
+
+std::string_view FrameStatisticsFeature::get_name() const
+{
+    return FeatureName;
+}
+}  // namespace uipc::core
@@ -33,6 +33,11 @@ Json IEngine::to_json() const
     return do_to_json();
 }
 
+Json IEngine::memory_report() const
+{
+    return do_memory_report();
+}
+
 bool IEngine::dump()
 {
     return do_dump();
@@ -63,6 +68,11 @@ Json IEngine::do_to_json() const
     return Json{};
 }
 
+Json IEngine::do_memory_report() const
+{
+    return Json::object();
+}
+
 bool IEngine::do_dump()
 {
     return true;
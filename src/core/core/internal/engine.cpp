@@ -163,6 +163,12 @@ class Engine::Impl
         return j;
     }
 
+    Json memory_report() const
+    {
+        LogPatternGuard guard{backend_name()};
+        return m_engine->memory_report();
+    }
+
     EngineStatusCollection& status()
     {
         LogPatternGuard guard{backend_name()};
@@ -286,6 +292,11 @@ Json Engine::to_json() const
 {
     return m_impl->to_json();
 }
+
+Json Engine::memory_report() const
+{
+    return m_impl->memory_report();
+}
 bool Engine::dump()
 {
     return m_impl->do_dump();
@@ -1,8 +1,114 @@
 #include <uipc/core/internal/scene.h>
 #include <uipc/core/scene_snapshot.h>
+#include <uipc/common/zip.h>
+#include <unordered_set>
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<core::internal::Scene>
+{
+  public:
+    static auto& attribute_slots(const AttributeCollection& ac)
+    {
+        return ac.m_attributes;
+    }
+
+    static const IAttribute& attribute(const IAttributeSlot& slot)
+    {
+        return slot.attribute();
+    }
+};
+
+template <>
+class GeometryFriend<core::internal::Scene>
+{
+  public:
+    static void attribute_collections(const Geometry&      geometry,
+                                      vector<std::string>& names,
+                                      vector<const AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+};
+}  // namespace uipc::geometry
 
 namespace uipc::core::internal
 {
+// Report the memory of a geometry collection.
+// The attributes shared by more than one geometry are only counted once in `unique_bytes`.
+static Json memory_report(const geometry::GeometryCollection& gc,
+                          std::unordered_set<const geometry::IAttribute*>& visited,
+                          SizeT& unique_bytes)
+{
+    using AF = geometry::AttributeFriend<Scene>;
+    using GF = geometry::GeometryFriend<Scene>;
+
+    Json  j           = Json::object();
+    auto& geometries  = j["geometries"] = Json::array();
+    SizeT total_bytes = 0;
+
+    vector<std::string>                          names;
+    vector<const geometry::AttributeCollection*> collections;
+
+    for(auto&& slot : gc.geometry_slots())
+    {
+        // don't load a lazily loaded geometry just to report it
+        if(!slot->is_loaded())
+        {
+            Json geo_json      = Json::object();
+            geo_json["id"]     = slot->id();
+            geo_json["loaded"] = false;
+            geo_json["bytes"]  = 0;
+            geometries.push_back(std::move(geo_json));
+            continue;
+        }
+
+        auto& geo = slot->geometry();
+
+        names.clear();
+        collections.clear();
+        GF::attribute_collections(geo, names, collections);
+
+        Json  geo_json   = Json::object();
+        SizeT geo_bytes  = 0;
+        geo_json["id"]   = slot->id();
+        geo_json["type"] = geo.type();
+        auto& collections_json = geo_json["collections"] = Json::object();
+
+        for(auto&& [name, ac] : zip(names, collections))
+        {
+            Json  ac_json  = Json::object();
+            SizeT ac_bytes = 0;
+            auto& attributes_json = ac_json["attributes"] = Json::object();
+
+            for(auto&& [attr_name, attr_slot] : AF::attribute_slots(*ac))
+            {
+                auto& attr  = AF::attribute(*attr_slot);
+                SizeT bytes = attr.memory_usage();
+
+                attributes_json[attr_name] = bytes;
+                ac_bytes += bytes;
+
+                if(visited.insert(&attr).second)
+                    unique_bytes += bytes;
+            }
+
+            ac_json["bytes"]       = ac_bytes;
+            collections_json[name] = std::move(ac_json);
+            geo_bytes += ac_bytes;
+        }
+
+        geo_json["bytes"] = geo_bytes;
+        geometries.push_back(std::move(geo_json));
+        total_bytes += geo_bytes;
+    }
+
+    j["count"] = gc.size();
+    j["bytes"] = total_bytes;
+    return j;
+}
+
 Scene::Scene(const Json& config) noexcept
     : m_animator{*this}
     , m_sanity_checker(*this)
@@ -50,8 +156,23 @@ void Scene::update_from(const SceneSnapshotCommit& commit)
     m_objects.update_from(*this, commit.m_object_collection);
     m_contact_tabular.update_from(*commit.m_contact_models, commit.m_contact_elements);
 
-    m_geometries.update_from(commit.m_geometries);
-    m_rest_geometries.update_from(commit.m_rest_geometries);
+    m_geometries.update_from(commit.m_geometries, commit.m_removed_geometries);
+    m_rest_geometries.update_from(commit.m_rest_geometries, commit.m_removed_rest_geometries);
+}
+
+Json Scene::memory_report() const
+{
+    std::unordered_set<const geometry::IAttribute*> visited;
+    SizeT                                           unique_bytes = 0;
+
+    Json j               = Json::object();
+    j["geometries"]      = internal::memory_report(m_geometries, visited, unique_bytes);
+    j["rest_geometries"] = internal::memory_report(m_rest_geometries, visited, unique_bytes);
+    j["total_bytes"]     = j["geometries"]["bytes"].get<SizeT>()
+                       + j["rest_geometries"]["bytes"].get<SizeT>();
+    // shared attributes are only counted once
+    j["unique_bytes"] = unique_bytes;
+    return j;
 }
 
 Scene::~Scene() = default;
@@ -22,7 +22,21 @@ void World::init(internal::Scene& s)
         return;
 
     sanity_check(s);
+    do_init(s);
+}
+
+void World::init(internal::Scene& s, SanityCheckResult known_result)
+{
+    if(m_scene)
+        return;
 
+    if(s.config()["sanity_check"]["enable"].get<bool>() == true)
+        m_valid = (known_result == SanityCheckResult::Success);
+    do_init(s);
+}
+
+void World::do_init(internal::Scene& s)
+{
     if(!m_valid)
     {
         spdlog::error("World is not valid, skipping init.");
@@ -186,6 +200,14 @@ const FeatureCollection& World::features() const
     return m_engine->features();
 }
 
+Json World::memory_report() const
+{
+    Json j       = Json::object();
+    j["scene"]   = m_scene ? m_scene->memory_report() : Json::object();
+    j["backend"] = m_engine->memory_report();
+    return j;
+}
+
 void World::sanity_check(Scene& s)
 {
     auto& config = s.config();
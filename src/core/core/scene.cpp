@@ -4,6 +4,7 @@
 #include <uipc/core/world.h>
 #include <uipc/core/internal/scene.h>
 #include <uipc/core/scene_snapshot.h>
+#include <uipc/geometry/attribute_deduplicator.h>
 
 namespace uipc::core
 {
@@ -19,6 +20,11 @@ Json Scene::default_config() noexcept
 
     config["cfl"]["enable"] = false;
 
+    // fixed order reductions for the validation runs, slower: the hessian assembly, the FEM, ABD and animator
+    // gradients, the preconditioners, the spmv, the line search energies and the contact candidates, so the
+    // frames are bitwise reproducible on the same device
+    config["deterministic"]["enable"] = false;
+
     auto& newton = config["newton"];
     {
         newton["max_iter"] = 1024;
@@ -77,6 +83,8 @@ Json Scene::default_config() noexcept
     auto& diff_sim = config["diff_sim"] = Json::object();
     {
         diff_sim["enable"] = false;
+        // the checkpoints kept by the adjoint method besides the first frame, the frames between them are recomputed
+        diff_sim["checkpoint_count"] = 8;
     }
 
     // something that is unofficial
@@ -187,6 +195,11 @@ void Scene::update_from(const SceneSnapshotCommit& snapshot)
     m_internal->update_from(snapshot);
 }
 
+Json Scene::memory_report() const
+{
+    return m_internal->memory_report();
+}
+
 // ----------------------------------------------------------------------------
 // Objects
 // ----------------------------------------------------------------------------
@@ -291,6 +304,24 @@ ObjectGeometrySlots<geometry::Geometry> core::Scene::Geometries::find(IndexT id)
     return {m_scene.geometries().find(id), m_scene.rest_geometries().find(id)};
 }
 
+SizeT Scene::Geometries::deduplicate_attributes() &&
+{
+    geometry::AttributeDeduplicator dedup;
+    SizeT                           count = 0;
+
+    auto apply = [&](geometry::GeometryCollection& geos)
+    {
+        for(auto& slot : geos.geometry_slots())
+            count += dedup.deduplicate(slot->geometry());
+        for(auto& slot : geos.pending_create_slots())
+            count += dedup.deduplicate(slot->geometry());
+    };
+
+    apply(m_scene.geometries());
+    apply(m_scene.rest_geometries());
+    return count;
+}
+
 ObjectGeometrySlots<const geometry::Geometry> Scene::CGeometries::find(IndexT id) && noexcept
 {
     return {m_scene.geometries().find(id), m_scene.rest_geometries().find(id)};
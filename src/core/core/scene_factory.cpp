@@ -7,6 +7,12 @@
 #include <uipc/geometry/geometry_factory.h>
 #include <uipc/core/internal/scene.h>
 #include <uipc/common/zip.h>
+#include <uipc/geometry/attribute_factory.h>
+#include <uipc/geometry/geometry_source.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
 
 namespace uipc::core
 {
@@ -45,17 +51,359 @@ class SceneFactory::Impl
     using GeometryAtlas       = uipc::geometry::GeometryAtlas;
     using GeometryAtlasCommit = uipc::geometry::GeometryAtlasCommit;
 
+    bool deduplicate_attributes = false;
+
+    static geometry::AttributeFactory& af()
+    {
+        static thread_local geometry::AttributeFactory af;
+        return af;
+    }
+
+    static geometry::AttributeCollectionFactory& acf()
+    {
+        static thread_local geometry::AttributeCollectionFactory acf;
+        return acf;
+    }
+
+    static geometry::GeometryFactory& gf()
+    {
+        static thread_local geometry::GeometryFactory gf;
+        return gf;
+    }
+
+    // visit the attribute indices in the json of an attribute collection
+    template <typename F>
+    static void for_each_attribute_index(const Json& ac_json, F&& f)
+    {
+        auto data_it = ac_json.find(builtin::__data__);
+        if(data_it == ac_json.end())
+            return;
+        for(auto&& [name, attr_json] : data_it->items())
+        {
+            auto index_it = attr_json.find("index");
+            if(index_it != attr_json.end())
+                f(index_it->template get<IndexT>());
+        }
+    }
+
+    /**************************************************************
+    *                       Lazy Scene File
+    ***************************************************************/
+
+    // A scene file read lazily: only the document without the attribute values is read up front,
+    // the attributes are read from the file by their byte ranges when needed.
+    class SceneFile
+    {
+      public:
+        SceneFile(std::string_view filename, JsonFormat format)
+            : m_format{format}
+            , m_path{normalized_path(filename)}
+            , m_file{std::string{filename}, std::ios::binary}
+        {
+            if(!m_file)
+                throw JsonIOError{fmt::format("Failed to open file {} for reading.", filename)};
+
+            const std::string attributes_path[] = {std::string{builtin::__data__},
+                                                   "geometry_atlas",
+                                                   std::string{builtin::__data__},
+                                                   "attributes"};
+            m_index = read_json_index(m_file, format, attributes_path, m_ranges);
+
+            // the attributes referred more than once are shared by the decoded geometries
+            vector<IndexT> ref_counts(m_ranges.size(), 0);
+            auto           count = [&](IndexT i)
+            {
+                if(i >= 0 && i < static_cast<IndexT>(ref_counts.size()))
+                    ++ref_counts[i];
+            };
+            auto& atlas = atlas_data();
+            for(auto&& geo_json : atlas.value("geometries", Json::array()))
+                for(auto&& [name, ac_json] : geo_json.value(builtin::__data__, Json::object()).items())
+                    for_each_attribute_index(ac_json, count);
+            for(auto&& [name, ac_json] : atlas.value("attribute_collections", Json::object()).items())
+                for_each_attribute_index(ac_json, count);
+
+            for(SizeT i = 0; i < ref_counts.size(); ++i)
+                if(ref_counts[i] > 1)
+                    m_shared.insert({static_cast<IndexT>(i), nullptr});
+        }
+
+        static std::string normalized_path(std::string_view filename)
+        {
+            namespace fs = std::filesystem;
+            return fs::absolute(fs::path{filename}).lexically_normal().string();
+        }
+
+        const std::string& path() const noexcept { return m_path; }
+
+        const Json& index() const noexcept { return m_index; }
+
+        const Json& atlas_data() const
+        {
+            return m_index[builtin::__data__]["geometry_atlas"][builtin::__data__];
+        }
+
+        JsonFormat format() const noexcept { return m_format; }
+
+        SizeT attribute_count() const noexcept { return m_ranges.size(); }
+
+        // the encoded attribute in the layout of `JsonStreamEncoder::raw()`
+        std::string encoded(IndexT i) const
+        {
+            std::lock_guard lock{m_mutex};
+            if(m_released)
+                return m_encoded.at(i);
+            return read_json_range(m_file, m_format, m_ranges.at(i));
+        }
+
+        // read all the encoded attributes into memory and close the file, so that the file can be replaced
+        void release() const
+        {
+            std::lock_guard lock{m_mutex};
+            if(m_released)
+                return;
+            m_encoded.reserve(m_ranges.size());
+            for(auto& range : m_ranges)
+                m_encoded.push_back(read_json_range(m_file, m_format, range));
+            m_file.close();
+            m_released = true;
+        }
+
+        Json attribute_json(IndexT i) const
+        {
+            auto bytes = encoded(i);
+            if(m_format == JsonFormat::Json)
+                return Json::parse(bytes);
+            return Json::from_bson(std::string_view{bytes}.substr(1));
+        }
+
+        S<geometry::IAttributeSlot> attribute(IndexT i) const
+        {
+            std::unique_lock lock{m_shared_mutex};
+            auto             it = m_shared.find(i);
+            if(it != m_shared.end() && it->second)
+                return it->second;
+            lock.unlock();
+
+            auto bytes = encoded(i);
+            if(m_format == JsonFormat::Bson)
+                bytes.erase(0, 1);  // the element type
+
+            S<geometry::IAttributeSlot> slot;
+            JsonStreamReader            reader;
+            reader.capture(
+                [&slot](span<const std::string> path) -> S<JsonSaxConsumer>
+                {
+                    if(!path.empty())
+                        return nullptr;
+                    return af().decoder([&slot](S<geometry::IAttributeSlot> s)
+                                        { slot = std::move(s); });
+                });
+            std::istringstream is{std::move(bytes)};
+            (void)reader.read(is, m_format);
+
+            if(!slot)
+                throw JsonIOError{fmt::format("Failed to decode the attribute {}", i)};
+
+            lock.lock();
+            if(it != m_shared.end())
+            {
+                if(!it->second)
+                    it->second = slot;
+                return it->second;
+            }
+            return slot;
+        }
+
+        // a context holding the attributes referred by the attribute collections
+        geometry::DeserialSharedAttributeContext context(span<const Json* const> ac_jsons) const
+        {
+            geometry::DeserialSharedAttributeContext ctx;
+            ctx.m_attribute_slots.resize(m_ranges.size());
+            for(auto ac_json : ac_jsons)
+            {
+                for_each_attribute_index(*ac_json,
+                                         [&](IndexT i)
+                                         {
+                                             auto& slot = ctx.m_attribute_slots.at(i);
+                                             if(!slot)
+                                                 slot = attribute(i);
+                                         });
+            }
+            return ctx;
+        }
+
+      private:
+        JsonFormat            m_format;
+        std::string           m_path;
+        Json                  m_index;
+        vector<JsonByteRange> m_ranges;
+
+        mutable std::mutex          m_mutex;
+        mutable std::ifstream       m_file;
+        mutable bool                m_released = false;
+        mutable vector<std::string> m_encoded;  // the encoded attributes after `release()`
+
+        mutable std::mutex m_shared_mutex;
+        mutable unordered_map<IndexT, S<geometry::IAttributeSlot>> m_shared;
+    };
+
+    // A geometry of a SceneFile
+    class SceneFileGeometry final : public geometry::IGeometrySource
+    {
+      public:
+        SceneFileGeometry(S<const SceneFile> file, const Json& json)
+            : m_file{std::move(file)}
+            , m_json(json)
+        {
+        }
+
+      protected:
+        S<geometry::Geometry> do_load() const override
+        {
+            vector<const Json*> ac_jsons;
+            auto                data_it = m_json.find(builtin::__data__);
+            if(data_it != m_json.end())
+                for(auto&& ac_json : *data_it)
+                    ac_jsons.push_back(&ac_json);
+
+            auto ctx  = m_file->context(ac_jsons);
+            auto geos = gf().from_json(Json::array({m_json}), ctx);
+            if(geos.empty())
+                return nullptr;
+            // copy to set up the shortcuts of the geometry
+            return std::static_pointer_cast<geometry::Geometry>(geos.front()->clone());
+        }
+
+        const Json& get_json() const override { return m_json; }
+
+        const void* get_archive() const noexcept override { return m_file.get(); }
+
+        void do_encode_attribute(IndexT index, JsonStreamEncoder& encoder) const override
+        {
+            if(encoder.format() == m_file->format())
+                encoder.raw(m_file->encoded(index));
+            else
+                encoder.value(m_file->attribute_json(index));
+        }
+
+        Json do_attribute_to_json(IndexT index) const override
+        {
+            return m_file->attribute_json(index);
+        }
+
+      private:
+        S<const SceneFile> m_file;
+        Json               m_json;
+    };
+
+    // the open scene files, to release them before their files are replaced
+    static std::mutex& scene_files_mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    static vector<std::weak_ptr<const SceneFile>>& scene_files()
+    {
+        static vector<std::weak_ptr<const SceneFile>> files;
+        return files;
+    }
+
+    static void release_lazy_file(std::string_view filename)
+    {
+        auto path = SceneFile::normalized_path(filename);
+
+        vector<S<const SceneFile>> files;
+        {
+            std::lock_guard lock{scene_files_mutex()};
+            auto&           all = scene_files();
+            std::erase_if(all, [](auto& f) { return f.expired(); });
+            for(auto& f : all)
+                if(auto file = f.lock(); file && file->path() == path)
+                    files.push_back(std::move(file));
+        }
+
+        for(auto& file : files)
+            file->release();
+    }
+
+    SceneSnapshot lazy_from_file(std::string_view filename, JsonFormat format)
+    {
+        auto file = uipc::make_shared<SceneFile>(filename, format);
+        {
+            std::lock_guard lock{scene_files_mutex()};
+            scene_files().push_back(file);
+        }
+
+        SceneSnapshot snapshot;
+        auto&         j    = file->index();
+        const Json*   data = data_of(j);
+        if(!data)
+            return snapshot;
+
+        // 1) Config
+        snapshot.m_config = config_from_json(*data);
+
+        // 2) Contact tabular, the contact models are small, decode them now
+        {
+            auto& atlas = file->atlas_data();
+            auto  ac_it = atlas.find("attribute_collections");
+            if(ac_it != atlas.end() && ac_it->contains("contact_models"))
+            {
+                const Json* ac_json = &(*ac_it)["contact_models"];
+                auto        ctx     = file->context(span{&ac_json, 1});
+                contact_tabular_from_json(*data, acf().from_json(*ac_json, ctx), snapshot);
+            }
+            else
+            {
+                contact_tabular_from_json(*data, nullptr, snapshot);
+            }
+        }
+
+        // 3) Objects
+        uipc::core::from_json((*data)["object_collection"], snapshot.m_object_collection);
+
+        // 4) Geometry slots & rest geometry slots, not decoded
+        {
+            auto& geometries_json = file->atlas_data()["geometries"];
+
+            auto build_sources =
+                [&](const Json& slots_json,
+                    unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources)
+            {
+                for(auto& slot_json : slots_json)
+                {
+                    auto id    = slot_json["id"].get<IndexT>();
+                    auto index = slot_json["index"].get<SizeT>();
+                    UIPC_ASSERT(index < geometries_json.size(),
+                                "Geometry slot with id {} not found in geometry atlas",
+                                index);
+                    sources[id] = uipc::make_shared<SceneFileGeometry>(file, geometries_json[index]);
+                }
+            };
+
+            build_sources((*data)["geometry_slots"], snapshot.m_geometry_sources);
+            build_sources((*data)["rest_geometry_slots"], snapshot.m_rest_geometry_sources);
+        }
+
+        return snapshot;
+    }
+
     void build_geometry_atlas_from_scene_snapshot(const SceneSnapshot& snapshot,
                                                   Json&                data,
-                                                  GeometryAtlas&       ga)
+                                                  GeometryAtlas&       ga,
+                                                  JsonStreamWriter*    writer)
     {
+        ga.deduplicate(deduplicate_attributes);
+
         // geometries
         {
             auto setup = [&](Json& slots_json,
-                             const unordered_map<IndexT, S<geometry::Geometry>>& geos)
+                             const unordered_map<IndexT, S<geometry::Geometry>>& geos,
+                             const unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources)
             {
-                auto geo_slots = snapshot.m_geometries;
-                slots_json     = Json::array();
+                slots_json = Json::array();
                 for(auto& [id, geo] : geos)
                 {
                     Json slot_json     = Json::object();
@@ -63,15 +411,24 @@ class SceneFactory::Impl
                     slot_json["index"] = ga.create(*geo);
                     slots_json.push_back(slot_json);
                 }
+
+                // the untouched geometries of a lazily loaded scene are copied, not decoded
+                for(auto& [id, source] : sources)
+                {
+                    Json slot_json     = Json::object();
+                    slot_json["id"]    = id;
+                    slot_json["index"] = ga.create(source);
+                    slots_json.push_back(slot_json);
+                }
             };
 
             // geometry slots
             auto& geo_slots_json = data["geometry_slots"];
-            setup(geo_slots_json, snapshot.m_geometries);
+            setup(geo_slots_json, snapshot.m_geometries, snapshot.m_geometry_sources);
 
             // rest geometry slots
             auto& rest_geo_slots_json = data["rest_geometry_slots"];
-            setup(rest_geo_slots_json, snapshot.m_rest_geometries);
+            setup(rest_geo_slots_json, snapshot.m_rest_geometries, snapshot.m_rest_geometry_sources);
         }
 
         // contact models
@@ -79,13 +436,33 @@ class SceneFactory::Impl
             ga.create("contact_models", *snapshot.m_contact_models);
         }
 
-        data["geometry_atlas"] = ga.to_json();
+        if(writer)
+            ga.to_json(data["geometry_atlas"], *writer);
+        else
+            data["geometry_atlas"] = ga.to_json();
     }
 
     Json to_json(const SceneSnapshot& snapshot)
     {
-        Json          j = Json::object();
+        Json          j;
         GeometryAtlas ga;
+        to_json(snapshot, j, ga, nullptr);
+        return j;
+    }
+
+    void to_stream(const SceneSnapshot& snapshot, std::ostream& os, JsonFormat format, int indent)
+    {
+        // the attribute values are left to the writer
+        Json             j;
+        GeometryAtlas    ga;
+        JsonStreamWriter writer{os, format, indent};
+        to_json(snapshot, j, ga, &writer);
+        writer.write(j);
+    }
+
+    void to_json(const SceneSnapshot& snapshot, Json& j, GeometryAtlas& ga, JsonStreamWriter* writer)
+    {
+        j = Json::object();
 
         auto& meta = j[builtin::__meta__];
         {
@@ -109,45 +486,109 @@ class SceneFactory::Impl
             // - contact models
             //
             // - geometry atlas
-            build_geometry_atlas_from_scene_snapshot(snapshot, data, ga);
+            build_geometry_atlas_from_scene_snapshot(snapshot, data, ga, writer);
         }
-        return j;
     }
 
     SceneSnapshot from_json(const Json& j)
     {
-        SceneSnapshot snapshot;
-        auto          meta_it = j.find(builtin::__meta__);
+        GeometryAtlas ga;
+        return from_json(j, ga);
+    }
+
+    SceneSnapshot from_stream(std::istream& is, JsonFormat format)
+    {
+        JsonStreamReader reader;
+        GeometryAtlas    ga;
+
+        // decode the attribute values straight into the geometry atlas
+        const std::string atlas_path[] = {std::string{builtin::__data__}, "geometry_atlas"};
+        ga.capture(reader, atlas_path);
+
+        Json j = reader.read(is, format);
+        return from_json(j, ga);
+    }
+
+    // the __data__ of a SceneSnapshot json, nullptr if invalid
+    static const Json* data_of(const Json& j)
+    {
+        auto meta_it = j.find(builtin::__meta__);
         if(meta_it == j.end())
         {
             UIPC_WARN_WITH_LOCATION("Can not find __meta__ in json");
-            return snapshot;
+            return nullptr;
         }
         auto& meta = *meta_it;
         if(meta["type"] != UIPC_TO_STRING(SceneSnapshot))
         {
             UIPC_WARN_WITH_LOCATION("Invalid type in __meta__, expected `Scene`");
-            return snapshot;
+            return nullptr;
         }
         auto data_it = j.find(builtin::__data__);
         if(data_it == j.end())
         {
             UIPC_WARN_WITH_LOCATION("Can not find __data__ in json");
-            return snapshot;
+            return nullptr;
         }
-        auto& data = *data_it;
+        return &*data_it;
+    }
+
+    static Json config_from_json(const Json& data)
+    {
+        auto config = Scene::default_config();
+        // merge default config with the one in json
+        // if same key, json config will override default config
+        config.merge_patch(data["config"]);
+        return config;
+    }
+
+    static void contact_tabular_from_json(const Json&                        data,
+                                          S<const geometry::AttributeCollection> contact_models,
+                                          SceneSnapshot& snapshot)
+    {
+        auto&                  contact_tabular = data["contact_tabular"];
+        vector<ContactElement> ce;
+        auto element_it = contact_tabular.find("contact_elements");
+        if(element_it != contact_tabular.end())
+        {
+            auto& elements = *element_it;
+            if(elements.is_array())
+            {
+                ce = elements.get<vector<ContactElement>>();
+            }
+            else
+            {
+                UIPC_WARN_WITH_LOCATION("contact_elements is not an array");
+            }
+        }
+        else
+        {
+            UIPC_WARN_WITH_LOCATION("Can not find `contact_elements` in contact_tabular");
+        }
+
+        // contact models
+        if(contact_models && !ce.empty())
+        {
+            snapshot.m_contact_models =
+                uipc::make_shared<geometry::AttributeCollection>(*contact_models);
+            snapshot.m_contact_elements = ce;
+        }
+    }
+
+    SceneSnapshot from_json(const Json& j, GeometryAtlas& ga)
+    {
+        SceneSnapshot snapshot;
+        const Json*   data_ptr = data_of(j);
+        if(!data_ptr)
+            return snapshot;
+        auto& data = *data_ptr;
 
         // 1) Config
         {
-            auto config = Scene::default_config();
-            // merge default config with the one in json
-            // if same key, json config will override default config
-            config.merge_patch(data["config"]);
-            snapshot.m_config = config;
+            snapshot.m_config = config_from_json(data);
         }
 
         // 2) Build geometry atlas
-        GeometryAtlas ga;
         {
             auto& geometry_atlas_json = data["geometry_atlas"];
             ga.from_json(geometry_atlas_json);
@@ -155,34 +596,7 @@ class SceneFactory::Impl
 
         // 3) Retrieve contact tabular
         {
-            auto&                  contact_tabular = data["contact_tabular"];
-            vector<ContactElement> ce;
-            auto element_it = contact_tabular.find("contact_elements");
-            if(element_it != contact_tabular.end())
-            {
-                auto& elements = *element_it;
-                if(elements.is_array())
-                {
-                    ce = elements.get<vector<ContactElement>>();
-                }
-                else
-                {
-                    UIPC_WARN_WITH_LOCATION("contact_elements is not an array");
-                }
-            }
-            else
-            {
-                UIPC_WARN_WITH_LOCATION("Can not find `contact_elements` in contact_tabular");
-            }
-
-            // contact models
-            auto contact_models = ga.find("contact_models");
-            if(contact_models && !ce.empty())
-            {
-                snapshot.m_contact_models =
-                    uipc::make_shared<geometry::AttributeCollection>(*contact_models);
-                snapshot.m_contact_elements = ce;
-            }
+            contact_tabular_from_json(data, ga.find("contact_models"), snapshot);
         }
 
         // 4) Retrieve objects
@@ -241,20 +655,43 @@ class SceneFactory::Impl
         {
             auto build_geometries =
                 [&gf, &scene](const unordered_map<IndexT, S<geometry::Geometry>>& geometries,
+                              const unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources,
                               geometry::GeometryCollection& geometry_collection)
             {
                 vector<S<geometry::GeometrySlot>> geometry_slots;
-                geometry_slots.reserve(geometries.size());
+                geometry_slots.reserve(geometries.size() + sources.size());
                 for(auto&& [id, geo] : geometries)
                 {
                     geometry_slots.push_back(gf.create_slot(id, *geo));
                 }
+
+                // lazily loaded slots, holding an empty geometry of the type until first access
+                for(auto&& [id, source] : sources)
+                {
+                    Json empty_json = Json::object();
+                    empty_json[builtin::__meta__] = source->json()[builtin::__meta__];
+                    empty_json[builtin::__data__] = Json::object();
+
+                    geometry::DeserialSharedAttributeContext ctx;
+                    auto geos = gf.from_json(Json::array({empty_json}), ctx);
+                    UIPC_ASSERT(geos.size() == 1,
+                                "Can not create the geometry of slot {}, type: {}",
+                                id,
+                                empty_json[builtin::__meta__].dump());
+
+                    auto slot = gf.create_slot(id, *geos.front());
+                    slot->source(source);
+                    geometry_slots.push_back(std::move(slot));
+                }
                 geometry_collection.build_from(geometry_slots);
             };
 
-            build_geometries(snapshot.m_geometries, scene.m_internal->geometries());
+            build_geometries(snapshot.m_geometries,
+                             snapshot.m_geometry_sources,
+                             scene.m_internal->geometries());
 
             build_geometries(snapshot.m_rest_geometries,
+                             snapshot.m_rest_geometry_sources,
                              scene.m_internal->rest_geometries());
         }
 
@@ -318,6 +755,9 @@ class SceneFactory::Impl
             setup(geo_slots_json, commit.m_geometries);
             setup(rest_geo_slots_json, commit.m_rest_geometries);
 
+            data["removed_geometry_ids"]      = commit.m_removed_geometries;
+            data["removed_rest_geometry_ids"] = commit.m_removed_rest_geometries;
+
             // geometry atlas
             data["geometry_atlas"] = gac.to_json();
         }
@@ -466,6 +906,12 @@ class SceneFactory::Impl
                 build_geo_commits(geometry_slots_json, commit.m_geometries);
                 build_geo_commits(rest_geometry_slots_json, commit.m_rest_geometries);
 
+                // the commits written before the removals were recorded have no removed ids
+                if(auto it = data.find("removed_geometry_ids"); it != data.end())
+                    commit.m_removed_geometries = it->get<vector<IndexT>>();
+                if(auto it = data.find("removed_rest_geometry_ids"); it != data.end())
+                    commit.m_removed_rest_geometries = it->get<vector<IndexT>>();
+
                 if(commit.m_geometries.size() != commit.m_rest_geometries.size())
                 {
                     UIPC_WARN_WITH_LOCATION("Geometry commit size does not match rest geometry commit size");
@@ -500,9 +946,17 @@ class SceneFactory::Impl
     }
 };
 
-SceneFactory::SceneFactory()
+SceneFactory::SceneFactory(const Json& config)
     : m_impl(uipc::make_unique<Impl>())
 {
+    m_impl->deduplicate_attributes = config.value("deduplicate_attributes", false);
+}
+
+Json SceneFactory::default_config()
+{
+    Json config;
+    config["deduplicate_attributes"] = false;
+    return config;
 }
 
 SceneFactory::~SceneFactory() = default;
@@ -531,4 +985,24 @@ Json SceneFactory::commit_to_json(const SceneSnapshotCommit& scene)
 {
     return m_impl->commit_to_json(scene);
 }
+
+void SceneFactory::to_stream(const SceneSnapshot& scene, std::ostream& os, JsonFormat format, int indent)
+{
+    m_impl->to_stream(scene, os, format, indent);
+}
+
+SceneSnapshot SceneFactory::from_stream(std::istream& is, JsonFormat format)
+{
+    return m_impl->from_stream(is, format);
+}
+
+SceneSnapshot SceneFactory::lazy_from_file(std::string_view filename, JsonFormat format)
+{
+    return m_impl->lazy_from_file(filename, format);
+}
+
+void SceneFactory::release_lazy_file(std::string_view filename)
+{
+    Impl::release_lazy_file(filename);
+}
 }  // namespace uipc::core
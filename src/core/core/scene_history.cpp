@@ -0,0 +1,654 @@
+#include <uipc/core/scene_history.h>
+#include <uipc/core/internal/scene.h>
+#include <uipc/geometry/geometry_commit.h>
+#include <uipc/geometry/geometry_slot.h>
+#include <uipc/common/zip.h>
+#include <algorithm>
+#include <array>
+#include <deque>
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<core::SceneHistory>
+{
+  public:
+    static auto& attribute_slots(const AttributeCollection& ac)
+    {
+        return ac.m_attributes;
+    }
+};
+
+template <>
+class GeometryFriend<core::SceneHistory>
+{
+  public:
+    static void attribute_collections(const Geometry&                     geometry,
+                                      vector<std::string>&                names,
+                                      vector<const AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+
+    static S<const AttributeCollection> find(const Geometry& geometry, std::string_view name)
+    {
+        return geometry.find(name);
+    }
+};
+}  // namespace uipc::geometry
+
+namespace uipc::core
+{
+namespace
+{
+    using AF = geometry::AttributeFriend<SceneHistory>;
+    using GF = geometry::GeometryFriend<SceneHistory>;
+
+    /**
+     * @brief The version of an attribute slot, identified by the modification time of the slot.
+     */
+    struct AttributeVersion
+    {
+        std::string         collection;
+        std::string         attribute;
+        geometry::TimePoint last_modified;
+        U64                 version = 0;
+
+        auto key() const noexcept
+        {
+            return std::pair<std::string_view, std::string_view>{collection, attribute};
+        }
+    };
+
+    /**
+     * @brief A geometry as recorded in a version, never modified once recorded.
+     */
+    struct Entry
+    {
+        U64 version = 0;
+        // a frozen copy of the geometry, the attributes are shared with the scene until the scene modifies them
+        S<geometry::Geometry> geometry;
+        // or the source of a lazily loaded geometry
+        S<const geometry::IGeometrySource> source;
+        // sorted by (collection, attribute), empty for the lazily loaded geometries
+        vector<AttributeVersion> attributes;
+        // the modification stamps of the attribute collections of the geometry in the scene
+        vector<U64> stamps;
+
+        const AttributeVersion* find(std::string_view collection,
+                                     std::string_view attribute) const noexcept
+        {
+            std::pair<std::string_view, std::string_view> key{collection, attribute};
+            auto it = std::ranges::lower_bound(attributes, key, {}, &AttributeVersion::key);
+            if(it == attributes.end() || it->key() != key)
+                return nullptr;
+            return &*it;
+        }
+    };
+
+    /**
+     * @brief A persistent map from the geometry id to the entry, as a fixed depth radix trie.
+     *
+     * An update copies the nodes on the path to the updated ids, the other nodes are shared with
+     * the map it was updated from. Two maps are diffed by skipping the shared nodes.
+     */
+    class GeometryMap
+    {
+        static constexpr SizeT Bits     = 5;
+        static constexpr SizeT Width    = SizeT{1} << Bits;
+        static constexpr SizeT Depth    = 7;
+        static constexpr U64   KeyCount = U64{1} << (Bits * Depth);
+
+        struct Node
+        {
+            // the branches have the children, the leaves have the entries
+            std::array<S<const Node>, Width>  children;
+            std::array<S<const Entry>, Width> entries;
+        };
+
+        static SizeT child_index(U64 key, SizeT level) noexcept
+        {
+            return (key >> ((Depth - 1 - level) * Bits)) & (Width - 1);
+        }
+
+      public:
+        using Update = std::pair<U64, S<const Entry>>;
+
+        static U64 key_of(IndexT id)
+        {
+            UIPC_ASSERT(id >= 0 && static_cast<U64>(id) < KeyCount,
+                        "Geometry id ({}) out of the range of SceneHistory.",
+                        id);
+            return static_cast<U64>(id);
+        }
+
+        SizeT size() const noexcept { return m_size; }
+
+        const Entry* find(IndexT id) const noexcept
+        {
+            if(id < 0 || static_cast<U64>(id) >= KeyCount)
+                return nullptr;
+            auto        key  = static_cast<U64>(id);
+            const Node* node = m_root.get();
+            for(SizeT level = 0; node && level + 1 < Depth; ++level)
+                node = node->children[child_index(key, level)].get();
+            return node ? node->entries[child_index(key, Depth - 1)].get() : nullptr;
+        }
+
+        /**
+         * @brief A new map with the updates applied, a null entry removes the id.
+         *
+         * @param updates sorted by key, unique
+         */
+        GeometryMap assign(span<const Update> updates) const
+        {
+            GeometryMap map;
+            map.m_size = m_size;
+            for(auto&& [key, entry] : updates)
+            {
+                bool exists = find(static_cast<IndexT>(key)) != nullptr;
+                if(entry && !exists)
+                    ++map.m_size;
+                else if(!entry && exists)
+                    --map.m_size;
+            }
+            map.m_root = updates.empty() ? m_root : assign(m_root.get(), 0, updates);
+            return map;
+        }
+
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            for_each(m_root.get(), 0, 0, f);
+        }
+
+        /**
+         * @brief Call `f(id, dst_entry, src_entry)` for the ids with different entries, the entry is nullptr if absent.
+         */
+        template <typename F>
+        static void diff(const GeometryMap& dst, const GeometryMap& src, F&& f)
+        {
+            diff(dst.m_root.get(), src.m_root.get(), 0, 0, f);
+        }
+
+      private:
+        S<const Node> m_root;
+        SizeT         m_size = 0;
+
+        static S<const Node> assign(const Node* node, SizeT level, span<const Update> updates)
+        {
+            auto copy = node ? uipc::make_shared<Node>(*node) : uipc::make_shared<Node>();
+
+            auto begin = updates.begin();
+            while(begin != updates.end())
+            {
+                auto i   = child_index(begin->first, level);
+                auto end = std::find_if(begin,
+                                        updates.end(),
+                                        [&](const Update& u)
+                                        { return child_index(u.first, level) != i; });
+
+                if(level + 1 == Depth)
+                    copy->entries[i] = std::prev(end)->second;
+                else
+                    copy->children[i] =
+                        assign(copy->children[i].get(), level + 1, span{begin, end});
+
+                begin = end;
+            }
+            return copy;
+        }
+
+        template <typename F>
+        static void for_each(const Node* node, SizeT level, U64 base, F& f)
+        {
+            if(!node)
+                return;
+            for(SizeT i = 0; i < Width; ++i)
+            {
+                auto key = (base << Bits) | i;
+                if(level + 1 == Depth)
+                {
+                    if(auto& e = node->entries[i])
+                        f(static_cast<IndexT>(key), *e);
+                }
+                else
+                    for_each(node->children[i].get(), level + 1, key, f);
+            }
+        }
+
+        template <typename F>
+        static void diff(const Node* dst, const Node* src, SizeT level, U64 base, F& f)
+        {
+            if(dst == src)  // shared, no change
+                return;
+            for(SizeT i = 0; i < Width; ++i)
+            {
+                auto key = (base << Bits) | i;
+                if(level + 1 == Depth)
+                {
+                    auto d = dst ? dst->entries[i].get() : nullptr;
+                    auto s = src ? src->entries[i].get() : nullptr;
+                    if(d != s)
+                        f(static_cast<IndexT>(key), d, s);
+                }
+                else
+                {
+                    diff(dst ? dst->children[i].get() : nullptr,
+                         src ? src->children[i].get() : nullptr,
+                         level + 1,
+                         key,
+                         f);
+                }
+            }
+        }
+    };
+}  // namespace
+
+class SceneHistory::Impl
+{
+  public:
+    struct Version
+    {
+        U64 version = 0;
+        // the plain data of the scene, without the geometries
+        SceneSnapshot meta;
+        GeometryMap   geometries;
+        GeometryMap   rest_geometries;
+    };
+
+    Impl(const Scene& scene, const Json& config)
+        : m_scene(scene.m_internal)
+        , m_max_versions(config["max_versions"].get<SizeT>())
+    {
+    }
+
+    U64 commit()
+    {
+        auto& scene = *m_scene;
+        UIPC_ASSERT(scene.geometries().pending_create_slots().size() == 0
+                        && scene.rest_geometries().pending_create_slots().size() == 0
+                        && scene.geometries().pending_destroy_ids().size() == 0
+                        && scene.rest_geometries().pending_destroy_ids().size() == 0,
+                    R"(GeometryCollection has pending create slots, you should commit SceneHistory immediately after:
+- world.init()
+- world.advance()
+)");
+
+        const Version* last = m_versions.empty() ? nullptr : &m_versions.back();
+
+        Version v;
+        v.version = m_next_version++;
+
+        v.meta.m_config         = scene.config();
+        v.meta.m_contact_models = uipc::make_shared<geometry::AttributeCollection>(
+            scene.contact_tabular().internal_contact_models());
+        auto elements = scene.contact_tabular().contact_elements();
+        v.meta.m_contact_elements.assign(elements.begin(), elements.end());
+        v.meta.m_object_collection = ObjectCollectionSnapshot{scene.objects()};
+
+        v.geometries =
+            record(last ? last->geometries : GeometryMap{}, scene.geometries(), v.version);
+        v.rest_geometries = record(last ? last->rest_geometries : GeometryMap{},
+                                   scene.rest_geometries(),
+                                   v.version);
+
+        m_versions.push_back(std::move(v));
+
+        // the dropped versions release the geometries no other version shares
+        if(m_max_versions > 0 && m_versions.size() > m_max_versions)
+            m_versions.pop_front();
+
+        return m_versions.back().version;
+    }
+
+    const Version& at(U64 version) const
+    {
+        if(!contains(version))
+            throw SceneHistoryError{fmt::format(
+                "Version {} is not in the scene history, the retained versions are [{}, {}).",
+                version,
+                m_versions.empty() ? 0 : m_versions.front().version,
+                m_next_version)};
+        return m_versions[version - m_versions.front().version];
+    }
+
+    bool contains(U64 version) const noexcept
+    {
+        return !m_versions.empty() && version >= m_versions.front().version
+               && version <= m_versions.back().version;
+    }
+
+    const Version& front() const
+    {
+        if(m_versions.empty())
+            throw SceneHistoryError{"No version in the scene history, call commit() first."};
+        return m_versions.front();
+    }
+
+    const Version& back() const
+    {
+        if(m_versions.empty())
+            throw SceneHistoryError{"No version in the scene history, call commit() first."};
+        return m_versions.back();
+    }
+
+    SizeT size() const noexcept { return m_versions.size(); }
+
+    SceneSnapshot snapshot(U64 version) const
+    {
+        auto& v = at(version);
+
+        SceneSnapshot snapshot = v.meta;
+        // the snapshot may be modified by the user, the recorded geometries are not exposed
+        snapshot.m_contact_models =
+            uipc::make_shared<geometry::AttributeCollection>(*v.meta.m_contact_models);
+
+        auto fill = [](const GeometryMap& map,
+                       unordered_map<IndexT, S<geometry::Geometry>>& geometries,
+                       unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources)
+        {
+            geometries.reserve(map.size());
+            map.for_each(
+                [&](IndexT id, const Entry& e)
+                {
+                    if(e.source)
+                        sources[id] = e.source;
+                    else
+                        geometries[id] =
+                            std::static_pointer_cast<geometry::Geometry>(e.geometry->clone());
+                });
+        };
+
+        fill(v.geometries, snapshot.m_geometries, snapshot.m_geometry_sources);
+        fill(v.rest_geometries, snapshot.m_rest_geometries, snapshot.m_rest_geometry_sources);
+        return snapshot;
+    }
+
+    SceneSnapshotCommit diff(U64 dst_version, U64 src_version) const
+    {
+        auto& dst = at(dst_version);
+        auto& src = at(src_version);
+
+        SceneSnapshotCommit commit;
+        commit.m_config            = dst.meta.m_config;
+        commit.m_object_collection = dst.meta.m_object_collection;
+        commit.m_contact_elements  = dst.meta.m_contact_elements;
+        commit.m_contact_models =
+            diff_collection(*dst.meta.m_contact_models, *src.meta.m_contact_models);
+
+        // a source shared by dst and src is never diffed, a source is only loaded if it is replaced
+        unordered_map<const geometry::IGeometrySource*, S<geometry::Geometry>> loaded;
+        auto geometry_of = [&loaded](const Entry& e) -> S<geometry::Geometry>
+        {
+            if(!e.source)
+                return e.geometry;
+            auto& geo = loaded[e.source.get()];
+            if(!geo)
+                geo = e.source->load();
+            return geo;
+        };
+
+        auto setup = [&](unordered_map<IndexT, S<geometry::GeometryCommit>>& gcs,
+                         vector<IndexT>&                                     removed,
+                         const GeometryMap&                                  dst_map,
+                         const GeometryMap&                                  src_map)
+        {
+            GeometryMap::diff(dst_map,
+                              src_map,
+                              [&](IndexT id, const Entry* d, const Entry* s)
+                              {
+                                  if(!d)  // removed in dst
+                                  {
+                                      removed.push_back(id);
+                                      return;
+                                  }
+
+                                  auto dst_geo = geometry_of(*d);
+                                  if(!s)
+                                  {
+                                      // new geometry
+                                      gcs[id] = uipc::make_shared<geometry::GeometryCommit>(*dst_geo);
+                                      return;
+                                  }
+
+                                  gcs[id] = diff_geometry(*dst_geo, *geometry_of(*s));
+                              });
+        };
+
+        setup(commit.m_geometries, commit.m_removed_geometries, dst.geometries, src.geometries);
+        setup(commit.m_rest_geometries,
+              commit.m_removed_rest_geometries,
+              dst.rest_geometries,
+              src.rest_geometries);
+        return commit;
+    }
+
+  private:
+    S<internal::Scene> m_scene;
+    SizeT              m_max_versions = 0;
+    U64                m_next_version = 0;
+    std::deque<Version> m_versions;
+
+    /**
+     * @brief The commit of the attributes from `src` to `dst`.
+     *
+     * The modification time identifies the content of an attribute, so the attributes with a different
+     * modification time are committed, no matter which one is newer.
+     */
+    static S<geometry::AttributeCollectionCommit> diff_collection(const geometry::AttributeCollection& dst,
+                                                                  const geometry::AttributeCollection& src)
+    {
+        auto commit = uipc::make_shared<geometry::AttributeCollectionCommit>();
+        for(auto&& [key, slot] : AF::attribute_slots(dst))
+        {
+            auto ref = src.find(key);
+            if(slot->is_evolving() || !ref || ref->last_modified() != slot->last_modified())
+                commit->m_attribute_collection.share(slot->name(), *slot, slot->allow_destroy());
+        }
+
+        for(auto&& [key, slot] : AF::attribute_slots(src))
+        {
+            if(!dst.find(key))
+                commit->m_removed_names.emplace_back(slot->name());
+        }
+        return commit;
+    }
+
+    static S<geometry::GeometryCommit> diff_geometry(const geometry::Geometry& dst,
+                                                     const geometry::Geometry& src)
+    {
+        // let GeometryCommit report the invalid diff
+        if(dst.type() != src.type())
+            return uipc::make_shared<geometry::GeometryCommit>(dst - src);
+
+        auto commit    = uipc::make_shared<geometry::GeometryCommit>();
+        commit->m_type = dst.type();
+
+        vector<std::string>                           names;
+        vector<const geometry::AttributeCollection*> collections;
+        GF::attribute_collections(dst, names, collections);
+        for(auto&& [name, ac] : zip(names, collections))
+        {
+            auto ref = GF::find(src, name);
+            commit->m_attribute_collections[name] =
+                ref ? diff_collection(*ac, *ref) :
+                      uipc::make_shared<geometry::AttributeCollectionCommit>(*ac);
+        }
+        return commit;
+    }
+
+    // whether the geometry of the slot is the same as the recorded one
+    static bool is_same(const geometry::GeometrySlot& slot, const Entry& e)
+    {
+        auto source = slot.source();
+        if(source || e.source)
+            return source == e.source;
+
+        auto& geo = slot.geometry();
+        if(geo.type() != e.geometry->type())
+            return false;
+
+        // any change of the attributes changes the stamp of their collection, the attributes aren't visited
+        return std::ranges::equal(stamps_of(geo), e.stamps);
+    }
+
+    static vector<U64> stamps_of(const geometry::Geometry& geo)
+    {
+        vector<std::string>                           names;
+        vector<const geometry::AttributeCollection*> collections;
+        GF::attribute_collections(geo, names, collections);
+
+        vector<U64> stamps(collections.size());
+        std::ranges::transform(collections,
+                               stamps.begin(),
+                               &geometry::AttributeCollection::modification_stamp);
+        return stamps;
+    }
+
+    static S<const Entry> make_entry(const geometry::GeometrySlot& slot, const Entry* last, U64 version)
+    {
+        auto e     = uipc::make_shared<Entry>();
+        e->version = version;
+
+        if(auto source = slot.source())
+        {
+            e->source = std::move(source);
+            return e;
+        }
+
+        auto& geo = slot.geometry();
+        e->geometry = std::static_pointer_cast<geometry::Geometry>(geo.clone());
+        e->stamps   = stamps_of(geo);
+
+        vector<std::string>                           names;
+        vector<const geometry::AttributeCollection*> collections;
+        GF::attribute_collections(*e->geometry, names, collections);
+        for(auto&& [name, ac] : zip(names, collections))
+        {
+            for(auto&& [key, attr] : AF::attribute_slots(*ac))
+            {
+                AttributeVersion v{name, std::string{attr->name()}, attr->last_modified(), version};
+
+                // an unmodified attribute keeps its version
+                if(last)
+                {
+                    auto l = last->find(v.collection, v.attribute);
+                    if(l && l->last_modified == v.last_modified)
+                        v.version = l->version;
+                }
+                e->attributes.push_back(std::move(v));
+            }
+        }
+        std::ranges::sort(e->attributes, {}, &AttributeVersion::key);
+        return e;
+    }
+
+    // record the changed geometries upon the last map
+    static GeometryMap record(const GeometryMap& last, geometry::GeometryCollection& geometries, U64 version)
+    {
+        vector<GeometryMap::Update> updates;
+
+        SizeT found = 0;
+        for(auto&& slot : geometries.geometry_slots())
+        {
+            auto e = last.find(slot->id());
+            if(e)
+                ++found;
+            if(e && is_same(*slot, *e))
+                continue;
+            updates.emplace_back(GeometryMap::key_of(slot->id()), make_entry(*slot, e, version));
+        }
+
+        // some recorded geometries are destroyed
+        if(found < last.size())
+        {
+            last.for_each(
+                [&](IndexT id, const Entry&)
+                {
+                    if(!geometries.find(id))
+                        updates.emplace_back(GeometryMap::key_of(id), nullptr);
+                });
+        }
+
+        std::ranges::sort(updates, {}, &GeometryMap::Update::first);
+        return last.assign(updates);
+    }
+};
+
+Json SceneHistory::default_config()
+{
+    Json config;
+    config["max_versions"] = 0;
+    return config;
+}
+
+SceneHistory::SceneHistory(const Scene& scene, const Json& config)
+    : m_impl(uipc::make_unique<Impl>(scene, config))
+{
+}
+
+SceneHistory::~SceneHistory() = default;
+
+U64 SceneHistory::commit()
+{
+    return m_impl->commit();
+}
+
+U64 SceneHistory::latest() const
+{
+    return m_impl->back().version;
+}
+
+U64 SceneHistory::oldest() const
+{
+    return m_impl->front().version;
+}
+
+SizeT SceneHistory::size() const noexcept
+{
+    return m_impl->size();
+}
+
+bool SceneHistory::contains(U64 version) const noexcept
+{
+    return m_impl->contains(version);
+}
+
+SceneSnapshot SceneHistory::snapshot(U64 version) const
+{
+    return m_impl->snapshot(version);
+}
+
+SceneSnapshotCommit SceneHistory::diff(U64 dst, U64 src) const
+{
+    return m_impl->diff(dst, src);
+}
+
+std::optional<U64> SceneHistory::geometry_version(U64 version, IndexT geometry_id) const
+{
+    auto e = m_impl->at(version).geometries.find(geometry_id);
+    if(!e)
+        return std::nullopt;
+    return e->version;
+}
+
+std::optional<U64> SceneHistory::attribute_version(U64              version,
+                                                   IndexT           geometry_id,
+                                                   std::string_view collection,
+                                                   std::string_view attribute) const
+{
+    auto e = m_impl->at(version).geometries.find(geometry_id);
+    if(!e)
+        return std::nullopt;
+
+    // the attributes of a lazily loaded geometry are unknown until it's loaded, take the geometry version
+    if(e->source)
+        return e->version;
+
+    auto v = e->find(collection, attribute);
+    if(!v)
+        return std::nullopt;
+    return v->version;
+}
+}  // namespace uipc::core
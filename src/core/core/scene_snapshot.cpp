@@ -29,25 +29,32 @@ SceneSnapshot::SceneSnapshot(const Scene& scene)
     auto& objects       = internal_scene.objects();
     m_object_collection = ObjectCollectionSnapshot{objects};
 
-    // retrieve geometries
-    auto geometry_slots = internal_scene.geometries().geometry_slots();
-    m_geometries.reserve(geometry_slots.size());
-    for(auto&& slot : geometry_slots)
+    // retrieve geometries, the unloaded ones are kept unloaded
+    auto retrieve = [](uipc::span<S<geometry::GeometrySlot>> slots,
+                       unordered_map<IndexT, S<geometry::Geometry>>& geometries,
+                       unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources)
     {
-        auto& geometry = slot->geometry();
-        m_geometries[slot->id()] =
-            std::static_pointer_cast<geometry::Geometry>(geometry.clone());
-    }
+        geometries.reserve(slots.size());
+        for(auto&& slot : slots)
+        {
+            if(auto source = slot->source())
+            {
+                sources[slot->id()] = std::move(source);
+                continue;
+            }
+
+            auto& geometry = slot->geometry();
+            geometries[slot->id()] =
+                std::static_pointer_cast<geometry::Geometry>(geometry.clone());
+        }
+    };
+
+    retrieve(internal_scene.geometries().geometry_slots(), m_geometries, m_geometry_sources);
 
     // retrieve rest geometries
-    auto rest_geometry_slots = internal_scene.rest_geometries().geometry_slots();
-    m_rest_geometries.reserve(rest_geometry_slots.size());
-    for(auto&& slot : rest_geometry_slots)
-    {
-        auto& geometry = slot->geometry();
-        m_rest_geometries[slot->id()] =
-            std::static_pointer_cast<geometry::Geometry>(geometry.clone());
-    }
+    retrieve(internal_scene.rest_geometries().geometry_slots(),
+             m_rest_geometries,
+             m_rest_geometry_sources);
 }
 
 SceneSnapshotCommit::SceneSnapshotCommit(const SceneSnapshot& dst, const SceneSnapshot& src)
@@ -58,13 +65,33 @@ SceneSnapshotCommit::SceneSnapshotCommit(const SceneSnapshot& dst, const SceneSn
     m_object_collection = dst.m_object_collection;
     m_contact_elements  = dst.m_contact_elements;
 
-    auto setup = [&dst, &src](unordered_map<IndexT, S<geometry::GeometryCommit>>& gcs)
+    // decode the lazily loaded geometries, a source shared by dst and src is decoded once,
+    // so the untouched geometries have no diff
+    unordered_map<const geometry::IGeometrySource*, S<geometry::Geometry>> loaded;
+
+    auto geometries = [&loaded](const unordered_map<IndexT, S<geometry::Geometry>>& geos,
+                                const unordered_map<IndexT, S<const geometry::IGeometrySource>>& sources)
+    {
+        auto all = geos;
+        for(auto&& [id, source] : sources)
+        {
+            auto& geo = loaded[source.get()];
+            if(!geo)
+                geo = source->load();
+            all[id] = geo;
+        }
+        return all;
+    };
+
+    auto setup = [](unordered_map<IndexT, S<geometry::GeometryCommit>>& gcs,
+                    const unordered_map<IndexT, S<geometry::Geometry>>&  dst_geos,
+                    const unordered_map<IndexT, S<geometry::Geometry>>&  src_geos)
     {
-        gcs.reserve(dst.m_geometries.size());
-        for(auto&& [id, dst_geo] : dst.m_geometries)
+        gcs.reserve(dst_geos.size());
+        for(auto&& [id, dst_geo] : dst_geos)
         {
-            auto src_geo = src.m_geometries.find(id);
-            if(src_geo != src.m_geometries.end())
+            auto src_geo = src_geos.find(id);
+            if(src_geo != src_geos.end())
             {
                 // diff geometry
                 gcs[id] = uipc::make_shared<geometry::GeometryCommit>(
@@ -79,9 +106,13 @@ SceneSnapshotCommit::SceneSnapshotCommit(const SceneSnapshot& dst, const SceneSn
     };
 
     // geometries
-    setup(m_geometries);
+    setup(m_geometries,
+          geometries(dst.m_geometries, dst.m_geometry_sources),
+          geometries(src.m_geometries, src.m_geometry_sources));
     // rest geometries
-    setup(m_rest_geometries);
+    setup(m_rest_geometries,
+          geometries(dst.m_rest_geometries, dst.m_rest_geometry_sources),
+          geometries(src.m_rest_geometries, src.m_rest_geometry_sources));
 }
 
 SceneSnapshotCommit UIPC_CORE_API operator-(const SceneSnapshot& dst, const SceneSnapshot& src)
@@ -73,4 +73,9 @@ const FeatureCollection& World::features() const
 {
     return m_internal->features();
 }
+
+Json World::memory_report() const
+{
+    return m_internal->memory_report();
+}
 }  // namespace uipc::core
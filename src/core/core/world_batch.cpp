@@ -0,0 +1,382 @@
+#include <uipc/core/world_batch.h>
+#include <uipc/core/internal/world.h>
+#include <uipc/core/internal/scene.h>
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/log.h>
+#include <uipc/common/hash.h>
+#include <filesystem>
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<core::WorldBatch>
+{
+  public:
+    static auto& attribute_slots(const AttributeCollection& ac) { return ac.m_attributes; }
+
+    static const IAttribute& attribute(const IAttributeSlot& slot)
+    {
+        return slot.attribute();
+    }
+};
+
+template <>
+class GeometryFriend<core::WorldBatch>
+{
+  public:
+    static void attribute_collections(const Geometry&                     geometry,
+                                      vector<std::string>&                names,
+                                      vector<const AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+};
+}  // namespace uipc::geometry
+
+namespace uipc::core
+{
+class WorldBatch::Impl
+{
+    using AF = geometry::AttributeFriend<WorldBatch>;
+    using GF = geometry::GeometryFriend<WorldBatch>;
+
+  public:
+    Impl(std::string_view backend_name, std::string_view workspace, const Json& config)
+        : m_backend_name(backend_name)
+        , m_config(config)
+    {
+        namespace fs = std::filesystem;
+        m_workspace  = fs::absolute(workspace).string();
+        if(!fs::exists(m_workspace))
+            fs::create_directories(m_workspace);
+    }
+
+    void init(span<Scene* const> scenes)
+    {
+        const SizeT first = m_worlds.size();
+
+        // engines are created one by one, the backend module is loaded by the first one and cached
+        for(SizeT i = 0; i < scenes.size(); ++i)
+        {
+            UIPC_ASSERT(scenes[i], "Scene {} is null.", i);
+            auto workspace = fmt::format("{}/{}", m_workspace, first + i);
+            auto engine    = uipc::make_unique<Engine>(m_backend_name, workspace, m_config);
+            auto world     = uipc::make_unique<World>(*engine);
+            m_engines.push_back(std::move(engine));
+            m_worlds.push_back(std::move(world));
+            m_scenes.push_back(scenes[i]);
+        }
+
+        // sanity check each distinct scene of this call only once
+        vector<SanityCheckResult>            results(scenes.size(), SanityCheckResult::Success);
+        unordered_map<U64, vector<SizeT>> checked;
+        for(SizeT i = 0; i < scenes.size(); ++i)
+        {
+            auto& scene = *scenes[i];
+            if(!scene.config()["sanity_check"]["enable"].get<bool>())
+                continue;
+
+            // a hit on the content hashes is confirmed attribute by attribute
+            auto& candidates = checked[content_key(scene)];
+            auto  it         = std::ranges::find_if(candidates,
+                                           [&](SizeT j)
+                                           { return content_equal(scene, *scenes[j]); });
+            if(it != candidates.end())
+            {
+                results[i] = results[*it];
+                continue;
+            }
+
+            auto& checker = scene.sanity_checker();
+            results[i]    = checker.check(m_engines[first + i]->workspace());
+            if(results[i] != SanityCheckResult::Success)
+                checker.report();
+            candidates.push_back(i);
+        }
+
+        parallel_for(
+            0,
+            scenes.size(),
+            [&](SizeT i)
+            {
+                auto& world = *m_worlds[first + i]->m_internal;
+                world.init(*scenes[i]->m_internal, results[i]);
+            },
+            1);
+    }
+
+    void advance()
+    {
+        for_each_world([](World& w) { w.advance(); });
+    }
+
+    void sync()
+    {
+        for_each_world([](World& w) { w.sync(); });
+    }
+
+    void retrieve()
+    {
+        for_each_world([](World& w) { w.retrieve(); });
+    }
+
+    SizeT size() const noexcept { return m_worlds.size(); }
+
+    World& world(SizeT i)
+    {
+        UIPC_ASSERT(i < m_worlds.size(), "World index out of range, size={}, yours={}.", m_worlds.size(), i);
+        return *m_worlds[i];
+    }
+
+    Engine& engine(SizeT i)
+    {
+        UIPC_ASSERT(i < m_engines.size(), "Engine index out of range, size={}, yours={}.", m_engines.size(), i);
+        return *m_engines[i];
+    }
+
+    Scene& scene(SizeT i) const { return *m_scenes[i]; }
+
+  private:
+    template <typename F>
+    void for_each_world(F&& f)
+    {
+        parallel_for(
+            0,
+            m_worlds.size(),
+            [&](SizeT i)
+            {
+                auto& w = *m_worlds[i];
+                if(w.is_valid())
+                    f(w);
+            },
+            1);
+    }
+
+    // the content hashes of all the attributes, chained with the hash of the config
+    static U64 content_key(const Scene& scene)
+    {
+        auto config = scene.config().dump();
+        U64  key    = xxhash64(config.data(), config.size());
+        auto chain  = [&key](U64 value) { key = xxhash64(&value, sizeof(value), key); };
+
+        auto apply = [&](const geometry::GeometryCollection& geos)
+        {
+            for(auto& slot : geos.geometry_slots())
+            {
+                chain(slot->id());
+
+                vector<std::string>                          names;
+                vector<const geometry::AttributeCollection*> collections;
+                GF::attribute_collections(slot->geometry(), names, collections);
+                for(auto ac : collections)
+                    for(auto&& [name, attr_slot] : AF::attribute_slots(*ac))
+                        chain(AF::attribute(*attr_slot).content_hash());
+            }
+        };
+
+        apply(scene.m_internal->geometries());
+        apply(scene.m_internal->rest_geometries());
+        return key;
+    }
+
+    static bool content_equal(const geometry::AttributeCollection& a,
+                              const geometry::AttributeCollection& b)
+    {
+        if(a.size() != b.size() || a.attribute_count() != b.attribute_count())
+            return false;
+
+        for(auto&& [name, slot] : AF::attribute_slots(a))
+        {
+            auto other = b.find(name);
+            if(!other || !AF::attribute(*slot).content_equal(AF::attribute(*other)))
+                return false;
+        }
+        return true;
+    }
+
+    static bool content_equal(const geometry::GeometryCollection& a,
+                              const geometry::GeometryCollection& b)
+    {
+        auto slots_a = a.geometry_slots();
+        auto slots_b = b.geometry_slots();
+        if(slots_a.size() != slots_b.size())
+            return false;
+
+        for(SizeT i = 0; i < slots_a.size(); ++i)
+        {
+            auto& geo_a = slots_a[i]->geometry();
+            auto& geo_b = slots_b[i]->geometry();
+            if(slots_a[i]->id() != slots_b[i]->id() || geo_a.type() != geo_b.type())
+                return false;
+
+            vector<std::string>                          names_a, names_b;
+            vector<const geometry::AttributeCollection*> collections_a, collections_b;
+            GF::attribute_collections(geo_a, names_a, collections_a);
+            GF::attribute_collections(geo_b, names_b, collections_b);
+            if(names_a != names_b)
+                return false;
+
+            for(SizeT k = 0; k < collections_a.size(); ++k)
+                if(!content_equal(*collections_a[k], *collections_b[k]))
+                    return false;
+        }
+        return true;
+    }
+
+    // the config, the contact tabular and all the attributes of the geometries
+    static bool content_equal(const Scene& a, const Scene& b)
+    {
+        if(a.config() != b.config())
+            return false;
+
+        auto& ct_a = a.contact_tabular();
+        auto& ct_b = b.contact_tabular();
+        auto  ce_a = ct_a.contact_elements();
+        auto  ce_b = ct_b.contact_elements();
+        if(!std::ranges::equal(ce_a,
+                               ce_b,
+                               [](const ContactElement& l, const ContactElement& r)
+                               { return l.id() == r.id() && l.name() == r.name(); }))
+            return false;
+        if(!content_equal(ct_a.internal_contact_models(), ct_b.internal_contact_models()))
+            return false;
+
+        return content_equal(a.m_internal->geometries(), b.m_internal->geometries())
+               && content_equal(a.m_internal->rest_geometries(),
+                                b.m_internal->rest_geometries());
+    }
+
+    string            m_backend_name;
+    string            m_workspace;
+    Json              m_config;
+    vector<U<Engine>> m_engines;
+    vector<U<World>>  m_worlds;
+    vector<Scene*>    m_scenes;
+};
+
+WorldBatch::WorldBatch(std::string_view backend_name, std::string_view workspace, const Json& config)
+    : m_impl{uipc::make_unique<Impl>(backend_name, workspace, config)}
+{
+}
+
+WorldBatch::~WorldBatch() {}
+
+void WorldBatch::init(span<Scene* const> scenes)
+{
+    m_impl->init(scenes);
+}
+
+void WorldBatch::advance()
+{
+    m_impl->advance();
+}
+
+void WorldBatch::sync()
+{
+    m_impl->sync();
+}
+
+void WorldBatch::retrieve()
+{
+    m_impl->retrieve();
+}
+
+SizeT WorldBatch::size() const noexcept
+{
+    return m_impl->size();
+}
+
+World& WorldBatch::world(SizeT i)
+{
+    return m_impl->world(i);
+}
+
+Engine& WorldBatch::engine(SizeT i)
+{
+    return m_impl->engine(i);
+}
+
+SizeT WorldBatch::frame() const
+{
+    SizeT frame = ~0ull;
+    bool  any   = false;
+    for(SizeT i = 0; i < m_impl->size(); ++i)
+    {
+        auto& w = m_impl->world(i);
+        if(!w.is_valid())
+            continue;
+        frame = std::min(frame, w.frame());
+        any   = true;
+    }
+    return any ? frame : 0;
+}
+
+vector<SizeT> WorldBatch::frames() const
+{
+    vector<SizeT> F(m_impl->size());
+    for(SizeT i = 0; i < F.size(); ++i)
+        F[i] = m_impl->world(i).frame();
+    return F;
+}
+
+vector<bool> WorldBatch::valid() const
+{
+    vector<bool> V(m_impl->size());
+    for(SizeT i = 0; i < V.size(); ++i)
+        V[i] = m_impl->world(i).is_valid();
+    return V;
+}
+
+template <typename T>
+vector<SizeT> WorldBatch::gather(const geometry::AttributeKey& name, vector<T>& out) const
+{
+    using namespace geometry;
+
+    const SizeT N = m_impl->size();
+
+    // collect the source attributes scene by scene
+    vector<vector<const AttributeSlot<T>*>> sources(N);
+    vector<SizeT>                           offsets(N + 1, 0);
+    for(SizeT i = 0; i < N; ++i)
+    {
+        auto& geometries = m_impl->scene(i).m_internal->geometries();
+        for(auto& slot : geometries.geometry_slots())
+        {
+            auto sc = dynamic_cast<const SimplicialComplex*>(&slot->geometry());
+            if(!sc)
+                continue;
+            auto attr = sc->vertices().find<T>(name);
+            if(!attr)
+                continue;
+            sources[i].push_back(attr.get());
+            offsets[i + 1] += attr->size();
+        }
+    }
+    for(SizeT i = 0; i < N; ++i)
+        offsets[i + 1] += offsets[i];
+
+    out.resize(offsets[N]);
+
+    parallel_for(
+        0,
+        N,
+        [&](SizeT i)
+        {
+            auto dst = out.begin() + offsets[i];
+            for(auto attr : sources[i])
+                dst = std::ranges::copy(attr->view(), dst).out;
+        },
+        1);
+
+    return offsets;
+}
+
+#define UIPC_ATTRIBUTE_EXPORT_DEF(T)                                           \
+    template UIPC_CORE_API vector<SizeT> WorldBatch::gather<T>(                \
+        const geometry::AttributeKey&, vector<T>&) const;
+
+#include <uipc/geometry/details/attribute_export_types.inl>
+
+#undef UIPC_ATTRIBUTE_EXPORT_DEF
+}  // namespace uipc::core
@@ -0,0 +1,358 @@
+#include <uipc/diff_sim/adjoint_solver.h>
+#include <uipc/common/log.h>
+#include <uipc/common/unordered_map.h>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+
+namespace uipc::diff_sim
+{
+namespace
+{
+    // C(n, k), saturated to avoid overflow
+    SizeT binomial(SizeT n, SizeT k)
+    {
+        k          = std::min(k, n - k);
+        SizeT r    = 1;
+        SizeT kMax = ~0ull >> 1;
+        for(SizeT i = 1; i <= k; ++i)
+        {
+            r = r * (n - k + i) / i;
+            if(r > kMax)
+                return kMax;
+        }
+        return r;
+    }
+
+    class ScheduleBuilder
+    {
+      public:
+        vector<CheckpointSchedule::Action>& actions;
+        SizeT                               current = 0;
+
+        void recover(SizeT frame)
+        {
+            if(current == frame)
+                return;
+            actions.push_back({CheckpointSchedule::ActionType::Recover, frame});
+            current = frame;
+        }
+
+        void advance(SizeT to)
+        {
+            for(SizeT f = current + 1; f <= to; ++f)
+                actions.push_back({CheckpointSchedule::ActionType::Advance, f});
+            current = to;
+        }
+
+        // reverse (s, e], a checkpoint at s exists, c more checkpoints are free
+        void reverse(SizeT s, SizeT e, SizeT c)
+        {
+            const SizeT n = e - s;
+            if(n == 0)
+                return;
+
+            if(n == 1)
+            {
+                recover(s);
+                advance(e);
+                actions.push_back({CheckpointSchedule::ActionType::Backward, e});
+                return;
+            }
+
+            if(c == 0)
+            {
+                for(SizeT f = e; f > s; --f)
+                {
+                    recover(s);
+                    advance(f);
+                    actions.push_back({CheckpointSchedule::ActionType::Backward, f});
+                }
+                return;
+            }
+
+            // the fewest repetitions r, so that c checkpoints can reverse n frames
+            SizeT r = 0;
+            while(binomial(c + r, c) < n)
+                ++r;
+
+            // the frames after the new checkpoint are reversed with (c - 1) checkpoints
+            SizeT tail = std::min(binomial(c - 1 + r, c - 1), n - 1);
+            SizeT m    = e - tail;
+
+            recover(s);
+            advance(m);
+            actions.push_back({CheckpointSchedule::ActionType::Checkpoint, m});
+            reverse(m, e, c - 1);
+            reverse(s, m, c);
+        }
+    };
+
+    template <typename T>
+    span<T> host_span(backend::BufferView view)
+    {
+        UIPC_ASSERT(view.element_size() == sizeof(T) && view.element_stride() == sizeof(T),
+                    "BufferView element size mismatch, expected={}, yours={}",
+                    sizeof(T),
+                    view.element_size());
+        auto ptr = reinterpret_cast<T*>(view.handle() + view.offset());
+        return span<T>{ptr, view.size()};
+    }
+}  // namespace
+
+vector<CheckpointSchedule::Action> CheckpointSchedule::revolve(SizeT steps, SizeT checkpoint_count)
+{
+    vector<Action>  actions;
+    ScheduleBuilder builder{actions};
+    builder.reverse(0, steps, checkpoint_count);
+    return actions;
+}
+
+class AdjointSolver::Impl
+{
+  public:
+    Impl(FrameSystemProvider& provider, SizeT checkpoint_count)
+        : provider(provider)
+        , checkpoint_count(checkpoint_count)
+    {
+    }
+
+    VectorX solve(SizeT begin, SizeT end, const LossGradient& dLdx)
+    {
+        UIPC_ASSERT(begin <= end, "Invalid frame range ({}, {}]", begin, end);
+
+        VectorX dLdP = VectorX::Zero(provider.get_parm_count());
+        VectorX g;
+        VectorX lambda;
+
+        // the adjoint carried to the previous frames, at most `depth` frames are pending
+        unordered_map<SizeT, VectorX> carried;
+
+        auto schedule = CheckpointSchedule::revolve(end - begin, checkpoint_count);
+
+        // the provider may be anywhere, go to the initial frame
+        if(provider.get_frame() != begin)
+            recover(begin);
+
+        for(auto& action : schedule)
+        {
+            SizeT frame = begin + action.frame;
+            switch(action.type)
+            {
+                case CheckpointSchedule::ActionType::Advance: {
+                    provider.do_advance();
+                    ++stats.advances;
+                    UIPC_ASSERT(provider.get_frame() == frame,
+                                "Frame mismatch after advance, expected={}, yours={}",
+                                frame,
+                                provider.get_frame());
+                }
+                break;
+                case CheckpointSchedule::ActionType::Checkpoint: {
+                    if(!provider.do_checkpoint())
+                        throw AdjointSolverError{
+                            fmt::format("Failed to checkpoint frame {}", frame)};
+                    ++stats.checkpoints;
+                }
+                break;
+                case CheckpointSchedule::ActionType::Recover: {
+                    recover(frame);
+                }
+                break;
+                case CheckpointSchedule::ActionType::Backward: {
+                    auto pGpP = provider.get_pGpP();
+                    UIPC_ASSERT(static_cast<SizeT>(pGpP.shape()(1)) == provider.get_parm_count(),
+                                "pGpP cols mismatch, expected={}, yours={}",
+                                provider.get_parm_count(),
+                                pGpP.shape()(1));
+
+                    auto H = provider.get_H();
+                    g      = VectorX::Zero(H.shape()(0));
+                    dLdx(frame, g);
+                    if(auto it = carried.find(frame); it != carried.end())
+                    {
+                        g += it->second;
+                        carried.erase(it);
+                    }
+                    if(g.isZero(0.0))
+                        break;
+
+                    factorize(H);
+                    lambda = ldlt.solve(g);
+                    if(ldlt.info() != Eigen::Success)
+                        throw AdjointSolverError{
+                            fmt::format("Failed to solve the adjoint system of frame {}", frame)};
+
+                    dLdP -= pGpP.to_sparse().transpose() * lambda;
+
+                    // the dofs of `begin` and before are constants, nothing to carry to them
+                    for(SizeT k = 1; k <= provider.get_coupling_depth() && frame - k > begin; ++k)
+                    {
+                        auto pGpX = provider.get_pGpX(k);
+                        if(pGpX.values().empty())
+                            continue;
+
+                        auto& r = carried[frame - k];
+                        if(r.size() == 0)
+                            r = VectorX::Zero(pGpX.shape()(1));
+                        r -= pGpX.to_sparse().transpose() * lambda;
+                    }
+                }
+                break;
+            }
+        }
+
+        return dLdP;
+    }
+
+    void recover(SizeT frame)
+    {
+        if(!provider.do_recover(frame))
+            throw AdjointSolverError{fmt::format("Failed to recover frame {}", frame)};
+        ++stats.recovers;
+    }
+
+    void factorize(const SparseCOOView& coo)
+    {
+        H = coo.to_sparse();
+        H.makeCompressed();
+
+        // redo the symbolic analysis only if the sparsity pattern changes
+        bool same_pattern =
+            H.rows() == pattern_rows && H.nonZeros() == static_cast<Eigen::Index>(inner.size())
+            && std::equal(outer.begin(), outer.end(), H.outerIndexPtr())
+            && std::equal(inner.begin(), inner.end(), H.innerIndexPtr());
+
+        if(!same_pattern)
+        {
+            pattern_rows = H.rows();
+            outer.assign(H.outerIndexPtr(), H.outerIndexPtr() + H.outerSize() + 1);
+            inner.assign(H.innerIndexPtr(), H.innerIndexPtr() + H.nonZeros());
+            ldlt.analyzePattern(H);
+            ++stats.analyses;
+        }
+
+        ldlt.factorize(H);
+        ++stats.factorizations;
+        if(ldlt.info() != Eigen::Success)
+            throw AdjointSolverError{"Failed to factorize the Hessian"};
+    }
+
+    FrameSystemProvider& provider;
+    SizeT                checkpoint_count;
+    Statistics           stats;
+
+    Eigen::SparseMatrix<Float>                      H;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<Float>> ldlt;
+    Eigen::Index                                    pattern_rows = -1;
+    vector<int>                                     outer;
+    vector<int>                                     inner;
+};
+
+AdjointSolver::AdjointSolver(FrameSystemProvider& provider, SizeT checkpoint_count)
+    : m_impl{uipc::make_unique<Impl>(provider, checkpoint_count)}
+{
+}
+
+AdjointSolver::~AdjointSolver() {}
+
+VectorX AdjointSolver::solve(SizeT begin, SizeT end, const LossGradient& dLdx)
+{
+    return m_impl->solve(begin, end, dLdx);
+}
+
+const AdjointSolver::Statistics& AdjointSolver::statistics() const noexcept
+{
+    return m_impl->stats;
+}
+
+HostAdjointMethod::HostAdjointMethod(FrameSystemProvider& provider, SizeT checkpoint_count)
+    : m_provider(provider)
+    , m_solver(provider, checkpoint_count)
+    , m_begin(provider.get_frame())
+{
+}
+
+void HostAdjointMethod::do_select_dofs(SizeT frame, backend::BufferView in_SDI)
+{
+    UIPC_ASSERT(m_provider.get_frame() == frame,
+                "Dofs must be selected at the current frame, current={}, yours={}",
+                m_provider.get_frame(),
+                frame);
+
+    // a new forward pass starts
+    if(!m_selections.empty() && frame <= m_selections.back().frame)
+        m_selections.clear();
+
+    auto  SDI  = host_span<const IndexT>(in_SDI);
+    auto  dofs = m_provider.get_dofs();
+    auto& s    = m_selections.emplace_back();
+    s.frame    = frame;
+    s.indices.assign(SDI.begin(), SDI.end());
+    s.values.resize(SDI.size());
+    for(SizeT i = 0; i < SDI.size(); ++i)
+        s.values[i] = dofs[SDI[i]];
+}
+
+void HostAdjointMethod::do_receive_dofs(backend::BufferView out_dofs)
+{
+    auto  out    = host_span<Float>(out_dofs);
+    SizeT offset = 0;
+    for(auto& s : m_selections)
+    {
+        UIPC_ASSERT(offset + s.values.size() <= out.size(),
+                    "Output buffer is too small, size={}",
+                    out.size());
+        std::ranges::copy(s.values, out.begin() + offset);
+        offset += s.values.size();
+    }
+}
+
+void HostAdjointMethod::do_compute_dLdP(backend::BufferView out_dLdP, backend::BufferView in_dLdx)
+{
+    auto in  = host_span<const Float>(in_dLdx);
+    auto out = host_span<Float>(out_dLdP);
+
+    // no dofs selected, the loss doesn't depend on the parameters
+    if(m_selections.empty())
+    {
+        std::ranges::fill(out, Float{0});
+        return;
+    }
+
+    // offsets of the selections in `in_dLdx`
+    vector<SizeT> offsets(m_selections.size() + 1, 0);
+    for(SizeT i = 0; i < m_selections.size(); ++i)
+        offsets[i + 1] = offsets[i] + m_selections[i].indices.size();
+    UIPC_ASSERT(in.size() == offsets.back(),
+                "dLdx size mismatch, expected={}, yours={}",
+                offsets.back(),
+                in.size());
+
+    // the dofs depend on the parameters through all the frames of the forward pass
+    SizeT begin = std::min(m_begin, m_selections.front().frame - 1);
+    SizeT end   = m_selections.back().frame;
+
+    auto dLdP = m_solver.solve(begin,
+                               end,
+                               [&](SizeT frame, Eigen::Ref<VectorX> dLdx)
+                               {
+                                   auto it = std::ranges::find(m_selections, frame, &Selection::frame);
+                                   if(it == m_selections.end())
+                                       return;
+                                   SizeT I = std::distance(m_selections.begin(), it);
+                                   for(SizeT i = 0; i < it->indices.size(); ++i)
+                                       dLdx[it->indices[i]] += in[offsets[I] + i];
+                               });
+
+    UIPC_ASSERT(out.size() == static_cast<SizeT>(dLdP.size()),
+                "dLdP size mismatch, expected={}, yours={}",
+                dLdP.size(),
+                out.size());
+    std::ranges::copy(dLdP, out.begin());
+}
+
+const AdjointSolver& HostAdjointMethod::solver() const noexcept
+{
+    return m_solver;
+}
+}  // namespace uipc::diff_sim
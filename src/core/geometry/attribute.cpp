@@ -29,6 +29,30 @@ std::string_view IAttribute::type_name() const noexcept
     return get_type_name();
 }
 
+SizeT IAttribute::memory_usage() const noexcept
+{
+    return get_memory_usage();
+}
+
+std::pmr::memory_resource* IAttribute::memory_resource() const noexcept
+{
+    return get_memory_resource();
+}
+
+U64 IAttribute::content_hash() const noexcept
+{
+    return get_content_hash();
+}
+
+bool IAttribute::content_equal(const IAttribute& other) const noexcept
+{
+    if(std::addressof(other) == this)
+        return true;
+    if(type_name() != other.type_name() || size() != other.size())
+        return false;
+    return get_content_equal(other);
+}
+
 void IAttribute::resize(SizeT N)
 {
     do_resize(N);
@@ -4,11 +4,68 @@
 #include <uipc/common/set.h>
 #include <uipc/common/list.h>
 #include <uipc/common/range.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/string_interner.h>
 #include <iostream>
+#include <algorithm>
+#include <uipc/common/parallel_for.h>
 #include <uipc/geometry/attribute_collection_factory.h>
 
 namespace uipc::geometry
 {
+SizeT AttributeCollection::SlotMap::index_of(const AttributeKey& key) const noexcept
+{
+    const U64 h = key.hash();
+    for(SizeT i = 0; i < m_hashes.size(); ++i)
+    {
+        if(m_hashes[i] == h && m_entries[i].first.name() == key.name())
+            return i;
+    }
+    return m_hashes.size();
+}
+
+auto AttributeCollection::SlotMap::find(const AttributeKey& key) noexcept -> iterator
+{
+    return m_entries.begin() + index_of(key);
+}
+
+auto AttributeCollection::SlotMap::find(const AttributeKey& key) const noexcept -> const_iterator
+{
+    return m_entries.begin() + index_of(key);
+}
+
+S<IAttributeSlot>& AttributeCollection::SlotMap::operator[](const AttributeKey& key)
+{
+    auto i = index_of(key);
+    if(i != m_entries.size())
+        return m_entries[i].second;
+
+    // the key may view a temporary string, so store the interned name
+    m_hashes.push_back(key.hash());
+    m_entries.emplace_back(AttributeKey{intern(key.name())}, nullptr);
+    return m_entries.back().second;
+}
+
+void AttributeCollection::SlotMap::erase(const_iterator it)
+{
+    auto i = it - m_entries.cbegin();
+    m_hashes.erase(m_hashes.begin() + i);
+    m_entries.erase(it);
+}
+
+void AttributeCollection::SlotMap::erase(const AttributeKey& key)
+{
+    auto it = std::as_const(*this).find(key);
+    if(it != m_entries.cend())
+        erase(it);
+}
+
+void AttributeCollection::SlotMap::clear() noexcept
+{
+    m_hashes.clear();
+    m_entries.clear();
+}
+
 S<IAttributeSlot> AttributeCollection::share(std::string_view      name,
                                              const IAttributeSlot& slot,
                                              bool allow_destroy)
@@ -23,8 +80,8 @@ S<IAttributeSlot> AttributeCollection::share(std::string_view      name,
                         size(),
                         slot.size())};
 
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    AttributeKey key{name};
+    auto         it = m_attributes.find(key);
 
     // if the attribute is already in the collection,
     // share the underlaying attribute
@@ -35,56 +92,102 @@ S<IAttributeSlot> AttributeCollection::share(std::string_view      name,
     }
     else  // if not, create a new attribute slot from the given one
     {
-        return m_attributes[n] = slot.clone(name, allow_destroy);
+        auto& s = m_attributes[key] = slot.clone(name, allow_destroy);
+        attach(*s);
+        return s;
     }
 }
 
-void AttributeCollection::destroy(std::string_view name)
+void AttributeCollection::destroy(const AttributeKey& key)
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(key);
     if(it == m_attributes.end())
     {
-        UIPC_WARN_WITH_LOCATION("Destroying non-existing attribute [{}]", name);
+        UIPC_WARN_WITH_LOCATION("Destroying non-existing attribute [{}]", key.name());
         return;
     }
 
     if(!it->second->allow_destroy())
         throw AttributeCollectionError{
-            fmt::format("Attribute [{}] don't allow destroy!", name)};
+            fmt::format("Attribute [{}] don't allow destroy!", key.name())};
 
     m_attributes.erase(it);
+    touch();
 }
 
-S<IAttributeSlot> AttributeCollection::find(std::string_view name)
+S<IAttributeSlot> AttributeCollection::find(const AttributeKey& key)
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(key);
     return it != m_attributes.end() ? it->second : nullptr;
 }
 
 
-S<const IAttributeSlot> AttributeCollection::find(std::string_view name) const
+S<const IAttributeSlot> AttributeCollection::find(const AttributeKey& key) const
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(key);
     return it != m_attributes.end() ? it->second : nullptr;
 }
 
+namespace
+{
+    /**
+     * @brief Call `f(i)` for each of the `attribute_count` attributes, in parallel over the attributes
+     * if there is enough work.
+     *
+     * `chunked`: `f` already splits a large attribute into parallel chunks, then the attributes are
+     * processed one by one to not nest the threads.
+     */
+    template <typename F>
+    void for_each_attribute(SizeT attribute_count, SizeT value_count, bool chunked, F&& f)
+    {
+        constexpr SizeT MinParallelWork = SizeT{1} << 15;
+
+        bool parallel = attribute_count > 1 && value_count * attribute_count >= MinParallelWork
+                        && !(chunked && value_count >= detail::ParallelAttributeSize);
+
+        if(parallel)
+            parallel_for(0, attribute_count, f, 1);
+        else
+            for(SizeT i = 0; i < attribute_count; ++i)
+                f(i);
+    }
+}  // namespace
+
 void AttributeCollection::resize(SizeT N)
 {
+    // the slots are made writable on this thread, then the attributes are resized in parallel,
+    // the memory resource they allocate from is thread-safe (see `MemoryResourceGuard`)
+    vector<IAttribute*> attributes;
+    attributes.reserve(m_attributes.size());
     for(auto& [name, slot] : m_attributes)
     {
         slot->rw_access();
-        slot->attribute().resize(N);
+        attributes.push_back(&slot->attribute());
     }
+
+    for_each_attribute(attributes.size(),
+                       std::max(N, m_size),
+                       false,
+                       [&](SizeT i) { attributes[i]->resize(N); });
     m_size = N;
+    // a collection without slots is modified as well
+    touch();
 }
 
 void AttributeCollection::reorder(span<const SizeT> O)
 {
+    vector<IAttribute*> attributes;
+    attributes.reserve(m_attributes.size());
     for(auto& [name, slot] : m_attributes)
     {
         slot->rw_access();
-        slot->attribute().reorder(O);
+        attributes.push_back(&slot->attribute());
     }
+
+    for_each_attribute(attributes.size(),
+                       O.size(),
+                       true,
+                       [&](SizeT i) { attributes[i]->reorder(O); });
 }
 
 void AttributeCollection::copy_from(const AttributeCollection& other,
@@ -98,6 +201,8 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
 
     if(_include_names.empty())
         include_names = other.names();
+    else
+        include_names.assign(_include_names.begin(), _include_names.end());
 
     filtered_names.reserve(include_names.size());
 
@@ -112,9 +217,17 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
         filtered_names = std::move(include_names);
     }
 
-    for(auto& name : filtered_names)
+    struct CopyTask
+    {
+        IAttribute*       dst;
+        const IAttribute* src;
+    };
+    vector<CopyTask> tasks;
+
+    for(auto& filtered_name : filtered_names)
     {
-        auto it = other.m_attributes.find(name);
+        AttributeKey name{filtered_name};
+        auto         it = other.m_attributes.find(name);
         if(it == other.m_attributes.end())
             throw AttributeCollectionError{fmt::format(
                 "Attribute [{}] not found in the source attribute collection.", name)};
@@ -139,8 +252,9 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
             }
             else
             {
-                m_attributes[name] =
+                auto& s = m_attributes[name] =
                     other_slot->clone(other_slot->name(), other_slot->allow_destroy());
+                attach(*s);
             }
 
             continue;
@@ -156,17 +270,152 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
             UIPC_ASSERT(c->is_shared() == false, "The attribute is shared, why can it happen?");
 
             m_attributes[name] = c;
+            attach(*c);
 
             c->attribute().resize(size());
-            c->attribute().copy_from(other_slot->attribute(), copy);
+            tasks.push_back({&c->attribute(), &other_slot->attribute()});
         }
         else  // the name is found in the current collection
         {
             this_it->second->make_owned();
-            // apply copy
-            this_it->second->attribute().copy_from(other_slot->attribute(), copy);
+            tasks.push_back({&this_it->second->attribute(), &other_slot->attribute()});
         }
     }
+
+    if(!tasks.empty())
+        touch();
+
+    // apply the copies, the slots are created above, because the map of the slots is not thread-safe
+    for_each_attribute(tasks.size(),
+                       std::max(size(), other.size()),
+                       true,
+                       [&](SizeT i) { tasks[i].dst->copy_from(*tasks[i].src, copy); });
+}
+
+void AttributeCollection::concat_from(span<const AttributeCollection* const> sources,
+                                      span<const string> exclude_names)
+{
+    concat_from(sources, span<const span<const SizeT>>{}, exclude_names);
+}
+
+void AttributeCollection::concat_from(span<const AttributeCollection* const> sources,
+                                      span<const span<const SizeT>>         mappings,
+                                      span<const string> exclude_names)
+{
+    UIPC_ASSERT(mappings.empty() || mappings.size() == sources.size(),
+                "Mapping count mismatch, {} sources, {} mappings.",
+                sources.size(),
+                mappings.size());
+
+    // the number of rows each source contributes
+    auto count = [&](SizeT I)
+    { return mappings.empty() ? sources[I]->size() : mappings[I].size(); };
+
+    vector<SizeT> offsets(sources.size() + 1, 0);
+    for(auto&& [I, source] : enumerate(sources))
+        offsets[I + 1] = offsets[I] + count(I);
+
+    resize(offsets.back());
+
+    auto is_excluded = [&](std::string_view name)
+    {
+        return std::ranges::find(exclude_names, name) != exclude_names.end();
+    };
+
+    // 1) group the source attributes by name, only once
+    struct Group
+    {
+        AttributeKey              key;
+        const IAttributeSlot*     first = nullptr;
+        vector<const IAttribute*> attributes;
+    };
+
+    vector<Group> groups;
+    for(auto&& [I, source] : enumerate(sources))
+    {
+        if(count(I) == 0)
+            continue;
+
+        for(auto& [key, slot] : source->m_attributes)
+        {
+            auto it = std::ranges::find(groups, key, &Group::key);
+            if(it == groups.end())
+            {
+                if(is_excluded(key))
+                    continue;
+                auto& group = groups.emplace_back();
+                group.key   = key;
+                group.first = slot.get();
+                group.attributes.resize(sources.size(), nullptr);
+                it = groups.end() - 1;
+            }
+            else if(it->first->type_name() != slot->type_name())
+            {
+                throw AttributeCollectionError{fmt::format(
+                    "Attribute [{}] type mismatch, <{}> in sources[0..{}), <{}> in sources[{}].",
+                    key.name(),
+                    it->first->type_name(),
+                    I,
+                    slot->type_name(),
+                    I)};
+            }
+            it->attributes[I] = &slot->attribute();
+        }
+    }
+
+    // 2) prepare the destination attributes
+    struct Task
+    {
+        IAttribute*       dst;
+        const IAttribute* src;
+        SizeT             source;
+    };
+
+    vector<Task> tasks;
+    for(auto& group : groups)
+    {
+        auto& dst_slot = m_attributes[group.key];
+        if(!dst_slot)
+        {
+            dst_slot = group.first->do_clone_empty(group.first->name(),
+                                                   group.first->allow_destroy());
+            dst_slot->attribute().resize(size());
+            attach(*dst_slot);
+        }
+        else
+        {
+            if(dst_slot->type_name() != group.first->type_name())
+                throw AttributeCollectionError{fmt::format(
+                    "Attribute [{}] type mismatch, dst is <{}>, src is <{}>.",
+                    group.key.name(),
+                    dst_slot->type_name(),
+                    group.first->type_name())};
+            dst_slot->rw_access();
+        }
+
+        auto dst = &dst_slot->attribute();
+        for(auto&& [I, src] : enumerate(group.attributes))
+        {
+            if(src)
+                tasks.push_back({dst, src, I});
+        }
+    }
+
+    // 3) copy, every task writes to a disjoint range of the destination
+    parallel_for(0,
+                 tasks.size(),
+                 [&](SizeT i)
+                 {
+                     auto& task   = tasks[i];
+                     auto  offset = offsets[task.source];
+                     if(mappings.empty())
+                         task.dst->copy_from(*task.src,
+                                             AttributeCopy::range(offset, 0, task.src->size()));
+                     else
+                         task.dst->copy_from(*task.src,
+                                             AttributeCopy::pull(mappings[task.source], offset));
+                 },
+                 256);
 }
 
 SizeT AttributeCollection::size() const
@@ -181,6 +430,7 @@ void AttributeCollection::clear()
         slot->make_owned();
         slot->attribute().clear();
     }
+    touch();
 }
 
 void AttributeCollection::reserve(SizeT N)
@@ -197,7 +447,7 @@ vector<string> AttributeCollection::names() const
     names.reserve(m_attributes.size());
     for(auto& [name, slot] : m_attributes)
     {
-        names.push_back(name);
+        names.emplace_back(name);
     }
     return names;
 }
@@ -207,12 +457,33 @@ SizeT AttributeCollection::attribute_count() const
     return m_attributes.size();
 }
 
+U64 AttributeCollection::modification_stamp() const noexcept
+{
+    // a new stamp is taken only if the collection is modified since the last call
+    if(m_dirty && m_dirty->exchange(false, std::memory_order_relaxed))
+        m_stamp = IAttributeSlot::next_modification_stamp();
+    return m_stamp;
+}
+
+void AttributeCollection::attach(IAttributeSlot& slot)
+{
+    touch();
+    slot.m_collection_dirty = m_dirty;
+}
+
+void AttributeCollection::touch()
+{
+    if(!m_dirty)
+        m_dirty = uipc::make_shared<std::atomic<bool>>(true);
+    m_dirty->store(true, std::memory_order_relaxed);
+}
+
 Json AttributeCollection::to_json() const
 {
     Json j = Json::object();
     for(auto& [name, slot] : m_attributes)
     {
-        j[name] = slot->to_json();
+        j[std::string{name}] = slot->to_json();
     }
     return j;
 }
@@ -229,12 +500,19 @@ void AttributeCollection::update_from(const AttributeCollectionCommit& commit)
     }
 }
 
+AttributeCollection::AttributeCollection()
+{
+    touch();
+}
+
 AttributeCollection::AttributeCollection(const AttributeCollection& o)
 {
+    touch();
     for(auto& [name, attr] : o.m_attributes)
     {
         auto attr_slot     = attr->clone(attr->name(), attr->allow_destroy());
         m_attributes[name] = attr_slot;
+        attach(*attr_slot);
     }
     m_size = o.m_size;
 }
@@ -245,7 +523,7 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
         return *this;
     resize(o.m_size);
 
-    list<std::string> to_remove;
+    list<AttributeKey> to_remove;
 
     for(auto& [name, attr] : m_attributes)
     {
@@ -260,6 +538,7 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
     {
         m_attributes.erase(name);
     }
+    touch();
 
     for(auto& [name, attr] : o.m_attributes)
     {
@@ -270,7 +549,8 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
         }
         else
         {
-            m_attributes[name] = attr->clone(attr->name(), attr->allow_destroy());
+            auto& s = m_attributes[name] = attr->clone(attr->name(), attr->allow_destroy());
+            attach(*s);
         }
     }
     return *this;
@@ -279,6 +559,8 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
 AttributeCollection::AttributeCollection(AttributeCollection&& o) noexcept
     : m_attributes(std::move(o.m_attributes))
     , m_size(o.m_size)
+    , m_dirty(std::move(o.m_dirty))
+    , m_stamp(o.m_stamp)
 {
     o.m_size = 0;
 }
@@ -289,7 +571,11 @@ AttributeCollection& AttributeCollection::operator=(AttributeCollection&& o) noe
         return *this;
     m_attributes = std::move(o.m_attributes);
     m_size       = o.m_size;
+    m_dirty      = std::move(o.m_dirty);
+    m_stamp      = o.m_stamp;
     o.m_size     = 0;
+    if(m_dirty)
+        m_dirty->store(true, std::memory_order_relaxed);
     return *this;
 }
 
@@ -301,8 +587,8 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
                                                 const T&         default_value,
                                                 bool             allow_destroy)
 {
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    AttributeKey key{name};
+    auto         it = m_attributes.find(key);
     if(it != m_attributes.end())
     {
         throw AttributeCollectionError{
@@ -311,13 +597,64 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
     auto A = uipc::make_shared<Attribute<T>>(default_value);
     A->resize(m_size);
     auto S = uipc::make_shared<AttributeSlot<T>>(name, A, allow_destroy);
-    m_attributes[n] = S;
+    m_attributes[key] = S;
+    attach(*S);
     return S;
 }
 
-#define UIPC_ATTRIBUTE_EXPORT_DEF(T)                                           \
-    template UIPC_CORE_API S<AttributeSlot<T>> AttributeCollection::create<T>( \
-        std::string_view, const T&, bool);
+template <typename T>
+S<AttributeSlot<T>> AttributeCollection::adopt(std::string_view name,
+                                               vector<T>&&      values,
+                                               const T&         default_value,
+                                               bool             allow_destroy)
+{
+    check_new_attribute(name, values.size());
+    AttributeKey key{name};
+    auto A = uipc::make_shared<Attribute<T>>(std::move(values), default_value);
+    auto S = uipc::make_shared<AttributeSlot<T>>(name, A, allow_destroy);
+    m_attributes[key] = S;
+    attach(*S);
+    return S;
+}
+
+template <typename T>
+S<AttributeSlot<T>> AttributeCollection::create_from(std::string_view name,
+                                                     span<const T>    values,
+                                                     const T&         default_value,
+                                                     bool allow_destroy)
+{
+    check_new_attribute(name, values.size());
+    // copy construct the values in place, without filling the default value first
+    vector<T> V;
+    V.reserve(values.size());
+    V.insert(V.end(), values.begin(), values.end());
+    return adopt<T>(name, std::move(V), default_value, allow_destroy);
+}
+
+void AttributeCollection::check_new_attribute(std::string_view name, SizeT value_count) const
+{
+    if(m_attributes.find(AttributeKey{name}) != m_attributes.end())
+    {
+        throw AttributeCollectionError{
+            fmt::format("Attribute with name [{}] already exist!", name)};
+    }
+    if(value_count != m_size)
+    {
+        throw AttributeCollectionError{
+            fmt::format("Attribute [{}] has {} values, but the attribute collection size is {}.",
+                        name,
+                        value_count,
+                        m_size)};
+    }
+}
+
+#define UIPC_ATTRIBUTE_EXPORT_DEF(T)                                                \
+    template UIPC_CORE_API S<AttributeSlot<T>> AttributeCollection::create<T>(      \
+        std::string_view, const T&, bool);                                          \
+    template UIPC_CORE_API S<AttributeSlot<T>> AttributeCollection::adopt<T>(       \
+        std::string_view, vector<T>&&, const T&, bool);                             \
+    template UIPC_CORE_API S<AttributeSlot<T>> AttributeCollection::create_from<T>( \
+        std::string_view, span<const T>, const T&, bool);
 
 #include <uipc/geometry/details/attribute_export_types.inl>
 
@@ -336,7 +673,7 @@ appender formatter<uipc::geometry::AttributeCollection>::format(
     for(const auto& [name, slot] : collection.m_attributes)
     {
         std::string_view star = slot->allow_destroy() ? "" : "*";
-        fmt::format_to(ctx.out(), "{}'{}':<{}> ", star, name, slot->type_name());
+        fmt::format_to(ctx.out(), "{}'{}':<{}> ", star, name.name(), slot->type_name());
     }
 
     fmt::format_to(ctx.out(), "]");
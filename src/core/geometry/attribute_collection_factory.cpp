@@ -146,7 +146,9 @@ class AttributeCollectionFactory::Impl
             auto allow_destroy = allow_destroy_it->get<bool>();
 
             S<IAttributeSlot> attr = ctx.attribute_slot_of(index);
-            ac->resize(attr->size());
+            // resizing makes the shared attributes owned, only resize if needed
+            if(ac->size() != attr->size())
+                ac->resize(attr->size());
             ac->share(name, *attr, allow_destroy);
         }
 
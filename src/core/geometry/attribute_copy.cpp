@@ -28,6 +28,14 @@ AttributeCopy AttributeCopy::pull(span<const SizeT> mapping) noexcept
     copy.m_mapping = mapping;
     return copy;
 }
+AttributeCopy AttributeCopy::pull(span<const SizeT> mapping, SizeT dst_offset) noexcept
+{
+    AttributeCopy copy;
+    copy.m_type       = CopyType::Pull;
+    copy.m_mapping    = mapping;
+    copy.m_dst_offset = dst_offset;
+    return copy;
+}
 AttributeCopy AttributeCopy::push(span<const SizeT> mapping) noexcept
 {
     AttributeCopy copy;
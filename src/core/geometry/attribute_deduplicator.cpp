@@ -0,0 +1,117 @@
+#include <uipc/geometry/attribute_deduplicator.h>
+#include <uipc/common/unordered_map.h>
+#include <algorithm>
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<AttributeDeduplicator>
+{
+  public:
+    static auto& attribute_slots(AttributeCollection& ac) { return ac.m_attributes; }
+
+    static const IAttribute& attribute(const IAttributeSlot& slot)
+    {
+        return slot.attribute();
+    }
+
+    // share the attribute of `src`, only the attribute changes
+    static void share(IAttributeSlot& dst, const IAttributeSlot& src)
+    {
+        auto tp       = dst.last_modified();
+        auto evolving = dst.is_evolving();
+        dst.share_from(src);
+        dst.is_evolving(evolving);
+        dst.last_modified(tp);
+    }
+};
+
+template <>
+class GeometryFriend<AttributeDeduplicator>
+{
+  public:
+    static void attribute_collections(Geometry&                     geometry,
+                                      vector<std::string>&          names,
+                                      vector<AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+};
+
+class AttributeDeduplicator::Impl
+{
+  public:
+    using AF = AttributeFriend<AttributeDeduplicator>;
+    using GF = GeometryFriend<AttributeDeduplicator>;
+
+    SizeT deduplicate(AttributeCollection& ac)
+    {
+        SizeT count = 0;
+        for(auto&& [key, slot] : AF::attribute_slots(ac))
+        {
+            auto& attr       = AF::attribute(*slot);
+            auto& candidates = m_content_to_slots[attr.content_hash()];
+
+            auto same = std::ranges::find_if(
+                candidates,
+                [&](const S<IAttributeSlot>& c)
+                { return AF::attribute(*c).content_equal(attr); });
+
+            if(same == candidates.end())
+            {
+                candidates.push_back(slot);
+                continue;
+            }
+
+            // already shared
+            if(&AF::attribute(**same) == &attr)
+                continue;
+
+            // the values are released if no one else holds them
+            if(!slot->is_shared())
+                m_released_bytes += attr.memory_usage();
+
+            AF::share(*slot, **same);
+            ++count;
+        }
+        return count;
+    }
+
+    SizeT deduplicate(Geometry& geometry)
+    {
+        vector<std::string>          names;
+        vector<AttributeCollection*> collections;
+        GF::attribute_collections(geometry, names, collections);
+
+        SizeT count = 0;
+        for(auto ac : collections)
+            count += deduplicate(*ac);
+        return count;
+    }
+
+    unordered_map<U64, vector<S<IAttributeSlot>>> m_content_to_slots;
+    SizeT                                         m_released_bytes = 0;
+};
+
+AttributeDeduplicator::AttributeDeduplicator()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+AttributeDeduplicator::~AttributeDeduplicator() {}
+
+SizeT AttributeDeduplicator::deduplicate(AttributeCollection& ac)
+{
+    return m_impl->deduplicate(ac);
+}
+
+SizeT AttributeDeduplicator::deduplicate(Geometry& geometry)
+{
+    return m_impl->deduplicate(geometry);
+}
+
+SizeT AttributeDeduplicator::released_bytes() const noexcept
+{
+    return m_impl->m_released_bytes;
+}
+}  // namespace uipc::geometry
@@ -1,6 +1,8 @@
 #include <uipc/geometry/attribute_factory.h>
 #include <uipc/geometry/attribute_slot.h>
 #include <uipc/builtin/factory_keyword.h>
+#include <uipc/common/json_eigen.h>
+#include <cmath>
 
 namespace uipc::geometry
 {
@@ -27,6 +29,454 @@ static void register_type(std::unordered_map<std::string, Creator>& creators)
 }
 
 
+/**************************************************************
+*                       Stream Codec
+***************************************************************/
+
+template <typename T>
+static void encode_value(JsonStreamEncoder& e, const T& v)
+{
+    if constexpr(std::is_same_v<T, std::string>)
+        e.string(v);
+    else if constexpr(std::is_floating_point_v<T>)
+        e.number_float(v);
+    else if constexpr(std::is_signed_v<T>)
+        e.number_integer(v);
+    else if constexpr(std::is_unsigned_v<T>)
+        e.number_unsigned(v);
+    else  // Eigen matrices, an array of rows, the same as their json
+    {
+        e.start_array();
+        for(Eigen::Index i = 0; i < v.rows(); ++i)
+        {
+            e.start_array();
+            for(Eigen::Index j = 0; j < v.cols(); ++j)
+                encode_value(e, v(i, j));
+            e.end_array();
+        }
+        e.end_array();
+    }
+}
+
+// Decode the `values` of an Attribute<T> into the final buffer
+class IValuesDecoder : public JsonSaxConsumer
+{
+  public:
+    virtual S<IAttributeSlot> create(const Json* default_value) = 0;
+};
+
+template <typename T>
+class ValuesDecoder final : public IValuesDecoder
+{
+    static constexpr bool IsString = std::is_same_v<T, std::string>;
+    static constexpr bool IsScalar = std::is_arithmetic_v<T>;
+
+    template <typename U>
+    struct ScalarOf
+    {
+        using type = U;
+    };
+    template <typename U>
+        requires requires { typename U::Scalar; }
+    struct ScalarOf<U>
+    {
+        using type = typename U::Scalar;
+    };
+
+    using Scalar = typename ScalarOf<T>::type;
+
+  public:
+    bool null() override
+    {
+        if constexpr(std::is_floating_point_v<Scalar>)
+            return number(std::numeric_limits<Scalar>::quiet_NaN());
+        else
+            return invalid("null");
+    }
+
+    bool boolean(bool) override { return invalid("boolean"); }
+    bool number_integer(I64 v) override { return number(v); }
+    bool number_unsigned(U64 v) override { return number(v); }
+    bool number_float(double v) override { return number(v); }
+
+    bool string(std::string& v) override
+    {
+        if constexpr(IsString)
+        {
+            if(m_depth != 1)
+                return invalid("string");
+            m_values.push_back(std::move(v));
+            return true;
+        }
+        else
+            return invalid("string");
+    }
+
+    bool start_object() override { return invalid("object"); }
+    bool key(std::string&) override { return invalid("key"); }
+    bool end_object() override { return invalid("object"); }
+
+    bool start_array() override
+    {
+        ++m_depth;
+        // 1: values, 2: a matrix, 3: a row of the matrix
+        if(m_depth == 2)
+        {
+            m_scalars.clear();
+            m_rows = 0;
+        }
+        else if(m_depth == 3)
+        {
+            ++m_rows;
+        }
+        if((IsScalar || IsString) ? m_depth > 1 : m_depth > 3)
+            return invalid("array");
+        return true;
+    }
+
+    bool end_array() override
+    {
+        if constexpr(!IsScalar && !IsString)
+        {
+            if(m_depth == 2)
+                m_values.push_back(build());
+        }
+        --m_depth;
+        return true;
+    }
+
+    S<IAttributeSlot> create(const Json* default_value) override
+    {
+        auto attribute = default_value ?
+                             uipc::make_shared<Attribute<T>>(std::move(m_values),
+                                                             default_value->get<T>()) :
+                             uipc::make_shared<Attribute<T>>();
+        return uipc::make_shared<AttributeSlot<T>>("", attribute, false);
+    }
+
+  private:
+    template <typename V>
+    bool number(V v)
+    {
+        if constexpr(IsString)
+        {
+            return invalid("number");
+        }
+        else if constexpr(IsScalar)
+        {
+            if(m_depth != 1)
+                return invalid("number");
+            m_values.push_back(static_cast<T>(v));
+            return true;
+        }
+        else
+        {
+            if(m_depth != 3)
+                return invalid("number");
+            m_scalars.push_back(static_cast<Scalar>(v));
+            return true;
+        }
+    }
+
+    T build()
+    {
+        T m;
+        if constexpr(!IsScalar && !IsString)
+        {
+            Eigen::Index rows = m_rows;
+            Eigen::Index cols = rows ? static_cast<Eigen::Index>(m_scalars.size()) / rows : 0;
+            if constexpr(T::ColsAtCompileTime != Eigen::Dynamic)
+                cols = T::ColsAtCompileTime;
+            if constexpr(T::RowsAtCompileTime == Eigen::Dynamic || T::ColsAtCompileTime == Eigen::Dynamic)
+                m.resize(rows, cols);
+
+            if(rows != m.rows() || static_cast<SizeT>(m.size()) != m_scalars.size())
+                throw JsonIOError{fmt::format("Unexpected matrix size of Attribute<{}>, rows={}, scalars={}",
+                                              Attribute<T>::type(),
+                                              rows,
+                                              m_scalars.size())};
+
+            for(Eigen::Index i = 0; i < m.rows(); ++i)
+                for(Eigen::Index j = 0; j < m.cols(); ++j)
+                    m(i, j) = m_scalars[i * m.cols() + j];
+        }
+        return m;
+    }
+
+    bool invalid(std::string_view what)
+    {
+        throw JsonIOError{fmt::format("Unexpected {} in the values of Attribute<{}>",
+                                      what,
+                                      Attribute<T>::type())};
+    }
+
+    vector<T>      m_values;
+    vector<Scalar> m_scalars;
+    SizeT          m_rows  = 0;
+    SizeT          m_depth = 0;
+};
+
+struct StreamCodec
+{
+    std::function<void(const IAttribute&, JsonStreamEncoder&)> encode;
+    std::function<U<IValuesDecoder>()>                           decoder;
+};
+
+template <typename T>
+static void register_codec(std::unordered_map<std::string, StreamCodec>& codecs)
+{
+    StreamCodec codec;
+    codec.encode = [](const IAttribute& a, JsonStreamEncoder& e)
+    {
+        auto& attribute = static_cast<const Attribute<T>&>(a);
+        e.start_object();
+        e.key("values");
+        e.start_array();
+        for(auto& v : attribute.view())
+            encode_value(e, v);
+        e.end_array();
+        e.key("default_value");
+        encode_value(e, attribute.default_value());
+        e.end_object();
+    };
+    codec.decoder = [] { return uipc::make_unique<ValuesDecoder<T>>(); };
+    codecs.insert({Attribute<T>::type(), std::move(codec)});
+}
+
+// Decode an element of AttributeFactory::to_json(), the layout is:
+// { __meta__: { base: "IAttribute", type: "T" }, __data__: { values: [...], default_value: ... } }
+//
+// If __meta__ comes first (JsonStreamWriter does so), the values are decoded into the final buffer,
+// otherwise __data__ is kept in a Json and the attribute is created from it.
+class AttributeDecoder final : public JsonSaxConsumer
+{
+  public:
+    using OnDecoded = std::function<void(S<IAttributeSlot>)>;
+    using Codecs    = std::unordered_map<std::string, StreamCodec>;
+    using Creators  = std::unordered_map<std::string, Creator>;
+
+    AttributeDecoder(const Codecs& codecs, const Creators& creators, OnDecoded on_decoded)
+        : m_codecs(codecs)
+        , m_creators(creators)
+        , m_on_decoded(std::move(on_decoded))
+    {
+    }
+
+    bool null() override
+    {
+        return scalar([](JsonSaxConsumer& c) { return c.null(); });
+    }
+    bool boolean(bool v) override
+    {
+        return scalar([v](JsonSaxConsumer& c) { return c.boolean(v); });
+    }
+    bool number_integer(I64 v) override
+    {
+        return scalar([v](JsonSaxConsumer& c) { return c.number_integer(v); });
+    }
+    bool number_unsigned(U64 v) override
+    {
+        return scalar([v](JsonSaxConsumer& c) { return c.number_unsigned(v); });
+    }
+    bool number_float(double v) override
+    {
+        return scalar([v](JsonSaxConsumer& c) { return c.number_float(v); });
+    }
+    bool string(std::string& v) override
+    {
+        return scalar([&v](JsonSaxConsumer& c) { return c.string(v); });
+    }
+
+    bool start_object() override
+    {
+        if(m_sub)
+        {
+            ++m_sub_depth;
+            return m_sub->start_object();
+        }
+        // 1: the element, 2: the __data__ decoded in place
+        ++m_depth;
+        return true;
+    }
+
+    bool key(std::string& k) override
+    {
+        if(m_sub)
+            return m_sub->key(k);
+
+        if(m_depth == 1)
+        {
+            if(k == builtin::__meta__)
+            {
+                m_meta = uipc::make_unique<JsonSaxDomBuilder>();
+                forward(m_meta.get());
+            }
+            else if(k == builtin::__data__ && (m_values = values_decoder()))
+            {
+                // decoded in place
+            }
+            else if(k == builtin::__data__)
+            {
+                m_data = uipc::make_unique<JsonSaxDomBuilder>();
+                forward(m_data.get());
+            }
+            else
+            {
+                skip();
+            }
+        }
+        else if(m_depth == 2 && k == "values")
+        {
+            m_has_values = true;
+            forward(m_values.get());
+        }
+        else if(m_depth == 2 && k == "default_value")
+        {
+            m_default = uipc::make_unique<JsonSaxDomBuilder>();
+            forward(m_default.get());
+        }
+        else
+        {
+            skip();
+        }
+        return true;
+    }
+
+    bool end_object() override
+    {
+        if(m_sub)
+        {
+            bool ok = m_sub->end_object();
+            if(--m_sub_depth == 0)
+                m_sub = nullptr;
+            return ok;
+        }
+        if(--m_depth == 0)
+            finish();
+        return true;
+    }
+
+    bool start_array() override
+    {
+        if(!m_sub)
+            throw JsonIOError{"Unexpected array in the json of an attribute"};
+        ++m_sub_depth;
+        return m_sub->start_array();
+    }
+
+    bool end_array() override
+    {
+        bool ok = m_sub->end_array();
+        if(--m_sub_depth == 0)
+            m_sub = nullptr;
+        return ok;
+    }
+
+  private:
+    template <typename F>
+    bool scalar(F&& f)
+    {
+        if(!m_sub)
+            throw JsonIOError{"Unexpected value in the json of an attribute"};
+        bool ok = f(*m_sub);
+        if(m_sub_depth == 0)
+            m_sub = nullptr;
+        return ok;
+    }
+
+    void forward(JsonSaxConsumer* sub)
+    {
+        m_sub       = sub;
+        m_sub_depth = 0;
+    }
+
+    void skip()
+    {
+        m_skipped = uipc::make_unique<JsonSaxDomBuilder>();
+        forward(m_skipped.get());
+    }
+
+    std::string type() const
+    {
+        if(!m_meta || !m_meta->done())
+            return {};
+        auto& meta    = m_meta->result();
+        auto  type_it = meta.find("type");
+        if(type_it == meta.end() || !type_it->is_string())
+            return {};
+        return type_it->get<std::string>();
+    }
+
+    U<IValuesDecoder> values_decoder() const
+    {
+        auto it = m_codecs.find(type());
+        if(it == m_codecs.end())
+            return nullptr;
+        return it->second.decoder();
+    }
+
+    void finish()
+    {
+        S<IAttributeSlot> slot;
+
+        Json base = m_meta ? m_meta->result().value("base", Json{}) : Json{};
+        if(base.is_null())
+        {
+            UIPC_WARN_WITH_LOCATION("`base` info not found, so we ignore it");
+        }
+        else if(base != "IAttribute")
+        {
+            UIPC_WARN_WITH_LOCATION("`base` info not match, so we ignore it");
+        }
+        else if(m_values)
+        {
+            if(!m_has_values)
+            {
+                UIPC_WARN_WITH_LOCATION("Can not find `values` in json, skip");
+            }
+            else if(!m_default)
+            {
+                UIPC_WARN_WITH_LOCATION("Can not find `default_value` in json, skip");
+            }
+
+            const Json* default_value =
+                m_has_values && m_default ? &m_default->result() : nullptr;
+            slot = m_values->create(default_value);
+        }
+        else
+        {
+            auto type       = this->type();
+            auto creator_it = m_creators.find(type);
+            if(creator_it == m_creators.end())
+            {
+                UIPC_WARN_WITH_LOCATION("Attribute<{}> not registered, so we ignore it", type);
+            }
+            else
+            {
+                slot = creator_it->second(m_data ? m_data->result() : Json::object());
+            }
+        }
+
+        m_on_decoded(std::move(slot));
+    }
+
+    const Codecs&   m_codecs;
+    const Creators& m_creators;
+    OnDecoded       m_on_decoded;
+
+    SizeT            m_depth     = 0;
+    JsonSaxConsumer* m_sub       = nullptr;
+    SizeT            m_sub_depth = 0;
+
+    U<JsonSaxDomBuilder> m_meta;
+    U<JsonSaxDomBuilder> m_data;
+    U<JsonSaxDomBuilder> m_default;
+    U<JsonSaxDomBuilder> m_skipped;
+    U<IValuesDecoder>    m_values;
+    bool                 m_has_values = false;
+};
+
+
 // A Json representation of the attribute looks like this:
 // {
 //     __meta__:
@@ -61,6 +511,55 @@ class AttributeFactory::Impl
         return m_creators;
     }
 
+    static auto& codecs()
+    {
+        static thread_local std::once_flag                               f;
+        static thread_local std::unordered_map<std::string, StreamCodec> m_codecs;
+
+        std::call_once(f,
+                       [&] {
+#define UIPC_ATTRIBUTE_EXPORT_DEF(T)                                           \
+    ::uipc::geometry::register_codec<T>(m_codecs);
+
+#include <uipc/geometry/details/attribute_export_types.inl>
+
+#undef UIPC_ATTRIBUTE_EXPORT_DEF
+                       });
+        return m_codecs;
+    }
+
+    void encode(const IAttribute& attr, JsonStreamEncoder& e)
+    {
+        auto it = codecs().find(std::string{attr.type_name()});
+        if(it == codecs().end())
+        {
+            UIPC_WARN_WITH_LOCATION("Attribute<{}> not registered, so we ignore it",
+                                    attr.type_name());
+            // keep the indices of the other attributes
+            e.null();
+            return;
+        }
+
+        e.start_object();
+        e.key(builtin::__meta__);
+        {
+            e.start_object();
+            e.key("base");
+            e.string("IAttribute");
+            e.key("type");
+            e.string(attr.type_name());
+            e.end_object();
+        }
+        e.key(builtin::__data__);
+        it->second.encode(attr, e);
+        e.end_object();
+    }
+
+    S<JsonSaxConsumer> decoder(std::function<void(S<IAttributeSlot>)> on_decoded)
+    {
+        return uipc::make_shared<AttributeDecoder>(codecs(), creators(), std::move(on_decoded));
+    }
+
     Json to_json(span<IAttribute*> attributes)
     {
         Json j = Json::array();
@@ -158,4 +657,14 @@ Json AttributeFactory::to_json(span<IAttribute*> attributes)
 {
     return m_impl->to_json(attributes);
 }
+
+void AttributeFactory::encode(const IAttribute& attribute, JsonStreamEncoder& encoder)
+{
+    m_impl->encode(attribute, encoder);
+}
+
+S<JsonSaxConsumer> AttributeFactory::decoder(std::function<void(S<IAttributeSlot>)> on_decoded)
+{
+    return m_impl->decoder(std::move(on_decoded));
+}
 }  // namespace uipc::geometry
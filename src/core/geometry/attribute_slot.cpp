@@ -95,5 +95,14 @@ void IAttributeSlot::rw_access()
 void IAttributeSlot::last_modified(const TimePoint& tp)
 {
     set_last_modified(tp);
+    // only a flag is set, the collection takes a new stamp when it's asked for
+    if(m_collection_dirty && !m_collection_dirty->load(std::memory_order_relaxed))
+        m_collection_dirty->store(true, std::memory_order_relaxed);
+}
+
+U64 IAttributeSlot::next_modification_stamp() noexcept
+{
+    static std::atomic<U64> stamp = 0;
+    return ++stamp;
 }
 }  // namespace uipc::geometry
\ No newline at end of file
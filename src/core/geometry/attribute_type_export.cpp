@@ -9,8 +9,8 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
                                                 const T&         default_value,
                                                 bool             allow_destory)
 {
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    AttributeKey key{name};
+    auto         it = m_attributes.find(key);
     if(it != m_attributes.end())
     {
         throw AttributeCollectionError{
@@ -19,7 +19,8 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
     auto A = uipc::make_shared<Attribute<T>>(default_value);
     A->resize(m_size);
     auto S = uipc::make_shared<AttributeSlot<T>>(name, A, allow_destory);
-    m_attributes[n] = S;
+    m_attributes[key] = S;
+    attach(*S);
     return S;
 }
 
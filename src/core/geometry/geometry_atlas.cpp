@@ -10,6 +10,8 @@
 #include <uipc/common/zip.h>
 #include <uipc/builtin/factory_keyword.h>
 #include <uipc/geometry/shared_attribute_context.h>
+#include <uipc/geometry/geometry_source.h>
+#include <map>
 
 namespace uipc::geometry
 {
@@ -41,33 +43,6 @@ class GeometryFriend<GeometryAtlas>
 };
 
 
-static void _build_attributes_index_from_attribute_collection(
-    unordered_map<IAttribute*, IndexT>& attr_to_index,
-    vector<IAttribute*>&                index_to_attr,
-    const AttributeCollection&          ac)
-{
-    using AF = AttributeFriend<GeometryAtlas>;
-
-    auto& attr_slots = AF::attribute_slots(ac);
-
-    for(auto&& [attr_name, attr_slot] : attr_slots)
-    {
-        auto attr = AF::attribute(attr_slot);
-        auto it   = attr_to_index.find(attr);
-        if(it == attr_to_index.end())
-        {
-            IndexT index        = static_cast<IndexT>(attr_to_index.size());
-            attr_to_index[attr] = index;
-            UIPC_ASSERT(index_to_attr.size() == index,
-                        "Index to attribute size mismatch, expected {}, got {}",
-                        index_to_attr.size(),
-                        index);
-            index_to_attr.push_back(attr);
-        }
-    }
-}
-
-
 }  // namespace uipc::geometry
 
 namespace uipc::geometry
@@ -85,6 +60,59 @@ class GeometryAtlas::Impl
     SerialSharedAttributeContext   m_serial_context;
     DeserialSharedAttributeContext m_deserial_context;
 
+    // the geometries written from geometry sources, their slots in `m_geometries` are nullptr
+    unordered_map<IndexT, Json> m_source_geometries;
+    // the attributes copied from geometry sources, their attributes in `m_serial_context` are nullptr
+    unordered_map<IndexT, std::pair<S<const IGeometrySource>, IndexT>> m_source_attributes;
+    // (archive, index in archive) -> index in the atlas
+    std::map<std::pair<const void*, IndexT>, IndexT> m_archive_attributes;
+
+    IndexT create(S<const IGeometrySource> source)
+    {
+        IndexT id = static_cast<IndexT>(m_geometries.size());
+
+        // refer to the attributes by their index in the atlas
+        Json         geo_json = source->json();
+        vector<Json*> indices;
+        auto          data_it = geo_json.find(builtin::__data__);
+        if(data_it != geo_json.end())
+        {
+            for(auto&& [name, ac_json] : data_it->items())
+            {
+                auto ac_data_it = ac_json.find(builtin::__data__);
+                if(ac_data_it == ac_json.end() || !ac_data_it->is_object())
+                    continue;
+
+                for(auto&& [attr_name, attr_json] : ac_data_it->items())
+                    indices.push_back(&attr_json["index"]);
+            }
+        }
+
+        // keep the order of the attributes in the archive
+        std::ranges::sort(indices,
+                          [](const Json* l, const Json* r)
+                          { return l->get<IndexT>() < r->get<IndexT>(); });
+        for(auto index : indices)
+            *index = source_attribute_index(source, index->get<IndexT>());
+
+        m_source_geometries[id] = std::move(geo_json);
+        m_geometries.push_back(nullptr);
+        return id;
+    }
+
+    IndexT source_attribute_index(const S<const IGeometrySource>& source, IndexT index)
+    {
+        auto [it, inserted] = m_archive_attributes.try_emplace(
+            {source->archive(), index},
+            static_cast<IndexT>(m_serial_context.m_index_to_attr.size()));
+        if(inserted)
+        {
+            m_serial_context.m_index_to_attr.push_back(nullptr);
+            m_source_attributes[it->second] = {source, index};
+        }
+        return it->second;
+    }
+
     IndexT create(const Geometry& geometry, bool evolving_only)
     {
         IndexT id = static_cast<IndexT>(m_geometries.size());
@@ -136,8 +164,9 @@ class GeometryAtlas::Impl
 
     void build_attributes_index_from_attribute_collection(const AttributeCollection& ac)
     {
-        _build_attributes_index_from_attribute_collection(
-            m_serial_context.m_attr_to_index, m_serial_context.m_index_to_attr, ac);
+        using AF = AttributeFriend<GeometryAtlas>;
+        for(auto&& [attr_name, attr_slot] : AF::attribute_slots(ac))
+            m_serial_context.insert(AF::attribute(attr_slot));
     }
 
     void build_attributes_index_from_geometry(Geometry& geo)
@@ -159,7 +188,38 @@ class GeometryAtlas::Impl
 
     Json attributes_to_json()
     {
-        return af().to_json(m_serial_context.m_index_to_attr);
+        auto& attrs = m_serial_context.m_index_to_attr;
+        if(m_source_attributes.empty())
+            return af().to_json(attrs);
+
+        Json j = Json::array();
+        for(SizeT i = 0; i < attrs.size(); ++i)
+        {
+            if(attrs[i])
+            {
+                for(auto&& elem : af().to_json(span{attrs.data() + i, 1}))
+                    j.push_back(std::move(elem));
+                continue;
+            }
+
+            auto& [source, index] = m_source_attributes.at(static_cast<IndexT>(i));
+            j.push_back(source->attribute_to_json(index));
+        }
+        return j;
+    }
+
+    void encode_attribute(SizeT i, JsonStreamEncoder& e)
+    {
+        auto attr = m_serial_context.m_index_to_attr[i];
+        if(attr)
+        {
+            af().encode(*attr, e);
+            return;
+        }
+
+        // copied from the source, without decoding if possible
+        auto& [source, index] = m_source_attributes.at(static_cast<IndexT>(i));
+        source->encode_attribute(index, e);
     }
 
     Json attribute_collection_to_json(const AttributeCollection& ac)
@@ -169,20 +229,27 @@ class GeometryAtlas::Impl
 
     Json geometries_to_json(span<S<GeometrySlot>> geos)
     {
-        vector<Geometry*> geos_ptr;
-        geos_ptr.reserve(geos.size());
-        std::transform(geos.begin(),
-                       geos.end(),
-                       std::back_inserter(geos_ptr),
-                       [](const S<GeometrySlot>& geo)
-                       { return &geo->geometry(); });
-
-        return gf().to_json(geos_ptr, m_serial_context);
+        Json j = Json::array();
+        for(SizeT i = 0; i < geos.size(); ++i)
+        {
+            if(geos[i])
+                j.push_back(gf().to_json(geos[i]->geometry(), m_serial_context));
+            else
+                j.push_back(m_source_geometries.at(static_cast<IndexT>(i)));
+        }
+        return j;
     }
 
     Json to_json()
     {
-        Json  j    = Json::object();
+        Json j = Json::object();
+        to_json(j, nullptr);
+        return j;
+    }
+
+    void to_json(Json& j, JsonStreamWriter* writer)
+    {
+        j          = Json::object();
         auto& meta = j[builtin::__meta__];
         {
 
@@ -192,7 +259,20 @@ class GeometryAtlas::Impl
         auto& data = j[builtin::__data__];
         {
             // An Array of <Attribute>
-            data["attributes"] = attributes_to_json();
+            auto& attributes = data["attributes"];
+            if(writer)
+            {
+                // encoded in parallel when the writer reaches them
+                attributes = Json::array();
+                writer->defer(attributes,
+                              m_serial_context.m_index_to_attr.size(),
+                              [this](SizeT i, JsonStreamEncoder& e)
+                              { encode_attribute(i, e); });
+            }
+            else
+            {
+                attributes = attributes_to_json();
+            }
 
             // A Map of <Name,AttributeCollection>
             auto& attribute_collections = data["attribute_collections"];
@@ -205,8 +285,6 @@ class GeometryAtlas::Impl
             auto& geometries = data["geometries"];
             geometries       = geometries_to_json(m_geometries);
         }
-
-        return j;
     }
 
     /**************************************************************
@@ -241,6 +319,36 @@ class GeometryAtlas::Impl
         return acf().from_json(j, m_deserial_context);
     }
 
+    // the attributes decoded by JsonStreamReader, indexed by their position in `attributes`
+    vector<S<IAttributeSlot>> m_captured_attributes;
+    bool                      m_capturing = false;
+
+    void capture(JsonStreamReader& reader, span<const std::string> path)
+    {
+        m_captured_attributes.clear();
+        m_capturing = true;
+
+        vector<std::string> prefix{path.begin(), path.end()};
+        prefix.push_back(std::string{builtin::__data__});
+        prefix.push_back("attributes");
+
+        reader.capture(
+            [this, prefix = std::move(prefix)](span<const std::string> p) -> S<JsonSaxConsumer>
+            {
+                if(p.size() != prefix.size() + 1 || !std::equal(prefix.begin(), prefix.end(), p.begin()))
+                    return nullptr;
+
+                SizeT index = std::stoull(p.back());
+                return af().decoder(
+                    [this, index](S<IAttributeSlot> slot)
+                    {
+                        if(m_captured_attributes.size() <= index)
+                            m_captured_attributes.resize(index + 1);
+                        m_captured_attributes[index] = std::move(slot);
+                    });
+            });
+    }
+
     vector<S<Geometry>> geometries_from_json(const Json& j)
     {
         return gf().from_json(j, m_deserial_context);
@@ -250,6 +358,9 @@ class GeometryAtlas::Impl
     {
         clear();
 
+        auto captured = std::move(m_captured_attributes);
+        bool capturing = std::exchange(m_capturing, false);
+
         // __meta__
         {
             auto it = j.find(builtin::__meta__);
@@ -288,7 +399,14 @@ class GeometryAtlas::Impl
             {
 
                 auto it_attr = data.find("attributes");
-                if(it_attr != data.end())
+                if(capturing)
+                {
+                    // already decoded by the JsonStreamReader
+                    if(it_attr != data.end() && it_attr->is_array())
+                        captured.resize(it_attr->size());
+                    m_deserial_context.m_attribute_slots = std::move(captured);
+                }
+                else if(it_attr != data.end())
                 {
                     attributes_from_json(*it_attr);
                 }
@@ -327,6 +445,9 @@ class GeometryAtlas::Impl
         m_attribute_collections.clear();
         m_serial_context.clear();
         m_deserial_context.clear();
+        m_source_geometries.clear();
+        m_source_attributes.clear();
+        m_archive_attributes.clear();
     }
 };
 
@@ -338,11 +459,26 @@ GeometryAtlas::GeometryAtlas()
 
 GeometryAtlas::~GeometryAtlas() {}
 
+void GeometryAtlas::deduplicate(bool enable) noexcept
+{
+    m_impl->m_serial_context.m_deduplicate = enable;
+}
+
+bool GeometryAtlas::deduplicate() const noexcept
+{
+    return m_impl->m_serial_context.m_deduplicate;
+}
+
 IndexT GeometryAtlas::create(const Geometry& geo, bool evolving_only)
 {
     return m_impl->create(geo, evolving_only);
 }
 
+IndexT GeometryAtlas::create(S<const IGeometrySource> source)
+{
+    return m_impl->create(std::move(source));
+}
+
 S<const GeometrySlot> GeometryAtlas::find(IndexT id) const
 {
     return m_impl->find(id);
@@ -388,6 +524,16 @@ void GeometryAtlas::from_json(const Json& j)
 {
     m_impl->from_json(j);
 }
+
+void GeometryAtlas::to_json(Json& j, JsonStreamWriter& writer) const
+{
+    m_impl->to_json(j, &writer);
+}
+
+void GeometryAtlas::capture(JsonStreamReader& reader, span<const std::string> path)
+{
+    m_impl->capture(reader, path);
+}
 }  // namespace uipc::geometry
 
 
@@ -490,8 +636,9 @@ class GeometryAtlasCommit::Impl
 
     void build_attributes_index_from_attribute_collection(const AttributeCollection& ac)
     {
-        _build_attributes_index_from_attribute_collection(
-            m_serial_context.m_attr_to_index, m_serial_context.m_index_to_attr, ac);
+        using AF = AttributeFriend<GeometryAtlas>;
+        for(auto&& [attr_name, attr_slot] : AF::attribute_slots(ac))
+            m_serial_context.insert(AF::attribute(attr_slot));
     }
 
     void build_attributes_index_from_geometry(Geometry& geo)
@@ -24,14 +24,99 @@ IndexT IGeometryCollection::next_id() const noexcept
     return get_next_id();
 }
 
-void GeometryCollection::destroy(IndexT id) noexcept
+auto GeometryCollection::entry(IndexT id) const noexcept -> const SlotEntry*
+{
+    if(id < 0 || id >= static_cast<IndexT>(m_entries.size()))
+        return nullptr;
+    return &m_entries[id];
+}
+
+void GeometryCollection::reindex(span<S<geometry::GeometrySlot>> slots,
+                                 SlotLocation                    location,
+                                 SizeT                           begin) const
+{
+    for(SizeT I = begin; I < slots.size(); ++I)
+    {
+        auto& e = m_entries[slots[I]->id()];
+        // skip the destroyed slots
+        if(e.location == location)
+            e.index = static_cast<IndexT>(I);
+    }
+}
+
+void GeometryCollection::insert(S<geometry::GeometrySlot> slot)
 {
-    m_dirty = true;
+    auto id = slot->id();
+    if(id >= static_cast<IndexT>(m_entries.size()))
+        m_entries.resize(std::max(id + 1, m_next_id));
+
+    auto by_id = [](const S<GeometrySlot>& a, const S<GeometrySlot>& b)
+    { return a->id() < b->id(); };
+
+    // ids are increasing, so a new slot almost always goes to the back
+    auto it = m_geometry_slots.end();
+    if(!m_geometry_slots.empty() && m_geometry_slots.back()->id() > id)
+        it = std::upper_bound(m_geometry_slots.begin(), m_geometry_slots.end(), slot, by_id);
+
+    SizeT index = it - m_geometry_slots.begin();
+    m_geometry_slots.insert(it, std::move(slot));
+    m_entries[id] = {SlotLocation::Normal, static_cast<IndexT>(index)};
 
-    auto it = m_geometries.find(id);
-    if(it != m_geometries.end())
+    if(index + 1 < m_geometry_slots.size())
     {
-        m_geometries.erase(it);
+        reindex(m_geometry_slots, SlotLocation::Normal, index + 1);
+        if(m_destroyed_count > 0 && m_first_destroyed >= index)
+            ++m_first_destroyed;
+    }
+}
+
+void GeometryCollection::pending_insert(S<geometry::GeometrySlot> slot)
+{
+    auto id = slot->id();
+    if(id >= static_cast<IndexT>(m_entries.size()))
+        m_entries.resize(std::max(id + 1, m_next_id));
+
+    auto by_id = [](const S<GeometrySlot>& a, const S<GeometrySlot>& b)
+    { return a->id() < b->id(); };
+
+    auto it = m_pending_create_slots.end();
+    if(!m_pending_create_slots.empty() && m_pending_create_slots.back()->id() > id)
+        it = std::upper_bound(
+            m_pending_create_slots.begin(), m_pending_create_slots.end(), slot, by_id);
+
+    SizeT index = it - m_pending_create_slots.begin();
+    m_pending_create_slots.insert(it, std::move(slot));
+    m_entries[id] = {SlotLocation::PendingCreate, static_cast<IndexT>(index)};
+
+    reindex(m_pending_create_slots, SlotLocation::PendingCreate, index + 1);
+}
+
+void GeometryCollection::mark_destroyed(IndexT id)
+{
+    auto& e = m_entries[id];
+    UIPC_ASSERT(e.location == SlotLocation::Normal,
+                "GeometrySlot ({}) is not a normal slot. Why can this happen?",
+                id);
+
+    SizeT index = e.index;
+    if(m_destroyed_count == 0 || index < m_first_destroyed)
+        m_first_destroyed = index;
+    ++m_destroyed_count;
+
+    e = {};
+}
+
+void GeometryCollection::destroy(IndexT id) noexcept
+{
+    auto e = entry(id);
+    if(e && e->location == SlotLocation::Normal)
+    {
+        auto& slot = m_geometry_slots[e->index];
+        if(slot->state() == GeometrySlotState::PendingDestroy)
+        {
+            std::erase(m_pending_destroy_ids, id);
+        }
+        mark_destroyed(id);
     }
     else
         UIPC_WARN_WITH_LOCATION("Trying to destroy a non-existing Geometry Slot ({}), ignored.",
@@ -40,19 +125,31 @@ void GeometryCollection::destroy(IndexT id) noexcept
 
 void GeometryCollection::pending_destroy(IndexT id) noexcept
 {
-    m_dirty = true;
-    if(auto it = m_geometries.find(id); it != m_geometries.end())  // if it exists
+    auto e = entry(id);
+    if(e && e->location == SlotLocation::Normal)  // if it exists
     {
-        it->second->state(GeometrySlotState::PendingDestroy);
-        m_pending_destroy.insert(id);  // mark it to be destroyed
+        auto& slot = m_geometry_slots[e->index];
+        if(slot->state() != GeometrySlotState::PendingDestroy)
+        {
+            slot->state(GeometrySlotState::PendingDestroy);
+            // mark it to be destroyed
+            if(!m_pending_destroy_ids.empty() && m_pending_destroy_ids.back() > id)
+                m_pending_destroy_sorted = false;
+            m_pending_destroy_ids.push_back(id);
+        }
     }
-    else if(m_pending_create.find(id) != m_pending_create.end())  // if it is pending to be created
+    else if(e && e->location == SlotLocation::PendingCreate)  // if it is pending to be created
     {
         UIPC_INFO_WITH_LOCATION(
             "Try to destroy a pending create Geometry Slot ({}), so we cancel the creation. "
             "This may be eliminated by optimizing your implementation.",
             id);
-        m_pending_create.erase(id);  // cancel the creation
+
+        // cancel the creation
+        SizeT index = e->index;
+        m_pending_create_slots.erase(m_pending_create_slots.begin() + index);
+        m_entries[id] = {};
+        reindex(m_pending_create_slots, SlotLocation::PendingCreate, index);
     }
     else
     {
@@ -63,37 +160,70 @@ void GeometryCollection::pending_destroy(IndexT id) noexcept
 
 void GeometryCollection::solve_pending() noexcept
 {
-    m_dirty = true;
+    if(m_pending_create_slots.empty() && m_pending_destroy_ids.empty())
+        return;
 
     // put the pending create into the geometries
-    for(auto& [id, geo] : m_pending_create)
+    if(!m_pending_create_slots.empty())
     {
-        UIPC_ASSERT(m_geometries.find(id) == m_geometries.end(),
-                    "GeometrySlot ({}) already exists. Why can this happen?",
-                    id);
+        for(auto& geo : m_pending_create_slots)
+        {
+            UIPC_ASSERT(m_entries[geo->id()].location == SlotLocation::PendingCreate,
+                        "GeometrySlot ({}) already exists. Why can this happen?",
+                        geo->id());
 
-        UIPC_ASSERT(geo->state() == GeometrySlotState::PendingCreate,
-                    "GeometrySlot ({}) is not in PendingCreate state. Why can this happen?",
-                    id);
+            UIPC_ASSERT(geo->state() == GeometrySlotState::PendingCreate,
+                        "GeometrySlot ({}) is not in PendingCreate state. Why can this happen?",
+                        geo->id());
+
+            geo->state(GeometrySlotState::Normal);
+        }
+
+        auto  by_id = [](const S<GeometrySlot>& a, const S<GeometrySlot>& b)
+        { return a->id() < b->id(); };
+        SizeT old_size = m_geometry_slots.size();
+
+        m_geometry_slots.insert(m_geometry_slots.end(),
+                                m_pending_create_slots.begin(),
+                                m_pending_create_slots.end());
 
-        geo->state(GeometrySlotState::Normal);
-        m_geometries.emplace(id, geo);
+        for(auto& geo : m_pending_create_slots)
+            m_entries[geo->id()].location = SlotLocation::Normal;
+
+        // the pending slots are usually newer than all the existing ones, then appending keeps the order
+        SizeT begin = old_size;
+        if(old_size > 0 && m_geometry_slots[old_size - 1]->id() > m_pending_create_slots.front()->id())
+        {
+            auto mid   = m_geometry_slots.begin() + old_size;
+            auto first = std::upper_bound(
+                m_geometry_slots.begin(), mid, m_pending_create_slots.front(), by_id);
+            std::inplace_merge(first, mid, m_geometry_slots.end(), by_id);
+
+            begin = first - m_geometry_slots.begin();
+            if(m_destroyed_count > 0)
+                m_first_destroyed = std::min(m_first_destroyed, begin);
+        }
+        reindex(m_geometry_slots, SlotLocation::Normal, begin);
+
+        m_pending_create_slots.clear();
     }
-    m_pending_create.clear();
 
-    for(auto id : m_pending_destroy)
+    for(auto id : m_pending_destroy_ids)
     {
-        auto it = m_geometries.find(id);
-        UIPC_ASSERT(it != m_geometries.end(),
+        UIPC_ASSERT(m_entries[id].location == SlotLocation::Normal,
                     "GeometrySlot ({}) does not exist. Why can this happen?",
                     id);
 
-        UIPC_ASSERT(it->second->state() == GeometrySlotState::PendingDestroy,
+        UIPC_ASSERT(m_geometry_slots[m_entries[id].index]->state() == GeometrySlotState::PendingDestroy,
                     "GeometrySlot ({}) is not in PendingDestroy state. Why can this happen?",
                     id);
-        m_geometries.erase(it);
+
+        mark_destroyed(id);
     }
-    m_pending_destroy.clear();
+    m_pending_destroy_ids.clear();
+    m_pending_destroy_sorted = true;
+
+    flush();
 }
 
 span<S<geometry::GeometrySlot>> GeometryCollection::geometry_slots() const noexcept
@@ -104,108 +234,120 @@ span<S<geometry::GeometrySlot>> GeometryCollection::geometry_slots() const noexc
 
 span<S<geometry::GeometrySlot>> GeometryCollection::pending_create_slots() const noexcept
 {
-    flush();
     return m_pending_create_slots;
 }
 
 span<IndexT> GeometryCollection::pending_destroy_ids() const noexcept
 {
-    flush();
+    if(!m_pending_destroy_sorted)
+    {
+        std::ranges::sort(m_pending_destroy_ids);
+        m_pending_destroy_sorted = true;
+    }
     return m_pending_destroy_ids;
 }
 
 void GeometryCollection::do_reserve(SizeT size) noexcept
 {
-    m_geometries.reserve(size);
+    m_geometry_slots.reserve(size);
+    m_entries.reserve(m_next_id + size);
 }
 
 void GeometryCollection::do_clear() noexcept
 {
-    m_geometries.clear();
+    for(auto& slot : m_geometry_slots)
+    {
+        auto& e = m_entries[slot->id()];
+        if(e.location == SlotLocation::Normal)
+            e = {};
+    }
+    m_geometry_slots.clear();
+    m_destroyed_count = 0;
+    m_first_destroyed = 0;
+
+    // the pending destroy ids refer to the cleared slots
+    m_pending_destroy_ids.clear();
+    m_pending_destroy_sorted = true;
 }
 
 SizeT GeometryCollection::get_size() const noexcept
 {
-    return m_geometries.size();
+    return m_geometry_slots.size() - m_destroyed_count;
 }
+
 IndexT GeometryCollection::get_next_id() const noexcept
 {
     return m_next_id;
 }
+
 void GeometryCollection::flush() const
 {
-    if(m_dirty)
-    {
-        m_geometry_slots.resize(m_geometries.size());
-        m_pending_create_slots.resize(m_pending_create.size());
-        m_pending_destroy_ids.resize(m_pending_destroy.size());
-
-        for(auto&& [I, geo] : enumerate(m_geometries))
-        {
-            m_geometry_slots[I] = geo.second;
-        }
-
-        std::sort(m_geometry_slots.begin(),
-                  m_geometry_slots.end(),
-                  [](const S<geometry::GeometrySlot>& a, const S<geometry::GeometrySlot>& b)
-                  { return a->id() < b->id(); });
+    if(m_destroyed_count == 0)
+        return;
 
-        for(auto&& [I, geo] : enumerate(m_pending_create))
-        {
-            m_pending_create_slots[I] = geo.second;
-        }
-
-        std::sort(m_pending_create_slots.begin(),
-                  m_pending_create_slots.end(),
-                  [](const S<geometry::GeometrySlot>& a, const S<geometry::GeometrySlot>& b)
-                  { return a->id() < b->id(); });
-
-        std::ranges::copy(m_pending_destroy, m_pending_destroy_ids.begin());
-
-        m_dirty = false;
+    // compact the destroyed slots out, only the slots after the first destroyed one move
+    SizeT write = m_first_destroyed;
+    for(SizeT read = m_first_destroyed; read < m_geometry_slots.size(); ++read)
+    {
+        auto& slot = m_geometry_slots[read];
+        auto& e    = m_entries[slot->id()];
+        if(e.location != SlotLocation::Normal)
+            continue;
+
+        e.index = static_cast<IndexT>(write);
+        if(write != read)
+            m_geometry_slots[write] = std::move(slot);
+        ++write;
     }
+    m_geometry_slots.resize(write);
+
+    m_destroyed_count = 0;
+    m_first_destroyed = 0;
 }
 
 void GeometryCollection::build_from(span<S<geometry::GeometrySlot>> slots) noexcept
 {
-    m_dirty   = true;
     m_next_id = 0;
 
-    m_geometries.clear();
-    m_pending_create.clear();
-    m_pending_destroy.clear();
-
-    {
-        m_geometry_slots.clear();
-        m_pending_create_slots.clear();
-        m_pending_destroy_ids.clear();
-    }
+    m_entries.clear();
+    m_geometry_slots.clear();
+    m_destroyed_count = 0;
+    m_first_destroyed = 0;
+    m_pending_create_slots.clear();
+    m_pending_destroy_ids.clear();
+    m_pending_destroy_sorted = true;
 
-    m_geometries.reserve(slots.size());
+    m_geometry_slots.reserve(slots.size());
 
     for(auto&& slot : slots)
     {
         auto my_slot = slot->clone();
-        m_geometries.insert({my_slot->id(), my_slot});
+        my_slot->state(GeometrySlotState::Normal);
         m_next_id = std::max(m_next_id, my_slot->id() + 1);
+        m_geometry_slots.push_back(std::move(my_slot));
     }
 
-    for(auto&& [id, slots] : m_geometries)
-    {
-        slots->state(GeometrySlotState::Normal);
-    }
+    std::ranges::sort(m_geometry_slots,
+                      [](const S<GeometrySlot>& a, const S<GeometrySlot>& b)
+                      { return a->id() < b->id(); });
+
+    m_entries.resize(m_next_id);
+    for(auto&& [I, slot] : enumerate(m_geometry_slots))
+        m_entries[slot->id()] = {SlotLocation::Normal, static_cast<IndexT>(I)};
 }
 
-void GeometryCollection::update_from(const unordered_map<IndexT, S<GeometryCommit>>& commits) noexcept
+void GeometryCollection::update_from(const unordered_map<IndexT, S<GeometryCommit>>& commits,
+                                     span<const IndexT> removed_ids)
 {
-    m_dirty = true;
+    for(auto id : removed_ids)
+        destroy(id);
 
     for(auto&& [id, commit] : commits)
     {
-        auto it = m_geometries.find(id);
-        if(it != m_geometries.end())
+        auto e = entry(id);
+        if(e && e->location == SlotLocation::Normal)
         {
-            auto& slot = it->second;
+            auto& slot = m_geometry_slots[e->index];
             slot->geometry().update_from(*commit);
         }
         else
@@ -220,56 +362,59 @@ GeometryCollection::GeometryCollection(const GeometryCollection& other)
     GeometryFactory gf;
 
     auto create_geo_slot = [&](S<GeometrySlot> src) -> S<GeometrySlot>
-    { return gf.create_slot(src->id(), src->geometry()); };
-
-    for(auto&& [name, slot] : other.m_geometries)
     {
-        auto my_slot = create_geo_slot(slot);
-        m_geometries.insert({my_slot->id(), my_slot});
-    }
+        auto slot = gf.create_slot(src->id(), src->geometry());
+        slot->state(src->state());
+        return slot;
+    };
 
-    for(auto&& [name, slot] : other.m_pending_create)
-    {
-        auto my_slot = create_geo_slot(slot);
-        m_pending_create.insert({my_slot->id(), my_slot});
-    }
+    other.flush();
 
-    m_pending_destroy = other.m_pending_destroy;
+    // the same order as `other`, so the entries are the same
+    m_entries = other.m_entries;
 
-    m_next_id = other.m_next_id;
+    m_geometry_slots.reserve(other.m_geometry_slots.size());
+    for(auto&& slot : other.m_geometry_slots)
+        m_geometry_slots.push_back(create_geo_slot(slot));
+
+    m_pending_create_slots.reserve(other.m_pending_create_slots.size());
+    for(auto&& slot : other.m_pending_create_slots)
+        m_pending_create_slots.push_back(create_geo_slot(slot));
+
+    m_pending_destroy_ids    = other.m_pending_destroy_ids;
+    m_pending_destroy_sorted = other.m_pending_destroy_sorted;
 
-    m_dirty = true;
+    m_next_id = other.m_next_id;
 }
 
 S<geometry::GeometrySlot> GeometryCollection::emplace(const geometry::Geometry& geometry)
 {
     GeometryFactory gf;
-    auto            geo_slot = gf.create_slot(m_next_id, geometry);
-    m_geometries.insert({m_next_id, geo_slot});
+    auto            geo_slot = gf.create_slot(m_next_id++, geometry);
     geo_slot->state(geometry::GeometrySlotState::Normal);
-    m_next_id++;
-    m_dirty = true;
+    insert(geo_slot);
     return geo_slot;
 }
 
 S<geometry::GeometrySlot> GeometryCollection::find(IndexT id) noexcept
 {
-    if(auto it = m_pending_destroy.find(id); it != m_pending_destroy.end())
-    {
+    auto e = entry(id);
+    if(!e)
         return {};
-    }
 
-    if(auto it = m_geometries.find(id); it != m_geometries.end())
+    switch(e->location)
     {
-        return it->second;
-    }
-
-    if(auto it = m_pending_create.find(id); it != m_pending_create.end())
-    {
-        return it->second;
+        case SlotLocation::Normal: {
+            auto& slot = m_geometry_slots[e->index];
+            if(slot->state() == GeometrySlotState::PendingDestroy)
+                return {};
+            return slot;
+        }
+        case SlotLocation::PendingCreate:
+            return m_pending_create_slots[e->index];
+        default:
+            return {};
     }
-
-    return {};
 }
 
 S<const geometry::GeometrySlot> GeometryCollection::find(IndexT id) const noexcept
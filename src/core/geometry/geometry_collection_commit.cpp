@@ -16,27 +16,29 @@ GeometryCollectionCommit::GeometryCollectionCommit(const GeometryCollectionCommi
 GeometryCollectionCommit::GeometryCollectionCommit(const GeometryCollection& dst,
                                                    const GeometryCollection& src)
 {
-    UIPC_ASSERT(dst.m_pending_create.size() == 0,
+    UIPC_ASSERT(dst.m_pending_create_slots.size() == 0,
                 "GeometryCollectionCommit: The pending create size is not 0 (size={}), this is not expected.",
-                dst.m_pending_create.size());
+                dst.m_pending_create_slots.size());
 
-    UIPC_ASSERT(dst.m_pending_destroy.size() == 0,
+    UIPC_ASSERT(dst.m_pending_destroy_ids.size() == 0,
                 "GeometryCollectionCommit: The pending destroy size is not 0 (size={}), this is not expected.",
-                dst.m_pending_destroy.size());
+                dst.m_pending_destroy_ids.size());
 
-    UIPC_ASSERT(src.m_pending_create.size() == 0,
+    UIPC_ASSERT(src.m_pending_create_slots.size() == 0,
                 "GeometryCollectionCommit: The pending create size is not 0 (size={}), this is not expected.",
-                src.m_pending_create.size());
+                src.m_pending_create_slots.size());
 
-    UIPC_ASSERT(src.m_pending_destroy.size() == 0,
+    UIPC_ASSERT(src.m_pending_destroy_ids.size() == 0,
                 "GeometryCollectionCommit: The pending destroy size is not 0 (size={}), this is not expected.",
-                src.m_pending_destroy.size());
+                src.m_pending_destroy_ids.size());
 
 
     m_next_id = dst.next_id();
-    m_geometries.reserve(dst.m_geometries.size());
-    for(auto&& [id, dst_geo_slot] : dst.m_geometries)
+    auto dst_slots = dst.geometry_slots();
+    m_geometries.reserve(dst_slots.size());
+    for(auto&& dst_geo_slot : dst_slots)
     {
+        auto id           = dst_geo_slot->id();
         auto src_geo_slot = src.find(id);
         if(src_geo_slot)
         {
@@ -1,7 +1,31 @@
 #include <uipc/geometry/geometry_slot.h>
+#include <uipc/geometry/geometry_source.h>
+#include <uipc/core/scene_factory.h>
+#include <uipc/common/log.h>
 
 namespace uipc::geometry
 {
+template <>
+class GeometryFriend<GeometrySlot>
+{
+  public:
+    // fill `dst` in place, the shortcuts of `dst` to its attribute collections are kept
+    static void assign(Geometry& dst, const Geometry& src)
+    {
+        vector<std::string>                names;
+        vector<const AttributeCollection*> collections;
+        src.collect_attribute_collections(names, collections);
+
+        for(SizeT i = 0; i < names.size(); ++i)
+        {
+            auto ac = dst.find(names[i]);
+            if(!ac)
+                ac = dst.create(names[i]);
+            *ac = *collections[i];
+        }
+    }
+};
+
 GeometrySlot::GeometrySlot(IndexT id) noexcept
     : m_id{id}
 {
@@ -12,13 +36,15 @@ IndexT GeometrySlot::id() const noexcept
     return m_id;
 }
 
-Geometry& GeometrySlot::geometry() noexcept
+Geometry& GeometrySlot::geometry()
 {
+    load();
     return get_geometry();
 }
 
-const Geometry& GeometrySlot::geometry() const noexcept
+const Geometry& GeometrySlot::geometry() const
 {
+    load();
     return get_geometry();
 }
 
@@ -29,7 +55,63 @@ GeometrySlotState GeometrySlot::state() const noexcept
 
 S<GeometrySlot> GeometrySlot::clone() const
 {
-    return do_clone();
+    std::lock_guard lock{m_load_mutex};
+    auto            slot = do_clone();
+    // an unloaded slot clones to an unloaded slot
+    if(!m_loaded)
+        slot->source(m_source);
+    return slot;
+}
+
+bool GeometrySlot::is_loaded() const noexcept
+{
+    return m_loaded.load(std::memory_order_acquire);
+}
+
+void GeometrySlot::load() const
+{
+    if(m_loaded.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard lock{m_load_mutex};
+    if(m_loaded.load(std::memory_order_relaxed))
+        return;
+
+    // on failure the source is kept, so every access throws instead of seeing an empty geometry
+    S<Geometry> geometry;
+    try
+    {
+        geometry = m_source->load();
+    }
+    catch(const core::SceneIOError&)
+    {
+        throw;
+    }
+    catch(const std::exception& e)
+    {
+        throw core::SceneIOError{
+            fmt::format("Failed to load the geometry of slot {}: {}", m_id, e.what())};
+    }
+
+    if(!geometry)
+        throw core::SceneIOError{fmt::format("Failed to load the geometry of slot {}.", m_id)};
+
+    GeometryFriend<GeometrySlot>::assign(const_cast<GeometrySlot*>(this)->get_geometry(), *geometry);
+
+    m_source.reset();
+    m_loaded.store(true, std::memory_order_release);
+}
+
+void GeometrySlot::source(S<const IGeometrySource> source) noexcept
+{
+    m_source = std::move(source);
+    m_loaded.store(m_source == nullptr, std::memory_order_release);
+}
+
+S<const IGeometrySource> GeometrySlot::source() const noexcept
+{
+    std::lock_guard lock{m_load_mutex};
+    return m_loaded ? nullptr : m_source;
 }
 
 void GeometrySlot::id(IndexT id) noexcept
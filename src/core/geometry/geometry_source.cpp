@@ -0,0 +1,29 @@
+#include <uipc/geometry/geometry_source.h>
+
+namespace uipc::geometry
+{
+S<Geometry> IGeometrySource::load() const
+{
+    return do_load();
+}
+
+const Json& IGeometrySource::json() const
+{
+    return get_json();
+}
+
+const void* IGeometrySource::archive() const noexcept
+{
+    return get_archive();
+}
+
+void IGeometrySource::encode_attribute(IndexT index, JsonStreamEncoder& encoder) const
+{
+    do_encode_attribute(index, encoder);
+}
+
+Json IGeometrySource::attribute_to_json(IndexT index) const
+{
+    return do_attribute_to_json(index);
+}
+}  // namespace uipc::geometry
@@ -8,13 +8,15 @@ GeometrySlotT<ImplicitGeometry>::GeometrySlotT(IndexT id, const ImplicitGeometry
 {
 }
 
-ImplicitGeometry& GeometrySlotT<ImplicitGeometry>::geometry() noexcept
+ImplicitGeometry& GeometrySlotT<ImplicitGeometry>::geometry()
 {
+    load();
     return m_geometry;
 }
 
-const ImplicitGeometry& GeometrySlotT<ImplicitGeometry>::geometry() const noexcept
+const ImplicitGeometry& GeometrySlotT<ImplicitGeometry>::geometry() const
 {
+    load();
     return m_geometry;
 }
 
@@ -1,4 +1,5 @@
 #include <uipc/geometry/shared_attribute_context.h>
+#include <algorithm>
 
 namespace uipc::geometry
 {
@@ -17,10 +18,37 @@ IAttribute* SerialSharedAttributeContext::attribute_of(IndexT index) const
     return m_index_to_attr[index];
 }
 
+void SerialSharedAttributeContext::insert(IAttribute* attr)
+{
+    if(m_attr_to_index.find(attr) != m_attr_to_index.end())
+        return;
+
+    IndexT index = static_cast<IndexT>(m_index_to_attr.size());
+
+    if(m_deduplicate)
+    {
+        // reuse the index of an attribute with the same content
+        auto& candidates = m_content_to_indices[attr->content_hash()];
+        auto  same       = std::ranges::find_if(candidates,
+                                         [&](IndexT i)
+                                         { return m_index_to_attr[i]->content_equal(*attr); });
+        if(same != candidates.end())
+        {
+            m_attr_to_index[attr] = *same;
+            return;
+        }
+        candidates.push_back(index);
+    }
+
+    m_attr_to_index[attr] = index;
+    m_index_to_attr.push_back(attr);
+}
+
 void SerialSharedAttributeContext::clear()
 {
     m_attr_to_index.clear();
     m_index_to_attr.clear();
+    m_content_to_indices.clear();
 }
 
 S<IAttributeSlot> DeserialSharedAttributeContext::attribute_slot_of(IndexT index) const
@@ -8,13 +8,15 @@ GeometrySlotT<SimplicialComplex>::GeometrySlotT(IndexT id, const SimplicialCompl
 {
 }
 
-SimplicialComplex& GeometrySlotT<SimplicialComplex>::geometry() noexcept
+SimplicialComplex& GeometrySlotT<SimplicialComplex>::geometry()
 {
+    load();
     return m_simplicial_complex;
 }
 
-const SimplicialComplex& GeometrySlotT<SimplicialComplex>::geometry() const noexcept
+const SimplicialComplex& GeometrySlotT<SimplicialComplex>::geometry() const
 {
+    load();
     return m_simplicial_complex;
 }
 
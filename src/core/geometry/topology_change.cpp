@@ -0,0 +1,293 @@
+#include <uipc/geometry/topology_change.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/log.h>
+#include <uipc/builtin/attribute_name.h>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace uipc::geometry
+{
+SimplexChange<0>& TopologyChange::vertices() noexcept
+{
+    return m_vertices;
+}
+
+const SimplexChange<0>& TopologyChange::vertices() const noexcept
+{
+    return m_vertices;
+}
+
+SimplexChange<1>& TopologyChange::edges() noexcept
+{
+    return m_edges;
+}
+
+const SimplexChange<1>& TopologyChange::edges() const noexcept
+{
+    return m_edges;
+}
+
+SimplexChange<2>& TopologyChange::triangles() noexcept
+{
+    return m_triangles;
+}
+
+const SimplexChange<2>& TopologyChange::triangles() const noexcept
+{
+    return m_triangles;
+}
+
+SimplexChange<3>& TopologyChange::tetrahedra() noexcept
+{
+    return m_tetrahedra;
+}
+
+const SimplexChange<3>& TopologyChange::tetrahedra() const noexcept
+{
+    return m_tetrahedra;
+}
+
+bool TopologyChange::empty() const noexcept
+{
+    return m_vertices.empty() && m_edges.empty() && m_triangles.empty()
+           && m_tetrahedra.empty();
+}
+
+void TopologyChange::clear() noexcept
+{
+    m_vertices.clear();
+    m_edges.clear();
+    m_triangles.clear();
+    m_tetrahedra.clear();
+}
+
+vector<IndexT> TopologyChange::vertex_remap(SizeT vertex_count) const
+{
+    vector<IndexT> remap(vertex_count, 0);
+    for(auto v : m_vertices.removed())
+    {
+        if(v < 0 || v >= static_cast<IndexT>(vertex_count))
+            throw TopologyChangeError{fmt::format(
+                "Removed vertex {} is out of range [0, {}).", v, vertex_count)};
+        remap[v] = -1;
+    }
+
+    IndexT next = 0;
+    for(auto& r : remap)
+        r = r < 0 ? -1 : next++;
+    return remap;
+}
+
+namespace detail
+{
+    template <IndexT N, typename SimplicialComplexT>
+    decltype(auto) simplices(SimplicialComplexT& sc)
+    {
+        if constexpr(N == 0)
+            return sc.vertices();
+        else if constexpr(N == 1)
+            return sc.edges();
+        else if constexpr(N == 2)
+            return sc.triangles();
+        else
+            return sc.tetrahedra();
+    }
+
+    template <IndexT N>
+    const SimplexChange<N>& simplex_change(const TopologyChange& change)
+    {
+        if constexpr(N == 0)
+            return change.vertices();
+        else if constexpr(N == 1)
+            return change.edges();
+        else if constexpr(N == 2)
+            return change.triangles();
+        else
+            return change.tetrahedra();
+    }
+
+    constexpr std::string_view simplex_name(IndexT N)
+    {
+        constexpr std::string_view names[] = {"vertex", "edge", "triangle", "tetrahedron"};
+        return names[N];
+    }
+
+    // the New2Old mapping of one dimension, the default values are at `old_size`
+    struct Plan
+    {
+        vector<SizeT> new_to_old;
+        SizeT         old_size     = 0;
+        SizeT         kept_count   = 0;
+        bool          need_default = false;
+    };
+
+    // validate the change and build the New2Old mapping, nothing is modified
+    template <IndexT N>
+    Plan plan(const SimplicialComplex& sc,
+              const SimplexChange<N>&  change,
+              span<const IndexT>       vertex_remap,
+              bool                     vertices_removed,
+              IndexT                   new_vertex_count)
+    {
+        auto current = simplices<N>(sc);
+
+        Plan p;
+        p.old_size = current.size();
+
+        vector<char> removed(p.old_size, 0);
+        for(auto i : change.removed())
+        {
+            if(i < 0 || i >= static_cast<IndexT>(p.old_size))
+                throw TopologyChangeError{fmt::format("Removed {} {} is out of range [0, {}).",
+                                                      simplex_name(N),
+                                                      i,
+                                                      p.old_size)};
+            if(removed[i])
+                throw TopologyChangeError{
+                    fmt::format("The {} {} is removed twice.", simplex_name(N), i)};
+            removed[i] = 1;
+        }
+
+        p.kept_count = p.old_size - change.removed().size();
+        p.new_to_old.reserve(p.kept_count + change.parents().size());
+        for(SizeT i = 0; i < p.old_size; ++i)
+        {
+            if(!removed[i])
+                p.new_to_old.push_back(i);
+        }
+
+        for(auto parent : change.parents())
+        {
+            if(parent < -1 || parent >= static_cast<IndexT>(p.old_size))
+                throw TopologyChangeError{
+                    fmt::format("The parent {} of an inserted {} is out of range [-1, {}).",
+                                parent,
+                                simplex_name(N),
+                                p.old_size)};
+
+            p.need_default |= parent < 0;
+            p.new_to_old.push_back(parent < 0 ? p.old_size : static_cast<SizeT>(parent));
+        }
+
+        if constexpr(N > 0)
+        {
+            // the kept simplices must not refer to the removed vertices
+            if(vertices_removed && p.kept_count > 0)
+            {
+                auto topo = current.topo().view();
+                for(SizeT i = 0; i < p.kept_count; ++i)
+                {
+                    auto& t = topo[p.new_to_old[i]];
+                    for(IndexT k = 0; k < N + 1; ++k)
+                    {
+                        if(vertex_remap[t[k]] < 0)
+                            throw TopologyChangeError{
+                                fmt::format("The kept {} {} refers to the removed vertex {}.",
+                                            simplex_name(N),
+                                            p.new_to_old[i],
+                                            t[k])};
+                    }
+                }
+            }
+
+            for(auto&& [I, t] : enumerate(change.topo()))
+            {
+                for(IndexT k = 0; k < N + 1; ++k)
+                {
+                    if(t[k] < 0 || t[k] >= new_vertex_count)
+                        throw TopologyChangeError{fmt::format(
+                            "The inserted {} {} refers to vertex {}, out of range [0, {}).",
+                            simplex_name(N),
+                            I,
+                            t[k],
+                            new_vertex_count)};
+                }
+            }
+        }
+
+        return p;
+    }
+
+    template <IndexT N>
+    void apply(SimplicialComplex&      sc,
+               const SimplexChange<N>& change,
+               const Plan&             p,
+               span<const IndexT>      vertex_remap,
+               bool                    vertices_removed)
+    {
+        bool remap_topo = N > 0 && vertices_removed && p.kept_count > 0;
+        if(change.empty() && !remap_topo)
+            return;
+
+        auto current  = simplices<N>(sc);
+        auto new_size = p.new_to_old.size();
+
+        if(!change.empty())
+        {
+            // 1) make room for the inserted simplices and the default values
+            current.resize(std::max(p.old_size + (p.need_default ? 1 : 0), new_size));
+            // 2) move the kept simplices to the front and copy the parents to the back
+            current.reorder(p.new_to_old);
+            // 3) drop the tail
+            current.resize(new_size);
+        }
+
+        if constexpr(N > 0)
+        {
+            using TopoValueT = typename SimplexChange<N>::TopoValueT;
+
+            auto topo_slot = current.template find<TopoValueT>(builtin::topo);
+            if(!topo_slot)
+            {
+                if(new_size == 0)
+                    return;
+                topo_slot = current.template create<TopoValueT>(
+                    builtin::topo, TopoValueT::Zero(), false);
+            }
+
+            auto topo = view(*topo_slot);
+
+            if(remap_topo)
+            {
+                for(SizeT i = 0; i < p.kept_count; ++i)
+                {
+                    auto& t = topo[i];
+                    for(IndexT k = 0; k < N + 1; ++k)
+                        t[k] = vertex_remap[t[k]];
+                }
+            }
+
+            std::ranges::copy(change.topo(), topo.begin() + p.kept_count);
+        }
+    }
+}  // namespace detail
+
+void apply_topology_change(SimplicialComplex& sc, const TopologyChange& change)
+{
+    if(change.empty())
+        return;
+
+    auto vertex_count     = sc.vertices().size();
+    auto vertex_remap     = change.vertex_remap(vertex_count);
+    bool vertices_removed = !change.vertices().removed().empty();
+    auto new_vertex_count = static_cast<IndexT>(vertex_count - change.vertices().removed().size()
+                                                + change.vertices().parents().size());
+
+    // 1) validate all the dimensions before modifying anything
+    std::array<detail::Plan, 4> plans;
+    [&]<IndexT... N>(std::integer_sequence<IndexT, N...>)
+    {
+        ((plans[N] = detail::plan<N>(
+              sc, detail::simplex_change<N>(change), vertex_remap, vertices_removed, new_vertex_count)),
+         ...);
+    }(std::make_integer_sequence<IndexT, 4>{});
+
+    // 2) apply
+    [&]<IndexT... N>(std::integer_sequence<IndexT, N...>)
+    {
+        (detail::apply<N>(sc, detail::simplex_change<N>(change), plans[N], vertex_remap, vertices_removed),
+         ...);
+    }(std::make_integer_sequence<IndexT, 4>{});
+}
+}  // namespace uipc::geometry
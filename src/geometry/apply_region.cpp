@@ -3,31 +3,37 @@
 #include <uipc/common/map.h>
 namespace uipc::geometry
 {
-static void calculate_mapping(SizeT                  N_region,
+// the local index of each primitive in its region, and the primitives of each region,
+// the primitive counts of the regions are given by label_region()
+static void calculate_mapping(span<const IndexT>     region_counts,
                               span<const IndexT>     region,
                               vector<SizeT>&         G2L,
                               vector<vector<SizeT>>& L2G)
 {
-    vector<SizeT> region_prim_count(N_region, 0);
     G2L.resize(region.size(), -1);
-    L2G.resize(N_region);
+    L2G.resize(region_counts.size());
 
-    for(auto&& [i, r] : enumerate(region))
+    for(auto&& [r, local_to_global] : enumerate(L2G))
     {
-        auto& local_prim = region_prim_count[r];
-        G2L[i]           = local_prim++;
+        local_to_global.reserve(region_counts[r]);
     }
 
-    for(auto&& [i, local_prim] : enumerate(region_prim_count))
+    for(auto&& [i, r] : enumerate(region))
     {
-        L2G[i].resize(local_prim);
+        G2L[i] = L2G[r].size();
+        L2G[r].push_back(i);
     }
+}
 
-    for(auto&& [i, local_prim] : enumerate(G2L))
-    {
-        auto r             = region[i];
-        L2G[r][local_prim] = i;
-    }
+static span<const IndexT> region_counts(const SimplicialComplex& sc, std::string_view name)
+{
+    auto counts = sc.meta().find<VectorXi>(name);
+    UIPC_ASSERT(counts,
+                "The `{}` attribute is not found in the meta. "
+                "You need to call label_region() to label the region of the geometry",
+                name);
+    const VectorXi& C = counts->view()[0];
+    return span<const IndexT>{C.data(), static_cast<SizeT>(C.size())};
 }
 
 vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
@@ -57,7 +63,10 @@ vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
     vector<vector<SizeT>> local_vert_to_global_vert;
     auto                  vert_region = sc.vertices().find<IndexT>("region");
     auto                  vert_region_view = vert_region->view();
-    calculate_mapping(N_region, vert_region_view, global_vert_to_local_vert, local_vert_to_global_vert);
+    calculate_mapping(region_counts(sc, "region_vertex_count"),
+                      vert_region_view,
+                      global_vert_to_local_vert,
+                      local_vert_to_global_vert);
 
 
     auto GV2LV = [&global_vert_to_local_vert]<int N>(const Eigen::Vector<IndexT, N>& GV)  // Map the global vertex to local vertex
@@ -72,7 +81,12 @@ vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
 
     // 2) copy the meta
     {
-        vector<std::string> excluding_attributes{"region_count"};  // exclude the region_count attribute
+        // exclude the region_count and the primitive counts of the regions
+        vector<std::string> excluding_attributes{"region_count",
+                                                 "region_vertex_count",
+                                                 "region_edge_count",
+                                                 "region_triangle_count",
+                                                 "region_tetrahedron_count"};
 
         for(auto&& [region_I, R] : enumerate(Rs))
         {
@@ -114,7 +128,10 @@ vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
 
         auto edge_region      = sc.edges().find<IndexT>("region");
         auto edge_region_view = edge_region->view();
-        calculate_mapping(N_region, edge_region_view, global_edge_to_local_edge, local_edge_to_global_edge);
+        calculate_mapping(region_counts(sc, "region_edge_count"),
+                          edge_region_view,
+                          global_edge_to_local_edge,
+                          local_edge_to_global_edge);
 
 
         // exclude:
@@ -162,7 +179,10 @@ vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
 
         auto tri_region      = sc.triangles().find<IndexT>("region");
         auto tri_region_view = tri_region->view();
-        calculate_mapping(N_region, tri_region_view, global_tri_to_local_tri, local_tri_to_global_tri);
+        calculate_mapping(region_counts(sc, "region_triangle_count"),
+                          tri_region_view,
+                          global_tri_to_local_tri,
+                          local_tri_to_global_tri);
 
         // exclude:
         // - topo, we need to fill it by ourselves
@@ -209,7 +229,10 @@ vector<SimplicialComplex> apply_region(const SimplicialComplex& sc)
 
         auto tet_region      = sc.tetrahedra().find<IndexT>("region");
         auto tet_region_view = tet_region->view();
-        calculate_mapping(N_region, tet_region_view, global_tet_to_local_tet, local_tet_to_global_tet);
+        calculate_mapping(region_counts(sc, "region_tetrahedron_count"),
+                          tet_region_view,
+                          global_tet_to_local_tet,
+                          local_tet_to_global_tet);
 
         // exclude:
         // - topo, we need to fill it by ourselves
@@ -1,6 +1,7 @@
 #include <uipc/geometry/utils/compute_vertex_volume.h>
 #include <uipc/common/enumerate.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/common/parallel_for.h>
 #include <Eigen/Dense>
 #include <numbers>
 
@@ -14,24 +15,25 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tet(SimplicialComplex&
     auto Vs = R.positions().view();
     auto Ts = R.tetrahedra().topo().view();
 
-    std::ranges::transform(Ts,
-                           tet_volume.begin(),
-                           [&](const Vector4i& t) -> Float
-                           {
-                               auto [p0, p1, p2, p3] =
-                                   std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]], Vs[t[3]]};
-
-                               Matrix<Float, 3, 3> A;
-                               A.col(0) = p1 - p0;
-                               A.col(1) = p2 - p0;
-                               A.col(2) = p3 - p0;
-                               auto D   = A.determinant();
-                               UIPC_ASSERT(D > 0.0,
-                                           "The determinant of the tetrahedron is non-positive ({}), which means the tetrahedron is inverted.",
-                                           D);
-                               auto volume = D / 6.0;
-                               return volume;
-                           });
+    // the element volumes in parallel, the scatter to the vertices stays serial to keep the summation order
+    parallel_for(0,
+                 Ts.size(),
+                 [&](SizeT i)
+                 {
+                     const Vector4i& t = Ts[i];
+                     auto [p0, p1, p2, p3] =
+                         std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]], Vs[t[3]]};
+
+                     Matrix<Float, 3, 3> A;
+                     A.col(0) = p1 - p0;
+                     A.col(1) = p2 - p0;
+                     A.col(2) = p3 - p0;
+                     auto D   = A.determinant();
+                     UIPC_ASSERT(D > 0.0,
+                                 "The determinant of the tetrahedron is non-positive ({}), which means the tetrahedron is inverted.",
+                                 D);
+                     tet_volume[i] = D / 6.0;
+                 });
 
     auto volume = R.vertices().find<Float>(builtin::volume);
 
@@ -63,11 +65,12 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tri(SimplicialComplex&
     auto Vs = R.positions().view();
     auto Ts = R.triangles().topo().view();
 
-    std::ranges::transform(
-        Ts,
-        tri_volume.begin(),
-        [&](const Vector3i& t) -> Float
+    parallel_for(
+        0,
+        Ts.size(),
+        [&](SizeT i)
         {
+            const Vector3i& t = Ts[i];
             auto [p0, p1, p2] = std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]]};
 
             auto n    = (p1 - p0).cross(p2 - p0);
@@ -89,15 +92,18 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tri(SimplicialComplex&
                 auto r = thickness_view[t[0]];
 
                 if(r == 0.0)  // if the thickness is zero, treat the density as surface density
-                    return area;
+                {
+                    tri_volume[i] = area;
+                    return;
+                }
 
                 auto h = 2 * r;
 
-                return area * h;
+                tri_volume[i] = area * h;
             }
             else
             {
-                return area;
+                tri_volume[i] = area;
             }
         });
 
@@ -132,12 +138,13 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_edge(SimplicialComplex
     auto Vs = R.positions().view();
     auto Es = R.edges().topo().view();
 
-    std::ranges::transform(
-        Es,
-        edge_volume.begin(),
-        [&](const Vector2i& e) -> Float
+    parallel_for(
+        0,
+        Es.size(),
+        [&](SizeT i)
         {
-            auto [p0, p1] = std::tuple{Vs[e[0]], Vs[e[1]]};
+            const Vector2i& e = Es[i];
+            auto [p0, p1]     = std::tuple{Vs[e[0]], Vs[e[1]]};
 
             auto l = (p1 - p0).norm();
 
@@ -155,13 +162,16 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_edge(SimplicialComplex
                 auto r = thickness_view[e[0]];
 
                 if(r == 0.0)  // if the thickness is zero, set length as volume
-                    return l;
+                {
+                    edge_volume[i] = l;
+                    return;
+                }
 
                 auto area = r * r * std::numbers::pi;
-                return l * area;
+                edge_volume[i] = l * area;
             }
             else
-                return l;
+                edge_volume[i] = l;
         });
 
     auto volume = R.vertices().find<Float>(builtin::volume);
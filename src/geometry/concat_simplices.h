@@ -0,0 +1,85 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/parallel_for.h>
+#include <algorithm>
+
+namespace uipc::geometry
+{
+template <IndexT N, typename SC>
+auto simplices(SC& sc)
+{
+    if constexpr(N == 0)
+        return sc.vertices();
+    else if constexpr(N == 1)
+        return sc.edges();
+    else if constexpr(N == 2)
+        return sc.triangles();
+    else
+        return sc.tetrahedra();
+}
+
+/**
+ * @brief Concatenate the N-simplices of the sources into `R`, shared by `merge()` and `extract_surface()`.
+ *
+ * The attributes are copied by `concat_from()`, then the topology is remapped to the vertices of `R`.
+ *
+ * @param mappings The selected simplices of each source, empty to select all the simplices of all the sources.
+ * @param vertex_maps The old to new vertex mapping of each source, empty (or empty for a source) to keep the vertex ids.
+ * @param vertex_offsets The offset of the vertices of each source in `R`.
+ * @param exclude_names The names of the attributes not to be copied, the topology is always excluded.
+ */
+template <IndexT N>
+void concat_simplices(SimplicialComplex&                               R,
+                      span<const SimplicialComplexAttributes<true, N>> sources,
+                      span<const span<const SizeT>>                    mappings,
+                      span<const span<const IndexT>>                   vertex_maps,
+                      span<const SizeT>                                vertex_offsets,
+                      span<const string> exclude_names = {})
+{
+    using TopoT = typename SimplicialComplexAttributes<true, N>::TopoValueT;
+
+    vector<string> excludes{exclude_names.begin(), exclude_names.end()};
+    excludes.push_back(string{builtin::topo});
+
+    auto dst = simplices<N>(R);
+    // resize and copy all the selected attributes except the topology in one pass
+    dst.concat_from(sources, mappings, excludes);
+
+    if constexpr(N > 0)
+    {
+        auto count = [&](SizeT I)
+        { return mappings.empty() ? sources[I].size() : mappings[I].size(); };
+
+        // the exclusive scan of the simplex counts
+        vector<SizeT> offsets(sources.size() + 1, 0);
+        for(SizeT I = 0; I < sources.size(); ++I)
+            offsets[I + 1] = offsets[I] + count(I);
+
+        vector<span<const TopoT>> src_topos(sources.size());
+        for(auto&& [I, source] : enumerate(sources))
+            if(count(I) > 0)
+                src_topos[I] = source.topo().view();
+
+        auto topo = dst.template create<TopoT>(builtin::topo, TopoT::Zero(), false);
+        auto dst_topo = view(*topo);
+
+        // remap the topology to the vertices of R, add the vertex offset of the source
+        parallel_for(0,
+                     dst_topo.size(),
+                     [&](SizeT i)
+                     {
+                         SizeT I = std::ranges::upper_bound(offsets, i) - offsets.begin() - 1;
+                         SizeT j = i - offsets[I];
+
+                         TopoT t = src_topos[I][mappings.empty() ? j : mappings[I][j]];
+                         if(!vertex_maps.empty() && !vertex_maps[I].empty())
+                             for(auto& v : t)
+                                 v = vertex_maps[I][v];
+                         dst_topo[i] = t.array() + static_cast<IndexT>(vertex_offsets[I]);
+                     },
+                     4096);
+    }
+}
+}  // namespace uipc::geometry
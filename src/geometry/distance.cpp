@@ -596,4 +596,82 @@ Float edge_edge_squared_distance(const Vector3& Ea0,
 
     return dist2;
 }
+
+namespace
+{
+    // the distance computation branches on the closest feature, there is no vectorized kernel,
+    // `ExecutionPolicy::Simd` runs as `ExecutionPolicy::Parallel`
+    template <typename F>
+    void evaluate(SizeT N, span<Float> Ds, ExecutionPolicy policy, F&& f)
+    {
+        UIPC_ASSERT(Ds.size() == N, "Output size mismatch, expected {}, got {}", N, Ds.size());
+        parallel_for(
+            policy, 0, N, [&](SizeT i) { Ds[i] = f(i); }, 4096);
+    }
+}  // namespace
+
+void point_point_squared_distance(span<const Vector2i> PPs,
+                                  span<const Vector3>  Vs,
+                                  span<Float>          Ds,
+                                  ExecutionPolicy      policy)
+{
+    evaluate(PPs.size(),
+             Ds,
+             policy,
+             [&](SizeT i)
+             {
+                 const Vector2i& PP = PPs[i];
+                 return point_point_squared_distance(Vs[PP[0]], Vs[PP[1]]);
+             });
+}
+
+void point_edge_squared_distance(span<const Vector2i> PEs,
+                                 span<const Vector3>  Vs,
+                                 span<const Vector2i> Es,
+                                 span<Float>          Ds,
+                                 ExecutionPolicy      policy)
+{
+    evaluate(PEs.size(),
+             Ds,
+             policy,
+             [&](SizeT i)
+             {
+                 const Vector2i& E = Es[PEs[i][1]];
+                 return point_edge_squared_distance(Vs[PEs[i][0]], Vs[E[0]], Vs[E[1]]);
+             });
+}
+
+void point_triangle_squared_distance(span<const Vector2i> PTs,
+                                     span<const Vector3>  Vs,
+                                     span<const Vector3i> Fs,
+                                     span<Float>          Ds,
+                                     ExecutionPolicy      policy)
+{
+    evaluate(PTs.size(),
+             Ds,
+             policy,
+             [&](SizeT i)
+             {
+                 const Vector3i& F = Fs[PTs[i][1]];
+                 return point_triangle_squared_distance(
+                     Vs[PTs[i][0]], Vs[F[0]], Vs[F[1]], Vs[F[2]]);
+             });
+}
+
+void edge_edge_squared_distance(span<const Vector2i> EEs,
+                                span<const Vector3>  Vs,
+                                span<const Vector2i> Es,
+                                span<Float>          Ds,
+                                ExecutionPolicy      policy)
+{
+    evaluate(EEs.size(),
+             Ds,
+             policy,
+             [&](SizeT i)
+             {
+                 const Vector2i& Ea = Es[EEs[i][0]];
+                 const Vector2i& Eb = Es[EEs[i][1]];
+                 return edge_edge_squared_distance(Vs[Ea[0]], Vs[Ea[1]], Vs[Eb[0]], Vs[Eb[1]]);
+             });
+}
 }  // namespace uipc::geometry
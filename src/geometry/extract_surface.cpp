@@ -3,7 +3,8 @@
 #include <uipc/common/enumerate.h>
 #include <uipc/builtin/attribute_name.h>
 #include <uipc/geometry/utils/apply_transform.h>
-#include <uipc/geometry/utils/merge.h>
+#include <concat_simplices.h>
+#include <Eigen/Geometry>
 #include <numeric>
 
 namespace uipc::geometry
@@ -198,6 +199,108 @@ static void extract_surface_check_input(span<const SimplicialComplex*> sc)
     }
 }
 
+namespace
+{
+    // the simplices of an input that go to the merged surface
+    struct SurfaceSelection
+    {
+        const SimplicialComplex* complex = nullptr;
+        // the triangles of a tetrahedral mesh are all facets and have no parent
+        bool is_tetmesh = false;
+
+        // new to old mapping of the vertices, edges and triangles
+        vector<SizeT> vertices;
+        vector<SizeT> edges;
+        vector<SizeT> triangles;
+
+        // old to new mapping of the vertices, empty if all the vertices are kept
+        vector<IndexT> old_to_new;
+    };
+
+    template <IndexT N>
+    span<const SizeT> selected(const SurfaceSelection& selection)
+    {
+        if constexpr(N == 0)
+            return selection.vertices;
+        else if constexpr(N == 1)
+            return selection.edges;
+        else if constexpr(N == 2)
+            return selection.triangles;
+        else
+            return {};  // no tetrahedron is on the surface
+    }
+
+    vector<SizeT> select(span<const IndexT> is_surf)
+    {
+        vector<SizeT> R;
+        for(auto&& [i, surf] : enumerate(is_surf))
+            if(surf)
+                R.push_back(static_cast<SizeT>(i));
+        return R;
+    }
+
+    vector<SizeT> select_all(SizeT N)
+    {
+        vector<SizeT> R(N);
+        std::iota(R.begin(), R.end(), 0);
+        return R;
+    }
+
+    // pass one: select the surface simplices of an input, the input is only read
+    void select_surface(SurfaceSelection& S, const SimplicialComplex* src)
+    {
+        S.complex = src;
+
+        if(src->dim() != 3)
+        {
+            S.vertices  = select_all(src->vertices().size());
+            S.edges     = select_all(src->edges().size());
+            S.triangles = select_all(src->triangles().size());
+            return;
+        }
+
+        auto v_is_surf = src->vertices().find<IndexT>(builtin::is_surf);
+        auto e_is_surf = src->edges().find<IndexT>(builtin::is_surf);
+        auto f_is_surf = src->triangles().find<IndexT>(builtin::is_surf);
+
+        UIPC_ASSERT(v_is_surf, "`is_surf` attribute not found in the mesh vertices. {}", hint);
+        UIPC_ASSERT(e_is_surf, "`is_surf` attribute not found in the mesh edges. {}", hint);
+        UIPC_ASSERT(f_is_surf, "`is_surf` attribute not found in the mesh triangles. {}", hint);
+
+        S.is_tetmesh = true;
+        S.vertices   = select(v_is_surf->view());
+        S.edges      = select(e_is_surf->view());
+        S.triangles  = select(f_is_surf->view());
+
+        S.old_to_new.resize(src->vertices().size(), -1);
+        for(auto&& [new_v, old_v] : enumerate(S.vertices))
+            S.old_to_new[old_v] = static_cast<IndexT>(new_v);
+    }
+
+    // pass two: fill the selected simplices of all the instances into the output
+    template <IndexT N>
+    void fill_simplices(SimplicialComplex&            R,
+                        span<const SurfaceSelection*> instances,
+                        span<const SizeT>             vertex_offsets,
+                        span<const string>            exclude_names)
+    {
+        vector<SimplicialComplexAttributes<true, N>> sources;
+        vector<span<const SizeT>>                    mappings;
+        vector<span<const IndexT>>                   vertex_maps;
+        sources.reserve(instances.size());
+        mappings.reserve(instances.size());
+        vertex_maps.reserve(instances.size());
+        for(auto instance : instances)
+        {
+            sources.push_back(simplices<N>(*instance->complex));
+            mappings.push_back(selected<N>(*instance));
+            vertex_maps.push_back(instance->old_to_new);
+        }
+
+        concat_simplices<N>(R, sources, mappings, vertex_maps, vertex_offsets, exclude_names);
+    }
+}  // namespace
+
 SimplicialComplex extract_surface(span<const SimplicialComplex*> sc)
 {
     if(sc.empty())
@@ -205,45 +308,113 @@ SimplicialComplex extract_surface(span<const SimplicialComplex*> sc)
 
     extract_surface_check_input(sc);
 
-    // 1) extract the surface from each simplicial complex
-    vector<SimplicialComplex> surfaces;
-    surfaces.reserve(sc.size());
-
-    std::transform(sc.begin(),
-                   sc.end(),
-                   std::back_inserter(surfaces),
-                   [](const SimplicialComplex* simplicial_complex)
-                   {
-                       if(simplicial_complex->dim() == 3)
-                           return extract_surface(*simplicial_complex);
-                       else
-                           return *simplicial_complex;
-                   });
-
-    // 2) find out all the surface instances, apply the transformation
-    SizeT total_surface_instances =
-        std::accumulate(sc.begin(),
-                        sc.end(),
-                        0ull,
-                        [](SizeT acc, const SimplicialComplex* simplicial_complex)
-                        { return acc + simplicial_complex->instances().size(); });
-
-    vector<SimplicialComplex> all_surfaces;
-    all_surfaces.reserve(total_surface_instances);
-
-    for(auto& surface : surfaces)
+    // 1) select the surface simplices of each simplicial complex, only the indices are computed in parallel
+    vector<SurfaceSelection> selections(sc.size());
+    parallel_for(
+        0, sc.size(), [&](SizeT I) { select_surface(selections[I], sc[I]); }, 1);
+
+    // 2) every instance of a surface is a copy of its selection, in the order of the inputs then the instances
+    vector<const SurfaceSelection*> instances;
+    vector<Matrix4x4>               transforms;
+    for(auto& selection : selections)
+    {
+        auto Ts = selection.complex->transforms().view();
+        for(auto& T : Ts)
+        {
+            instances.push_back(&selection);
+            transforms.push_back(T);
+        }
+    }
+
+    // the exclusive scan of the vertex and triangle counts
+    vector<SizeT> vertex_offsets(instances.size() + 1, 0);
+    vector<SizeT> triangle_offsets(instances.size() + 1, 0);
+    for(auto&& [I, instance] : enumerate(instances))
+    {
+        vertex_offsets[I + 1]   = vertex_offsets[I] + instance->vertices.size();
+        triangle_offsets[I + 1] = triangle_offsets[I] + instance->triangles.size();
+    }
+
+    auto is_tetmesh_triangles = [&](SizeT I)
+    { return instances[I]->is_tetmesh && !instances[I]->triangles.empty(); };
+
+    bool has_tetmesh_triangles = false;
+    for(SizeT I = 0; I < instances.size(); ++I)
+        has_tetmesh_triangles |= is_tetmesh_triangles(I);
+
+    // the same as extract_surface(), the surface triangles of the tetrahedral meshes don't keep these attributes
+    const std::array surface_excludes = {string{builtin::parent_id},
+                                         string{builtin::is_facet}};
+
+    SimplicialComplex R;
+
+    fill_simplices<0>(R, instances, vertex_offsets, {});
+    fill_simplices<1>(R, instances, vertex_offsets, {});
+    fill_simplices<2>(R,
+                      instances,
+                      vertex_offsets,
+                      has_tetmesh_triangles ? span<const string>{surface_excludes} :
+                                              span<const string>{});
+    fill_simplices<3>(R, instances, vertex_offsets, {});
+
+    // 3) apply the transforms of the instances
+    if(auto pos = R.vertices().find<Vector3>(builtin::position))
     {
-        vector<SimplicialComplex> instances = apply_transform(surface);
-        std::move(instances.begin(), instances.end(), std::back_inserter(all_surfaces));
+        auto Vs = view(*pos);
+        parallel_for(0,
+                     Vs.size(),
+                     [&](SizeT i)
+                     {
+                         SizeT I = std::ranges::upper_bound(vertex_offsets, i)
+                                   - vertex_offsets.begin() - 1;
+                         if(!transforms[I].isIdentity())
+                             Vs[i] = Transform{transforms[I]} * Vs[i];
+                     },
+                     4096);
     }
 
-    vector<const SimplicialComplex*> surfaces_ptr(total_surface_instances);
+    if(!has_tetmesh_triangles)
+        return R;
 
-    std::transform(all_surfaces.begin(),
-                   all_surfaces.end(),
-                   surfaces_ptr.begin(),
-                   [](SimplicialComplex& surface) { return &surface; });
+    // 4) the excluded attributes are set serially: the triangles of the tetrahedral meshes are all facets
+    // without parent, the other inputs keep their own values
+    struct Excluded
+    {
+        std::string_view name;
+        IndexT           default_value;
+        IndexT           tetmesh_value;
+    };
 
-    return merge(surfaces_ptr);
+    for(auto [name, default_value, tetmesh_value] :
+        {Excluded{builtin::parent_id, -1, -1}, Excluded{builtin::is_facet, 0, 1}})
+    {
+        auto dst = R.triangles().find<IndexT>(name);
+        for(SizeT I = 0; I < instances.size(); ++I)
+        {
+            auto& instance = *instances[I];
+            if(instance.triangles.empty())
+                continue;
+
+            auto src = instance.complex->triangles().find<IndexT>(name);
+            if(!instance.is_tetmesh && !src)
+                continue;
+            if(instance.is_tetmesh && tetmesh_value == default_value)
+                continue;
+
+            if(!dst)
+                dst = R.triangles().create<IndexT>(name, default_value);
+
+            auto dst_view = view(*dst).subspan(triangle_offsets[I], instance.triangles.size());
+            if(instance.is_tetmesh)
+                std::ranges::fill(dst_view, tetmesh_value);
+            else
+                std::ranges::transform(instance.triangles,
+                                       dst_view.begin(),
+                                       [src_view = src->view()](SizeT i)
+                                       { return src_view[i]; });
+        }
+    }
+
+    return R;
 }
-}  // namespace uipc::geometry
\ No newline at end of file
+}  // namespace uipc::geometry
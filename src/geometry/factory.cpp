@@ -10,9 +10,7 @@ namespace detail
     static void create_vertices(SimplicialComplex& sc, span<const Vector3> Vs)
     {
         sc.vertices().resize(Vs.size());
-        auto pos = sc.vertices().create<Vector3>(builtin::position, Vector3::Zero(), false);
-        auto pos_view = view(*pos);
-        std::ranges::copy(Vs, pos_view.begin());
+        sc.vertices().create_from<Vector3>(builtin::position, Vs, Vector3::Zero(), false);
     }
 }  // namespace detail
 
@@ -22,9 +20,7 @@ SimplicialComplex tetmesh(span<const Vector3> Vs, span<const Vector4i> Ts)
 
     // Create tetrahedra
     sc.tetrahedra().resize(Ts.size());
-    auto topo = sc.tetrahedra().create<Vector4i>(builtin::topo, Vector4i::Zero(), false);
-    auto topo_view = view(*topo);
-    std::ranges::copy(Ts, topo_view.begin());
+    sc.tetrahedra().create_from<Vector4i>(builtin::topo, Ts, Vector4i::Zero(), false);
 
     detail::create_vertices(sc, Vs);
 
@@ -37,10 +33,7 @@ SimplicialComplex trimesh(span<const Vector3> Vs, span<const Vector3i> Fs)
 
     // Create triangles
     sc.triangles().resize(Fs.size());
-    auto topo = sc.triangles().create<Vector3i>(builtin::topo, Vector3i::Zero(), false);
-    auto topo_view = view(*topo);
-    std::ranges::copy(Fs, topo_view.begin());
-
+    sc.triangles().create_from<Vector3i>(builtin::topo, Fs, Vector3i::Zero(), false);
 
     detail::create_vertices(sc, Vs);
 
@@ -66,9 +59,7 @@ SimplicialComplex linemesh(span<const Vector3> Vs, span<const Vector2i> Es)
 
     // Create edges
     sc.edges().resize(Es.size());
-    auto topo = sc.edges().create<Vector2i>(builtin::topo, Vector2i::Zero(), false);
-    auto topo_view = view(*topo);
-    std::ranges::copy(Es, topo_view.begin());
+    sc.edges().create_from<Vector2i>(builtin::topo, Es, Vector2i::Zero(), false);
 
     detail::create_vertices(sc, Vs);
 
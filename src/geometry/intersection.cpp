@@ -1,5 +1,8 @@
 #include <uipc/geometry/utils/intersection.h>
+#include <uipc/geometry/utils/predicates.h>
+#include <uipc/common/log.h>
 #include <Eigen/Dense>
+#include <array>
 #include <igl/segment_segment_intersect.h>
 
 namespace uipc::geometry
@@ -192,4 +195,228 @@ bool is_point_in_tet(const Vector3& tetVA,
     return in_01(tuvw_in_tet[0]) && in_01(tuvw_in_tet[1])
            && in_01(tuvw_in_tet[2]) && in_01(tuvw_in_tet[3]);
 }
+
+namespace
+{
+    // the edge crosses the plane of the triangle, and the line of the edge passes through the triangle
+    bool tri_edge_intersect_exact(const Vector3& T0,
+                                  const Vector3& T1,
+                                  const Vector3& T2,
+                                  const Vector3& E0,
+                                  const Vector3& E1)
+    {
+        int s0 = orient3d(T0, T1, T2, E0);
+        int s1 = orient3d(T0, T1, T2, E1);
+        if(s0 * s1 > 0)
+            return false;
+
+        if(s0 == 0 && s1 == 0)  // coplanar
+            return tri_edge_intersect(T0, T1, T2, E0, E1);
+
+        int t0 = orient3d(E0, E1, T0, T1);
+        int t1 = orient3d(E0, E1, T1, T2);
+        int t2 = orient3d(E0, E1, T2, T0);
+        return !((t0 > 0 || t1 > 0 || t2 > 0) && (t0 < 0 || t1 < 0 || t2 < 0));
+    }
+
+    bool is_point_in_tet_exact(const Vector3& T0,
+                               const Vector3& T1,
+                               const Vector3& T2,
+                               const Vector3& T3,
+                               const Vector3& P)
+    {
+        int o = orient3d(T0, T1, T2, T3);
+        if(o == 0)
+            return false;
+
+        // the barycentric coordinates have the sign of the tetrahedron, or are zero on the boundary
+        auto inside = [o](int s) { return s == 0 || s == o; };
+        return inside(orient3d(P, T1, T2, T3)) && inside(orient3d(T0, P, T2, T3))
+               && inside(orient3d(T0, T1, P, T3)) && inside(orient3d(T0, T1, T2, P));
+    }
+
+    // the pairs in a block of the Simd policy
+    constexpr SizeT Lanes = 8;
+    // the blocks a thread takes at least
+    constexpr SizeT BlockGrain = 128;
+
+    /**
+     * @brief Evaluate the pairs block by block: gather the points of a block, run the branch-free filters of all the lanes,
+     * then decide each lane by the signs. The lanes with an uncertain sign, and the tail, are evaluated by `Kernel::exact()`.
+     */
+    template <typename Kernel>
+    void for_each_block(const Kernel& kernel, SizeT N, span<IndexT> out)
+    {
+        const SizeT block_count = N / Lanes;
+
+        parallel_for(
+            0,
+            block_count,
+            [&](SizeT b)
+            {
+                typename Kernel::Block block;
+
+                const SizeT begin = b * Lanes;
+                for(SizeT l = 0; l < Lanes; ++l)
+                    kernel.gather(block, l, begin + l);
+                for(SizeT l = 0; l < Lanes; ++l)
+                    kernel.filter(block, l);
+                for(SizeT l = 0; l < Lanes; ++l)
+                {
+                    int d          = kernel.decide(block, l);
+                    out[begin + l] = d < 0 ? kernel.exact(begin + l) : d;
+                }
+            },
+            BlockGrain);
+
+        for(SizeT i = block_count * Lanes; i < N; ++i)
+            out[i] = kernel.exact(i);
+    }
+
+    struct TriEdgeKernel
+    {
+        span<const Vector2i> FEs;
+        span<const Vector3>  Vs;
+        span<const Vector3i> Fs;
+        span<const Vector2i> Es;
+
+        struct Block
+        {
+            std::array<Vector3, Lanes> T0, T1, T2, E0, E1;
+            // the signs of the filters, 0 if uncertain
+            std::array<int, Lanes> s0, s1, t0, t1, t2;
+        };
+
+        void gather(Block& B, SizeT l, SizeT i) const
+        {
+            const Vector3i& F = Fs[FEs[i][0]];
+            const Vector2i& E = Es[FEs[i][1]];
+
+            B.T0[l] = Vs[F[0]];
+            B.T1[l] = Vs[F[1]];
+            B.T2[l] = Vs[F[2]];
+            B.E0[l] = Vs[E[0]];
+            B.E1[l] = Vs[E[1]];
+        }
+
+        void filter(Block& B, SizeT l) const
+        {
+            using detail::orient3d_filter;
+            B.s0[l] = orient3d_filter(B.T0[l], B.T1[l], B.T2[l], B.E0[l]);
+            B.s1[l] = orient3d_filter(B.T0[l], B.T1[l], B.T2[l], B.E1[l]);
+            B.t0[l] = orient3d_filter(B.E0[l], B.E1[l], B.T0[l], B.T1[l]);
+            B.t1[l] = orient3d_filter(B.E0[l], B.E1[l], B.T1[l], B.T2[l]);
+            B.t2[l] = orient3d_filter(B.E0[l], B.E1[l], B.T2[l], B.T0[l]);
+        }
+
+        int decide(const Block& B, SizeT l) const
+        {
+            if(B.s0[l] == 0 || B.s1[l] == 0)
+                return -1;
+            if(B.s0[l] == B.s1[l])
+                return 0;
+            if(B.t0[l] == 0 || B.t1[l] == 0 || B.t2[l] == 0)
+                return -1;
+            return B.t0[l] == B.t1[l] && B.t1[l] == B.t2[l];
+        }
+
+        IndexT exact(SizeT i) const
+        {
+            const Vector3i& F = Fs[FEs[i][0]];
+            const Vector2i& E = Es[FEs[i][1]];
+            return tri_edge_intersect_exact(Vs[F[0]], Vs[F[1]], Vs[F[2]], Vs[E[0]], Vs[E[1]]);
+        }
+    };
+
+    struct PointTetKernel
+    {
+        span<const Vector2i> PTs;
+        span<const Vector3>  Vs;
+        span<const Vector4i> Ts;
+
+        struct Block
+        {
+            std::array<Vector3, Lanes> T0, T1, T2, T3, P;
+            // the signs of the filters, 0 if uncertain
+            std::array<int, Lanes> o, s0, s1, s2, s3;
+        };
+
+        void gather(Block& B, SizeT l, SizeT i) const
+        {
+            const Vector4i& T = Ts[PTs[i][1]];
+
+            B.T0[l] = Vs[T[0]];
+            B.T1[l] = Vs[T[1]];
+            B.T2[l] = Vs[T[2]];
+            B.T3[l] = Vs[T[3]];
+            B.P[l]  = Vs[PTs[i][0]];
+        }
+
+        void filter(Block& B, SizeT l) const
+        {
+            using detail::orient3d_filter;
+            B.o[l]  = orient3d_filter(B.T0[l], B.T1[l], B.T2[l], B.T3[l]);
+            B.s0[l] = orient3d_filter(B.P[l], B.T1[l], B.T2[l], B.T3[l]);
+            B.s1[l] = orient3d_filter(B.T0[l], B.P[l], B.T2[l], B.T3[l]);
+            B.s2[l] = orient3d_filter(B.T0[l], B.T1[l], B.P[l], B.T3[l]);
+            B.s3[l] = orient3d_filter(B.T0[l], B.T1[l], B.T2[l], B.P[l]);
+        }
+
+        int decide(const Block& B, SizeT l) const
+        {
+            int o = B.o[l];
+            if(o == 0)
+                return -1;
+            // a certain sign opposite to the tetrahedron is enough to be outside
+            if(B.s0[l] == -o || B.s1[l] == -o || B.s2[l] == -o || B.s3[l] == -o)
+                return 0;
+            if(B.s0[l] == 0 || B.s1[l] == 0 || B.s2[l] == 0 || B.s3[l] == 0)
+                return -1;
+            return 1;
+        }
+
+        IndexT exact(SizeT i) const
+        {
+            const Vector4i& T = Ts[PTs[i][1]];
+            return is_point_in_tet_exact(
+                Vs[T[0]], Vs[T[1]], Vs[T[2]], Vs[T[3]], Vs[PTs[i][0]]);
+        }
+    };
+
+    template <typename Kernel>
+    void evaluate(const Kernel& kernel, SizeT N, span<IndexT> out, ExecutionPolicy policy)
+    {
+        UIPC_ASSERT(out.size() == N, "Output size mismatch, expected {}, got {}", N, out.size());
+
+        if(policy == ExecutionPolicy::Simd)
+            for_each_block(kernel, N, out);
+        else
+            parallel_for(
+                policy, 0, N, [&](SizeT i) { out[i] = kernel.exact(i); }, 4096);
+    }
+}  // namespace
+
+bool is_point_in_tet(const Vector3& T0, const Vector3& T1, const Vector3& T2, const Vector3& T3, const Vector3& P)
+{
+    return is_point_in_tet_exact(T0, T1, T2, T3, P);
+}
+
+void tri_edge_intersect(span<const Vector2i> FEs,
+                        span<const Vector3>  Vs,
+                        span<const Vector3i> Fs,
+                        span<const Vector2i> Es,
+                        span<IndexT>         intersected,
+                        ExecutionPolicy      policy)
+{
+    evaluate(TriEdgeKernel{FEs, Vs, Fs, Es}, FEs.size(), intersected, policy);
+}
+
+void is_point_in_tet(span<const Vector2i> PTs,
+                     span<const Vector3>  Vs,
+                     span<const Vector4i> Ts,
+                     span<IndexT>         inside,
+                     ExecutionPolicy      policy)
+{
+    evaluate(PointTetKernel{PTs, Vs, Ts}, PTs.size(), inside, policy);
+}
 }  // namespace uipc::geometry
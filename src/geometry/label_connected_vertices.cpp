@@ -1,50 +1,163 @@
 #include <uipc/geometry/utils/label_connected_vertices.h>
 #include <uipc/common/enumerate.h>
-#include <igl/connected_components.h>
+#include <uipc/common/parallel_for.h>
+#include <atomic>
+#include <functional>
+#include <vector>
 
 namespace uipc::geometry
 {
+namespace
+{
+    constexpr SizeT Grain = 1 << 14;
+
+    /**
+     * @brief A lock-free union-find, `unite()` and `find()` can be called concurrently.
+     *
+     * A root is always linked under a smaller root (by CAS), so the root of a set is its smallest element,
+     * no matter in which order the unions happen. `find()` compresses the path by halving, with CAS as well.
+     */
+    class ConcurrentDisjointSet
+    {
+      public:
+        explicit ConcurrentDisjointSet(SizeT N)
+            : m_parent(N)
+        {
+            parallel_for(0,
+                         N,
+                         [&](SizeT i)
+                         { m_parent[i].store(static_cast<IndexT>(i), std::memory_order_relaxed); },
+                         Grain);
+        }
+
+        IndexT find(IndexT x) noexcept
+        {
+            while(true)
+            {
+                IndexT p = m_parent[x].load(std::memory_order_relaxed);
+                if(p == x)
+                    return x;
+                IndexT gp = m_parent[p].load(std::memory_order_relaxed);
+                if(gp != p)
+                    m_parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+                x = gp;
+            }
+        }
+
+        void unite(IndexT a, IndexT b) noexcept
+        {
+            while(true)
+            {
+                a = find(a);
+                b = find(b);
+                if(a == b)
+                    return;
+                if(a < b)
+                    std::swap(a, b);
+                // fails if `a` is linked by another thread in between, retry from the new roots
+                IndexT expected = a;
+                if(m_parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+      private:
+        std::vector<std::atomic<IndexT>> m_parent;
+    };
+}  // namespace
+
 S<AttributeSlot<IndexT>> label_connected_vertices(SimplicialComplex& complex)
 {
-    IndexT N_vert = complex.vertices().size();
+    SizeT N_vert = complex.vertices().size();
 
     auto region = complex.vertices().find<IndexT>("region");
     if(!region)
         region = complex.vertices().create<IndexT>("region");
     auto region_view = view(*region);
 
-    std::vector<Eigen::Triplet<IndexT>> triplets{complex.edges().size() * 2};
     auto edge_view = complex.edges().topo().view();
 
-    for(auto [i, edge] : enumerate(edge_view))
-    {
-        UIPC_ASSERT(edge[0] != edge[1],
-                    "Self-loop is not allowed. In edge[{}] = ({},{})",
-                    i,
-                    edge[0],
-                    edge[1]);
+    // 1) union the two vertices of each edge
+    ConcurrentDisjointSet set{N_vert};
+    parallel_for(0,
+                 edge_view.size(),
+                 [&](SizeT i)
+                 {
+                     auto& edge = edge_view[i];
+                     UIPC_ASSERT(edge[0] != edge[1],
+                                 "Self-loop is not allowed. In edge[{}] = ({},{})",
+                                 i,
+                                 edge[0],
+                                 edge[1]);
+                     set.unite(edge[0], edge[1]);
+                 },
+                 Grain);
 
-        triplets[i * 2]     = {edge[0], edge[1], 1};
-        triplets[i * 2 + 1] = {edge[1], edge[0], 1};
-    }
+    // 2) the root (smallest vertex) of each vertex, and the vertex count of each root,
+    //    the runs of the same root in a chunk are added at once
+    const SizeT         chunk_count = (N_vert + Grain - 1) / Grain;
+    std::vector<IndexT> root(N_vert);
+    std::vector<IndexT> root_size(N_vert, 0);
+    parallel_for(0,
+                 chunk_count,
+                 [&](SizeT c)
+                 {
+                     IndexT run_root = -1;
+                     IndexT run      = 0;
+                     auto   flush    = [&]
+                     {
+                         if(run > 0)
+                             std::atomic_ref<IndexT>{root_size[run_root]}.fetch_add(
+                                 run, std::memory_order_relaxed);
+                     };
 
-    Eigen::SparseMatrix<IndexT> adjacency_matrix{N_vert, N_vert};
-    adjacency_matrix.setFromTriplets(triplets.begin(), triplets.end());
+                     for(SizeT i = c * Grain; i < std::min(N_vert, (c + 1) * Grain); ++i)
+                     {
+                         IndexT r = set.find(static_cast<IndexT>(i));
+                         root[i]  = r;
+                         if(r != run_root)
+                         {
+                             flush();
+                             run_root = r;
+                             run      = 0;
+                         }
+                         ++run;
+                     }
+                     flush();
+                 },
+                 1);
 
-    Eigen::VectorXi C;
-    Eigen::VectorXi K;
+    // 3) dense region ids by an exclusive scan over the roots, so the regions are
+    //    numbered in the order of their smallest vertex (the same as a serial traversal)
+    std::vector<IndexT> region_id(N_vert);
+    parallel_for(0,
+                 N_vert,
+                 [&](SizeT i) { region_id[i] = root[i] == static_cast<IndexT>(i); },
+                 Grain);
+    IndexT N_region =
+        exec::parallel_scan<IndexT>(region_id, region_id, 0, std::plus<IndexT>{}, Grain);
 
-    auto N_region = igl::connected_components(adjacency_matrix, C, K);
-
-    // fill the region attribute
-    for(auto&& [i, r] : enumerate(region_view))
-        r = C[i];
+    // 4) fill the region attribute, and the vertex count of each region from its root
+    VectorXi region_vertex_count(N_region);
+    parallel_for(0,
+                 N_vert,
+                 [&](SizeT i)
+                 {
+                     region_view[i] = region_id[root[i]];
+                     if(root[i] == static_cast<IndexT>(i))
+                         region_vertex_count[region_id[i]] = root_size[i];
+                 },
+                 Grain);
 
     auto region_count = complex.meta().find<IndexT>("region_count");
     if(!region_count)
         region_count = complex.meta().create<IndexT>("region_count");
-    auto region_count_view = view(*region_count);
-    region_count_view[0]   = N_region;
+    view(*region_count)[0] = N_region;
+
+    auto vertex_count = complex.meta().find<VectorXi>("region_vertex_count");
+    if(!vertex_count)
+        vertex_count = complex.meta().create<VectorXi>("region_vertex_count");
+    view(*vertex_count)[0] = std::move(region_vertex_count);
 
     return region;
 }
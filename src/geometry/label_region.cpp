@@ -1,8 +1,97 @@
 #include <uipc/geometry/utils/label_region.h>
 #include <uipc/geometry/utils/label_connected_vertices.h>
+#include <uipc/common/parallel_for.h>
+#include <algorithm>
+#include <atomic>
 
 namespace uipc::geometry
 {
+namespace
+{
+    constexpr SizeT Grain = 4096;
+
+    /**
+     * @brief Fill the region of each simplex from its vertices, and count the simplices of each region in the same pass.
+     *
+     * The runs of the same region in a chunk are added at once, so a large region doesn't serialize the counting.
+     */
+    template <int N>
+    VectorXi fill_region(std::string_view                     simplex_name,
+                         span<const Eigen::Vector<IndexT, N>> topo,
+                         span<const IndexT>                   vert_region,
+                         span<IndexT>                         region,
+                         IndexT                               region_count)
+    {
+        VectorXi    counts      = VectorXi::Zero(region_count);
+        const SizeT chunk_count = (topo.size() + Grain - 1) / Grain;
+
+        parallel_for(0,
+                     chunk_count,
+                     [&](SizeT c)
+                     {
+                         IndexT run_region = -1;
+                         IndexT run        = 0;
+                         auto   flush      = [&]
+                         {
+                             if(run > 0)
+                                 std::atomic_ref<IndexT>{counts[run_region]}.fetch_add(
+                                     run, std::memory_order_relaxed);
+                         };
+
+                         for(SizeT i = c * Grain; i < std::min(topo.size(), (c + 1) * Grain); ++i)
+                         {
+                             const auto& simplex = topo[i];
+                             IndexT      r       = vert_region[simplex[0]];
+                             for(int k = 1; k < N; ++k)
+                             {
+                                 UIPC_ASSERT(vert_region[simplex[k]] == r,
+                                             "In the {}[{}], vertices {} and {} are not in the same region -> ({},{}), which is ill condition.",
+                                             simplex_name,
+                                             i,
+                                             simplex[0],
+                                             simplex[k],
+                                             r,
+                                             vert_region[simplex[k]]);
+                             }
+
+                             region[i] = r;
+                             if(r != run_region)
+                             {
+                                 flush();
+                                 run_region = r;
+                                 run        = 0;
+                             }
+                             ++run;
+                         }
+                         flush();
+                     },
+                     1);
+
+        return counts;
+    }
+
+    template <typename SimplicesT>
+    void label_simplex_region(SimplicialComplex& complex,
+                              SimplicesT&&       simplices,
+                              std::string_view   simplex_name,
+                              std::string_view   count_name,
+                              span<const IndexT> vert_region,
+                              IndexT             region_count)
+    {
+        auto region = simplices.template find<IndexT>("region");
+        if(!region)
+            region = simplices.template create<IndexT>("region");
+
+        auto counts = fill_region(
+            simplex_name, simplices.topo().view(), vert_region, view(*region), region_count);
+
+        auto count = complex.meta().find<VectorXi>(count_name);
+        if(!count)
+            count = complex.meta().create<VectorXi>(count_name);
+        view(*count)[0] = std::move(counts);
+    }
+}  // namespace
+
 void label_region(SimplicialComplex& complex)
 {
     // 1) find the region of each vertex
@@ -12,87 +101,42 @@ void label_region(SimplicialComplex& complex)
 
     auto vert_region_view = vert_region->view();
 
+    auto region_count = complex.meta().find<IndexT>("region_count");
+    if(!region_count)  // the vertex regions are given, count them
+    {
+        region_count = complex.meta().create<IndexT>("region_count");
+        view(*region_count)[0] =
+            vert_region_view.empty() ? 0 : std::ranges::max(vert_region_view) + 1;
+    }
+    IndexT N_region = region_count->view()[0];
+
     auto Dim = complex.dim();
 
     // 2) fill the region of each edge
     if(Dim >= 1)
-    {
-        auto edge_region = complex.edges().find<IndexT>("region");
-        if(!edge_region)
-            edge_region = complex.edges().create<IndexT>("region");
-
-        auto edge_region_view = view(*edge_region);
-        auto edge_view        = complex.edges().topo().view();
-
-        for(auto [i, edge] : enumerate(edge_view))
-        {
-            UIPC_ASSERT(vert_region_view[edge[0]] == vert_region_view[edge[1]],
-                        "In the edge[{}] = ({},{}), vertices are not in the same region -> ({},{}), which is ill condition.",
-                        i,
-                        edge[0],
-                        edge[1],
-                        vert_region_view[edge[0]],
-                        vert_region_view[edge[1]]);
-
-            edge_region_view[i] = vert_region_view[edge[0]];
-        }
-    }
+        label_simplex_region(complex,
+                             complex.edges(),
+                             "edge",
+                             "region_edge_count",
+                             vert_region_view,
+                             N_region);
 
     // 3) fill the region of each triangle
     if(Dim >= 2)
-    {
-        auto tri_region = complex.triangles().find<IndexT>("region");
-        if(!tri_region)
-            tri_region = complex.triangles().create<IndexT>("region");
-
-        auto tri_region_view = view(*tri_region);
-        auto tri_view        = complex.triangles().topo().view();
-
-        for(auto [i, tri] : enumerate(tri_view))
-        {
-            UIPC_ASSERT(vert_region_view[tri[0]] == vert_region_view[tri[1]]
-                            && vert_region_view[tri[1]] == vert_region_view[tri[2]],
-                        "In the triangle[{}] = ({},{},{}), vertices are not in the same region -> ({},{},{}), which is ill condition.",
-                        i,
-                        tri[0],
-                        tri[1],
-                        tri[2],
-                        vert_region_view[tri[0]],
-                        vert_region_view[tri[1]],
-                        vert_region_view[tri[2]]);
-
-            tri_region_view[i] = vert_region_view[tri[0]];
-        }
-    }
+        label_simplex_region(complex,
+                             complex.triangles(),
+                             "triangle",
+                             "region_triangle_count",
+                             vert_region_view,
+                             N_region);
 
     // 4) fill the region of each tetrahedron
     if(Dim >= 3)
-    {
-        auto tet_region = complex.tetrahedra().find<IndexT>("region");
-        if(!tet_region)
-            tet_region = complex.tetrahedra().create<IndexT>("region");
-
-        auto tet_region_view = view(*tet_region);
-        auto tet_view        = complex.tetrahedra().topo().view();
-
-        for(auto [i, tet] : enumerate(tet_view))
-        {
-            UIPC_ASSERT(vert_region_view[tet[0]] == vert_region_view[tet[1]]
-                            && vert_region_view[tet[1]] == vert_region_view[tet[2]]
-                            && vert_region_view[tet[2]] == vert_region_view[tet[3]],
-                        "In the tetrahedron[{}] = ({},{},{},{}), vertices are not in the same region -> ({},{},{},{}), which is ill condition.",
-                        i,
-                        tet[0],
-                        tet[1],
-                        tet[2],
-                        tet[3],
-                        vert_region_view[tet[0]],
-                        vert_region_view[tet[1]],
-                        vert_region_view[tet[2]],
-                        vert_region_view[tet[3]]);
-
-            tet_region_view[i] = vert_region_view[tet[0]];
-        }
-    }
+        label_simplex_region(complex,
+                             complex.tetrahedra(),
+                             "tetrahedron",
+                             "region_tetrahedron_count",
+                             vert_region_view,
+                             N_region);
 }
 }  // namespace uipc::geometry
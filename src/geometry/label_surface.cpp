@@ -2,6 +2,7 @@
 #include <uipc/common/timer.h>
 #include <uipc/common/enumerate.h>
 #include <uipc/common/algorithm/run_length_encode.h>
+#include <uipc/common/parallel_for.h>
 #include <uipc/builtin/attribute_name.h>
 #include <algorithm>
 #include <numeric>
@@ -87,15 +88,22 @@ void label_surface(SimplicialComplex& R)
     };
 
 
-    for(auto&& [i, T] : enumerate(Ts))
-    {
-        IndexT I = static_cast<IndexT>(i);
+    parallel_for(0,
+                 Ts.size(),
+                 [&](SizeT i)
+                 {
+                     const Vector4i& T = Ts[i];
+                     IndexT          I = static_cast<IndexT>(i);
 
-        separated_triangles[4 * i + 0] = sort_triangle(Vector4i{T[0], T[1], T[2], I});
-        separated_triangles[4 * i + 1] = sort_triangle(Vector4i{T[0], T[1], T[3], I});
-        separated_triangles[4 * i + 2] = sort_triangle(Vector4i{T[0], T[2], T[3], I});
-        separated_triangles[4 * i + 3] = sort_triangle(Vector4i{T[1], T[2], T[3], I});
-    }
+                     separated_triangles[4 * i + 0] =
+                         sort_triangle(Vector4i{T[0], T[1], T[2], I});
+                     separated_triangles[4 * i + 1] =
+                         sort_triangle(Vector4i{T[0], T[1], T[3], I});
+                     separated_triangles[4 * i + 2] =
+                         sort_triangle(Vector4i{T[0], T[2], T[3], I});
+                     separated_triangles[4 * i + 3] =
+                         sort_triangle(Vector4i{T[1], T[2], T[3], I});
+                 });
 
     // 2) run length encoding the triangles
     std::ranges::sort(separated_triangles,
@@ -124,6 +132,7 @@ void label_surface(SimplicialComplex& R)
     auto is_surface_triangle = [&counts](IndexT i) { return counts[i] == 1; };
 
     // 3) label the surface tetrahedra
+    // NOTE: a tetrahedron may own several surface triangles, so steps 3) and 6) stay serial
     auto t_is_surf = R.tetrahedra().find<IndexT>(builtin::is_surf);
     if(!t_is_surf)
     {
@@ -150,23 +159,27 @@ void label_surface(SimplicialComplex& R)
         auto f_is_surf_view   = view(*f_is_surf);
         auto f_parent_id_view = view(*f_parent_id);
         // now we assume the triangles are sorted
-        for(auto&& [i, UF] : enumerate(unique_triangles))
-        {
-            auto& F      = Fs[i];
-            auto  sorted = (F == UF.segment<3>(0));
-
-            // TODO:
-            // if the triangles are not sorted, we need find a mapping from the sorted to the unsorted
-            // and then we can label the surface vertices
-            UIPC_ASSERT(sorted, "The triangles are not sorted, now we don't support this case, TODO: need to implement it.");
-
-            if(is_surface_triangle(i))
+        parallel_for(
+            0,
+            unique_triangles.size(),
+            [&](SizeT i)
             {
-                f_is_surf_view[i] = 1;
-            }
-
-            f_parent_id_view[i] = UF[3];
-        }
+                const Vector4i& UF     = unique_triangles[i];
+                auto&           F      = Fs[i];
+                auto            sorted = (F == UF.segment<3>(0));
+
+                // TODO:
+                // if the triangles are not sorted, we need find a mapping from the sorted to the unsorted
+                // and then we can label the surface vertices
+                UIPC_ASSERT(sorted, "The triangles are not sorted, now we don't support this case, TODO: need to implement it.");
+
+                if(is_surface_triangle(i))
+                {
+                    f_is_surf_view[i] = 1;
+                }
+
+                f_parent_id_view[i] = UF[3];
+            });
     }
 
 
@@ -175,15 +188,17 @@ void label_surface(SimplicialComplex& R)
     auto             Es = R.edges().topo().view();
     vector<Vector3i> edges_with_flag(unique_triangles.size() * 3);
     vector<IndexT>   edge_is_surf(unique_triangles.size() * 3, 0);
-    for(auto&& [i, F] : enumerate(unique_triangles))
-    {
-
-        IndexT count = counts[i];
-        // first 2 components are the edge, the last component is the 'count'
-        edges_with_flag[3 * i + 0] = Vector3i{F[0], F[1], count};
-        edges_with_flag[3 * i + 1] = Vector3i{F[0], F[2], count};
-        edges_with_flag[3 * i + 2] = Vector3i{F[1], F[2], count};
-    }
+    parallel_for(0,
+                 unique_triangles.size(),
+                 [&](SizeT i)
+                 {
+                     const Vector4i& F     = unique_triangles[i];
+                     IndexT          count = counts[i];
+                     // first 2 components are the edge, the last component is the 'count'
+                     edges_with_flag[3 * i + 0] = Vector3i{F[0], F[1], count};
+                     edges_with_flag[3 * i + 1] = Vector3i{F[0], F[2], count};
+                     edges_with_flag[3 * i + 2] = Vector3i{F[1], F[2], count};
+                 });
 
     // sort by the 3 components
     std::ranges::sort(edges_with_flag,
@@ -226,23 +241,28 @@ void label_surface(SimplicialComplex& R)
     std::exclusive_scan(counts_edges.begin(), counts_edges.end(), offsets_edges.begin(), 0);
 
     //To find the surface edges_with_flag, we only need to check if the edge belongs to a surface triangle
-    for(auto e_is_surf_view = view(*e_is_surf); auto&& [i, UE] : enumerate(unique_edges))
-    {
-        auto& E      = Es[i];
-        auto  sorted = (E == UE.segment<2>(0));
+    auto e_is_surf_view = view(*e_is_surf);
+    parallel_for(
+        0,
+        unique_edges.size(),
+        [&](SizeT i)
+        {
+            const Vector3i& UE     = unique_edges[i];
+            auto&           E      = Es[i];
+            auto            sorted = (E == UE.segment<2>(0));
 
-        // TODO: if the edges_with_flag are not sorted, we need find a mapping from the sorted to the unsorted
-        // 	 and then we can label the surface vertices
-        UIPC_ASSERT(sorted, "The edges are not sorted, now we don't support this case, TODO: need to implement it.");
+            // TODO: if the edges_with_flag are not sorted, we need find a mapping from the sorted to the unsorted
+            // 	 and then we can label the surface vertices
+            UIPC_ASSERT(sorted, "The edges are not sorted, now we don't support this case, TODO: need to implement it.");
 
-        auto offset         = offsets_edges[i];
-        auto edge_with_flag = edges_with_flag[offset];
+            auto offset         = offsets_edges[i];
+            auto edge_with_flag = edges_with_flag[offset];
 
-        if(edge_with_flag(2) == 1)  // count == 1, means the triangle is surface
-        {
-            e_is_surf_view[i] = 1;
-        }
-    }
+            if(edge_with_flag(2) == 1)  // count == 1, means the triangle is surface
+            {
+                e_is_surf_view[i] = 1;
+            }
+        });
 
     // 6) label the surface vertices
     for(auto v_is_surf_view = view(*v_is_surf); auto&& [i, F] : enumerate(unique_triangles))
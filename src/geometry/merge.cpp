@@ -1,7 +1,7 @@
 #include <uipc/geometry/utils/merge.h>
 #include <uipc/builtin/attribute_name.h>
-#include <numeric>
 #include <algorithm>
+#include <uipc/common/parallel_for.h>
 #include <ranges>
 
 namespace uipc::geometry
@@ -19,205 +19,82 @@ static void check_merge_input(span<const SimplicialComplex*> complexes)
 }
 
 
-SimplicialComplex merge(span<const SimplicialComplex*> complexes)
+template <IndexT N, typename SC>
+static auto simplices(SC& sc)
 {
-    check_merge_input(complexes);
-
-    SimplicialComplex R;
-
-    vector<SizeT> vertex_offsets(complexes.size() + 1, 0);
-    vector<SizeT> vertex_counts(complexes.size() + 1, 0);
+    if constexpr(N == 0)
+        return sc.vertices();
+    else if constexpr(N == 1)
+        return sc.edges();
+    else if constexpr(N == 2)
+        return sc.triangles();
+    else
+        return sc.tetrahedra();
+}
 
-    std::ranges::transform(complexes,
-                           vertex_counts.begin(),
-                           [](const SimplicialComplex* complex)
-                           { return complex->vertices().size(); });
+template <IndexT N>
+static void merge_simplices(SimplicialComplex&             R,
+                            span<const SimplicialComplex*> complexes,
+                            span<const SizeT>              vertex_offsets)
+{
+    using TopoT = typename SimplicialComplexAttributes<true, N>::TopoValueT;
 
-    std::exclusive_scan(
-        vertex_counts.begin(), vertex_counts.end(), vertex_offsets.begin(), 0ull);
+    vector<SimplicialComplexAttributes<true, N>> sources;
+    sources.reserve(complexes.size());
+    for(auto complex : complexes)
+        sources.push_back(simplices<N>(*complex));
 
     vector<string> exclude_attributes = {string{builtin::topo}};
 
-    {  // 1) merge vertices
-        SizeT num_verts = vertex_offsets.back();
+    auto dst = simplices<N>(R);
+    // resize and copy all the attributes except the topology in one pass
+    dst.concat_from(sources, exclude_attributes);
 
-        R.vertices().resize(num_verts);
-
-        for(auto&& [i, complex] : enumerate(complexes))
-        {
-            auto count  = vertex_counts[i];
-            auto offset = vertex_offsets[i];
-            R.vertices().copy_from(complex->vertices(),
-                                   AttributeCopy::range(offset, 0, count),
-                                   {},
-                                   exclude_attributes);
-        }
+    if constexpr(N > 0)
+    {
+        vector<SizeT> offsets(complexes.size() + 1, 0);
+        for(auto&& [I, source] : enumerate(sources))
+            offsets[I + 1] = offsets[I] + source.size();
+
+        auto topo = dst.template create<TopoT>(builtin::topo, TopoT::Zero(), false);
+        auto dst_topo = view(*topo);
+
+        // setup topology, add the vertex offset to each simplex
+        parallel_for(0,
+                     sources.size(),
+                     [&](SizeT I)
+                     {
+                         auto& source = sources[I];
+                         if(source.size() == 0)
+                             return;
+
+                         auto src_topo = source.topo().view();
+                         auto v_offset = static_cast<IndexT>(vertex_offsets[I]);
+                         std::ranges::transform(src_topo,
+                                                dst_topo.begin() + offsets[I],
+                                                [=](const TopoT& t) -> TopoT
+                                                { return t.array() + v_offset; });
+                     },
+                     256);
     }
+}
 
-    {  // 2) merge edges
-
-        vector<SizeT> edge_offsets(complexes.size() + 1, 0);
-        vector<SizeT> edge_counts(complexes.size() + 1, 0);
-
-        std::ranges::transform(complexes,
-                               edge_counts.begin(),
-                               [](const SimplicialComplex* complex)
-                               { return complex->edges().size(); });
-
-        std::exclusive_scan(edge_counts.begin(), edge_counts.end(), edge_offsets.begin(), 0ull);
-
-        SizeT num_edges = edge_offsets.back();
-
-        R.edges().resize(num_edges);
-        auto topo = R.edges().create<Vector2i>(builtin::topo, Vector2i::Zero(), false);
-        auto Es = view(*topo);
-
-
-        // setup edge topology
-        for(auto&& [I, complex] : enumerate(complexes))
-        {
-            SizeT e_offset = edge_offsets[I];
-            SizeT e_count  = edge_counts[I];
-            SizeT v_offset = vertex_offsets[I];
-
-            if(e_count)
-            {
-                span<Vector2i>       dst_Es = Es.subspan(e_offset, e_count);
-                span<const Vector2i> src_Es = complex->edges().topo().view();
-
-                // add offset to each edge
-                std::ranges::transform(src_Es,
-                                       dst_Es.begin(),
-                                       [=](const Vector2i& e) -> Vector2i
-                                       { return e.array() + v_offset; });
-            }
-        }
-
-        // copy edge attributes
-        for(auto&& [I, complex] : enumerate(complexes))
-        {
-            auto count  = edge_counts[I];
-            auto offset = edge_offsets[I];
-            if(count > 0)
-            {
-                R.edges().copy_from(complex->edges(),
-                                    AttributeCopy::range(offset, 0, count),
-                                    {},
-                                    exclude_attributes);
-            }
-        }
-    }
+SimplicialComplex merge(span<const SimplicialComplex*> complexes)
+{
+    check_merge_input(complexes);
 
-    {  // 3) merge triangles
-
-        vector<SizeT> triangle_offsets(complexes.size() + 1, 0);
-        vector<SizeT> triangle_counts(complexes.size() + 1, 0);
-
-        std::ranges::transform(complexes,
-                               triangle_counts.begin(),
-                               [](const SimplicialComplex* complex)
-                               { return complex->triangles().size(); });
-
-        std::exclusive_scan(triangle_counts.begin(),
-                            triangle_counts.end(),
-                            triangle_offsets.begin(),
-                            0ull);
-
-        SizeT num_triangles = triangle_offsets.back();
-
-        R.triangles().resize(num_triangles);
-        auto topo = R.triangles().create<Vector3i>(builtin::topo, Vector3i::Zero(), false);
-
-        auto Fs = view(*topo);
-
-        // setup triangle topology
-        for(auto [I, complex] : enumerate(complexes))
-        {
-            SizeT offset   = triangle_offsets[I];
-            SizeT count    = triangle_counts[I];
-            SizeT v_offset = vertex_offsets[I];
-
-            if(count)
-            {
-                span<Vector3i> dst_Ts = Fs.subspan(offset, count);
-                span<const Vector3i> src_Ts = complex->triangles().topo().view();
-
-                // add offset to each triangle
-                std::ranges::transform(src_Ts,
-                                       dst_Ts.begin(),
-                                       [=](const Vector3i& t) -> Vector3i
-                                       { return t.array() + v_offset; });
-            }
-        }
-
-        // copy triangle attributes
-        for(auto [I, complex] : enumerate(complexes))
-        {
-            auto count = triangle_counts[I];
-            if(count > 0)
-            {
-                R.triangles().copy_from(complex->triangles(),
-                                        AttributeCopy::range(triangle_offsets[I], 0, count),
-                                        {},
-                                        exclude_attributes);
-            }
-        }
-    }
+    SimplicialComplex R;
 
-    {  // 4) merge tetrahedra
-
-        vector<SizeT> tetrahedron_offsets(complexes.size() + 1, 0);
-        vector<SizeT> tetrahedron_counts(complexes.size() + 1, 0);
-
-        std::ranges::transform(complexes,
-                               tetrahedron_counts.begin(),
-                               [](const SimplicialComplex* complex)
-                               { return complex->tetrahedra().size(); });
-
-        std::exclusive_scan(tetrahedron_counts.begin(),
-                            tetrahedron_counts.end(),
-                            tetrahedron_offsets.begin(),
-                            0ull);
-
-        SizeT num_tetrahedra = tetrahedron_offsets.back();
-
-        R.tetrahedra().resize(num_tetrahedra);
-        auto topo = R.tetrahedra().create<Vector4i>(builtin::topo, Vector4i::Zero(), false);
-        auto Ts = view(*topo);
-
-        // setup tetrahedron topology
-        for(auto [I, complex] : enumerate(complexes))
-        {
-            SizeT t_offset = tetrahedron_offsets[I];
-            SizeT t_count  = tetrahedron_counts[I];
-            SizeT v_offset = vertex_offsets[I];
-
-            if(t_count)
-            {
-                span<Vector4i> dst_Ts = Ts.subspan(t_offset, t_count);
-                span<const Vector4i> src_Ts = complex->tetrahedra().topo().view();
-
-                // add offset to each tetrahedron
-                std::ranges::transform(src_Ts,
-                                       dst_Ts.begin(),
-                                       [=](const Vector4i& t) -> Vector4i
-                                       { return t.array() + v_offset; });
-            }
-        }
-
-        // copy tetrahedron attributes
-        for(auto [I, complex] : enumerate(complexes))
-        {
-            auto count = tetrahedron_counts[I];
-            if(count > 0)
-            {
-                R.tetrahedra().copy_from(complex->tetrahedra(),
-                                         AttributeCopy::range(tetrahedron_offsets[I], 0, count),
-                                         {},
-                                         exclude_attributes);
-            }
-        }
-    }
+    vector<SizeT> vertex_offsets(complexes.size() + 1, 0);
+    for(auto&& [I, complex] : enumerate(complexes))
+        vertex_offsets[I + 1] = vertex_offsets[I] + complex->vertices().size();
+
+    // NOTE: the dimensions are merged one by one, the slots are created in the attribute collections,
+    // which are not thread-safe. The copies inside each dimension run in parallel.
+    merge_simplices<0>(R, complexes, vertex_offsets);
+    merge_simplices<1>(R, complexes, vertex_offsets);
+    merge_simplices<2>(R, complexes, vertex_offsets);
+    merge_simplices<3>(R, complexes, vertex_offsets);
 
     return R;
 }
@@ -0,0 +1,758 @@
+#include <uipc/geometry/utils/mesh_distance_query.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/unordered_map.h>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+
+namespace uipc::geometry
+{
+namespace detail
+{
+    // the closest feature of a triangle:
+    // 0, 1, 2: vertex k
+    // 3, 4, 5: edge (k, k+1) where k = feature - 3
+    // 6: the face
+    constexpr IndexT TriangleFace = 6;
+
+    // Real-Time Collision Detection, 5.1.5 Closest Point on Triangle to Point
+    static Vector3 closest_point_triangle(const Vector3& P,
+                                          const Vector3& A,
+                                          const Vector3& B,
+                                          const Vector3& C,
+                                          Vector3&       bary,
+                                          IndexT&        feature)
+    {
+        Vector3 AB = B - A;
+        Vector3 AC = C - A;
+        Vector3 AP = P - A;
+
+        Float d1 = AB.dot(AP);
+        Float d2 = AC.dot(AP);
+        if(d1 <= 0 && d2 <= 0)
+        {
+            bary    = {1, 0, 0};
+            feature = 0;
+            return A;
+        }
+
+        Vector3 BP = P - B;
+        Float   d3 = AB.dot(BP);
+        Float   d4 = AC.dot(BP);
+        if(d3 >= 0 && d4 <= d3)
+        {
+            bary    = {0, 1, 0};
+            feature = 1;
+            return B;
+        }
+
+        Float vc = d1 * d4 - d3 * d2;
+        if(vc <= 0 && d1 >= 0 && d3 <= 0)
+        {
+            Float v = d1 / (d1 - d3);
+            bary    = {1 - v, v, 0};
+            feature = 3;
+            return A + v * AB;
+        }
+
+        Vector3 CP = P - C;
+        Float   d5 = AB.dot(CP);
+        Float   d6 = AC.dot(CP);
+        if(d6 >= 0 && d5 <= d6)
+        {
+            bary    = {0, 0, 1};
+            feature = 2;
+            return C;
+        }
+
+        Float vb = d5 * d2 - d1 * d6;
+        if(vb <= 0 && d2 >= 0 && d6 <= 0)
+        {
+            Float w = d2 / (d2 - d6);
+            bary    = {1 - w, 0, w};
+            feature = 5;
+            return A + w * AC;
+        }
+
+        Float va = d3 * d6 - d5 * d4;
+        if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+        {
+            Float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            bary    = {0, 1 - w, w};
+            feature = 4;
+            return B + w * (C - B);
+        }
+
+        Float denom = va + vb + vc;
+        if(denom <= 0)  // degenerate triangle, fall back to the closest edge
+        {
+            Vector3 best;
+            Float   best_d2 = std::numeric_limits<Float>::infinity();
+            for(IndexT k = 0; k < 3; ++k)
+            {
+                const Vector3& E0 = k == 0 ? A : k == 1 ? B : C;
+                const Vector3& E1 = k == 0 ? B : k == 1 ? C : A;
+                Vector3        E  = E1 - E0;
+                Float          L2 = E.squaredNorm();
+                Float t  = L2 > 0 ? std::clamp((P - E0).dot(E) / L2, Float{0}, Float{1}) : 0;
+                Vector3 Q  = E0 + t * E;
+                Float   D2 = (P - Q).squaredNorm();
+                if(D2 < best_d2)
+                {
+                    best_d2           = D2;
+                    best              = Q;
+                    bary              = Vector3::Zero();
+                    bary[k]           = 1 - t;
+                    bary[(k + 1) % 3] = t;
+                    feature           = 3 + k;
+                }
+            }
+            return best;
+        }
+
+        Float v = vb / denom;
+        Float w = vc / denom;
+        bary    = {1 - v - w, v, w};
+        feature = TriangleFace;
+        return A + AB * v + AC * w;
+    }
+
+    static Vector3 closest_point_edge(const Vector3& P, const Vector3& A, const Vector3& B, Vector3& bary)
+    {
+        Vector3 E  = B - A;
+        Float   L2 = E.squaredNorm();
+        Float   t  = L2 > 0 ? std::clamp((P - A).dot(E) / L2, Float{0}, Float{1}) : 0;
+        bary       = {1 - t, t, 0};
+        return A + t * E;
+    }
+
+    static U64 edge_key(IndexT a, IndexT b)
+    {
+        return (static_cast<U64>(static_cast<U32>(a)) << 32) | static_cast<U32>(b);
+    }
+}  // namespace detail
+
+class MeshDistanceQuery::Impl
+{
+  public:
+    using AABB = Eigen::AlignedBox<Float, 3>;
+
+    struct Node
+    {
+        AABB   box;
+        IndexT left  = -1;  // -1 for a leaf
+        IndexT right = -1;
+        IndexT begin = 0;  // the range of the leaf in m_order
+        IndexT end   = 0;
+    };
+
+    struct Hit
+    {
+        Result result;
+        IndexT feature = -1;
+    };
+
+    static constexpr IndexT LeafSize = 4;
+
+    void clear()
+    {
+        m_positions.clear();
+        m_prims.clear();
+        m_prim_dim = -1;
+        m_nodes.clear();
+        m_order.clear();
+        m_face_normals.clear();
+        m_edge_normals.clear();
+        m_vertex_normals.clear();
+        m_closed = false;
+        clear_sdf();
+    }
+
+    void clear_sdf()
+    {
+        m_sdf.clear();
+        m_cell_size = 0;
+        m_band      = 0;
+        m_has_sdf   = false;
+    }
+
+    void build(const SimplicialComplex& mesh)
+    {
+        auto Ps = mesh.positions().view();
+
+        vector<Vector3i> prims;
+        IndexT           prim_dim = std::min<IndexT>(mesh.dim(), 2);
+
+        switch(prim_dim)
+        {
+            case 0: {
+                prims.resize(mesh.vertices().size());
+                for(auto&& [i, p] : enumerate(prims))
+                    p = Vector3i{static_cast<IndexT>(i), -1, -1};
+            }
+            break;
+            case 1: {
+                auto Es = mesh.edges().topo().view();
+                prims.resize(Es.size());
+                for(auto&& [i, p] : enumerate(prims))
+                    p = Vector3i{Es[i][0], Es[i][1], -1};
+            }
+            break;
+            default: {
+                auto Fs     = mesh.triangles().topo().view();
+                auto is_surf = mesh.triangles().find<IndexT>(builtin::is_surf);
+                auto orient  = mesh.triangles().find<IndexT>(builtin::orient);
+
+                // the surface of a tetmesh is labeled, a trimesh is all surface
+                auto surf_view = (mesh.dim() == 3 && is_surf) ? is_surf->view() : span<const IndexT>{};
+                auto orient_view = orient ? orient->view() : span<const IndexT>{};
+
+                prims.reserve(Fs.size());
+                for(auto&& [i, F] : enumerate(Fs))
+                {
+                    if(!surf_view.empty() && !surf_view[i])
+                        continue;
+                    Vector3i f = F;
+                    if(!orient_view.empty() && orient_view[i] < 0)
+                        std::swap(f[1], f[2]);
+                    prims.push_back(f);
+                }
+            }
+            break;
+        }
+
+        build(Ps, prims, prim_dim);
+    }
+
+    void build(span<const Vector3> positions, span<const Vector3i> prims, IndexT prim_dim)
+    {
+        clear();
+
+        m_positions.assign(positions.begin(), positions.end());
+        m_prims.assign(prims.begin(), prims.end());
+        m_prim_dim = prim_dim;
+
+        for(auto& p : m_prims)
+        {
+            for(IndexT k = 0; k <= m_prim_dim; ++k)
+                UIPC_ASSERT(p[k] >= 0 && p[k] < static_cast<IndexT>(m_positions.size()),
+                            "Vertex index {} out of range [0, {}).",
+                            p[k],
+                            m_positions.size());
+        }
+
+        build_tree();
+
+        if(m_prim_dim == 2)
+            build_pseudo_normals();
+    }
+
+    void build_tree()
+    {
+        auto N = m_prims.size();
+        if(N == 0)
+            return;
+
+        m_prim_boxes.resize(N);
+        m_centroids.resize(N);
+        for(auto&& [i, p] : enumerate(m_prims))
+        {
+            AABB box;
+            for(IndexT k = 0; k <= m_prim_dim; ++k)
+                box.extend(m_positions[p[k]]);
+            m_prim_boxes[i] = box;
+            m_centroids[i]  = box.center();
+        }
+
+        m_order.resize(N);
+        for(auto&& [i, o] : enumerate(m_order))
+            o = static_cast<IndexT>(i);
+
+        m_nodes.reserve(2 * (N / LeafSize + 1));
+        build_node(0, static_cast<IndexT>(N));
+
+        // the boxes are only needed by the build
+        m_prim_boxes.clear();
+        m_prim_boxes.shrink_to_fit();
+        m_centroids.clear();
+        m_centroids.shrink_to_fit();
+    }
+
+    // split [begin, end) of m_order at the median of the longest axis of the centroids
+    IndexT build_node(IndexT begin, IndexT end)
+    {
+        IndexT index = static_cast<IndexT>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        AABB box;
+        AABB centroid_box;
+        for(IndexT i = begin; i < end; ++i)
+        {
+            box.extend(m_prim_boxes[m_order[i]]);
+            centroid_box.extend(m_centroids[m_order[i]]);
+        }
+        m_nodes[index].box = box;
+
+        if(end - begin <= LeafSize)
+        {
+            m_nodes[index].begin = begin;
+            m_nodes[index].end   = end;
+            return index;
+        }
+
+        Eigen::Index axis;
+        centroid_box.sizes().maxCoeff(&axis);
+
+        IndexT mid = begin + (end - begin) / 2;
+        std::nth_element(m_order.begin() + begin,
+                         m_order.begin() + mid,
+                         m_order.begin() + end,
+                         [&](IndexT a, IndexT b)
+                         { return m_centroids[a][axis] < m_centroids[b][axis]; });
+
+        IndexT left  = build_node(begin, mid);
+        IndexT right = build_node(mid, end);
+
+        // m_nodes may be reallocated by the children
+        m_nodes[index].left  = left;
+        m_nodes[index].right = right;
+        return index;
+    }
+
+    void build_pseudo_normals()
+    {
+        auto F = m_prims.size();
+        m_face_normals.resize(F);
+        m_edge_normals.assign(3 * F, Vector3::Zero());
+        m_vertex_normals.assign(m_positions.size(), Vector3::Zero());
+
+        // directed edge -> (triangle, local edge)
+        unordered_map<U64, Vector2i> directed_edges;
+        directed_edges.reserve(3 * F);
+
+        bool closed = F > 0;
+        for(auto&& [i, f] : enumerate(m_prims))
+        {
+            const Vector3& A = m_positions[f[0]];
+            const Vector3& B = m_positions[f[1]];
+            const Vector3& C = m_positions[f[2]];
+
+            Vector3 N   = (B - A).cross(C - A);
+            Float   len = N.norm();
+            N           = len > 0 ? Vector3{N / len} : Vector3::Zero();
+            m_face_normals[i] = N;
+
+            for(IndexT k = 0; k < 3; ++k)
+            {
+                const Vector3& P  = m_positions[f[k]];
+                Vector3        E0 = m_positions[f[(k + 1) % 3]] - P;
+                Vector3        E1 = m_positions[f[(k + 2) % 3]] - P;
+                Float          l  = E0.norm() * E1.norm();
+                Float          angle = l > 0 ? std::acos(std::clamp(E0.dot(E1) / l, Float{-1}, Float{1})) : 0;
+                m_vertex_normals[f[k]] += angle * N;
+
+                auto [it, inserted] = directed_edges.try_emplace(
+                    detail::edge_key(f[k], f[(k + 1) % 3]), Vector2i{static_cast<IndexT>(i), k});
+                // the same directed edge twice: not a consistently oriented manifold
+                closed &= inserted;
+            }
+        }
+
+        for(auto&& [key, e] : directed_edges)
+        {
+            IndexT a = static_cast<IndexT>(key >> 32);
+            IndexT b = static_cast<IndexT>(key & 0xFFFFFFFFull);
+
+            auto twin = directed_edges.find(detail::edge_key(b, a));
+            if(twin == directed_edges.end())
+            {
+                // a boundary edge, the normal of the face alone
+                closed                       = false;
+                m_edge_normals[3 * e[0] + e[1]] = m_face_normals[e[0]];
+                continue;
+            }
+            auto& t = twin->second;
+            m_edge_normals[3 * e[0] + e[1]] = m_face_normals[e[0]] + m_face_normals[t[0]];
+        }
+
+        m_closed = closed;
+    }
+
+    Hit closest(const Vector3& P, Float max_distance) const
+    {
+        Hit hit;
+        if(m_nodes.empty())
+            return hit;
+
+        Float best_d2 = max_distance * max_distance;
+        bool  found   = false;
+
+        // (squared distance to the box, node)
+        std::pair<Float, IndexT> stack[64];
+        SizeT                    top = 0;
+
+        auto root_d2 = m_nodes[0].box.squaredExteriorDistance(P);
+        if(root_d2 <= best_d2)
+            stack[top++] = {root_d2, 0};
+
+        while(top > 0)
+        {
+            auto [d2, index] = stack[--top];
+            if(d2 > best_d2)
+                continue;
+
+            const Node& node = m_nodes[index];
+            if(node.left < 0)
+            {
+                for(IndexT i = node.begin; i < node.end; ++i)
+                {
+                    IndexT          prim = m_order[i];
+                    const Vector3i& p    = m_prims[prim];
+
+                    Vector3 bary;
+                    IndexT  feature = -1;
+                    Vector3 Q;
+                    switch(m_prim_dim)
+                    {
+                        case 0:
+                            Q    = m_positions[p[0]];
+                            bary = {1, 0, 0};
+                            break;
+                        case 1:
+                            Q = detail::closest_point_edge(
+                                P, m_positions[p[0]], m_positions[p[1]], bary);
+                            break;
+                        default:
+                            Q = detail::closest_point_triangle(P,
+                                                               m_positions[p[0]],
+                                                               m_positions[p[1]],
+                                                               m_positions[p[2]],
+                                                               bary,
+                                                               feature);
+                            break;
+                    }
+
+                    Float D2 = (P - Q).squaredNorm();
+                    if(D2 < best_d2 || (!found && D2 <= best_d2))
+                    {
+                        best_d2                  = D2;
+                        found                    = true;
+                        hit.result.primitive     = prim;
+                        hit.result.barycentric   = bary;
+                        hit.result.closest_point = Q;
+                        hit.feature              = feature;
+                    }
+                }
+                continue;
+            }
+
+            Float dl = m_nodes[node.left].box.squaredExteriorDistance(P);
+            Float dr = m_nodes[node.right].box.squaredExteriorDistance(P);
+
+            // push the farther child first, so the nearer one is visited first
+            std::pair<Float, IndexT> near{dl, node.left};
+            std::pair<Float, IndexT> far{dr, node.right};
+            if(dr < dl)
+                std::swap(near, far);
+
+            UIPC_ASSERT(top + 2 <= std::size(stack), "BVH is too deep, why can it happen?");
+            if(far.first <= best_d2)
+                stack[top++] = far;
+            if(near.first <= best_d2)
+                stack[top++] = near;
+        }
+
+        if(found)
+            hit.result.distance = std::sqrt(best_d2);
+        return hit;
+    }
+
+    Result query(const Vector3& P, Float max_distance) const
+    {
+        return closest(P, max_distance).result;
+    }
+
+    Result signed_query(const Vector3& P, Float max_distance) const
+    {
+        UIPC_ASSERT(m_closed,
+                    "The signed distance is only defined for a closed, consistently oriented trimesh.");
+
+        Hit hit = closest(P, max_distance);
+        if(hit.result.primitive < 0)
+            return hit.result;
+
+        const Vector3i& f = m_prims[hit.result.primitive];
+
+        Vector3 N;
+        if(hit.feature == detail::TriangleFace)
+            N = m_face_normals[hit.result.primitive];
+        else if(hit.feature >= 3)
+            N = m_edge_normals[3 * hit.result.primitive + (hit.feature - 3)];
+        else
+            N = m_vertex_normals[f[hit.feature]];
+
+        if((P - hit.result.closest_point).dot(N) < 0)
+            hit.result.distance = -hit.result.distance;
+        return hit.result;
+    }
+
+    Float exact_distance(const Vector3& P) const
+    {
+        return m_closed ? signed_query(P, std::numeric_limits<Float>::infinity()).distance :
+                          query(P, std::numeric_limits<Float>::infinity()).distance;
+    }
+
+    // the grid nodes are packed into 21 bits per axis
+    static constexpr I64 GridBits   = 21;
+    static constexpr I64 GridOffset = I64{1} << (GridBits - 1);
+
+    static U64 grid_key(I64 i, I64 j, I64 k)
+    {
+        constexpr U64 Mask = (U64{1} << GridBits) - 1;
+        return (static_cast<U64>(i + GridOffset) & Mask)
+               | ((static_cast<U64>(j + GridOffset) & Mask) << GridBits)
+               | ((static_cast<U64>(k + GridOffset) & Mask) << (2 * GridBits));
+    }
+
+    bool in_grid_range(const Vector3& P) const
+    {
+        Float limit = static_cast<Float>(GridOffset - 2) * m_cell_size;
+        return (P.array().abs() < limit).all();
+    }
+
+    void build_sdf(Float cell_size, Float band)
+    {
+        UIPC_ASSERT(cell_size > 0, "The cell size should be positive, yours {}.", cell_size);
+        UIPC_ASSERT(band >= 0, "The band should be non-negative, yours {}.", band);
+
+        clear_sdf();
+        if(m_prims.empty())
+            return;
+
+        m_cell_size = cell_size;
+        m_band      = band;
+
+        UIPC_ASSERT(in_grid_range(m_nodes[0].box.min()) && in_grid_range(m_nodes[0].box.max()),
+                    "The mesh is too large for the cell size {}, the grid supports {} cells per axis.",
+                    cell_size,
+                    2 * GridOffset);
+
+        // the candidate nodes: the nodes in the band-expanded box of any primitive
+        vector<U64> keys;
+        for(auto& p : m_prims)
+        {
+            AABB box;
+            for(IndexT k = 0; k <= m_prim_dim; ++k)
+                box.extend(m_positions[p[k]]);
+
+            Eigen::Vector<I64, 3> lo =
+                ((box.min().array() - band) / cell_size).floor().cast<I64>();
+            Eigen::Vector<I64, 3> hi =
+                ((box.max().array() + band) / cell_size).ceil().cast<I64>();
+
+            for(I64 i = lo[0]; i <= hi[0]; ++i)
+                for(I64 j = lo[1]; j <= hi[1]; ++j)
+                    for(I64 k = lo[2]; k <= hi[2]; ++k)
+                        keys.push_back(grid_key(i, j, k));
+        }
+
+        std::ranges::sort(keys);
+        auto [first, last] = std::ranges::unique(keys);
+        keys.erase(first, last);
+
+        constexpr U64 Mask = (U64{1} << GridBits) - 1;
+        vector<Float> values(keys.size());
+        parallel_for(0,
+                     keys.size(),
+                     [&](SizeT I)
+                     {
+                         U64     key = keys[I];
+                         Vector3 P{
+                             static_cast<Float>(static_cast<I64>(key & Mask) - GridOffset),
+                             static_cast<Float>(static_cast<I64>((key >> GridBits) & Mask) - GridOffset),
+                             static_cast<Float>(static_cast<I64>((key >> (2 * GridBits)) & Mask) - GridOffset)};
+                         values[I] = exact_distance(P * cell_size);
+                     },
+                     64);
+
+        // only the nodes in the band are kept
+        m_sdf.reserve(keys.size());
+        for(auto&& [I, key] : enumerate(keys))
+        {
+            if(std::abs(values[I]) <= band)
+                m_sdf.emplace(key, values[I]);
+        }
+
+        // build_sdf() with an empty band still marks the grid as built
+        m_has_sdf = true;
+    }
+
+    Float distance(const Vector3& P) const
+    {
+        if(m_has_sdf && in_grid_range(P))
+        {
+            Vector3 X  = P / m_cell_size;
+            Vector3 X0 = X.array().floor();
+            Vector3 T  = X - X0;
+
+            I64 i = static_cast<I64>(X0[0]);
+            I64 j = static_cast<I64>(X0[1]);
+            I64 k = static_cast<I64>(X0[2]);
+
+            Float values[8];
+            bool  covered = true;
+            for(IndexT c = 0; c < 8 && covered; ++c)
+            {
+                auto it = m_sdf.find(grid_key(i + (c & 1), j + ((c >> 1) & 1), k + ((c >> 2) & 1)));
+                if(it == m_sdf.end())
+                    covered = false;
+                else
+                    values[c] = it->second;
+            }
+
+            if(covered)
+            {
+                Float x00 = std::lerp(values[0], values[1], T[0]);
+                Float x10 = std::lerp(values[2], values[3], T[0]);
+                Float x01 = std::lerp(values[4], values[5], T[0]);
+                Float x11 = std::lerp(values[6], values[7], T[0]);
+                Float y0  = std::lerp(x00, x10, T[1]);
+                Float y1  = std::lerp(x01, x11, T[1]);
+                return std::lerp(y0, y1, T[2]);
+            }
+        }
+
+        return exact_distance(P);
+    }
+
+    vector<Vector3>  m_positions;
+    vector<Vector3i> m_prims;
+    IndexT           m_prim_dim = -1;
+
+    vector<Node>   m_nodes;
+    vector<IndexT> m_order;
+
+    // build only
+    vector<AABB>    m_prim_boxes;
+    vector<Vector3> m_centroids;
+
+    // angle-weighted pseudo normals, for the sign of the distance
+    vector<Vector3> m_face_normals;
+    vector<Vector3> m_edge_normals;  // 3 per triangle, edge (k, k+1)
+    vector<Vector3> m_vertex_normals;
+    bool            m_closed = false;
+
+    // sparse narrow-band SDF
+    unordered_map<U64, Float> m_sdf;
+    Float                     m_cell_size = 0;
+    Float                     m_band      = 0;
+    bool                      m_has_sdf   = false;
+};
+
+MeshDistanceQuery::MeshDistanceQuery()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+MeshDistanceQuery::MeshDistanceQuery(const SimplicialComplex& mesh)
+    : MeshDistanceQuery()
+{
+    build(mesh);
+}
+
+MeshDistanceQuery::~MeshDistanceQuery() {}
+
+void MeshDistanceQuery::build(const SimplicialComplex& mesh)
+{
+    m_impl->build(mesh);
+}
+
+void MeshDistanceQuery::build(span<const Vector3> positions, span<const Vector3i> triangles)
+{
+    m_impl->build(positions, triangles, 2);
+}
+
+void MeshDistanceQuery::clear()
+{
+    m_impl->clear();
+}
+
+SizeT MeshDistanceQuery::primitive_count() const noexcept
+{
+    return m_impl->m_prims.size();
+}
+
+bool MeshDistanceQuery::is_closed() const noexcept
+{
+    return m_impl->m_closed;
+}
+
+auto MeshDistanceQuery::query(const Vector3& point, Float max_distance) const -> Result
+{
+    return m_impl->query(point, max_distance);
+}
+
+void MeshDistanceQuery::query(span<const Vector3> points, span<Result> results, Float max_distance) const
+{
+    UIPC_ASSERT(points.size() == results.size(),
+                "The size of results ({}) should be the size of points ({}).",
+                results.size(),
+                points.size());
+
+    parallel_for(0,
+                 points.size(),
+                 [&](SizeT I) { results[I] = m_impl->query(points[I], max_distance); },
+                 256);
+}
+
+auto MeshDistanceQuery::signed_query(const Vector3& point, Float max_distance) const -> Result
+{
+    return m_impl->signed_query(point, max_distance);
+}
+
+void MeshDistanceQuery::signed_query(span<const Vector3> points,
+                                     span<Result>        results,
+                                     Float               max_distance) const
+{
+    UIPC_ASSERT(points.size() == results.size(),
+                "The size of results ({}) should be the size of points ({}).",
+                results.size(),
+                points.size());
+
+    parallel_for(0,
+                 points.size(),
+                 [&](SizeT I)
+                 { results[I] = m_impl->signed_query(points[I], max_distance); },
+                 256);
+}
+
+void MeshDistanceQuery::build_sdf(Float cell_size, Float band)
+{
+    m_impl->build_sdf(cell_size, band);
+}
+
+bool MeshDistanceQuery::has_sdf() const noexcept
+{
+    return m_impl->m_has_sdf;
+}
+
+Float MeshDistanceQuery::distance(const Vector3& point) const
+{
+    return m_impl->distance(point);
+}
+
+void MeshDistanceQuery::distance(span<const Vector3> points, span<Float> distances) const
+{
+    UIPC_ASSERT(points.size() == distances.size(),
+                "The size of distances ({}) should be the size of points ({}).",
+                distances.size(),
+                points.size());
+
+    parallel_for(0,
+                 points.size(),
+                 [&](SizeT I) { distances[I] = m_impl->distance(points[I]); },
+                 256);
+}
+}  // namespace uipc::geometry
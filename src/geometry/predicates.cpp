@@ -0,0 +1,107 @@
+#include <uipc/geometry/utils/predicates.h>
+#include <array>
+
+namespace uipc::geometry
+{
+namespace detail
+{
+    // the floating point expansion arithmetic of Shewchuk,
+    // a value is represented exactly by the sum of nonoverlapping components of increasing magnitude
+
+    // a + b = x + y exactly
+    inline void two_sum(Float a, Float b, Float& x, Float& y) noexcept
+    {
+        x        = a + b;
+        Float bv = x - a;
+        Float av = x - bv;
+        y        = (a - av) + (b - bv);
+    }
+
+    // a * b = x + y exactly
+    inline void two_product(Float a, Float b, Float& x, Float& y) noexcept
+    {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    class Expansion
+    {
+      public:
+        // all the components of the 4 triple products of the 4 determinants of orient3d fit in
+        static constexpr SizeT Capacity = 4 * 6 * 4;
+
+        // add b to the expansion, the zero components are eliminated
+        void add(Float b) noexcept
+        {
+            Float Q    = b;
+            SizeT size = 0;
+            for(SizeT i = 0; i < m_size; ++i)
+            {
+                Float h;
+                two_sum(Q, m_components[i], Q, h);
+                if(h != 0)
+                    m_components[size++] = h;
+            }
+            if(Q != 0 || size == 0)
+                m_components[size++] = Q;
+            m_size = size;
+        }
+
+        // add s * a * b * c to the expansion
+        void add_product(int s, Float a, Float b, Float c) noexcept
+        {
+            Float ab, ab_err;
+            two_product(a, b, ab, ab_err);
+
+            Float x, y;
+            two_product(ab, c, x, y);
+            add(s * x);
+            add(s * y);
+            two_product(ab_err, c, x, y);
+            add(s * x);
+            add(s * y);
+        }
+
+        // the sign of the value, the largest component decides
+        int sign() const noexcept
+        {
+            Float top = m_components[m_size - 1];
+            return (top > 0) - (top < 0);
+        }
+
+      private:
+        std::array<Float, Capacity> m_components{};
+        SizeT                       m_size = 0;
+    };
+
+    // add s * det(P, Q, R) to the expansion
+    inline void add_det3(Expansion& e, int s, const Vector3& P, const Vector3& Q, const Vector3& R) noexcept
+    {
+        e.add_product(s, P[0], Q[1], R[2]);
+        e.add_product(-s, P[0], Q[2], R[1]);
+        e.add_product(-s, P[1], Q[0], R[2]);
+        e.add_product(s, P[1], Q[2], R[0]);
+        e.add_product(s, P[2], Q[0], R[1]);
+        e.add_product(-s, P[2], Q[1], R[0]);
+    }
+
+    int orient3d_exact(const Vector3& A, const Vector3& B, const Vector3& C, const Vector3& D) noexcept
+    {
+        // det(B - A, C - A, D - A), expanded without the inexact differences:
+        // det(B, C, D) - det(A, C, D) + det(A, B, D) - det(A, B, C)
+        Expansion e;
+        add_det3(e, 1, B, C, D);
+        add_det3(e, -1, A, C, D);
+        add_det3(e, 1, A, B, D);
+        add_det3(e, -1, A, B, C);
+        return e.sign();
+    }
+}  // namespace detail
+
+int orient3d(const Vector3& A, const Vector3& B, const Vector3& C, const Vector3& D)
+{
+    if(int s = detail::orient3d_filter(A, B, C, D))
+        return s;
+    return detail::orient3d_exact(A, B, C, D);
+}
+}  // namespace uipc::geometry
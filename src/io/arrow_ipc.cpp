@@ -0,0 +1,373 @@
+#include "arrow_ipc.h"
+#include <uipc/common/log.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace uipc::geometry::arrow
+{
+namespace
+{
+    // A minimal flatbuffers writer.
+    //
+    // Objects are written front to back: a table (preceded by its vtable) first, then its children.
+    // So all the uoffsets point forward, as flatbuffers requires.
+    class FlatBufferWriter
+    {
+      public:
+        using ChildWriter = std::function<SizeT(FlatBufferWriter&)>;
+
+        struct TableField
+        {
+            uint16_t    id;
+            uint8_t     size  = 0;  // inline scalar size, 0 for offset fields
+            U64         value = 0;
+            ChildWriter child;
+        };
+
+        SizeT pos() const noexcept { return m_buffer.size(); }
+
+        // pad so that (pos + extra) % align == 0
+        void pad(SizeT align, SizeT extra = 0)
+        {
+            while((pos() + extra) % align != 0)
+                m_buffer.push_back(std::byte{0});
+        }
+
+        template <typename T>
+        SizeT put(T value)
+        {
+            SizeT at = pos();
+            m_buffer.resize(at + sizeof(T));
+            std::memcpy(m_buffer.data() + at, &value, sizeof(T));
+            return at;
+        }
+
+        void put_bytes(span<const std::byte> bytes)
+        {
+            m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+        }
+
+        template <typename T>
+        void patch(SizeT at, T value)
+        {
+            std::memcpy(m_buffer.data() + at, &value, sizeof(T));
+        }
+
+        SizeT write_table(std::vector<TableField> fields)
+        {
+            uint16_t slot_count = 0;
+            for(auto& f : fields)
+                slot_count = std::max<uint16_t>(slot_count, f.id + 1);
+
+            // inline layout, the larger fields first to minimize the padding
+            std::ranges::stable_sort(fields,
+                                     [](const TableField& a, const TableField& b)
+                                     { return inline_size(a) > inline_size(b); });
+
+            std::vector<uint16_t> field_offsets(fields.size());
+            SizeT            table_size = sizeof(I32);  // soffset to the vtable
+            for(SizeT i = 0; i < fields.size(); ++i)
+            {
+                SizeT s          = inline_size(fields[i]);
+                table_size       = (table_size + s - 1) / s * s;
+                field_offsets[i] = static_cast<uint16_t>(table_size);
+                table_size += s;
+            }
+
+            // vtable
+            pad(sizeof(uint16_t));
+            SizeT vtable_pos = put<uint16_t>(static_cast<uint16_t>(sizeof(uint16_t) * (2 + slot_count)));
+            put<uint16_t>(static_cast<uint16_t>(table_size));
+            std::vector<uint16_t> slots(slot_count, 0);
+            for(SizeT i = 0; i < fields.size(); ++i)
+                slots[fields[i].id] = field_offsets[i];
+            for(auto s : slots)
+                put<uint16_t>(s);
+
+            // table, the vtable is found at (table_pos - soffset)
+            pad(8);
+            SizeT table_pos = put<I32>(static_cast<I32>(pos() - vtable_pos));
+            m_buffer.resize(table_pos + table_size, std::byte{0});
+            for(SizeT i = 0; i < fields.size(); ++i)
+            {
+                auto& f = fields[i];
+                if(!f.child)
+                    std::memcpy(m_buffer.data() + table_pos + field_offsets[i], &f.value, f.size);
+            }
+
+            // children
+            for(SizeT i = 0; i < fields.size(); ++i)
+            {
+                auto& f = fields[i];
+                if(f.child)
+                {
+                    SizeT at    = table_pos + field_offsets[i];
+                    SizeT child = f.child(*this);
+                    patch<U32>(at, static_cast<U32>(child - at));
+                }
+            }
+
+            return table_pos;
+        }
+
+        SizeT write_table_vector(SizeT count, std::function<SizeT(FlatBufferWriter&, SizeT)> write_element)
+        {
+            pad(sizeof(U32));
+            SizeT vector_pos = put<U32>(static_cast<U32>(count));
+            SizeT first      = pos();
+            for(SizeT i = 0; i < count; ++i)
+                put<U32>(0);
+            for(SizeT i = 0; i < count; ++i)
+            {
+                SizeT at    = first + i * sizeof(U32);
+                SizeT child = write_element(*this, i);
+                patch<U32>(at, static_cast<U32>(child - at));
+            }
+            return vector_pos;
+        }
+
+        SizeT write_struct_vector(SizeT count, span<const std::byte> bytes, SizeT align)
+        {
+            // the elements (right after the length) must be aligned
+            pad(std::max<SizeT>(align, sizeof(U32)), sizeof(U32));
+            SizeT vector_pos = put<U32>(static_cast<U32>(count));
+            put_bytes(bytes);
+            return vector_pos;
+        }
+
+        SizeT write_string(std::string_view str)
+        {
+            pad(sizeof(U32));
+            SizeT string_pos = put<U32>(static_cast<U32>(str.size()));
+            put_bytes({reinterpret_cast<const std::byte*>(str.data()), str.size()});
+            put<uint8_t>(0);
+            return string_pos;
+        }
+
+        /**
+         * @brief Write the root table, return the finished buffer, padded to 8 bytes.
+         */
+        std::vector<std::byte> finish(std::vector<TableField> root)
+        {
+            SizeT at       = put<U32>(0);
+            SizeT root_pos = write_table(std::move(root));
+            patch<U32>(at, static_cast<U32>(root_pos - at));
+            pad(8);
+            return std::move(m_buffer);
+        }
+
+      private:
+        static SizeT inline_size(const TableField& f)
+        {
+            return f.child ? sizeof(U32) : f.size;
+        }
+
+        std::vector<std::byte> m_buffer;
+    };
+
+    using TableField = FlatBufferWriter::TableField;
+
+    template <typename T>
+    TableField scalar(uint16_t id, T value)
+    {
+        TableField f;
+        f.id   = id;
+        f.size = sizeof(T);
+        std::memcpy(&f.value, &value, sizeof(T));
+        return f;
+    }
+
+    TableField child(uint16_t id, FlatBufferWriter::ChildWriter writer)
+    {
+        TableField f;
+        f.id    = id;
+        f.child = std::move(writer);
+        return f;
+    }
+
+    // Schema.fbs / Message.fbs
+    constexpr int16_t MetadataVersionV5        = 4;
+    constexpr uint8_t MessageHeaderSchema      = 1;
+    constexpr uint8_t MessageHeaderRecordBatch = 3;
+
+    SizeT write_type(FlatBufferWriter& w, const DataType& type)
+    {
+        switch(type.id)
+        {
+            case TypeId::Int:
+                return w.write_table({scalar<I32>(0, type.bit_width),
+                                      scalar<uint8_t>(1, type.is_signed ? 1 : 0)});
+            case TypeId::FloatingPoint:
+                return w.write_table({scalar<int16_t>(0, type.precision)});
+            case TypeId::FixedSizeList:
+                return w.write_table({scalar<I32>(0, type.list_size)});
+            case TypeId::LargeUtf8:
+            case TypeId::LargeList:
+            default:
+                return w.write_table({});
+        }
+    }
+
+    SizeT write_field(FlatBufferWriter& w, const Field& field)
+    {
+        return w.write_table(
+            {child(0, [&](FlatBufferWriter& w) { return w.write_string(field.name); }),
+             scalar<uint8_t>(1, 0),  // nullable = false
+             scalar<uint8_t>(2, static_cast<uint8_t>(field.type.id)),
+             child(3, [&](FlatBufferWriter& w) { return write_type(w, field.type); }),
+             child(5,
+                   [&](FlatBufferWriter& w)
+                   {
+                       return w.write_table_vector(field.children.size(),
+                                                   [&](FlatBufferWriter& w, SizeT i)
+                                                   {
+                                                       return write_field(w, field.children[i]);
+                                                   });
+                   })});
+    }
+
+    struct FieldNode
+    {
+        I64 length;
+        I64 null_count;
+    };
+
+    struct BufferSpec
+    {
+        I64 offset;
+        I64 length;
+    };
+
+    constexpr SizeT align8(SizeT n) noexcept
+    {
+        return (n + 7) / 8 * 8;
+    }
+
+    void flatten(const ArrayData&                    array,
+                 std::vector<FieldNode>&             nodes,
+                 std::vector<BufferSpec>&            buffers,
+                 std::vector<span<const std::byte>>& body,
+                 SizeT&                              body_length)
+    {
+        nodes.push_back({static_cast<I64>(array.length), 0});
+
+        // validity bitmap, empty for non-nullable arrays
+        buffers.push_back({static_cast<I64>(body_length), 0});
+
+        for(auto& b : array.buffers)
+        {
+            buffers.push_back({static_cast<I64>(body_length), static_cast<I64>(b.size())});
+            body.push_back(b);
+            body_length += align8(b.size());
+        }
+
+        for(auto& c : array.children)
+            flatten(c, nodes, buffers, body, body_length);
+    }
+}  // namespace
+
+StreamWriter::StreamWriter(const std::string& file)
+    : m_out(file, std::ios::binary | std::ios::trunc)
+{
+}
+
+bool StreamWriter::is_open() const noexcept
+{
+    return m_out.is_open();
+}
+
+void StreamWriter::write_schema(span<const Field> fields)
+{
+    FlatBufferWriter w;
+
+    auto metadata = w.finish(
+        {scalar<int16_t>(0, MetadataVersionV5),
+         scalar<uint8_t>(1, MessageHeaderSchema),
+         child(2,
+               [&](FlatBufferWriter& w)
+               {
+                   return w.write_table(
+                       {scalar<int16_t>(0, 0),  // little endian
+                        child(1,
+                              [&](FlatBufferWriter& w)
+                              {
+                                  return w.write_table_vector(
+                                      fields.size(),
+                                      [&](FlatBufferWriter& w, SizeT i)
+                                      { return write_field(w, fields[i]); });
+                              })});
+               }),
+         scalar<I64>(3, 0)});
+
+    write_message(metadata, {});
+}
+
+void StreamWriter::write_record_batch(SizeT length, span<const ArrayData> columns)
+{
+    std::vector<FieldNode>             nodes;
+    std::vector<BufferSpec>            buffers;
+    std::vector<span<const std::byte>> body;
+    SizeT                              body_length = 0;
+
+    for(auto& c : columns)
+        flatten(c, nodes, buffers, body, body_length);
+
+    FlatBufferWriter w;
+
+    auto metadata = w.finish(
+        {scalar<int16_t>(0, MetadataVersionV5),
+         scalar<uint8_t>(1, MessageHeaderRecordBatch),
+         child(2,
+               [&](FlatBufferWriter& w)
+               {
+                   return w.write_table(
+                       {scalar<I64>(0, static_cast<I64>(length)),
+                        child(1,
+                              [&](FlatBufferWriter& w)
+                              {
+                                  return w.write_struct_vector(
+                                      nodes.size(), as_bytes(span<const FieldNode>{nodes}), 8);
+                              }),
+                        child(2,
+                              [&](FlatBufferWriter& w)
+                              {
+                                  return w.write_struct_vector(
+                                      buffers.size(), as_bytes(span<const BufferSpec>{buffers}), 8);
+                              })});
+               }),
+         scalar<I64>(3, static_cast<I64>(body_length))});
+
+    write_message(metadata, body);
+}
+
+void StreamWriter::write_message(const std::vector<std::byte>& metadata,
+                                 span<const span<const std::byte>> body)
+{
+    constexpr U32  continuation = 0xFFFFFFFF;
+    constexpr char zeros[8]     = {};
+
+    // metadata is padded to 8 bytes by the flatbuffer writer
+    I32 metadata_size = static_cast<I32>(metadata.size());
+    m_out.write(reinterpret_cast<const char*>(&continuation), sizeof(continuation));
+    m_out.write(reinterpret_cast<const char*>(&metadata_size), sizeof(metadata_size));
+    m_out.write(reinterpret_cast<const char*>(metadata.data()), metadata.size());
+
+    for(auto& b : body)
+    {
+        m_out.write(reinterpret_cast<const char*>(b.data()), b.size());
+        m_out.write(zeros, align8(b.size()) - b.size());
+    }
+}
+
+void StreamWriter::close()
+{
+    if(!m_out.is_open())
+        return;
+
+    // end-of-stream marker
+    constexpr U32 eos[2] = {0xFFFFFFFF, 0};
+    m_out.write(reinterpret_cast<const char*>(eos), sizeof(eos));
+    m_out.close();
+}
+}  // namespace uipc::geometry::arrow
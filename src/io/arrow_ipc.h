@@ -0,0 +1,118 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/span.h>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A minimal writer of the Apache Arrow IPC streaming format.
+ *
+ * Only the types needed by the spreadsheets are supported: Int, FloatingPoint, LargeUtf8, LargeList and
+ * FixedSizeList, all non-nullable. The variable sized types use 64-bit offsets, so a column may hold more than 2GB. See https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format
+ */
+namespace uipc::geometry::arrow
+{
+enum class TypeId : uint8_t
+{
+    Int           = 2,
+    FloatingPoint = 3,
+    FixedSizeList = 16,
+    LargeUtf8     = 20,
+    LargeList     = 21,
+};
+
+struct DataType
+{
+    TypeId  id;
+    I32     bit_width = 0;      // Int
+    bool    is_signed = false;  // Int
+    int16_t precision = 0;      // FloatingPoint: 0 = half, 1 = single, 2 = double
+    I32     list_size = 0;      // FixedSizeList
+};
+
+struct Field
+{
+    std::string        name;
+    DataType           type;
+    std::vector<Field> children;  // List and FixedSizeList have one child
+};
+
+/**
+ * @brief The data of an array (a column), the buffers are views, never copied before writing.
+ *
+ * Buffers (without the validity buffer, all arrays are non-nullable):
+ * - Int, FloatingPoint: values
+ * - LargeUtf8: offsets (I64), data
+ * - LargeList: offsets (I64)
+ * - FixedSizeList: none
+ */
+struct ArrayData
+{
+    SizeT                              length = 0;
+    std::vector<span<const std::byte>> buffers;
+    std::vector<ArrayData>             children;
+};
+
+/**
+ * @brief Keeps the generated buffers (offsets, repeated values...) alive until the batch is written.
+ */
+class BufferPool
+{
+  public:
+    template <typename T>
+    span<T> allocate(SizeT count)
+    {
+        auto& buffer = m_buffers.emplace_back(count * sizeof(T));
+        return span<T>{reinterpret_cast<T*>(buffer.data()), count};
+    }
+
+    void clear() { m_buffers.clear(); }
+
+  private:
+    struct alignas(8) Block
+    {
+        std::byte data[8];
+    };
+
+    struct Buffer
+    {
+        explicit Buffer(SizeT bytes)
+            : m_blocks((bytes + sizeof(Block) - 1) / sizeof(Block))
+        {
+        }
+        void*              data() { return m_blocks.data(); }
+        std::vector<Block> m_blocks;
+    };
+
+    std::deque<Buffer> m_buffers;
+};
+
+template <typename T>
+span<const std::byte> as_bytes(span<const T> s) noexcept
+{
+    return {reinterpret_cast<const std::byte*>(s.data()), s.size() * sizeof(T)};
+}
+
+class StreamWriter
+{
+  public:
+    explicit StreamWriter(const std::string& file);
+
+    bool is_open() const noexcept;
+
+    void write_schema(span<const Field> fields);
+    void write_record_batch(SizeT length, span<const ArrayData> columns);
+    /**
+     * @brief Write the end-of-stream marker and close the file.
+     */
+    void close();
+
+  private:
+    void write_message(const std::vector<std::byte>& metadata, span<const span<const std::byte>> body);
+
+    std::ofstream m_out;
+};
+}  // namespace uipc::geometry::arrow
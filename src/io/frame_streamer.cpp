@@ -0,0 +1,461 @@
+#include <uipc/io/frame_streamer.h>
+#include <uipc/io/scene_io.h>
+#include <uipc/geometry/utils/extract_surface.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/format.h>
+#include <uipc/common/log.h>
+#include <uipc/common/enumerate.h>
+#include "shared_memory.h"
+#include <Eigen/Geometry>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace uipc::core
+{
+/*
+ * The stream `<name>` is a directory segment holding the current generation,
+ * the surface of generation `g` lives in the segment `<name>.<g>`:
+ *
+ *   SegmentHeader | edges | triangles | slot 0 | slot 1 | ... | slot K-1
+ *
+ * A slot is a SlotHeader followed by the positions. The n-th published frame (n = 0, 1, ...) goes to the slot n % K,
+ * whose sequence is 2n+1 while the positions are being written, and 2n+2 once they are complete.
+ */
+namespace
+{
+    constexpr U64   DirectoryMagic = 0x5249445F43504955ull;  // "UIPC_DIR"
+    constexpr U64   SegmentMagic   = 0x4D52545F43504955ull;  // "UIPC_TRM"
+    constexpr SizeT Alignment      = 64;
+
+    static_assert(std::atomic<U64>::is_always_lock_free,
+                  "The frame stream needs lock free 64-bit atomics to work across processes.");
+
+    struct DirectoryHeader
+    {
+        U64              magic;
+        std::atomic<U64> generation;  // 0: no segment yet
+    };
+
+    struct SegmentHeader
+    {
+        U64              magic;
+        U64              generation;
+        U64              slot_count;
+        U64              vertex_count;
+        U64              edge_count;
+        U64              triangle_count;
+        U64              edges_offset;
+        U64              triangles_offset;
+        U64              slots_offset;
+        U64              slot_stride;
+        std::atomic<U64> published;  // the number of published frames
+    };
+
+    struct SlotHeader
+    {
+        std::atomic<U64> sequence;
+        std::atomic<U64> frame;
+    };
+
+    constexpr SizeT align(SizeT size)
+    {
+        return (size + Alignment - 1) / Alignment * Alignment;
+    }
+
+    std::string segment_name(std::string_view name, U64 generation)
+    {
+        return fmt::format("{}.{}", name, generation);
+    }
+
+    const SegmentHeader& segment_header(const SharedMemory& shm)
+    {
+        return *static_cast<const SegmentHeader*>(shm.data());
+    }
+
+    const SlotHeader& slot_header(const SharedMemory& shm, SizeT slot)
+    {
+        auto& header = segment_header(shm);
+        auto  base   = static_cast<const std::byte*>(shm.data());
+        return *reinterpret_cast<const SlotHeader*>(base + header.slots_offset
+                                                    + slot * header.slot_stride);
+    }
+
+    template <typename T>
+    span<const T> segment_span(const SharedMemory& shm, SizeT offset, SizeT count)
+    {
+        auto base = static_cast<const std::byte*>(shm.data());
+        return span<const T>{reinterpret_cast<const T*>(base + offset), count};
+    }
+}  // namespace
+
+// ----------------------------------------------------------------------------
+// FrameStreamer
+// ----------------------------------------------------------------------------
+class FrameStreamer::Impl
+{
+  public:
+    Impl(Scene& scene, std::string_view name, const Json& config)
+        : io{scene}
+        , name{name}
+        , slot_count{config["slot_count"].get<SizeT>()}
+        , dim{config["dim"].get<IndexT>()}
+    {
+        UIPC_ASSERT(slot_count >= 2, "The frame stream needs at least 2 slots, yours is {}.", slot_count);
+
+        directory = SharedMemory::create(name, sizeof(DirectoryHeader));
+        auto dir  = new(directory.data()) DirectoryHeader{};
+        dir->magic = DirectoryMagic;
+        dir->generation.store(0, std::memory_order_release);
+    }
+
+    // what the surface topology depends on
+    struct Source
+    {
+        const geometry::SimplicialComplex* geo;
+        SizeT                              vertex_count;
+        SizeT                              edge_count;
+        SizeT                              triangle_count;
+        SizeT                              instance_count;
+        // the modification times of the topologies and of `is_surf`, a rewired simplex keeps the counts
+        vector<geometry::TimePoint> topology_stamps;
+
+        bool operator==(const Source&) const = default;
+    };
+
+    static vector<geometry::TimePoint> topology_stamps(const geometry::SimplicialComplex& geo)
+    {
+        vector<geometry::TimePoint> stamps;
+        auto add = [&](auto&& slot)
+        { stamps.push_back(slot ? slot->last_modified() : geometry::TimePoint{}); };
+
+        add(geo.edges().find<Vector2i>(builtin::topo));
+        add(geo.triangles().find<Vector3i>(builtin::topo));
+        add(geo.tetrahedra().find<Vector4i>(builtin::topo));
+        add(geo.vertices().find<IndexT>(builtin::is_surf));
+        add(geo.edges().find<IndexT>(builtin::is_surf));
+        add(geo.triangles().find<IndexT>(builtin::is_surf));
+        return stamps;
+    }
+
+    // the surface vertices of an instance
+    struct Block
+    {
+        IndexT source;
+        IndexT instance;
+        SizeT  offset;
+    };
+
+    SceneIO     io;
+    std::string name;
+    SizeT       slot_count;
+    IndexT      dim;
+
+    SharedMemory directory;
+    SharedMemory segment;
+    U64          generation = 0;
+    U64          published  = 0;
+
+    vector<Source>         sources;
+    vector<vector<IndexT>> surf_vertices;  // per source, the surface vertices of a tetmesh, empty for the others
+    vector<Block>          blocks;
+
+    void rebuild(span<const geometry::SimplicialComplex*> inputs)
+    {
+        auto surface = geometry::extract_surface(inputs);
+
+        // the same order as extract_surface: geometries, then instances, then surface vertices
+        surf_vertices.assign(sources.size(), {});
+        blocks.clear();
+        SizeT offset = 0;
+        for(auto&& [I, source] : enumerate(sources))
+        {
+            SizeT count = source.vertex_count;
+            if(source.geo->dim() == 3)
+            {
+                auto is_surf = source.geo->vertices().find<IndexT>(builtin::is_surf);
+                UIPC_ASSERT(is_surf, "`is_surf` attribute not found in the mesh vertices.");
+                for(auto&& [v, surf] : enumerate(is_surf->view()))
+                    if(surf)
+                        surf_vertices[I].push_back(static_cast<IndexT>(v));
+                count = surf_vertices[I].size();
+            }
+
+            for(SizeT i = 0; i < source.instance_count; ++i)
+            {
+                blocks.push_back({static_cast<IndexT>(I), static_cast<IndexT>(i), offset});
+                offset += count;
+            }
+        }
+
+        UIPC_ASSERT(offset == surface.vertices().size(),
+                    "Surface vertex count mismatch, expected {}, extract_surface gives {}.",
+                    offset,
+                    surface.vertices().size());
+
+        SizeT V = surface.vertices().size();
+        SizeT E = surface.edges().size();
+        SizeT F = surface.triangles().size();
+
+        SizeT edges_offset     = align(sizeof(SegmentHeader));
+        SizeT triangles_offset = edges_offset + align(E * sizeof(Vector2i));
+        SizeT slots_offset     = triangles_offset + align(F * sizeof(Vector3i));
+        SizeT slot_stride      = align(sizeof(SlotHeader)) + align(V * sizeof(Vector3));
+        SizeT total            = slots_offset + slot_count * slot_stride;
+
+        auto next  = SharedMemory::create(segment_name(name, generation + 1), total);
+        auto base  = static_cast<std::byte*>(next.data());
+        auto header = new(base) SegmentHeader{};
+
+        header->magic            = SegmentMagic;
+        header->generation       = generation + 1;
+        header->slot_count       = slot_count;
+        header->vertex_count     = V;
+        header->edge_count       = E;
+        header->triangle_count   = F;
+        header->edges_offset     = edges_offset;
+        header->triangles_offset = triangles_offset;
+        header->slots_offset     = slots_offset;
+        header->slot_stride      = slot_stride;
+        header->published.store(0, std::memory_order_relaxed);
+
+        if(E)
+            std::memcpy(base + edges_offset, surface.edges().topo().view().data(), E * sizeof(Vector2i));
+        if(F)
+            std::memcpy(base + triangles_offset,
+                        surface.triangles().topo().view().data(),
+                        F * sizeof(Vector3i));
+
+        for(SizeT s = 0; s < slot_count; ++s)
+        {
+            auto slot = new(base + slots_offset + s * slot_stride) SlotHeader{};
+            slot->sequence.store(0, std::memory_order_relaxed);
+            slot->frame.store(0, std::memory_order_relaxed);
+        }
+
+        // publish the new segment, the old one is removed, the readers keep their mappings
+        segment = std::move(next);
+        ++generation;
+        published = 0;
+        static_cast<DirectoryHeader*>(directory.data())->generation.store(generation, std::memory_order_release);
+    }
+
+    void publish(SizeT frame)
+    {
+        auto inputs = io.surface_inputs(dim);
+
+        vector<Source> current(inputs.size());
+        std::ranges::transform(inputs,
+                               current.begin(),
+                               [](const geometry::SimplicialComplex* geo)
+                               {
+                                   return Source{geo,
+                                                 geo->vertices().size(),
+                                                 geo->edges().size(),
+                                                 geo->triangles().size(),
+                                                 geo->instances().size(),
+                                                 topology_stamps(*geo)};
+                               });
+
+        if(generation == 0 || !std::ranges::equal(current, sources))
+        {
+            sources = std::move(current);
+            rebuild(inputs);
+        }
+
+        auto  base   = static_cast<std::byte*>(segment.data());
+        auto& header = *static_cast<SegmentHeader*>(segment.data());
+        auto  slot_base = base + header.slots_offset + (published % slot_count) * header.slot_stride;
+        auto& slot      = *reinterpret_cast<SlotHeader*>(slot_base);
+        auto  positions = reinterpret_cast<Vector3*>(slot_base + align(sizeof(SlotHeader)));
+
+        slot.sequence.store(2 * published + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        parallel_for(0,
+                     blocks.size(),
+                     [&](SizeT b)
+                     {
+                         auto& block  = blocks[b];
+                         auto& source = sources[block.source];
+                         auto  Ps     = source.geo->positions().view();
+                         auto  T = Transform{source.geo->transforms().view()[block.instance]};
+                         auto  dst    = positions + block.offset;
+
+                         auto& vs = surf_vertices[block.source];
+                         if(vs.empty() && source.geo->dim() != 3)
+                         {
+                             for(SizeT v = 0; v < Ps.size(); ++v)
+                                 dst[v] = T * Ps[v];
+                         }
+                         else
+                         {
+                             for(SizeT v = 0; v < vs.size(); ++v)
+                                 dst[v] = T * Ps[vs[v]];
+                         }
+                     },
+                     1);
+
+        slot.frame.store(frame, std::memory_order_relaxed);
+        slot.sequence.store(2 * published + 2, std::memory_order_release);
+        header.published.store(published + 1, std::memory_order_release);
+        ++published;
+    }
+};
+
+Json FrameStreamer::default_config()
+{
+    Json config;
+    config["slot_count"] = 4;
+    config["dim"]        = -1;
+    return config;
+}
+
+FrameStreamer::FrameStreamer(Scene& scene, std::string_view name, const Json& config)
+    : m_impl{uipc::make_unique<Impl>(scene, name, config)}
+{
+}
+
+FrameStreamer::~FrameStreamer() = default;
+
+void FrameStreamer::publish(SizeT frame)
+{
+    m_impl->publish(frame);
+}
+
+U64 FrameStreamer::generation() const noexcept
+{
+    return m_impl->generation;
+}
+
+std::string_view FrameStreamer::name() const noexcept
+{
+    return m_impl->name;
+}
+
+// ----------------------------------------------------------------------------
+// FrameStreamReader
+// ----------------------------------------------------------------------------
+class FrameStreamReader::Segment
+{
+  public:
+    SharedMemory shm;
+};
+
+class FrameStreamReader::Impl
+{
+  public:
+    Impl(std::string_view name)
+        : name{name}
+        , directory{SharedMemory::open(name)}
+    {
+        if(directory.size() < sizeof(DirectoryHeader)
+           || static_cast<const DirectoryHeader*>(directory.data())->magic != DirectoryMagic)
+            throw FrameStreamError{fmt::format("[{}] is not a frame stream.", name)};
+    }
+
+    std::string          name;
+    SharedMemory         directory;
+    S<const Segment>     segment;
+
+    std::optional<Frame> latest()
+    {
+        auto& dir        = *static_cast<const DirectoryHeader*>(directory.data());
+        U64   generation = dir.generation.load(std::memory_order_acquire);
+        if(generation == 0)
+            return std::nullopt;
+
+        if(!segment || segment_header(segment->shm).generation != generation)
+        {
+            try
+            {
+                auto next = uipc::make_shared<Segment>();
+                next->shm = SharedMemory::open(segment_name(name, generation));
+                segment   = next;
+            }
+            catch(const FrameStreamError&)
+            {
+                // the writer moved on (or stopped) in between, try next time
+                return std::nullopt;
+            }
+        }
+
+        auto& header = segment_header(segment->shm);
+        UIPC_ASSERT(header.magic == SegmentMagic, "[{}] is not a frame stream segment.", name);
+
+        // the writer may overwrite the slot while we look at it, retry with the newer frame
+        for(int retry = 0; retry < 8; ++retry)
+        {
+            U64 published = header.published.load(std::memory_order_acquire);
+            if(published == 0)
+                return std::nullopt;
+
+            U64   n    = published - 1;
+            SizeT slot = n % header.slot_count;
+            auto& s    = slot_header(segment->shm, slot);
+            if(s.sequence.load(std::memory_order_acquire) != 2 * n + 2)
+                continue;
+
+            Frame frame;
+            frame.m_segment  = segment;
+            frame.m_slot     = slot;
+            frame.m_sequence = 2 * n + 2;
+            frame.m_frame    = s.frame.load(std::memory_order_relaxed);
+            if(!frame.is_valid())
+                continue;
+            return frame;
+        }
+        return std::nullopt;
+    }
+};
+
+FrameStreamReader::FrameStreamReader(std::string_view name)
+    : m_impl{uipc::make_unique<Impl>(name)}
+{
+}
+
+FrameStreamReader::~FrameStreamReader() = default;
+
+std::optional<FrameStreamReader::Frame> FrameStreamReader::latest()
+{
+    return m_impl->latest();
+}
+
+SizeT FrameStreamReader::Frame::frame() const noexcept
+{
+    return m_frame;
+}
+
+U64 FrameStreamReader::Frame::generation() const noexcept
+{
+    return segment_header(m_segment->shm).generation;
+}
+
+span<const Vector3> FrameStreamReader::Frame::positions() const noexcept
+{
+    auto& header = segment_header(m_segment->shm);
+    return segment_span<Vector3>(m_segment->shm,
+                                 header.slots_offset + m_slot * header.slot_stride
+                                     + align(sizeof(SlotHeader)),
+                                 header.vertex_count);
+}
+
+span<const Vector2i> FrameStreamReader::Frame::edges() const noexcept
+{
+    auto& header = segment_header(m_segment->shm);
+    return segment_span<Vector2i>(m_segment->shm, header.edges_offset, header.edge_count);
+}
+
+span<const Vector3i> FrameStreamReader::Frame::triangles() const noexcept
+{
+    auto& header = segment_header(m_segment->shm);
+    return segment_span<Vector3i>(m_segment->shm, header.triangles_offset, header.triangle_count);
+}
+
+bool FrameStreamReader::Frame::is_valid() const noexcept
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot_header(m_segment->shm, m_slot).sequence.load(std::memory_order_relaxed) == m_sequence;
+}
+}  // namespace uipc::core
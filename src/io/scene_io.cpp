@@ -133,6 +133,12 @@ void SceneIO::write_surface(std::string_view filename)
 }
 
 geometry::SimplicialComplex SceneIO::simplicial_surface(IndexT dim) const
+{
+    auto inputs = surface_inputs(dim);
+    return geometry::extract_surface(inputs);
+}
+
+vector<const geometry::SimplicialComplex*> SceneIO::surface_inputs(IndexT dim) const
 {
     using namespace uipc::geometry;
 
@@ -159,104 +165,90 @@ geometry::SimplicialComplex SceneIO::simplicial_surface(IndexT dim) const
             break;
     }
 
-    return extract_surface(simplicial_complex_has_surf);
+    return simplicial_complex_has_surf;
 }
 
-void SceneIO::save(const Scene& scene, std::string_view filename)
+void SceneIO::save(const Scene& scene, std::string_view filename, const Json& config)
 {
     fs::path path{filename};
     path = fs::absolute(path);
 
     auto ext = path.extension();
 
-    SceneFactory sf;
-    auto         scene_json = sf.to_json(scene);
-
+    JsonFormat format;
     if(ext == ".json")
-    {
-        fs::exists(path.parent_path()) || fs::create_directories(path.parent_path());
-        std::ofstream file(path.string());
-        if(file)
-        {
-            file << scene_json.dump(4);
-        }
-        else
-        {
-            throw SceneIOError(fmt::format("Failed to open file {} for writing.",
-                                           path.string()));
-        }
-    }
+        format = JsonFormat::Json;
     else if(ext == ".bson")
+        format = JsonFormat::Bson;
+    else
+        throw SceneIOError(fmt::format("Unsupported file format when writing {}.", filename));
+
+    fs::exists(path.parent_path()) || fs::create_directories(path.parent_path());
+
+    // write to a temporary file first, a lazily loaded scene may still read from `path`
+    fs::path tmp_path = path;
+    tmp_path += ".tmp";
     {
-        fs::exists(path.parent_path()) || fs::create_directories(path.parent_path());
-        std::vector<std::uint8_t> v = Json::to_bson(scene_json);
-        std::ofstream             file(path, std::ios::binary);
-        if(file)
-        {
-            file.write(reinterpret_cast<const char*>(v.data()), v.size());
-        }
-        else
+        std::ofstream file(tmp_path, std::ios::binary);
+        if(!file)
         {
             throw SceneIOError(fmt::format("Failed to open file {} for writing.",
-                                           path.string()));
+                                           tmp_path.string()));
         }
+
+        // stream the scene, the whole json is never built
+        SceneFactory sf{config};
+        sf.to_stream(scene, file, format, format == JsonFormat::Json ? 4 : -1);
     }
-    else
+
+    // a lazily loaded scene keeps `path` open, which can't be replaced on Windows
+    SceneFactory::release_lazy_file(path.string());
+
+    std::error_code ec;
+    fs::rename(tmp_path, path, ec);
+    if(ec)
     {
-        throw SceneIOError(fmt::format("Unsupported file format when writing {}.", filename));
+        fs::remove(tmp_path, ec);
+        throw SceneIOError(fmt::format("Failed to write file {}.", path.string()));
     }
 }
 
-void SceneIO::save(std::string_view filename) const
+void SceneIO::save(std::string_view filename, const Json& config) const
 {
-    save(m_scene, filename);
+    save(m_scene, filename, config);
 }
 
-Scene SceneIO::load(std::string_view filename)
+Scene SceneIO::load(std::string_view filename, bool lazy)
 {
     fs::path path{filename};
     path = fs::absolute(path);
 
     auto ext = path.extension();
 
-    SceneFactory sf;
+    JsonFormat format;
     if(ext == ".json")
-    {
-        std::ifstream file(path.string());
-        if(file)
-        {
-            Json scene_json;
-            file >> scene_json;
-            return sf.from_snapshot(sf.from_json(scene_json));
-        }
-        else
-        {
-            throw SceneIOError(fmt::format("Failed to open file {} for reading.",
-                                           path.string()));
-        }
-    }
+        format = JsonFormat::Json;
     else if(ext == ".bson")
+        format = JsonFormat::Bson;
+    else
+        throw SceneIOError(fmt::format("Unsupported file format when loading {}.", filename));
+
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
     {
-        std::ifstream file(path, std::ios::binary);
-        if(file)
-        {
-            std::vector<std::uint8_t> v((std::istreambuf_iterator<char>(file)),
-                                        std::istreambuf_iterator<char>());
-            Json                      scene_json = Json::from_bson(v);
-            return sf.from_snapshot(sf.from_json(scene_json));
-        }
-        else
-        {
-            throw SceneIOError(fmt::format("Failed to open file {} for reading.",
-                                           path.string()));
-        }
+        throw SceneIOError(fmt::format("Failed to open file {} for reading.", path.string()));
     }
-    else
+
+    SceneFactory sf;
+    if(lazy)
     {
-        throw SceneIOError(fmt::format("Unsupported file format when loading {}.", filename));
+        // the attribute values are left in the file until the geometries are accessed
+        file.close();
+        return sf.from_snapshot(sf.lazy_from_file(path.string(), format));
     }
 
-    return Scene{};
+    // the attribute values are decoded into the attributes directly
+    return sf.from_snapshot(sf.from_stream(file, format));
 }
 
 void SceneIO::commit(const SceneSnapshot& last, std::string_view filename)
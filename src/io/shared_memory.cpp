@@ -0,0 +1,184 @@
+#include "shared_memory.h"
+#include <uipc/io/frame_streamer.h>
+#include <uipc/common/format.h>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uipc::core
+{
+#ifdef _WIN32
+static std::string system_name(std::string_view name)
+{
+    return std::string{name};
+}
+
+static std::string last_error()
+{
+    return fmt::format("error code {}", ::GetLastError());
+}
+
+SharedMemory SharedMemory::create(std::string_view name, SizeT size)
+{
+    SharedMemory shm;
+    shm.m_name   = system_name(name);
+    shm.m_handle = ::CreateFileMappingA(INVALID_HANDLE_VALUE,
+                                        nullptr,
+                                        PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<U64>(size) >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFFull),
+                                        shm.m_name.c_str());
+    if(!shm.m_handle)
+        throw FrameStreamError{fmt::format("Failed to create shared memory [{}], {}.", name, last_error())};
+    if(::GetLastError() == ERROR_ALREADY_EXISTS)
+        throw FrameStreamError{fmt::format("Shared memory [{}] is already in use.", name)};
+
+    shm.m_data = ::MapViewOfFile(shm.m_handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if(!shm.m_data)
+        throw FrameStreamError{fmt::format("Failed to map shared memory [{}], {}.", name, last_error())};
+    shm.m_size  = size;
+    shm.m_owner = true;
+    return shm;
+}
+
+SharedMemory SharedMemory::open(std::string_view name)
+{
+    SharedMemory shm;
+    shm.m_name   = system_name(name);
+    shm.m_handle = ::OpenFileMappingA(FILE_MAP_READ, FALSE, shm.m_name.c_str());
+    if(!shm.m_handle)
+        throw FrameStreamError{fmt::format("Failed to open shared memory [{}], {}.", name, last_error())};
+
+    shm.m_data = ::MapViewOfFile(shm.m_handle, FILE_MAP_READ, 0, 0, 0);
+    if(!shm.m_data)
+        throw FrameStreamError{fmt::format("Failed to map shared memory [{}], {}.", name, last_error())};
+
+    MEMORY_BASIC_INFORMATION info;
+    ::VirtualQuery(shm.m_data, &info, sizeof(info));
+    shm.m_size = info.RegionSize;
+    return shm;
+}
+
+void SharedMemory::release() noexcept
+{
+    if(m_data)
+        ::UnmapViewOfFile(m_data);
+    if(m_handle)
+        ::CloseHandle(m_handle);
+    m_data   = nullptr;
+    m_handle = nullptr;
+}
+#else
+static std::string system_name(std::string_view name)
+{
+    // POSIX shared memory names start with a single slash
+    return name.starts_with('/') ? std::string{name} : fmt::format("/{}", name);
+}
+
+static std::string last_error()
+{
+    return std::strerror(errno);
+}
+
+SharedMemory SharedMemory::create(std::string_view name, SizeT size)
+{
+    SharedMemory shm;
+    shm.m_name = system_name(name);
+
+    // never take over a name in use, it may belong to another writer
+    int fd = ::shm_open(shm.m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(fd < 0 && errno == EEXIST)
+        throw FrameStreamError{fmt::format("Shared memory [{}] is already in use.", name)};
+    if(fd < 0)
+        throw FrameStreamError{fmt::format("Failed to create shared memory [{}], {}.", name, last_error())};
+    shm.m_owner = true;
+
+    if(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        auto error = last_error();
+        ::close(fd);
+        throw FrameStreamError{fmt::format("Failed to resize shared memory [{}] to {} bytes, {}.", name, size, error)};
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED)
+        throw FrameStreamError{fmt::format("Failed to map shared memory [{}], {}.", name, last_error())};
+
+    shm.m_data = data;
+    shm.m_size = size;
+    return shm;
+}
+
+SharedMemory SharedMemory::open(std::string_view name)
+{
+    SharedMemory shm;
+    shm.m_name = system_name(name);
+
+    int fd = ::shm_open(shm.m_name.c_str(), O_RDONLY, 0);
+    if(fd < 0)
+        throw FrameStreamError{fmt::format("Failed to open shared memory [{}], {}.", name, last_error())};
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        throw FrameStreamError{fmt::format("Shared memory [{}] is empty.", name)};
+    }
+
+    void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED)
+        throw FrameStreamError{fmt::format("Failed to map shared memory [{}], {}.", name, last_error())};
+
+    shm.m_data = data;
+    shm.m_size = st.st_size;
+    return shm;
+}
+
+void SharedMemory::release() noexcept
+{
+    if(m_data)
+        ::munmap(m_data, m_size);
+    if(m_owner)
+        ::shm_unlink(m_name.c_str());
+    m_data  = nullptr;
+    m_owner = false;
+}
+#endif
+
+SharedMemory::SharedMemory(SharedMemory&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    release();
+    m_name  = std::move(other.m_name);
+    m_data  = std::exchange(other.m_data, nullptr);
+    m_size  = std::exchange(other.m_size, 0);
+    m_owner = std::exchange(other.m_owner, false);
+#ifdef _WIN32
+    m_handle = std::exchange(other.m_handle, nullptr);
+#endif
+    return *this;
+}
+
+SharedMemory::~SharedMemory()
+{
+    release();
+}
+}  // namespace uipc::core
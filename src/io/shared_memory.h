@@ -0,0 +1,39 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <string>
+#include <string_view>
+
+namespace uipc::core
+{
+/**
+ * @brief A named shared memory segment.
+ *
+ * The creator maps it read-write and removes the name on destruction, the others map it read-only.
+ * Errors are reported as `FrameStreamError`.
+ */
+class SharedMemory
+{
+  public:
+    static SharedMemory create(std::string_view name, SizeT size);
+    static SharedMemory open(std::string_view name);
+
+    SharedMemory() = default;
+    SharedMemory(SharedMemory&& other) noexcept;
+    SharedMemory& operator=(SharedMemory&& other) noexcept;
+    ~SharedMemory();
+
+    void* data() const noexcept { return m_data; }
+    SizeT size() const noexcept { return m_size; }
+
+  private:
+    std::string m_name;
+    void*       m_data  = nullptr;
+    SizeT       m_size  = 0;
+    bool        m_owner = false;
+#ifdef _WIN32
+    void* m_handle = nullptr;
+#endif
+
+    void release() noexcept;
+};
+}  // namespace uipc::core
@@ -2,9 +2,26 @@
 #include <filesystem>
 #include <fstream>
 #include <uipc/common/enumerate.h>
+#include <uipc/common/map.h>
+#include <uipc/common/log.h>
+#include <uipc/geometry/geometry_friend.h>
+#include <uipc/builtin/attribute_name.h>
+#include "arrow_ipc.h"
 
 namespace uipc::geometry
 {
+template <>
+class GeometryFriend<SpreadSheetStream>
+{
+  public:
+    static void attribute_collections(const Geometry&      geometry,
+                                      vector<std::string>& names,
+                                      vector<const AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+};
+
 namespace fs = std::filesystem;
 
 SpreadSheetIO::SpreadSheetIO(std::string_view output_folder)
@@ -126,4 +143,294 @@ void SpreadSheetIO::write_csv(const Geometry& geo) const
 {
     write_csv("spreadsheet", geo);
 }
+void SpreadSheetIO::write_arrow(std::string_view geo_name, const Geometry& geo) const
+{
+    SpreadSheetStream stream{m_output_folder, geo_name};
+    stream.append(geo, 0);
+    stream.close();
+}
+
+void SpreadSheetIO::write_arrow(const Geometry& geo) const
+{
+    write_arrow("spreadsheet", geo);
+}
+
+namespace detail
+{
+    template <typename T>
+    arrow::DataType arrow_scalar_type()
+    {
+        if constexpr(std::is_floating_point_v<T>)
+        {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+            return {.id = arrow::TypeId::FloatingPoint, .precision = sizeof(T) == 4 ? int16_t{1} : int16_t{2}};
+        }
+        else
+        {
+            static_assert(std::is_integral_v<T>);
+            return {.id        = arrow::TypeId::Int,
+                    .bit_width = static_cast<I32>(sizeof(T) * 8),
+                    .is_signed = std::is_signed_v<T>};
+        }
+    }
+
+    template <typename T>
+    bool encode_typed_column(const AttributeSlot<T>& slot,
+                             arrow::Field&           field,
+                             arrow::ArrayData&       array,
+                             arrow::BufferPool&      pool)
+    {
+        auto values = slot.view();
+
+        field.name   = slot.name();
+        array.length = values.size();
+
+        if constexpr(std::is_arithmetic_v<T>)
+        {
+            field.type = arrow_scalar_type<T>();
+            array.buffers.push_back(arrow::as_bytes(values));
+        }
+        else if constexpr(std::is_same_v<T, std::string>)
+        {
+            field.type = {.id = arrow::TypeId::LargeUtf8};
+
+            SizeT total = 0;
+            for(auto& v : values)
+                total += v.size();
+
+            auto offsets = pool.allocate<I64>(values.size() + 1);
+            auto data    = pool.allocate<char>(total);
+
+            offsets[0] = 0;
+            for(auto&& [i, v] : enumerate(values))
+            {
+                std::ranges::copy(v, data.begin() + offsets[i]);
+                offsets[i + 1] = offsets[i] + static_cast<I64>(v.size());
+            }
+
+            array.buffers.push_back(arrow::as_bytes(span<const I64>{offsets}));
+            array.buffers.push_back(arrow::as_bytes(span<const char>{data}));
+        }
+        else if constexpr(requires { T::SizeAtCompileTime; })
+        {
+            using Scalar = typename T::Scalar;
+
+            arrow::Field item{.name = "item", .type = arrow_scalar_type<Scalar>(), .children = {}};
+            arrow::ArrayData items;
+
+            if constexpr(T::SizeAtCompileTime != Eigen::Dynamic)
+            {
+                // fixed size vector/matrix, values are stored contiguously (column-major)
+                static_assert(sizeof(T) == sizeof(Scalar) * T::SizeAtCompileTime);
+
+                field.type = {.id = arrow::TypeId::FixedSizeList, .list_size = T::SizeAtCompileTime};
+
+                items.length = values.size() * T::SizeAtCompileTime;
+                items.buffers.push_back(arrow::as_bytes(span<const Scalar>{
+                    reinterpret_cast<const Scalar*>(values.data()), items.length}));
+            }
+            else
+            {
+                field.type = {.id = arrow::TypeId::LargeList};
+
+                SizeT total = 0;
+                for(auto& v : values)
+                    total += v.size();
+
+                auto offsets = pool.allocate<I64>(values.size() + 1);
+                auto data    = pool.allocate<Scalar>(total);
+
+                offsets[0] = 0;
+                for(auto&& [i, v] : enumerate(values))
+                {
+                    std::copy_n(v.data(), v.size(), data.begin() + offsets[i]);
+                    offsets[i + 1] = offsets[i] + static_cast<I64>(v.size());
+                }
+
+                array.buffers.push_back(arrow::as_bytes(span<const I64>{offsets}));
+
+                items.length = total;
+                items.buffers.push_back(arrow::as_bytes(span<const Scalar>{data}));
+            }
+
+            field.children.push_back(std::move(item));
+            array.children.push_back(std::move(items));
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Dispatch the slot to the typed encoder, return false if the type is not supported.
+    bool encode_column(const IAttributeSlot& slot,
+                       arrow::Field&         field,
+                       arrow::ArrayData&     array,
+                       arrow::BufferPool&    pool)
+    {
+#define UIPC_ATTRIBUTE_EXPORT_DEF(T)                                           \
+    if(auto typed = dynamic_cast<const AttributeSlot<T>*>(&slot))              \
+        return encode_typed_column(*typed, field, array, pool)
+
+#include <uipc/geometry/details/attribute_export_types.inl>
+
+#undef UIPC_ATTRIBUTE_EXPORT_DEF
+
+        return false;
+    }
+
+    bool same_type(const arrow::Field& a, const arrow::Field& b)
+    {
+        auto& l = a.type;
+        auto& r = b.type;
+        if(a.name != b.name || l.id != r.id || l.bit_width != r.bit_width
+           || l.is_signed != r.is_signed || l.precision != r.precision
+           || l.list_size != r.list_size || a.children.size() != b.children.size())
+            return false;
+
+        for(SizeT i = 0; i < a.children.size(); ++i)
+            if(!same_type(a.children[i], b.children[i]))
+                return false;
+
+        return true;
+    }
+}  // namespace detail
+
+class SpreadSheetStream::Impl
+{
+  public:
+    Impl(std::string_view output_folder, std::string_view geo_name)
+        : m_folder(fs::path(output_folder) / fmt::format("{}", geo_name))
+    {
+        fs::exists(m_folder) || fs::create_directories(m_folder);
+    }
+
+    void append(const Geometry& geo, SizeT frame)
+    {
+        vector<std::string>                names;
+        vector<const AttributeCollection*> collections;
+        GeometryFriend<SpreadSheetStream>::attribute_collections(geo, names, collections);
+
+        for(auto&& [i, name] : enumerate(names))
+            append(name, *collections[i], frame);
+    }
+
+    void close()
+    {
+        for(auto& [name, stream] : m_streams)
+            stream.writer->close();
+        m_streams.clear();
+    }
+
+  private:
+    struct Stream
+    {
+        U<arrow::StreamWriter> writer;
+        vector<arrow::Field>   schema;
+    };
+
+    void append(const std::string& name, const AttributeCollection& ac, SizeT frame)
+    {
+        arrow::BufferPool pool;
+
+        vector<arrow::Field>     fields;
+        vector<arrow::ArrayData> columns;
+
+        auto rows = ac.size();
+
+        {  // the frame column
+            auto& field = fields.emplace_back();
+            field.name  = "frame";
+            field.type  = detail::arrow_scalar_type<U64>();
+
+            auto  frames = pool.allocate<U64>(rows);
+            std::ranges::fill(frames, frame);
+            auto& array  = columns.emplace_back();
+            array.length = rows;
+            array.buffers.push_back(arrow::as_bytes(span<const U64>{frames}));
+        }
+
+        // keep the column order stable, topo goes first
+        auto attr_names = ac.names();
+        std::ranges::sort(attr_names,
+                          [](const string& a, const string& b)
+                          {
+                              bool a_topo = a == builtin::topo;
+                              bool b_topo = b == builtin::topo;
+                              return a_topo != b_topo ? a_topo : a < b;
+                          });
+
+        for(auto& attr_name : attr_names)
+        {
+            auto slot = ac.find(attr_name);
+
+            arrow::Field     field;
+            arrow::ArrayData array;
+            if(!detail::encode_column(*slot, field, array, pool))
+            {
+                UIPC_WARN_WITH_LOCATION("Attribute [{}] <{}> is not supported by the arrow spreadsheet, skip.",
+                                        attr_name,
+                                        slot->type_name());
+                continue;
+            }
+            fields.push_back(std::move(field));
+            columns.push_back(std::move(array));
+        }
+
+        auto it = m_streams.find(name);
+        if(it == m_streams.end())
+        {
+            auto file = (m_folder / fmt::format("{}.arrows", name)).string();
+
+            Stream stream;
+            stream.writer = uipc::make_unique<arrow::StreamWriter>(file);
+            if(!stream.writer->is_open())
+                throw SpreadSheetIOError{fmt::format("Failed to open file [{}].", file)};
+            stream.writer->write_schema(fields);
+            stream.schema = fields;
+
+            it = m_streams.emplace(name, std::move(stream)).first;
+        }
+        else
+        {
+            auto& schema = it->second.schema;
+            bool  same   = schema.size() == fields.size();
+            for(SizeT i = 0; same && i < fields.size(); ++i)
+                same = detail::same_type(schema[i], fields[i]);
+
+            if(!same)
+                throw SpreadSheetIOError{fmt::format(
+                    "The attributes of [{}] changed at frame {}, the spreadsheet stream requires a fixed schema.",
+                    name,
+                    frame)};
+        }
+
+        it->second.writer->write_record_batch(rows, columns);
+    }
+
+    fs::path            m_folder;
+    map<string, Stream> m_streams;
+};
+
+SpreadSheetStream::SpreadSheetStream(std::string_view output_folder, std::string_view geo_name)
+    : m_impl(uipc::make_unique<Impl>(output_folder, geo_name))
+{
+}
+
+SpreadSheetStream::~SpreadSheetStream()
+{
+    m_impl->close();
+}
+
+void SpreadSheetStream::append(const Geometry& geo, SizeT frame)
+{
+    m_impl->append(geo, frame);
+}
+
+void SpreadSheetStream::close()
+{
+    m_impl->close();
+}
 }  // namespace uipc::geometry
@@ -0,0 +1,499 @@
+#include <uipc/io/urdf_io.h>
+#include <uipc/io/simplicial_complex_io.h>
+#include <uipc/geometry/utils/factory.h>
+#include <uipc/geometry/utils/merge.h>
+#include <uipc/geometry/utils/label_surface.h>
+#include <uipc/constitution/affine_body_constitution.h>
+#include <uipc/constitution/affine_body_revolute_joint.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/unit.h>
+#include <uipc/common/format.h>
+#include <uipc/common/log.h>
+#include <uipc/common/map.h>
+#include <uipc/common/enumerate.h>
+#include <urdf_parser/urdf_parser.h>
+#include <Eigen/Geometry>
+#include <filesystem>
+
+namespace uipc::core
+{
+namespace fs = std::filesystem;
+using namespace uipc::geometry;
+
+namespace
+{
+    Transform to_transform(const urdf::Pose& pose)
+    {
+        Transform t = Transform::Identity();
+        t.translate(Vector3{pose.position.x, pose.position.y, pose.position.z});
+        t.rotate(Eigen::Quaternion<Float>{
+            pose.rotation.w, pose.rotation.x, pose.rotation.y, pose.rotation.z});
+        return t;
+    }
+
+    SimplicialComplex box(const Vector3& size)
+    {
+        vector<Vector3> Vs(8);
+        for(IndexT i = 0; i < 8; ++i)
+        {
+            Vector3 sign{i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0};
+            Vs[i] = 0.5 * sign.cwiseProduct(size);
+        }
+        // outward oriented
+        vector<Vector3i> Fs = {{0, 4, 6},
+                               {0, 6, 2},
+                               {1, 3, 7},
+                               {1, 7, 5},
+                               {0, 1, 5},
+                               {0, 5, 4},
+                               {2, 6, 7},
+                               {2, 7, 3},
+                               {0, 2, 3},
+                               {0, 3, 1},
+                               {4, 5, 7},
+                               {4, 7, 6}};
+        return trimesh(Vs, Fs);
+    }
+}  // namespace
+
+class UrdfIO::Impl
+{
+  public:
+    // a body is a link with the links attached to it by fixed joints
+    struct Body
+    {
+        string               name;
+        S<SimplicialComplex> mesh;  // nullptr if the body has no shape
+        // the body frame in the robot frame
+        Matrix4x4 transform = Matrix4x4::Identity();
+        bool      jointed   = false;
+    };
+
+    struct Joint
+    {
+        IndexT  parent_body;
+        IndexT  child_body;
+        Vector3 P0;
+        Vector3 P1;
+    };
+
+    struct RobotTemplate
+    {
+        string        name;
+        vector<Body>  bodies;
+        vector<Joint> joints;
+        // the body fixed by `fixed_base`, the first body with a shape, -1 if no body has a shape
+        IndexT base = -1;
+    };
+
+    Impl(Scene& scene, const Json& config)
+        : scene{scene}
+        , config(UrdfIO::default_config())
+    {
+        // the missing keys take the default values
+        this->config.merge_patch(config);
+    }
+
+    Scene& scene;
+    Json   config;
+
+    // key: resolved path (or primitive) + scale
+    map<string, SimplicialComplex> meshes;
+    // key: canonical URDF path
+    map<string, S<RobotTemplate>> robots;
+
+    fs::path resolve(std::string_view uri, const fs::path& urdf_dir) const
+    {
+        constexpr std::string_view package = "package://";
+        constexpr std::string_view file     = "file://";
+
+        if(uri.starts_with(file))
+            return fs::path{uri.substr(file.size())};
+
+        if(!uri.starts_with(package))
+        {
+            fs::path p{uri};
+            return p.is_absolute() ? p : urdf_dir / p;
+        }
+
+        // package://<package>/<path>
+        fs::path rest{uri.substr(package.size())};
+        fs::path in_package;
+        for(auto it = std::next(rest.begin()); it != rest.end(); ++it)
+            in_package /= *it;
+
+        for(auto& dir : config["package_dirs"])
+        {
+            fs::path p = fs::path{dir.get<std::string>()} / rest;
+            if(fs::exists(p))
+                return p;
+        }
+
+        // the URDF file usually lives in the package, search its ancestors
+        for(fs::path dir = urdf_dir; !dir.empty(); dir = dir.parent_path())
+        {
+            if(fs::exists(dir / rest))
+                return dir / rest;
+            if(fs::exists(dir / in_package))
+                return dir / in_package;
+            if(dir == dir.parent_path())
+                break;
+        }
+
+        throw UrdfIOError{fmt::format("Can't find [{}], searched `package_dirs` and the ancestors of [{}].",
+                                      uri,
+                                      urdf_dir.string())};
+    }
+
+    const SimplicialComplex* load_shape(const urdf::Geometry& geo, const fs::path& urdf_dir)
+    {
+        string key;
+        switch(geo.type)
+        {
+            case urdf::Geometry::MESH: {
+                auto& mesh = static_cast<const urdf::Mesh&>(geo);
+                auto  path = fs::weakly_canonical(resolve(mesh.filename, urdf_dir));
+                key = fmt::format("{}:{},{},{}", path.string(), mesh.scale.x, mesh.scale.y, mesh.scale.z);
+
+                auto it = meshes.find(key);
+                if(it != meshes.end())
+                    return &it->second;
+
+                Transform scale = Transform::Identity();
+                scale.scale(Vector3{mesh.scale.x, mesh.scale.y, mesh.scale.z});
+                SimplicialComplexIO io{scale};
+                return &meshes.emplace(key, io.read(path.string())).first->second;
+            }
+            case urdf::Geometry::BOX: {
+                auto& b = static_cast<const urdf::Box&>(geo);
+                key     = fmt::format("box:{},{},{}", b.dim.x, b.dim.y, b.dim.z);
+
+                auto it = meshes.find(key);
+                if(it != meshes.end())
+                    return &it->second;
+                return &meshes.emplace(key, box(Vector3{b.dim.x, b.dim.y, b.dim.z}))
+                            .first->second;
+            }
+            default:
+                UIPC_WARN_WITH_LOCATION("URDF sphere and cylinder shapes are not supported, ignored.");
+                return nullptr;
+        }
+    }
+
+    S<RobotTemplate> parse(const fs::path& file)
+    {
+        auto model = urdf::parseURDFFile(file.string());
+        if(!model)
+            throw UrdfIOError{fmt::format("Failed to parse URDF file [{}].", file.string())};
+
+        auto robot  = uipc::make_shared<RobotTemplate>();
+        robot->name = model->getName();
+
+        const fs::path urdf_dir      = file.parent_path();
+        const bool     use_collision = config["use_collision"].get<bool>();
+
+        struct Shape
+        {
+            const SimplicialComplex* mesh;
+            Matrix4x4                transform;  // in the robot frame
+        };
+
+        vector<vector<Shape>> body_shapes;
+        vector<Transform>     body_frames;
+
+        auto collect_shapes = [&](const urdf::Link& link, const Transform& frame, IndexT body)
+        {
+            auto add = [&](const urdf::GeometrySharedPtr& geo, const urdf::Pose& origin)
+            {
+                if(!geo)
+                    return;
+                if(auto mesh = load_shape(*geo, urdf_dir))
+                    body_shapes[body].push_back({mesh, (frame * to_transform(origin)).matrix()});
+            };
+
+            bool has_collision = !link.collision_array.empty();
+            if((use_collision && has_collision) || link.visual_array.empty())
+            {
+                for(auto& c : link.collision_array)
+                    add(c->geometry, c->origin);
+            }
+            else
+            {
+                for(auto& v : link.visual_array)
+                    add(v->geometry, v->origin);
+            }
+        };
+
+        auto new_body = [&](const urdf::Link& link, const Transform& frame)
+        {
+            IndexT id                     = robot->bodies.size();
+            robot->bodies.emplace_back().name = link.name;
+            body_shapes.emplace_back();
+            body_frames.push_back(frame);
+            return id;
+        };
+
+        // traverse the kinematic tree at the zero configuration
+        auto traverse = [&](auto&& self, const urdf::Link& link, const Transform& frame, IndexT body) -> void
+        {
+            collect_shapes(link, frame, body);
+
+            for(auto& joint : link.child_joints)
+            {
+                auto child = model->getLink(joint->child_link_name);
+                UIPC_ASSERT(child, "Child link [{}] of joint [{}] not found.", joint->child_link_name, joint->name);
+
+                Transform child_frame = frame * to_transform(joint->parent_to_joint_origin_transform);
+
+                if(joint->type == urdf::Joint::FIXED)
+                {
+                    self(self, *child, child_frame, body);
+                    continue;
+                }
+
+                IndexT child_body = new_body(*child, child_frame);
+
+                if(joint->type == urdf::Joint::REVOLUTE || joint->type == urdf::Joint::CONTINUOUS)
+                {
+                    Vector3 axis{joint->axis.x, joint->axis.y, joint->axis.z};
+                    axis *= 0.5 * config["joint_axis_length"].get<Float>() / axis.norm();
+                    robot->joints.push_back({.parent_body = body,
+                                             .child_body  = child_body,
+                                             .P0          = child_frame * (-axis),
+                                             .P1          = child_frame * axis});
+                }
+                else if(joint->type != urdf::Joint::FLOATING)
+                {
+                    UIPC_WARN_WITH_LOCATION("Joint [{}] of URDF [{}]: only revolute, continuous, fixed and floating joints are supported, the links are left unconstrained.",
+                                            joint->name,
+                                            file.string());
+                }
+
+                self(self, *child, child_frame, child_body);
+            }
+        };
+
+        auto root = model->getRoot();
+        UIPC_ASSERT(root, "URDF [{}] has no root link.", file.string());
+        traverse(traverse, *root, Transform::Identity(), new_body(*root, Transform::Identity()));
+
+        constitution::AffineBodyConstitution abd;
+        const Float kappa        = config["kappa"].get<Float>();
+        const Float mass_density = config["mass_density"].get<Float>();
+
+        for(auto&& [i, body] : enumerate(robot->bodies))
+        {
+            auto& shapes = body_shapes[i];
+            if(shapes.empty())
+                continue;
+
+            if(shapes.size() == 1)
+            {
+                // share the cached mesh, the shape transform goes to the instance
+                body.mesh      = uipc::make_shared<SimplicialComplex>(*shapes[0].mesh);
+                body.transform = shapes[0].transform;
+            }
+            else
+            {
+                // bake the shapes into the body frame
+                Matrix4x4                 to_body = body_frames[i].inverse().matrix();
+                vector<SimplicialComplex> baked;
+                baked.reserve(shapes.size());
+                for(auto& shape : shapes)
+                {
+                    auto&     sc = baked.emplace_back(*shape.mesh);
+                    Matrix4x4 T  = to_body * shape.transform;
+                    for(auto& v : view(sc.positions()))
+                        v = (T * v.homogeneous()).head<3>();
+                }
+
+                vector<const SimplicialComplex*> ptrs(baked.size());
+                std::ranges::transform(baked, ptrs.begin(), [](auto& sc) { return &sc; });
+                body.mesh      = uipc::make_shared<SimplicialComplex>(merge(ptrs));
+                body.transform = body_frames[i].matrix();
+            }
+
+            abd.apply_to(*body.mesh, kappa, mass_density);
+            label_surface(*body.mesh);
+        }
+
+        // joints on the bodies without any shape can't be simulated
+        std::erase_if(robot->joints,
+                      [&](const Joint& j)
+                      {
+                          bool empty = body_shapes[j.parent_body].empty()
+                                       || body_shapes[j.child_body].empty();
+                          if(empty)
+                              UIPC_WARN_WITH_LOCATION("URDF [{}]: joint between [{}] and [{}] is ignored, one of the links has no shape.",
+                                                      file.string(),
+                                                      robot->bodies[j.parent_body].name,
+                                                      robot->bodies[j.child_body].name);
+                          return empty;
+                      });
+
+        for(auto& j : robot->joints)
+        {
+            robot->bodies[j.parent_body].jointed = true;
+            robot->bodies[j.child_body].jointed  = true;
+        }
+
+        // the root link is often a shapeless frame, e.g. `world`, fix the first body with a shape instead
+        auto base = std::ranges::find_if(robot->bodies, [](const Body& b) { return b.mesh != nullptr; });
+        if(base != robot->bodies.end())
+            robot->base = static_cast<IndexT>(base - robot->bodies.begin());
+
+        if(config["fixed_base"].get<bool>() && robot->base != 0)
+        {
+            if(robot->base < 0)
+            {
+                UIPC_WARN_WITH_LOCATION("URDF [{}]: `fixed_base` is ignored, no link has a shape.",
+                                        file.string());
+            }
+            else
+            {
+                UIPC_WARN_WITH_LOCATION("URDF [{}]: the root link [{}] has no shape, `fixed_base` fixes [{}] instead.",
+                                        file.string(),
+                                        robot->bodies.front().name,
+                                        robot->bodies[robot->base].name);
+            }
+        }
+
+        return robot;
+    }
+
+    const RobotTemplate& robot(std::string_view file_name)
+    {
+        auto path = fs::weakly_canonical(fs::path{file_name});
+        if(!fs::exists(path))
+            throw UrdfIOError{fmt::format("File [{}] doesn't exist.", file_name)};
+
+        auto key = path.string();
+        auto it  = robots.find(key);
+        if(it == robots.end())
+            it = robots.emplace(key, parse(path)).first;
+        return *it->second;
+    }
+
+    Robot instantiate(const RobotTemplate& robot, span<const Transform> placements)
+    {
+        using SlotTuple = constitution::AffineBodyRevoluteJoint::SlotTuple;
+
+        const SizeT N          = placements.size();
+        const bool  fixed_base = config["fixed_base"].get<bool>();
+
+        Robot R;
+        R.name = robot.name;
+
+        // slots[body][placement] for the jointed bodies
+        vector<vector<S<SimplicialComplexSlot>>> slots(robot.bodies.size());
+
+        for(auto&& [i, body] : enumerate(robot.bodies))
+        {
+            if(!body.mesh)
+                continue;
+
+            auto object = scene.objects().create(fmt::format("{}/{}", robot.name, body.name));
+            R.links.push_back(object);
+
+            const bool fixed = fixed_base && static_cast<IndexT>(i) == robot.base;
+
+            if(!body.jointed)
+            {
+                SimplicialComplex mesh = *body.mesh;
+                mesh.instances().resize(N);
+                auto trans = view(mesh.transforms());
+                for(SizeT p = 0; p < N; ++p)
+                    trans[p] = placements[p].matrix() * body.transform;
+                if(fixed)
+                    std::ranges::fill(view(*mesh.instances().find<IndexT>(builtin::is_fixed)), 1);
+                object->geometries().create(mesh);
+                continue;
+            }
+
+            slots[i].reserve(N);
+            for(SizeT p = 0; p < N; ++p)
+            {
+                SimplicialComplex mesh     = *body.mesh;
+                view(mesh.transforms())[0] = placements[p].matrix() * body.transform;
+                if(fixed)
+                    view(*mesh.instances().find<IndexT>(builtin::is_fixed))[0] = 1;
+                auto [geo_slot, rest_geo_slot] = object->geometries().create(mesh);
+                slots[i].push_back(geo_slot);
+            }
+        }
+
+        if(robot.joints.empty() || N == 0)
+            return R;
+
+        vector<Vector3>   Vs;
+        vector<Vector2i>  Es;
+        vector<SlotTuple> links;
+        Vs.reserve(2 * robot.joints.size() * N);
+        Es.reserve(robot.joints.size() * N);
+        links.reserve(robot.joints.size() * N);
+
+        for(SizeT p = 0; p < N; ++p)
+        {
+            for(auto& joint : robot.joints)
+            {
+                IndexT v = Vs.size();
+                Vs.push_back(placements[p] * joint.P0);
+                Vs.push_back(placements[p] * joint.P1);
+                Es.push_back({v, v + 1});
+                links.push_back({slots[joint.parent_body][p], slots[joint.child_body][p]});
+            }
+        }
+
+        auto joint_mesh = linemesh(Vs, Es);
+        constitution::AffineBodyRevoluteJoint abrj;
+        abrj.apply_to(joint_mesh, links, config["strength_ratio"].get<Float>());
+
+        R.joints = scene.objects().create(fmt::format("{}/joints", robot.name));
+        R.joints->geometries().create(joint_mesh);
+
+        return R;
+    }
+};
+
+UrdfIO::UrdfIO(Scene& scene, const Json& config)
+    : m_impl{uipc::make_unique<Impl>(scene, config)}
+{
+}
+
+UrdfIO::~UrdfIO() = default;
+
+Json UrdfIO::default_config()
+{
+    Json config;
+    config["kappa"]             = static_cast<Float>(100.0_MPa);
+    config["mass_density"]      = 1e3;
+    config["strength_ratio"]    = 100.0;
+    config["joint_axis_length"] = 1.0;
+    config["use_collision"]     = true;
+    config["fixed_base"]        = false;
+    config["package_dirs"]      = Json::array();
+    return config;
+}
+
+UrdfIO::Robot UrdfIO::read(std::string_view file_name)
+{
+    Transform identity = Transform::Identity();
+    return read(file_name, span{&identity, 1});
+}
+
+UrdfIO::Robot UrdfIO::read(std::string_view file_name, span<const Transform> placements)
+{
+    return m_impl->instantiate(m_impl->robot(file_name), placements);
+}
+
+SizeT UrdfIO::cached_mesh_count() const noexcept
+{
+    return m_impl->meshes.size();
+}
+
+void UrdfIO::clear_cache() noexcept
+{
+    m_impl->meshes.clear();
+    m_impl->robots.clear();
+}
+}  // namespace uipc::core
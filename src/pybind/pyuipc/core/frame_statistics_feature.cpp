@@ -0,0 +1,79 @@
+#include <pyuipc/core/frame_statistics_feature.h>
+#include <uipc/core/frame_statistics_feature.h>
+#include <pyuipc/common/json.h>
+#include <pybind11/numpy.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+
+namespace
+{
+    template <typename T, typename F>
+    py::array_t<T> column(const FrameStatisticsFeature& self, F&& get)
+    {
+        py::array_t<T> arr(static_cast<py::ssize_t>(self.size()));
+        auto           data = arr.mutable_data();
+        for(SizeT i = 0; i < self.size(); ++i)
+            data[i] = static_cast<T>(get(self[i]));
+        return arr;
+    }
+}  // namespace
+
+PyFrameStatisticsFeature::PyFrameStatisticsFeature(py::module& m)
+{
+    auto class_FrameStatisticsFeature =
+        py::class_<FrameStatisticsFeature, IFeature, S<FrameStatisticsFeature>>(
+            m, "FrameStatisticsFeature");
+
+    class_FrameStatisticsFeature.attr("FeatureName") = FrameStatisticsFeature::FeatureName;
+
+    class_FrameStatisticsFeature.def("size", &FrameStatisticsFeature::size);
+    class_FrameStatisticsFeature.def("capacity", &FrameStatisticsFeature::capacity);
+    class_FrameStatisticsFeature.def("clear", &FrameStatisticsFeature::clear);
+    class_FrameStatisticsFeature.def("to_json", &FrameStatisticsFeature::to_json);
+
+    class_FrameStatisticsFeature.def(
+        "latest",
+        [](const FrameStatisticsFeature& self) -> Json
+        {
+            if(self.size() == 0)
+                throw PyException(PYUIPC_MSG("No frame statistics recorded yet."));
+            return self.latest().to_json();
+        });
+
+    // columns of the ring, from the oldest frame to the latest one
+    class_FrameStatisticsFeature.def(
+        "to_numpy",
+        [](const FrameStatisticsFeature& self)
+        {
+            using R = FrameStatisticsRecord;
+            py::dict d;
+            d["frame"] = column<U64>(self, [](const R& r) { return r.frame; });
+            d["newton_iterations"] =
+                column<IndexT>(self, [](const R& r) { return r.newton_iterations; });
+            d["line_search_iterations"] =
+                column<IndexT>(self, [](const R& r) { return r.line_search_iterations; });
+            d["linear_solver_iterations"] =
+                column<IndexT>(self, [](const R& r) { return r.linear_solver_iterations; });
+            d["ccd_alpha"] = column<Float>(self, [](const R& r) { return r.ccd_alpha; });
+            d["cfl_alpha"] = column<Float>(self, [](const R& r) { return r.cfl_alpha; });
+            d["line_search_alpha"] =
+                column<Float>(self, [](const R& r) { return r.line_search_alpha; });
+            d["contact_candidates"] =
+                column<U64>(self, [](const R& r) { return r.contact_candidates; });
+            d["active_contacts"] =
+                column<U64>(self, [](const R& r) { return r.active_contacts; });
+
+            py::dict times;
+            for(int p = 0; p < R::PhaseCount; ++p)
+            {
+                auto phase = static_cast<R::Phase>(p);
+                times[py::str(std::string{R::phase_name(phase)})] =
+                    column<Float>(self, [p](const R& r) { return r.phase_times[p]; });
+            }
+            d["phase_times"] = times;
+            return d;
+        });
+}
+}  // namespace pyuipc::core
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::core
+{
+class PyFrameStatisticsFeature
+{
+  public:
+    PyFrameStatisticsFeature(py::module& m);
+};
+}  // namespace pyuipc::core
@@ -0,0 +1,48 @@
+#include <pyuipc/core/frame_streamer.h>
+#include <pyuipc/common/json.h>
+#include <pyuipc/as_numpy.h>
+#include <uipc/io/frame_streamer.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+PyFrameStreamer::PyFrameStreamer(py::module& m)
+{
+    auto class_FrameStreamer = py::class_<FrameStreamer>(m, "FrameStreamer");
+    class_FrameStreamer.def(py::init<Scene&, std::string_view, const Json&>(),
+                            py::arg("scene"),
+                            py::arg("name"),
+                            py::arg("config") = FrameStreamer::default_config());
+    class_FrameStreamer.def_static("default_config", &FrameStreamer::default_config);
+    class_FrameStreamer.def("publish", &FrameStreamer::publish, py::arg("frame"));
+    class_FrameStreamer.def("generation", &FrameStreamer::generation);
+    class_FrameStreamer.def("name", &FrameStreamer::name);
+
+    auto class_FrameStreamReader = py::class_<FrameStreamReader>(m, "FrameStreamReader");
+    auto class_Frame = py::class_<FrameStreamReader::Frame>(class_FrameStreamReader, "Frame");
+
+    // the arrays map the shared memory, they keep the frame (and its mapping) alive
+    class_Frame.def("frame", &FrameStreamReader::Frame::frame);
+    class_Frame.def("generation", &FrameStreamReader::Frame::generation);
+    class_Frame.def("positions",
+                    [](FrameStreamReader::Frame& self)
+                    { return as_numpy(self.positions(), py::cast(self)); });
+    class_Frame.def("edges",
+                    [](FrameStreamReader::Frame& self)
+                    { return as_numpy(self.edges(), py::cast(self)); });
+    class_Frame.def("triangles",
+                    [](FrameStreamReader::Frame& self)
+                    { return as_numpy(self.triangles(), py::cast(self)); });
+    class_Frame.def("is_valid", &FrameStreamReader::Frame::is_valid);
+
+    class_FrameStreamReader.def(py::init<std::string_view>(), py::arg("name"));
+    class_FrameStreamReader.def("latest",
+                                [](FrameStreamReader& self) -> py::object
+                                {
+                                    auto frame = self.latest();
+                                    if(!frame)
+                                        return py::none();
+                                    return py::cast(std::move(*frame));
+                                });
+}
+}  // namespace pyuipc::core
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::core
+{
+class PyFrameStreamer
+{
+  public:
+    PyFrameStreamer(py::module& m);
+};
+}  // namespace pyuipc::core
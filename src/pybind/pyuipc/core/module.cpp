@@ -4,19 +4,27 @@
 #include <pyuipc/core/scene.h>
 #include <pyuipc/core/scene_factory.h>
 #include <pyuipc/core/world.h>
+#include <pyuipc/core/world_batch.h>
 #include <pyuipc/core/contact_tabular.h>
 #include <pyuipc/core/constitution_tabular.h>
 #include <pyuipc/core/scene_io.h>
+#include <pyuipc/core/urdf_io.h>
+#include <pyuipc/core/frame_streamer.h>
 #include <pyuipc/core/scene_snapshot.h>
+#include <pyuipc/core/scene_history.h>
 #include <pyuipc/core/animator.h>
 #include <pyuipc/core/diff_sim.h>
 #include <pyuipc/core/sanity_checker.h>
+#include <pyuipc/core/feature.h>
 #include <pyuipc/core/feature_collection.h>
+#include <pyuipc/core/frame_statistics_feature.h>
 
 namespace pyuipc::core
 {
 PyModule::PyModule(py::module& m)
 {
+    PyFeature{m};
+    PyFrameStatisticsFeature{m};
     PyFeatureCollection{m};
 
     PyEngine{m};
@@ -32,10 +40,14 @@ PyModule::PyModule(py::module& m)
     PySanityChecker{m};
     PyScene{m};
     PySceneSnapshot{m};
+    PySceneHistory{m};
 
     PySceneFactory{m};
     PyWorld{m};
+    PyWorldBatch{m};
 
     PySceneIO{m};
+    PyUrdfIO{m};
+    PyFrameStreamer{m};
 }
 }  // namespace pyuipc::core
@@ -78,6 +78,10 @@ PyScene::PyScene(py::module& m)
                              return std::make_pair(geo, rest_geo);
                          });
 
+    class_Geometries.def("deduplicate_attributes",
+                         [](Scene::Geometries& self)
+                         { return std::move(self).deduplicate_attributes(); });
+
     class_Scene.def(
         "diff_sim",
         [](Scene& self) -> DiffSim& { return self.diff_sim(); },
@@ -88,6 +92,8 @@ PyScene::PyScene(py::module& m)
         [](Scene& self) -> SanityChecker& { return self.sanity_checker(); },
         py::return_value_policy::reference_internal);
 
+    class_Scene.def("memory_report", &Scene::memory_report);
+
     class_Scene.def("__repr__",
                     [](const Scene& self) { return fmt::format("{}", self); });
 }
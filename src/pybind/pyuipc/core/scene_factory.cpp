@@ -10,7 +10,9 @@ using namespace uipc::geometry;
 PySceneFactory::PySceneFactory(py::module& m)
 {
     auto class_SceneFactory = py::class_<SceneFactory>(m, "SceneFactory")
-                                  .def(py::init<>())
+                                  .def(py::init<const Json&>(),
+                                       py::arg("config") = SceneFactory::default_config())
+                                  .def_static("default_config", &SceneFactory::default_config)
                                   .def("from_json", &SceneFactory::from_json)
                                   .def("to_json", &SceneFactory::to_json);
 
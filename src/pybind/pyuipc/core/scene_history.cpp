@@ -0,0 +1,34 @@
+#include <pyuipc/core/scene_history.h>
+#include <pyuipc/common/json.h>
+#include <pybind11/stl.h>
+#include <uipc/core/scene_history.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+PySceneHistory::PySceneHistory(py::module& m)
+{
+    auto class_SceneHistory = py::class_<SceneHistory>(m, "SceneHistory");
+    class_SceneHistory.def(py::init<const Scene&, const Json&>(),
+                           py::arg("scene"),
+                           py::arg("config") = SceneHistory::default_config());
+    class_SceneHistory.def_static("default_config", &SceneHistory::default_config);
+    class_SceneHistory.def("commit", &SceneHistory::commit);
+    class_SceneHistory.def("latest", &SceneHistory::latest);
+    class_SceneHistory.def("oldest", &SceneHistory::oldest);
+    class_SceneHistory.def("size", &SceneHistory::size);
+    class_SceneHistory.def("contains", &SceneHistory::contains, py::arg("version"));
+    class_SceneHistory.def("snapshot", &SceneHistory::snapshot, py::arg("version"));
+    class_SceneHistory.def("diff", &SceneHistory::diff, py::arg("dst"), py::arg("src"));
+    class_SceneHistory.def("geometry_version",
+                           &SceneHistory::geometry_version,
+                           py::arg("version"),
+                           py::arg("geometry_id"));
+    class_SceneHistory.def("attribute_version",
+                           &SceneHistory::attribute_version,
+                           py::arg("version"),
+                           py::arg("geometry_id"),
+                           py::arg("collection"),
+                           py::arg("attribute"));
+}
+}  // namespace pyuipc::core
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::core
+{
+class PySceneHistory
+{
+  public:
+    PySceneHistory(py::module& m);
+};
+}  // namespace pyuipc::core
@@ -17,10 +17,16 @@ PySceneIO::PySceneIO(py::module& m)
         py::arg("dim") = -1);
     class_SceneIO.def_static(
         "load",
-        [](std::string_view filename) { return SceneIO::load(filename); },
-        py::arg("filename"));
+        [](std::string_view filename, bool lazy)
+        { return SceneIO::load(filename, lazy); },
+        py::arg("filename"),
+        py::arg("lazy") = false);
     class_SceneIO.def(
-        "save", [](SceneIO& self, std::string_view file) { self.save(file); }, py::arg("filename"));
+        "save",
+        [](SceneIO& self, std::string_view file, const Json& config)
+        { self.save(file, config); },
+        py::arg("filename"),
+        py::arg("config") = SceneFactory::default_config());
     class_SceneIO.def("to_json", &SceneIO::to_json);
     class_SceneIO.def_static("from_json", &SceneIO::from_json, py::arg("json"));
 
@@ -0,0 +1,45 @@
+#include <pyuipc/core/urdf_io.h>
+#include <pyuipc/common/json.h>
+#include <pyuipc/as_numpy.h>
+#include <uipc/io/urdf_io.h>
+#include <pybind11/stl.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+PyUrdfIO::PyUrdfIO(py::module& m)
+{
+    auto class_UrdfIO = py::class_<UrdfIO>(m, "UrdfIO");
+
+    auto class_Robot = py::class_<UrdfIO::Robot>(class_UrdfIO, "Robot");
+    class_Robot.def_readonly("name", &UrdfIO::Robot::name);
+    class_Robot.def_readonly("links", &UrdfIO::Robot::links);
+    class_Robot.def_readonly("joints", &UrdfIO::Robot::joints);
+
+    class_UrdfIO.def(py::init<Scene&, const Json&>(),
+                     py::arg("scene"),
+                     py::arg("config") = UrdfIO::default_config());
+    class_UrdfIO.def_static("default_config", &UrdfIO::default_config);
+
+    class_UrdfIO.def(
+        "read",
+        [](UrdfIO& self, std::string_view filename)
+        { return self.read(filename); },
+        py::arg("filename"));
+
+    class_UrdfIO.def(
+        "read",
+        [](UrdfIO& self, std::string_view filename, py::array_t<Float> placements)
+        {
+            auto              mats = as_span_of<const Matrix4x4>(placements);
+            vector<Transform> transforms(mats.size());
+            std::ranges::transform(mats, transforms.begin(), [](const Matrix4x4& m) { return Transform{m}; });
+            return self.read(filename, transforms);
+        },
+        py::arg("filename"),
+        py::arg("placements"));
+
+    class_UrdfIO.def("cached_mesh_count", &UrdfIO::cached_mesh_count);
+    class_UrdfIO.def("clear_cache", &UrdfIO::clear_cache);
+}
+}  // namespace pyuipc::core
@@ -1,6 +1,7 @@
 #include <pyuipc/core/world.h>
 #include <uipc/core/world.h>
 #include <uipc/core/engine.h>
+#include <pyuipc/common/json.h>
 
 namespace pyuipc::core
 {
@@ -20,6 +21,7 @@ PyWorld::PyWorld(py::module& m)
         .def("backward", &World::backward)
         .def("frame", &World::frame)
         .def("features", &World::features, py::return_value_policy::reference_internal)
+        .def("memory_report", &World::memory_report)
         .def("is_valid", &World::is_valid);
 }
 
@@ -0,0 +1,68 @@
+#include <pyuipc/core/world_batch.h>
+#include <uipc/core/world_batch.h>
+#include <uipc/builtin/attribute_name.h>
+#include <pyuipc/common/json.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+
+PyWorldBatch::PyWorldBatch(py::module& m)
+{
+    auto class_WorldBatch = py::class_<WorldBatch>(m, "WorldBatch");
+
+    class_WorldBatch
+        .def(py::init<std::string_view, std::string_view, const Json&>(),
+             py::arg("backend_name"),
+             py::arg("workspace") = "./",
+             py::arg("config")    = Engine::default_config())
+        .def(
+            "init",
+            [](WorldBatch& self, std::vector<Scene*> scenes) { self.init(scenes); },
+            py::arg("scenes"),
+            py::keep_alive<1, 2>())
+        // the worlds are stepped on the worker threads, release the GIL meanwhile
+        .def("advance", &WorldBatch::advance, py::call_guard<py::gil_scoped_release>())
+        .def("sync", &WorldBatch::sync, py::call_guard<py::gil_scoped_release>())
+        .def("retrieve", &WorldBatch::retrieve, py::call_guard<py::gil_scoped_release>())
+        .def("size", &WorldBatch::size)
+        .def("__len__", &WorldBatch::size)
+        .def("world", &WorldBatch::world, py::return_value_policy::reference_internal)
+        .def("engine", &WorldBatch::engine, py::return_value_policy::reference_internal)
+        .def("frame", &WorldBatch::frame)
+        .def("frames",
+             [](const WorldBatch& self)
+             {
+                 auto frames = self.frames();
+                 return py::array_t<SizeT>(frames.size(), frames.data());
+             })
+        .def("valid",
+             [](const WorldBatch& self)
+             {
+                 auto              valid = self.valid();
+                 py::array_t<bool> arr(valid.size());
+                 auto              data = arr.mutable_data();
+                 for(SizeT i = 0; i < valid.size(); ++i)
+                     data[i] = valid[i];
+                 return arr;
+             })
+        .def(
+            "gather_positions",
+            [](const WorldBatch& self)
+            {
+                vector<Vector3> Xs;
+                auto            offsets = self.gather<Vector3>(uipc::builtin::position, Xs);
+
+                py::array_t<Float> positions({static_cast<py::ssize_t>(Xs.size()), py::ssize_t{3}});
+                std::memcpy(positions.mutable_data(), Xs.data(), Xs.size() * sizeof(Vector3));
+                return py::make_tuple(positions,
+                                      py::array_t<SizeT>(offsets.size(), offsets.data()));
+            },
+            R"(Gather the vertex positions of all the scenes into one (N, 3) array.
+
+Returns:
+    (positions, offsets), the positions of the i-th scene are positions[offsets[i]:offsets[i+1]].)");
+}
+}  // namespace pyuipc::core
@@ -1,6 +1,7 @@
 #include <pyuipc/geometry/attribute_collection.h>
 #include <uipc/geometry/attribute_collection.h>
 #include <pyuipc/as_numpy.h>
+#include <pyuipc/geometry/attribute_creator.h>
 #include <uipc/common/type_traits.h>
 #include <pybind11/numpy.h>
 #include <boost/core/demangle.hpp>
@@ -179,12 +180,27 @@ PyAttributeCollection::PyAttributeCollection(py::module& m)
 
     def_create(class_AttributeCollection);
 
+    class_AttributeCollection.def(
+        "create_from",
+        [](AttributeCollection& self, std::string_view name, py::array values)
+        { return AttributeCreator::create_from(self, name, values); },
+        py::arg("name"),
+        py::arg("values"));
+
+    class_AttributeCollection.def(
+        "create_many",
+        [](AttributeCollection& self, py::dict attributes)
+        { return AttributeCreator::create_many(self, attributes); },
+        py::arg("attributes"));
+
     class_AttributeCollection.def(
         "share",
         [](AttributeCollection& self, std::string_view name, IAttributeSlot& slot)
         { self.share(name, slot); });
 
-    class_AttributeCollection.def("destroy", &AttributeCollection::destroy);
+    class_AttributeCollection.def("destroy",
+                                  [](AttributeCollection& self, std::string_view name)
+                                  { self.destroy(name); });
 
     class_AttributeCollection.def("find",
                                   [](AttributeCollection& self,
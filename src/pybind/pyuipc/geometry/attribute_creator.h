@@ -1,5 +1,6 @@
 #pragma once
 #include <pyuipc/pyuipc.h>
+#include <pyuipc/as_numpy.h>
 #include <uipc/geometry/attribute_slot.h>
 #include <uipc/geometry/attribute_collection.h>
 
@@ -18,5 +19,194 @@ class AttributeCreator
         return py::cast<S<uipc::geometry::IAttributeSlot>>(
             pyobj.attr("create").operator()(py::cast(name), object));
     }
+
+    /**
+     * @brief Create an attribute from a per-element array, the values are copied in one pass.
+     *
+     * The attribute type is deduced from the dtype and the shape of the array:
+     * - float64: (N,) -> Float, (N,k)/(N,k,1) -> Vector{k}, (N,k,k) -> Matrix{k}x{k}
+     * - int32: (N,) -> IndexT, (N,k)/(N,k,1) -> Vector{k}i
+     * - int64: (N,) -> I64
+     * - uint64: (N,) -> U64
+     */
+    static S<uipc::geometry::IAttributeSlot> create_from(uipc::geometry::AttributeCollection& a,
+                                                         std::string_view name,
+                                                         py::array        values)
+    {
+        using namespace uipc;
+
+        if(py::array_t<Float>::check_(values))
+        {
+            auto arr = as_contiguous<Float>(values);
+            if(arr.ndim() == 1)
+                return create_scalars<Float>(a, name, arr);
+
+            auto rows = arr.ndim() >= 2 ? arr.shape(1) : 0;
+            auto cols = arr.ndim() == 3 ? arr.shape(2) : 1;
+            if(arr.ndim() <= 3 && cols == 1)
+            {
+                switch(rows)
+                {
+                    case 2:
+                        return create_matrices<Vector2>(a, name, arr);
+                    case 3:
+                        return create_matrices<Vector3>(a, name, arr);
+                    case 4:
+                        return create_matrices<Vector4>(a, name, arr);
+                    case 6:
+                        return create_matrices<Vector6>(a, name, arr);
+                    case 9:
+                        return create_matrices<Vector9>(a, name, arr);
+                    case 12:
+                        return create_matrices<Vector12>(a, name, arr);
+                    default:
+                        break;
+                }
+            }
+            else if(arr.ndim() == 3 && rows == cols)
+            {
+                switch(rows)
+                {
+                    case 2:
+                        return create_matrices<Matrix2x2>(a, name, arr);
+                    case 3:
+                        return create_matrices<Matrix3x3>(a, name, arr);
+                    case 4:
+                        return create_matrices<Matrix4x4>(a, name, arr);
+                    case 6:
+                        return create_matrices<Matrix6x6>(a, name, arr);
+                    case 9:
+                        return create_matrices<Matrix9x9>(a, name, arr);
+                    case 12:
+                        return create_matrices<Matrix12x12>(a, name, arr);
+                    default:
+                        break;
+                }
+            }
+            throw PyException(PYUIPC_MSG("Unsupported shape of float64 values, ndim={}", arr.ndim()));
+        }
+
+        if(py::array_t<IndexT>::check_(values))
+        {
+            auto arr = as_contiguous<IndexT>(values);
+            if(arr.ndim() == 1)
+                return create_scalars<IndexT>(a, name, arr);
+
+            auto rows = arr.ndim() >= 2 ? arr.shape(1) : 0;
+            auto cols = arr.ndim() == 3 ? arr.shape(2) : 1;
+            if(arr.ndim() <= 3 && cols == 1)
+            {
+                switch(rows)
+                {
+                    case 2:
+                        return create_matrices<Vector2i>(a, name, arr);
+                    case 3:
+                        return create_matrices<Vector3i>(a, name, arr);
+                    case 4:
+                        return create_matrices<Vector4i>(a, name, arr);
+                    default:
+                        break;
+                }
+            }
+            throw PyException(PYUIPC_MSG("Unsupported shape of int32 values, ndim={}", arr.ndim()));
+        }
+
+        if(py::array_t<I64>::check_(values))
+        {
+            auto arr = as_contiguous<I64>(values);
+            if(arr.ndim() == 1)
+                return create_scalars<I64>(a, name, arr);
+            throw PyException(PYUIPC_MSG("Unsupported shape of int64 values, ndim={}", arr.ndim()));
+        }
+
+        if(py::array_t<U64>::check_(values))
+        {
+            auto arr = as_contiguous<U64>(values);
+            if(arr.ndim() == 1)
+                return create_scalars<U64>(a, name, arr);
+            throw PyException(PYUIPC_MSG("Unsupported shape of uint64 values, ndim={}", arr.ndim()));
+        }
+
+        throw PyException(PYUIPC_MSG("Unsupported dtype of values for attribute [{}]", name));
+    }
+
+    /**
+     * @brief Create several attributes from a dict of {name: values} in one call.
+     *
+     * If any of the attributes fails to be created, the attributes created by this call are destroyed.
+     */
+    static py::list create_many(uipc::geometry::AttributeCollection& a, py::dict attributes)
+    {
+        py::list                 slots;
+        std::vector<std::string> created;
+        try
+        {
+            for(auto&& [key, value] : attributes)
+            {
+                auto name = py::cast<std::string>(key);
+                slots.append(create_from(a, name, py::cast<py::array>(value)));
+                created.push_back(std::move(name));
+            }
+        }
+        catch(...)
+        {
+            for(auto& name : created)
+                a.destroy(name);
+            throw;
+        }
+        return slots;
+    }
+
+  private:
+    template <typename T>
+    using ContiguousArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+    template <typename T>
+    static ContiguousArray<T> as_contiguous(py::array values)
+    {
+        // no copy if the array is already C-contiguous
+        return ContiguousArray<T>::ensure(values);
+    }
+
+    template <typename T>
+    static S<uipc::geometry::IAttributeSlot> create_scalars(uipc::geometry::AttributeCollection& a,
+                                                            std::string_view name,
+                                                            const ContiguousArray<T>& arr)
+    {
+        return a.create_from<T>(name, uipc::span<const T>{arr.data(), static_cast<SizeT>(arr.shape(0))});
+    }
+
+    template <typename MatrixT>
+    static S<uipc::geometry::IAttributeSlot> create_matrices(
+        uipc::geometry::AttributeCollection& a,
+        std::string_view                     name,
+        const ContiguousArray<typename MatrixT::Scalar>& arr)
+    {
+        using Scalar       = typename MatrixT::Scalar;
+        constexpr int Rows = MatrixT::RowsAtCompileTime;
+        constexpr int Cols = MatrixT::ColsAtCompileTime;
+
+        const SizeT N = static_cast<SizeT>(arr.shape(0));
+
+        const Scalar* data    = arr.data();
+        const bool    aligned = reinterpret_cast<std::uintptr_t>(data) % alignof(MatrixT) == 0;
+
+        if constexpr(Cols == 1)
+        {
+            // a column vector has the same memory layout as a row of the array
+            if(aligned)
+            {
+                uipc::span<const MatrixT> values{reinterpret_cast<const MatrixT*>(data), N};
+                return a.create_from<MatrixT>(name, values);
+            }
+        }
+
+        // numpy is row major, eigen is column major
+        using Layout = Eigen::Matrix<Scalar, Rows, Cols, Cols == 1 ? Eigen::ColMajor : Eigen::RowMajor>;
+        uipc::vector<MatrixT> values(N);
+        for(SizeT i = 0; i < N; ++i)
+            values[i] = Eigen::Map<const Layout>(data + i * Rows * Cols);
+        return a.adopt<MatrixT>(name, std::move(values));
+    }
 };
-}  // namespace pyuipc::geometry
\ No newline at end of file
+}  // namespace pyuipc::geometry
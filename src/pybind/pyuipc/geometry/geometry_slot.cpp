@@ -11,5 +11,6 @@ PyGeometrySlot::PyGeometrySlot(py::module& m)
         "geometry",
         [](GeometrySlot& self) -> Geometry& { return self.geometry(); },
         py::return_value_policy::reference_internal);
+    class_GeometrySlot.def("is_loaded", &GeometrySlot::is_loaded);
 }
 }  // namespace pyuipc::geometry
@@ -34,6 +34,20 @@ class AttributeFriend<pyuipc::geometry::PySimplicialComplex>
     {
         return pyuipc::geometry::AttributeCreator::create(a.m_attributes, name, object);
     }
+
+    template <IndexT N>
+    static S<IAttributeSlot> create_from(SimplicialComplexAttributes<false, N>& a,
+                                         std::string_view                       name,
+                                         py::array                              values)
+    {
+        return pyuipc::geometry::AttributeCreator::create_from(a.m_attributes, name, values);
+    }
+
+    template <IndexT N>
+    static py::list create_many(SimplicialComplexAttributes<false, N>& a, py::dict attributes)
+    {
+        return pyuipc::geometry::AttributeCreator::create_many(a.m_attributes, attributes);
+    }
 };
 }  // namespace uipc::geometry
 
@@ -76,6 +90,19 @@ void def_method(py::module& m, py::class_<SimplicialComplexAttributes<false, N>>
                             return Accessor::template create<N>(self, name, object);
                         });
 
+    class_Attribute.def(
+        "create_from",
+        [](Attributes& self, std::string_view name, py::array values)
+        { return Accessor::template create_from<N>(self, name, values); },
+        py::arg("name"),
+        py::arg("values"));
+
+    class_Attribute.def(
+        "create_many",
+        [](Attributes& self, py::dict attributes)
+        { return Accessor::template create_many<N>(self, attributes); },
+        py::arg("attributes"));
+
     class_Attribute.def("to_json", &Attributes::to_json);
 }
 
@@ -32,5 +32,28 @@ PySpreadSheetIO::PySpreadSheetIO(py::module& m)
     class_SpreadSheetIO.def("write_csv",
                             [](SpreadSheetIO& self, const SimplicialComplex& simplicial_complex)
                             { self.write_csv(simplicial_complex); });
+
+    class_SpreadSheetIO.def(
+        "write_arrow",
+        [](SpreadSheetIO& self, std::string geo_name, const SimplicialComplex& simplicial_complex)
+        { self.write_arrow(geo_name, simplicial_complex); },
+        py::arg("geo_name"),
+        py::arg("simplicial_complex"));
+
+    class_SpreadSheetIO.def("write_arrow",
+                            [](SpreadSheetIO& self, const SimplicialComplex& simplicial_complex)
+                            { self.write_arrow(simplicial_complex); });
+
+    auto class_SpreadSheetStream = py::class_<SpreadSheetStream>(m, "SpreadSheetStream");
+    class_SpreadSheetStream.def(py::init<std::string_view, std::string_view>(),
+                                py::arg("output_folder") = "./",
+                                py::arg("geo_name")      = "spreadsheet");
+    class_SpreadSheetStream.def(
+        "append",
+        [](SpreadSheetStream& self, const SimplicialComplex& simplicial_complex, uipc::SizeT frame)
+        { self.append(simplicial_complex, frame); },
+        py::arg("simplicial_complex"),
+        py::arg("frame"));
+    class_SpreadSheetStream.def("close", &SpreadSheetStream::close);
 }
 }  // namespace pyuipc::geometry
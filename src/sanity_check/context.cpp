@@ -7,8 +7,7 @@
 #include <uipc/backend/visitors/scene_visitor.h>
 #include <uipc/common/unordered_map.h>
 #include <uipc/geometry/utils/extract_surface.h>
-#include <uipc/geometry/utils/apply_transform.h>
-#include <uipc/geometry/utils/merge.h>
+#include <uipc/common/parallel_for.h>
 #include <uipc/core/internal/scene.h>
 
 namespace uipc::sanity_check
@@ -314,59 +313,49 @@ namespace detail
         if(sc.empty())
             return SimplicialComplex{};
 
-        // 1) extract the surface from each simplicial complex
-        vector<SimplicialComplex> surfaces;
-        surfaces.reserve(sc.size());
-
-        std::transform(sc.begin(),
-                       sc.end(),
-                       std::back_inserter(surfaces),
-                       [](const SimplicialComplex* simplicial_complex)
-                       {
-                           if(simplicial_complex->dim() == 3)
-                               return extract_surface(*simplicial_complex);
-                           else
-                               return *simplicial_complex;
-                       });
-
-        // 2) find out all the surface instances, apply the transformation
-        SizeT total_surface_instances = std::accumulate(
-            sc.begin(),
-            sc.end(),
-            0ull,
-            [](SizeT acc, const SimplicialComplex* simplicial_complex)
-            { return acc + simplicial_complex->instances().size(); });
-
-        vector<SimplicialComplex> all_surfaces;
-        all_surfaces.reserve(total_surface_instances);
-
-        for(auto& surface : surfaces)
-        {
-            vector<SimplicialComplex> instances = apply_transform(surface);
+        auto R = extract_surface(sc);
 
-            // label vertices with instance id
-            for(auto&& [I, instance] : enumerate(instances))
+        // the surface vertex count of each simplicial complex
+        vector<SizeT> vertex_counts(sc.size());
+        parallel_for(
+            0,
+            sc.size(),
+            [&](SizeT I)
             {
-                auto instance_id =
-                    instance.vertices().find<IndexT>("sanity_check/instance_id");
-
-                if(!instance_id)
-                    instance_id = instance.vertices().create<IndexT>("sanity_check/instance_id");
-
-                std::ranges::fill(view(*instance_id), I);
+                auto complex = sc[I];
+                if(complex->dim() != 3)
+                {
+                    vertex_counts[I] = complex->vertices().size();
+                    return;
+                }
+                auto is_surf = complex->vertices().find<IndexT>(builtin::is_surf);
+                UIPC_ASSERT(is_surf, "`is_surf` attribute not found in the mesh vertices.");
+                vertex_counts[I] = std::ranges::count_if(is_surf->view(),
+                                                         [](IndexT surf) { return surf != 0; });
+            },
+            1);
+
+        // label vertices with instance id, in the same order as extract_surface: geometries, then instances
+        auto instance_id = R.vertices().find<IndexT>("sanity_check/instance_id");
+        if(!instance_id)
+            instance_id = R.vertices().create<IndexT>("sanity_check/instance_id");
+        auto instance_id_view = view(*instance_id);
+
+        SizeT offset = 0;
+        for(auto&& [I, complex] : enumerate(sc))
+        {
+            for(IndexT i = 0; i < static_cast<IndexT>(complex->instances().size()); ++i)
+            {
+                std::fill_n(instance_id_view.begin() + offset, vertex_counts[I], i);
+                offset += vertex_counts[I];
             }
-
-            std::move(instances.begin(), instances.end(), std::back_inserter(all_surfaces));
         }
+        UIPC_ASSERT(offset == instance_id_view.size(),
+                    "Surface vertex count mismatch, expected {}, got {}.",
+                    offset,
+                    instance_id_view.size());
 
-        vector<const SimplicialComplex*> surfaces_ptr(total_surface_instances);
-
-        std::transform(all_surfaces.begin(),
-                       all_surfaces.end(),
-                       surfaces_ptr.begin(),
-                       [](SimplicialComplex& surface) { return &surface; });
-
-        return merge(surfaces_ptr);
+        return R;
     }
 }  // namespace detail
 
@@ -12,6 +12,7 @@
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/geometry/utils/distance.h>
 #include <uipc/common/map.h>
+#include <uipc/common/parallel_for.h>
 
 namespace std
 {
@@ -208,6 +209,8 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
         map<Vector2i, Vector2i> close_geo_ids;
 
         vector<IndexT> vertex_too_close(Vs.size(), 0);
+        // the vertices too close to the current half-plane instance
+        vector<IndexT> vertex_close_to_instance(Vs.size(), 0);
 
         for(auto& halfplane : halfplanes)
         {
@@ -239,19 +242,32 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
                 const Vector3& N = Ns[I];
                 const Vector3& P = Ps[I];
 
-                for(auto vI : range(Vs.size()))
-                {
-                    const auto& CM = contact_table.at(HCid, CIds[vI]);
+                // the distances in parallel, then the messages in the vertex order
+                parallel_for(
+                    0,
+                    Vs.size(),
+                    [&](SizeT vI)
+                    {
+                        vertex_close_to_instance[vI] = 0;
+
+                        const auto& CM = contact_table.at(HCid, CIds[vI]);
 
-                    if(!CM.is_enabled())  // if unenabled, skip
-                        continue;
+                        if(!CM.is_enabled())  // if unenabled, skip
+                            return;
 
-                    const Vector3& V = Vs[vI];
-                    auto V_thickness = VThickness.size() ? VThickness[vI] : 0.0;
+                        const Vector3& V = Vs[vI];
+                        auto V_thickness = VThickness.size() ? VThickness[vI] : 0.0;
 
-                    auto d = geometry::halfplane_vertex_signed_distance(P, N, V, V_thickness);
+                        auto d = geometry::halfplane_vertex_signed_distance(
+                            P, N, V, V_thickness);
 
-                    if(d <= 0)  // too close
+                        if(d <= 0)  // too close
+                            vertex_close_to_instance[vI] = 1;
+                    });
+
+                for(auto vI : range(Vs.size()))
+                {
+                    if(vertex_close_to_instance[vI])
                     {
                         too_close = true;
 
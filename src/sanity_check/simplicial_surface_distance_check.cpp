@@ -11,6 +11,7 @@
 #include <uipc/common/map.h>
 #include <uipc/geometry/utils/distance.h>
 #include <uipc/geometry/utils/octree.h>
+#include <uipc/common/zip.h>
 namespace std
 {
 // Vector2i  set comparison
@@ -276,95 +277,117 @@ class SimplicialSurfaceDistanceCheck final : public SanityChecker
             }
         };
 
+        auto is_contact_enabled = [&](IndexT L, IndexT R)
+        { return contact_table.at(CIds[L], CIds[R]).is_enabled(); };
+
+        // the queries only collect the candidate pairs,
+        // then the distances are computed in a batch
+        vector<Vector2i> candidates;
+        vector<Float>    Ds;
+        auto distances = [&](auto&& compute)
+        {
+            Ds.resize(candidates.size());
+            compute(span<const Vector2i>{candidates}, span<Float>{Ds});
+        };
+
         // 1) CodimP-AllP
-        point_bvh.query(
-            codim_point_aabbs,
-            [&](IndexT i, IndexT j)
-            {
-                IndexT CodimP = CodimPs[i];
-                IndexT P      = j;
+        candidates.clear();
+        point_bvh.query(codim_point_aabbs,
+                        [&](IndexT i, IndexT j)
+                        {
+                            IndexT CodimP = CodimPs[i];
+                            IndexT P      = j;
 
-                //1) if the two vertices are the same, don't consider it
-                if(CodimP == P)
-                    return;
+                            //1) if the two vertices are the same, don't consider it
+                            if(CodimP == P)
+                                return;
 
-                auto L = CIds[CodimP];
-                auto R = CIds[P];
+                            // 2) if the contact model is not enabled, don't consider it
+                            if(!is_contact_enabled(CodimP, P))
+                                return;
 
-                const core::ContactModel& model = contact_table.at(L, R);
+                            candidates.push_back({CodimP, P});
+                        });
 
-                // 2) if the contact model is not enabled, don't consider it
-                if(!model.is_enabled())
-                    return;
+        distances([&](auto PPs, auto Ds)
+                  { geometry::point_point_squared_distance(PPs, Vs, Ds); });
 
-                Float D = geometry::point_point_squared_distance(Vs[CodimP], Vs[P]);
+        for(auto&& [PP, D] : zip(candidates, Ds))
+        {
+            IndexT CodimP = PP[0];
+            IndexT P      = PP[1];
 
-                Float thickness =
-                    VThickness.empty() ? 0 : VThickness[CodimP] + VThickness[P];
-                Float thickness2 = thickness * thickness;
+            Float thickness =
+                VThickness.empty() ? 0 : VThickness[CodimP] + VThickness[P];
+            Float thickness2 = thickness * thickness;
 
-                if(D <= thickness2)
-                {
-                    vertex_too_close[CodimP] = 1;
-                    vertex_too_close[P]      = 1;
+            if(D <= thickness2)
+            {
+                vertex_too_close[CodimP] = 1;
+                vertex_too_close[P]      = 1;
 
-                    is_too_close = true;
+                is_too_close = true;
 
-                    Vector2i geo_ids{VGeoIds[CodimP], VGeoIds[P]};
+                Vector2i geo_ids{VGeoIds[CodimP], VGeoIds[P]};
 
-                    close_geo_ids[geo_ids] = {VObjectIds[CodimP], VObjectIds[P]};
+                close_geo_ids[geo_ids] = {VObjectIds[CodimP], VObjectIds[P]};
 
-                    set_geo_distance(geo_ids, D, thickness2);
-                }
-            });
+                set_geo_distance(geo_ids, D, thickness2);
+            }
+        }
 
         // 2) CodimP-AllE
-        edge_bvh.query(
-            codim_point_aabbs,
-            [&](IndexT i, IndexT j)
-            {
-                IndexT   CodimP = CodimPs[i];
-                Vector2i E      = Es[j];
+        candidates.clear();
+        edge_bvh.query(codim_point_aabbs,
+                       [&](IndexT i, IndexT j)
+                       {
+                           IndexT   CodimP = CodimPs[i];
+                           Vector2i E      = Es[j];
 
-                // 1) if the point is on the edge, don't consider it
-                if(CodimP == E[0] || CodimP == E[1])
-                    return;
+                           // 1) if the point is on the edge, don't consider it
+                           if(CodimP == E[0] || CodimP == E[1])
+                               return;
 
-                auto L = CIds[CodimP];
-                auto R = CIds[E[0]];
+                           // 2) if the contact model is not enabled, don't consider it
+                           if(!is_contact_enabled(CodimP, E[0]))
+                               return;
 
-                const core::ContactModel& model = contact_table.at(L, R);
+                           candidates.push_back({CodimP, j});
+                       });
 
-                // 2) if the contact model is not enabled, don't consider it
-                if(!model.is_enabled())
-                    return;
+        distances([&](auto PEs, auto Ds)
+                  { geometry::point_edge_squared_distance(PEs, Vs, Es, Ds); });
 
-                Float D =
-                    geometry::point_edge_squared_distance(Vs[CodimP], Vs[E[0]], Vs[E[1]]);
-
-                Float thickness =
-                    VThickness.empty() ? 0 : VThickness[CodimP] + VThickness[E[0]];
-                Float thickness2 = thickness * thickness;
-                if(D <= thickness2)
-                {
-                    vertex_too_close[CodimP] = 1;
-                    edge_too_close[j]        = 1;
+        for(auto&& [PE, D] : zip(candidates, Ds))
+        {
+            IndexT   CodimP = PE[0];
+            IndexT   j      = PE[1];
+            Vector2i E      = Es[j];
+
+            Float thickness =
+                VThickness.empty() ? 0 : VThickness[CodimP] + VThickness[E[0]];
+            Float thickness2 = thickness * thickness;
+            if(D <= thickness2)
+            {
+                vertex_too_close[CodimP] = 1;
+                edge_too_close[j]        = 1;
 
-                    // also mark the vertex of the edge
-                    vertex_too_close[E[0]] = 1;
-                    vertex_too_close[E[1]] = 1;
+                // also mark the vertex of the edge
+                vertex_too_close[E[0]] = 1;
+                vertex_too_close[E[1]] = 1;
 
-                    is_too_close = true;
+                is_too_close = true;
 
-                    Vector2i geo_ids{VGeoIds[CodimP], VGeoIds[E[0]]};
+                Vector2i geo_ids{VGeoIds[CodimP], VGeoIds[E[0]]};
 
-                    close_geo_ids[geo_ids] = {VObjectIds[CodimP], VObjectIds[E[0]]};
+                close_geo_ids[geo_ids] = {VObjectIds[CodimP], VObjectIds[E[0]]};
 
-                    set_geo_distance(geo_ids, D, thickness2);
-                }
-            });
+                set_geo_distance(geo_ids, D, thickness2);
+            }
+        }
 
         // 3) AllP-AllT
+        candidates.clear();
         tri_bvh.query(point_aabbs,
                       [&](IndexT i, IndexT j)
                       {
@@ -375,93 +398,100 @@ class SimplicialSurfaceDistanceCheck final : public SanityChecker
                           if(P == T[0] || P == T[1] || P == T[2])
                               return;
 
-                          auto L = CIds[P];
-                          auto R = CIds[T[0]];
-
-                          const core::ContactModel& model = contact_table.at(L, R);
-
                           // 2) if the contact model is not enabled, don't consider it
-                          if(!model.is_enabled())
+                          if(!is_contact_enabled(P, T[0]))
                               return;
 
-                          Float D = geometry::point_triangle_squared_distance(
-                              Vs[P], Vs[T[0]], Vs[T[1]], Vs[T[2]]);
+                          candidates.push_back({P, j});
+                      });
 
-                          Float thickness = VThickness.empty() ?
-                                                0 :
-                                                VThickness[P] + VThickness[T[0]];
+        distances([&](auto PTs, auto Ds)
+                  { geometry::point_triangle_squared_distance(PTs, Vs, Fs, Ds); });
 
-                          Float thickness2 = thickness * thickness;
+        for(auto&& [PT, D] : zip(candidates, Ds))
+        {
+            IndexT   P = PT[0];
+            IndexT   j = PT[1];
+            Vector3i T = Fs[j];
 
-                          if(D <= thickness2)
-                          {
-                              vertex_too_close[P] = 1;
-                              tri_too_close[j]    = 1;
+            Float thickness =
+                VThickness.empty() ? 0 : VThickness[P] + VThickness[T[0]];
+            Float thickness2 = thickness * thickness;
 
-                              // also mark the vertices of the triangle
-                              vertex_too_close[T[0]] = 1;
-                              vertex_too_close[T[1]] = 1;
-                              vertex_too_close[T[2]] = 1;
+            if(D <= thickness2)
+            {
+                vertex_too_close[P] = 1;
+                tri_too_close[j]    = 1;
 
-                              is_too_close = true;
+                // also mark the vertices of the triangle
+                vertex_too_close[T[0]] = 1;
+                vertex_too_close[T[1]] = 1;
+                vertex_too_close[T[2]] = 1;
 
-                              Vector2i geo_ids{VGeoIds[P], VGeoIds[T[0]]};
+                is_too_close = true;
 
-                              close_geo_ids[geo_ids] = {VObjectIds[P], VObjectIds[T[0]]};
+                Vector2i geo_ids{VGeoIds[P], VGeoIds[T[0]]};
 
-                              set_geo_distance(geo_ids, D, thickness2);
-                          }
-                      });
+                close_geo_ids[geo_ids] = {VObjectIds[P], VObjectIds[T[0]]};
 
-        // 4) AllE-AllE
-        edge_bvh.query(
-            edge_aabbs,
-            [&](IndexT i, IndexT j)
-            {
-                Vector2i E0 = Es[i];
-                Vector2i E1 = Es[j];
+                set_geo_distance(geo_ids, D, thickness2);
+            }
+        }
 
-                // 1) if the two edges share a vertex, don't consider it
-                if(E0[0] == E1[0] || E0[0] == E1[1] || E0[1] == E1[0] || E0[1] == E1[1])
-                    return;
+        // 4) AllE-AllE
+        candidates.clear();
+        edge_bvh.query(edge_aabbs,
+                       [&](IndexT i, IndexT j)
+                       {
+                           Vector2i E0 = Es[i];
+                           Vector2i E1 = Es[j];
 
-                auto L = CIds[E0[0]];
-                auto R = CIds[E1[0]];
+                           // 1) if the two edges share a vertex, don't consider it
+                           if(E0[0] == E1[0] || E0[0] == E1[1]
+                              || E0[1] == E1[0] || E0[1] == E1[1])
+                               return;
 
-                const core::ContactModel& model = contact_table.at(L, R);
+                           // 2) if the contact model is not enabled, don't consider it
+                           if(!is_contact_enabled(E0[0], E1[0]))
+                               return;
 
-                // 2) if the contact model is not enabled, don't consider it
-                if(!model.is_enabled())
-                    return;
+                           candidates.push_back({i, j});
+                       });
 
-                Float D = geometry::edge_edge_squared_distance(
-                    Vs[E0[0]], Vs[E0[1]], Vs[E1[0]], Vs[E1[1]]);
+        distances([&](auto EEs, auto Ds)
+                  { geometry::edge_edge_squared_distance(EEs, Vs, Es, Ds); });
 
-                Float thickness =
-                    VThickness.empty() ? 0 : VThickness[E0[0]] + VThickness[E1[0]];
+        for(auto&& [EE, D] : zip(candidates, Ds))
+        {
+            IndexT   i  = EE[0];
+            IndexT   j  = EE[1];
+            Vector2i E0 = Es[i];
+            Vector2i E1 = Es[j];
 
-                Float thickness2 = thickness * thickness;
+            Float thickness =
+                VThickness.empty() ? 0 : VThickness[E0[0]] + VThickness[E1[0]];
+            Float thickness2 = thickness * thickness;
 
-                if(D <= thickness2)
-                {
-                    edge_too_close[i] = 1;
-                    edge_too_close[j] = 1;
+            if(D <= thickness2)
+            {
+                edge_too_close[i] = 1;
+                edge_too_close[j] = 1;
 
-                    // also mark the vertices of the edges
-                    vertex_too_close[E0[0]] = 1;
-                    vertex_too_close[E0[1]] = 1;
-                    vertex_too_close[E1[0]] = 1;
-                    vertex_too_close[E1[1]] = 1;
+                // also mark the vertices of the edges
+                vertex_too_close[E0[0]] = 1;
+                vertex_too_close[E0[1]] = 1;
+                vertex_too_close[E1[0]] = 1;
+                vertex_too_close[E1[1]] = 1;
 
-                    is_too_close = true;
+                is_too_close = true;
 
-                    Vector2i geo_ids{VGeoIds[E0[0]], VGeoIds[E1[0]]};
+                Vector2i geo_ids{VGeoIds[E0[0]], VGeoIds[E1[0]]};
 
-                    close_geo_ids[geo_ids] = {VObjectIds[E0[0]], VObjectIds[E1[0]]};
+                close_geo_ids[geo_ids] = {VObjectIds[E0[0]], VObjectIds[E1[0]]};
 
-                    set_geo_distance(geo_ids, D, thickness2);
-                }
-            });
+                set_geo_distance(geo_ids, D, thickness2);
+            }
+        }
 
         if(is_too_close)
         {
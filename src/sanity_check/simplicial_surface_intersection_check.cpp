@@ -9,6 +9,7 @@
 #include <uipc/geometry/utils/intersection.h>
 #include <uipc/builtin/attribute_name.h>
 #include <uipc/common/map.h>
+#include <uipc/common/zip.h>
 
 namespace std
 {
@@ -187,6 +188,8 @@ class SimplicialSurfaceIntersectionCheck final : public SanityChecker
         // key: {geo_id_0, geo_id_1}, value: {obj_id_0, obj_id_1}
         map<Vector2i, Vector2i> intersected_geo_ids;
 
+        // (triangle index, edge index)
+        vector<Vector2i> FEs;
         bvh.query(
             edge_aabbs,
             [&](IndexT i, IndexT j)
@@ -219,49 +222,49 @@ class SimplicialSurfaceIntersectionCheck final : public SanityChecker
                 if(!model.is_enabled())
                     return;
 
+                FEs.push_back({j, i});
+            });
 
-                bool intersected = geometry::tri_edge_intersect(
-                    Vs[F[0]], Vs[F[1]], Vs[F[2]], Vs[E[0]], Vs[E[1]]);
+        // the query only collects the candidate pairs, then they are checked in a batch
+        vector<IndexT> intersected(FEs.size());
+        geometry::tri_edge_intersect(FEs, Vs, Fs, Es, intersected);
 
-                if(intersected)
-                {
-                    //spdlog::error(fmt::format("tri_edge_intersect: E[{}] = ({}, {}), F[{}] = ({}, {}, {}) -> intersected = {}",
-                    //                          i,
-                    //                          E[0],
-                    //                          E[1],
-                    //                          j,
-                    //                          F[0],
-                    //                          F[1],
-                    //                          F[2],
-                    //                          intersected));
+        for(auto&& [FE, is_intersected] : zip(FEs, intersected))
+        {
+            if(!is_intersected)
+                continue;
 
-                    edge_intersected[i] = 1;
-                    tri_intersected[j]  = 1;
+            IndexT   i = FE[1];
+            IndexT   j = FE[0];
+            Vector2i E = Es[i];
+            Vector3i F = Fs[j];
 
-                    vertex_intersected[E[0]] = 1;
-                    vertex_intersected[E[1]] = 1;
+            edge_intersected[i] = 1;
+            tri_intersected[j]  = 1;
 
-                    vertex_intersected[F[0]] = 1;
-                    vertex_intersected[F[1]] = 1;
-                    vertex_intersected[F[2]] = 1;
+            vertex_intersected[E[0]] = 1;
+            vertex_intersected[E[1]] = 1;
 
-                    has_intersection = true;
+            vertex_intersected[F[0]] = 1;
+            vertex_intersected[F[1]] = 1;
+            vertex_intersected[F[2]] = 1;
 
-                    auto GeoIdL = VGeoIds[E[0]];
-                    auto GeoIdR = VGeoIds[F[1]];
+            has_intersection = true;
 
-                    auto ObjIdL = VObjectIds[E[0]];
-                    auto ObjIdR = VObjectIds[F[1]];
+            auto GeoIdL = VGeoIds[E[0]];
+            auto GeoIdR = VGeoIds[F[1]];
 
-                    if(GeoIdL > GeoIdR)
-                    {
-                        std::swap(GeoIdL, GeoIdR);
-                        std::swap(ObjIdL, ObjIdR);
-                    }
+            auto ObjIdL = VObjectIds[E[0]];
+            auto ObjIdR = VObjectIds[F[1]];
 
-                    intersected_geo_ids[{GeoIdL, GeoIdR}] = {ObjIdL, ObjIdR};
-                }
-            });
+            if(GeoIdL > GeoIdR)
+            {
+                std::swap(GeoIdL, GeoIdR);
+                std::swap(ObjIdL, ObjIdR);
+            }
+
+            intersected_geo_ids[{GeoIdL, GeoIdR}] = {ObjIdL, ObjIdR};
+        }
 
         if(has_intersection)
         {
@@ -12,6 +12,8 @@
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/builtin/constitution_type.h>
 #include <uipc/builtin/constitution_uid_collection.h>
+#include <uipc/common/exec.h>
+#include <limits>
 
 namespace std
 {
@@ -49,6 +51,16 @@ class SimplicialVolumeCheck final : public SanityChecker
         vector<IndexT> invalid_geo_ids;
         vector<IndexT> invalid_obj_ids;
 
+        auto min_volume = [](span<const Float> volumes)
+        {
+            return exec::parallel_reduce(
+                0,
+                volumes.size(),
+                std::numeric_limits<Float>::infinity(),
+                [&](SizeT i) { return volumes[i]; },
+                [](Float a, Float b) { return std::min(a, b); });
+        };
+
         for(auto& geo_slot : geo_slots)
         {
             auto& geo = geo_slot->geometry();
@@ -69,12 +81,9 @@ class SimplicialVolumeCheck final : public SanityChecker
 
             if(uid_info.type == builtin::FiniteElement)
             {
-                auto volume      = sc->vertices().find<Float>(builtin::volume);
-                auto volume_view = volume->view();
-                auto min_elem =
-                    std::min_element(volume_view.begin(), volume_view.end());
+                auto volume = sc->vertices().find<Float>(builtin::volume);
 
-                if(*min_elem <= 0.0)
+                if(min_volume(volume->view()) <= 0.0)
                 {
                     invalid_geo_ids.push_back(gid);
                     invalid_obj_ids.push_back(oid);
@@ -83,11 +92,8 @@ class SimplicialVolumeCheck final : public SanityChecker
             else if(uid_info.type == builtin::AffineBody)
             {
 
-                auto volume      = sc->instances().find<Float>(builtin::volume);
-                auto volume_view = volume->view();
-                auto min_elem =
-                    std::min_element(volume_view.begin(), volume_view.end());
-                if(*min_elem <= 0.0)
+                auto volume = sc->instances().find<Float>(builtin::volume);
+                if(min_volume(volume->view()) <= 0.0)
                 {
                     invalid_geo_ids.push_back(gid);
                     invalid_obj_ids.push_back(oid);